@@ -27,10 +27,10 @@ macx:greaterThan(QT_MAJOR_VERSION, 4):lessThan(QT_VERSION, 5.2) {
 
 TEMPLATE = app
 greaterThan(QT_MAJOR_VERSION, 4) { # QT v. 5
-    QT += printsupport webkitwidgets widgets concurrent
+    QT += printsupport webkitwidgets widgets concurrent network
 }
 else { # QT v. 4
-    QT += webkit concurrent
+    QT += webkit concurrent network
 }
 CONFIG -= debug
 CONFIG += warn_on
@@ -116,6 +116,9 @@ HEADERS += src/MainWindow.h \
     src/Theme.h \
     src/ThemeFactory.h \
     src/CommandLineExporter.h \
+    src/CommonMarkEntities.h \
+    src/CommonMarkExporter.h \
+    src/CommonMarkParser.h \
     src/TextBlockData.h \
     src/HudWindowTypes.h \
     src/HudWindow.h \
@@ -128,14 +131,28 @@ HEADERS += src/MainWindow.h \
     src/AppSettings.h \
     src/DocumentManager.h \
     src/TextDocument.h \
+    src/TextDocumentLayout.h \
+    src/AnnotatedScrollBar.h \
+    src/FuzzyMatcher.h \
+    src/QuickJumpPalette.h \
+    src/ImageThumbnailCache.h \
     src/DocumentHistory.h \
+    src/AsyncFileAccess.h \
+    src/CancellationToken.h \
+    src/TaskScheduler.h \
     src/ExportDialog.h \
     src/Outline.h \
+    src/MarkdownFlavor.h \
     src/MarkdownStates.h \
     src/MarkdownHighlighter.h \
+    src/StyleChecker.h \
+    src/MarkdownLintTypes.h \
+    src/MarkdownLinter.h \
+    src/ProblemsPanel.h \
     src/MarkdownStyles.h \
     src/MessageBoxHelper.h \
     src/GraphicsFadeEffect.h \
+    src/CachedDropShadowEffect.h \
     src/SundownExporter.h \
     src/StyleSheetManagerDialog.h \
     src/SimpleFontDialog.h \
@@ -148,8 +165,31 @@ HEADERS += src/MainWindow.h \
     src/AbstractStatisticsWidget.h \
     src/DocumentStatistics.h \
     src/DocumentStatisticsWidget.h \
+    src/PreviewRendererTypes.h \
+    src/PreviewChannel.h \
+    src/PreviewRendererWindow.h \
+    src/PreviewTimings.h \
+    src/PreviewLatencyHarness.h \
+    src/MemoryAccounting.h \
+    src/MemoryDiagnosticsWidget.h \
+    src/MemorySoakHarness.h \
+    src/SelfContainedHtmlWriter.h \
+    src/DocumentMinimap.h \
+    src/PipeTableFormatter.h \
+    src/BackgroundImageLoader.h \
+    src/ExporterPlugin.h \
+    src/PluginExporter.h \
+    src/CommonMarkHarness.h \
+    src/SumTree.h \
+    src/FuzzyMatcherHarness.h \
+    src/PipeTableHarness.h \
+    src/SundownHarness.h \
+    src/RemotePreviewRenderer.h \
     src/SessionStatistics.h \
     src/SessionStatisticsWidget.h \
+    src/WritingHistory.h \
+    src/WritingHistoryLog.h \
+    src/WritingHistoryWidget.h \
     src/find_dialog.h \
     src/image_button.h \
     src/color_button.h \
@@ -164,7 +204,9 @@ HEADERS += src/MainWindow.h \
     src/sundown/houdini.h \
     src/sundown/html_blocks.h \
     src/sundown/html.h \
+    src/sundown/latex.h \
     src/sundown/markdown.h \
+    src/sundown/odt.h \
     src/sundown/stack.h
 
 SOURCES += src/AppMain.cpp \
@@ -177,6 +219,8 @@ SOURCES += src/AppMain.cpp \
     src/Theme.cpp \
     src/ThemeFactory.cpp \
     src/CommandLineExporter.cpp \
+    src/CommonMarkExporter.cpp \
+    src/CommonMarkParser.cpp \
     src/HudWindow.cpp \
     src/ThemeSelectionDialog.cpp \
     src/ThemePreviewer.cpp \
@@ -186,12 +230,24 @@ SOURCES += src/AppMain.cpp \
     src/AppSettings.cpp \
     src/DocumentManager.cpp \
     src/TextDocument.cpp \
+    src/TextDocumentLayout.cpp \
+    src/AnnotatedScrollBar.cpp \
+    src/FuzzyMatcher.cpp \
+    src/QuickJumpPalette.cpp \
+    src/ImageThumbnailCache.cpp \
     src/DocumentHistory.cpp \
+    src/AsyncFileAccess.cpp \
+    src/CancellationToken.cpp \
+    src/TaskScheduler.cpp \
     src/ExportDialog.cpp \
     src/Outline.cpp \
     src/MarkdownHighlighter.cpp \
+    src/StyleChecker.cpp \
+    src/MarkdownLinter.cpp \
+    src/ProblemsPanel.cpp \
     src/MessageBoxHelper.cpp \
     src/GraphicsFadeEffect.cpp \
+    src/CachedDropShadowEffect.cpp \
     src/StyleSheetManagerDialog.cpp \
     src/SimpleFontDialog.cpp \
     src/SundownExporter.cpp \
@@ -203,8 +259,28 @@ SOURCES += src/AppMain.cpp \
     src/AbstractStatisticsWidget.cpp \
     src/SessionStatistics.cpp \
     src/SessionStatisticsWidget.cpp \
+    src/WritingHistory.cpp \
+    src/WritingHistoryLog.cpp \
+    src/WritingHistoryWidget.cpp \
     src/DocumentStatistics.cpp \
     src/DocumentStatisticsWidget.cpp \
+    src/PreviewChannel.cpp \
+    src/PreviewRendererWindow.cpp \
+    src/PreviewTimings.cpp \
+    src/PreviewLatencyHarness.cpp \
+    src/MemoryAccounting.cpp \
+    src/MemoryDiagnosticsWidget.cpp \
+    src/MemorySoakHarness.cpp \
+    src/SelfContainedHtmlWriter.cpp \
+    src/DocumentMinimap.cpp \
+    src/PipeTableFormatter.cpp \
+    src/BackgroundImageLoader.cpp \
+    src/PluginExporter.cpp \
+    src/CommonMarkHarness.cpp \
+    src/FuzzyMatcherHarness.cpp \
+    src/PipeTableHarness.cpp \
+    src/SundownHarness.cpp \
+    src/RemotePreviewRenderer.cpp \
     src/find_dialog.cpp \
     src/image_button.cpp \
     src/color_button.cpp \
@@ -217,7 +293,9 @@ SOURCES += src/AppMain.cpp \
     src/sundown/houdini_html_e.c \
     src/sundown/html_smartypants.c \
     src/sundown/html.c \
+    src/sundown/latex.c \
     src/sundown/markdown.c \
+    src/sundown/odt.c \
     src/sundown/stack.c
 
 # Allow for updating translations
@@ -0,0 +1,566 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <algorithm>
+
+#include <QAbstractTextDocumentLayout>
+#include <QEvent>
+#include <QPainter>
+#include <QPlainTextEdit>
+#include <QStyle>
+#include <QStyleOptionSlider>
+#include <QTextBlock>
+#include <QTimer>
+
+#include "AnnotatedScrollBar.h"
+#include "MarkdownStates.h"
+#include "TextBlockData.h"
+#include "TextDocumentLayout.h"
+
+// Height of each bucket of the annotation strip, in pixels.
+#define GW_ANNOTATION_BUCKET_HEIGHT 2
+
+// Delay in milliseconds before document changes are reflected in the
+// annotations, so that bursts of changes are handled in one go.
+//
+#define GW_ANNOTATION_REFRESH_DELAY 100
+
+AnnotatedScrollBar::AnnotatedScrollBar(QPlainTextEdit* editor)
+    : QScrollBar(Qt::Vertical, editor), editor(editor)
+{
+    annotationColors[AnnotationHeading] = QColor(Qt::darkGray);
+    annotationColors[AnnotationSpellingError] = QColor(Qt::red);
+    annotationColors[AnnotationLint] = QColor(Qt::darkYellow);
+    annotationColors[AnnotationSearchMatch] = QColor(Qt::blue);
+
+    bucketCount = 0;
+    countedHeight = 0;
+    firstDirtyBlock = -1;
+    lastDirtyBlock = -1;
+    rebuildNeeded = true;
+    recountNeeded = false;
+
+    refreshTimer = new QTimer(this);
+    refreshTimer->setSingleShot(true);
+    refreshTimer->setInterval(GW_ANNOTATION_REFRESH_DELAY);
+    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+
+    // Note that the syntax highlighter marks the blocks it highlights as
+    // changed, so spelling errors and lint findings found after the text
+    // of a block has changed are picked up here as well.
+    //
+    connect
+    (
+        editor->document(),
+        SIGNAL(contentsChange(int,int,int)),
+        this,
+        SLOT(onContentsChange(int,int,int))
+    );
+
+    // The heights of blocks change whenever the text is wrapped
+    // differently, or an image preview is shown or hidden.
+    //
+    connect
+    (
+        editor->document()->documentLayout(),
+        SIGNAL(documentSizeChanged(QSizeF)),
+        refreshTimer,
+        SLOT(start())
+    );
+
+    editor->viewport()->installEventFilter(this);
+    refreshTimer->start();
+}
+
+AnnotatedScrollBar::~AnnotatedScrollBar()
+{
+
+}
+
+void AnnotatedScrollBar::setAnnotationColor
+(
+    AnnotationType type,
+    const QColor& color
+)
+{
+    annotationColors[type] = color;
+    redrawStrip();
+}
+
+void AnnotatedScrollBar::setSearchMatches(const QList<int>& positions)
+{
+    QTextDocument* document = editor->document();
+    QVector<int> blocks;
+
+    blocks.reserve(positions.size());
+
+    foreach (int position, positions)
+    {
+        blocks.append(document->findBlock(position).blockNumber());
+    }
+
+    std::sort(blocks.begin(), blocks.end());
+    blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+
+    if (blocks != searchMatchBlocks)
+    {
+        searchMatchBlocks = blocks;
+        refreshAnnotations();
+    }
+}
+
+void AnnotatedScrollBar::refreshAnnotations()
+{
+    firstDirtyBlock = 0;
+    lastDirtyBlock = editor->document()->blockCount() - 1;
+    refreshTimer->start();
+}
+
+void AnnotatedScrollBar::paintEvent(QPaintEvent* event)
+{
+    QScrollBar::paintEvent(event);
+
+    if (!strip.isNull())
+    {
+        QPainter painter(this);
+        painter.drawImage(grooveRect().topLeft(), strip);
+    }
+}
+
+void AnnotatedScrollBar::resizeEvent(QResizeEvent* event)
+{
+    QScrollBar::resizeEvent(event);
+
+    // The number of buckets depends on the groove height.
+    recountNeeded = true;
+    refreshTimer->start();
+}
+
+bool AnnotatedScrollBar::eventFilter(QObject* watched, QEvent* event)
+{
+    // Resizing the editor rewraps the text, which can change the heights
+    // of blocks without changing the height of the document.
+    //
+    if ((watched == editor->viewport()) && (QEvent::Resize == event->type()))
+    {
+        recountNeeded = true;
+        refreshTimer->start();
+    }
+
+    return QScrollBar::eventFilter(watched, event);
+}
+
+void AnnotatedScrollBar::onContentsChange
+(
+    int position,
+    int charsRemoved,
+    int charsAdded
+)
+{
+    Q_UNUSED(charsRemoved)
+
+    QTextDocument* document = editor->document();
+    QTextBlock first = document->findBlock(position);
+    QTextBlock last = document->findBlock(position + charsAdded);
+
+    int firstBlock = first.isValid() ? first.blockNumber() : 0;
+    int lastBlock =
+        last.isValid() ? last.blockNumber() : (document->blockCount() - 1);
+
+    // Of the blocks spanned by the change, only the first one existed
+    // before it, so splice any inserted or removed blocks in after that
+    // one, and shift the pending range of changed blocks to match.
+    //
+    if (!rebuildNeeded && first.isValid())
+    {
+        int blockCountDelta = document->blockCount() - blockAnnotations.size();
+
+        if (blockCountDelta > 0)
+        {
+            blockAnnotations.insert(firstBlock + 1, blockCountDelta, 0);
+        }
+        else if (blockCountDelta < 0)
+        {
+            blockAnnotations.remove(firstBlock + 1, -blockCountDelta);
+        }
+
+        if (0 != blockCountDelta)
+        {
+            if (firstDirtyBlock > firstBlock)
+            {
+                firstDirtyBlock = qMax(firstBlock, firstDirtyBlock + blockCountDelta);
+            }
+
+            if (lastDirtyBlock > firstBlock)
+            {
+                lastDirtyBlock = qMax(firstBlock, lastDirtyBlock + blockCountDelta);
+            }
+
+            // The blocks below the change have moved.
+            recountNeeded = true;
+        }
+    }
+
+    if (firstDirtyBlock < 0)
+    {
+        firstDirtyBlock = firstBlock;
+        lastDirtyBlock = lastBlock;
+    }
+    else
+    {
+        firstDirtyBlock = qMin(firstDirtyBlock, firstBlock);
+        lastDirtyBlock = qMax(lastDirtyBlock, lastBlock);
+    }
+
+    refreshTimer->start();
+}
+
+void AnnotatedScrollBar::refresh()
+{
+    QTextDocument* document = editor->document();
+    int firstBlock = firstDirtyBlock;
+    int lastBlock = qMin(lastDirtyBlock, document->blockCount() - 1);
+
+    firstDirtyBlock = -1;
+    lastDirtyBlock = -1;
+
+    if (rebuildNeeded || (document->blockCount() != blockAnnotations.size()))
+    {
+        rebuild();
+        return;
+    }
+
+    QVector<int> changedBlocks;
+    QVector<uchar> previousAnnotations;
+
+    if (firstBlock >= 0)
+    {
+        QTextBlock block = document->findBlockByNumber(firstBlock);
+
+        for (int i = firstBlock; (i <= lastBlock) && block.isValid(); i++)
+        {
+            uchar annotations = annotationsForBlock(block);
+
+            if (annotations != blockAnnotations[i])
+            {
+                changedBlocks.append(i);
+                previousAnnotations.append(blockAnnotations[i]);
+                blockAnnotations[i] = annotations;
+            }
+
+            block = block.next();
+        }
+    }
+
+    // Blocks were inserted, removed or resized, or the groove was resized,
+    // which moves the blocks below them to other buckets.
+    //
+    int height = documentHeight();
+
+    if
+    (
+        recountNeeded
+        || (height != countedHeight)
+        || ((grooveRect().height() / GW_ANNOTATION_BUCKET_HEIGHT) != bucketCount)
+    )
+    {
+        recountBuckets();
+        return;
+    }
+
+    if (changedBlocks.isEmpty() || strip.isNull())
+    {
+        return;
+    }
+
+    QVector<int> changedBuckets;
+
+    for (int i = 0; i < changedBlocks.size(); i++)
+    {
+        int bucket = bucketForBlock(changedBlocks[i], height);
+
+        for (int type = 0; type < AnnotationTypeCount; type++)
+        {
+            uchar flag = 1 << type;
+
+            bucketCounts[(bucket * AnnotationTypeCount) + type] +=
+                ((blockAnnotations[changedBlocks[i]] & flag) ? 1 : 0)
+                - ((previousAnnotations[i] & flag) ? 1 : 0);
+        }
+
+        changedBuckets.append(bucket);
+    }
+
+    QPainter painter(&strip);
+
+    foreach (int bucket, changedBuckets)
+    {
+        drawBucket(painter, bucket);
+    }
+
+    painter.end();
+    update();
+}
+
+QRect AnnotatedScrollBar::grooveRect() const
+{
+    QStyleOptionSlider option;
+    initStyleOption(&option);
+
+    return style()->subControlRect
+        (
+            QStyle::CC_ScrollBar,
+            &option,
+            QStyle::SC_ScrollBarGroove,
+            this
+        );
+}
+
+TextDocumentLayout* AnnotatedScrollBar::documentLayout() const
+{
+    return qobject_cast<TextDocumentLayout*>
+        (
+            editor->document()->documentLayout()
+        );
+}
+
+int AnnotatedScrollBar::documentHeight() const
+{
+    TextDocumentLayout* layout = documentLayout();
+
+    // Without a TextDocumentLayout, every block counts as one pixel high.
+    if (NULL == layout)
+    {
+        return editor->document()->blockCount();
+    }
+
+    return layout->documentHeight();
+}
+
+uchar AnnotatedScrollBar::annotationsForBlock(const QTextBlock& block) const
+{
+    uchar annotations = 0;
+
+    switch (block.userState())
+    {
+        case MarkdownStateAtxHeading1:
+        case MarkdownStateAtxHeading2:
+        case MarkdownStateAtxHeading3:
+        case MarkdownStateAtxHeading4:
+        case MarkdownStateAtxHeading5:
+        case MarkdownStateAtxHeading6:
+        case MarkdownStateSetextHeading1Line1:
+        case MarkdownStateSetextHeading2Line1:
+            annotations |= 1 << AnnotationHeading;
+            break;
+        default:
+            break;
+    }
+
+    TextBlockData* blockData = (TextBlockData*) block.userData();
+
+    if (NULL != blockData)
+    {
+        if (blockData->misspellingCount > 0)
+        {
+            annotations |= 1 << AnnotationSpellingError;
+        }
+
+        if (!blockData->lintDiagnostics.isEmpty())
+        {
+            annotations |= 1 << AnnotationLint;
+        }
+    }
+
+    if
+    (
+        std::binary_search
+        (
+            searchMatchBlocks.constBegin(),
+            searchMatchBlocks.constEnd(),
+            block.blockNumber()
+        )
+    )
+    {
+        annotations |= 1 << AnnotationSearchMatch;
+    }
+
+    return annotations;
+}
+
+int AnnotatedScrollBar::bucketForBlock(int blockNumber, int height) const
+{
+    if ((height <= 0) || (bucketCount <= 0))
+    {
+        return 0;
+    }
+
+    TextDocumentLayout* layout = documentLayout();
+    qint64 top = (NULL != layout) ? layout->blockTop(blockNumber) : blockNumber;
+
+    return qMin(bucketCount - 1, (int) ((top * bucketCount) / height));
+}
+
+void AnnotatedScrollBar::rebuild()
+{
+    QTextDocument* document = editor->document();
+    QTextBlock block = document->begin();
+
+    rebuildNeeded = false;
+    blockAnnotations.resize(document->blockCount());
+
+    for (int i = 0; (i < blockAnnotations.size()) && block.isValid(); i++)
+    {
+        blockAnnotations[i] = annotationsForBlock(block);
+        block = block.next();
+    }
+
+    recountBuckets();
+}
+
+void AnnotatedScrollBar::recountBuckets()
+{
+    QRect groove = grooveRect();
+    int newBucketCount = qMax(0, groove.height() / GW_ANNOTATION_BUCKET_HEIGHT);
+    bool resized = (newBucketCount != bucketCount) || (strip.width() != groove.width());
+
+    bucketCount = newBucketCount;
+    recountNeeded = false;
+    countedHeight = documentHeight();
+
+    QVector<int> counts(bucketCount * AnnotationTypeCount, 0);
+
+    for (int i = 0; i < blockAnnotations.size(); i++)
+    {
+        uchar annotations = blockAnnotations[i];
+
+        if (0 == annotations)
+        {
+            continue;
+        }
+
+        int bucket = bucketForBlock(i, countedHeight);
+
+        for (int type = 0; type < AnnotationTypeCount; type++)
+        {
+            if (annotations & (1 << type))
+            {
+                counts[(bucket * AnnotationTypeCount) + type]++;
+            }
+        }
+    }
+
+    QVector<int> previousCounts = bucketCounts;
+    bucketCounts = counts;
+
+    if (resized || strip.isNull())
+    {
+        redrawStrip();
+        return;
+    }
+
+    // Only redraw the buckets whose counts have changed.
+    QPainter painter(&strip);
+
+    for (int bucket = 0; bucket < bucketCount; bucket++)
+    {
+        for (int type = 0; type < AnnotationTypeCount; type++)
+        {
+            int index = (bucket * AnnotationTypeCount) + type;
+
+            if (counts[index] != previousCounts[index])
+            {
+                drawBucket(painter, bucket);
+                break;
+            }
+        }
+    }
+
+    painter.end();
+    update();
+}
+
+void AnnotatedScrollBar::drawBucket(QPainter& painter, int bucket)
+{
+    int y = bucket * GW_ANNOTATION_BUCKET_HEIGHT;
+    int width = strip.width();
+    int halfWidth = width / 2;
+    const int* counts = bucketCounts.constData() + (bucket * AnnotationTypeCount);
+
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect(0, y, width, GW_ANNOTATION_BUCKET_HEIGHT, Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+    // Headings and search matches span the whole width of the strip, while
+    // spelling errors and lint findings share it side by side.  Search
+    // matches are drawn last, since they are what the user is looking for
+    // while they are shown.
+    //
+    if (counts[AnnotationHeading] > 0)
+    {
+        painter.fillRect(0, y, width, GW_ANNOTATION_BUCKET_HEIGHT, annotationColors[AnnotationHeading]);
+    }
+
+    if (counts[AnnotationSpellingError] > 0)
+    {
+        painter.fillRect(0, y, halfWidth, GW_ANNOTATION_BUCKET_HEIGHT, annotationColors[AnnotationSpellingError]);
+    }
+
+    if (counts[AnnotationLint] > 0)
+    {
+        painter.fillRect(halfWidth, y, width - halfWidth, GW_ANNOTATION_BUCKET_HEIGHT, annotationColors[AnnotationLint]);
+    }
+
+    if (counts[AnnotationSearchMatch] > 0)
+    {
+        painter.fillRect(0, y, width, GW_ANNOTATION_BUCKET_HEIGHT, annotationColors[AnnotationSearchMatch]);
+    }
+}
+
+void AnnotatedScrollBar::redrawStrip()
+{
+    QRect groove = grooveRect();
+
+    if ((bucketCount <= 0) || (groove.width() <= 0))
+    {
+        strip = QImage();
+        update();
+        return;
+    }
+
+    strip =
+        QImage
+        (
+            groove.width(),
+            bucketCount * GW_ANNOTATION_BUCKET_HEIGHT,
+            QImage::Format_ARGB32_Premultiplied
+        );
+    strip.fill(0);
+
+    QPainter painter(&strip);
+
+    for (int bucket = 0; bucket < bucketCount; bucket++)
+    {
+        drawBucket(painter, bucket);
+    }
+
+    painter.end();
+    update();
+}
@@ -0,0 +1,147 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef ANNOTATEDSCROLLBAR_H
+#define ANNOTATEDSCROLLBAR_H
+
+#include <QColor>
+#include <QImage>
+#include <QList>
+#include <QScrollBar>
+#include <QVector>
+
+class QPainter;
+class QPlainTextEdit;
+class QTextBlock;
+class QTimer;
+class TextDocumentLayout;
+
+/**
+ * Vertical scroll bar for a QPlainTextEdit that marks where headings,
+ * spelling errors, lint findings and search matches are in the document.
+ *
+ * The groove is divided into buckets a couple of pixels high, each of
+ * which counts the annotations of every type for the blocks that fall into
+ * it.  Blocks are mapped to buckets by their distance in pixels from the
+ * top of the document, as indexed by the editor's TextDocumentLayout, so
+ * that image previews take up their share of the groove.  The markers are
+ * drawn into a cached strip image, and as the document changes only the
+ * buckets whose counts have changed are redrawn, so that even documents
+ * with many thousands of annotations scroll smoothly.
+ */
+class AnnotatedScrollBar : public QScrollBar
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Kinds of annotations shown on the scroll bar.
+         */
+        enum AnnotationType
+        {
+            AnnotationHeading,
+            AnnotationSpellingError,
+            AnnotationLint,
+            AnnotationSearchMatch,
+            AnnotationTypeCount
+        };
+
+        /**
+         * Constructor.  Takes the editor whose document is to be annotated
+         * as a parameter.  Note that the editor must still be told to use
+         * this scroll bar via QAbstractScrollArea::setVerticalScrollBar().
+         */
+        AnnotatedScrollBar(QPlainTextEdit* editor);
+
+        /**
+         * Destructor.
+         */
+        ~AnnotatedScrollBar();
+
+        /**
+         * Sets the color of the markers for the given annotation type.
+         */
+        void setAnnotationColor(AnnotationType type, const QColor& color);
+
+    public slots:
+        /**
+         * Sets the document positions of the current search matches, or
+         * clears them if the list is empty.
+         */
+        void setSearchMatches(const QList<int>& positions);
+
+        /**
+         * Checks the annotations of every block in the document again.
+         * Call this method when annotations can change without the text of
+         * their block changing, such as lint findings that depend on other
+         * blocks.
+         */
+        void refreshAnnotations();
+
+    protected:
+        void paintEvent(QPaintEvent* event);
+        void resizeEvent(QResizeEvent* event);
+        bool eventFilter(QObject* watched, QEvent* event);
+
+    private slots:
+        void onContentsChange(int position, int charsRemoved, int charsAdded);
+        void refresh();
+
+    private:
+        QPlainTextEdit* editor;
+        QColor annotationColors[AnnotationTypeCount];
+        QTimer* refreshTimer;
+
+        // Annotation types present in each block as bit flags, spliced as
+        // blocks are inserted and removed.
+        //
+        QVector<uchar> blockAnnotations;
+
+        // Sorted numbers of the blocks with search matches.
+        QVector<int> searchMatchBlocks;
+
+        // Annotation counts per bucket, with AnnotationTypeCount entries
+        // for each bucket.
+        //
+        int bucketCount;
+        QVector<int> bucketCounts;
+        QImage strip;
+
+        // Document height in pixels for which the buckets were counted.
+        int countedHeight;
+
+        // Range of blocks changed since the last refresh, or -1 if none.
+        int firstDirtyBlock;
+        int lastDirtyBlock;
+        bool rebuildNeeded;
+        bool recountNeeded;
+
+        QRect grooveRect() const;
+        TextDocumentLayout* documentLayout() const;
+        int documentHeight() const;
+        uchar annotationsForBlock(const QTextBlock& block) const;
+        int bucketForBlock(int blockNumber, int height) const;
+        void rebuild();
+        void recountBuckets();
+        void drawBucket(QPainter& painter, int bucket);
+        void redrawStrip();
+};
+
+#endif // ANNOTATEDSCROLLBAR_H
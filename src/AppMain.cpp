@@ -24,6 +24,14 @@
 
 #include "MainWindow.h"
 #include "AppSettings.h"
+#include "PreviewRendererTypes.h"
+#include "PreviewRendererWindow.h"
+#include "PreviewLatencyHarness.h"
+#include "MemorySoakHarness.h"
+#include "CommonMarkHarness.h"
+#include "FuzzyMatcherHarness.h"
+#include "PipeTableHarness.h"
+#include "SundownHarness.h"
 
 int main(int argc, char* argv[])
 {
@@ -33,6 +41,17 @@ int main(int argc, char* argv[])
 
     QApplication app(argc, argv);
 
+    // If launched as the HTML preview renderer helper process, run only the
+    // renderer.  See RemotePreviewRenderer.
+    //
+    int rendererArgIndex = app.arguments().indexOf(GW_PREVIEW_RENDERER_ARG);
+
+    if ((rendererArgIndex >= 0) && (rendererArgIndex + 1 < app.arguments().size()))
+    {
+        PreviewRendererWindow rendererWindow(app.arguments().at(rendererArgIndex + 1));
+        return app.exec();
+    }
+
     // Call this to force settings initialization before the application
     // fully launches.
     //
@@ -57,6 +76,92 @@ int main(int argc, char* argv[])
 
     app.installTranslator(&translator);
 
+    // If launched as the latency harness, measure the live preview instead
+    // of opening the editor.  See PreviewLatencyHarness.
+    //
+    int harnessArgIndex = app.arguments().indexOf(GW_LATENCY_HARNESS_ARG);
+
+    if (harnessArgIndex >= 0)
+    {
+        PreviewLatencyHarness harness(app.arguments().mid(harnessArgIndex + 1));
+        return harness.run();
+    }
+
+    // If launched as the soak harness, simulate a long writing session and
+    // report memory growth.  See MemorySoakHarness.
+    //
+    int soakArgIndex = app.arguments().indexOf(GW_SOAK_HARNESS_ARG);
+
+    if (soakArgIndex >= 0)
+    {
+        MemorySoakHarness harness(app.arguments().mid(soakArgIndex + 1));
+        return harness.run();
+    }
+
+    // If launched as the CommonMark spec runner, pathological input test or
+    // benchmark, test the built-in CommonMark processor.  See CommonMarkHarness.
+    //
+    int specArgIndex = app.arguments().indexOf(GW_COMMONMARK_SPEC_ARG);
+
+    if (specArgIndex >= 0)
+    {
+        CommonMarkHarness harness(app.arguments().mid(specArgIndex + 1));
+        return harness.runSpecTests();
+    }
+
+    int benchmarkArgIndex = app.arguments().indexOf(GW_COMMONMARK_BENCHMARK_ARG);
+
+    if (benchmarkArgIndex >= 0)
+    {
+        CommonMarkHarness harness(app.arguments().mid(benchmarkArgIndex + 1));
+        return harness.runBenchmark();
+    }
+
+    int pathologicalArgIndex = app.arguments().indexOf(GW_COMMONMARK_PATHOLOGICAL_ARG);
+
+    if (pathologicalArgIndex >= 0)
+    {
+        CommonMarkHarness harness(app.arguments().mid(pathologicalArgIndex + 1));
+        return harness.runPathologicalTests();
+    }
+
+    // If launched as the quick jump palette benchmark, time the fuzzy
+    // matcher.  See FuzzyMatcherHarness.
+    //
+    int fuzzyArgIndex = app.arguments().indexOf(GW_FUZZY_BENCHMARK_ARG);
+
+    if (fuzzyArgIndex >= 0)
+    {
+        FuzzyMatcherHarness harness(app.arguments().mid(fuzzyArgIndex + 1));
+        return harness.run();
+    }
+
+    // If launched as the pipe table tests, check the table formatter.  See
+    // PipeTableHarness.
+    //
+    if (app.arguments().contains(GW_PIPE_TABLE_TESTS_ARG))
+    {
+        PipeTableHarness harness;
+        return harness.run();
+    }
+
+    // If launched as the export benchmark or the nested block benchmark,
+    // time the built-in Sundown renderers and parser.  See SundownHarness.
+    //
+    int exportArgIndex = app.arguments().indexOf(GW_EXPORT_BENCHMARK_ARG);
+
+    if (exportArgIndex >= 0)
+    {
+        SundownHarness harness(app.arguments().mid(exportArgIndex + 1));
+        return harness.runExportBenchmark();
+    }
+
+    if (app.arguments().contains(GW_NESTING_BENCHMARK_ARG))
+    {
+        SundownHarness harness(QStringList());
+        return harness.runNestingBenchmark();
+    }
+
     QString filePath = QString();
 
     if (argc > 1)
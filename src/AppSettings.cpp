@@ -34,6 +34,9 @@
 #define GW_REMEMBER_FILE_HISTORY_KEY "Save/rememberFileHistory"
 #define GW_FONT_KEY "Style/font"
 #define GW_LARGE_HEADINGS_KEY "Style/largeHeadings"
+#define GW_IMAGE_PREVIEWS_KEY "Style/imagePreviews"
+#define GW_MINIMAP_KEY "Style/minimap"
+#define GW_PAINT_CACHE_KEY "Style/paintCache"
 #define GW_AUTO_MATCH_KEY "Typing/autoMatchEnabled"
 #define GW_AUTO_MATCH_DOUBLE_QUOTES_KEY "Typing/autoMatchDoubleQuotes"
 #define GW_AUTO_MATCH_SINGLE_QUOTES_KEY "Typing/autoMatchSingleQuotes"
@@ -45,6 +48,7 @@
 #define GW_AUTO_MATCH_BACKTICKS_KEY "Typing/autoMatchBackticks"
 #define GW_AUTO_MATCH_ANGLE_BRACKETS_KEY "Typing/autoMatchAngleBrackets"
 #define GW_BULLET_CYCLING_KEY "Typing/bulletPointCyclingEnabled"
+#define GW_TABLE_FORMATTING_KEY "Typing/tableFormattingEnabled"
 #define GW_UNDERLINE_ITALICS_KEY "Style/underlineInsteadOfItalics"
 #define GW_FOCUS_MODE_KEY "Style/focusMode"
 #define GW_HIDE_MENU_BAR_IN_FULL_SCREEN_KEY "Style/hideMenuBarInFullScreenEnabled"
@@ -57,10 +61,12 @@
 #define GW_DICTIONARY_KEY "Spelling/locale"
 #define GW_LOCALE_KEY "Application/locale"
 #define GW_LIVE_SPELL_CHECK_KEY "Spelling/liveSpellCheck"
+#define GW_LIVE_STYLE_CHECK_KEY "Spelling/liveStyleCheck"
 #define GW_HUD_BUTTON_LAYOUT_KEY "HUD/windowButtonLayout"
 #define GW_HUD_ROW_COLORS_KEY "HUD/alternateRowColors"
 #define GW_DESKTOP_COMPOSITING_KEY "HUD/desktopCompositingEnabled"
 #define GW_HUD_OPACITY_KEY "HUD/opacity"
+#define GW_REMOTE_PREVIEW_RENDERING_KEY "Preview/renderInSeparateProcess"
 
 AppSettings* AppSettings::instance = NULL;
 
@@ -88,6 +94,9 @@ void AppSettings::store()
     appSettings.setValue(GW_TAB_WIDTH_KEY, QVariant(tabWidth));
     appSettings.setValue(GW_SPACES_FOR_TABS_KEY, QVariant(insertSpacesForTabsEnabled));
     appSettings.setValue(GW_LARGE_HEADINGS_KEY, QVariant(largeHeadingSizesEnabled));
+    appSettings.setValue(GW_IMAGE_PREVIEWS_KEY, QVariant(imagePreviewsEnabled));
+    appSettings.setValue(GW_MINIMAP_KEY, QVariant(minimapEnabled));
+    appSettings.setValue(GW_PAINT_CACHE_KEY, QVariant(paintCacheEnabled));
     appSettings.setValue(GW_AUTO_MATCH_KEY, QVariant(autoMatchEnabled));
     appSettings.setValue(GW_AUTO_MATCH_DOUBLE_QUOTES_KEY, QVariant(autoMatchDoubleQuotesEnabled));
     appSettings.setValue(GW_AUTO_MATCH_SINGLE_QUOTES_KEY, QVariant(autoMatchSingleQuotesEnabled));
@@ -99,6 +108,7 @@ void AppSettings::store()
     appSettings.setValue(GW_AUTO_MATCH_BACKTICKS_KEY, QVariant(autoMatchBackticksEnabled));
     appSettings.setValue(GW_AUTO_MATCH_ANGLE_BRACKETS_KEY, QVariant(autoMatchAngleBracketsEnabled));
     appSettings.setValue(GW_BULLET_CYCLING_KEY, QVariant(bulletPointCyclingEnabled));
+    appSettings.setValue(GW_TABLE_FORMATTING_KEY, QVariant(tableFormattingEnabled));
 
     appSettings.setValue(GW_UNDERLINE_ITALICS_KEY, QVariant(useUnderlineForEmphasis));
     appSettings.setValue(GW_FOCUS_MODE_KEY, QVariant(focusMode));
@@ -110,12 +120,14 @@ void AppSettings::store()
     appSettings.setValue(GW_DICTIONARY_KEY, QVariant(dictionaryLanguage));
     appSettings.setValue(GW_LOCALE_KEY, QVariant(locale));
     appSettings.setValue(GW_LIVE_SPELL_CHECK_KEY, QVariant(liveSpellCheckEnabled));
+    appSettings.setValue(GW_LIVE_STYLE_CHECK_KEY, QVariant(liveStyleCheckEnabled));
     appSettings.setValue(GW_EDITOR_WIDTH_KEY, QVariant(editorWidth));
     appSettings.setValue(GW_BLOCKQUOTE_STYLE_KEY, QVariant(blockquoteStyle));
     appSettings.setValue(GW_HUD_BUTTON_LAYOUT_KEY, QVariant(hudButtonLayout));
     appSettings.setValue(GW_HUD_ROW_COLORS_KEY, QVariant(alternateHudRowColorsEnabled));
     appSettings.setValue(GW_DESKTOP_COMPOSITING_KEY, QVariant(desktopCompositingEnabled));
     appSettings.setValue(GW_HUD_OPACITY_KEY, QVariant(hudOpacity));
+    appSettings.setValue(GW_REMOTE_PREVIEW_RENDERING_KEY, QVariant(remotePreviewRenderingEnabled));
     appSettings.sync();
 }
 
@@ -129,6 +141,21 @@ QString AppSettings::getDictionaryPath() const
     return dictionaryPath;
 }
 
+QString AppSettings::getHistoryDirectoryPath() const
+{
+    return historyDirectoryPath;
+}
+
+QString AppSettings::getCacheDirectoryPath() const
+{
+    return cacheDirectoryPath;
+}
+
+QStringList AppSettings::getPluginPaths() const
+{
+    return pluginPaths;
+}
+
 QString AppSettings::getTranslationsPath() const
 {
     return translationsPath;
@@ -207,6 +234,36 @@ void AppSettings::setLargeHeadingSizesEnabled(bool enabled)
     largeHeadingSizesEnabled = enabled;
 }
 
+bool AppSettings::getImagePreviewsEnabled() const
+{
+    return imagePreviewsEnabled;
+}
+
+void AppSettings::setImagePreviewsEnabled(bool enabled)
+{
+    imagePreviewsEnabled = enabled;
+}
+
+bool AppSettings::getMinimapEnabled() const
+{
+    return minimapEnabled;
+}
+
+void AppSettings::setMinimapEnabled(bool enabled)
+{
+    minimapEnabled = enabled;
+}
+
+bool AppSettings::getPaintCacheEnabled() const
+{
+    return paintCacheEnabled;
+}
+
+void AppSettings::setPaintCacheEnabled(bool enabled)
+{
+    paintCacheEnabled = enabled;
+}
+
 bool AppSettings::getAutoMatchEnabled() const
 {
     return autoMatchEnabled;
@@ -317,6 +374,16 @@ void AppSettings::setBulletPointCyclingEnabled(bool enabled)
     bulletPointCyclingEnabled = enabled;
 }
 
+bool AppSettings::getTableFormattingEnabled() const
+{
+    return tableFormattingEnabled;
+}
+
+void AppSettings::setTableFormattingEnabled(bool enabled)
+{
+    tableFormattingEnabled = enabled;
+}
+
 FocusMode AppSettings::getFocusMode() const
 {
     return focusMode;
@@ -400,6 +467,16 @@ void AppSettings::setLiveSpellCheckEnabled(bool enabled)
     liveSpellCheckEnabled = enabled;
 }
 
+bool AppSettings::getLiveStyleCheckEnabled() const
+{
+    return liveStyleCheckEnabled;
+}
+
+void AppSettings::setLiveStyleCheckEnabled(bool enabled)
+{
+    liveStyleCheckEnabled = enabled;
+}
+
 EditorWidth AppSettings::getEditorWidth() const
 {
     return editorWidth;
@@ -466,6 +543,16 @@ void AppSettings::setHudOpacity(int value)
     hudOpacity = value;
 }
 
+bool AppSettings::getRemotePreviewRenderingEnabled() const
+{
+    return remotePreviewRenderingEnabled;
+}
+
+void AppSettings::setRemotePreviewRenderingEnabled(bool enabled)
+{
+    remotePreviewRenderingEnabled = enabled;
+}
+
 AppSettings::AppSettings()
 {
     QCoreApplication::setOrganizationName("ghostwriter");
@@ -542,6 +629,41 @@ AppSettings::AppSettings()
 
     themeDirectoryPath = themeDir.absolutePath();
 
+    QDir historyDir(userDir + "/history");
+
+    if (!historyDir.exists())
+    {
+        historyDir.mkpath(historyDir.path());
+    }
+
+    historyDirectoryPath = historyDir.absolutePath();
+
+    QDir cacheDir(userDir + "/cache");
+
+    if (!cacheDir.exists())
+    {
+        cacheDir.mkpath(cacheDir.path());
+    }
+
+    cacheDirectoryPath = cacheDir.absolutePath();
+
+    // Search for exporter plugins in the user's directory first, followed by
+    // the directories into which plugins are installed alongside the
+    // executable.
+    //
+    QDir pluginDir(userDir + "/plugins");
+
+    if (!pluginDir.exists())
+    {
+        pluginDir.mkpath(pluginDir.path());
+    }
+
+    pluginPaths.append(pluginDir.absolutePath());
+    pluginPaths.append(appDir + "/plugins");
+    pluginPaths.append(appDir + "/../lib/" +
+        QCoreApplication::applicationName().toLower() + "/plugins");
+    pluginPaths.append(appDir + "/../PlugIns");
+
     QDir dictionaryDir(userDir + "/dictionaries");
 
     if (!dictionaryDir.exists())
@@ -654,6 +776,9 @@ AppSettings::AppSettings()
     insertSpacesForTabsEnabled = appSettings.value(GW_SPACES_FOR_TABS_KEY, QVariant(false)).toBool();
     useUnderlineForEmphasis = appSettings.value(GW_UNDERLINE_ITALICS_KEY, QVariant(false)).toBool();
     largeHeadingSizesEnabled = appSettings.value(GW_LARGE_HEADINGS_KEY, QVariant(true)).toBool();
+    imagePreviewsEnabled = appSettings.value(GW_IMAGE_PREVIEWS_KEY, QVariant(true)).toBool();
+    minimapEnabled = appSettings.value(GW_MINIMAP_KEY, QVariant(false)).toBool();
+    paintCacheEnabled = appSettings.value(GW_PAINT_CACHE_KEY, QVariant(false)).toBool();
     autoMatchEnabled = appSettings.value(GW_AUTO_MATCH_KEY, QVariant(true)).toBool();
     autoMatchDoubleQuotesEnabled = appSettings.value(GW_AUTO_MATCH_DOUBLE_QUOTES_KEY, QVariant(true)).toBool();
     autoMatchSingleQuotesEnabled = appSettings.value(GW_AUTO_MATCH_SINGLE_QUOTES_KEY, QVariant(true)).toBool();
@@ -665,6 +790,7 @@ AppSettings::AppSettings()
     autoMatchBackticksEnabled = appSettings.value(GW_AUTO_MATCH_BACKTICKS_KEY, QVariant(true)).toBool();
     autoMatchAngleBracketsEnabled = appSettings.value(GW_AUTO_MATCH_ANGLE_BRACKETS_KEY, QVariant(true)).toBool();
     bulletPointCyclingEnabled = appSettings.value(GW_BULLET_CYCLING_KEY, QVariant(true)).toBool();
+    tableFormattingEnabled = appSettings.value(GW_TABLE_FORMATTING_KEY, QVariant(true)).toBool();
     focusMode = (FocusMode) appSettings.value(GW_FOCUS_MODE_KEY, QVariant(FocusModeSentence)).toInt();
 
     if ((focusMode < FocusModeDisabled) || (focusMode > FocusModeParagraph))
@@ -679,6 +805,7 @@ AppSettings::AppSettings()
     dictionaryLanguage = appSettings.value(GW_DICTIONARY_KEY, QLocale().name()).toString();
     locale = appSettings.value(GW_LOCALE_KEY, QLocale().name()).toString();
     liveSpellCheckEnabled = appSettings.value(GW_LIVE_SPELL_CHECK_KEY, QVariant(true)).toBool();
+    liveStyleCheckEnabled = appSettings.value(GW_LIVE_STYLE_CHECK_KEY, QVariant(true)).toBool();
     editorWidth = (EditorWidth) appSettings.value(GW_EDITOR_WIDTH_KEY, QVariant(EditorWidthMedium)).toInt();
     blockquoteStyle = (BlockquoteStyle) appSettings.value(GW_BLOCKQUOTE_STYLE_KEY, QVariant(BlockquoteStylePlain)).toInt();
 
@@ -698,4 +825,5 @@ AppSettings::AppSettings()
     alternateHudRowColorsEnabled = appSettings.value(GW_HUD_ROW_COLORS_KEY, QVariant(false)).toBool();
     desktopCompositingEnabled = appSettings.value(GW_DESKTOP_COMPOSITING_KEY, QVariant(true)).toBool();
     hudOpacity = appSettings.value(GW_HUD_OPACITY_KEY, QVariant(200)).toInt();
+    remotePreviewRenderingEnabled = appSettings.value(GW_REMOTE_PREVIEW_RENDERING_KEY, QVariant(false)).toBool();
 }
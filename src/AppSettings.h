@@ -21,6 +21,7 @@
 #define APPSETTINGS_H
 
 #include <QString>
+#include <QStringList>
 #include <QFont>
 
 #include "MarkdownEditorTypes.h"
@@ -48,6 +49,9 @@ class AppSettings
         QString getThemeDirectoryPath() const;
         QString getDictionaryPath() const;
         QString getTranslationsPath() const;
+        QString getHistoryDirectoryPath() const;
+        QString getCacheDirectoryPath() const;
+        QStringList getPluginPaths() const;
 
         bool getAutoSaveEnabled() const;
         void setAutoSaveEnabled(bool enabled);
@@ -70,6 +74,15 @@ class AppSettings
         bool getLargeHeadingSizesEnabled() const;
         void setLargeHeadingSizesEnabled(bool enabled);
 
+        bool getImagePreviewsEnabled() const;
+        void setImagePreviewsEnabled(bool enabled);
+
+        bool getMinimapEnabled() const;
+        void setMinimapEnabled(bool enabled);
+
+        bool getPaintCacheEnabled() const;
+        void setPaintCacheEnabled(bool enabled);
+
         bool getAutoMatchEnabled() const;
         void setAutoMatchEnabled(bool enabled);
 
@@ -103,6 +116,9 @@ class AppSettings
         bool getBulletPointCyclingEnabled() const;
         void setBulletPointCyclingEnabled(bool enabled);
 
+        bool getTableFormattingEnabled() const;
+        void setTableFormattingEnabled(bool enabled);
+
         FocusMode getFocusMode() const;
         void setFocusMode(FocusMode focusMode);
 
@@ -127,6 +143,9 @@ class AppSettings
         bool getLiveSpellCheckEnabled() const;
         void setLiveSpellCheckEnabled(bool enabled);
 
+        bool getLiveStyleCheckEnabled() const;
+        void setLiveStyleCheckEnabled(bool enabled);
+
         EditorWidth getEditorWidth() const;
         void setEditorWidth(EditorWidth editorWidth);
 
@@ -145,6 +164,9 @@ class AppSettings
         int getHudOpacity() const;
         void setHudOpacity(int value);
 
+        bool getRemotePreviewRenderingEnabled() const;
+        void setRemotePreviewRenderingEnabled(bool enabled);
+
     private:
         AppSettings();
 
@@ -152,6 +174,9 @@ class AppSettings
         QString themeDirectoryPath;
         QString dictionaryPath;
         QString translationsPath;
+        QString historyDirectoryPath;
+        QString cacheDirectoryPath;
+        QStringList pluginPaths;
 
         QFont defaultFont;
         bool autoSaveEnabled;
@@ -161,6 +186,9 @@ class AppSettings
         bool insertSpacesForTabsEnabled;
         bool useUnderlineForEmphasis;
         bool largeHeadingSizesEnabled;
+        bool imagePreviewsEnabled;
+        bool minimapEnabled;
+        bool paintCacheEnabled;
         bool autoMatchEnabled;
         bool autoMatchDoubleQuotesEnabled;
         bool autoMatchSingleQuotesEnabled;
@@ -172,6 +200,7 @@ class AppSettings
         bool autoMatchBackticksEnabled;
         bool autoMatchAngleBracketsEnabled;
         bool bulletPointCyclingEnabled;
+        bool tableFormattingEnabled;
         FocusMode focusMode;
         bool hideMenuBarInFullScreenEnabled;
         bool fileHistoryEnabled;
@@ -180,12 +209,14 @@ class AppSettings
         QString dictionaryLanguage;
         QString locale;
         bool liveSpellCheckEnabled;
+        bool liveStyleCheckEnabled;
         EditorWidth editorWidth;
         BlockquoteStyle blockquoteStyle;
         HudWindowButtonLayout hudButtonLayout;
         bool alternateHudRowColorsEnabled;
         bool desktopCompositingEnabled;
         int hudOpacity;
+        bool remotePreviewRenderingEnabled;
 };
 
 #endif // APPSETTINGS_H
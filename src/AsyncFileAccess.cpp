@@ -0,0 +1,491 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <climits>
+
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QProgressDialog>
+#include <QTimer>
+#include <QWidget>
+
+#include "AsyncFileAccess.h"
+#include "TaskScheduler.h"
+
+// Default time in milliseconds after which pending operations are
+// abandoned.
+//
+#define GW_FILE_ACCESS_TIMEOUT 30000
+
+// Time in milliseconds to wait for the directory of a file dialog.  File
+// dialogs are opened often, so don't keep the user waiting for long.
+//
+#define GW_DIRECTORY_LOOKUP_TIMEOUT 2000
+
+// Time in milliseconds after which a progress dialog is shown for a pending
+// operation.
+//
+#define GW_FILE_ACCESS_PROGRESS_DELAY 500
+
+// Files are read in chunks of this many bytes, so that reads can be
+// cancelled part way through.
+//
+#define GW_FILE_READ_CHUNK_SIZE 65536
+
+int AsyncFileAccess::pendingCount = 0;
+
+AsyncFileAccess::AsyncFileAccess(QWidget* parentWidget, QObject* parent)
+    : QObject(parent), parentWidget(parentWidget),
+        timeout(GW_FILE_ACCESS_TIMEOUT), existingFilesLookupQueued(false)
+{
+    existingFilesWatcher = new QFutureWatcher<QStringList>(this);
+    connect(existingFilesWatcher, SIGNAL(finished()), this, SLOT(onExistingFilesLookupFinished()));
+}
+
+AsyncFileAccess::~AsyncFileAccess()
+{
+
+}
+
+int AsyncFileAccess::getTimeout() const
+{
+    return timeout;
+}
+
+void AsyncFileAccess::setTimeout(int milliseconds)
+{
+    timeout = milliseconds;
+}
+
+bool AsyncFileAccess::isBusy()
+{
+    return pendingCount > 0;
+}
+
+AsyncFileAccess::Result AsyncFileAccess::stat(const QString& path, FileStatus& status)
+{
+    if (isBusy())
+    {
+        return Cancelled;
+    }
+
+    TaskOptions options(TaskPriorityInteractive);
+    QFuture<FileStatus> future =
+        TaskScheduler::getInstance()->run(options, &AsyncFileAccess::statPath, path);
+
+    Result result = waitForFuture(future, tr("Waiting for %1...").arg(path));
+
+    if (Succeeded == result)
+    {
+        status = future.result();
+    }
+
+    return result;
+}
+
+AsyncFileAccess::Result AsyncFileAccess::readFile
+(
+    const QString& path,
+    QByteArray& contents,
+    FileStatus& status,
+    QString& err
+)
+{
+    if (isBusy())
+    {
+        return Cancelled;
+    }
+
+    TaskOptions options(TaskPriorityInteractive);
+
+    QFuture<ReadResult> future =
+        TaskScheduler::getInstance()->run(options, &AsyncFileAccess::readPath, path);
+
+    Result result = waitForFuture(future, tr("Reading %1...").arg(path));
+
+    if (Succeeded == result)
+    {
+        ReadResult readResult = future.result();
+
+        status = readResult.status;
+
+        if (!readResult.error.isNull())
+        {
+            err = readResult.error;
+            return Failed;
+        }
+
+        contents = readResult.contents;
+    }
+    else
+    {
+        // Stop reading at the next chunk, in case the file system is slow
+        // rather than hung.
+        //
+        options.token.cancel();
+
+        if (TimedOut == result)
+        {
+            err = tr("The file system did not respond within %n second(s).", "", timeout / 1000);
+        }
+    }
+
+    return result;
+}
+
+AsyncFileAccess::Result AsyncFileAccess::removeFile(const QString& path, bool forceWritable)
+{
+    if (isBusy())
+    {
+        return Cancelled;
+    }
+
+    TaskOptions options(TaskPriorityInteractive);
+    QFuture<bool> future =
+        TaskScheduler::getInstance()->run(options, &AsyncFileAccess::removePath, path, forceWritable);
+
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>();
+    watcher->setFuture(future);
+
+    Result result =
+        waitFor(watcher, tr("Removing %1...").arg(path), timeout, false);
+
+    if ((Succeeded == result) && !future.result())
+    {
+        result = Failed;
+    }
+
+    return result;
+}
+
+AsyncFileAccess::Result AsyncFileAccess::renameFile
+(
+    const QString& oldPath,
+    const QString& newPath,
+    QString& err
+)
+{
+    if (isBusy())
+    {
+        return Cancelled;
+    }
+
+    TaskOptions options(TaskPriorityInteractive);
+
+    QFuture<QString> future =
+        TaskScheduler::getInstance()->run(options, &AsyncFileAccess::renamePath, oldPath, newPath);
+
+    QFutureWatcher<QString>* watcher = new QFutureWatcher<QString>();
+    watcher->setFuture(future);
+
+    Result result =
+        waitFor(watcher, tr("Renaming %1...").arg(oldPath), timeout, false);
+
+    if (Succeeded == result)
+    {
+        err = future.result();
+
+        if (!err.isNull())
+        {
+            result = Failed;
+        }
+    }
+
+    return result;
+}
+
+void AsyncFileAccess::findExistingFiles(const QStringList& paths)
+{
+    // Rather than start another lookup behind one that may be stuck on an
+    // unresponsive file system, wait for it to finish first.
+    //
+    if (existingFilesWatcher->isRunning())
+    {
+        queuedExistingFilesPaths = paths;
+        existingFilesLookupQueued = true;
+        return;
+    }
+
+    TaskOptions options(TaskPriorityInteractive);
+
+    existingFilesWatcher->setFuture
+    (
+        TaskScheduler::getInstance()->run(options, &AsyncFileAccess::filterExistingPaths, paths)
+    );
+}
+
+QString AsyncFileAccess::startingDirectory(const QString& filePath)
+{
+    if (filePath.isNull() || filePath.isEmpty())
+    {
+        return QString();
+    }
+
+    if (isBusy())
+    {
+        return QString();
+    }
+
+    QString directoryPath = QFileInfo(filePath).dir().path();
+    TaskOptions options(TaskPriorityInteractive);
+
+    QFuture<FileStatus> future =
+        TaskScheduler::getInstance()->run(options, &AsyncFileAccess::statPath, directoryPath);
+
+    QFutureWatcher<FileStatus>* watcher = new QFutureWatcher<FileStatus>();
+    watcher->setFuture(future);
+
+    Result result =
+        waitFor
+        (
+            watcher,
+            tr("Waiting for %1...").arg(directoryPath),
+            qMin(timeout, GW_DIRECTORY_LOOKUP_TIMEOUT)
+        );
+
+    if ((Succeeded == result) && !future.isCanceled() && future.result().isDir)
+    {
+        return directoryPath;
+    }
+
+    return QString();
+}
+
+AsyncFileAccess::Result AsyncFileAccess::waitFor
+(
+    QFutureWatcherBase* watcher,
+    const QString& description,
+    int timeout,
+    bool abandonable
+)
+{
+    if (watcher->isFinished())
+    {
+        delete watcher;
+        return Succeeded;
+    }
+
+    pendingCount++;
+
+    QEventLoop loop;
+    QTimer timeoutTimer;
+    QTimer progressTimer;
+
+    timeoutTimer.setSingleShot(true);
+    progressTimer.setSingleShot(true);
+
+    connect(watcher, SIGNAL(finished()), &loop, SLOT(quit()));
+    connect(&timeoutTimer, SIGNAL(timeout()), &loop, SLOT(quit()));
+    connect(&progressTimer, SIGNAL(timeout()), &loop, SLOT(quit()));
+
+    if (abandonable)
+    {
+        timeoutTimer.start(timeout);
+    }
+
+    progressTimer.start(GW_FILE_ACCESS_PROGRESS_DELAY);
+
+    // Most operations finish before the progress dialog would appear, so
+    // hold back user input in the meantime rather than flash a dialog.
+    //
+    loop.exec(QEventLoop::ExcludeUserInputEvents);
+
+    bool cancelled = false;
+
+    if (!watcher->isFinished() && (timeoutTimer.isActive() || !abandonable))
+    {
+        QProgressDialog progressDialog
+        (
+            description,
+            tr("Cancel"),
+            0,
+            0,
+            parentWidget
+        );
+
+        progressDialog.setWindowModality(Qt::WindowModal);
+        progressDialog.setMinimumDuration(0);
+
+        if (abandonable)
+        {
+            connect(&progressDialog, SIGNAL(canceled()), &loop, SLOT(quit()));
+        }
+        else
+        {
+            // Closing the dialog with the Escape key still cancels it, so
+            // bring it back until the operation finishes.
+            //
+            progressDialog.setCancelButton(NULL);
+            connect(&progressDialog, SIGNAL(canceled()), &progressDialog, SLOT(show()));
+        }
+
+        progressDialog.show();
+
+        loop.exec();
+
+        cancelled = progressDialog.wasCanceled();
+    }
+
+    pendingCount--;
+
+    if (watcher->isFinished())
+    {
+        delete watcher;
+        return Succeeded;
+    }
+
+    // The worker thread is most likely blocked in a system call that can't
+    // be interrupted.  Leave it to finish in the background, and let the
+    // scheduler start another worker in its place until it does.
+    //
+    connect(watcher, SIGNAL(finished()), this, SLOT(onAbandonedOperationFinished()));
+    connect(watcher, SIGNAL(finished()), watcher, SLOT(deleteLater()));
+    TaskScheduler::getInstance()->startExtraWorker();
+
+    if (cancelled)
+    {
+        return Cancelled;
+    }
+
+    return TimedOut;
+}
+
+void AsyncFileAccess::onAbandonedOperationFinished()
+{
+    TaskScheduler::getInstance()->retireExtraWorker();
+}
+
+void AsyncFileAccess::onExistingFilesLookupFinished()
+{
+    // Only report the latest lookup's result.
+    if (existingFilesLookupQueued)
+    {
+        existingFilesLookupQueued = false;
+        findExistingFiles(queuedExistingFilesPaths);
+        queuedExistingFilesPaths.clear();
+        return;
+    }
+
+    emit existingFilesFound(existingFilesWatcher->result());
+}
+
+FileStatus AsyncFileAccess::statPath(const QString& path)
+{
+    FileStatus status;
+    QFileInfo fileInfo(path);
+
+    status.exists = fileInfo.exists();
+
+    if (status.exists)
+    {
+        status.isDir = fileInfo.isDir();
+        status.readable = fileInfo.isReadable();
+        status.writable = fileInfo.isWritable();
+        status.size = fileInfo.size();
+        status.lastModified = fileInfo.lastModified();
+        status.canonicalFilePath = fileInfo.canonicalFilePath();
+    }
+
+    return status;
+}
+
+AsyncFileAccess::ReadResult AsyncFileAccess::readPath(const QString& path)
+{
+    ReadResult result;
+    CancellationToken token = CancellationToken::current();
+    result.status = statPath(path);
+
+    QFile inputFile(path);
+
+    if (!inputFile.open(QIODevice::ReadOnly))
+    {
+        result.error = inputFile.errorString();
+        return result;
+    }
+
+    if ((result.status.size > 0) && (result.status.size < INT_MAX))
+    {
+        result.contents.reserve((int) result.status.size);
+    }
+
+    while (!token.isCancelled())
+    {
+        QByteArray chunk = inputFile.read(GW_FILE_READ_CHUNK_SIZE);
+
+        if (QFile::NoError != inputFile.error())
+        {
+            result.error = inputFile.errorString();
+            break;
+        }
+
+        if (chunk.isEmpty())
+        {
+            break;
+        }
+
+        result.contents.append(chunk);
+    }
+
+    inputFile.close();
+    return result;
+}
+
+bool AsyncFileAccess::removePath(const QString& path, bool forceWritable)
+{
+    QFile file(path);
+
+    if (file.remove())
+    {
+        return true;
+    }
+
+    return forceWritable
+        && file.setPermissions(QFile::WriteUser | QFile::ReadUser)
+        && file.remove();
+}
+
+QString AsyncFileAccess::renamePath(const QString& oldPath, const QString& newPath)
+{
+    QFile file(oldPath);
+
+    if (!file.rename(newPath))
+    {
+        return file.errorString();
+    }
+
+    return QString();
+}
+
+QStringList AsyncFileAccess::filterExistingPaths(const QStringList& paths)
+{
+    QStringList existingPaths;
+
+    foreach (const QString& path, paths)
+    {
+        if (QFileInfo(path).exists())
+        {
+            existingPaths.append(path);
+        }
+    }
+
+    return existingPaths;
+}
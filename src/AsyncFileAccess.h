@@ -0,0 +1,272 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef ASYNCFILEACCESS_H
+#define ASYNCFILEACCESS_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QDateTime>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QString>
+#include <QStringList>
+
+class QWidget;
+
+/**
+ * Information about a file or directory, as gathered by AsyncFileAccess.
+ */
+struct FileStatus
+{
+    FileStatus()
+        : exists(false), isDir(false), readable(false), writable(false),
+            size(0)
+    {
+
+    }
+
+    bool exists;
+    bool isDir;
+    bool readable;
+    bool writable;
+    qint64 size;
+    QDateTime lastModified;
+    QString canonicalFilePath;
+};
+
+/**
+ * Performs file system operations on a worker thread on behalf of the GUI
+ * thread, so that slow or unresponsive file systems (such as SSHFS or NFS
+ * mounts) cannot freeze the application.
+ *
+ * Most operations appear synchronous to the caller, which makes them easy
+ * to use from existing code paths.  However, while an operation is pending,
+ * the caller waits in a local event loop, so that the application keeps
+ * repainting.  If the operation takes longer than a moment, a progress
+ * dialog is displayed from which the user can cancel the operation.  If
+ * the operation takes longer than the timeout, it is abandoned.  An
+ * abandoned operation is left to finish in the background, and its result
+ * is discarded.  Operations that modify the file system (removing and
+ * renaming files) are never abandoned, since the caller could not tell
+ * whether they took place.
+ *
+ * Note that user input to the application is held back until the progress
+ * dialog appears, and that the progress dialog is window modal, so that the
+ * user cannot start another operation while one is pending.  However,
+ * other events such as timers are still processed.  To keep the handlers
+ * of such events from nesting another wait inside the pending one, every
+ * synchronous operation returns Cancelled without starting while any
+ * operation is pending, in any instance.  Callers that would rather not
+ * be refused should check isBusy() first.  The lookup of existing files,
+ * which is needed at startup and after every file is closed, is
+ * asynchronous instead, and reports its result with a signal.
+ */
+class AsyncFileAccess : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Outcome of a file operation.
+         */
+        enum Result
+        {
+            Succeeded,
+            Failed,
+            TimedOut,
+            Cancelled
+        };
+
+        /**
+         * Constructor.  Takes the widget over which to display progress
+         * as a parameter.
+         */
+        AsyncFileAccess(QWidget* parentWidget, QObject* parent = NULL);
+
+        /**
+         * Destructor.
+         */
+        virtual ~AsyncFileAccess();
+
+        /**
+         * Gets the time in milliseconds after which pending operations are
+         * abandoned.
+         */
+        int getTimeout() const;
+
+        /**
+         * Sets the time in milliseconds after which pending operations are
+         * abandoned.
+         */
+        void setTimeout(int milliseconds);
+
+        /**
+         * Returns true if a synchronous operation is pending in any
+         * instance.
+         */
+        static bool isBusy();
+
+        /**
+         * Gets the status of the file or directory at the given path.
+         */
+        Result stat(const QString& path, FileStatus& status);
+
+        /**
+         * Reads the entire contents of the file at the given path, along
+         * with its status.  Sets err to a description of the error if the
+         * result is Failed or TimedOut.
+         */
+        Result readFile
+        (
+            const QString& path,
+            QByteArray& contents,
+            FileStatus& status,
+            QString& err
+        );
+
+        /**
+         * Removes the file at the given path.  If forceWritable is true and
+         * the file cannot be removed, the file is first made writable by the
+         * user, and removal is attempted again.  Waits for the removal to
+         * finish however long it takes, without offering to cancel it.
+         */
+        Result removeFile(const QString& path, bool forceWritable);
+
+        /**
+         * Renames the file at the given path to the new path.  Sets err to
+         * a description of the error if the result is Failed.  Waits for
+         * the rename to finish however long it takes, without offering to
+         * cancel it.
+         */
+        Result renameFile
+        (
+            const QString& oldPath,
+            const QString& newPath,
+            QString& err
+        );
+
+        /**
+         * Looks up which of the paths in the given list refer to existing
+         * files without waiting for the result, which is reported by the
+         * existingFilesFound() signal.  If a lookup is already pending,
+         * this one starts once it finishes, and the pending lookup's result
+         * is discarded.
+         */
+        void findExistingFiles(const QStringList& paths);
+
+        /**
+         * Returns the directory containing the given file path, for use as
+         * the starting directory of a file dialog, or a null string if the
+         * directory does not exist or does not respond promptly.  (A file
+         * dialog started in an unresponsive directory will hang.)
+         */
+        QString startingDirectory(const QString& filePath);
+
+        /**
+         * Waits for the given future to finish, displaying the given
+         * description to the user should the wait take a while.  Returns
+         * Succeeded once the future has finished, or Cancelled if the future
+         * was cancelled or if another operation is pending.
+         */
+        template <class T>
+        Result waitForFuture(const QFuture<T>& future, const QString& description);
+
+    signals:
+        /**
+         * Emitted when a lookup started with findExistingFiles() finishes.
+         * Takes the paths that refer to existing files, in the same order
+         * as they were given, as a parameter.
+         */
+        void existingFilesFound(const QStringList& paths);
+
+    private slots:
+        void onAbandonedOperationFinished();
+        void onExistingFilesLookupFinished();
+
+    private:
+        struct ReadResult
+        {
+            QByteArray contents;
+            FileStatus status;
+            QString error;
+        };
+
+        // Number of synchronous operations pending in all instances.
+        static int pendingCount;
+
+        QWidget* parentWidget;
+        int timeout;
+        QFutureWatcher<QStringList>* existingFilesWatcher;
+        QStringList queuedExistingFilesPaths;
+        bool existingFilesLookupQueued;
+
+        /*
+         * Waits for the given watcher's future to finish, for at most the
+         * given timeout.  If abandonable is false, waits until the future
+         * finishes, without offering to cancel it.  Takes ownership of the
+         * watcher.
+         */
+        Result waitFor
+        (
+            QFutureWatcherBase* watcher,
+            const QString& description,
+            int timeout,
+            bool abandonable = true
+        );
+
+        /*
+         * The following methods perform the actual file operations on the
+         * worker thread.
+         */
+        static FileStatus statPath(const QString& path);
+        static ReadResult readPath(const QString& path);
+        static bool removePath(const QString& path, bool forceWritable);
+        static QString renamePath(const QString& oldPath, const QString& newPath);
+        static QStringList filterExistingPaths(const QStringList& paths);
+};
+
+template <class T>
+AsyncFileAccess::Result AsyncFileAccess::waitForFuture
+(
+    const QFuture<T>& future,
+    const QString& description
+)
+{
+    if (isBusy())
+    {
+        return Cancelled;
+    }
+
+    QFutureWatcher<T>* watcher = new QFutureWatcher<T>();
+    watcher->setFuture(future);
+
+    Result result = waitFor(watcher, description, timeout);
+
+    // Cancelled futures have no result.
+    if ((Succeeded == result) && future.isCanceled())
+    {
+        result = Cancelled;
+    }
+
+    return result;
+}
+
+#endif // ASYNCFILEACCESS_H
@@ -0,0 +1,267 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QApplication>
+#include <QCryptographicHash>
+#include <QDesktopWidget>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QRect>
+
+#include "BackgroundImageLoader.h"
+#include "TaskScheduler.h"
+
+// Quality of cached images saved as JPEG, which is used for images
+// without an alpha channel.  Images with one are cached as PNG.
+//
+#define GW_BACKGROUND_CACHE_JPEG_QUALITY 92
+
+BackgroundImageLoader::BackgroundImageLoader
+(
+    const QString& cacheDirectoryPath,
+    QObject* parent
+)
+    : QObject(parent),
+    cacheDirectoryPath(cacheDirectoryPath),
+    currentLoad(NULL)
+{
+
+}
+
+BackgroundImageLoader::~BackgroundImageLoader()
+{
+
+}
+
+void BackgroundImageLoader::load(const Theme& theme, const QSize& maxSize)
+{
+    LoadRequest request;
+    request.imagePath = theme.getBackgroundImageUrl();
+    request.aspect = theme.getBackgroundImageAspect();
+    request.maxSize = maxSize;
+
+    // Cached images are named after the theme, so that each theme only
+    // ever has one, and after everything the cached image depends on.
+    //
+    QByteArray themeHash =
+        QCryptographicHash::hash
+        (
+            theme.getName().toUtf8(),
+            QCryptographicHash::Md5
+        ).toHex();
+
+    QByteArray requestHash =
+        QCryptographicHash::hash
+        (
+            QString("%1|%2|%3x%4")
+                .arg(request.imagePath)
+                .arg((int) request.aspect)
+                .arg(maxSize.width())
+                .arg(maxSize.height())
+                .toUtf8(),
+            QCryptographicHash::Md5
+        ).toHex();
+
+    request.cacheFilePath =
+        cacheDirectoryPath + "/" + themeHash + "-" + requestHash;
+
+    // The result of a load that is still running is ignored once it
+    // finishes.
+    //
+    currentLoad = new QFutureWatcher<LoadResult>(this);
+    connect(currentLoad, SIGNAL(finished()), this, SLOT(onLoadFinished()));
+
+    currentLoad->setFuture
+    (
+        TaskScheduler::getInstance()->run
+        (
+            TaskOptions(TaskPriorityNormal),
+            &BackgroundImageLoader::decode,
+            request
+        )
+    );
+}
+
+QSize BackgroundImageLoader::largestScreenSize()
+{
+    QDesktopWidget* desktop = QApplication::desktop();
+    QSize size;
+
+    for (int i = 0; i < desktop->screenCount(); i++)
+    {
+        size = size.expandedTo(desktop->screenGeometry(i).size());
+    }
+
+    return size;
+}
+
+void BackgroundImageLoader::onLoadFinished()
+{
+    QFutureWatcher<LoadResult>* watcher =
+        static_cast<QFutureWatcher<LoadResult>*>(sender());
+
+    watcher->deleteLater();
+
+    if (watcher != currentLoad)
+    {
+        return;
+    }
+
+    currentLoad = NULL;
+
+    LoadResult result = watcher->result();
+    emit imageLoaded(result.imagePath, result.aspect, result.image);
+}
+
+BackgroundImageLoader::LoadResult BackgroundImageLoader::decode
+(
+    const LoadRequest& request
+)
+{
+    LoadResult result;
+    result.imagePath = request.imagePath;
+    result.aspect = request.aspect;
+
+    QFileInfo sourceInfo(request.imagePath);
+    QDir cacheDir = QFileInfo(request.cacheFilePath).absoluteDir();
+    QString cacheFileName = QFileInfo(request.cacheFilePath).fileName();
+    QStringList cachedFiles =
+        cacheDir.entryList(QStringList(cacheFileName + ".*"), QDir::Files);
+
+    // Use the cached image as long as it is newer than the original.
+    // Images from resources have no modification time, and never change.
+    //
+    if (!cachedFiles.isEmpty())
+    {
+        QFileInfo cacheInfo(cacheDir.filePath(cachedFiles.first()));
+
+        if
+        (
+            !sourceInfo.lastModified().isValid() ||
+            (cacheInfo.lastModified() >= sourceInfo.lastModified())
+        )
+        {
+            result.image = QImage(cacheInfo.absoluteFilePath());
+
+            if (!result.image.isNull())
+            {
+                return result;
+            }
+        }
+    }
+
+    result.image = decodeFromSource(request);
+
+    if (result.image.isNull())
+    {
+        return result;
+    }
+
+    // Replace any image cached for the theme before.
+    QString themePrefix = cacheFileName.section('-', 0, 0) + "-*";
+
+    foreach (const QString& fileName, cacheDir.entryList(QStringList(themePrefix), QDir::Files))
+    {
+        cacheDir.remove(fileName);
+    }
+
+    if (cacheDir.exists() || cacheDir.mkpath(cacheDir.absolutePath()))
+    {
+        if (result.image.hasAlphaChannel())
+        {
+            result.image.save(request.cacheFilePath + ".png", "PNG");
+        }
+        else
+        {
+            result.image.save
+            (
+                request.cacheFilePath + ".jpg",
+                "JPG",
+                GW_BACKGROUND_CACHE_JPEG_QUALITY
+            );
+        }
+    }
+
+    return result;
+}
+
+QImage BackgroundImageLoader::decodeFromSource(const LoadRequest& request)
+{
+    QImageReader reader(request.imagePath);
+    QSize size = reader.size();
+    QSize maxSize = request.maxSize;
+
+    if (!size.isValid() || !maxSize.isValid())
+    {
+        return reader.read();
+    }
+
+    switch (request.aspect)
+    {
+        case PictureAspectTile:
+            // Only the top left of a large tile is ever seen.
+            if ((size.width() > maxSize.width()) || (size.height() > maxSize.height()))
+            {
+                reader.setClipRect(QRect(QPoint(0, 0), size.boundedTo(maxSize)));
+            }
+            break;
+        case PictureAspectStretch:
+        case PictureAspectScale:
+        case PictureAspectZoom:
+            // Let the image reader scale the image while decoding it, which
+            // for JPEG images in particular is far faster than decoding the
+            // full image and scaling it afterwards.  The image still needs
+            // to cover the screen after it is scaled to the window, which
+            // may crop it.
+            //
+            if ((size.width() > maxSize.width()) && (size.height() > maxSize.height()))
+            {
+                reader.setScaledSize
+                (
+                    size.scaled(maxSize, Qt::KeepAspectRatioByExpanding)
+                );
+            }
+            break;
+        default:
+            // Centered images are drawn as they are, so only the middle of
+            // a large image is ever seen.
+            //
+            if ((size.width() > maxSize.width()) || (size.height() > maxSize.height()))
+            {
+                QSize clipSize = size.boundedTo(maxSize);
+
+                reader.setClipRect
+                (
+                    QRect
+                    (
+                        QPoint
+                        (
+                            (size.width() - clipSize.width()) / 2,
+                            (size.height() - clipSize.height()) / 2
+                        ),
+                        clipSize
+                    )
+                );
+            }
+            break;
+    }
+
+    return reader.read();
+}
@@ -0,0 +1,105 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef BACKGROUNDIMAGELOADER_H
+#define BACKGROUNDIMAGELOADER_H
+
+#include <QFutureWatcher>
+#include <QImage>
+#include <QObject>
+#include <QSize>
+#include <QString>
+
+#include "Theme.h"
+
+/**
+ * Loads the background images of themes on a worker thread via the
+ * TaskScheduler, so that switching themes never stalls the GUI.
+ *
+ * Images are only decoded at the resolution needed to cover the largest
+ * screen: images that are scaled to the window are scaled down while they
+ * are decoded, and images that are tiled or centered are clipped to the
+ * part that can be seen.  The result is cached on disk, with one cached
+ * image per theme, and is used in place of the original image for as long
+ * as the original image file is unchanged.
+ */
+class BackgroundImageLoader : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Takes the path of the directory in which to cache
+         * the decoded images as a parameter.
+         */
+        BackgroundImageLoader(const QString& cacheDirectoryPath, QObject* parent = 0);
+
+        /**
+         * Destructor.
+         */
+        ~BackgroundImageLoader();
+
+        /**
+         * Starts loading the given theme's background image, such that it
+         * covers an area of the given size when drawn with the theme's
+         * picture aspect.  Emits imageLoaded() once the image is ready.  Any
+         * load still in progress is abandoned.
+         */
+        void load(const Theme& theme, const QSize& maxSize);
+
+        /**
+         * Returns the size of the area that background images must cover,
+         * which is the size of the largest screen.
+         */
+        static QSize largestScreenSize();
+
+    signals:
+        /**
+         * Emitted when the image at the given path has been loaded for the
+         * given picture aspect.  The image is null if it could not be read.
+         */
+        void imageLoaded(const QString& imagePath, PictureAspect aspect, const QImage& image);
+
+    private slots:
+        void onLoadFinished();
+
+    private:
+        struct LoadRequest
+        {
+            QString imagePath;
+            QString cacheFilePath;
+            PictureAspect aspect;
+            QSize maxSize;
+        };
+
+        struct LoadResult
+        {
+            QString imagePath;
+            PictureAspect aspect;
+            QImage image;
+        };
+
+        QString cacheDirectoryPath;
+        QFutureWatcher<LoadResult>* currentLoad;
+
+        static LoadResult decode(const LoadRequest& request);
+        static QImage decodeFromSource(const LoadRequest& request);
+};
+
+#endif // BACKGROUNDIMAGELOADER_H
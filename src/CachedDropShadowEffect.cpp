@@ -0,0 +1,235 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <QPainter>
+#include <QTransform>
+
+#include "CachedDropShadowEffect.h"
+
+// Number of box blur passes, which together approximate a Gaussian blur.
+#define GW_SHADOW_BLUR_PASSES 3
+
+CachedDropShadowEffect::CachedDropShadowEffect(QObject* parent)
+    : QGraphicsEffect(parent)
+{
+    color = QColor(63, 63, 63, 180);
+    blurRadius = 1.0;
+    offset = QPointF(8.0, 8.0);
+}
+
+CachedDropShadowEffect::~CachedDropShadowEffect()
+{
+
+}
+
+void CachedDropShadowEffect::setColor(const QColor& color)
+{
+    this->color = color;
+    invalidate();
+    update();
+}
+
+void CachedDropShadowEffect::setBlurRadius(qreal radius)
+{
+    blurRadius = radius;
+    invalidate();
+    updateBoundingRect();
+}
+
+void CachedDropShadowEffect::setOffset(qreal dx, qreal dy)
+{
+    offset = QPointF(dx, dy);
+    invalidate();
+    updateBoundingRect();
+}
+
+QRectF CachedDropShadowEffect::boundingRectFor(const QRectF& rect) const
+{
+    // Each blur pass spreads the shadow by the box radius.
+    qreal spread = GW_SHADOW_BLUR_PASSES * boxRadius();
+
+    return rect.united
+        (
+            rect.translated(offset).adjusted(-spread, -spread, spread, spread)
+        );
+}
+
+void CachedDropShadowEffect::draw(QPainter* painter)
+{
+    if (0 == color.alpha())
+    {
+        drawSource(painter);
+        return;
+    }
+
+    QRect sourceRect = sourceBoundingRect(Qt::DeviceCoordinates).toAlignedRect();
+
+    if (sourceRect.isEmpty())
+    {
+        return;
+    }
+
+    if (sourceRect.size() != cachedSize)
+    {
+        updateShadow(sourceRect.size());
+    }
+
+    int spread = GW_SHADOW_BLUR_PASSES * boxRadius();
+    QTransform restoreTransform = painter->worldTransform();
+
+    painter->setWorldTransform(QTransform());
+    painter->drawImage
+    (
+        sourceRect.topLeft() + offset.toPoint() - QPoint(spread, spread),
+        cachedShadow
+    );
+    painter->setWorldTransform(restoreTransform);
+
+    drawSource(painter);
+}
+
+int CachedDropShadowEffect::boxRadius() const
+{
+    // Three box blur passes of radius r have the variance of a Gaussian
+    // blur with a standard deviation of roughly sqrt(r * (r + 1)).
+    //
+    return qMax(1, qRound(blurRadius / GW_SHADOW_BLUR_PASSES));
+}
+
+void CachedDropShadowEffect::invalidate()
+{
+    cachedShadow = QImage();
+    cachedSize = QSize();
+}
+
+void CachedDropShadowEffect::updateShadow(const QSize& size)
+{
+    // The blur of a rectangle is the product of the blurs of its width and
+    // of its height, so only two lines need to be blurred.
+    //
+    int spread = GW_SHADOW_BLUR_PASSES * boxRadius();
+    QVector<int> columns = blurredProfile(size.width(), spread);
+    QVector<int> rows = blurredProfile(size.height(), spread);
+    int red = color.red();
+    int green = color.green();
+    int blue = color.blue();
+    int colorAlpha = color.alpha();
+
+    cachedSize = size;
+    cachedShadow =
+        QImage
+        (
+            columns.size(),
+            rows.size(),
+            QImage::Format_ARGB32_Premultiplied
+        );
+
+    for (int y = 0; y < rows.size(); y++)
+    {
+        QRgb* line = (QRgb*) cachedShadow.scanLine(y);
+
+        for (int x = 0; x < columns.size(); x++)
+        {
+            int a = (columns[x] * rows[y] * colorAlpha) / (255 * 255);
+
+            line[x] =
+                qRgba
+                (
+                    (red * a) / 255,
+                    (green * a) / 255,
+                    (blue * a) / 255,
+                    a
+                );
+        }
+    }
+
+    // Leave out the part of the shadow that the widget covers.
+    QPainter painter(&cachedShadow);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect
+    (
+        QRect(QPoint(spread, spread) - offset.toPoint(), size),
+        Qt::transparent
+    );
+}
+
+/*
+ * Returns the alpha values along a line through the shadow of a widget of
+ * the given length, padded by spread on either side, after blurring.
+ */
+QVector<int> CachedDropShadowEffect::blurredProfile(int length, int spread) const
+{
+    int count = length + (2 * spread);
+    QVector<int> values(count, 0);
+    QVector<int> buffer(count);
+
+    for (int i = spread; i < (spread + length); i++)
+    {
+        values[i] = 255;
+    }
+
+    for (int pass = 0; pass < GW_SHADOW_BLUR_PASSES; pass++)
+    {
+        boxBlur(values.data(), buffer.data(), count, 1, boxRadius());
+    }
+
+    return values;
+}
+
+void CachedDropShadowEffect::boxBlur
+(
+    int* values,
+    int* buffer,
+    int count,
+    int stride,
+    int radius
+)
+{
+    // Running sum over a window of 2 * radius + 1 values, where values
+    // outside the line are transparent.
+    //
+    int windowSize = (2 * radius) + 1;
+    int sum = 0;
+
+    for (int i = 0; (i < radius) && (i < count); i++)
+    {
+        sum += values[i * stride];
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if ((i + radius) < count)
+        {
+            sum += values[(i + radius) * stride];
+        }
+
+        if ((i - radius - 1) >= 0)
+        {
+            sum -= values[(i - radius - 1) * stride];
+        }
+
+        buffer[i] = sum / windowSize;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        values[i * stride] = buffer[i];
+    }
+}
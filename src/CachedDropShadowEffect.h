@@ -0,0 +1,103 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef CACHEDDROPSHADOWEFFECT_H
+#define CACHEDDROPSHADOWEFFECT_H
+
+#include <QColor>
+#include <QGraphicsEffect>
+#include <QImage>
+#include <QPointF>
+#include <QSize>
+#include <QVector>
+
+/**
+ * Drop shadow effect for window chrome, such as the menu bar and status
+ * bar, whose contents change often.
+ *
+ * Unlike QGraphicsDropShadowEffect, which renders the widget offscreen and
+ * blurs it every time it is repainted, this effect casts the shadow of the
+ * widget's rectangle, which does not depend on its contents.  The blurred
+ * shadow is cached, and is only blurred again when the widget is resized
+ * or the theme changes the shadow's color, blur radius or offset.  The
+ * widget itself is painted directly, and the shadow is left out from
+ * underneath it, so that widgets with a transparent background are not
+ * darkened.
+ */
+class CachedDropShadowEffect : public QGraphicsEffect
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.
+         */
+        CachedDropShadowEffect(QObject* parent = 0);
+
+        /**
+         * Destructor.
+         */
+        virtual ~CachedDropShadowEffect();
+
+        /**
+         * Sets the shadow color.
+         */
+        void setColor(const QColor& color);
+
+        /**
+         * Sets the blur radius of the shadow, in pixels.
+         */
+        void setBlurRadius(qreal radius);
+
+        /**
+         * Sets the offset of the shadow from the widget's contents, in
+         * pixels.
+         */
+        void setOffset(qreal dx, qreal dy);
+
+        /**
+         * Overridden to make room for the shadow.
+         */
+        QRectF boundingRectFor(const QRectF& rect) const;
+
+    protected:
+        /**
+         * Overridden method to draw the effect.
+         */
+        void draw(QPainter* painter);
+
+    private:
+        QColor color;
+        qreal blurRadius;
+        QPointF offset;
+
+        // Shadow for the widget size it was last drawn for, and that size.
+        QImage cachedShadow;
+        QSize cachedSize;
+
+        int boxRadius() const;
+        void invalidate();
+        void updateShadow(const QSize& size);
+        QVector<int> blurredProfile(int length, int spread) const;
+
+        static void boxBlur(int* values, int* buffer, int count, int stride, int radius);
+};
+
+#endif // CACHEDDROPSHADOWEFFECT_H
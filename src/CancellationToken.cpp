@@ -0,0 +1,48 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include "CancellationToken.h"
+#include "TaskScheduler.h"
+
+CancellationToken::CancellationToken()
+    : cancelled(new QAtomicInt(0))
+{
+
+}
+
+CancellationToken::~CancellationToken()
+{
+
+}
+
+void CancellationToken::cancel()
+{
+    cancelled->fetchAndStoreOrdered(1);
+}
+
+bool CancellationToken::isCancelled() const
+{
+    return 0 != cancelled->fetchAndAddOrdered(0);
+}
+
+CancellationToken CancellationToken::current()
+{
+    return TaskScheduler::currentCancellationToken();
+}
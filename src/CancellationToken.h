@@ -0,0 +1,71 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef CANCELLATIONTOKEN_H
+#define CANCELLATIONTOKEN_H
+
+#include <QAtomicInt>
+#include <QSharedPointer>
+
+/**
+ * Shared flag with which the owner of a background task can ask the task
+ * to stop.  Copies of a token share the same flag, so a token can be kept
+ * by the owner and handed to the TaskScheduler along with the task.
+ *
+ * Tasks that have been cancelled before starting are never run.  Long
+ * running tasks should check CancellationToken::current() periodically
+ * and return early once it is cancelled.  This class is thread-safe.
+ */
+class CancellationToken
+{
+    public:
+        /**
+         * Constructor.  Creates a new token that has not been cancelled.
+         */
+        CancellationToken();
+
+        /**
+         * Destructor.
+         */
+        ~CancellationToken();
+
+        /**
+         * Requests that all tasks sharing this token stop.
+         */
+        void cancel();
+
+        /**
+         * Returns true if cancel() has been called on this token or any of
+         * its copies.
+         */
+        bool isCancelled() const;
+
+        /**
+         * Returns the token of the task running on the calling thread, or
+         * a token that is never cancelled if the calling thread is not
+         * running a task for the TaskScheduler.
+         */
+        static CancellationToken current();
+
+    private:
+        QSharedPointer<QAtomicInt> cancelled;
+};
+
+#endif // CANCELLATIONTOKEN_H
@@ -0,0 +1,110 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QObject>
+
+#include "CommonMarkExporter.h"
+#include "CommonMarkParser.h"
+
+#include "sundown/html.h"
+#include "sundown/buffer.h"
+
+CommonMarkExporter::CommonMarkExporter() : Exporter("CommonMark (GitHub)")
+{
+    supportedFormats.append(ExportFormat::HTML);
+    selfContainedHtmlSupported = true;
+}
+
+CommonMarkExporter::~CommonMarkExporter()
+{
+
+}
+
+void CommonMarkExporter::exportToHtml(const QString& text, QString& html)
+{
+    QByteArray utf8Text = text.toUtf8();
+    struct buf* htmlOutputBuffer = bufnew(utf8Text.length() + 1024);
+
+    // The live preview renders on a worker thread, so use a separate parser
+    // for each export.  Construction is cheap, since no memory is allocated
+    // for the document until parsing begins.
+    //
+    CommonMarkParser parser(CommonMarkParser::GitHubExtensions);
+    parser.renderHtml(utf8Text.data(), utf8Text.length(), htmlOutputBuffer);
+
+    if (this->getSmartTypographyEnabled())
+    {
+        // Run HTML through smarty pants to get fancy quotation marks, etc.
+        struct buf* smartyPantsBuffer = bufnew(htmlOutputBuffer->size + 1024);
+
+        sdhtml_smartypants
+        (
+            smartyPantsBuffer,
+            htmlOutputBuffer->data,
+            htmlOutputBuffer->size
+        );
+
+        html = QString::fromUtf8
+            (
+                (char*) smartyPantsBuffer->data,
+                smartyPantsBuffer->size
+            );
+
+        bufrelease(smartyPantsBuffer);
+    }
+    else
+    {
+        html = QString::fromUtf8
+            (
+                (char*) htmlOutputBuffer->data,
+                htmlOutputBuffer->size
+            );
+    }
+
+    bufrelease(htmlOutputBuffer);
+}
+
+void CommonMarkExporter::exportToFile
+(
+    const ExportFormat* format,
+    const QString& inputFilePath,
+    const QString& text,
+    const QString& outputFilePath,
+    QString& err
+)
+{
+    QString html;
+
+    if (ExportFormat::HTML != format)
+    {
+        err = QObject::tr("%1 format is unsupported by the CommonMark processor.")
+            .arg(format->getName());
+        return;
+    }
+
+    exportToHtml(text, html);
+
+    if (html.isNull())
+    {
+        err = "Export failed";
+        return;
+    }
+
+    writeHtmlFile(html, inputFilePath, outputFilePath, err);
+}
@@ -0,0 +1,505 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <stdio.h>
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QRegExp>
+#include <QTextStream>
+
+#include "CommonMarkHarness.h"
+#include "CommonMarkExporter.h"
+#include "CommonMarkParser.h"
+#include "SundownExporter.h"
+
+#include "sundown/buffer.h"
+
+// Fence that opens and closes each example in a spec file.
+#define GW_SPEC_EXAMPLE_FENCE "````````````````````````````````"
+
+// Minimum time in milliseconds to spend rendering each corpus document with
+// each exporter, and the minimum number of renders, so that the throughput
+// is not skewed by the timer's resolution.
+//
+#define GW_BENCHMARK_MIN_TIME 1000
+#define GW_BENCHMARK_MIN_ITERATIONS 5
+
+// Number of repetitions of the opening unit of each pathological input in
+// the smaller of its two sizes, and how many times larger the other size
+// is.  Inputs whose units grow as they are repeated get fewer repetitions,
+// since their length grows with the square of the count.
+//
+#define GW_PATHOLOGICAL_SIZE 10000
+#define GW_PATHOLOGICAL_GROWING_SIZE 500
+#define GW_PATHOLOGICAL_SCALE 4
+
+// Largest allowed ratio between the time taken per kilobyte of the larger
+// and the smaller size of a pathological input.  Parsing in linear time
+// keeps it below 2 even once the larger input no longer fits in the cache,
+// whereas quadratic time would make it as large as the scale above.
+//
+#define GW_PATHOLOGICAL_MAX_GROWTH 2.5
+
+// Minimum time in milliseconds to spend rendering each size of each
+// pathological input.
+//
+#define GW_PATHOLOGICAL_MIN_TIME 200
+
+CommonMarkHarness::CommonMarkHarness(const QStringList& paths)
+    : paths(paths)
+{
+    ;
+}
+
+CommonMarkHarness::~CommonMarkHarness()
+{
+    ;
+}
+
+int CommonMarkHarness::runSpecTests()
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    if (paths.isEmpty())
+    {
+        err << "Usage: ghostwriter " << GW_COMMONMARK_SPEC_ARG
+            << " <spec.txt files> [-platform offscreen]\n";
+        return 1;
+    }
+
+    QList<SpecExample> examples;
+
+    foreach (QString path, paths)
+    {
+        QList<SpecExample> fileExamples = readSpecFile(path);
+
+        if (fileExamples.isEmpty())
+        {
+            err << "No examples found in " << path << "\n";
+            return 1;
+        }
+
+        examples.append(fileExamples);
+    }
+
+    // The core examples are run without extensions, since some of them
+    // (such as bare URLs) would otherwise render differently.
+    //
+    CommonMarkParser coreParser(CommonMarkParser::NoExtensions);
+    CommonMarkParser gfmParser(CommonMarkParser::GitHubExtensions);
+    struct buf* ob = bufnew(1024);
+
+    QStringList sections;
+    QMap<QString, int> sectionTotals;
+    QMap<QString, int> sectionPasses;
+    int passCount = 0;
+
+    foreach (const SpecExample& example, examples)
+    {
+        QByteArray markdown = example.markdown.toUtf8();
+        CommonMarkParser* parser =
+            example.extensionsRequired ? &gfmParser : &coreParser;
+
+        ob->size = 0;
+        parser->renderHtml(markdown.data(), markdown.length(), ob);
+
+        QString html = QString::fromUtf8((const char*) ob->data, ob->size);
+
+        if (!sectionTotals.contains(example.section))
+        {
+            sections.append(example.section);
+        }
+
+        sectionTotals[example.section]++;
+
+        if (normalizeHtml(html) == normalizeHtml(example.html))
+        {
+            sectionPasses[example.section]++;
+            passCount++;
+        }
+        else
+        {
+            out << "Example " << example.number << " (" << example.section
+                << ") failed\n"
+                << "--- Markdown\n" << example.markdown
+                << "--- Expected\n" << example.html
+                << "--- Actual\n" << html << "\n";
+        }
+    }
+
+    bufrelease(ob);
+
+    out << QString("Section").leftJustified(40)
+        << QString("Passed").rightJustified(8)
+        << QString("Total").rightJustified(8) << "\n";
+
+    foreach (QString section, sections)
+    {
+        out << section.leftJustified(40, ' ', true)
+            << QString::number(sectionPasses.value(section)).rightJustified(8)
+            << QString::number(sectionTotals.value(section)).rightJustified(8)
+            << "\n";
+    }
+
+    out << "\n" << passCount << " of " << examples.size()
+        << " examples passed\n";
+
+    return (passCount == examples.size()) ? 0 : 1;
+}
+
+int CommonMarkHarness::runBenchmark()
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    QStringList corpusFilePaths = findCorpusFiles();
+
+    if (corpusFilePaths.isEmpty())
+    {
+        err << "Usage: ghostwriter " << GW_COMMONMARK_BENCHMARK_ARG
+            << " <Markdown files or directories> [-platform offscreen]\n";
+        return 1;
+    }
+
+    CommonMarkExporter commonMarkExporter;
+    SundownExporter sundownExporter;
+
+    // Smart typography is an extra pass over the output with both exporters,
+    // so leave it out of the comparison.
+    //
+    commonMarkExporter.setSmartTypographyEnabled(false);
+    sundownExporter.setSmartTypographyEnabled(false);
+
+    out << QString("Document").leftJustified(32)
+        << QString("KB").rightJustified(8)
+        << QString("CommonMark MB/s").rightJustified(17)
+        << QString("Sundown MB/s").rightJustified(14)
+        << QString("Ratio").rightJustified(8) << "\n";
+
+    foreach (QString filePath, corpusFilePaths)
+    {
+        QFile file(filePath);
+
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            err << "Could not read " << filePath << "\n";
+            continue;
+        }
+
+        QTextStream in(&file);
+        in.setCodec("UTF-8");
+        QString text = in.readAll();
+        file.close();
+
+        double commonMarkThroughput = measureThroughput(&commonMarkExporter, text);
+        double sundownThroughput = measureThroughput(&sundownExporter, text);
+
+        out << QFileInfo(filePath).fileName().leftJustified(32, ' ', true)
+            << QString::number(text.toUtf8().size() / 1024.0, 'f', 1).rightJustified(8)
+            << QString::number(commonMarkThroughput, 'f', 1).rightJustified(17)
+            << QString::number(sundownThroughput, 'f', 1).rightJustified(14)
+            << QString::number(commonMarkThroughput / qMax(sundownThroughput, 0.001), 'f', 2).rightJustified(8)
+            << "\n";
+        out.flush();
+    }
+
+    return 0;
+}
+
+int CommonMarkHarness::runPathologicalTests()
+{
+    static const PathologicalCase cases[] =
+    {
+        { "Nested strong emphasis", "*a **a ", "b", " a** a*", RepeatUnit },
+        { "Emphasis closers without openers", "a_ ", "", "", RepeatUnit },
+        { "Emphasis openers without closers", "_a ", "", "", RepeatUnit },
+        { "Mismatched emphasis", "*a_ ", "", "", RepeatUnit },
+        { "Closers in multiples of three", "", "a**b", "c* ", RepeatUnit },
+        { "Link closers without openers", "a]", "", "", RepeatUnit },
+        { "Link openers without closers", "[a", "", "", RepeatUnit },
+        { "Link openers and emphasis closers", "[ a_", "", "", RepeatUnit },
+        { "Unclosed link destinations", "[a](b", "", "", RepeatUnit },
+        { "Unclosed bracketed destinations", "[a](<b", "", "", RepeatUnit },
+        { "Brackets and parentheses", "[ (](", "", "", RepeatUnit },
+        { "Nested brackets", "[", "a", "]", RepeatUnit },
+        { "Nested block quotes", "> ", "a", "", RepeatUnit },
+        { "Deeply nested lists", "* a\n", "", "", IndentUnit },
+        { "Backtick runs", "e`", "", "", LengthenUnit },
+        { "Unclosed HTML tags", "<a ", "", "", RepeatUnit },
+        { "Unterminated entities", "&#", "", "&a", RepeatUnit },
+        { "Email autolink candidates", "a@", "", "", RepeatUnit },
+        { "Domain autolink candidates", "www.a", "", "", RepeatUnit },
+        { "URL autolink candidates", "http://a", "", "", RepeatUnit },
+        { "Empty table rows", "", "a|b\n-|-\n", "|\n", RepeatUnit },
+        { "Wide table", "|", "\n", "-|", RepeatUnit }
+    };
+
+    int caseCount = (int) (sizeof(cases) / sizeof(cases[0]));
+    QTextStream out(stdout);
+    int failures = 0;
+
+    out << QString("Input").leftJustified(36)
+        << QString("KB").rightJustified(8)
+        << QString("ms/KB").rightJustified(10)
+        << QString("KB").rightJustified(8)
+        << QString("ms/KB").rightJustified(10)
+        << QString("Growth").rightJustified(8) << "\n";
+
+    for (int i = 0; i < caseCount; i++)
+    {
+        int size = (RepeatUnit == cases[i].growth)
+            ? GW_PATHOLOGICAL_SIZE : GW_PATHOLOGICAL_GROWING_SIZE;
+        QByteArray small = pathologicalInput(cases[i], size);
+        QByteArray large = pathologicalInput(cases[i], size * GW_PATHOLOGICAL_SCALE);
+        double smallTime = measureTimePerKilobyte(small);
+        double largeTime = measureTimePerKilobyte(large);
+        double growth = largeTime / qMax(smallTime, 0.000001);
+
+        out << QString(cases[i].name).leftJustified(36, ' ', true)
+            << QString::number(small.size() / 1024.0, 'f', 1).rightJustified(8)
+            << QString::number(smallTime, 'f', 4).rightJustified(10)
+            << QString::number(large.size() / 1024.0, 'f', 1).rightJustified(8)
+            << QString::number(largeTime, 'f', 4).rightJustified(10)
+            << QString::number(growth, 'f', 2).rightJustified(8);
+
+        if (growth > GW_PATHOLOGICAL_MAX_GROWTH)
+        {
+            out << "  FAILED";
+            failures++;
+        }
+
+        out << "\n";
+        out.flush();
+    }
+
+    out << "\n" << failures << " of " << caseCount
+        << " inputs took superlinear time\n";
+
+    return (0 == failures) ? 0 : 1;
+}
+
+QList<CommonMarkHarness::SpecExample> CommonMarkHarness::readSpecFile
+(
+    const QString& filePath
+) const
+{
+    QList<SpecExample> examples;
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return examples;
+    }
+
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+
+    // The spec files show tabs as arrows, so that they are visible.
+    QString contents = in.readAll().replace(QChar(0x2192), QChar('\t'));
+    QStringList lines = contents.split('\n');
+    file.close();
+
+    QString section;
+    int number = 0;
+    int i = 0;
+
+    while (i < lines.size())
+    {
+        QString line = lines[i];
+        i++;
+
+        if (line.startsWith("#"))
+        {
+            section = line.mid(line.indexOf(' ') + 1).trimmed();
+            continue;
+        }
+
+        if (!line.startsWith(GW_SPEC_EXAMPLE_FENCE " example"))
+        {
+            continue;
+        }
+
+        // The words following "example" name the extensions that the
+        // example requires.
+        //
+        QStringList extensions = line.mid(QString(GW_SPEC_EXAMPLE_FENCE " example").length())
+            .split(' ', QString::SkipEmptyParts);
+
+        SpecExample example;
+        example.number = ++number;
+        example.section = section;
+        example.extensionsRequired = !extensions.isEmpty();
+
+        while ((i < lines.size()) && ("." != lines[i]))
+        {
+            example.markdown += lines[i] + "\n";
+            i++;
+        }
+
+        i++;
+
+        while ((i < lines.size()) && !lines[i].startsWith(GW_SPEC_EXAMPLE_FENCE))
+        {
+            example.html += lines[i] + "\n";
+            i++;
+        }
+
+        i++;
+
+        // Examples of features that the spec's own implementation disables
+        // are not expected to pass.
+        //
+        if (!extensions.contains("disabled"))
+        {
+            examples.append(example);
+        }
+    }
+
+    return examples;
+}
+
+QString CommonMarkHarness::normalizeHtml(const QString& html) const
+{
+    // Line breaks between tags carry no meaning, so don't report them as
+    // failures.
+    //
+    QString normalized = html;
+    normalized.remove('\r');
+    normalized.replace(QRegExp(">\\s+<"), "><");
+    return normalized.trimmed();
+}
+
+QStringList CommonMarkHarness::findCorpusFiles() const
+{
+    QStringList corpusFilePaths;
+    QStringList nameFilters;
+    nameFilters << "*.md" << "*.markdown" << "*.mdown" << "*.mkd" << "*.txt";
+
+    foreach (QString path, paths)
+    {
+        QFileInfo info(path);
+
+        if (info.isDir())
+        {
+            QDir dir(path);
+
+            foreach (QString fileName, dir.entryList(nameFilters, QDir::Files, QDir::Name))
+            {
+                corpusFilePaths.append(dir.filePath(fileName));
+            }
+        }
+        else if (info.isFile())
+        {
+            corpusFilePaths.append(path);
+        }
+    }
+
+    return corpusFilePaths;
+}
+
+double CommonMarkHarness::measureThroughput(Exporter* exporter, const QString& text) const
+{
+    QString html;
+    QElapsedTimer timer;
+    int iterations = 0;
+
+    // Warm up the caches before timing.
+    exporter->exportToHtml(text, html);
+
+    timer.start();
+
+    while
+    (
+        (timer.elapsed() < GW_BENCHMARK_MIN_TIME)
+        || (iterations < GW_BENCHMARK_MIN_ITERATIONS)
+    )
+    {
+        exporter->exportToHtml(text, html);
+        iterations++;
+    }
+
+    double seconds = timer.nsecsElapsed() / 1000000000.0;
+    double megabytes = (text.toUtf8().size() * (double) iterations) / (1024.0 * 1024.0);
+
+    return megabytes / qMax(seconds, 0.000001);
+}
+
+QByteArray CommonMarkHarness::pathologicalInput
+(
+    const PathologicalCase& test,
+    int size
+) const
+{
+    QByteArray markdown;
+    QByteArray opener(test.opener);
+
+    for (int i = 0; i < size; i++)
+    {
+        switch (test.growth)
+        {
+            case IndentUnit:
+                markdown.append(QByteArray(2 * i, ' '));
+                markdown.append(opener);
+                break;
+            case LengthenUnit:
+                markdown.append(opener);
+                markdown.append(QByteArray(i, opener.at(opener.length() - 1)));
+                break;
+            default:
+                markdown.append(opener);
+                break;
+        }
+    }
+
+    markdown.append(test.middle);
+
+    for (int i = 0; i < size; i++)
+    {
+        markdown.append(test.closer);
+    }
+
+    return markdown;
+}
+
+double CommonMarkHarness::measureTimePerKilobyte(const QByteArray& markdown) const
+{
+    CommonMarkParser parser(CommonMarkParser::GitHubExtensions);
+    struct buf* ob = bufnew(1024);
+    QElapsedTimer timer;
+    int iterations = 0;
+
+    timer.start();
+
+    do
+    {
+        ob->size = 0;
+        parser.renderHtml(markdown.data(), markdown.length(), ob);
+        iterations++;
+    }
+    while (timer.elapsed() < GW_PATHOLOGICAL_MIN_TIME);
+
+    double milliseconds = timer.nsecsElapsed() / 1000000.0;
+    bufrelease(ob);
+
+    return milliseconds / (iterations * (markdown.length() / 1024.0));
+}
@@ -0,0 +1,143 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef COMMONMARKHARNESS_H
+#define COMMONMARKHARNESS_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+class QTextStream;
+class Exporter;
+
+/*
+ * Command line argument that launches ghostwriter as the CommonMark spec
+ * runner rather than as an editor.  The arguments that follow it are the
+ * spec.txt files of the CommonMark spec and/or the GitHub-flavored
+ * Markdown spec, whose examples are rendered with the built-in CommonMark
+ * processor and checked against the expected HTML.
+ */
+#define GW_COMMONMARK_SPEC_ARG "--commonmark-spec"
+
+/*
+ * Command line argument that launches ghostwriter as the Markdown
+ * processor benchmark rather than as an editor.  The arguments that follow
+ * it are the Markdown files, or directories of Markdown files, to render.
+ */
+#define GW_COMMONMARK_BENCHMARK_ARG "--commonmark-benchmark"
+
+/*
+ * Command line argument that launches ghostwriter as the pathological input
+ * test of the Markdown processor rather than as an editor.
+ */
+#define GW_COMMONMARK_PATHOLOGICAL_ARG "--commonmark-pathological"
+
+/**
+ * Checks the conformance of the built-in CommonMark processor against the
+ * examples of the CommonMark and GitHub-flavored Markdown specs, checks
+ * that it parses pathological input in linear time, and measures its
+ * throughput against the Sundown processor.
+ */
+class CommonMarkHarness
+{
+    public:
+        /**
+         * Constructor.  Takes the spec files or the Markdown corpus to use,
+         * depending on which test is run, as a parameter.
+         */
+        CommonMarkHarness(const QStringList& paths);
+
+        /**
+         * Destructor.
+         */
+        ~CommonMarkHarness();
+
+        /**
+         * Runs every example of the spec files, and writes the failed
+         * examples and the number of passing examples per section to
+         * standard output.  Returns the process exit code, which is
+         * non-zero if any example failed.
+         */
+        int runSpecTests();
+
+        /**
+         * Renders each corpus document repeatedly with the CommonMark and
+         * Sundown exporters, and writes their throughput to standard output.
+         * Returns the process exit code.
+         */
+        int runBenchmark();
+
+        /**
+         * Renders inputs known to make Markdown processors take quadratic
+         * time or worse, such as deeply nested brackets or "a@" repeated
+         * many times, at two sizes.  Writes the time taken per kilobyte at
+         * each size to standard output.  Returns the process exit code,
+         * which is non-zero if the time per kilobyte of any input grew with
+         * its size.
+         */
+        int runPathologicalTests();
+
+    private:
+        // One example of a spec file.
+        struct SpecExample
+        {
+            int number;
+            QString section;
+            QString markdown;
+            QString html;
+            bool extensionsRequired;
+        };
+
+        // How the opening unit of a pathological input changes as it is
+        // repeated.
+        //
+        enum PathologicalGrowth
+        {
+            RepeatUnit,
+            IndentUnit,
+            LengthenUnit
+        };
+
+        // Input made of an opening unit repeated many times, some text,
+        // and then a closing unit repeated as many times.  Each repetition
+        // of the opening unit is either the same, indented by one more
+        // level, or ends with one more copy of its last character.
+        //
+        struct PathologicalCase
+        {
+            const char* name;
+            const char* opener;
+            const char* middle;
+            const char* closer;
+            PathologicalGrowth growth;
+        };
+
+        QStringList paths;
+
+        QList<SpecExample> readSpecFile(const QString& filePath) const;
+        QString normalizeHtml(const QString& html) const;
+        QStringList findCorpusFiles() const;
+        double measureThroughput(Exporter* exporter, const QString& text) const;
+        QByteArray pathologicalInput(const PathologicalCase& test, int size) const;
+        double measureTimePerKilobyte(const QByteArray& markdown) const;
+};
+
+#endif // COMMONMARKHARNESS_H
@@ -0,0 +1,4949 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GW_COMMONMARK_SSE2
+#endif
+
+#include "CommonMarkParser.h"
+#include "CommonMarkEntities.h"
+#include "sundown/buffer.h"
+#include "sundown/houdini.h"
+
+#define GW_CODE_INDENT 4
+#define GW_ARENA_BLOCK_SIZE (64 * 1024)
+#define GW_MAX_LINK_LABEL_LENGTH 999
+#define GW_MAX_BACKTICKS 80
+
+// Deepest nesting of parentheses allowed in a raw link destination.  The
+// spec permits such a limit, and without it, every unmatched "](" would scan
+// the rest of the paragraph for closing parentheses.
+//
+#define GW_MAX_LINK_PAREN_DEPTH 32
+
+enum NodeType
+{
+    DocumentNode,
+    BlockQuoteNode,
+    ListNode,
+    ItemNode,
+    CodeBlockNode,
+    HtmlBlockNode,
+    ParagraphNode,
+    HeadingNode,
+    ThematicBreakNode,
+    TableNode,
+    TableRowNode,
+    TableCellNode,
+    TextNode,
+    SoftBreakNode,
+    LineBreakNode,
+    CodeNode,
+    HtmlInlineNode,
+    EmphasisNode,
+    StrongNode,
+    StrikethroughNode,
+    LinkNode,
+    ImageNode
+};
+
+enum TaskState
+{
+    NoTask,
+    UncheckedTask,
+    CheckedTask
+};
+
+/*
+ * A line of block content.  Lines are not copied out of the input text.
+ * Instead, chunks refer to the part of the line remaining after container
+ * prefixes, such as "> " or list item indentation, have been stripped.
+ */
+struct CommonMarkParser::Chunk
+{
+    const char* data;
+    int length;
+
+    // Columns left over from a tab that was only partially consumed as
+    // indentation, which must be output as spaces.
+    //
+    int leadingSpaces;
+
+    Chunk* next;
+};
+
+/*
+ * Node of the document tree.  The same structure is used for both block and
+ * inline nodes, with the fields used varying by node type.  Nodes are
+ * allocated from the arena and zero-initialized.
+ */
+struct CommonMarkParser::Node
+{
+    int type;
+    Node* parent;
+    Node* first;
+    Node* last;
+    Node* prev;
+    Node* next;
+
+    // Block parsing state.
+    bool open;
+    bool lastLineBlank;
+    bool lastLineChecked;
+    int startLine;
+    Chunk* firstChunk;
+    Chunk* lastChunk;
+
+    // Text content for text, code, HTML and paragraph nodes.
+    const char* literal;
+    int literalLength;
+
+    // Link and image destination and title, or code block info string.
+    const char* url;
+    int urlLength;
+    const char* title;
+    int titleLength;
+
+    // Heading level, HTML block type, table column count, or for table rows
+    // and cells, whether they are in the table header.
+    //
+    int level;
+
+    // List and list item data.
+    bool ordered;
+    bool tight;
+    char bulletChar;
+    char delimiter;
+    int start;
+    int markerOffset;
+    int padding;
+    int taskState;
+
+    // Code block data.
+    bool fenced;
+    char fenceChar;
+    int fenceLength;
+    int fenceOffset;
+
+    // Table column alignments ('l', 'c', 'r', or 0 for none).
+    char* alignments;
+
+    // True if the node is a delimiter run or link opener, whose text may
+    // still be consumed by emphasis or link processing.
+    //
+    bool delimiterText;
+};
+
+/*
+ * Entry in the stack of emphasis and strikethrough delimiter runs.
+ */
+struct CommonMarkParser::Delimiter
+{
+    char c;
+    int numDelims;
+    int origDelims;
+    Node* node;
+    Delimiter* previous;
+    Delimiter* next;
+    bool canOpen;
+    bool canClose;
+};
+
+/*
+ * Entry in the stack of link and image openers.
+ */
+struct CommonMarkParser::Bracket
+{
+    Node* node;
+    Bracket* previous;
+    Delimiter* previousDelimiter;
+    int index;
+    bool image;
+    bool active;
+    bool bracketAfter;
+};
+
+/*
+ * Bump allocator.  Memory is handed out from large blocks and is only ever
+ * freed all at once, which makes allocation nearly free and keeps related
+ * nodes close together in memory.
+ */
+class CommonMarkParser::Arena
+{
+    public:
+        Arena() : head(NULL), used(0), capacity(0)
+        {
+            ;
+        }
+
+        ~Arena()
+        {
+            while (NULL != head)
+            {
+                Block* next = head->next;
+                free(head);
+                head = next;
+            }
+        }
+
+        void* allocate(size_t size)
+        {
+            // Keep everything pointer-aligned.
+            size = (size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+
+            if ((used + size) > capacity)
+            {
+                size_t blockSize = GW_ARENA_BLOCK_SIZE;
+
+                if (size > blockSize)
+                {
+                    blockSize = size;
+                }
+
+                Block* block = (Block*) malloc(sizeof(Block) + blockSize);
+
+                if (NULL == block)
+                {
+                    abort();
+                }
+
+                block->next = head;
+                head = block;
+                used = 0;
+                capacity = blockSize;
+            }
+
+            void* memory = head->data() + used;
+            used += size;
+            return memory;
+        }
+
+        char* allocateString(size_t size)
+        {
+            return (char*) allocate(size);
+        }
+
+    private:
+        struct Block
+        {
+            Block* next;
+            void* padding;
+
+            char* data()
+            {
+                return (char*) (this + 1);
+            }
+        };
+
+        Block* head;
+        size_t used;
+        size_t capacity;
+};
+
+/*
+ * Finds the first occurrence of any of a small set of characters.  This is
+ * the hot loop of the inline parser and HTML renderer, since the vast
+ * majority of Markdown text contains no syntax at all.  Where SSE2 is
+ * available, sixteen bytes are tested at a time.
+ */
+class CommonMarkParser::CharScanner
+{
+    public:
+        CharScanner(const char* chars)
+        {
+            memset(table, 0, sizeof(table));
+            count = 0;
+
+            for (const char* c = chars; *c && count < 16; c++)
+            {
+                table[(unsigned char) *c] = true;
+                memset(vectors[count], *c, 16);
+                count++;
+            }
+        }
+
+        const char* find(const char* p, const char* end) const
+        {
+#ifdef GW_COMMONMARK_SSE2
+            while ((end - p) >= 16)
+            {
+                __m128i data = _mm_loadu_si128((const __m128i*) p);
+                __m128i matches = _mm_setzero_si128();
+
+                for (int i = 0; i < count; i++)
+                {
+                    __m128i c = _mm_loadu_si128((const __m128i*) vectors[i]);
+                    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(data, c));
+                }
+
+                int mask = _mm_movemask_epi8(matches);
+
+                if (0 != mask)
+                {
+                    int index = 0;
+
+                    while (0 == (mask & 1))
+                    {
+                        mask >>= 1;
+                        index++;
+                    }
+
+                    return p + index;
+                }
+
+                p += 16;
+            }
+#endif
+            while ((p < end) && !table[(unsigned char) *p])
+            {
+                p++;
+            }
+
+            return p;
+        }
+
+        bool contains(char c) const
+        {
+            return table[(unsigned char) c];
+        }
+
+    private:
+        bool table[256];
+        unsigned char vectors[16][16];
+        int count;
+};
+
+static inline bool isSpaceOrTab(int c)
+{
+    return (' ' == c) || ('\t' == c);
+}
+
+static inline bool isLineWhitespace(int c)
+{
+    return (' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c)
+        || ('\f' == c) || ('\v' == c);
+}
+
+static inline bool isAsciiDigit(int c)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+static inline bool isAsciiAlpha(int c)
+{
+    return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z'));
+}
+
+static inline bool isAsciiAlnum(int c)
+{
+    return isAsciiAlpha(c) || isAsciiDigit(c);
+}
+
+static inline bool isAsciiPunctuation(int c)
+{
+    return ((c >= '!') && (c <= '/')) || ((c >= ':') && (c <= '@'))
+        || ((c >= '[') && (c <= '`')) || ((c >= '{') && (c <= '~'));
+}
+
+static inline int asciiLower(int c)
+{
+    return ((c >= 'A') && (c <= 'Z')) ? (c + ('a' - 'A')) : c;
+}
+
+static bool startsWithNoCase(const char* s, int length, const char* prefix)
+{
+    int i = 0;
+
+    for (; prefix[i]; i++)
+    {
+        if ((i >= length) || (asciiLower((unsigned char) s[i]) != prefix[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool containsNoCase(const char* s, int length, const char* needle)
+{
+    int needleLength = strlen(needle);
+
+    for (int i = 0; (i + needleLength) <= length; i++)
+    {
+        if (startsWithNoCase(s + i, length - i, needle))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Decodes the UTF-8 character starting at s, returning its code point and
+ * setting length to its size in bytes.  Invalid sequences decode as single
+ * bytes.
+ */
+static unsigned int decodeUtf8(const char* s, int available, int* length)
+{
+    const unsigned char* u = (const unsigned char*) s;
+    unsigned int c = u[0];
+    int size = 1;
+
+    if ((c >= 0xC0) && (c < 0xE0) && (available >= 2))
+    {
+        c = ((c & 0x1F) << 6) | (u[1] & 0x3F);
+        size = 2;
+    }
+    else if ((c >= 0xE0) && (c < 0xF0) && (available >= 3))
+    {
+        c = ((c & 0x0F) << 12) | ((u[1] & 0x3F) << 6) | (u[2] & 0x3F);
+        size = 3;
+    }
+    else if ((c >= 0xF0) && (available >= 4))
+    {
+        c = ((c & 0x07) << 18) | ((u[1] & 0x3F) << 12)
+            | ((u[2] & 0x3F) << 6) | (u[3] & 0x3F);
+        size = 4;
+    }
+
+    if (NULL != length)
+    {
+        *length = size;
+    }
+
+    return c;
+}
+
+static int encodeUtf8(unsigned int c, char* out)
+{
+    if (c < 0x80)
+    {
+        out[0] = (char) c;
+        return 1;
+    }
+    else if (c < 0x800)
+    {
+        out[0] = (char) (0xC0 | (c >> 6));
+        out[1] = (char) (0x80 | (c & 0x3F));
+        return 2;
+    }
+    else if (c < 0x10000)
+    {
+        out[0] = (char) (0xE0 | (c >> 12));
+        out[1] = (char) (0x80 | ((c >> 6) & 0x3F));
+        out[2] = (char) (0x80 | (c & 0x3F));
+        return 3;
+    }
+    else
+    {
+        out[0] = (char) (0xF0 | (c >> 18));
+        out[1] = (char) (0x80 | ((c >> 12) & 0x3F));
+        out[2] = (char) (0x80 | ((c >> 6) & 0x3F));
+        out[3] = (char) (0x80 | (c & 0x3F));
+        return 4;
+    }
+}
+
+static bool isUnicodeWhitespace(unsigned int c)
+{
+    return (c == 0x09) || (c == 0x0A) || (c == 0x0C) || (c == 0x0D)
+        || (c == 0x20) || (c == 0xA0) || (c == 0x1680)
+        || ((c >= 0x2000) && (c <= 0x200A)) || (c == 0x202F)
+        || (c == 0x205F) || (c == 0x3000);
+}
+
+/*
+ * Approximates the Unicode punctuation and symbol categories with the
+ * blocks that matter in practice.
+ */
+static bool isUnicodePunctuation(unsigned int c)
+{
+    if (c < 0x80)
+    {
+        return isAsciiPunctuation(c);
+    }
+
+    return ((c >= 0xA1) && (c <= 0xBF) && (c != 0xAA) && (c != 0xB2)
+            && (c != 0xB3) && (c != 0xB5) && (c != 0xB9) && (c != 0xBA))
+        || (c == 0xD7) || (c == 0xF7)
+        || ((c >= 0x2010) && (c <= 0x2027))
+        || ((c >= 0x2030) && (c <= 0x205E))
+        || ((c >= 0x20A0) && (c <= 0x20CF))
+        || ((c >= 0x2190) && (c <= 0x23FF))
+        || ((c >= 0x2500) && (c <= 0x27BF))
+        || ((c >= 0x2E00) && (c <= 0x2E7F))
+        || ((c >= 0x3001) && (c <= 0x3003))
+        || ((c >= 0x3008) && (c <= 0x3020))
+        || (c == 0x30FB)
+        || ((c >= 0xFE30) && (c <= 0xFE6B))
+        || ((c >= 0xFF01) && (c <= 0xFF0F))
+        || ((c >= 0xFF1A) && (c <= 0xFF20))
+        || ((c >= 0xFF3B) && (c <= 0xFF40))
+        || ((c >= 0xFF5B) && (c <= 0xFF65));
+}
+
+/*
+ * Simple case folding for reference labels.  Covers ASCII, Latin-1,
+ * Latin Extended-A, Greek and Cyrillic.
+ */
+static unsigned int foldCase(unsigned int c)
+{
+    if (c < 0x80)
+    {
+        return asciiLower(c);
+    }
+    else if (((c >= 0xC0) && (c <= 0xDE) && (c != 0xD7))
+        || ((c >= 0x391) && (c <= 0x3A9))
+        || ((c >= 0x410) && (c <= 0x42F)))
+    {
+        return c + 0x20;
+    }
+    else if ((c >= 0x400) && (c <= 0x40F))
+    {
+        return c + 0x50;
+    }
+    else if ((c >= 0x100) && (c <= 0x17F) && (0 == (c & 1)))
+    {
+        return c + 1;
+    }
+    else if (c == 0x3C2)
+    {
+        // Final sigma.
+        return 0x3C3;
+    }
+
+    return c;
+}
+
+/*
+ * Decodes the entity or numeric character reference at the start of s,
+ * writing the UTF-8 result to out (which must hold at least 8 bytes, since
+ * a few named references stand for two code points).  Returns the length
+ * of the reference, or 0 if there is none.  The result is at most one byte
+ * longer than the reference itself.
+ */
+static int decodeEntity(const char* s, int length, char* out, int* outLength)
+{
+    if ((length < 3) || ('&' != s[0]))
+    {
+        return 0;
+    }
+
+    int i = 1;
+    unsigned int codePoint = 0;
+
+    if ('#' == s[1])
+    {
+        int digits = 0;
+        i = 2;
+
+        if ((i < length) && (('x' == s[i]) || ('X' == s[i])))
+        {
+            i++;
+
+            while ((i < length) && (digits < 7))
+            {
+                int c = asciiLower((unsigned char) s[i]);
+
+                if (isAsciiDigit(c))
+                {
+                    codePoint = (codePoint * 16) + (c - '0');
+                }
+                else if ((c >= 'a') && (c <= 'f'))
+                {
+                    codePoint = (codePoint * 16) + (c - 'a' + 10);
+                }
+                else
+                {
+                    break;
+                }
+
+                i++;
+                digits++;
+            }
+
+            if ((digits < 1) || (digits > 6))
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            while ((i < length) && (digits < 8) && isAsciiDigit(s[i]))
+            {
+                codePoint = (codePoint * 10) + (s[i] - '0');
+                i++;
+                digits++;
+            }
+
+            if ((digits < 1) || (digits > 7))
+            {
+                return 0;
+            }
+        }
+
+        if ((i >= length) || (';' != s[i]))
+        {
+            return 0;
+        }
+
+        if ((0 == codePoint) || (codePoint > 0x10FFFF)
+            || ((codePoint >= 0xD800) && (codePoint <= 0xDFFF)))
+        {
+            codePoint = 0xFFFD;
+        }
+
+        *outLength = encodeUtf8(codePoint, out);
+        return i + 1;
+    }
+
+    while ((i < length) && ((i - 1) < 32) && isAsciiAlnum(s[i]))
+    {
+        i++;
+    }
+
+    if ((i < 3) || (i >= length) || (';' != s[i]) || !isAsciiAlpha(s[1]))
+    {
+        return 0;
+    }
+
+    int nameLength = i - 1;
+    int low = 0;
+    int high = COMMONMARK_ENTITY_COUNT - 1;
+
+    while (low <= high)
+    {
+        int mid = (low + high) / 2;
+        const char* name = commonMarkEntities[mid].name;
+        int result = strncmp(s + 1, name, nameLength);
+
+        if ((0 == result) && ('\0' != name[nameLength]))
+        {
+            result = -1;
+        }
+
+        if (0 == result)
+        {
+            *outLength = encodeUtf8(commonMarkEntities[mid].codePoint, out);
+
+            if (0 != commonMarkEntities[mid].secondCodePoint)
+            {
+                *outLength += encodeUtf8
+                    (
+                        commonMarkEntities[mid].secondCodePoint,
+                        out + *outLength
+                    );
+            }
+
+            return i + 1;
+        }
+        else if (result < 0)
+        {
+            high = mid - 1;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+
+    return 0;
+}
+
+static int scanTagName(const char* s, int length, int i)
+{
+    if ((i >= length) || !isAsciiAlpha(s[i]))
+    {
+        return -1;
+    }
+
+    i++;
+
+    while ((i < length) && (isAsciiAlnum(s[i]) || ('-' == s[i])))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+static int skipWhitespace(const char* s, int length, int i)
+{
+    while ((i < length) && isLineWhitespace(s[i]))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/*
+ * Returns the length of the HTML open tag at the start of s, or 0 if there
+ * is none.
+ */
+static int scanOpenTag(const char* s, int length)
+{
+    if ((length < 3) || ('<' != s[0]))
+    {
+        return 0;
+    }
+
+    int i = scanTagName(s, length, 1);
+
+    if (i < 0)
+    {
+        return 0;
+    }
+
+    // Attributes
+    while (true)
+    {
+        int j = skipWhitespace(s, length, i);
+
+        if ((j == i) || (j >= length))
+        {
+            break;
+        }
+
+        char c = s[j];
+
+        if (!isAsciiAlpha(c) && ('_' != c) && (':' != c))
+        {
+            break;
+        }
+
+        j++;
+
+        while ((j < length) && (isAsciiAlnum(s[j]) || ('_' == s[j])
+            || ('.' == s[j]) || (':' == s[j]) || ('-' == s[j])))
+        {
+            j++;
+        }
+
+        // Optional attribute value
+        int k = skipWhitespace(s, length, j);
+
+        if ((k < length) && ('=' == s[k]))
+        {
+            k = skipWhitespace(s, length, k + 1);
+
+            if (k >= length)
+            {
+                return 0;
+            }
+
+            if (('"' == s[k]) || ('\'' == s[k]))
+            {
+                const char* close = (const char*)
+                    memchr(s + k + 1, s[k], length - k - 1);
+
+                if (NULL == close)
+                {
+                    return 0;
+                }
+
+                j = (close - s) + 1;
+            }
+            else
+            {
+                int valueStart = k;
+
+                while ((k < length) && !isLineWhitespace(s[k])
+                    && (NULL == strchr("\"'=<>`", s[k])))
+                {
+                    k++;
+                }
+
+                if (k == valueStart)
+                {
+                    return 0;
+                }
+
+                j = k;
+            }
+        }
+
+        i = j;
+    }
+
+    i = skipWhitespace(s, length, i);
+
+    if ((i < length) && ('/' == s[i]))
+    {
+        i++;
+    }
+
+    if ((i < length) && ('>' == s[i]))
+    {
+        return i + 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Returns the length of the HTML closing tag at the start of s, or 0 if
+ * there is none.
+ */
+static int scanClosingTag(const char* s, int length)
+{
+    if ((length < 4) || ('<' != s[0]) || ('/' != s[1]))
+    {
+        return 0;
+    }
+
+    int i = scanTagName(s, length, 2);
+
+    if (i < 0)
+    {
+        return 0;
+    }
+
+    i = skipWhitespace(s, length, i);
+
+    if ((i < length) && ('>' == s[i]))
+    {
+        return i + 1;
+    }
+
+    return 0;
+}
+
+static int scanUntil(const char* s, int length, int i, const char* terminator)
+{
+    int terminatorLength = strlen(terminator);
+
+    for (; (i + terminatorLength) <= length; i++)
+    {
+        if (0 == memcmp(s + i, terminator, terminatorLength))
+        {
+            return i + terminatorLength;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Returns the length of the inline raw HTML at the start of s, or 0 if there
+ * is none.
+ */
+static int scanHtmlTag(const char* s, int length)
+{
+    if ((length < 3) || ('<' != s[0]))
+    {
+        return 0;
+    }
+
+    if ('/' == s[1])
+    {
+        return scanClosingTag(s, length);
+    }
+    else if ('?' == s[1])
+    {
+        return scanUntil(s, length, 2, "?>");
+    }
+    else if ('!' == s[1])
+    {
+        if ((length >= 4) && (0 == memcmp(s, "<!--", 4)))
+        {
+            if ((length >= 5) && ('>' == s[4]))
+            {
+                return 5;
+            }
+
+            if ((length >= 6) && (0 == memcmp(s + 4, "->", 2)))
+            {
+                return 6;
+            }
+
+            return scanUntil(s, length, 4, "-->");
+        }
+        else if ((length >= 9) && (0 == memcmp(s, "<![CDATA[", 9)))
+        {
+            return scanUntil(s, length, 9, "]]>");
+        }
+        else if (isAsciiAlpha(s[2]))
+        {
+            return scanUntil(s, length, 3, ">");
+        }
+
+        return 0;
+    }
+
+    return scanOpenTag(s, length);
+}
+
+static bool isBlockTagName(const char* s, int length)
+{
+    static const char* blockTags[] =
+    {
+        "address", "article", "aside", "base", "basefont", "blockquote",
+        "body", "caption", "center", "col", "colgroup", "dd", "details",
+        "dialog", "dir", "div", "dl", "dt", "fieldset", "figcaption",
+        "figure", "footer", "form", "frame", "frameset", "h1", "h2", "h3",
+        "h4", "h5", "h6", "head", "header", "hr", "html", "iframe", "legend",
+        "li", "link", "main", "menu", "menuitem", "nav", "noframes", "ol",
+        "optgroup", "option", "p", "param", "search", "section", "summary",
+        "table", "tbody", "td", "tfoot", "th", "thead", "title", "tr",
+        "track", "ul", NULL
+    };
+
+    for (int i = 0; NULL != blockTags[i]; i++)
+    {
+        if (((int) strlen(blockTags[i]) == length)
+            && startsWithNoCase(s, length, blockTags[i]))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Returns which of the seven kinds of HTML block the line starts, or 0 if it
+ * does not start one.
+ */
+static int htmlBlockStartType
+(
+    const char* s,
+    int length,
+    bool canInterruptParagraph
+)
+{
+    static const char* literalTags[] = { "script", "pre", "textarea", "style", NULL };
+
+    for (int i = 0; NULL != literalTags[i]; i++)
+    {
+        int tagLength = strlen(literalTags[i]);
+
+        if (startsWithNoCase(s + 1, length - 1, literalTags[i]))
+        {
+            int end = tagLength + 1;
+
+            if ((end >= length) || isLineWhitespace(s[end]) || ('>' == s[end]))
+            {
+                return 1;
+            }
+        }
+    }
+
+    if ((length >= 4) && (0 == memcmp(s, "<!--", 4)))
+    {
+        return 2;
+    }
+
+    if ((length >= 2) && ('?' == s[1]))
+    {
+        return 3;
+    }
+
+    if ((length >= 9) && (0 == memcmp(s, "<![CDATA[", 9)))
+    {
+        return 5;
+    }
+
+    if ((length >= 3) && ('!' == s[1]) && isAsciiAlpha(s[2]))
+    {
+        return 4;
+    }
+
+    int nameStart = ((length >= 2) && ('/' == s[1])) ? 2 : 1;
+    int nameEnd = nameStart;
+
+    while ((nameEnd < length) && isAsciiAlnum(s[nameEnd]))
+    {
+        nameEnd++;
+    }
+
+    if ((nameEnd > nameStart) && isBlockTagName(s + nameStart, nameEnd - nameStart))
+    {
+        if ((nameEnd >= length) || isLineWhitespace(s[nameEnd])
+            || ('>' == s[nameEnd])
+            || (((nameEnd + 1) < length) && ('/' == s[nameEnd]) && ('>' == s[nameEnd + 1])))
+        {
+            return 6;
+        }
+    }
+
+    if (canInterruptParagraph)
+    {
+        int tagLength = scanOpenTag(s, length);
+
+        if (tagLength > 0)
+        {
+            for (int i = 0; NULL != literalTags[i]; i++)
+            {
+                int literalLength = strlen(literalTags[i]);
+
+                if (startsWithNoCase(s + 1, length - 1, literalTags[i])
+                    && !isAsciiAlnum(s[literalLength + 1])
+                    && ('-' != s[literalLength + 1]))
+                {
+                    return 0;
+                }
+            }
+        }
+        else
+        {
+            tagLength = scanClosingTag(s, length);
+        }
+
+        if ((tagLength > 0) && (skipWhitespace(s, length, tagLength) == length))
+        {
+            return 7;
+        }
+    }
+
+    return 0;
+}
+
+static bool htmlBlockEnds(int type, const char* s, int length)
+{
+    switch (type)
+    {
+        case 1:
+            return containsNoCase(s, length, "</script>")
+                || containsNoCase(s, length, "</pre>")
+                || containsNoCase(s, length, "</style>")
+                || containsNoCase(s, length, "</textarea>");
+        case 2:
+            return scanUntil(s, length, 0, "-->") > 0;
+        case 3:
+            return scanUntil(s, length, 0, "?>") > 0;
+        case 4:
+            return NULL != memchr(s, '>', length);
+        case 5:
+            return scanUntil(s, length, 0, "]]>") > 0;
+        default:
+            return false;
+    }
+}
+
+struct TableCellSpan
+{
+    const char* data;
+    int length;
+};
+
+/*
+ * Splits a table row into cells at unescaped pipes, returning the number of
+ * cells.  The spans of up to maxCells cells are stored in cells, if it is
+ * not NULL.
+ */
+static int splitTableRow
+(
+    const char* s,
+    int length,
+    TableCellSpan* cells,
+    int maxCells
+)
+{
+    int start = 0;
+    int end = length;
+
+    while ((start < end) && isLineWhitespace(s[start]))
+    {
+        start++;
+    }
+
+    while ((end > start) && isLineWhitespace(s[end - 1]))
+    {
+        end--;
+    }
+
+    if ((start < end) && ('|' == s[start]))
+    {
+        start++;
+    }
+
+    if ((end > start) && ('|' == s[end - 1])
+        && !(((end - 2) >= start) && ('\\' == s[end - 2])))
+    {
+        end--;
+    }
+
+    int count = 0;
+    int i = start;
+    int cellStart = start;
+
+    while (true)
+    {
+        if ((i >= end) || ('|' == s[i]))
+        {
+            int a = cellStart;
+            int b = i;
+
+            while ((a < b) && isSpaceOrTab(s[a]))
+            {
+                a++;
+            }
+
+            while ((b > a) && isSpaceOrTab(s[b - 1]))
+            {
+                b--;
+            }
+
+            if ((NULL != cells) && (count < maxCells))
+            {
+                cells[count].data = s + a;
+                cells[count].length = b - a;
+            }
+
+            count++;
+
+            if (i >= end)
+            {
+                break;
+            }
+
+            cellStart = i + 1;
+        }
+        else if (('\\' == s[i]) && ((i + 1) < end))
+        {
+            i++;
+        }
+
+        i++;
+    }
+
+    return count;
+}
+
+/*
+ * Parses a table delimiter row, such as "| :--- | ---: |", storing the
+ * column alignments in alignments.  Returns the number of columns, or 0 if
+ * the line is not a delimiter row.
+ */
+static int parseTableDelimiterRow
+(
+    const char* s,
+    int length,
+    char* alignments,
+    int maxColumns
+)
+{
+    TableCellSpan cells[64];
+    int count = splitTableRow(s, length, cells, 64);
+
+    if ((count > 64) || (count > maxColumns))
+    {
+        return 0;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        const char* cell = cells[i].data;
+        int cellLength = cells[i].length;
+        int j = 0;
+        bool left = false;
+        bool right = false;
+
+        if ((j < cellLength) && (':' == cell[j]))
+        {
+            left = true;
+            j++;
+        }
+
+        int dashes = 0;
+
+        while ((j < cellLength) && ('-' == cell[j]))
+        {
+            dashes++;
+            j++;
+        }
+
+        if ((j < cellLength) && (':' == cell[j]))
+        {
+            right = true;
+            j++;
+        }
+
+        if ((0 == dashes) || (j != cellLength))
+        {
+            return 0;
+        }
+
+        if (NULL != alignments)
+        {
+            alignments[i] = (left && right) ? 'c' : (left ? 'l' : (right ? 'r' : 0));
+        }
+    }
+
+    return count;
+}
+
+CommonMarkParser::CommonMarkParser(int extensions)
+    : extensions(extensions),
+    document(NULL),
+    tip(NULL),
+    oldTip(NULL),
+    lastMatchedContainer(NULL),
+    line(NULL),
+    lineLength(0),
+    lineNumber(0),
+    offset(0),
+    column(0),
+    nextNonspace(0),
+    nextNonspaceColumn(0),
+    indent(0),
+    indented(false),
+    blank(false),
+    partiallyConsumedTab(false),
+    allClosed(true),
+    lineConsumed(false),
+    subject(NULL),
+    subjectLength(0),
+    pos(0),
+    delimiters(NULL),
+    brackets(NULL),
+    backticksScanned(false)
+{
+    arena = NULL;
+
+    std::string specialChars = "\n\\`*_[]!<&";
+
+    if (extensions & StrikethroughExtension)
+    {
+        specialChars += "~";
+    }
+
+    if (extensions & AutolinkExtension)
+    {
+        specialChars += ":.@";
+    }
+
+    inlineScanner = new CharScanner(specialChars.c_str());
+    escapeScanner = new CharScanner("&<>\"");
+}
+
+CommonMarkParser::~CommonMarkParser()
+{
+    delete inlineScanner;
+    delete escapeScanner;
+
+    if (NULL != arena)
+    {
+        delete arena;
+    }
+}
+
+void CommonMarkParser::renderHtml(const char* text, size_t size, struct buf* ob)
+{
+    arena = new Arena();
+    references.clear();
+
+    document = newNode(DocumentNode);
+    document->open = true;
+    document->startLine = 1;
+    tip = document;
+    oldTip = document;
+    lastMatchedContainer = document;
+    lineNumber = 0;
+
+    const char* input = normalizeInput(text, size);
+    const char* end = input + size;
+    const char* p = input;
+
+    while (p < end)
+    {
+        const char* eol = (const char*) memchr(p, '\n', end - p);
+
+        if (NULL == eol)
+        {
+            eol = end;
+        }
+
+        incorporateLine(p, eol - p);
+        p = eol + 1;
+    }
+
+    while (NULL != tip)
+    {
+        finalize(tip);
+    }
+
+    processInlines();
+    render(ob);
+
+    delete arena;
+    arena = NULL;
+    references.clear();
+}
+
+CommonMarkParser::Node* CommonMarkParser::newNode(int type)
+{
+    Node* node = (Node*) arena->allocate(sizeof(Node));
+    memset(node, 0, sizeof(Node));
+    node->type = type;
+    return node;
+}
+
+void CommonMarkParser::appendChild(Node* parent, Node* child)
+{
+    child->parent = parent;
+    child->next = NULL;
+    child->prev = parent->last;
+
+    if (NULL != parent->last)
+    {
+        parent->last->next = child;
+    }
+    else
+    {
+        parent->first = child;
+    }
+
+    parent->last = child;
+}
+
+void CommonMarkParser::insertAfter(Node* node, Node* sibling)
+{
+    sibling->parent = node->parent;
+    sibling->prev = node;
+    sibling->next = node->next;
+
+    if (NULL != node->next)
+    {
+        node->next->prev = sibling;
+    }
+    else if (NULL != node->parent)
+    {
+        node->parent->last = sibling;
+    }
+
+    node->next = sibling;
+}
+
+void CommonMarkParser::unlink(Node* node)
+{
+    if (NULL != node->prev)
+    {
+        node->prev->next = node->next;
+    }
+    else if (NULL != node->parent)
+    {
+        node->parent->first = node->next;
+    }
+
+    if (NULL != node->next)
+    {
+        node->next->prev = node->prev;
+    }
+    else if (NULL != node->parent)
+    {
+        node->parent->last = node->prev;
+    }
+
+    node->parent = NULL;
+    node->prev = NULL;
+    node->next = NULL;
+}
+
+const char* CommonMarkParser::normalizeInput(const char* text, size_t& size)
+{
+    bool needsCopy = false;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        if (('\r' == text[i]) || ('\0' == text[i]))
+        {
+            needsCopy = true;
+            break;
+        }
+    }
+
+    if (!needsCopy)
+    {
+        return text;
+    }
+
+    // Line endings become "\n" and NUL characters become U+FFFD, which
+    // takes up at most three times as much space.
+    //
+    char* normalized = arena->allocateString((size * 3) + 1);
+    size_t j = 0;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        if ('\r' == text[i])
+        {
+            normalized[j++] = '\n';
+
+            if (((i + 1) < size) && ('\n' == text[i + 1]))
+            {
+                i++;
+            }
+        }
+        else if ('\0' == text[i])
+        {
+            j += encodeUtf8(0xFFFD, normalized + j);
+        }
+        else
+        {
+            normalized[j++] = text[i];
+        }
+    }
+
+    size = j;
+    return normalized;
+}
+
+int CommonMarkParser::peek(int index) const
+{
+    return (index < lineLength) ? (unsigned char) line[index] : -1;
+}
+
+void CommonMarkParser::findNextNonspace()
+{
+    // The indentation is only scanned again once the offset has moved past
+    // the last non-space character found.  Until then, only whitespace lies
+    // between the two, so the result still holds.  Scanning it for each
+    // open container would otherwise take time proportional to the square
+    // of the nesting depth on every line of a deeply nested list.
+    //
+    if (nextNonspace <= offset)
+    {
+        int i = offset;
+        int cols = column;
+
+        while (i < lineLength)
+        {
+            char c = line[i];
+
+            if (' ' == c)
+            {
+                i++;
+                cols++;
+            }
+            else if ('\t' == c)
+            {
+                i++;
+                cols += 4 - (cols % 4);
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        nextNonspace = i;
+        nextNonspaceColumn = cols;
+    }
+
+    blank = (nextNonspace >= lineLength);
+    indent = nextNonspaceColumn - column;
+    indented = (indent >= GW_CODE_INDENT);
+}
+
+void CommonMarkParser::advanceNextNonspace()
+{
+    offset = nextNonspace;
+    column = nextNonspaceColumn;
+    partiallyConsumedTab = false;
+}
+
+void CommonMarkParser::advanceOffset(int count, bool columns)
+{
+    while ((count > 0) && (offset < lineLength))
+    {
+        if ('\t' == line[offset])
+        {
+            int charsToTab = 4 - (column % 4);
+
+            if (columns)
+            {
+                partiallyConsumedTab = charsToTab > count;
+                int charsToAdvance = (charsToTab > count) ? count : charsToTab;
+                column += charsToAdvance;
+                offset += partiallyConsumedTab ? 0 : 1;
+                count -= charsToAdvance;
+            }
+            else
+            {
+                partiallyConsumedTab = false;
+                column += charsToTab;
+                offset++;
+                count--;
+            }
+        }
+        else
+        {
+            partiallyConsumedTab = false;
+            offset++;
+            column++;
+            count--;
+        }
+    }
+}
+
+void CommonMarkParser::addLine()
+{
+    Chunk* chunk = (Chunk*) arena->allocate(sizeof(Chunk));
+    chunk->leadingSpaces = 0;
+    chunk->next = NULL;
+
+    if (partiallyConsumedTab)
+    {
+        // Skip over the tab, and output the columns that are left of it as
+        // spaces.
+        //
+        offset++;
+        chunk->leadingSpaces = 4 - (column % 4);
+    }
+
+    chunk->data = line + offset;
+    chunk->length = lineLength - offset;
+
+    if (NULL != tip->lastChunk)
+    {
+        tip->lastChunk->next = chunk;
+    }
+    else
+    {
+        tip->firstChunk = chunk;
+    }
+
+    tip->lastChunk = chunk;
+}
+
+static bool canContain(int parentType, int childType)
+{
+    switch (parentType)
+    {
+        case DocumentNode:
+        case BlockQuoteNode:
+        case ItemNode:
+            return ItemNode != childType;
+        case ListNode:
+            return ItemNode == childType;
+        default:
+            return false;
+    }
+}
+
+static bool acceptsLines(int type)
+{
+    return (ParagraphNode == type) || (CodeBlockNode == type)
+        || (HtmlBlockNode == type) || (TableNode == type);
+}
+
+CommonMarkParser::Node* CommonMarkParser::addChild(int type)
+{
+    while (!canContain(tip->type, type))
+    {
+        finalize(tip);
+    }
+
+    Node* node = newNode(type);
+    node->open = true;
+    node->startLine = lineNumber;
+    appendChild(tip, node);
+    tip = node;
+    return node;
+}
+
+void CommonMarkParser::closeUnmatchedBlocks()
+{
+    if (!allClosed)
+    {
+        while (oldTip != lastMatchedContainer)
+        {
+            Node* parent = oldTip->parent;
+            finalize(oldTip);
+            oldTip = parent;
+        }
+
+        allClosed = true;
+    }
+}
+
+void CommonMarkParser::incorporateLine(const char* text, int length)
+{
+    Node* container = document;
+
+    oldTip = tip;
+    offset = 0;
+    column = 0;
+    nextNonspace = 0;
+    nextNonspaceColumn = 0;
+    blank = false;
+    partiallyConsumedTab = false;
+    lineConsumed = false;
+    lineNumber++;
+    line = text;
+    lineLength = length;
+
+    // Match the line against each open container, from the document down.
+    while ((NULL != container->last) && container->last->open)
+    {
+        container = container->last;
+        findNextNonspace();
+
+        int result = continueBlock(container);
+
+        if (1 == result)
+        {
+            container = container->parent;
+            break;
+        }
+        else if (2 == result)
+        {
+            // The line closed a fenced code block, so there's nothing more
+            // to do with it.
+            //
+            return;
+        }
+    }
+
+    allClosed = (container == oldTip);
+    lastMatchedContainer = container;
+
+    bool matchedLeaf = (ParagraphNode != container->type)
+        && (TableNode != container->type)
+        && acceptsLines(container->type);
+
+    // Look for new block starts, unless the line belongs to a leaf block that
+    // takes its lines verbatim.
+    //
+    while (!matchedLeaf)
+    {
+        findNextNonspace();
+
+        int c = peek(nextNonspace);
+
+        // Quick rejection for lines that can't start a block.
+        if (!indented && (NULL == strchr("#`~*+_=<>-0123456789", c))
+            && !((extensions & TablesExtension) && (('|' == c) || (':' == c))))
+        {
+            advanceNextNonspace();
+            break;
+        }
+
+        int result = startBlock(container);
+
+        if (0 == result)
+        {
+            advanceNextNonspace();
+            break;
+        }
+
+        container = tip;
+
+        if (2 == result)
+        {
+            matchedLeaf = true;
+        }
+    }
+
+    if (lineConsumed)
+    {
+        return;
+    }
+
+    // What remains at the offset is text.  First, check for a lazy
+    // paragraph continuation.
+    //
+    if (!allClosed && !blank && (ParagraphNode == tip->type))
+    {
+        addLine();
+        return;
+    }
+
+    closeUnmatchedBlocks();
+
+    if (blank && (NULL != container->last))
+    {
+        container->last->lastLineBlank = true;
+    }
+
+    int type = container->type;
+
+    // Block quote lines are never blank, as they start with ">", and blank
+    // lines in fenced code don't count towards loose lists.  Nor do blank
+    // lines right after an empty list item marker.
+    //
+    bool lastLineBlank = blank
+        && !((BlockQuoteNode == type)
+            || ((CodeBlockNode == type) && container->fenced)
+            || ((ItemNode == type) && (NULL == container->first)
+                && (container->startLine == lineNumber)));
+
+    for (Node* node = container; NULL != node; node = node->parent)
+    {
+        node->lastLineBlank = lastLineBlank;
+    }
+
+    if (acceptsLines(type))
+    {
+        addLine();
+
+        if ((HtmlBlockNode == type) && (container->level >= 1)
+            && (container->level <= 5)
+            && htmlBlockEnds(container->level, line + offset, lineLength - offset))
+        {
+            finalize(container);
+        }
+    }
+    else if ((offset < lineLength) && !blank)
+    {
+        addChild(ParagraphNode);
+        advanceNextNonspace();
+        addLine();
+    }
+}
+
+int CommonMarkParser::continueBlock(Node* container)
+{
+    switch (container->type)
+    {
+        case BlockQuoteNode:
+            if (!indented && ('>' == peek(nextNonspace)))
+            {
+                advanceNextNonspace();
+                advanceOffset(1, false);
+
+                if (isSpaceOrTab(peek(offset)))
+                {
+                    advanceOffset(1, true);
+                }
+
+                return 0;
+            }
+
+            return 1;
+
+        case ItemNode:
+            if (blank)
+            {
+                if (NULL == container->first)
+                {
+                    // A list item can begin with at most one blank line.
+                    return 1;
+                }
+
+                advanceNextNonspace();
+            }
+            else if (indent >= (container->markerOffset + container->padding))
+            {
+                advanceOffset(container->markerOffset + container->padding, true);
+            }
+            else
+            {
+                return 1;
+            }
+
+            return 0;
+
+        case CodeBlockNode:
+            if (container->fenced)
+            {
+                if ((indent <= 3) && (peek(nextNonspace) == container->fenceChar))
+                {
+                    int i = nextNonspace;
+
+                    while ((i < lineLength) && (line[i] == container->fenceChar))
+                    {
+                        i++;
+                    }
+
+                    if ((i - nextNonspace) >= container->fenceLength)
+                    {
+                        int j = i;
+
+                        while ((j < lineLength) && isSpaceOrTab(line[j]))
+                        {
+                            j++;
+                        }
+
+                        if (j == lineLength)
+                        {
+                            // Closing fence
+                            finalize(container);
+                            return 2;
+                        }
+                    }
+                }
+
+                // Skip optional spaces of the fence's indentation.
+                int i = container->fenceOffset;
+
+                while ((i > 0) && isSpaceOrTab(peek(offset)))
+                {
+                    advanceOffset(1, true);
+                    i--;
+                }
+            }
+            else
+            {
+                if (indent >= GW_CODE_INDENT)
+                {
+                    advanceOffset(GW_CODE_INDENT, true);
+                }
+                else if (blank)
+                {
+                    advanceNextNonspace();
+                }
+                else
+                {
+                    return 1;
+                }
+            }
+
+            return 0;
+
+        case HtmlBlockNode:
+            return (blank && ((6 == container->level) || (7 == container->level))) ? 1 : 0;
+
+        case ParagraphNode:
+        case TableNode:
+            return blank ? 1 : 0;
+
+        case HeadingNode:
+        case ThematicBreakNode:
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+int CommonMarkParser::startBlock(Node* container)
+{
+    int result = startBlockQuote();
+
+    if (0 == result)
+    {
+        result = startAtxHeading();
+    }
+
+    if (0 == result)
+    {
+        result = startFencedCode();
+    }
+
+    if (0 == result)
+    {
+        result = startHtmlBlock(container);
+    }
+
+    if (0 == result)
+    {
+        result = startSetextHeading(container);
+    }
+
+    if (0 == result)
+    {
+        result = startThematicBreak();
+    }
+
+    if ((0 == result) && (extensions & TablesExtension))
+    {
+        result = startTable(container);
+    }
+
+    if (0 == result)
+    {
+        result = startListItem(container);
+    }
+
+    if (0 == result)
+    {
+        result = startIndentedCode();
+    }
+
+    return result;
+}
+
+int CommonMarkParser::startBlockQuote()
+{
+    if (indented || ('>' != peek(nextNonspace)))
+    {
+        return 0;
+    }
+
+    advanceNextNonspace();
+    advanceOffset(1, false);
+
+    // Optional following space
+    if (isSpaceOrTab(peek(offset)))
+    {
+        advanceOffset(1, true);
+    }
+
+    closeUnmatchedBlocks();
+    addChild(BlockQuoteNode);
+    return 1;
+}
+
+int CommonMarkParser::startAtxHeading()
+{
+    if (indented || ('#' != peek(nextNonspace)))
+    {
+        return 0;
+    }
+
+    int i = nextNonspace;
+    int level = 0;
+
+    while ((i < lineLength) && ('#' == line[i]) && (level < 7))
+    {
+        i++;
+        level++;
+    }
+
+    if ((level > 6) || ((i < lineLength) && !isSpaceOrTab(line[i])))
+    {
+        return 0;
+    }
+
+    advanceNextNonspace();
+    advanceOffset(level, false);
+    closeUnmatchedBlocks();
+
+    Node* heading = addChild(HeadingNode);
+    heading->level = level;
+
+    // Remove the optional closing sequence of #'s.
+    const char* content = line + offset;
+    int end = lineLength - offset;
+
+    while ((end > 0) && isSpaceOrTab(content[end - 1]))
+    {
+        end--;
+    }
+
+    int hashes = end;
+
+    while ((hashes > 0) && ('#' == content[hashes - 1]))
+    {
+        hashes--;
+    }
+
+    if ((hashes < end) && ((0 == hashes) || isSpaceOrTab(content[hashes - 1])))
+    {
+        end = hashes;
+    }
+
+    heading->literal = content;
+    heading->literalLength = end;
+
+    advanceOffset(lineLength - offset, false);
+    return 2;
+}
+
+int CommonMarkParser::startFencedCode()
+{
+    int c = peek(nextNonspace);
+
+    if (indented || (('`' != c) && ('~' != c)))
+    {
+        return 0;
+    }
+
+    int i = nextNonspace;
+
+    while ((i < lineLength) && (line[i] == c))
+    {
+        i++;
+    }
+
+    int fenceLength = i - nextNonspace;
+
+    if (fenceLength < 3)
+    {
+        return 0;
+    }
+
+    // The info string of a backtick fence can't contain backticks.
+    if (('`' == c) && (NULL != memchr(line + i, '`', lineLength - i)))
+    {
+        return 0;
+    }
+
+    closeUnmatchedBlocks();
+
+    Node* code = addChild(CodeBlockNode);
+    code->fenced = true;
+    code->fenceChar = (char) c;
+    code->fenceLength = fenceLength;
+    code->fenceOffset = indent;
+
+    advanceNextNonspace();
+    advanceOffset(fenceLength, false);
+    return 2;
+}
+
+int CommonMarkParser::startHtmlBlock(Node* container)
+{
+    if (indented || ('<' != peek(nextNonspace)))
+    {
+        return 0;
+    }
+
+    bool canInterruptParagraph = (ParagraphNode != container->type)
+        && !(!allClosed && !blank && (ParagraphNode == tip->type));
+
+    int type = htmlBlockStartType
+        (
+            line + nextNonspace,
+            lineLength - nextNonspace,
+            canInterruptParagraph
+        );
+
+    if (0 == type)
+    {
+        return 0;
+    }
+
+    closeUnmatchedBlocks();
+
+    // The offset is not advanced, since leading spaces are part of the
+    // HTML block.
+    //
+    Node* html = addChild(HtmlBlockNode);
+    html->level = type;
+    return 2;
+}
+
+int CommonMarkParser::startSetextHeading(Node* container)
+{
+    int c = peek(nextNonspace);
+
+    if (indented || (ParagraphNode != container->type)
+        || (('=' != c) && ('-' != c)))
+    {
+        return 0;
+    }
+
+    int i = nextNonspace;
+
+    while ((i < lineLength) && (line[i] == c))
+    {
+        i++;
+    }
+
+    while ((i < lineLength) && isSpaceOrTab(line[i]))
+    {
+        i++;
+    }
+
+    if (i != lineLength)
+    {
+        return 0;
+    }
+
+    closeUnmatchedBlocks();
+    extractReferences(container);
+
+    if (0 == container->literalLength)
+    {
+        return 0;
+    }
+
+    Node* heading = newNode(HeadingNode);
+    heading->open = true;
+    heading->startLine = container->startLine;
+    heading->level = ('=' == c) ? 1 : 2;
+    heading->literal = container->literal;
+    heading->literalLength = container->literalLength;
+
+    insertAfter(container, heading);
+    unlink(container);
+    tip = heading;
+
+    advanceOffset(lineLength - offset, false);
+    return 2;
+}
+
+int CommonMarkParser::startThematicBreak()
+{
+    int c = peek(nextNonspace);
+
+    if (indented || (('*' != c) && ('-' != c) && ('_' != c)))
+    {
+        return 0;
+    }
+
+    int count = 0;
+
+    for (int i = nextNonspace; i < lineLength; i++)
+    {
+        if (line[i] == c)
+        {
+            count++;
+        }
+        else if (!isSpaceOrTab(line[i]))
+        {
+            return 0;
+        }
+    }
+
+    if (count < 3)
+    {
+        return 0;
+    }
+
+    closeUnmatchedBlocks();
+    addChild(ThematicBreakNode);
+    advanceOffset(lineLength - offset, false);
+    return 2;
+}
+
+int CommonMarkParser::startTable(Node* container)
+{
+    if (indented || (ParagraphNode != container->type)
+        || (NULL == container->lastChunk))
+    {
+        return 0;
+    }
+
+    Chunk* header = container->lastChunk;
+    int columns = splitTableRow(header->data, header->length, NULL, 0);
+    char alignments[64];
+
+    if ((columns > 64) || (columns != parseTableDelimiterRow
+        (
+            line + nextNonspace,
+            lineLength - nextNonspace,
+            alignments,
+            64
+        )))
+    {
+        return 0;
+    }
+
+    closeUnmatchedBlocks();
+
+    // The last line of the paragraph becomes the table header.  Any lines
+    // before it remain a paragraph.
+    //
+    if (container->firstChunk == header)
+    {
+        tip = container->parent;
+        unlink(container);
+    }
+    else
+    {
+        Chunk* chunk = container->firstChunk;
+
+        while (chunk->next != header)
+        {
+            chunk = chunk->next;
+        }
+
+        chunk->next = NULL;
+        container->lastChunk = chunk;
+        finalize(container);
+    }
+
+    Node* table = addChild(TableNode);
+    table->level = columns;
+    table->alignments = arena->allocateString(columns);
+    memcpy(table->alignments, alignments, columns);
+    table->firstChunk = header;
+    table->lastChunk = header;
+
+    advanceOffset(lineLength - offset, false);
+    lineConsumed = true;
+    return 2;
+}
+
+int CommonMarkParser::startListItem(Node* container)
+{
+    if ((indented && (ListNode != container->type)) || (indent >= GW_CODE_INDENT))
+    {
+        return 0;
+    }
+
+    int c = peek(nextNonspace);
+    int markerLength = 0;
+    bool ordered = false;
+    char bulletChar = 0;
+    char delimiter = 0;
+    int start = 0;
+
+    if (('*' == c) || ('+' == c) || ('-' == c))
+    {
+        bulletChar = (char) c;
+        markerLength = 1;
+    }
+    else if (isAsciiDigit(c))
+    {
+        int i = nextNonspace;
+
+        while ((i < lineLength) && isAsciiDigit(line[i]) && ((i - nextNonspace) < 10))
+        {
+            start = (start * 10) + (line[i] - '0');
+            i++;
+        }
+
+        int digits = i - nextNonspace;
+
+        if ((digits > 9) || (i >= lineLength)
+            || (('.' != line[i]) && (')' != line[i])))
+        {
+            return 0;
+        }
+
+        // Only lists starting with 1 can interrupt a paragraph.
+        if ((ParagraphNode == container->type) && (1 != start))
+        {
+            return 0;
+        }
+
+        ordered = true;
+        delimiter = line[i];
+        markerLength = digits + 1;
+    }
+    else
+    {
+        return 0;
+    }
+
+    // The marker must be followed by whitespace.
+    int nextc = peek(nextNonspace + markerLength);
+
+    if ((-1 != nextc) && !isSpaceOrTab(nextc))
+    {
+        return 0;
+    }
+
+    // An empty list item can't interrupt a paragraph.
+    if (ParagraphNode == container->type)
+    {
+        int i = nextNonspace + markerLength;
+
+        while ((i < lineLength) && isSpaceOrTab(line[i]))
+        {
+            i++;
+        }
+
+        if (i >= lineLength)
+        {
+            return 0;
+        }
+    }
+
+    int markerOffset = indent;
+
+    advanceNextNonspace();
+    advanceOffset(markerLength, true);
+
+    int spacesStartColumn = column;
+    int spacesStartOffset = offset;
+
+    do
+    {
+        advanceOffset(1, true);
+        nextc = peek(offset);
+    }
+    while (((column - spacesStartColumn) < 5) && isSpaceOrTab(nextc));
+
+    bool blankItem = (-1 == peek(offset));
+    int spacesAfterMarker = column - spacesStartColumn;
+    int padding;
+
+    if ((spacesAfterMarker >= 5) || (spacesAfterMarker < 1) || blankItem)
+    {
+        padding = markerLength + 1;
+        column = spacesStartColumn;
+        offset = spacesStartOffset;
+
+        if (isSpaceOrTab(peek(offset)))
+        {
+            advanceOffset(1, true);
+        }
+    }
+    else
+    {
+        padding = markerLength + spacesAfterMarker;
+    }
+
+    closeUnmatchedBlocks();
+
+    if ((ListNode != tip->type) || (tip->ordered != ordered)
+        || (tip->bulletChar != bulletChar) || (tip->delimiter != delimiter))
+    {
+        Node* list = addChild(ListNode);
+        list->ordered = ordered;
+        list->bulletChar = bulletChar;
+        list->delimiter = delimiter;
+        list->start = start;
+        list->tight = true;
+    }
+
+    Node* item = addChild(ItemNode);
+    item->ordered = ordered;
+    item->bulletChar = bulletChar;
+    item->delimiter = delimiter;
+    item->markerOffset = markerOffset;
+    item->padding = padding;
+    return 1;
+}
+
+int CommonMarkParser::startIndentedCode()
+{
+    if (!indented || blank || (ParagraphNode == tip->type)
+        || (TableNode == tip->type))
+    {
+        return 0;
+    }
+
+    advanceOffset(GW_CODE_INDENT, true);
+    closeUnmatchedBlocks();
+    addChild(CodeBlockNode);
+    return 2;
+}
+
+void CommonMarkParser::materializeContent(Node* block)
+{
+    Chunk* chunk = block->firstChunk;
+
+    if (NULL == chunk)
+    {
+        block->literal = "";
+        block->literalLength = 0;
+        return;
+    }
+
+    // Lines that were not stripped of any prefix are still contiguous in the
+    // input, in which case there's no need to copy them.
+    //
+    bool contiguous = true;
+    size_t size = 0;
+
+    for (Chunk* c = chunk; NULL != c; c = c->next)
+    {
+        size += c->leadingSpaces + c->length + 1;
+
+        if ((c->leadingSpaces > 0)
+            || ((NULL != c->next) && (c->next->data != (c->data + c->length + 1))))
+        {
+            contiguous = false;
+        }
+    }
+
+    size--;
+
+    if (contiguous)
+    {
+        block->literal = chunk->data;
+        block->literalLength = size;
+        return;
+    }
+
+    char* content = arena->allocateString(size + 1);
+    char* p = content;
+
+    for (Chunk* c = chunk; NULL != c; c = c->next)
+    {
+        memset(p, ' ', c->leadingSpaces);
+        p += c->leadingSpaces;
+        memcpy(p, c->data, c->length);
+        p += c->length;
+        *p++ = '\n';
+    }
+
+    block->literal = content;
+    block->literalLength = size;
+}
+
+bool CommonMarkParser::extractReferences(Node* block)
+{
+    bool found = false;
+
+    materializeContent(block);
+
+    while ((block->literalLength > 0) && ('[' == block->literal[0]))
+    {
+        int consumed = parseReference(block->literal, block->literalLength);
+
+        if (0 == consumed)
+        {
+            break;
+        }
+
+        block->literal += consumed;
+        block->literalLength -= consumed;
+        found = true;
+    }
+
+    if (found)
+    {
+        // Keep the remaining lines in sync with the content, in case more
+        // lines are added to the paragraph.
+        //
+        if (block->literalLength > 0)
+        {
+            Chunk* chunk = (Chunk*) arena->allocate(sizeof(Chunk));
+            chunk->data = block->literal;
+            chunk->length = block->literalLength;
+            chunk->leadingSpaces = 0;
+            chunk->next = NULL;
+            block->firstChunk = chunk;
+            block->lastChunk = chunk;
+        }
+        else
+        {
+            block->firstChunk = NULL;
+            block->lastChunk = NULL;
+        }
+    }
+
+    return found;
+}
+
+bool CommonMarkParser::endsWithBlankLine(Node* block) const
+{
+    while (NULL != block)
+    {
+        if (block->lastLineBlank)
+        {
+            return true;
+        }
+
+        if (!block->lastLineChecked
+            && ((ListNode == block->type) || (ItemNode == block->type)))
+        {
+            block->lastLineChecked = true;
+            block = block->last;
+        }
+        else
+        {
+            block->lastLineChecked = true;
+            break;
+        }
+    }
+
+    return false;
+}
+
+static bool isBlankLine(const char* s, int length)
+{
+    for (int i = 0; i < length; i++)
+    {
+        if (!isLineWhitespace(s[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void CommonMarkParser::finalize(Node* block)
+{
+    Node* above = block->parent;
+    block->open = false;
+
+    switch (block->type)
+    {
+        case ParagraphNode:
+            if (extractReferences(block)
+                && isBlankLine(block->literal, block->literalLength))
+            {
+                unlink(block);
+            }
+            break;
+
+        case CodeBlockNode:
+            if (block->fenced)
+            {
+                // The first line is the info string.
+                Chunk* info = block->firstChunk;
+
+                if (NULL != info)
+                {
+                    int start = 0;
+                    int end = info->length;
+
+                    while ((start < end) && isLineWhitespace(info->data[start]))
+                    {
+                        start++;
+                    }
+
+                    while ((end > start) && isLineWhitespace(info->data[end - 1]))
+                    {
+                        end--;
+                    }
+
+                    block->url = unescapeString
+                        (
+                            info->data + start,
+                            end - start,
+                            &block->urlLength
+                        );
+
+                    block->firstChunk = info->next;
+
+                    if (NULL == block->firstChunk)
+                    {
+                        block->lastChunk = NULL;
+                    }
+                }
+            }
+            else
+            {
+                // Trailing blank lines are not part of indented code.
+                Chunk* lastNonBlank = NULL;
+
+                for (Chunk* c = block->firstChunk; NULL != c; c = c->next)
+                {
+                    if (!isBlankLine(c->data, c->length))
+                    {
+                        lastNonBlank = c;
+                    }
+                }
+
+                if (NULL != lastNonBlank)
+                {
+                    lastNonBlank->next = NULL;
+                }
+                else
+                {
+                    block->firstChunk = NULL;
+                }
+
+                block->lastChunk = lastNonBlank;
+            }
+            break;
+
+        case HtmlBlockNode:
+        {
+            // Trailing lines consisting only of spaces are dropped.
+            Chunk* lastNonBlank = NULL;
+
+            for (Chunk* c = block->firstChunk; NULL != c; c = c->next)
+            {
+                bool spacesOnly = true;
+
+                for (int i = 0; i < c->length; i++)
+                {
+                    if (' ' != c->data[i])
+                    {
+                        spacesOnly = false;
+                        break;
+                    }
+                }
+
+                if (!spacesOnly || (c == block->firstChunk))
+                {
+                    lastNonBlank = c;
+                }
+            }
+
+            if (NULL != lastNonBlank)
+            {
+                lastNonBlank->next = NULL;
+            }
+
+            block->lastChunk = lastNonBlank;
+            break;
+        }
+
+        case ListNode:
+        {
+            for (Node* item = block->first; NULL != item; item = item->next)
+            {
+                if (endsWithBlankLine(item) && (NULL != item->next))
+                {
+                    block->tight = false;
+                    break;
+                }
+
+                // Recurse into the children of the list item, to see if
+                // there are spaces between any of them.
+                //
+                for (Node* sub = item->first; NULL != sub; sub = sub->next)
+                {
+                    if (endsWithBlankLine(sub)
+                        && ((NULL != item->next) || (NULL != sub->next)))
+                    {
+                        block->tight = false;
+                        break;
+                    }
+                }
+
+                if (!block->tight)
+                {
+                    break;
+                }
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    tip = above;
+}
+
+void CommonMarkParser::processInlines()
+{
+    Node* node = document;
+
+    // Walk the block tree iteratively, so that deeply nested documents can't
+    // overflow the stack.
+    //
+    while (NULL != node)
+    {
+        Node* next = NULL;
+
+        switch (node->type)
+        {
+            case DocumentNode:
+            case BlockQuoteNode:
+            case ListNode:
+                next = node->first;
+                break;
+
+            case ItemNode:
+                if (extensions & TaskListExtension)
+                {
+                    processTaskListItem(node);
+                }
+
+                next = node->first;
+                break;
+
+            case ParagraphNode:
+            case HeadingNode:
+                parseInlines(node, node->literal, node->literalLength);
+                break;
+
+            case TableNode:
+                processTable(node);
+                break;
+
+            default:
+                break;
+        }
+
+        if (NULL == next)
+        {
+            // Move on to the next sibling, or the next sibling of the
+            // nearest ancestor that has one.
+            //
+            Node* current = node;
+
+            while ((NULL != current) && (NULL == current->next))
+            {
+                current = current->parent;
+            }
+
+            next = (NULL != current) ? current->next : NULL;
+        }
+
+        node = next;
+    }
+}
+
+void CommonMarkParser::processTable(Node* table)
+{
+    int columns = table->level;
+    TableCellSpan* cells = (TableCellSpan*)
+        arena->allocate(sizeof(TableCellSpan) * columns);
+    bool header = true;
+
+    for (Chunk* chunk = table->firstChunk; NULL != chunk; chunk = chunk->next)
+    {
+        Node* row = newNode(TableRowNode);
+        row->level = header ? 1 : 0;
+        appendChild(table, row);
+
+        int count = splitTableRow(chunk->data, chunk->length, cells, columns);
+
+        for (int i = 0; i < columns; i++)
+        {
+            Node* cell = newNode(TableCellNode);
+            cell->level = row->level;
+            appendChild(row, cell);
+
+            if (i >= count)
+            {
+                continue;
+            }
+
+            // Escaped pipes are unescaped before the cell's content is
+            // parsed, even inside code spans.
+            //
+            const char* content = cells[i].data;
+            int length = cells[i].length;
+
+            for (int j = 0; (j + 1) < length; j++)
+            {
+                if (('\\' == content[j]) && ('|' == content[j + 1]))
+                {
+                    char* unescaped = arena->allocateString(length);
+                    int k = 0;
+
+                    for (int m = 0; m < length; m++)
+                    {
+                        if (('\\' == content[m]) && ((m + 1) < length)
+                            && ('|' == content[m + 1]))
+                        {
+                            continue;
+                        }
+
+                        unescaped[k++] = content[m];
+                    }
+
+                    content = unescaped;
+                    length = k;
+                    break;
+                }
+            }
+
+            parseInlines(cell, content, length);
+        }
+
+        header = false;
+    }
+}
+
+void CommonMarkParser::processTaskListItem(Node* item)
+{
+    Node* paragraph = item->first;
+
+    if ((NULL == paragraph) || (ParagraphNode != paragraph->type)
+        || (paragraph->literalLength < 4))
+    {
+        return;
+    }
+
+    const char* s = paragraph->literal;
+    int taskState;
+
+    if ((' ' == s[1]) && ('[' == s[0]) && (']' == s[2]))
+    {
+        taskState = UncheckedTask;
+    }
+    else if ((('x' == s[1]) || ('X' == s[1])) && ('[' == s[0]) && (']' == s[2]))
+    {
+        taskState = CheckedTask;
+    }
+    else
+    {
+        return;
+    }
+
+    if (!isLineWhitespace(s[3]))
+    {
+        return;
+    }
+
+    item->taskState = taskState;
+    paragraph->literal += 4;
+    paragraph->literalLength -= 4;
+}
+
+void CommonMarkParser::parseInlines(Node* block, const char* text, int length)
+{
+    // Leading and trailing whitespace is not part of the content.
+    while ((length > 0) && isLineWhitespace(text[0]))
+    {
+        text++;
+        length--;
+    }
+
+    while ((length > 0) && isLineWhitespace(text[length - 1]))
+    {
+        length--;
+    }
+
+    subject = text;
+    subjectLength = length;
+    pos = 0;
+    delimiters = NULL;
+    brackets = NULL;
+    backticksScanned = false;
+    memset(backtickPositions, 0, sizeof(backtickPositions));
+
+    while (pos < subjectLength)
+    {
+        parseInline(block);
+    }
+
+    processEmphasis(NULL);
+}
+
+void CommonMarkParser::parseInline(Node* block)
+{
+    char c = subject[pos];
+    bool handled = false;
+
+    switch (c)
+    {
+        case '\n':
+            handled = parseNewline(block);
+            break;
+        case '\\':
+            handled = parseBackslash(block);
+            break;
+        case '`':
+            handled = parseBackticks(block);
+            break;
+        case '*':
+        case '_':
+            handled = parseDelimiters(c, block);
+            break;
+        case '~':
+            if (extensions & StrikethroughExtension)
+            {
+                handled = parseDelimiters(c, block);
+            }
+            break;
+        case '[':
+            handled = parseOpenBracket(block);
+            break;
+        case '!':
+            handled = parseBang(block);
+            break;
+        case ']':
+            handled = parseCloseBracket(block);
+            break;
+        case '<':
+            handled = parseAutolink(block) || parseHtmlTag(block);
+            break;
+        case '&':
+            handled = parseEntity(block);
+            break;
+        case ':':
+        case '.':
+        case '@':
+            if (extensions & AutolinkExtension)
+            {
+                handled = parseExtendedAutolink(c, block);
+            }
+            break;
+        default:
+            handled = parseString(block);
+            break;
+    }
+
+    if (!handled)
+    {
+        appendText(block, subject + pos, 1);
+        pos++;
+    }
+}
+
+CommonMarkParser::Node* CommonMarkParser::appendText
+(
+    Node* block,
+    const char* text,
+    int length,
+    bool mergeable
+)
+{
+    Node* last = block->last;
+
+    // Adjacent runs of text are merged into one node, so that plain text
+    // doesn't become a node per punctuation character.
+    //
+    if (mergeable && (NULL != last) && (TextNode == last->type)
+        && !last->delimiterText
+        && ((last->literal + last->literalLength) == text))
+    {
+        last->literalLength += length;
+        return last;
+    }
+
+    Node* node = newNode(TextNode);
+    node->literal = text;
+    node->literalLength = length;
+    node->delimiterText = !mergeable;
+    appendChild(block, node);
+    return node;
+}
+
+CommonMarkParser::Node* CommonMarkParser::trailingText(Node* block, int minLength)
+{
+    Node* last = block->last;
+
+    if ((NULL != last) && (TextNode == last->type) && !last->delimiterText
+        && (last->literalLength >= minLength)
+        && ((last->literal + last->literalLength) == (subject + pos)))
+    {
+        return last;
+    }
+
+    return NULL;
+}
+
+bool CommonMarkParser::parseString(Node* block)
+{
+    const char* start = subject + pos;
+    const char* end = inlineScanner->find(start + 1, subject + subjectLength);
+
+    appendText(block, start, end - start);
+    pos += end - start;
+    return true;
+}
+
+bool CommonMarkParser::parseNewline(Node* block)
+{
+    pos++;
+
+    Node* last = block->last;
+
+    if ((NULL != last) && (TextNode == last->type) && (last->literalLength > 0)
+        && (' ' == last->literal[last->literalLength - 1]))
+    {
+        bool hardBreak = (last->literalLength >= 2)
+            && (' ' == last->literal[last->literalLength - 2]);
+
+        while ((last->literalLength > 0)
+            && (' ' == last->literal[last->literalLength - 1]))
+        {
+            last->literalLength--;
+        }
+
+        appendChild(block, newNode(hardBreak ? LineBreakNode : SoftBreakNode));
+    }
+    else
+    {
+        appendChild(block, newNode(SoftBreakNode));
+    }
+
+    // Gobble the leading spaces of the next line.
+    while ((pos < subjectLength) && (' ' == subject[pos]))
+    {
+        pos++;
+    }
+
+    return true;
+}
+
+bool CommonMarkParser::parseBackslash(Node* block)
+{
+    pos++;
+
+    if ((pos < subjectLength) && ('\n' == subject[pos]))
+    {
+        pos++;
+        appendChild(block, newNode(LineBreakNode));
+    }
+    else if ((pos < subjectLength) && isAsciiPunctuation(subject[pos]))
+    {
+        appendText(block, subject + pos, 1);
+        pos++;
+    }
+    else
+    {
+        appendText(block, subject + pos - 1, 1);
+    }
+
+    return true;
+}
+
+bool CommonMarkParser::parseBackticks(Node* block)
+{
+    int start = pos;
+
+    while ((pos < subjectLength) && ('`' == subject[pos]))
+    {
+        pos++;
+    }
+
+    int ticks = pos - start;
+    int afterOpenTicks = pos;
+
+    // Remember where runs of each length were last seen, so that unmatched
+    // backticks don't make parsing quadratic.
+    //
+    if (!backticksScanned || ((ticks < GW_MAX_BACKTICKS)
+        && (backtickPositions[ticks] >= afterOpenTicks)))
+    {
+        int i = afterOpenTicks;
+
+        while (i < subjectLength)
+        {
+            const char* found = (const char*)
+                memchr(subject + i, '`', subjectLength - i);
+
+            if (NULL == found)
+            {
+                break;
+            }
+
+            int runStart = found - subject;
+            int runEnd = runStart;
+
+            while ((runEnd < subjectLength) && ('`' == subject[runEnd]))
+            {
+                runEnd++;
+            }
+
+            int runLength = runEnd - runStart;
+
+            if (runLength < GW_MAX_BACKTICKS)
+            {
+                backtickPositions[runLength] = runStart;
+            }
+
+            if (runLength == ticks)
+            {
+                Node* code = newNode(CodeNode);
+                const char* content = subject + afterOpenTicks;
+                int length = runStart - afterOpenTicks;
+
+                // Line endings are converted to spaces.
+                if (NULL != memchr(content, '\n', length))
+                {
+                    char* converted = arena->allocateString(length);
+
+                    for (int j = 0; j < length; j++)
+                    {
+                        converted[j] = ('\n' == content[j]) ? ' ' : content[j];
+                    }
+
+                    content = converted;
+                }
+
+                // Strip one space from each side, unless the code is all
+                // spaces.
+                //
+                if ((length >= 2) && (' ' == content[0])
+                    && (' ' == content[length - 1]))
+                {
+                    bool allSpaces = true;
+
+                    for (int j = 0; j < length; j++)
+                    {
+                        if (' ' != content[j])
+                        {
+                            allSpaces = false;
+                            break;
+                        }
+                    }
+
+                    if (!allSpaces)
+                    {
+                        content++;
+                        length -= 2;
+                    }
+                }
+
+                code->literal = content;
+                code->literalLength = length;
+                appendChild(block, code);
+                pos = runEnd;
+                return true;
+            }
+
+            i = runEnd;
+        }
+
+        backticksScanned = true;
+    }
+
+    // No closing backtick run was found.
+    appendText(block, subject + start, ticks);
+    pos = afterOpenTicks;
+    return true;
+}
+
+bool CommonMarkParser::parseDelimiters(char c, Node* block)
+{
+    int start = pos;
+
+    while ((pos < subjectLength) && (c == subject[pos]))
+    {
+        pos++;
+    }
+
+    int numDelims = pos - start;
+
+    unsigned int charBefore = '\n';
+    unsigned int charAfter = '\n';
+
+    if (start > 0)
+    {
+        int before = start - 1;
+
+        while ((before > 0) && ((subject[before] & 0xC0) == 0x80)
+            && ((start - before) < 4))
+        {
+            before--;
+        }
+
+        charBefore = decodeUtf8(subject + before, start - before, NULL);
+    }
+
+    if (pos < subjectLength)
+    {
+        charAfter = decodeUtf8(subject + pos, subjectLength - pos, NULL);
+    }
+
+    bool afterIsWhitespace = isUnicodeWhitespace(charAfter);
+    bool afterIsPunctuation = isUnicodePunctuation(charAfter);
+    bool beforeIsWhitespace = isUnicodeWhitespace(charBefore);
+    bool beforeIsPunctuation = isUnicodePunctuation(charBefore);
+
+    bool leftFlanking = !afterIsWhitespace
+        && (!afterIsPunctuation || beforeIsWhitespace || beforeIsPunctuation);
+    bool rightFlanking = !beforeIsWhitespace
+        && (!beforeIsPunctuation || afterIsWhitespace || afterIsPunctuation);
+    bool canOpen;
+    bool canClose;
+
+    if ('_' == c)
+    {
+        canOpen = leftFlanking && (!rightFlanking || beforeIsPunctuation);
+        canClose = rightFlanking && (!leftFlanking || afterIsPunctuation);
+    }
+    else
+    {
+        canOpen = leftFlanking;
+        canClose = rightFlanking;
+    }
+
+    // Runs of more than two tildes are never strikethrough.
+    if (('~' == c) && (numDelims > 2))
+    {
+        appendText(block, subject + start, numDelims);
+        return true;
+    }
+
+    Node* node = appendText(block, subject + start, numDelims, false);
+
+    if (canOpen || canClose)
+    {
+        Delimiter* delim = (Delimiter*) arena->allocate(sizeof(Delimiter));
+        delim->c = c;
+        delim->numDelims = numDelims;
+        delim->origDelims = numDelims;
+        delim->node = node;
+        delim->previous = delimiters;
+        delim->next = NULL;
+        delim->canOpen = canOpen;
+        delim->canClose = canClose;
+
+        if (NULL != delimiters)
+        {
+            delimiters->next = delim;
+        }
+
+        delimiters = delim;
+    }
+
+    return true;
+}
+
+bool CommonMarkParser::parseOpenBracket(Node* block)
+{
+    Node* node = appendText(block, subject + pos, 1, false);
+
+    if (NULL != brackets)
+    {
+        brackets->bracketAfter = true;
+    }
+
+    Bracket* bracket = (Bracket*) arena->allocate(sizeof(Bracket));
+    bracket->node = node;
+    bracket->previous = brackets;
+    bracket->previousDelimiter = delimiters;
+    bracket->index = pos;
+    bracket->image = false;
+    bracket->active = true;
+    bracket->bracketAfter = false;
+    brackets = bracket;
+
+    pos++;
+    return true;
+}
+
+bool CommonMarkParser::parseBang(Node* block)
+{
+    if (((pos + 1) < subjectLength) && ('[' == subject[pos + 1]))
+    {
+        Node* node = appendText(block, subject + pos, 2, false);
+
+        if (NULL != brackets)
+        {
+            brackets->bracketAfter = true;
+        }
+
+        Bracket* bracket = (Bracket*) arena->allocate(sizeof(Bracket));
+        bracket->node = node;
+        bracket->previous = brackets;
+        bracket->previousDelimiter = delimiters;
+        bracket->index = pos + 1;
+        bracket->image = true;
+        bracket->active = true;
+        bracket->bracketAfter = false;
+        brackets = bracket;
+
+        pos += 2;
+        return true;
+    }
+
+    return false;
+}
+
+bool CommonMarkParser::parseCloseBracket(Node* block)
+{
+    pos++;
+
+    int startPos = pos;
+    Bracket* opener = brackets;
+
+    if (NULL == opener)
+    {
+        appendText(block, subject + pos - 1, 1);
+        return true;
+    }
+
+    if (!opener->active)
+    {
+        appendText(block, subject + pos - 1, 1);
+        brackets = opener->previous;
+        return true;
+    }
+
+    bool isImage = opener->image;
+    bool matched = false;
+    const char* dest = NULL;
+    int destLength = 0;
+    const char* title = NULL;
+    int titleLength = 0;
+
+    // Inline link?
+    if ((pos < subjectLength) && ('(' == subject[pos]))
+    {
+        int savePos = pos;
+        pos++;
+        skipSpacesAndNewline();
+
+        if (parseLinkDestination(&dest, &destLength))
+        {
+            int beforeTitle = pos;
+            skipSpacesAndNewline();
+
+            // There must be whitespace before the title.
+            if ((pos > beforeTitle) && !parseLinkTitle(&title, &titleLength))
+            {
+                title = NULL;
+            }
+
+            skipSpacesAndNewline();
+
+            if ((pos < subjectLength) && (')' == subject[pos]))
+            {
+                pos++;
+                matched = true;
+                dest = unescapeString(dest, destLength, &destLength);
+
+                if (NULL != title)
+                {
+                    title = unescapeString(title, titleLength, &titleLength);
+                }
+            }
+        }
+
+        if (!matched)
+        {
+            pos = savePos;
+            title = NULL;
+        }
+    }
+
+    // Reference link?
+    if (!matched)
+    {
+        int beforeLabel = pos;
+        int labelLength = parseLinkLabel();
+        const char* label = NULL;
+        int length = 0;
+
+        if (labelLength > 2)
+        {
+            label = subject + beforeLabel;
+            length = labelLength;
+        }
+        else if (!opener->bracketAfter)
+        {
+            // An empty or missing second label means the first label is the
+            // reference.  It can't contain a bracket, which is already known
+            // if there was one.
+            //
+            label = subject + opener->index;
+            length = startPos - opener->index;
+        }
+
+        if (0 == labelLength)
+        {
+            // Rewind for shortcut reference links.
+            pos = startPos;
+        }
+
+        LinkReference ref;
+
+        if ((NULL != label) && lookupReference(label, length, ref))
+        {
+            dest = ref.url;
+            destLength = ref.urlLength;
+            title = ref.title;
+            titleLength = ref.titleLength;
+            matched = true;
+        }
+    }
+
+    if (!matched)
+    {
+        brackets = opener->previous;
+        pos = startPos;
+        appendText(block, subject + pos - 1, 1);
+        return true;
+    }
+
+    Node* link = newNode(isImage ? ImageNode : LinkNode);
+    link->url = dest;
+    link->urlLength = destLength;
+    link->title = title;
+    link->titleLength = titleLength;
+
+    Node* child = opener->node->next;
+
+    while (NULL != child)
+    {
+        Node* next = child->next;
+        unlink(child);
+        appendChild(link, child);
+        child = next;
+    }
+
+    appendChild(block, link);
+    processEmphasis(opener->previousDelimiter);
+    brackets = opener->previous;
+    unlink(opener->node);
+
+    // Links may not contain other links, so deactivate earlier link
+    // openers.
+    //
+    if (!isImage)
+    {
+        for (Bracket* b = brackets; NULL != b; b = b->previous)
+        {
+            if (!b->image)
+            {
+                b->active = false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool CommonMarkParser::parseAutolink(Node* block)
+{
+    const char* s = subject + pos;
+    int length = subjectLength - pos;
+    int i = 1;
+
+    // URI autolink: <scheme:...>
+    if ((i < length) && isAsciiAlpha(s[i]))
+    {
+        i++;
+
+        while ((i < length) && (isAsciiAlnum(s[i]) || ('.' == s[i])
+            || ('+' == s[i]) || ('-' == s[i])))
+        {
+            i++;
+        }
+
+        int schemeLength = i - 1;
+
+        if ((schemeLength >= 2) && (schemeLength <= 32) && (i < length)
+            && (':' == s[i]))
+        {
+            i++;
+
+            while ((i < length) && ('>' != s[i]) && ('<' != s[i])
+                && ((unsigned char) s[i] > 0x20))
+            {
+                i++;
+            }
+
+            if ((i < length) && ('>' == s[i]))
+            {
+                addAutolink(block, pos + 1, pos + i, NULL);
+                pos += i + 1;
+                return true;
+            }
+        }
+    }
+
+    // Email autolink: <user@domain>
+    static const char* emailChars = ".!#$%&'*+/=?^_`{|}~-";
+    i = 1;
+
+    while ((i < length) && (isAsciiAlnum(s[i]) || (NULL != strchr(emailChars, s[i]))))
+    {
+        i++;
+    }
+
+    if ((i == 1) || (i >= length) || ('@' != s[i]))
+    {
+        return false;
+    }
+
+    i++;
+
+    // Domain labels of up to 63 alphanumeric characters or hyphens, not
+    // starting or ending with a hyphen.
+    //
+    while (true)
+    {
+        int labelStart = i;
+
+        while ((i < length) && (isAsciiAlnum(s[i]) || ('-' == s[i]))
+            && ((i - labelStart) < 63))
+        {
+            i++;
+        }
+
+        if ((i == labelStart) || ('-' == s[labelStart]) || ('-' == s[i - 1]))
+        {
+            return false;
+        }
+
+        if ((i < length) && ('.' == s[i]))
+        {
+            i++;
+            continue;
+        }
+
+        break;
+    }
+
+    if ((i >= length) || ('>' != s[i]))
+    {
+        return false;
+    }
+
+    addAutolink(block, pos + 1, pos + i, "mailto:");
+    pos += i + 1;
+    return true;
+}
+
+bool CommonMarkParser::parseHtmlTag(Node* block)
+{
+    int length = scanHtmlTag(subject + pos, subjectLength - pos);
+
+    if (0 == length)
+    {
+        return false;
+    }
+
+    Node* html = newNode(HtmlInlineNode);
+    html->literal = subject + pos;
+    html->literalLength = length;
+    appendChild(block, html);
+    pos += length;
+    return true;
+}
+
+bool CommonMarkParser::parseEntity(Node* block)
+{
+    char decoded[8];
+    int decodedLength = 0;
+    int length = decodeEntity
+        (
+            subject + pos,
+            subjectLength - pos,
+            decoded,
+            &decodedLength
+        );
+
+    if (0 == length)
+    {
+        return false;
+    }
+
+    char* text = arena->allocateString(decodedLength);
+    memcpy(text, decoded, decodedLength);
+    appendText(block, text, decodedLength);
+    pos += length;
+    return true;
+}
+
+bool CommonMarkParser::parseExtendedAutolink(char c, Node* block)
+{
+    switch (c)
+    {
+        case '.':
+            return parseWwwAutolink(block);
+        case ':':
+            return parseUrlAutolink(block);
+        case '@':
+            return parseEmailAutolink(block);
+        default:
+            return false;
+    }
+}
+
+/*
+ * Returns the length of a valid domain name at the start of s, or 0 if
+ * there is none.  Underscores are not allowed in the last two segments.
+ */
+static int scanDomain(const char* s, int length, bool allowShort)
+{
+    int i;
+    int periods = 0;
+    int underscores1 = 0;
+    int underscores2 = 0;
+
+    for (i = 1; i < (length - 1); i++)
+    {
+        unsigned char c = s[i];
+
+        if (('\\' == c) && (i < (length - 2)))
+        {
+            i++;
+            c = s[i];
+        }
+
+        if ('_' == c)
+        {
+            underscores2++;
+        }
+        else if ('.' == c)
+        {
+            underscores1 = underscores2;
+            underscores2 = 0;
+            periods++;
+        }
+        else if ((c < 0x80) && !isAsciiAlnum(c) && ('-' != c))
+        {
+            break;
+        }
+    }
+
+    if ((underscores1 > 0) || (underscores2 > 0))
+    {
+        return 0;
+    }
+
+    if (allowShort || (periods > 0))
+    {
+        return i;
+    }
+
+    return 0;
+}
+
+/*
+ * Trims trailing punctuation, unbalanced closing parentheses and entity
+ * references from the end of an extended autolink.
+ */
+static int trimAutolinkEnd(const char* s, int end)
+{
+    int opening = 0;
+    int closing = 0;
+
+    for (int i = 0; i < end; i++)
+    {
+        if ('<' == s[i])
+        {
+            end = i;
+            break;
+        }
+        else if ('(' == s[i])
+        {
+            opening++;
+        }
+        else if (')' == s[i])
+        {
+            closing++;
+        }
+    }
+
+    while (end > 0)
+    {
+        switch (s[end - 1])
+        {
+            case ')':
+                if (closing <= opening)
+                {
+                    return end;
+                }
+
+                closing--;
+                end--;
+                break;
+
+            case '?':
+            case '!':
+            case '.':
+            case ',':
+            case ':':
+            case '*':
+            case '_':
+            case '~':
+            case '\'':
+            case '"':
+                end--;
+                break;
+
+            case ';':
+            {
+                int entityStart = end - 2;
+
+                while ((entityStart > 0) && isAsciiAlpha(s[entityStart]))
+                {
+                    entityStart--;
+                }
+
+                if ((entityStart < (end - 2)) && ('&' == s[entityStart]))
+                {
+                    end = entityStart;
+                }
+                else
+                {
+                    end--;
+                }
+                break;
+            }
+
+            default:
+                return end;
+        }
+    }
+
+    return end;
+}
+
+static int scanLinkPath(const char* s, int length, int i)
+{
+    while ((i < length) && !isLineWhitespace(s[i]) && ('<' != s[i]))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+bool CommonMarkParser::parseWwwAutolink(Node* block)
+{
+    Node* text = trailingText(block, 3);
+
+    if ((NULL == text) || (0 != memcmp(subject + pos - 3, "www", 3)))
+    {
+        return false;
+    }
+
+    int start = pos - 3;
+
+    if ((start > 0) && !isLineWhitespace(subject[start - 1])
+        && (NULL == strchr("*_~(", subject[start - 1])))
+    {
+        return false;
+    }
+
+    const char* s = subject + start;
+    int length = subjectLength - start;
+    int end = scanDomain(s, length, false);
+
+    if (0 == end)
+    {
+        return false;
+    }
+
+    end = trimAutolinkEnd(s, scanLinkPath(s, length, end));
+
+    if (end <= 4)
+    {
+        return false;
+    }
+
+    text->literalLength -= 3;
+
+    if (0 == text->literalLength)
+    {
+        unlink(text);
+    }
+
+    addAutolink(block, start, start + end, "http://");
+    pos = start + end;
+    return true;
+}
+
+bool CommonMarkParser::parseUrlAutolink(Node* block)
+{
+    static const char* schemes[] = { "http", "https", "ftp", NULL };
+
+    Node* text = trailingText(block, 3);
+
+    if ((NULL == text) || ((pos + 3) > subjectLength)
+        || (0 != memcmp(subject + pos, "://", 3)))
+    {
+        return false;
+    }
+
+    int rewind = 0;
+
+    while ((rewind < text->literalLength)
+        && isAsciiAlpha(subject[pos - rewind - 1]))
+    {
+        rewind++;
+    }
+
+    bool validScheme = false;
+
+    for (int i = 0; NULL != schemes[i]; i++)
+    {
+        if (((int) strlen(schemes[i]) == rewind)
+            && startsWithNoCase(subject + pos - rewind, rewind, schemes[i]))
+        {
+            validScheme = true;
+            break;
+        }
+    }
+
+    if (!validScheme)
+    {
+        return false;
+    }
+
+    int start = pos - rewind;
+    const char* s = subject + start;
+    int length = subjectLength - start;
+    int domainStart = rewind + 3;
+    int domainLength = scanDomain(s + domainStart, length - domainStart, true);
+
+    if (0 == domainLength)
+    {
+        return false;
+    }
+
+    int end = trimAutolinkEnd(s, scanLinkPath(s, length, domainStart + domainLength));
+
+    if (end <= domainStart)
+    {
+        return false;
+    }
+
+    text->literalLength -= rewind;
+
+    if (0 == text->literalLength)
+    {
+        unlink(text);
+    }
+
+    addAutolink(block, start, start + end, NULL);
+    pos = start + end;
+    return true;
+}
+
+bool CommonMarkParser::parseEmailAutolink(Node* block)
+{
+    Node* text = trailingText(block, 1);
+
+    if (NULL == text)
+    {
+        return false;
+    }
+
+    int rewind = 0;
+
+    while (rewind < text->literalLength)
+    {
+        char c = subject[pos - rewind - 1];
+
+        if (!isAsciiAlnum(c) && (NULL == strchr(".+-_", c)))
+        {
+            break;
+        }
+
+        rewind++;
+    }
+
+    if (0 == rewind)
+    {
+        return false;
+    }
+
+    // The scan stops at a second '@', since the address would be rejected
+    // anyway.  Every character is then scanned at most once forwards and
+    // once backwards, rather than once per '@' before it in "a@a@a@...".
+    //
+    const char* s = subject + pos;
+    int length = subjectLength - pos;
+    int end = 0;
+    int ats = 0;
+    int periods = 0;
+
+    for (; end < length; end++)
+    {
+        char c = s[end];
+
+        if (isAsciiAlnum(c))
+        {
+            continue;
+        }
+
+        if ('@' == c)
+        {
+            ats++;
+
+            if (ats > 1)
+            {
+                break;
+            }
+        }
+        else if (('.' == c) && (end < (length - 1)) && isAsciiAlnum(s[end + 1]))
+        {
+            periods++;
+        }
+        else if (('-' != c) && ('_' != c))
+        {
+            break;
+        }
+    }
+
+    if ((end < 2) || (1 != ats) || (0 == periods)
+        || (!isAsciiAlpha(s[end - 1]) && ('.' != s[end - 1])))
+    {
+        return false;
+    }
+
+    end = trimAutolinkEnd(s, end);
+
+    if (end < 2)
+    {
+        return false;
+    }
+
+    int start = pos - rewind;
+
+    text->literalLength -= rewind;
+
+    if (0 == text->literalLength)
+    {
+        unlink(text);
+    }
+
+    addAutolink(block, start, pos + end, "mailto:");
+    pos += end;
+    return true;
+}
+
+void CommonMarkParser::addAutolink
+(
+    Node* block,
+    int start,
+    int end,
+    const char* prefix
+)
+{
+    Node* link = newNode(LinkNode);
+    int length = end - start;
+
+    if (NULL != prefix)
+    {
+        int prefixLength = strlen(prefix);
+        char* url = arena->allocateString(prefixLength + length);
+        memcpy(url, prefix, prefixLength);
+        memcpy(url + prefixLength, subject + start, length);
+        link->url = url;
+        link->urlLength = prefixLength + length;
+    }
+    else
+    {
+        link->url = subject + start;
+        link->urlLength = length;
+    }
+
+    Node* text = newNode(TextNode);
+    text->literal = subject + start;
+    text->literalLength = length;
+    appendChild(link, text);
+    appendChild(block, link);
+}
+
+int CommonMarkParser::parseLinkLabel()
+{
+    if ((pos >= subjectLength) || ('[' != subject[pos]))
+    {
+        return 0;
+    }
+
+    int i = pos + 1;
+    int count = 0;
+
+    while (i < subjectLength)
+    {
+        char c = subject[i];
+
+        if (('\\' == c) && ((i + 1) < subjectLength))
+        {
+            i += 2;
+            count += 2;
+        }
+        else if ('[' == c)
+        {
+            return 0;
+        }
+        else if (']' == c)
+        {
+            break;
+        }
+        else
+        {
+            i++;
+            count++;
+        }
+
+        if (count > GW_MAX_LINK_LABEL_LENGTH)
+        {
+            return 0;
+        }
+    }
+
+    if (i >= subjectLength)
+    {
+        return 0;
+    }
+
+    int length = (i + 1) - pos;
+    pos = i + 1;
+    return length;
+}
+
+bool CommonMarkParser::parseLinkDestination(const char** dest, int* destLength)
+{
+    if ((pos < subjectLength) && ('<' == subject[pos]))
+    {
+        int i = pos + 1;
+
+        while (i < subjectLength)
+        {
+            char c = subject[i];
+
+            if (('\\' == c) && ((i + 1) < subjectLength) && ('\n' != subject[i + 1]))
+            {
+                i += 2;
+            }
+            else if ('>' == c)
+            {
+                *dest = subject + pos + 1;
+                *destLength = i - pos - 1;
+                pos = i + 1;
+                return true;
+            }
+            else if (('<' == c) || ('\n' == c))
+            {
+                return false;
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        return false;
+    }
+
+    int start = pos;
+    int parens = 0;
+    int i = pos;
+
+    while (i < subjectLength)
+    {
+        unsigned char c = subject[i];
+
+        if (('\\' == c) && ((i + 1) < subjectLength)
+            && isAsciiPunctuation(subject[i + 1]))
+        {
+            i += 2;
+        }
+        else if ('(' == c)
+        {
+            parens++;
+
+            if (parens > GW_MAX_LINK_PAREN_DEPTH)
+            {
+                return false;
+            }
+
+            i++;
+        }
+        else if (')' == c)
+        {
+            if (parens < 1)
+            {
+                break;
+            }
+
+            parens--;
+            i++;
+        }
+        else if ((c <= 0x20) || (0x7F == c))
+        {
+            break;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    if (((i == start) && ((i >= subjectLength) || (')' != subject[i])))
+        || (0 != parens))
+    {
+        return false;
+    }
+
+    *dest = subject + start;
+    *destLength = i - start;
+    pos = i;
+    return true;
+}
+
+bool CommonMarkParser::parseLinkTitle(const char** title, int* titleLength)
+{
+    if (pos >= subjectLength)
+    {
+        return false;
+    }
+
+    char open = subject[pos];
+    char close;
+
+    if (('"' == open) || ('\'' == open))
+    {
+        close = open;
+    }
+    else if ('(' == open)
+    {
+        close = ')';
+    }
+    else
+    {
+        return false;
+    }
+
+    int i = pos + 1;
+
+    while (i < subjectLength)
+    {
+        char c = subject[i];
+
+        if (('\\' == c) && ((i + 1) < subjectLength))
+        {
+            i += 2;
+        }
+        else if (close == c)
+        {
+            *title = subject + pos + 1;
+            *titleLength = i - pos - 1;
+            pos = i + 1;
+            return true;
+        }
+        else if (('(' == open) && ('(' == c))
+        {
+            return false;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return false;
+}
+
+void CommonMarkParser::skipSpacesAndNewline()
+{
+    while ((pos < subjectLength) && isSpaceOrTab(subject[pos]))
+    {
+        pos++;
+    }
+
+    if ((pos < subjectLength) && ('\n' == subject[pos]))
+    {
+        pos++;
+
+        while ((pos < subjectLength) && isSpaceOrTab(subject[pos]))
+        {
+            pos++;
+        }
+    }
+}
+
+bool CommonMarkParser::skipSpacesToLineEnd()
+{
+    int i = pos;
+
+    while ((i < subjectLength) && isSpaceOrTab(subject[i]))
+    {
+        i++;
+    }
+
+    if (i >= subjectLength)
+    {
+        pos = i;
+        return true;
+    }
+
+    if ('\n' == subject[i])
+    {
+        pos = i + 1;
+        return true;
+    }
+
+    return false;
+}
+
+int CommonMarkParser::parseReference(const char* text, int length)
+{
+    subject = text;
+    subjectLength = length;
+    pos = 0;
+
+    int labelLength = parseLinkLabel();
+
+    if (0 == labelLength)
+    {
+        return 0;
+    }
+
+    if ((pos >= subjectLength) || (':' != subject[pos]))
+    {
+        return 0;
+    }
+
+    pos++;
+    skipSpacesAndNewline();
+
+    const char* dest = NULL;
+    int destLength = 0;
+
+    if (!parseLinkDestination(&dest, &destLength))
+    {
+        return 0;
+    }
+
+    int beforeTitle = pos;
+    const char* title = NULL;
+    int titleLength = 0;
+
+    skipSpacesAndNewline();
+
+    if ((pos == beforeTitle) || !parseLinkTitle(&title, &titleLength))
+    {
+        title = NULL;
+        pos = beforeTitle;
+    }
+
+    // The definition must end at a line ending.  If a title was found but is
+    // followed by something else, the definition may still be valid without
+    // the title.
+    //
+    if (!skipSpacesToLineEnd())
+    {
+        if (NULL == title)
+        {
+            return 0;
+        }
+
+        title = NULL;
+        pos = beforeTitle;
+
+        if (!skipSpacesToLineEnd())
+        {
+            return 0;
+        }
+    }
+
+    std::string key = normalizeLabel(text + 1, labelLength - 2);
+
+    if (key.empty())
+    {
+        return 0;
+    }
+
+    if (references.find(key) == references.end())
+    {
+        LinkReference ref;
+        ref.url = unescapeString(dest, destLength, &ref.urlLength);
+        ref.title = NULL;
+        ref.titleLength = 0;
+
+        if (NULL != title)
+        {
+            ref.title = unescapeString(title, titleLength, &ref.titleLength);
+        }
+
+        references[key] = ref;
+    }
+
+    return pos;
+}
+
+bool CommonMarkParser::lookupReference
+(
+    const char* label,
+    int length,
+    LinkReference& ref
+) const
+{
+    if ((length < 2) || ((length - 2) > GW_MAX_LINK_LABEL_LENGTH))
+    {
+        return false;
+    }
+
+    std::map<std::string, LinkReference>::const_iterator it =
+        references.find(normalizeLabel(label + 1, length - 2));
+
+    if (it == references.end())
+    {
+        return false;
+    }
+
+    ref = it->second;
+    return true;
+}
+
+std::string CommonMarkParser::normalizeLabel(const char* label, int length) const
+{
+    std::string key;
+    bool pendingSpace = false;
+    int i = 0;
+
+    key.reserve(length);
+
+    while (i < length)
+    {
+        if (isLineWhitespace(label[i]))
+        {
+            pendingSpace = !key.empty();
+            i++;
+            continue;
+        }
+
+        if (pendingSpace)
+        {
+            key += ' ';
+            pendingSpace = false;
+        }
+
+        int charLength;
+        unsigned int c = decodeUtf8(label + i, length - i, &charLength);
+        char encoded[4];
+        int encodedLength = encodeUtf8(foldCase(c), encoded);
+
+        key.append(encoded, encodedLength);
+        i += charLength;
+    }
+
+    return key;
+}
+
+const char* CommonMarkParser::unescapeString
+(
+    const char* text,
+    int length,
+    int* outLength
+)
+{
+    bool needsUnescaping = false;
+
+    for (int i = 0; i < length; i++)
+    {
+        if (('\\' == text[i]) || ('&' == text[i]))
+        {
+            needsUnescaping = true;
+            break;
+        }
+    }
+
+    if (!needsUnescaping)
+    {
+        *outLength = length;
+        return text;
+    }
+
+    // Unescaping makes the text longer only for the few named references
+    // that are one byte shorter than their UTF-8 encoding, the shortest of
+    // which ("&nGt;") is five bytes long.
+    //
+    char* unescaped = arena->allocateString(length + (length / 5));
+    int j = 0;
+
+    for (int i = 0; i < length;)
+    {
+        if (('\\' == text[i]) && ((i + 1) < length)
+            && isAsciiPunctuation(text[i + 1]))
+        {
+            unescaped[j++] = text[i + 1];
+            i += 2;
+        }
+        else if ('&' == text[i])
+        {
+            int decodedLength = 0;
+            char decoded[8];
+            int entityLength = decodeEntity(text + i, length - i, decoded, &decodedLength);
+
+            if (entityLength > 0)
+            {
+                memcpy(unescaped + j, decoded, decodedLength);
+                j += decodedLength;
+                i += entityLength;
+            }
+            else
+            {
+                unescaped[j++] = text[i++];
+            }
+        }
+        else
+        {
+            unescaped[j++] = text[i++];
+        }
+    }
+
+    *outLength = j;
+    return unescaped;
+}
+
+void CommonMarkParser::removeDelimiter(Delimiter* delim)
+{
+    if (NULL != delim->previous)
+    {
+        delim->previous->next = delim->next;
+    }
+
+    if (NULL != delim->next)
+    {
+        delim->next->previous = delim->previous;
+    }
+    else
+    {
+        // The top of the stack.
+        delimiters = delim->previous;
+    }
+}
+
+void CommonMarkParser::processEmphasis(Delimiter* stackBottom)
+{
+    // Lower bounds for opener searches, by delimiter character, whether the
+    // closer can also open, and the closer's length modulo 3.
+    //
+    Delimiter* openersBottom[18];
+
+    for (int i = 0; i < 18; i++)
+    {
+        openersBottom[i] = stackBottom;
+    }
+
+    // Find the first closer above the stack bottom.
+    Delimiter* closer = delimiters;
+
+    while ((NULL != closer) && (closer->previous != stackBottom))
+    {
+        closer = closer->previous;
+    }
+
+    while (NULL != closer)
+    {
+        if (!closer->canClose)
+        {
+            closer = closer->next;
+            continue;
+        }
+
+        int index = (('*' == closer->c) ? 0 : (('_' == closer->c) ? 6 : 12))
+            + (closer->canOpen ? 3 : 0) + (closer->origDelims % 3);
+
+        // Look back for the first matching opener.
+        Delimiter* opener = closer->previous;
+        bool openerFound = false;
+
+        while ((NULL != opener) && (opener != stackBottom)
+            && (opener != openersBottom[index]))
+        {
+            if ((opener->c == closer->c) && opener->canOpen)
+            {
+                if ('~' == closer->c)
+                {
+                    if (opener->numDelims == closer->numDelims)
+                    {
+                        openerFound = true;
+                        break;
+                    }
+                }
+                else
+                {
+                    bool oddMatch = (closer->canOpen || opener->canClose)
+                        && ((closer->origDelims % 3) != 0)
+                        && (((opener->origDelims + closer->origDelims) % 3) == 0);
+
+                    if (!oddMatch)
+                    {
+                        openerFound = true;
+                        break;
+                    }
+                }
+            }
+
+            opener = opener->previous;
+        }
+
+        Delimiter* oldCloser = closer;
+
+        if (openerFound)
+        {
+            int used;
+            int type;
+
+            if ('~' == closer->c)
+            {
+                used = closer->numDelims;
+                type = StrikethroughNode;
+            }
+            else
+            {
+                used = ((closer->numDelims >= 2) && (opener->numDelims >= 2)) ? 2 : 1;
+                type = (1 == used) ? EmphasisNode : StrongNode;
+            }
+
+            Node* openerNode = opener->node;
+            Node* closerNode = closer->node;
+
+            opener->numDelims -= used;
+            closer->numDelims -= used;
+            openerNode->literalLength -= used;
+            closerNode->literalLength -= used;
+
+            Node* emphasis = newNode(type);
+            Node* child = openerNode->next;
+
+            while ((NULL != child) && (child != closerNode))
+            {
+                Node* next = child->next;
+                unlink(child);
+                appendChild(emphasis, child);
+                child = next;
+            }
+
+            insertAfter(openerNode, emphasis);
+
+            // Remove the delimiters between the opener and closer.
+            if (opener->next != closer)
+            {
+                opener->next = closer;
+                closer->previous = opener;
+            }
+
+            if (0 == opener->numDelims)
+            {
+                unlink(openerNode);
+                removeDelimiter(opener);
+            }
+
+            if (0 == closer->numDelims)
+            {
+                unlink(closerNode);
+                Delimiter* next = closer->next;
+                removeDelimiter(closer);
+                closer = next;
+            }
+        }
+        else
+        {
+            closer = closer->next;
+
+            // Set the lower bound for future searches for openers.
+            openersBottom[index] = oldCloser->previous;
+
+            // A closer that can't open can be removed, once it's known that
+            // there is no matching opener.
+            //
+            if (!oldCloser->canOpen)
+            {
+                removeDelimiter(oldCloser);
+            }
+        }
+    }
+
+    while ((NULL != delimiters) && (delimiters != stackBottom))
+    {
+        removeDelimiter(delimiters);
+    }
+}
+
+static bool isContainerNode(int type)
+{
+    switch (type)
+    {
+        case DocumentNode:
+        case BlockQuoteNode:
+        case ListNode:
+        case ItemNode:
+        case ParagraphNode:
+        case HeadingNode:
+        case TableNode:
+        case TableRowNode:
+        case TableCellNode:
+        case EmphasisNode:
+        case StrongNode:
+        case StrikethroughNode:
+        case LinkNode:
+        case ImageNode:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void cr(struct buf* ob)
+{
+    if ((ob->size > 0) && ('\n' != ob->data[ob->size - 1]))
+    {
+        bufputc(ob, '\n');
+    }
+}
+
+void CommonMarkParser::escapeHtml(struct buf* ob, const char* text, int length) const
+{
+    const char* p = text;
+    const char* end = text + length;
+
+    while (p < end)
+    {
+        const char* special = escapeScanner->find(p, end);
+
+        if (special > p)
+        {
+            bufput(ob, p, special - p);
+        }
+
+        if (special >= end)
+        {
+            break;
+        }
+
+        switch (*special)
+        {
+            case '&':
+                BUFPUTSL(ob, "&amp;");
+                break;
+            case '<':
+                BUFPUTSL(ob, "&lt;");
+                break;
+            case '>':
+                BUFPUTSL(ob, "&gt;");
+                break;
+            case '"':
+                BUFPUTSL(ob, "&quot;");
+                break;
+        }
+
+        p = special + 1;
+    }
+}
+
+void CommonMarkParser::render(struct buf* ob)
+{
+    static const char* alignments[] = { "", " align=\"left\"", " align=\"center\"", " align=\"right\"" };
+
+    Node* node = document;
+    bool entering = true;
+    int disableTags = 0;
+
+    // Walk the tree iteratively, visiting container nodes both on the way in
+    // and on the way out.
+    //
+    while (NULL != node)
+    {
+        switch (node->type)
+        {
+            case BlockQuoteNode:
+                cr(ob);
+                bufputs(ob, entering ? "<blockquote>" : "</blockquote>");
+                cr(ob);
+                break;
+
+            case ListNode:
+                cr(ob);
+
+                if (entering)
+                {
+                    if (!node->ordered)
+                    {
+                        BUFPUTSL(ob, "<ul>");
+                    }
+                    else if (1 != node->start)
+                    {
+                        bufprintf(ob, "<ol start=\"%d\">", node->start);
+                    }
+                    else
+                    {
+                        BUFPUTSL(ob, "<ol>");
+                    }
+                }
+                else
+                {
+                    bufputs(ob, node->ordered ? "</ol>" : "</ul>");
+                }
+
+                cr(ob);
+                break;
+
+            case ItemNode:
+                if (entering)
+                {
+                    BUFPUTSL(ob, "<li>");
+                }
+                else
+                {
+                    BUFPUTSL(ob, "</li>");
+                    cr(ob);
+                }
+                break;
+
+            case ParagraphNode:
+            {
+                Node* grandparent = (NULL != node->parent) ? node->parent->parent : NULL;
+                bool tight = (NULL != grandparent) && (ListNode == grandparent->type)
+                    && grandparent->tight;
+
+                if (!tight)
+                {
+                    if (entering)
+                    {
+                        cr(ob);
+                        BUFPUTSL(ob, "<p>");
+                    }
+                    else
+                    {
+                        BUFPUTSL(ob, "</p>");
+                        cr(ob);
+                    }
+                }
+
+                if (entering && (ItemNode == node->parent->type)
+                    && (node->parent->first == node)
+                    && (NoTask != node->parent->taskState))
+                {
+                    bufputs(ob, (CheckedTask == node->parent->taskState)
+                        ? "<input type=\"checkbox\" checked=\"\" disabled=\"\" /> "
+                        : "<input type=\"checkbox\" disabled=\"\" /> ");
+                }
+                break;
+            }
+
+            case HeadingNode:
+                if (entering)
+                {
+                    cr(ob);
+                    bufprintf(ob, "<h%d>", node->level);
+                }
+                else
+                {
+                    bufprintf(ob, "</h%d>", node->level);
+                    cr(ob);
+                }
+                break;
+
+            case ThematicBreakNode:
+                cr(ob);
+                BUFPUTSL(ob, "<hr />");
+                cr(ob);
+                break;
+
+            case CodeBlockNode:
+            {
+                cr(ob);
+                BUFPUTSL(ob, "<pre><code");
+
+                // The first word of the info string is the language.
+                int languageLength = 0;
+
+                while ((languageLength < node->urlLength)
+                    && !isLineWhitespace(node->url[languageLength]))
+                {
+                    languageLength++;
+                }
+
+                if (languageLength > 0)
+                {
+                    BUFPUTSL(ob, " class=\"language-");
+                    escapeHtml(ob, node->url, languageLength);
+                    BUFPUTSL(ob, "\"");
+                }
+
+                BUFPUTSL(ob, ">");
+
+                for (Chunk* c = node->firstChunk; NULL != c; c = c->next)
+                {
+                    for (int i = 0; i < c->leadingSpaces; i++)
+                    {
+                        bufputc(ob, ' ');
+                    }
+
+                    escapeHtml(ob, c->data, c->length);
+                    bufputc(ob, '\n');
+                }
+
+                BUFPUTSL(ob, "</code></pre>");
+                cr(ob);
+                break;
+            }
+
+            case HtmlBlockNode:
+                cr(ob);
+
+                for (Chunk* c = node->firstChunk; NULL != c; c = c->next)
+                {
+                    for (int i = 0; i < c->leadingSpaces; i++)
+                    {
+                        bufputc(ob, ' ');
+                    }
+
+                    bufput(ob, c->data, c->length);
+
+                    if (NULL != c->next)
+                    {
+                        bufputc(ob, '\n');
+                    }
+                }
+
+                cr(ob);
+                break;
+
+            case TableNode:
+                cr(ob);
+
+                if (entering)
+                {
+                    BUFPUTSL(ob, "<table>\n");
+                }
+                else
+                {
+                    if (node->first != node->last)
+                    {
+                        BUFPUTSL(ob, "</tbody>\n");
+                    }
+
+                    BUFPUTSL(ob, "</table>\n");
+                }
+                break;
+
+            case TableRowNode:
+                if (entering)
+                {
+                    if (node->level)
+                    {
+                        BUFPUTSL(ob, "<thead>\n");
+                    }
+                    else if (node->prev == node->parent->first)
+                    {
+                        BUFPUTSL(ob, "<tbody>\n");
+                    }
+
+                    BUFPUTSL(ob, "<tr>\n");
+                }
+                else
+                {
+                    BUFPUTSL(ob, "</tr>\n");
+
+                    if (node->level)
+                    {
+                        BUFPUTSL(ob, "</thead>\n");
+                    }
+                }
+                break;
+
+            case TableCellNode:
+                if (entering)
+                {
+                    int column = 0;
+
+                    for (Node* n = node->prev; NULL != n; n = n->prev)
+                    {
+                        column++;
+                    }
+
+                    char alignment = node->parent->parent->alignments[column];
+                    int alignmentIndex = ('l' == alignment) ? 1
+                        : (('c' == alignment) ? 2 : (('r' == alignment) ? 3 : 0));
+
+                    bufprintf(ob, "<%s%s>", node->level ? "th" : "td",
+                        alignments[alignmentIndex]);
+                }
+                else
+                {
+                    bufprintf(ob, "</%s>\n", node->level ? "th" : "td");
+                }
+                break;
+
+            case TextNode:
+                escapeHtml(ob, node->literal, node->literalLength);
+                break;
+
+            case SoftBreakNode:
+                bufputc(ob, '\n');
+                break;
+
+            case LineBreakNode:
+                if (0 == disableTags)
+                {
+                    BUFPUTSL(ob, "<br />");
+                }
+
+                bufputc(ob, '\n');
+                break;
+
+            case CodeNode:
+                if (0 == disableTags)
+                {
+                    BUFPUTSL(ob, "<code>");
+                }
+
+                escapeHtml(ob, node->literal, node->literalLength);
+
+                if (0 == disableTags)
+                {
+                    BUFPUTSL(ob, "</code>");
+                }
+                break;
+
+            case HtmlInlineNode:
+                bufput(ob, node->literal, node->literalLength);
+                break;
+
+            case EmphasisNode:
+                if (0 == disableTags)
+                {
+                    bufputs(ob, entering ? "<em>" : "</em>");
+                }
+                break;
+
+            case StrongNode:
+                if (0 == disableTags)
+                {
+                    bufputs(ob, entering ? "<strong>" : "</strong>");
+                }
+                break;
+
+            case StrikethroughNode:
+                if (0 == disableTags)
+                {
+                    bufputs(ob, entering ? "<del>" : "</del>");
+                }
+                break;
+
+            case LinkNode:
+                if (0 == disableTags)
+                {
+                    if (entering)
+                    {
+                        BUFPUTSL(ob, "<a href=\"");
+                        houdini_escape_href(ob, (const uint8_t*) node->url, node->urlLength);
+
+                        if (node->titleLength > 0)
+                        {
+                            BUFPUTSL(ob, "\" title=\"");
+                            escapeHtml(ob, node->title, node->titleLength);
+                        }
+
+                        BUFPUTSL(ob, "\">");
+                    }
+                    else
+                    {
+                        BUFPUTSL(ob, "</a>");
+                    }
+                }
+                break;
+
+            case ImageNode:
+                if (entering)
+                {
+                    // The image's content becomes its plain text alt text.
+                    if (0 == disableTags)
+                    {
+                        BUFPUTSL(ob, "<img src=\"");
+                        houdini_escape_href(ob, (const uint8_t*) node->url, node->urlLength);
+                        BUFPUTSL(ob, "\" alt=\"");
+                    }
+
+                    disableTags++;
+                }
+                else
+                {
+                    disableTags--;
+
+                    if (0 == disableTags)
+                    {
+                        if (node->titleLength > 0)
+                        {
+                            BUFPUTSL(ob, "\" title=\"");
+                            escapeHtml(ob, node->title, node->titleLength);
+                        }
+
+                        BUFPUTSL(ob, "\" />");
+                    }
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Move to the next node.
+        if (entering && isContainerNode(node->type))
+        {
+            if (NULL != node->first)
+            {
+                node = node->first;
+            }
+            else
+            {
+                entering = false;
+            }
+        }
+        else if (node == document)
+        {
+            node = NULL;
+        }
+        else if (NULL != node->next)
+        {
+            node = node->next;
+            entering = true;
+        }
+        else
+        {
+            node = node->parent;
+            entering = false;
+        }
+    }
+}
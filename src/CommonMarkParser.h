@@ -0,0 +1,200 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef COMMONMARKPARSER_H
+#define COMMONMARKPARSER_H
+
+#include <stddef.h>
+#include <map>
+#include <string>
+
+struct buf;
+
+/**
+ * Parses CommonMark text, with optional GitHub-flavored Markdown extensions
+ * (tables, strikethrough, extended autolinks, and task lists), and renders
+ * it to HTML.
+ *
+ * The parser follows the two-phase strategy of the CommonMark reference
+ * implementations: the block structure is built one line at a time, after
+ * which the inline content of paragraphs, headings and table cells is
+ * parsed.  All nodes and intermediate strings are carved out of an arena
+ * that is freed in one go once rendering is done, and text nodes refer
+ * directly into the input wherever possible, so that parsing a document
+ * involves only a handful of heap allocations no matter how large it is.
+ *
+ * This class does not depend on Qt, and is not thread-safe.  Use a separate
+ * instance per thread.
+ */
+class CommonMarkParser
+{
+    public:
+        /**
+         * Optional syntax extensions, which can be OR'ed together.
+         */
+        enum Extension
+        {
+            NoExtensions = 0x0,
+            TablesExtension = 0x1,
+            StrikethroughExtension = 0x2,
+            AutolinkExtension = 0x4,
+            TaskListExtension = 0x8,
+            GitHubExtensions = 0xF
+        };
+
+        /**
+         * Constructor.  Takes the Extension flags to enable as a parameter.
+         */
+        CommonMarkParser(int extensions = GitHubExtensions);
+
+        /**
+         * Destructor.
+         */
+        ~CommonMarkParser();
+
+        /**
+         * Parses the given UTF-8 encoded Markdown text, appending the HTML
+         * output to the given Sundown output buffer.
+         */
+        void renderHtml(const char* text, size_t size, struct buf* ob);
+
+    private:
+        struct Node;
+        struct Chunk;
+        struct Delimiter;
+        struct Bracket;
+        class Arena;
+        class CharScanner;
+
+        struct LinkReference
+        {
+            const char* url;
+            int urlLength;
+            const char* title;
+            int titleLength;
+        };
+
+        int extensions;
+        Arena* arena;
+        CharScanner* inlineScanner;
+        CharScanner* escapeScanner;
+        std::map<std::string, LinkReference> references;
+
+        // Block parser state
+        Node* document;
+        Node* tip;
+        Node* oldTip;
+        Node* lastMatchedContainer;
+        const char* line;
+        int lineLength;
+        int lineNumber;
+        int offset;
+        int column;
+        int nextNonspace;
+        int nextNonspaceColumn;
+        int indent;
+        bool indented;
+        bool blank;
+        bool partiallyConsumedTab;
+        bool allClosed;
+        bool lineConsumed;
+
+        // Inline parser state
+        const char* subject;
+        int subjectLength;
+        int pos;
+        Delimiter* delimiters;
+        Bracket* brackets;
+        bool backticksScanned;
+        int backtickPositions[80];
+
+        // Disallow copying.
+        CommonMarkParser(const CommonMarkParser&);
+        CommonMarkParser& operator=(const CommonMarkParser&);
+
+        Node* newNode(int type);
+        void appendChild(Node* parent, Node* child);
+        void insertAfter(Node* node, Node* sibling);
+        void unlink(Node* node);
+
+        const char* normalizeInput(const char* text, size_t& size);
+        void incorporateLine(const char* text, int length);
+        int peek(int index) const;
+        void findNextNonspace();
+        void advanceNextNonspace();
+        void advanceOffset(int count, bool columns);
+        void addLine();
+        Node* addChild(int type);
+        void closeUnmatchedBlocks();
+        void finalize(Node* block);
+        int continueBlock(Node* container);
+        int startBlock(Node* container);
+        int startBlockQuote();
+        int startAtxHeading();
+        int startFencedCode();
+        int startHtmlBlock(Node* container);
+        int startSetextHeading(Node* container);
+        int startThematicBreak();
+        int startTable(Node* container);
+        int startListItem(Node* container);
+        int startIndentedCode();
+        void materializeContent(Node* block);
+        bool extractReferences(Node* block);
+        bool endsWithBlankLine(Node* block) const;
+
+        void processInlines();
+        void processTable(Node* table);
+        void processTaskListItem(Node* item);
+        void parseInlines(Node* block, const char* text, int length);
+        void parseInline(Node* block);
+        Node* appendText(Node* block, const char* text, int length, bool mergeable = true);
+        Node* trailingText(Node* block, int minLength);
+        bool parseString(Node* block);
+        bool parseNewline(Node* block);
+        bool parseBackslash(Node* block);
+        bool parseBackticks(Node* block);
+        bool parseDelimiters(char c, Node* block);
+        bool parseOpenBracket(Node* block);
+        bool parseBang(Node* block);
+        bool parseCloseBracket(Node* block);
+        bool parseAutolink(Node* block);
+        bool parseHtmlTag(Node* block);
+        bool parseEntity(Node* block);
+        bool parseExtendedAutolink(char c, Node* block);
+        bool parseWwwAutolink(Node* block);
+        bool parseUrlAutolink(Node* block);
+        bool parseEmailAutolink(Node* block);
+        void addAutolink(Node* block, int start, int end, const char* prefix);
+        int parseLinkLabel();
+        bool parseLinkDestination(const char** dest, int* destLength);
+        bool parseLinkTitle(const char** title, int* titleLength);
+        void skipSpacesAndNewline();
+        bool skipSpacesToLineEnd();
+        int parseReference(const char* text, int length);
+        bool lookupReference(const char* label, int length, LinkReference& ref) const;
+        std::string normalizeLabel(const char* label, int length) const;
+        const char* unescapeString(const char* text, int length, int* outLength);
+        void removeDelimiter(Delimiter* delim);
+        void processEmphasis(Delimiter* stackBottom);
+
+        void render(struct buf* ob);
+        void escapeHtml(struct buf* ob, const char* text, int length) const;
+};
+
+#endif // COMMONMARKPARSER_H
@@ -20,7 +20,6 @@
 #include <QString>
 #include <QStringList>
 #include <QList>
-#include <QFileInfo>
 #include <QSettings>
 
 #include "DocumentHistory.h"
@@ -59,15 +58,12 @@ void DocumentHistory::add
     int cursorPosition
 )
 {
-    QFileInfo fileInfo(filePath);
-
-    if (fileInfo.exists())
+    if (!filePath.isNull() && !filePath.isEmpty())
     {
-        QString sanitizedPath = fileInfo.canonicalFilePath();
         RecentFilesList recentFiles = loadFromSettings();
         RecentFile lastFile;
 
-        lastFile.filePath = sanitizedPath;
+        lastFile.filePath = filePath;
         lastFile.position = cursorPosition;
         recentFiles.removeAll(lastFile);
         recentFiles.prepend(lastFile);
@@ -78,7 +74,6 @@ void DocumentHistory::add
 
 int DocumentHistory::getCursorPosition(const QString& filePath)
 {
-    QString sanitizedPath = QFileInfo(filePath).canonicalFilePath();
     int position = 0;
 
     RecentFilesList recentFiles = loadFromSettings();
@@ -86,7 +81,7 @@ int DocumentHistory::getCursorPosition(const QString& filePath)
 
     foreach (RecentFile file, recentFiles)
     {
-        if (sanitizedPath == file.filePath)
+        if (filePath == file.filePath)
         {
             position = file.position;
             break;
@@ -128,7 +123,7 @@ DocumentHistory::RecentFilesList DocumentHistory::loadFromSettings(int max)
         QString filePath = settings.value(FILE_PATH_KEY).toString();
         int position = settings.value(CURSOR_POSITION_KEY, 0).toInt();
 
-        if (!filePath.isNull() && !filePath.isEmpty() && QFileInfo(filePath).exists())
+        if (!filePath.isNull() && !filePath.isEmpty())
         {
             RecentFile recentFile;
             recentFile.filePath = filePath;
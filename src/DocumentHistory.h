@@ -29,6 +29,12 @@
  * This class stores and retrieves recent file history using QSettings.
  * It is reentrant, and different instances can be used from anywhere to
  * access the same file history.
+ *
+ * Note that this class never accesses the files in the history, since the
+ * file system might be slow to respond.  File paths are stored exactly as
+ * given, so callers should pass in canonical file paths.  Likewise, the
+ * recent files returned might no longer exist.  Use AsyncFileAccess to
+ * look up canonical file paths and filter out files that no longer exist.
  */
 class DocumentHistory
 {
@@ -50,14 +56,15 @@ class DocumentHistory
         QStringList getRecentFiles(int max = -1);
 
         /**
-         * Adds the given file path and cursor position to the history.
+         * Adds the given canonical file path and cursor position to the
+         * history.
          */
         void add(const QString& filePath, int cursorPosition);
 
         /**
-         * Gets the last-known cursor position for the given file path.  This
-         * will return 0 (beginning of the file) if the last cursor position
-         * is unknown.
+         * Gets the last-known cursor position for the given canonical file
+         * path.  This will return 0 (beginning of the file) if the last
+         * cursor position is unknown.
          */
         int getCursorPosition(const QString& filePath);
 
@@ -19,7 +19,6 @@
 
 #include <QTextDocument>
 #include <QPair>
-#include <QtConcurrentRun>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QFileSystemWatcher>
@@ -46,6 +45,7 @@
 #include "ExportDialog.h"
 #include "MessageBoxHelper.h"
 #include "ThemeFactory.h"
+#include "TaskScheduler.h"
 
 const QString DocumentManager::FILE_CHOOSER_FILTER =
     QString("%1 (*.md *.markdown *.txt);;%2 (*.txt);;%3 (*)")
@@ -66,6 +66,8 @@ DocumentManager::DocumentManager
         saveInProgress(false)
 {
     saveFutureWatcher = new QFutureWatcher<QString>(this);
+    fileAccess = new AsyncFileAccess(parent, this);
+    connect(fileAccess, SIGNAL(existingFilesFound(QStringList)), this, SLOT(onRecentFilesFound(QStringList)));
 
     fileWatcher = new QFileSystemWatcher(this);
     document = (TextDocument*) editor->document();
@@ -152,7 +154,8 @@ void DocumentManager::open(const QString& filePath)
 
             if (!document->isNew())
             {
-                startingDirectory = QFileInfo(document->getFilePath()).dir().path();
+                startingDirectory =
+                    fileAccess->startingDirectory(document->getFilePath());
             }
 
             path =
@@ -167,21 +170,11 @@ void DocumentManager::open(const QString& filePath)
 
         if (!path.isNull() && !path.isEmpty())
         {
-            QFileInfo fileInfo(path);
-
-            if (!fileInfo.isReadable())
-            {
-                MessageBoxHelper::critical
-                (
-                    parentWidget,
-                    tr("Could not open %1").arg(path),
-                    tr("Permission denied.")
-                );
-
-                return;
-            }
-
+            // Note that loadFile() reports an error if the file can't be
+            // read, before making any changes to the current document.
+            //
             QString oldFilePath = document->getFilePath();
+            QString oldCanonicalFilePath = canonicalFilePath;
             int oldCursorPosition = editor->textCursor().position();
             bool oldFileWasNew = document->isNew();
 
@@ -203,7 +196,7 @@ void DocumentManager::open(const QString& filePath)
                     DocumentHistory history;
                     history.add
                     (
-                        oldFilePath,
+                        oldCanonicalFilePath,
                         oldCursorPosition
                     );
                 }
@@ -222,21 +215,13 @@ void DocumentManager::open(const QString& filePath)
 
 void DocumentManager::reopenLastClosedFile()
 {
+    // The file is reopened once the lookup of which recent files still
+    // exist finishes.  See onRecentFilesFound().
+    //
     if (fileHistoryEnabled)
     {
         DocumentHistory history;
-        QStringList recentFiles = history.getRecentFiles(2);
-
-        if (!document->isNew())
-        {
-            recentFiles.removeAll(document->getFilePath());
-        }
-
-        if (!recentFiles.isEmpty())
-        {
-            open(recentFiles.first());
-            emit documentClosed();
-        }
+        fileAccess->findExistingFiles(history.getRecentFiles());
     }
 }
 
@@ -293,16 +278,22 @@ void DocumentManager::rename()
 
         if (!filePath.isNull() && !filePath.isEmpty())
         {
-            QFile file(document->getFilePath());
-            bool success = file.rename(filePath);
+            QString err;
 
-            if (!success)
+            AsyncFileAccess::Result result =
+                fileAccess->renameFile(document->getFilePath(), filePath, err);
+
+            if (AsyncFileAccess::Cancelled == result)
+            {
+                return;
+            }
+            else if (AsyncFileAccess::Succeeded != result)
             {
                 MessageBoxHelper::critical
                 (
                     parentWidget,
                     tr("Failed to rename %1").arg(document->getFilePath()),
-                    file.errorString()
+                    err
                 );
                 return;
             }
@@ -321,18 +312,14 @@ bool DocumentManager::save()
     }
     else
     {
-        document->setModified(false);
-        emit documentModifiedChanged(false);
-
-        if
-        (
-            this->saveFutureWatcher->isRunning() ||
-            this->saveFutureWatcher->isStarted()
-        )
+        if (!waitForSave())
         {
-            this->saveFutureWatcher->waitForFinished();
+            return false;
         }
 
+        document->setModified(false);
+        emit documentModifiedChanged(false);
+
         saveInProgress = true;
 
         if (fileWatcher->files().contains(document->getFilePath()))
@@ -343,8 +330,9 @@ bool DocumentManager::save()
         document->setTimestamp(QDateTime::currentDateTime());
 
         QFuture<QString> future =
-            QtConcurrent::run
+            TaskScheduler::getInstance()->run
             (
+                TaskOptions(TaskPriorityNormal),
                 this,
                 &DocumentManager::saveToDisk,
                 document->getFilePath(),
@@ -365,7 +353,8 @@ bool DocumentManager::saveAs()
 
     if (!document->isNew())
     {
-        startingDirectory = QFileInfo(document->getFilePath()).dir().path();
+        startingDirectory =
+            fileAccess->startingDirectory(document->getFilePath());
     }
 
     QString filePath =
@@ -390,15 +379,15 @@ bool DocumentManager::close()
 {
     if (checkSaveChanges())
     {
-        if (saveFutureWatcher->isRunning() || saveFutureWatcher->isStarted())
+        if (!waitForSave())
         {
-            this->saveFutureWatcher->waitForFinished();
+            return false;
         }
 
         // Get the document's information before closing it out
         // so we can store history information about it.
         //
-        QString filePath = document->getFilePath();
+        QString filePath = canonicalFilePath;
         int cursorPosition = editor->textCursor().position();
         bool documentIsNew = document->isNew();
 
@@ -471,7 +460,17 @@ void DocumentManager::onDocumentModifiedChanged(bool modified)
 
 void DocumentManager::onSaveCompleted()
 {
-    QString err = this->saveFutureWatcher->result();
+    QString err;
+
+    // Saves are only ever cancelled when the application is shutting down.
+    if (this->saveFutureWatcher->isCanceled())
+    {
+        err = tr("The save was cancelled.");
+    }
+    else
+    {
+        err = this->saveFutureWatcher->result();
+    }
 
     if (!err.isNull() && !err.isEmpty())
     {
@@ -490,11 +489,40 @@ void DocumentManager::onSaveCompleted()
     saveInProgress = false;
 }
 
+void DocumentManager::onRecentFilesFound(const QStringList& existingPaths)
+{
+    QStringList recentFiles = existingPaths;
+
+    if (!document->isNew())
+    {
+        recentFiles.removeAll(canonicalFilePath);
+    }
+
+    if (!recentFiles.isEmpty())
+    {
+        open(recentFiles.first());
+        emit documentClosed();
+    }
+}
+
 void DocumentManager::onFileChangedExternally(const QString& path)
 {
-    QFileInfo fileInfo(path);
+    // Don't interrupt a pending file operation, which is most likely the
+    // cause of the change anyway.
+    //
+    if (fileAccess->isBusy())
+    {
+        return;
+    }
+
+    FileStatus fileInfo;
+
+    if (AsyncFileAccess::Succeeded != fileAccess->stat(path, fileInfo))
+    {
+        return;
+    }
 
-    if (!fileInfo.exists())
+    if (!fileInfo.exists)
     {
         emit documentModifiedChanged(true);
 
@@ -505,7 +533,7 @@ void DocumentManager::onFileChangedExternally(const QString& path)
     }
     else
     {
-        if (fileInfo.isWritable() && document->isReadOnly())
+        if (fileInfo.writable && document->isReadOnly())
         {
             document->setReadOnly(false);
 
@@ -514,7 +542,7 @@ void DocumentManager::onFileChangedExternally(const QString& path)
                 emit documentModifiedChanged(false);
             }
         }
-        else if (!fileInfo.isWritable() && !document->isReadOnly())
+        else if (!fileInfo.writable && !document->isReadOnly())
         {
             document->setReadOnly(true);
 
@@ -531,7 +559,7 @@ void DocumentManager::onFileChangedExternally(const QString& path)
         if
         (
             !saveInProgress &&
-            (fileInfo.lastModified() > document->getTimestamp())
+            (fileInfo.lastModified > document->getTimestamp())
         )
         {
             int response =
@@ -577,6 +605,7 @@ void DocumentManager::autoSaveFile()
     if
     (
         autoSaveEnabled &&
+        !fileAccess->isBusy() &&
         !document->isNew() &&
         !document->isReadOnly() &&
         document->isModified()
@@ -588,16 +617,27 @@ void DocumentManager::autoSaveFile()
 
 bool DocumentManager::loadFile(const QString& filePath)
 {
-    QFileInfo fileInfo(filePath);
-    QFile inputFile(filePath);
+    QByteArray contents;
+    FileStatus fileInfo;
+    QString err;
+
+    // Read the whole file up front on a worker thread, so that a slow
+    // file system can't freeze the editor part way through loading it.
+    //
+    AsyncFileAccess::Result result =
+        fileAccess->readFile(filePath, contents, fileInfo, err);
 
-    if (!inputFile.open(QIODevice::ReadOnly))
+    if (AsyncFileAccess::Cancelled == result)
+    {
+        return false;
+    }
+    else if (AsyncFileAccess::Succeeded != result)
     {
         MessageBoxHelper::critical
         (
             parentWidget,
             tr("Could not read %1").arg(filePath),
-            inputFile.errorString()
+            err
         );
         return false;
     }
@@ -612,7 +652,7 @@ bool DocumentManager::loadFile(const QString& filePath)
 
     QApplication::setOverrideCursor(Qt::WaitCursor);
     emit operationStarted(tr("opening %1").arg(filePath));
-    QTextStream inStream(&inputFile);
+    QTextStream inStream(contents, QIODevice::ReadOnly);
 
     // Markdown files need to be in UTF-8 format, so assume that is
     // what the user is opening by default.  Enable autodection
@@ -648,35 +688,23 @@ bool DocumentManager::loadFile(const QString& filePath)
 
     document->setUndoRedoEnabled(true);
 
-    if (QFile::NoError != inputFile.error())
-    {
-        MessageBoxHelper::critical
-        (
-            parentWidget,
-            tr("Could not read %1").arg(filePath),
-            inputFile.errorString()
-        );
-
-        inputFile.close();
-        return false;
-    }
-
-    inputFile.close();
-
     if (fileHistoryEnabled)
     {
         DocumentHistory history;
-        editor->navigateDocument(history.getCursorPosition(filePath));
+        editor->navigateDocument
+        (
+            history.getCursorPosition(fileInfo.canonicalFilePath)
+        );
     }
     else
     {
         editor->navigateDocument(0);
     }
 
-    setFilePath(filePath);
+    setFilePath(filePath, fileInfo);
     editor->setReadOnly(false);
 
-    if (!fileInfo.isWritable())
+    if (!fileInfo.writable)
     {
         document->setReadOnly(true);
     }
@@ -686,7 +714,7 @@ bool DocumentManager::loadFile(const QString& filePath)
     }
 
     document->setModified(false);
-    document->setTimestamp(fileInfo.lastModified());
+    document->setTimestamp(fileInfo.lastModified);
 
     QString watchedFile;
 
@@ -707,6 +735,21 @@ bool DocumentManager::loadFile(const QString& filePath)
 }
 
 void DocumentManager::setFilePath(const QString& filePath)
+{
+    FileStatus status;
+
+    // If the file system doesn't respond, assume the file doesn't exist
+    // yet.  Saving it will report any problems with the file.
+    //
+    if (!filePath.isNull() && !filePath.isEmpty())
+    {
+        fileAccess->stat(filePath, status);
+    }
+
+    setFilePath(filePath, status);
+}
+
+void DocumentManager::setFilePath(const QString& filePath, const FileStatus& status)
 {
     if (!document->isNew())
     {
@@ -715,25 +758,24 @@ void DocumentManager::setFilePath(const QString& filePath)
 
     document->setFilePath(filePath);
 
-    if (!filePath.isNull() && !filePath.isEmpty())
+    if (filePath.isNull() || filePath.isEmpty())
     {
-        QFileInfo fileInfo(filePath);
-
-        if (fileInfo.exists())
-        {
-            document->setReadOnly(!fileInfo.isWritable());
-        }
-        else
-        {
-            document->setReadOnly(false);
-        }
+        canonicalFilePath = QString();
+        document->setReadOnly(false);
+    }
+    else if (status.exists)
+    {
+        canonicalFilePath = status.canonicalFilePath;
+        document->setReadOnly(!status.writable);
     }
     else
     {
+        canonicalFilePath = QFileInfo(filePath).absoluteFilePath();
         document->setReadOnly(false);
     }
 
     emit documentDisplayNameChanged(document->getDisplayName());
+    emit filePathChanged(document->getFilePath());
 }
 
 bool DocumentManager::checkSaveChanges()
@@ -812,17 +854,18 @@ bool DocumentManager::checkPermissionsBeforeSave()
         }
         else
         {
-            QFile file(document->getFilePath());
             fileWatcher->removePath(document->getFilePath());
 
-            if (!file.remove())
+            AsyncFileAccess::Result result =
+                fileAccess->removeFile(document->getFilePath(), true);
+
+            if (AsyncFileAccess::Succeeded == result)
             {
-                if (file.setPermissions(QFile::WriteUser | QFile::ReadUser) && file.remove())
-                {
-                    document->setReadOnly(false);
-                    return true;
-                }
-                else
+                document->setReadOnly(false);
+            }
+            else
+            {
+                if (AsyncFileAccess::Cancelled != result)
                 {
                     MessageBoxHelper::critical
                     (
@@ -830,14 +873,10 @@ bool DocumentManager::checkPermissionsBeforeSave()
                         tr("Overwrite failed."),
                         tr("Please save file to another location.")
                     );
-
-                    fileWatcher->addPath(document->getFilePath());
-                    return false;
                 }
-            }
-            else
-            {
-                document->setReadOnly(false);
+
+                fileWatcher->addPath(document->getFilePath());
+                return false;
             }
         }
     }
@@ -845,6 +884,33 @@ bool DocumentManager::checkPermissionsBeforeSave()
     return true;
 }
 
+bool DocumentManager::waitForSave()
+{
+    if (saveFutureWatcher->isRunning() || saveFutureWatcher->isStarted())
+    {
+        AsyncFileAccess::Result result =
+            fileAccess->waitForFuture
+            (
+                saveFutureWatcher->future(),
+                tr("Saving %1...").arg(document->getFilePath())
+            );
+
+        if (AsyncFileAccess::TimedOut == result)
+        {
+            MessageBoxHelper::critical
+            (
+                parentWidget,
+                tr("Error saving %1").arg(document->getFilePath()),
+                tr("The file system is not responding.")
+            );
+        }
+
+        return (AsyncFileAccess::Succeeded == result);
+    }
+
+    return true;
+}
+
 QString DocumentManager::saveToDisk
 (
     const QString& filePath,
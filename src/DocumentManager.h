@@ -25,6 +25,7 @@
 #include <QFutureWatcher>
 #include <QPrinter>
 
+#include "AsyncFileAccess.h"
 #include "MarkdownEditor.h"
 #include "DocumentStatistics.h"
 #include "SessionStatistics.h"
@@ -95,6 +96,13 @@ class DocumentManager : public QObject
          */
         void documentModifiedChanged(bool modified);
 
+        /**
+         * Emitted when the document's file path changes, such as when a file
+         * is opened, saved under a new name, or closed.  The file path will
+         * be empty if the document is new and has not yet been saved.
+         */
+        void filePathChanged(const QString& filePath);
+
         /**
          * Emitted when an operation on the document has started, such as
          * when a document is being loaded into the editor either from being
@@ -220,6 +228,7 @@ class DocumentManager : public QObject
         void onDocumentModifiedChanged(bool modified);
         void onSaveCompleted();
         void onFileChangedExternally(const QString& path);
+        void onRecentFilesFound(const QStringList& existingPaths);
         void printFileToPrinter(QPrinter* printer);
         void autoSaveFile();
 
@@ -233,6 +242,15 @@ class DocumentManager : public QObject
         SessionStatistics* sessionStats;
         QFutureWatcher<QString>* saveFutureWatcher;
         QFileSystemWatcher* fileWatcher;
+        AsyncFileAccess* fileAccess;
+
+        /*
+         * Canonical path of the document's file, under which the document
+         * is stored in the recent file history.  This is looked up once
+         * when the file path is set, so that the history can be updated
+         * without touching the file system.
+         */
+        QString canonicalFilePath;
         bool fileHistoryEnabled;
         bool createBackupOnSave;
 
@@ -270,6 +288,18 @@ class DocumentManager : public QObject
          */
         void setFilePath(const QString& filePath);
 
+        /*
+         * Sets the file path for the document, given the file's status
+         * has already been looked up.
+         */
+        void setFilePath(const QString& filePath, const FileStatus& status);
+
+        /*
+         * Waits for the save in progress, if any, to finish.  Returns false
+         * if the save timed out or the user cancelled waiting for it.
+         */
+        bool waitForSave();
+
         /*
          * Checks if changes need to be saved before an operation
          * can continue.  The user will be prompted to save if
@@ -0,0 +1,479 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QPlainTextEdit>
+#include <QScrollBar>
+#include <QTextBlock>
+#include <QTimer>
+
+#include "DocumentMinimap.h"
+#include "MarkdownStates.h"
+#include "TextDocumentLayout.h"
+
+// Width of the minimap, in pixels.
+#define GW_MINIMAP_WIDTH 100
+
+// Height of the row of each block, and of the bar drawn in it, in pixels.
+#define GW_MINIMAP_ROW_HEIGHT 3
+#define GW_MINIMAP_BAR_HEIGHT 2
+
+// Margin to the left of the rows, in pixels.  Each character of a row is
+// one pixel wide.
+//
+#define GW_MINIMAP_MARGIN 4
+
+// Number of blocks drawn into each cached tile.
+#define GW_MINIMAP_TILE_ROWS 256
+
+// Delay in milliseconds before document changes are reflected in the
+// minimap, so that bursts of changes are handled in one go.
+//
+#define GW_MINIMAP_REFRESH_DELAY 100
+
+DocumentMinimap::DocumentMinimap(QPlainTextEdit* editor, QWidget* parent)
+    : QWidget(parent), editor(editor)
+{
+    firstDirtyBlock = -1;
+    lastDirtyBlock = -1;
+
+    setColorScheme(Qt::black, Qt::white, Qt::gray, Qt::blue);
+    setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Expanding);
+    setCursor(Qt::PointingHandCursor);
+
+    refreshTimer = new QTimer(this);
+    refreshTimer->setSingleShot(true);
+    refreshTimer->setInterval(GW_MINIMAP_REFRESH_DELAY);
+    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+
+    // Note that the syntax highlighter marks the blocks it highlights as
+    // changed, so block states that change after the text has changed are
+    // picked up here as well.
+    //
+    connect
+    (
+        editor->document(),
+        SIGNAL(contentsChange(int,int,int)),
+        this,
+        SLOT(onContentsChange(int,int,int))
+    );
+
+    // Only the viewport marker and the tile offsets change on scrolling.
+    connect
+    (
+        editor->verticalScrollBar(),
+        SIGNAL(valueChanged(int)),
+        this,
+        SLOT(update())
+    );
+    connect
+    (
+        editor->verticalScrollBar(),
+        SIGNAL(rangeChanged(int,int)),
+        this,
+        SLOT(update())
+    );
+
+    refreshTimer->start();
+}
+
+DocumentMinimap::~DocumentMinimap()
+{
+
+}
+
+void DocumentMinimap::setColorScheme
+(
+    const QColor& defaultTextColor,
+    const QColor& backgroundColor,
+    const QColor& markupColor,
+    const QColor& linkColor
+)
+{
+    this->backgroundColor = backgroundColor;
+
+    rowColors[RowBlank] = backgroundColor;
+    rowColors[RowText] = defaultTextColor;
+    rowColors[RowText].setAlpha(90);
+    rowColors[RowHeading] = defaultTextColor;
+    rowColors[RowCode] = markupColor;
+    rowColors[RowCode].setAlpha(160);
+    rowColors[RowBlockquote] = markupColor;
+    rowColors[RowBlockquote].setAlpha(110);
+    rowColors[RowList] = defaultTextColor;
+    rowColors[RowList].setAlpha(90);
+    rowColors[RowTable] = linkColor;
+    rowColors[RowTable].setAlpha(130);
+    rowColors[RowMarkup] = markupColor;
+    rowColors[RowMarkup].setAlpha(110);
+
+    viewportColor = defaultTextColor;
+    viewportColor.setAlpha(30);
+
+    tileDirty.fill(true);
+    update();
+}
+
+QSize DocumentMinimap::sizeHint() const
+{
+    return QSize(GW_MINIMAP_WIDTH, QWidget::sizeHint().height());
+}
+
+void DocumentMinimap::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.fillRect(rect(), backgroundColor);
+
+    int offset = contentOffset();
+    int tileHeight = GW_MINIMAP_TILE_ROWS * GW_MINIMAP_ROW_HEIGHT;
+    int firstTile = offset / tileHeight;
+    int lastTile = qMin(tiles.size() - 1, (offset + height()) / tileHeight);
+
+    for (int i = firstTile; i <= lastTile; i++)
+    {
+        // Tiles are only drawn once they are scrolled into view.
+        if (tileDirty[i] || (tiles[i].width() != width()))
+        {
+            drawTile(i);
+        }
+
+        painter.drawPixmap(0, (i * tileHeight) - offset, tiles[i]);
+    }
+
+    // Mark the blocks that are visible in the editor.
+    int firstVisible = editor->cursorForPosition(QPoint(0, 0)).blockNumber();
+    int lastVisible =
+        editor->cursorForPosition
+        (
+            QPoint(0, editor->viewport()->height() - 1)
+        ).blockNumber();
+
+    painter.fillRect
+    (
+        0,
+        (firstVisible * GW_MINIMAP_ROW_HEIGHT) - offset,
+        width(),
+        (lastVisible - firstVisible + 1) * GW_MINIMAP_ROW_HEIGHT,
+        viewportColor
+    );
+}
+
+void DocumentMinimap::mousePressEvent(QMouseEvent* event)
+{
+    if (Qt::LeftButton == event->button())
+    {
+        scrollTo(event->y());
+        event->accept();
+    }
+    else
+    {
+        QWidget::mousePressEvent(event);
+    }
+}
+
+void DocumentMinimap::mouseMoveEvent(QMouseEvent* event)
+{
+    if (event->buttons() & Qt::LeftButton)
+    {
+        scrollTo(event->y());
+        event->accept();
+    }
+    else
+    {
+        QWidget::mouseMoveEvent(event);
+    }
+}
+
+void DocumentMinimap::onContentsChange
+(
+    int position,
+    int charsRemoved,
+    int charsAdded
+)
+{
+    Q_UNUSED(charsRemoved)
+
+    QTextDocument* document = editor->document();
+    QTextBlock first = document->findBlock(position);
+    QTextBlock last = document->findBlock(position + charsAdded);
+
+    int firstBlock = first.isValid() ? first.blockNumber() : 0;
+    int lastBlock =
+        last.isValid() ? last.blockNumber() : (document->blockCount() - 1);
+
+    if (firstDirtyBlock < 0)
+    {
+        firstDirtyBlock = firstBlock;
+        lastDirtyBlock = lastBlock;
+    }
+    else
+    {
+        firstDirtyBlock = qMin(firstDirtyBlock, firstBlock);
+        lastDirtyBlock = qMax(lastDirtyBlock, lastBlock);
+    }
+
+    refreshTimer->start();
+}
+
+void DocumentMinimap::refresh()
+{
+    QTextDocument* document = editor->document();
+    int blockCount = document->blockCount();
+    int firstBlock = firstDirtyBlock;
+    int lastBlock = qMin(lastDirtyBlock, blockCount - 1);
+
+    firstDirtyBlock = -1;
+    lastDirtyBlock = -1;
+
+    // Inserting or removing blocks shifts the rows of every block below
+    // them, so compare all of the rows.  This is still much cheaper than
+    // drawing them, and only the tiles whose rows actually moved or
+    // changed are drawn again.
+    //
+    if (blockCount != rows.size())
+    {
+        firstBlock = 0;
+        lastBlock = blockCount - 1;
+
+        int tileCount =
+            (blockCount + GW_MINIMAP_TILE_ROWS - 1) / GW_MINIMAP_TILE_ROWS;
+
+        while (tiles.size() > tileCount)
+        {
+            tiles.removeLast();
+        }
+
+        while (tiles.size() < tileCount)
+        {
+            tiles.append(QPixmap());
+        }
+
+        // New tiles are dirty, as is the tile that holds the last row,
+        // which may have gained or lost rows.
+        //
+        int oldTileCount = tileDirty.size();
+        tileDirty.resize(tileCount);
+
+        for (int i = qMax(0, qMin(oldTileCount, tileCount) - 1); i < tileCount; i++)
+        {
+            tileDirty[i] = true;
+        }
+
+        rows.resize(blockCount);
+    }
+
+    if (firstBlock < 0)
+    {
+        return;
+    }
+
+    QTextBlock block = document->findBlockByNumber(firstBlock);
+
+    for (int i = firstBlock; (i <= lastBlock) && block.isValid(); i++)
+    {
+        updateRow(i, rowForBlock(block));
+        block = block.next();
+    }
+
+    update();
+}
+
+DocumentMinimap::Row DocumentMinimap::rowForBlock(const QTextBlock& block) const
+{
+    Row row;
+    QString text = block.text();
+    int indent = 0;
+
+    while ((indent < text.length()) && text[indent].isSpace())
+    {
+        indent++;
+    }
+
+    row.indent = qMin(indent, 255);
+    row.length = qMin(text.length() - indent, 255);
+
+    switch (block.userState())
+    {
+        case MarkdownStateAtxHeading1:
+        case MarkdownStateAtxHeading2:
+        case MarkdownStateAtxHeading3:
+        case MarkdownStateAtxHeading4:
+        case MarkdownStateAtxHeading5:
+        case MarkdownStateAtxHeading6:
+        case MarkdownStateSetextHeading1Line1:
+        case MarkdownStateSetextHeading1Line2:
+        case MarkdownStateSetextHeading2Line1:
+        case MarkdownStateSetextHeading2Line2:
+            row.kind = RowHeading;
+            break;
+        case MarkdownStateCodeBlock:
+        case MarkdownStateInGithubCodeFence:
+        case MarkdownStateInPandocCodeFence:
+        case MarkdownStateCodeFenceEnd:
+            row.kind = RowCode;
+            break;
+        case MarkdownStateBlockquote:
+            row.kind = RowBlockquote;
+            break;
+        case MarkdownStateNumberedList:
+        case MarkdownStateBulletPointList:
+        case MarkdownStateListLineBreak:
+            row.kind = RowList;
+            break;
+        case MarkdownStatePipeTableHeader:
+        case MarkdownStatePipeTableDivider:
+        case MarkdownStatePipeTableRow:
+            row.kind = RowTable;
+            break;
+        case MarkdownStateHorizontalRule:
+        case MarkdownStateComment:
+        case MarkdownStateFrontMatter:
+        case MarkdownStateFrontMatterEnd:
+            row.kind = RowMarkup;
+            break;
+        default:
+            row.kind = RowText;
+            break;
+    }
+
+    if (0 == row.length)
+    {
+        row.kind = RowBlank;
+    }
+
+    return row;
+}
+
+void DocumentMinimap::updateRow(int blockNumber, const Row& row)
+{
+    if (row != rows[blockNumber])
+    {
+        rows[blockNumber] = row;
+        tileDirty[blockNumber / GW_MINIMAP_TILE_ROWS] = true;
+    }
+}
+
+void DocumentMinimap::drawTile(int tile)
+{
+    QPixmap& pixmap = tiles[tile];
+
+    if (pixmap.width() != width())
+    {
+        pixmap = QPixmap(width(), GW_MINIMAP_TILE_ROWS * GW_MINIMAP_ROW_HEIGHT);
+    }
+
+    pixmap.fill(backgroundColor);
+
+    QPainter painter(&pixmap);
+    int first = tile * GW_MINIMAP_TILE_ROWS;
+    int last = qMin(rows.size(), first + GW_MINIMAP_TILE_ROWS);
+    int maxWidth = width() - (2 * GW_MINIMAP_MARGIN);
+
+    for (int i = first; i < last; i++)
+    {
+        const Row& row = rows[i];
+
+        if ((RowBlank == row.kind) || (row.indent >= maxWidth))
+        {
+            continue;
+        }
+
+        painter.fillRect
+        (
+            GW_MINIMAP_MARGIN + row.indent,
+            (i - first) * GW_MINIMAP_ROW_HEIGHT,
+            qMin((int) row.length, maxWidth - row.indent),
+            GW_MINIMAP_BAR_HEIGHT,
+            rowColors[row.kind]
+        );
+    }
+
+    painter.end();
+    tileDirty[tile] = false;
+}
+
+int DocumentMinimap::contentOffset() const
+{
+    int contentHeight = rows.size() * GW_MINIMAP_ROW_HEIGHT;
+    QScrollBar* scrollBar = editor->verticalScrollBar();
+
+    if ((contentHeight <= height()) || (scrollBar->maximum() <= scrollBar->minimum()))
+    {
+        return 0;
+    }
+
+    // Scroll the minimap along with the editor, so that the top and bottom
+    // of the document line up with the top and bottom of the scroll range.
+    //
+    qint64 range = scrollBar->maximum() - scrollBar->minimum();
+    qint64 value = scrollBar->value() - scrollBar->minimum();
+
+    return (int) (((contentHeight - height()) * value) / range);
+}
+
+void DocumentMinimap::scrollTo(int y)
+{
+    QTextDocument* document = editor->document();
+    int blockNumber = (y + contentOffset()) / GW_MINIMAP_ROW_HEIGHT;
+    blockNumber = qBound(0, blockNumber, document->blockCount() - 1);
+
+    TextDocumentLayout* layout =
+        qobject_cast<TextDocumentLayout*>(document->documentLayout());
+
+    // Center the block under the mouse in the editor.  The block height
+    // index of the layout gives the line to scroll to, however tall the
+    // blocks around it are because of wrapped lines or image previews.
+    //
+    if (NULL != layout)
+    {
+        int blockCenter =
+            (layout->blockTop(blockNumber) + layout->blockTop(blockNumber + 1)) / 2;
+
+        editor->verticalScrollBar()->setValue
+        (
+            layout->lineNumberAt
+            (
+                qMax(0, blockCenter - (editor->viewport()->height() / 2))
+            )
+        );
+
+        return;
+    }
+
+    int firstVisible = editor->cursorForPosition(QPoint(0, 0)).blockNumber();
+    int lastVisible =
+        editor->cursorForPosition
+        (
+            QPoint(0, editor->viewport()->height() - 1)
+        ).blockNumber();
+
+    blockNumber -= (lastVisible - firstVisible) / 2;
+    blockNumber = qBound(0, blockNumber, document->blockCount() - 1);
+
+    QTextBlock block = document->findBlockByNumber(blockNumber);
+
+    if (block.isValid())
+    {
+        editor->verticalScrollBar()->setValue(block.firstLineNumber());
+    }
+}
@@ -0,0 +1,149 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef DOCUMENTMINIMAP_H
+#define DOCUMENTMINIMAP_H
+
+#include <QColor>
+#include <QList>
+#include <QPixmap>
+#include <QVector>
+#include <QWidget>
+
+class QMouseEvent;
+class QPainter;
+class QPaintEvent;
+class QPlainTextEdit;
+class QTextBlock;
+class QTimer;
+
+/**
+ * Narrow strip beside the editor that shows the shape of the whole
+ * document, with a row of a couple of pixels for each block, and marks
+ * the part of the document that is currently visible in the editor.
+ * Clicking or dragging in the strip scrolls the editor.
+ *
+ * Rather than drawing text, each row is drawn from the kind of block it
+ * is, which is taken from the state the syntax highlighter left in the
+ * block, and from the block's indentation and length.  These are cached
+ * per block, and the rows are drawn into pixmap tiles of a fixed number
+ * of blocks.  As the document changes, only the tiles with rows whose
+ * cached values have changed are drawn again, and scrolling only
+ * composites the tiles that are already drawn.
+ */
+class DocumentMinimap : public QWidget
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Takes the editor whose document is to be shown as
+         * a parameter.
+         */
+        DocumentMinimap(QPlainTextEdit* editor, QWidget* parent = 0);
+
+        /**
+         * Destructor.
+         */
+        ~DocumentMinimap();
+
+        /**
+         * Sets the colors with which to draw the minimap.
+         */
+        void setColorScheme
+        (
+            const QColor& defaultTextColor,
+            const QColor& backgroundColor,
+            const QColor& markupColor,
+            const QColor& linkColor
+        );
+
+        QSize sizeHint() const;
+
+    protected:
+        void paintEvent(QPaintEvent* event);
+        void mousePressEvent(QMouseEvent* event);
+        void mouseMoveEvent(QMouseEvent* event);
+
+    private slots:
+        void onContentsChange(int position, int charsRemoved, int charsAdded);
+        void refresh();
+
+    private:
+        // Kinds of rows, which determine the color of the row.
+        enum RowKind
+        {
+            RowBlank,
+            RowText,
+            RowHeading,
+            RowCode,
+            RowBlockquote,
+            RowList,
+            RowTable,
+            RowMarkup,
+            RowKindCount
+        };
+
+        // Cached appearance of the row of one block.
+        struct Row
+        {
+            uchar kind;
+            uchar indent;
+            uchar length;
+
+            Row() : kind(RowBlank), indent(0), length(0)
+            {
+                ;
+            }
+
+            bool operator==(const Row& other) const
+            {
+                return (kind == other.kind)
+                    && (indent == other.indent)
+                    && (length == other.length);
+            }
+
+            bool operator!=(const Row& other) const
+            {
+                return !(*this == other);
+            }
+        };
+
+        QPlainTextEdit* editor;
+        QColor rowColors[RowKindCount];
+        QColor backgroundColor;
+        QColor viewportColor;
+        QTimer* refreshTimer;
+
+        QVector<Row> rows;
+        QList<QPixmap> tiles;
+        QVector<bool> tileDirty;
+
+        // Range of blocks changed since the last refresh, or -1 if none.
+        int firstDirtyBlock;
+        int lastDirtyBlock;
+
+        Row rowForBlock(const QTextBlock& block) const;
+        void updateRow(int blockNumber, const Row& row);
+        void drawTile(int tile);
+        int contentOffset() const;
+        void scrollTo(int y);
+};
+
+#endif // DOCUMENTMINIMAP_H
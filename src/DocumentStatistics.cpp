@@ -21,20 +21,12 @@
 #include <QTextBoundaryFinder>
 
 #include "DocumentStatistics.h"
-#include "TextBlockData.h"
 
 DocumentStatistics::DocumentStatistics(QTextDocument* document, QObject* parent)
     : QObject(parent), document(document)
 {
-    wordCount = 0;
-    wordCharacterCount = 0;
-    sentenceCount = 0;
-    paragraphCount = 0;
-    lixLongWordCount = 0;
-    lastBlockCount = 1;
-
     connect(this->document, SIGNAL(contentsChange(int,int,int)), this, SLOT(onTextChanged(int,int,int)));
-    connect(this->document, SIGNAL(blockCountChanged(int)), this, SLOT(onBlockCountChanged(int)));
+    refreshStatistics();
 }
 
 DocumentStatistics::~DocumentStatistics()
@@ -44,54 +36,46 @@ DocumentStatistics::~DocumentStatistics()
 
 int DocumentStatistics::getWordCount() const
 {
-    return wordCount;
+    return blockCounts.total().words;
 }
 
-void DocumentStatistics::refreshStatistics()
+int DocumentStatistics::getWordCount(int startPosition, int endPosition) const
 {
-    // For each block, update the word count.
-    QTextBlock block = document->begin();
-    wordCount = 0;
-    wordCharacterCount = 0;
-    sentenceCount = 0;
-    paragraphCount = 0;
-    lixLongWordCount = 0;
+    int startBlock = document->findBlock(startPosition).blockNumber();
+    int endBlock = document->blockCount();
 
-    TextBlockData* blockData = (TextBlockData*) block.userData();
+    if (startBlock < 0)
+    {
+        return 0;
+    }
 
-    if (NULL != blockData)
+    if (endPosition >= 0)
     {
-        wordCount += blockData->wordCount;
-        wordCharacterCount += blockData->alphaNumericCharacterCount;
-        sentenceCount += blockData->sentenceCount;
-        lixLongWordCount += blockData->lixLongWordCount;
+        QTextBlock block = document->findBlock(endPosition);
 
-        if (!blockData->blankLine)
+        if (block.isValid())
         {
-            paragraphCount++;
+            endBlock = block.blockNumber();
         }
     }
 
-    while (block != document->end())
-    {
-        block = block.next();
-        blockData = (TextBlockData*) block.userData();
+    return blockCounts.sum(startBlock, endBlock).words;
+}
 
-        if (NULL != blockData)
-        {
-            wordCount += blockData->wordCount;
-            wordCharacterCount += blockData->alphaNumericCharacterCount;
-            sentenceCount += blockData->sentenceCount;
-            lixLongWordCount += blockData->lixLongWordCount;
+void DocumentStatistics::refreshStatistics()
+{
+    // Recount every block.
+    QVector<BlockCounts> counts;
+    counts.reserve(document->blockCount());
 
-            if (!blockData->blankLine)
-            {
-                paragraphCount++;
-            }
-        }
+    for (QTextBlock block = document->begin(); block.isValid(); block = block.next())
+    {
+        counts.append(countBlock(block));
     }
 
+    blockCounts.reset(counts);
     updateStatistics();
+    emit blockWordCountsChanged(0, document->characterCount());
 }
 
 void DocumentStatistics::onTextSelected
@@ -116,22 +100,11 @@ void DocumentStatistics::onTextSelected
     int selectionSentenceCount = countSentences(selectedText);
 
     // Count the number of selected paragraphs.
-    int selectedParagraphCount = 0;
-
-    QTextBlock block = this->document->findBlock(selectionStart);
-    QTextBlock end = this->document->findBlock(selectionEnd).next();
-
-    while (block != end)
-    {
-        TextBlockData* blockData = (TextBlockData*) block.userData();
-
-        if ((NULL != blockData) && !blockData->blankLine)
-        {
-            selectedParagraphCount++;
-        }
-
-        block = block.next();
-    }
+    int selectedParagraphCount = blockCounts.sum
+        (
+            document->findBlock(selectionStart).blockNumber(),
+            document->findBlock(selectionEnd).blockNumber() + 1
+        ).paragraphs;
 
     emit wordCountChanged(selectionWordCount);
     emit characterCountChanged(selectedText.length());
@@ -153,111 +126,84 @@ void DocumentStatistics::onTextChanged(int position, int charsRemoved, int chars
 {
     Q_UNUSED(charsRemoved)
 
-    int startIndex = position - charsRemoved;
+    int endPosition = position + charsAdded;
 
-    if (startIndex < 0)
+    if (endPosition >= document->characterCount())
     {
-        startIndex = 0;
+        endPosition = document->characterCount() - 1;
     }
 
-    int endIndex = position + charsAdded;
+    QTextBlock startBlock = document->findBlock(position);
+    QTextBlock endBlock = document->findBlock(endPosition);
+
+    if (!startBlock.isValid())
+    {
+        return;
+    }
+
+    // Of the blocks spanned by the change, only the first one existed
+    // before it, so splice any inserted or removed blocks in after that
+    // one.  The rest of the blocks keep their counts, at shifted indexes.
+    //
+    int blockCountDelta = document->blockCount() - blockCounts.size();
 
-    if ((endIndex < startIndex) || (endIndex >= document->characterCount()))
+    if (blockCountDelta > 0)
     {
-        endIndex = document->characterCount() - 1;
+        blockCounts.insert(startBlock.blockNumber() + 1, blockCountDelta);
+    }
+    else if (blockCountDelta < 0)
+    {
+        blockCounts.remove(startBlock.blockNumber() + 1, -blockCountDelta);
     }
 
-    // Update the word counts of affected blocks.  Note that there is no need to
+    // Update the counts of affected blocks.  Note that there is no need to
     // check for changes to section headings, since the Highlighter class will
     // take care of this for us.
     //
-    QTextBlock startBlock = document->findBlock(startIndex);
-    QTextBlock endBlock = document->findBlock(endIndex);
-
     QTextBlock block = startBlock;
 
-    updateBlockStatistics(block);
-
-    while (block != endBlock)
+    while (block.isValid())
     {
-        block = block.next();
-        updateBlockStatistics(block);
-    }
+        blockCounts.setValue(block.blockNumber(), countBlock(block));
 
-    updateStatistics();
-}
+        if (block == endBlock)
+        {
+            break;
+        }
 
-void DocumentStatistics::onBlockCountChanged(int newBlockCount)
-{
-    // If one or more blocks was deleted from the document, update
-    // statistics from scratch.
-    //
-    if (newBlockCount < lastBlockCount)
-    {
-        refreshStatistics();
+        block = block.next();
     }
 
-    lastBlockCount = newBlockCount;
+    updateStatistics();
+    emit blockWordCountsChanged(position, endPosition);
 }
 
 void DocumentStatistics::updateStatistics()
 {
-    emit wordCountChanged(wordCount);
-    emit totalWordCountChanged(wordCount);
+    BlockCounts totals = blockCounts.total();
+
+    emit wordCountChanged(totals.words);
+    emit totalWordCountChanged(totals.words);
     emit characterCountChanged(document->characterCount() - 1);
-    emit sentenceCountChanged(sentenceCount);
-    emit paragraphCountChanged(paragraphCount);
-    emit pageCountChanged(calculatePageCount(wordCount));
-    emit complexWordsChanged(calculateComplexWords(wordCount, lixLongWordCount));
-    emit readingTimeChanged(calculateReadingTime(wordCount));
-    emit lixReadingEaseChanged(calculateLIX(wordCount, lixLongWordCount, sentenceCount));
-    emit readabilityIndexChanged(calculateCLI(wordCharacterCount, wordCount, sentenceCount));
+    emit sentenceCountChanged(totals.sentences);
+    emit paragraphCountChanged(totals.paragraphs);
+    emit pageCountChanged(calculatePageCount(totals.words));
+    emit complexWordsChanged(calculateComplexWords(totals.words, totals.lixLongWords));
+    emit readingTimeChanged(calculateReadingTime(totals.words));
+    emit lixReadingEaseChanged(calculateLIX(totals.words, totals.lixLongWords, totals.sentences));
+    emit readabilityIndexChanged(calculateCLI(totals.wordCharacters, totals.words, totals.sentences));
 }
 
-void DocumentStatistics::updateBlockStatistics(QTextBlock& block)
+DocumentStatistics::BlockCounts DocumentStatistics::countBlock(const QTextBlock& block)
 {
-    TextBlockData* blockData = (TextBlockData*) block.userData();
-
-    if (NULL == blockData)
-    {
-        blockData = new TextBlockData();
-        block.setUserData(blockData);
-    }
+    BlockCounts counts;
+    QString text = block.text();
 
-    int oldWordCount = blockData->wordCount;
-    int oldLixLongWordCount = blockData->lixLongWordCount;
-    int oldAlphaNumCharCount = blockData->alphaNumericCharacterCount;
+    countWords(text, counts.words, counts.lixLongWords, counts.wordCharacters);
+    counts.sentences = countSentences(text);
+    counts.paragraphs = (text.trimmed().length() > 0) ? 1 : 0;
 
-    countWords
-    (
-        block.text(),
-        blockData->wordCount,
-        blockData->lixLongWordCount,
-        blockData->alphaNumericCharacterCount
-    );
-
-
-    wordCount += blockData->wordCount - oldWordCount;
-    lixLongWordCount += blockData->lixLongWordCount - oldLixLongWordCount;
-    wordCharacterCount += blockData->alphaNumericCharacterCount - oldAlphaNumCharCount;
-
-    int oldSentenceCount = blockData->sentenceCount;
-    blockData->sentenceCount = countSentences(block.text());
-    sentenceCount += blockData->sentenceCount - oldSentenceCount;
-
-    if (blockData->blankLine)
-    {
-        if (block.text().trimmed().length() > 0)
-        {
-            blockData->blankLine = false;
-            paragraphCount++;
-        }
-    }
-    else if (block.text().trimmed().length() <= 0)
-    {
-        blockData->blankLine = true;
-        paragraphCount--;
-    }
+    return counts;
 }
 
 void DocumentStatistics::countWords
@@ -452,3 +398,44 @@ int DocumentStatistics::calculateReadingTime(int words)
     return words / 270;
 }
 
+DocumentStatistics::BlockCounts::BlockCounts()
+    : words(0),
+    lixLongWords(0),
+    wordCharacters(0),
+    sentences(0),
+    paragraphs(0)
+{
+    ;
+}
+
+DocumentStatistics::BlockCounts DocumentStatistics::BlockCounts::operator+
+(
+    const BlockCounts& other
+) const
+{
+    BlockCounts result;
+
+    result.words = words + other.words;
+    result.lixLongWords = lixLongWords + other.lixLongWords;
+    result.wordCharacters = wordCharacters + other.wordCharacters;
+    result.sentences = sentences + other.sentences;
+    result.paragraphs = paragraphs + other.paragraphs;
+
+    return result;
+}
+
+DocumentStatistics::BlockCounts DocumentStatistics::BlockCounts::operator-
+(
+    const BlockCounts& other
+) const
+{
+    BlockCounts result;
+
+    result.words = words - other.words;
+    result.lixLongWords = lixLongWords - other.lixLongWords;
+    result.wordCharacters = wordCharacters - other.wordCharacters;
+    result.sentences = sentences - other.sentences;
+    result.paragraphs = paragraphs - other.paragraphs;
+
+    return result;
+}
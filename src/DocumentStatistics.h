@@ -23,6 +23,8 @@
 #include <QObject>
 #include <QTextDocument>
 
+#include "SumTree.h"
+
 /**
  * Class to compute document statistics for a QTextDocument.
  */
@@ -46,6 +48,21 @@ class DocumentStatistics : public QObject
          */
         int getWordCount() const;
 
+        /**
+         * Gets the word count of the blocks from the one containing
+         * startPosition up to, but not including, the one containing
+         * endPosition.  If endPosition is negative, the count runs to the
+         * end of the document.  Runs in logarithmic time, so that section
+         * totals can be kept up to date while typing.
+         */
+        int getWordCount(int startPosition, int endPosition) const;
+
+        /**
+         * Returns the estimated time, in minutes, that it takes to read
+         * the given number of words.
+         */
+        static int calculateReadingTime(int words);
+
     signals:
         /**
          * Emitted when word count changes.  May be word count
@@ -99,6 +116,14 @@ class DocumentStatistics : public QObject
          */
         void readabilityIndexChanged(int value);
 
+        /**
+         * Emitted when the word counts of the blocks in the given range of
+         * document positions have been updated, so that any word counts
+         * for ranges overlapping them should be fetched again with
+         * getWordCount().
+         */
+        void blockWordCountsChanged(int startPosition, int endPosition);
+
     public slots:
         /**
          * Updates block statistics for the entire document.
@@ -124,7 +149,6 @@ class DocumentStatistics : public QObject
 
     private slots:
         void onTextChanged(int position, int charsRemoved, int charsAdded);
-        void onBlockCountChanged(int newBlockCount);
 
     private:
         static const QString LESS_THAN_ONE_MINUTE_STR;
@@ -134,21 +158,34 @@ class DocumentStatistics : public QObject
         static const QString DIFFICULT_READING_EASE_STR;
         static const QString VERY_DIFFICULT_READING_EASE_STR;
 
-        QTextDocument* document;
-        int lastBlockCount;
+        // Statistics of one block, or the totals of a range of blocks.
+        struct BlockCounts
+        {
+            int words;
+            int lixLongWords;
 
-        int wordCount; // may be count of selected text only or entire document
-        int totalWordCount; // word count of entire document
+            // Count of characters that are "word" characters.
+            int wordCharacters;
 
-        // Count of characters that are "word" characters.
-        int wordCharacterCount;
+            int sentences;
+            int paragraphs;
+
+            BlockCounts();
+            BlockCounts operator+(const BlockCounts& other) const;
+            BlockCounts operator-(const BlockCounts& other) const;
+        };
+
+        QTextDocument* document;
 
-        int sentenceCount;
-        int paragraphCount;
-        int lixLongWordCount;
+        // Statistics of each block, indexed by block number.  Blocks are
+        // inserted into and removed from the tree along with the document's
+        // blocks, so that the totals, and the totals of any range of
+        // blocks, are kept up to date in logarithmic time.
+        //
+        SumTree<BlockCounts> blockCounts;
 
         void updateStatistics();
-        void updateBlockStatistics(QTextBlock& block);
+        BlockCounts countBlock(const QTextBlock& block);
         void countWords
         (
             const QString& text,
@@ -161,7 +198,6 @@ class DocumentStatistics : public QObject
         int calculateCLI(int characters, int words, int sentences);
         int calculateLIX(int totalWords, int longWords, int sentences);
         int calculateComplexWords(int totalWords, int longWords);
-        int calculateReadingTime(int words);
 
 };
 
@@ -53,11 +53,10 @@ void EffectsMenuBar::setDropShadow
 
     if (menuIsVisible)
     {
-        dropShadowEffect = new QGraphicsDropShadowEffect();
+        dropShadowEffect = new CachedDropShadowEffect();
         dropShadowEffect->setColor(color);
         dropShadowEffect->setBlurRadius(blurRadius);
-        dropShadowEffect->setXOffset(xOffset);
-        dropShadowEffect->setYOffset(yOffset);
+        dropShadowEffect->setOffset(xOffset, yOffset);
         this->setGraphicsEffect(dropShadowEffect);
     }
 }
@@ -109,11 +108,10 @@ void EffectsMenuBar::showBar()
 
         if (dropShadowEnabled)
         {
-            dropShadowEffect = new QGraphicsDropShadowEffect();
+            dropShadowEffect = new CachedDropShadowEffect();
             dropShadowEffect->setColor(dropShadowColor);
             dropShadowEffect->setBlurRadius(dropShadowBlurRadius);
-            dropShadowEffect->setXOffset(dropShadowXOffset);
-            dropShadowEffect->setYOffset(dropShadowYOffset);
+            dropShadowEffect->setOffset(dropShadowXOffset, dropShadowYOffset);
             this->setGraphicsEffect(dropShadowEffect);
         }
     }
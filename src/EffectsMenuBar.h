@@ -21,10 +21,11 @@
 #define EFFECTSMENUBAR_H
 
 #include <QMenuBar>
-#include <QGraphicsDropShadowEffect>
 #include <QGraphicsOpacityEffect>
 #include <QKeyEvent>
 
+#include "CachedDropShadowEffect.h"
+
 /**
  * Menu bar that can do drop shadows on its items or be hidden/shown
  * (for use in full screen mode).  Drop shadows are included in this
@@ -49,7 +50,7 @@ class EffectsMenuBar : public QMenuBar
         ~EffectsMenuBar();
 
         /**
-         * Adds a QGraphicsDropShadowEffect drop shadow to the menu bar using
+         * Adds a CachedDropShadowEffect drop shadow to the menu bar using
          * the specified color, blur radius, and x and y offsets.
          */
         void setDropShadow
@@ -88,7 +89,7 @@ class EffectsMenuBar : public QMenuBar
         qreal dropShadowBlurRadius;
         qreal dropShadowXOffset;
         qreal dropShadowYOffset;
-        QGraphicsDropShadowEffect* dropShadowEffect;
+        CachedDropShadowEffect* dropShadowEffect;
         QGraphicsOpacityEffect* opacityEffect;
         bool menuIsVisible;
         bool dropShadowEnabled;
@@ -35,10 +35,13 @@
 #include "ExportDialog.h"
 #include "ExporterFactory.h"
 #include "Exporter.h"
+#include "HtmlPreview.h"
 #include "MessageBoxHelper.h"
 
 #define GW_LAST_EXPORTER_KEY "Export/lastUsedExporter"
 #define GW_SMART_TYPOGRAPHY_KEY "Export/smartTypographyEnabled"
+#define GW_SELF_CONTAINED_HTML_KEY "Export/selfContainedHtmlEnabled"
+#define GW_EMBEDDED_IMAGE_WIDTH_KEY "Export/embeddedImageMaxWidth"
 
 ExportDialog::ExportDialog(TextDocument* document, QWidget* parent)
     : QDialog(parent), document(document)
@@ -190,11 +193,49 @@ ExportDialog::ExportDialog(TextDocument* document, QWidget* parent)
     smartTypographyCheckBox = new QCheckBox(tr("Smart Typography"));
     smartTypographyCheckBox->setChecked(smartTypographyEnabled);
 
+    selfContainedHtmlCheckBox = new QCheckBox(tr("Self-Contained HTML"));
+    selfContainedHtmlCheckBox->setToolTip(tr("Embed images and the live "
+        "preview's style sheet into exported HTML files, so that they can be "
+        "shared as a single file"));
+    selfContainedHtmlCheckBox->setChecked
+    (
+        settings.value(GW_SELF_CONTAINED_HTML_KEY, false).toBool()
+    );
+
+    int imageWidth = settings.value(GW_EMBEDDED_IMAGE_WIDTH_KEY, 0).toInt();
+    const int imageWidths[] = { 0, 2048, 1280, 800 };
+
+    imageWidthComboBox = new QComboBox();
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (0 == imageWidths[i])
+        {
+            imageWidthComboBox->addItem(tr("Original Size"), 0);
+        }
+        else
+        {
+            imageWidthComboBox->addItem
+            (
+                tr("%1 Pixels Wide").arg(imageWidths[i]),
+                imageWidths[i]
+            );
+        }
+
+        if (imageWidth == imageWidths[i])
+        {
+            imageWidthComboBox->setCurrentIndex(i);
+        }
+    }
+
     QGroupBox* optionsGroupBox = new QGroupBox(tr("Export Options"));
     QGridLayout* optionsLayout = new QGridLayout();
     optionsLayout->addWidget(new QLabel(tr("Markdown Converter:")), 0, 0, 1, 1);
     optionsLayout->addWidget(exporterComboBox, 0, 1, 1, 1, Qt::AlignLeft);
     optionsLayout->addWidget(smartTypographyCheckBox, 0, 2, 1, 2);
+    optionsLayout->addWidget(new QLabel(tr("Embedded Images:")), 1, 0, 1, 1);
+    optionsLayout->addWidget(imageWidthComboBox, 1, 1, 1, 1, Qt::AlignLeft);
+    optionsLayout->addWidget(selfContainedHtmlCheckBox, 1, 2, 1, 2);
     optionsGroupBox->setLayout(optionsLayout);
 
     QVBoxLayout* layout = new QVBoxLayout(this);
@@ -204,6 +245,10 @@ ExportDialog::ExportDialog(TextDocument* document, QWidget* parent)
 
     connect(exporterComboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(onExporterChanged(int)));
     connect(fileDialogWidget, SIGNAL(filterSelected(QString)), this, SLOT(onFilterSelected(QString)));
+    connect(selfContainedHtmlCheckBox, SIGNAL(toggled(bool)), this, SLOT(onSelfContainedHtmlToggled(bool)));
+
+    selfContainedHtmlCheckBox->setEnabled(exporters[selectedIndex]->getSelfContainedHtmlSupported());
+    onSelfContainedHtmlToggled(selfContainedHtmlCheckBox->isChecked());
 }
 
 ExportDialog::~ExportDialog()
@@ -211,6 +256,12 @@ ExportDialog::~ExportDialog()
     QSettings settings;
     settings.setValue(GW_LAST_EXPORTER_KEY, exporterComboBox->currentText());
     settings.setValue(GW_SMART_TYPOGRAPHY_KEY, smartTypographyCheckBox->isChecked());
+    settings.setValue(GW_SELF_CONTAINED_HTML_KEY, selfContainedHtmlCheckBox->isChecked());
+    settings.setValue
+    (
+        GW_EMBEDDED_IMAGE_WIDTH_KEY,
+        imageWidthComboBox->itemData(imageWidthComboBox->currentIndex())
+    );
 }
 
 void ExportDialog::accept()
@@ -238,6 +289,16 @@ void ExportDialog::accept()
                 emit exportStarted(tr("exporting to %1").arg(fileName));
 
                 exporter->setSmartTypographyEnabled(smartTypographyCheckBox->isChecked());
+
+                QSettings settings;
+                exporter->setSelfContainedHtmlEnabled
+                (
+                    selfContainedHtmlCheckBox->isEnabled()
+                        && selfContainedHtmlCheckBox->isChecked(),
+                    settings.value(GW_LAST_USED_STYLE_SHEET_KEY, GW_DEFAULT_STYLE_SHEET).toString(),
+                    imageWidthComboBox->itemData(imageWidthComboBox->currentIndex()).toInt()
+                );
+
                 exporter->exportToFile
                 (
                     format,
@@ -283,6 +344,9 @@ void ExportDialog::onExporterChanged(int index)
     }
 
     fileDialogWidget->setNameFilter(fileFilters[index]);
+
+    selfContainedHtmlCheckBox->setEnabled(exporter->getSelfContainedHtmlSupported());
+    onSelfContainedHtmlToggled(selfContainedHtmlCheckBox->isChecked());
 }
 
 void ExportDialog::onFilterSelected(const QString& filter)
@@ -304,3 +368,8 @@ void ExportDialog::onFilterSelected(const QString& filter)
         }
     }
 }
+
+void ExportDialog::onSelfContainedHtmlToggled(bool checked)
+{
+    imageWidthComboBox->setEnabled(selfContainedHtmlCheckBox->isEnabled() && checked);
+}
@@ -33,7 +33,8 @@ class QCheckBox;
  * logic is performed by Exporters, which are provided by ExporterFactory.  The
  * user can select which exporter to use in a combo box.  Also, an option for
  * enabling/disabling smart typography during export is provided in the form of
- * a checkbox.
+ * a checkbox, as is an option for exporting HTML as a self-contained file
+ * with its images and the live preview's style sheet embedded.
  */
 class ExportDialog : public QDialog
 {
@@ -86,10 +87,17 @@ class ExportDialog : public QDialog
          */
         void onFilterSelected(const QString& filter);
 
+        /*
+         * Called when the user toggles the self-contained HTML option.
+         */
+        void onSelfContainedHtmlToggled(bool checked);
+
     private:
         QFileDialog* fileDialogWidget;
         QComboBox* exporterComboBox;
         QCheckBox* smartTypographyCheckBox;
+        QCheckBox* selfContainedHtmlCheckBox;
+        QComboBox* imageWidthComboBox;
         TextDocument* document;
         QStringList fileFilters;
 };
@@ -21,14 +21,20 @@
 #include <QString>
 #include <QStringList>
 #include <QObject>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
 
 #include "Exporter.h"
+#include "SelfContainedHtmlWriter.h"
 
 #include <stdio.h>
 
 
 Exporter::Exporter(const QString& name)
-    : smartTypographyEnabled(false), name(name)
+    : smartTypographyEnabled(false), selfContainedHtmlSupported(false),
+    name(name), markdownFlavor(MarkdownFlavorGitHub),
+    selfContainedHtmlEnabled(false), maxImageWidth(0)
 {
     ;
 }
@@ -58,6 +64,38 @@ void Exporter::setSmartTypographyEnabled(bool enabled)
     smartTypographyEnabled = enabled;
 }
 
+MarkdownFlavor Exporter::getMarkdownFlavor() const
+{
+    return markdownFlavor;
+}
+
+void Exporter::setMarkdownFlavor(MarkdownFlavor flavor)
+{
+    markdownFlavor = flavor;
+}
+
+bool Exporter::getSelfContainedHtmlSupported() const
+{
+    return selfContainedHtmlSupported;
+}
+
+bool Exporter::getSelfContainedHtmlEnabled() const
+{
+    return selfContainedHtmlEnabled;
+}
+
+void Exporter::setSelfContainedHtmlEnabled
+(
+    bool enabled,
+    const QString& styleSheetPath,
+    int maxImageWidth
+)
+{
+    this->selfContainedHtmlEnabled = enabled;
+    this->styleSheetPath = styleSheetPath;
+    this->maxImageWidth = maxImageWidth;
+}
+
 void Exporter::exportToHtml(const QString& text, QString& html)
 {
     Q_UNUSED(text)
@@ -67,3 +105,61 @@ void Exporter::exportToHtml(const QString& text, QString& html)
          QString("</b></center>)");
 }
 
+void Exporter::writeHtmlFile
+(
+    const QString& html,
+    const QString& inputFilePath,
+    const QString& outputFilePath,
+    QString& err
+) const
+{
+    QFile outputFile(outputFilePath);
+
+    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        err = outputFile.errorString();
+        return;
+    }
+
+    if (selfContainedHtmlSupported && selfContainedHtmlEnabled)
+    {
+        // Images of an untitled document can only be found relative to
+        // where it is exported.
+        //
+        QString basePath = inputFilePath;
+
+        if (basePath.isNull() || basePath.isEmpty())
+        {
+            basePath = outputFilePath;
+        }
+
+        SelfContainedHtmlWriter writer(QFileInfo(basePath).absoluteDir());
+        writer.setStyleSheetPath(styleSheetPath);
+        writer.setMaxImageWidth(maxImageWidth);
+        writer.write(html, &outputFile);
+    }
+    else
+    {
+        QTextStream outStream(&outputFile);
+        outStream.setCodec("UTF-8");
+
+        // Specify the character set (UTF-8) for the HTML document.
+        // Browsers typically can't tell if the HTML has unicode characters
+        // unless UTF-8 is specified in the <head> section.
+        //
+        outStream << "<html><head><meta http-equiv=\"Content-Type\" "
+            "content=\"text/html; charset=utf-8\" />"
+            "<title></title></head><body>";
+
+        outStream << html;
+        outStream << "</body></html>";
+        outStream.flush();
+    }
+
+    if (QFile::NoError != outputFile.error())
+    {
+        err = outputFile.errorString();
+    }
+
+    outputFile.close();
+}
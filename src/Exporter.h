@@ -24,6 +24,7 @@
 #include <QList>
 
 #include "ExportFormat.h"
+#include "MarkdownFlavor.h"
 
 /**
  * Abstract class to export text to another format (i.e., Markdown text to
@@ -76,6 +77,43 @@ class Exporter
          */
         void setSmartTypographyEnabled(bool enabled);
 
+        /**
+         * Returns the Markdown flavor that this exporter's processor reads,
+         * so that the editor can highlight the syntax that the processor
+         * supports.  Defaults to MarkdownFlavorGitHub.
+         */
+        MarkdownFlavor getMarkdownFlavor() const;
+
+        /**
+         * Sets the Markdown flavor that this exporter's processor reads.
+         */
+        void setMarkdownFlavor(MarkdownFlavor flavor);
+
+        /**
+         * Returns true if this exporter can export HTML as a self-contained
+         * file, with its images and style sheet embedded.
+         */
+        bool getSelfContainedHtmlSupported() const;
+
+        /**
+         * Returns true if HTML exports should be self-contained.
+         */
+        bool getSelfContainedHtmlEnabled() const;
+
+        /**
+         * Set to true if HTML exports should be self-contained, with local
+         * images embedded as data URLs and the given style sheet inlined.
+         * Images wider than maxImageWidth pixels are scaled down to fit,
+         * unless maxImageWidth is 0.  Ignored if self-contained HTML is not
+         * supported by this exporter.
+         */
+        void setSelfContainedHtmlEnabled
+        (
+            bool enabled,
+            const QString& styleSheetPath = QString(),
+            int maxImageWidth = 0
+        );
+
         /**
          * Override this method to transform the given text into HTML for
          * use in the Live HTML Preview.  By default, this method will set the
@@ -121,8 +159,31 @@ class Exporter
          */
         bool smartTypographyEnabled;
 
+        /*
+         * Implementors of this class that write HTML files themselves via
+         * writeHtmlFile() should set this flag to true.
+         */
+        bool selfContainedHtmlSupported;
+
+        /*
+         * Writes a complete HTML document with the given HTML body to the
+         * given output file, self-contained if so enabled.  Sets err to an
+         * error string if an error occurs.
+         */
+        void writeHtmlFile
+        (
+            const QString& html,
+            const QString& inputFilePath,
+            const QString& outputFilePath,
+            QString& err
+        ) const;
+
     private:
         QString name;
+        MarkdownFlavor markdownFlavor;
+        bool selfContainedHtmlEnabled;
+        QString styleSheetPath;
+        int maxImageWidth;
 };
 
 #endif
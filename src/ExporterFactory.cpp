@@ -20,10 +20,17 @@
 #include <QProcess>
 #include <QObject>
 #include <QRegExp>
+#include <QDir>
+#include <QLibrary>
+#include <QPluginLoader>
+#include <QDebug>
 
 #include "ExporterFactory.h"
 #include "SundownExporter.h"
+#include "CommonMarkExporter.h"
 #include "CommandLineExporter.h"
+#include "PluginExporter.h"
+#include "AppSettings.h"
 
 ExporterFactory* ExporterFactory::instance = NULL;
 
@@ -66,9 +73,13 @@ ExporterFactory::ExporterFactory()
     fileExporters.append(sundownExporter);
     htmlExporters.append(sundownExporter);
 
+    CommonMarkExporter* commonMarkExporter = new CommonMarkExporter();
+    fileExporters.append(commonMarkExporter);
+    htmlExporters.append(commonMarkExporter);
+
     if (pandocIsAvailable)
     {
-        addPandocExporter("Pandoc", "markdown");
+        addPandocExporter("Pandoc", "markdown", MarkdownFlavorPandoc);
 
         // Check whether version of Pandoc can read CommonMark.
         QList<int> versionNumber = extractVersionNumber("pandoc --version");
@@ -89,19 +100,20 @@ ExporterFactory::ExporterFactory()
                 ((1 == majorVersion) && (minorVersion >= 14))
             )
             {
-                addPandocExporter("Pandoc CommonMark", "commonmark");
+                addPandocExporter("Pandoc CommonMark", "commonmark", MarkdownFlavorCommonMark);
             }
         }
 
-        addPandocExporter("Pandoc GitHub-flavored Markdown", "markdown_github");
-        addPandocExporter("Pandoc PHP Markdown Extra", "markdown_phpextra");
-        addPandocExporter("Pandoc MultiMarkdown", "markdown_mmd");
-        addPandocExporter("Pandoc Strict", "markdown_strict");
+        addPandocExporter("Pandoc GitHub-flavored Markdown", "markdown_github", MarkdownFlavorGitHub);
+        addPandocExporter("Pandoc PHP Markdown Extra", "markdown_phpextra", MarkdownFlavorMultiMarkdown);
+        addPandocExporter("Pandoc MultiMarkdown", "markdown_mmd", MarkdownFlavorMultiMarkdown);
+        addPandocExporter("Pandoc Strict", "markdown_strict", MarkdownFlavorCommonMark);
     }
 
     if (mmdIsAvailable)
     {
         exporter = new CommandLineExporter("MultiMarkdown");
+        exporter->setMarkdownFlavor(MarkdownFlavorMultiMarkdown);
         exporter->setSmartTypographyOnArgument("--smart");
         exporter->setSmartTypographyOffArgument("--nosmart");
         exporter->setHtmlRenderCommand(QString("multimarkdown %1 -t html")
@@ -166,6 +178,7 @@ ExporterFactory::ExporterFactory()
     if (cmarkIsAvailable)
     {
         exporter = new CommandLineExporter("cmark");
+        exporter->setMarkdownFlavor(MarkdownFlavorCommonMark);
         exporter->setSmartTypographyOnArgument("--smart");
         exporter->setHtmlRenderCommand(QString("cmark -t html --smart %1")
             .arg(CommandLineExporter::SMART_TYPOGRAPHY_ARG));
@@ -190,6 +203,8 @@ ExporterFactory::ExporterFactory()
         fileExporters.append(exporter);
         htmlExporters.append(exporter);
     }
+
+    loadPlugins();
 }
 
 QList<int> ExporterFactory::extractVersionNumber(const QString& command) const
@@ -247,10 +262,12 @@ bool ExporterFactory::isCommandAvailable(const QString& testCommand) const
 void ExporterFactory::addPandocExporter
 (
     const QString& name,
-    const QString& inputFormat
+    const QString& inputFormat,
+    MarkdownFlavor flavor
 )
 {
     CommandLineExporter* exporter = new CommandLineExporter(name);
+    exporter->setMarkdownFlavor(flavor);
     exporter->setSmartTypographyOnArgument("--smart");
     exporter->setHtmlRenderCommand(QString("pandoc %1 -f %2 -t html")
         .arg(CommandLineExporter::SMART_TYPOGRAPHY_ARG)
@@ -354,3 +371,67 @@ void ExporterFactory::addPandocExporter
     fileExporters.append(exporter);
     htmlExporters.append(exporter);
 }
+
+void ExporterFactory::loadPlugins()
+{
+    QStringList exporterNames;
+
+    foreach (Exporter* exporter, fileExporters)
+    {
+        exporterNames.append(exporter->getName());
+    }
+
+    foreach (const QString& path, AppSettings::getInstance()->getPluginPaths())
+    {
+        QDir pluginDir(path);
+
+        if (!pluginDir.exists())
+        {
+            continue;
+        }
+
+        foreach (const QString& fileName, pluginDir.entryList(QDir::Files))
+        {
+            QString filePath = pluginDir.absoluteFilePath(fileName);
+
+            if (!QLibrary::isLibrary(filePath))
+            {
+                continue;
+            }
+
+            // The plugin loader is deliberately not deleted, so that the
+            // plugin stays loaded for as long as the application runs.
+            //
+            QPluginLoader* loader = new QPluginLoader(filePath);
+            ExporterPlugin* plugin =
+                qobject_cast<ExporterPlugin*>(loader->instance());
+
+            if (NULL == plugin)
+            {
+                qWarning() << "Could not load exporter plugin" << filePath
+                    << loader->errorString();
+                loader->unload();
+                delete loader;
+                continue;
+            }
+
+            // Plugins in the user's directory take precedence over those
+            // installed with the application, since they are searched first.
+            //
+            if (exporterNames.contains(plugin->name()))
+            {
+                qWarning() << "Skipping exporter plugin" << filePath
+                    << "since an exporter named" << plugin->name()
+                    << "already exists";
+                loader->unload();
+                delete loader;
+                continue;
+            }
+
+            PluginExporter* exporter = new PluginExporter(plugin);
+            exporterNames.append(exporter->getName());
+            fileExporters.append(exporter);
+            htmlExporters.append(exporter);
+        }
+    }
+}
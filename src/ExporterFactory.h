@@ -87,14 +87,22 @@ class ExporterFactory
          * each one (i.e., for Pandoc GitHub Flavored Markdown, Pandoc Strict,
          * Pandoc CommonMark, etc.).  The inputFormat parameter specifies
          * the argument to be passed to the -f option--for example,
-         * markdown, markdown_mmd, etc.
+         * markdown, markdown_mmd, etc.  The flavor parameter specifies the
+         * syntax that the input format supports, for highlighting.
          */
         void addPandocExporter
         (
             const QString& name,
-            const QString& inputFormat
+            const QString& inputFormat,
+            MarkdownFlavor flavor
         );
 
+        /*
+         * Loads the exporter plugins found in the plugin directories, and
+         * adds an exporter for each one whose name is not already taken by
+         * another exporter.
+         */
+        void loadPlugins();
 
 };
 
@@ -0,0 +1,90 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef EXPORTERPLUGIN_H
+#define EXPORTERPLUGIN_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtPlugin>
+
+#include "MarkdownFlavor.h"
+
+/**
+ * Interface for Markdown processors that are loaded as plugins, so that
+ * they can render HTML within the application's process instead of being
+ * run as separate programs for every preview refresh.
+ *
+ * Plugins implement this interface in a QObject subclass that declares it
+ * with Q_INTERFACES(ExporterPlugin), and export that class with
+ * Q_PLUGIN_METADATA(IID GW_EXPORTER_PLUGIN_IID) in Qt 5, or with
+ * Q_EXPORT_PLUGIN2() in Qt 4.  The interface only depends on this header
+ * and on Qt, so that plugins need not link against the application.  The
+ * plugin library is then placed in one of the plugin directories searched
+ * by the ExporterFactory.
+ */
+class ExporterPlugin
+{
+    public:
+        virtual ~ExporterPlugin()
+        {
+            ;
+        }
+
+        /**
+         * Returns the name of the exporter, as shown to the user.  The name
+         * should be unique among the exporters of the application.
+         */
+        virtual QString name() const = 0;
+
+        /**
+         * Returns the Markdown flavor that the processor reads, so that the
+         * editor can highlight the syntax that the processor supports.
+         */
+        virtual MarkdownFlavor markdownFlavor() const = 0;
+
+        /**
+         * Returns true if renderHtml() may be called from several threads at
+         * once, such as for the live preview and a file export at the same
+         * time.  Otherwise, the application never calls renderHtml() from
+         * more than one thread at a time.
+         */
+        virtual bool isThreadSafe() const = 0;
+
+        /**
+         * Renders the given UTF-8 encoded Markdown text into the given
+         * buffer as a UTF-8 encoded HTML fragment, with smart typography (such
+         * as curly quotation marks) if so requested.  Processors that do not
+         * support smart typography may ignore the request.  Returns false and sets err to an
+         * error message if rendering fails.
+         */
+        virtual bool renderHtml
+        (
+            const QByteArray& markdown,
+            bool smartTypography,
+            QByteArray& html,
+            QString& err
+        ) = 0;
+};
+
+#define GW_EXPORTER_PLUGIN_IID "com.github.wereturtle.ghostwriter.ExporterPlugin/1.0"
+
+Q_DECLARE_INTERFACE(ExporterPlugin, GW_EXPORTER_PLUGIN_IID)
+
+#endif // EXPORTERPLUGIN_H
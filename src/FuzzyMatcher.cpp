@@ -0,0 +1,516 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <algorithm>
+#include <functional>
+
+#include "FuzzyMatcher.h"
+
+// Score for each matched character, and bonuses for matched characters at
+// the start of the candidate, at the start of a word, at a lower-case to
+// upper-case transition, and immediately following the previous match.
+//
+#define GW_FUZZY_SCORE_MATCH 16
+#define GW_FUZZY_BONUS_FIRST_CHARACTER 12
+#define GW_FUZZY_BONUS_WORD_START 10
+#define GW_FUZZY_BONUS_CAMEL_CASE 8
+#define GW_FUZZY_BONUS_CONSECUTIVE 6
+
+// Penalty for each unmatched character between the first and last matched
+// characters.
+//
+#define GW_FUZZY_PENALTY_GAP 1
+
+// Number of characters compared at once when searching a candidate for the
+// next query character.  Eight UTF-16 characters fill a 128-bit vector
+// register.
+//
+#define GW_FUZZY_SEARCH_BATCH 8
+
+namespace
+{
+    // Packs a match into a single number that is greater for better
+    // matches, so that ranking the matches takes plain integer comparisons.
+    // Of two matches with the same score, the one added first is better.
+    //
+    quint64 matchKey(int index, int score)
+    {
+        return (((quint64) score) << 32) | (quint32) ~index;
+    }
+
+    // Returns the position of the first occurrence of the given character
+    // in text from the given position on, or length if there is none.  The
+    // characters are compared in batches without branching, so that the
+    // compiler can turn each batch into a single vector comparison, and
+    // only the batch containing the character is searched one by one.
+    //
+    int findCharacter(const ushort* text, int from, int length, ushort c)
+    {
+        int i = from;
+
+        while ((i + GW_FUZZY_SEARCH_BATCH) <= length)
+        {
+            int found = 0;
+
+            for (int k = 0; k < GW_FUZZY_SEARCH_BATCH; k++)
+            {
+                found |= (text[i + k] == c);
+            }
+
+            if (found)
+            {
+                break;
+            }
+
+            i += GW_FUZZY_SEARCH_BATCH;
+        }
+
+        while ((i < length) && (text[i] != c))
+        {
+            i++;
+        }
+
+        return i;
+    }
+}
+
+FuzzyMatcher::FuzzyMatcher()
+    : previousMatchesValid(false)
+{
+    offsets.append(0);
+}
+
+FuzzyMatcher::~FuzzyMatcher()
+{
+
+}
+
+int FuzzyMatcher::addCandidate(const QString& text)
+{
+    quint64 mask = 0;
+    quint64 bonusMask = 0;
+    QChar previous;
+
+    for (int i = 0; i < text.length(); i++)
+    {
+        QChar c = text[i];
+        ushort folded = c.toCaseFolded().unicode();
+        uchar bonus = 0;
+
+        if (0 == i)
+        {
+            bonus = GW_FUZZY_BONUS_FIRST_CHARACTER;
+        }
+        else if (c.isLetterOrNumber() && !previous.isLetterOrNumber())
+        {
+            bonus = GW_FUZZY_BONUS_WORD_START;
+        }
+        else if (c.isUpper() && previous.isLower())
+        {
+            bonus = GW_FUZZY_BONUS_CAMEL_CASE;
+        }
+
+        characters.append(folded);
+        bonuses.append(bonus);
+        mask |= characterMask(folded);
+
+        if (bonus > 0)
+        {
+            bonusMask |= characterMask(folded);
+        }
+        previous = c;
+    }
+
+    offsets.append(characters.size());
+    masks.append(mask);
+    bonusMasks.append(bonusMask);
+    previousMatchesValid = false;
+
+    return masks.size() - 1;
+}
+
+int FuzzyMatcher::count() const
+{
+    return masks.size();
+}
+
+void FuzzyMatcher::clear()
+{
+    characters.clear();
+    bonuses.clear();
+    offsets.clear();
+    offsets.append(0);
+    masks.clear();
+    bonusMasks.clear();
+    previousMatches.clear();
+    previousMatchLengths.clear();
+    previousMatchEnds.clear();
+    previousMatchesValid = false;
+}
+
+QVector<FuzzyMatcher::Match> FuzzyMatcher::match
+(
+    const QString& query,
+    int maxResults
+) const
+{
+    QVector<ushort> foldedQuery;
+    QVector<quint64> queryCharacterMasks;
+    quint64 queryMask = 0;
+
+    foldedQuery.reserve(query.length());
+    queryCharacterMasks.reserve(query.length());
+
+    for (int i = 0; i < query.length(); i++)
+    {
+        if (!query[i].isSpace())
+        {
+            ushort folded = query[i].toCaseFolded().unicode();
+            foldedQuery.append(folded);
+            queryCharacterMasks.append(characterMask(folded));
+            queryMask |= characterMask(folded);
+        }
+    }
+
+    QVector<Match> matches;
+
+    if (maxResults <= 0)
+    {
+        return matches;
+    }
+
+    const ushort* queryData = foldedQuery.constData();
+    int queryLength = foldedQuery.size();
+
+    // Highest score possible for the query, not counting the bonuses for
+    // where the characters fall in the candidate, and the most each query
+    // character could add to that if it earns a bonus.  Only the first
+    // query character can match the first character of a candidate, and a
+    // word start cannot follow a match of a letter or number, so it gives
+    // up the bonus for following the previous match.
+    //
+    int baseBound = (queryLength * GW_FUZZY_SCORE_MATCH)
+        + (qMax(0, queryLength - 1) * GW_FUZZY_BONUS_CONSECUTIVE);
+    QVector<int> queryBonusBounds;
+
+    queryBonusBounds.reserve(queryLength);
+
+    for (int q = 0; q < queryLength; q++)
+    {
+        if (0 == q)
+        {
+            queryBonusBounds.append(GW_FUZZY_BONUS_FIRST_CHARACTER);
+        }
+        else if (QChar(queryData[q - 1]).isLetterOrNumber())
+        {
+            queryBonusBounds.append
+            (
+                qMax
+                (
+                    GW_FUZZY_BONUS_CAMEL_CASE,
+                    GW_FUZZY_BONUS_WORD_START - GW_FUZZY_BONUS_CONSECUTIVE
+                )
+            );
+        }
+        else
+        {
+            queryBonusBounds.append
+            (
+                qMax(GW_FUZZY_BONUS_CAMEL_CASE, GW_FUZZY_BONUS_WORD_START)
+            );
+        }
+    }
+
+    // As the user types more of a query, only the candidates that matched
+    // what they had typed so far can still match.  If the query was only
+    // added to at the end, the search for each candidate's match also picks
+    // up where it left off.
+    //
+    bool narrowing = narrowsPreviousQuery(foldedQuery);
+    int resumeLength = 0;
+
+    if
+    (
+        narrowing
+        && (queryLength >= previousQuery.size())
+        && std::equal(previousQuery.begin(), previousQuery.end(), foldedQuery.begin())
+    )
+    {
+        resumeLength = previousQuery.size();
+    }
+
+    int candidateCount = narrowing ? previousMatches.size() : masks.size();
+    const quint64* candidateMasks = masks.constData();
+    const quint64* candidateBonusMasks = bonusMasks.constData();
+    const int* previousIndices = previousMatches.constData();
+    const int* previousLengths = previousMatchLengths.constData();
+    const int* previousEnds = previousMatchEnds.constData();
+
+    // First, find where in the list of candidates those that have all of
+    // the query's characters are.  Each position is written out whether or
+    // not its candidate passes, and only counted if it does, since whether
+    // it passes is essentially random and branching on it would defeat the
+    // branch predictor.
+    //
+    QVector<int> positions(candidateCount);
+    int* position = positions.data();
+    int positionCount = 0;
+
+    if (narrowing)
+    {
+        for (int n = 0; n < candidateCount; n++)
+        {
+            position[positionCount] = n;
+            positionCount +=
+                ((candidateMasks[previousIndices[n]] & queryMask) == queryMask);
+        }
+    }
+    else
+    {
+        for (int n = 0; n < candidateCount; n++)
+        {
+            position[positionCount] = n;
+            positionCount += ((candidateMasks[n] & queryMask) == queryMask);
+        }
+    }
+
+    // Keys of the best matches so far, kept as a heap with the worst of
+    // them at the front, so that most matches are turned away with a
+    // single comparison.
+    //
+    QVector<quint64> best;
+    best.reserve(maxResults);
+
+    // Then score those candidates, keeping the ones that may still match
+    // for the next query.
+    //
+    QVector<int> survivors(positionCount);
+    QVector<int> survivorLengths(positionCount);
+    QVector<int> survivorEnds(positionCount);
+    int* indices = survivors.data();
+    int* lengths = survivorLengths.data();
+    int* ends = survivorEnds.data();
+    int survivorCount = 0;
+
+    for (int p = 0; p < positionCount; p++)
+    {
+        int n = position[p];
+        int i = narrowing ? previousIndices[n] : n;
+        int matchedLength = 0;
+        int end = -1;
+
+        if (resumeLength > 0)
+        {
+            matchedLength = previousLengths[n];
+            end = previousEnds[n];
+        }
+
+        // Once there are enough results, pass over the candidates that
+        // could not beat the worst of them even if each query character
+        // earned the most it could wherever the candidate has a bonus for
+        // it.  They may still match, so keep them for the next query along
+        // with however far the search for them has got.
+        //
+        if (best.size() >= maxResults)
+        {
+            int bound = baseBound;
+
+            for (int q = 0; q < queryLength; q++)
+            {
+                bound += queryBonusBounds[q]
+                    * (0 != (candidateBonusMasks[i] & queryCharacterMasks[q]));
+            }
+
+            if (matchKey(i, bound) < best.first())
+            {
+                indices[survivorCount] = i;
+                lengths[survivorCount] = matchedLength;
+                ends[survivorCount] = end;
+                survivorCount++;
+                continue;
+            }
+        }
+
+        if (!findMatchEnd(i, queryData, queryLength, matchedLength, end))
+        {
+            continue;
+        }
+
+        indices[survivorCount] = i;
+        lengths[survivorCount] = queryLength;
+        ends[survivorCount] = end;
+        survivorCount++;
+
+        quint64 key = matchKey(i, score(i, queryData, queryLength, end));
+
+        if (best.size() < maxResults)
+        {
+            best.append(key);
+            std::push_heap(best.begin(), best.end(), std::greater<quint64>());
+        }
+        else if (key > best.first())
+        {
+            std::pop_heap(best.begin(), best.end(), std::greater<quint64>());
+            best.last() = key;
+            std::push_heap(best.begin(), best.end(), std::greater<quint64>());
+        }
+    }
+
+    survivors.resize(survivorCount);
+    survivorLengths.resize(survivorCount);
+    survivorEnds.resize(survivorCount);
+
+    previousQuery = foldedQuery;
+    previousMatches = survivors;
+    previousMatchLengths = survivorLengths;
+    previousMatchEnds = survivorEnds;
+    previousMatchesValid = true;
+
+    std::sort(best.begin(), best.end(), std::greater<quint64>());
+    matches.reserve(best.size());
+
+    for (int i = 0; i < best.size(); i++)
+    {
+        Match match;
+        match.index = ~((quint32) best[i]);
+        match.score = (int) (best[i] >> 32);
+        matches.append(match);
+    }
+
+    return matches;
+}
+
+bool FuzzyMatcher::narrowsPreviousQuery(const QVector<ushort>& query) const
+{
+    if (!previousMatchesValid || previousQuery.isEmpty())
+    {
+        return false;
+    }
+
+    int previousIndex = 0;
+
+    for (int i = 0; (i < query.size()) && (previousIndex < previousQuery.size()); i++)
+    {
+        if (query[i] == previousQuery[previousIndex])
+        {
+            previousIndex++;
+        }
+    }
+
+    return previousIndex == previousQuery.size();
+}
+
+bool FuzzyMatcher::findMatchEnd
+(
+    int index,
+    const ushort* query,
+    int queryLength,
+    int matchedLength,
+    int& end
+) const
+{
+    const ushort* text = characters.constData() + offsets[index];
+    int length = offsets[index + 1] - offsets[index];
+
+    for (int queryIndex = matchedLength; queryIndex < queryLength; queryIndex++)
+    {
+        end = findCharacter(text, end + 1, length, query[queryIndex]);
+
+        if (end >= length)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int FuzzyMatcher::score
+(
+    int index,
+    const ushort* query,
+    int queryLength,
+    int end
+) const
+{
+    if (0 == queryLength)
+    {
+        return 0;
+    }
+
+    const ushort* text = characters.constData() + offsets[index];
+    const uchar* bonus = bonuses.constData() + offsets[index];
+
+    // Scan backwards from the end to find the shortest match ending there,
+    // so that a stray early occurrence of the first query character does
+    // not spread the match out.
+    //
+    int start = end + 1;
+    int queryIndex = queryLength - 1;
+
+    while (queryIndex >= 0)
+    {
+        start--;
+
+        if (text[start] == query[queryIndex])
+        {
+            queryIndex--;
+        }
+    }
+
+    // The matched characters score the same whether or not they follow the
+    // previous match, with the bonus added by multiplying rather than by
+    // branching, since which way that goes is essentially random and would
+    // defeat the branch predictor.
+    //
+    int total = 0;
+    int previousHit = 0;
+    queryIndex = 0;
+
+    for (int i = start; (i <= end) && (queryIndex < queryLength); i++)
+    {
+        int hit = (text[i] == query[queryIndex]);
+
+        total += hit
+            * (GW_FUZZY_SCORE_MATCH + bonus[i] + (previousHit * GW_FUZZY_BONUS_CONSECUTIVE));
+        previousHit = hit;
+        queryIndex += hit;
+    }
+
+    total -= ((end - start + 1) - queryLength) * GW_FUZZY_PENALTY_GAP;
+
+    return qMax(0, total);
+}
+
+quint64 FuzzyMatcher::characterMask(ushort c)
+{
+    if ((c >= 'a') && (c <= 'z'))
+    {
+        return Q_UINT64_C(1) << (c - 'a');
+    }
+
+    if ((c >= '0') && (c <= '9'))
+    {
+        return Q_UINT64_C(1) << (26 + (c - '0'));
+    }
+
+    // All other characters share the remaining bits.
+    return Q_UINT64_C(1) << (36 + (c % 28));
+}
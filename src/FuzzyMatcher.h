@@ -0,0 +1,140 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef FUZZYMATCHER_H
+#define FUZZYMATCHER_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * Matches a query against a list of candidate strings, such as for a
+ * quick-jump palette, where the characters of the query must appear in the
+ * candidate in the same order but not necessarily next to each other.
+ * Matches are scored higher when the query characters are consecutive or
+ * fall at the start of words.  Matching is case-insensitive, and white
+ * space in the query is ignored.
+ *
+ * Candidates are stored case-folded in flat arrays, together with a bit
+ * mask of the characters each one contains and the word-start bonus of each
+ * character, so that matching is a tight loop over contiguous memory.  The
+ * bit masks allow most candidates to be rejected without looking at their
+ * text at all, and, once enough good matches have been found, most of the
+ * rest to be passed over because they could not score high enough to make
+ * it into the results.  The matcher also remembers which candidates matched
+ * the previous query and how far into each one the search got, so that as
+ * the user types more of a query, only those candidates are matched again,
+ * picking up where the search left off.  Only the best results are kept in
+ * order, so the cost of ranking grows with the number of results asked for
+ * rather than with the number of matches.
+ *
+ * Because of the remembered matches, a matcher must not be used from more
+ * than one thread at a time.
+ */
+class FuzzyMatcher
+{
+    public:
+        /**
+         * A matching candidate, identified by the index at which it was
+         * added, along with its score.
+         */
+        struct Match
+        {
+            int index;
+            int score;
+        };
+
+        /**
+         * Constructor.
+         */
+        FuzzyMatcher();
+
+        /**
+         * Destructor.
+         */
+        ~FuzzyMatcher();
+
+        /**
+         * Adds a candidate string, and returns its index.
+         */
+        int addCandidate(const QString& text);
+
+        /**
+         * Returns the number of candidates.
+         */
+        int count() const;
+
+        /**
+         * Removes all candidates.
+         */
+        void clear();
+
+        /**
+         * Returns up to maxResults candidates that match the given query,
+         * best matches first.  Candidates with equal scores are returned
+         * in the order in which they were added.  An empty query matches
+         * every candidate.
+         */
+        QVector<Match> match(const QString& query, int maxResults) const;
+
+    private:
+        // Case-folded characters and per-character bonuses of all the
+        // candidates, one after another.  Candidate i occupies the range
+        // [offsets[i], offsets[i + 1]).
+        //
+        QVector<ushort> characters;
+        QVector<uchar> bonuses;
+        QVector<int> offsets;
+        QVector<quint64> masks;
+
+        // Bit mask of the characters that earn a bonus in each candidate,
+        // from which an upper bound of its score is worked out without
+        // looking at its text.
+        //
+        QVector<quint64> bonusMasks;
+
+        // Case-folded previous query, and the indices of the candidates
+        // that may have matched it, along with how many of its characters
+        // were found in each candidate so far and where the earliest match
+        // of those characters ended (-1 if none were looked for).  Every
+        // candidate that matches a query also matches any query made of a
+        // subsequence of its characters.
+        //
+        mutable QVector<ushort> previousQuery;
+        mutable QVector<int> previousMatches;
+        mutable QVector<int> previousMatchLengths;
+        mutable QVector<int> previousMatchEnds;
+        mutable bool previousMatchesValid;
+
+        bool narrowsPreviousQuery(const QVector<ushort>& query) const;
+        bool findMatchEnd
+        (
+            int index,
+            const ushort* query,
+            int queryLength,
+            int matchedLength,
+            int& end
+        ) const;
+        int score(int index, const ushort* query, int queryLength, int end) const;
+
+        static quint64 characterMask(ushort c);
+};
+
+#endif // FUZZYMATCHER_H
@@ -0,0 +1,280 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <stdio.h>
+#include <algorithm>
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegExp>
+#include <QSet>
+#include <QTextStream>
+
+#include "FuzzyMatcherHarness.h"
+#include "FuzzyMatcher.h"
+#include "QuickJumpPalette.h"
+
+// Number of candidates to match against.  Candidates are made up from the
+// corpus words until there are this many.  This is ten times the headings
+// of the 2,000-heading documents the quick jump palette is meant for, with
+// room to spare for recent files and commands.  Made up candidates are
+// built from only a few words, so thousands of them tie for the best score
+// on common keystrokes, and latency grows with their number from there on.
+//
+#define GW_FUZZY_BENCHMARK_CANDIDATES 20000
+
+// Number of queries to type.  After each keystroke, as many results are
+// asked for as the quick jump palette shows.
+//
+#define GW_FUZZY_BENCHMARK_QUERIES 200
+
+// Budget in milliseconds for matching a keystroke, which the 95th
+// percentile of the latency must not exceed.
+//
+#define GW_FUZZY_BENCHMARK_BUDGET 1.0
+
+// Words from which to make up candidates when no corpus is given.
+#define GW_FUZZY_BENCHMARK_WORDS \
+    "chapter notes draft index summary introduction readme todo ideas " \
+    "outline research meeting project journal archive review design plan " \
+    "report letter story scene character world magic history recipe " \
+    "travel budget invoice"
+
+FuzzyMatcherHarness::FuzzyMatcherHarness(const QStringList& corpusPaths)
+    : corpusPaths(corpusPaths)
+{
+    ;
+}
+
+FuzzyMatcherHarness::~FuzzyMatcherHarness()
+{
+    ;
+}
+
+int FuzzyMatcherHarness::run()
+{
+    QTextStream out(stdout);
+    QStringList words;
+    QStringList candidates = readCandidates(words);
+
+    if (words.isEmpty())
+    {
+        words = QString(GW_FUZZY_BENCHMARK_WORDS).split(' ', QString::SkipEmptyParts);
+    }
+
+    // Make up the rest of the candidates as file paths and headings of a
+    // few words each, so that there are many near misses for every query.
+    // The seed is fixed so that runs can be compared.
+    //
+    qsrand(1);
+
+    while (candidates.size() < GW_FUZZY_BENCHMARK_CANDIDATES)
+    {
+        QString candidate;
+        int wordCount = 2 + (qrand() % 4);
+
+        for (int i = 0; i < wordCount; i++)
+        {
+            QString word = words[qrand() % words.size()];
+
+            if (0 == (qrand() % 3))
+            {
+                word[0] = word[0].toUpper();
+            }
+
+            if (i > 0)
+            {
+                candidate += (0 == (qrand() % 2)) ? "/" : " ";
+            }
+
+            candidate += word;
+        }
+
+        candidates.append(candidate + QString(" %1.md").arg(qrand() % 1000));
+    }
+
+    FuzzyMatcher matcher;
+
+    foreach (const QString& candidate, candidates)
+    {
+        matcher.addCandidate(candidate);
+    }
+
+    QStringList queries;
+
+    for (int i = 0; i < GW_FUZZY_BENCHMARK_QUERIES; i++)
+    {
+        QString query = words[qrand() % words.size()];
+
+        if (0 == (i % 2))
+        {
+            query += " " + words[qrand() % words.size()].left(3);
+        }
+
+        queries.append(query);
+    }
+
+    QVector<double> firstKeystrokeTimes;
+    QVector<double> keystrokeTimes;
+    QElapsedTimer timer;
+
+    foreach (const QString& query, queries)
+    {
+        // The palette matches the empty query when it opens.
+        matcher.match(QString(), GW_QUICK_JUMP_MAX_RESULTS);
+
+        for (int length = 1; length <= query.length(); length++)
+        {
+            timer.start();
+            matcher.match(query.left(length), GW_QUICK_JUMP_MAX_RESULTS);
+            double elapsed = timer.nsecsElapsed() / 1000000.0;
+
+            keystrokeTimes.append(elapsed);
+
+            if (1 == length)
+            {
+                firstKeystrokeTimes.append(elapsed);
+            }
+        }
+    }
+
+    std::sort(firstKeystrokeTimes.begin(), firstKeystrokeTimes.end());
+    std::sort(keystrokeTimes.begin(), keystrokeTimes.end());
+
+    out << "Candidates: " << matcher.count() << "\n"
+        << "Queries: " << queries.size() << "\n"
+        << "Keystrokes: " << keystrokeTimes.size() << "\n\n"
+        << QString("Latency (ms)").leftJustified(20)
+        << QString("p50").rightJustified(8)
+        << QString("p95").rightJustified(8)
+        << QString("p99").rightJustified(8)
+        << QString("max").rightJustified(8) << "\n";
+
+    QVector<double>* rows[] = { &firstKeystrokeTimes, &keystrokeTimes };
+    const char* rowNames[] = { "First keystroke", "All keystrokes" };
+
+    for (int i = 0; i < 2; i++)
+    {
+        out << QString(rowNames[i]).leftJustified(20)
+            << QString::number(percentile(*rows[i], 0.50), 'f', 3).rightJustified(8)
+            << QString::number(percentile(*rows[i], 0.95), 'f', 3).rightJustified(8)
+            << QString::number(percentile(*rows[i], 0.99), 'f', 3).rightJustified(8)
+            << QString::number(percentile(*rows[i], 1.0), 'f', 3).rightJustified(8)
+            << "\n";
+    }
+
+    bool withinBudget = percentile(keystrokeTimes, 0.95) <= GW_FUZZY_BENCHMARK_BUDGET;
+
+    out << "\nBudget: " << GW_FUZZY_BENCHMARK_BUDGET << " ms at p95 of all keystrokes: "
+        << (withinBudget ? "met" : "NOT MET") << "\n";
+    out.flush();
+
+    return withinBudget ? 0 : 1;
+}
+
+QStringList FuzzyMatcherHarness::findCorpusFiles() const
+{
+    QStringList corpusFilePaths;
+    QStringList nameFilters;
+    nameFilters << "*.md" << "*.markdown" << "*.mdown" << "*.mkd" << "*.txt";
+
+    foreach (QString path, corpusPaths)
+    {
+        QFileInfo info(path);
+
+        if (info.isDir())
+        {
+            QDir dir(path);
+
+            foreach (QString fileName, dir.entryList(nameFilters, QDir::Files, QDir::Name))
+            {
+                corpusFilePaths.append(dir.filePath(fileName));
+            }
+        }
+        else if (info.isFile())
+        {
+            corpusFilePaths.append(path);
+        }
+    }
+
+    return corpusFilePaths;
+}
+
+/*
+ * Returns the file names and headings of the corpus documents as
+ * candidates, and adds the words of the documents to the given list.
+ */
+QStringList FuzzyMatcherHarness::readCandidates(QStringList& words) const
+{
+    QStringList candidates;
+    QSet<QString> uniqueWords;
+    QRegExp headingPrefix("^#+\\s*");
+    QRegExp wordSeparator("[^\\w]+");
+
+    foreach (QString filePath, findCorpusFiles())
+    {
+        QFile file(filePath);
+
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            continue;
+        }
+
+        QTextStream in(&file);
+        in.setCodec("UTF-8");
+        QString text = in.readAll();
+        file.close();
+
+        candidates.append(QFileInfo(filePath).fileName());
+
+        foreach (QString line, text.split('\n'))
+        {
+            if (line.startsWith('#'))
+            {
+                candidates.append(line.remove(headingPrefix).trimmed());
+            }
+        }
+
+        foreach (QString word, text.split(wordSeparator, QString::SkipEmptyParts))
+        {
+            if (word.length() >= 3)
+            {
+                uniqueWords.insert(word.toLower());
+            }
+        }
+    }
+
+    words = uniqueWords.toList();
+    std::sort(words.begin(), words.end());
+
+    return candidates;
+}
+
+double FuzzyMatcherHarness::percentile(const QVector<double>& sortedTimes, double fraction)
+{
+    if (sortedTimes.isEmpty())
+    {
+        return 0.0;
+    }
+
+    int index = qBound(0, (int) (fraction * sortedTimes.size()), sortedTimes.size() - 1);
+    return sortedTimes[index];
+}
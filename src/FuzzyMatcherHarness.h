@@ -0,0 +1,71 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef FUZZYMATCHERHARNESS_H
+#define FUZZYMATCHERHARNESS_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/*
+ * Command line argument that launches ghostwriter as the quick jump palette
+ * benchmark rather than as an editor.  The arguments that follow it are
+ * optional Markdown files, or directories of Markdown files, whose file
+ * names, headings and words are used to make up the candidates.
+ */
+#define GW_FUZZY_BENCHMARK_ARG "--fuzzy-benchmark"
+
+/**
+ * Measures how long the FuzzyMatcher takes to match each keystroke of
+ * queries typed into the quick jump palette, against a large list of
+ * candidates, and checks the latency against the budget for keeping up
+ * with typing.
+ */
+class FuzzyMatcherHarness
+{
+    public:
+        /**
+         * Constructor.  Takes the Markdown files, or directories of Markdown
+         * files, from which to make up the candidates as a parameter.
+         */
+        FuzzyMatcherHarness(const QStringList& corpusPaths);
+
+        /**
+         * Destructor.
+         */
+        ~FuzzyMatcherHarness();
+
+        /**
+         * Types each query one character at a time, matching after every
+         * keystroke, and writes the latency percentiles to standard output.
+         * Returns the process exit code, which is non-zero if the latency
+         * is over budget.
+         */
+        int run();
+
+    private:
+        QStringList corpusPaths;
+
+        QStringList findCorpusFiles() const;
+        QStringList readCandidates(QStringList& words) const;
+        static double percentile(const QVector<double>& sortedTimes, double fraction);
+};
+
+#endif // FUZZYMATCHERHARNESS_H
@@ -20,6 +20,7 @@
 #include <QVariant>
 #include <QFileDialog>
 #include <QFile>
+#include <QFileInfo>
 #include <QTextStream>
 #include <QString>
 #include <QStatusBar>
@@ -32,11 +33,16 @@
 #include <QDir>
 #include <QDesktopServices>
 #include <QAction>
-#include <QtConcurrentRun>
 #include <QFuture>
 #include <QSettings>
 #include <QPrinter>
 #include <QDesktopWidget>
+#include <QLabel>
+#include <QShowEvent>
+
+#if QT_VERSION >= 0x050000
+#include <QWindow>
+#endif
 
 #include "HtmlPreview.h"
 #include "Exporter.h"
@@ -44,17 +50,29 @@
 #include "ExportDialog.h"
 #include "MessageBoxHelper.h"
 #include "StyleSheetManagerDialog.h"
+#include "RemotePreviewRenderer.h"
+#include "AppSettings.h"
+#include "TaskScheduler.h"
 
 #define GW_CUSTOM_STYLE_SHEETS_KEY "Preview/customStyleSheets"
-#define GW_LAST_USED_STYLE_SHEET_KEY "Preview/lastUsedStyleSheet"
 #define GW_LAST_USED_EXPORTER_KEY "Preview/lastUsedExporter"
 
+// Time in milliseconds to wait after the last change to a custom style
+// sheet before reloading it.
+//
+#define GW_STYLE_SHEET_RELOAD_DELAY 100
+
 HtmlPreview::HtmlPreview
 (
     TextDocument* document,
     QWidget* parent
 )
-    : QMainWindow(parent), document(document), handlingStyleSheetChange(false)
+    : QMainWindow(parent),
+    remoteRenderer(NULL),
+    remoteRendererWidget(NULL),
+    document(document),
+    handlingStyleSheetChange(false),
+    loadingTimingsPending(false)
 {
     QSettings settings;
     QString currentCssFile =
@@ -64,7 +82,9 @@ HtmlPreview::HtmlPreview
     customCssFiles =
         settings.value(GW_CUSTOM_STYLE_SHEETS_KEY, QStringList()).toStringList();
 
-    htmlBrowser = new QWebView(this);
+    previewStack = new QStackedWidget(this);
+    htmlBrowser = new QWebView(previewStack);
+    previewStack->addWidget(htmlBrowser);
     htmlBrowser->settings()->setDefaultTextEncoding("utf-8");
 
     setWindowTitle(tr("HTML Preview"));
@@ -77,8 +97,7 @@ HtmlPreview::HtmlPreview
     htmlBrowser->page()->action(QWebPage::OpenLink)->setVisible(false);
     htmlBrowser->page()->action(QWebPage::OpenLinkInNewWindow)->setVisible(false);
     connect(htmlBrowser, SIGNAL(linkClicked(QUrl)), this, SLOT(onLinkClicked(QUrl)));
-    headingTagExp.setMinimal(true);
-    headingTagExp.setPattern("[Hh][1-6]");
+    connect(htmlBrowser, SIGNAL(loadFinished(bool)), this, SLOT(onLoadFinished(bool)));
 
     this->statusBar()->setSizeGripEnabled(false);
 
@@ -96,7 +115,7 @@ HtmlPreview::HtmlPreview
         ;
     this->statusBar()->setStyleSheet(styleSheet);
 
-    defaultStyleSheets.append(":/resources/github.css");
+    defaultStyleSheets.append(GW_DEFAULT_STYLE_SHEET);
 
     QPushButton* copyHtmlButton = new QPushButton(tr("Copy HTML"));
     copyHtmlButton->setFocusPolicy(Qt::NoFocus);
@@ -183,10 +202,20 @@ HtmlPreview::HtmlPreview
     connect(styleSheetComboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(changeStyleSheet(int)));
     this->statusBar()->addWidget(styleSheetComboBox);
 
-    this->setCentralWidget(htmlBrowser);
+    this->setCentralWidget(previewStack);
 
-    futureWatcher = new QFutureWatcher<QString>(this);
+    futureWatcher = new QFutureWatcher<RenderedHtml>(this);
     this->connect(futureWatcher, SIGNAL(finished()), SLOT(onHtmlReady()));
+
+    styleSheetWatcher = new QFileSystemWatcher(this);
+    this->connect(styleSheetWatcher, SIGNAL(fileChanged(QString)), SLOT(onStyleSheetFileChanged(QString)));
+    this->connect(styleSheetWatcher, SIGNAL(directoryChanged(QString)), SLOT(onStyleSheetDirectoryChanged(QString)));
+
+    styleSheetReloadTimer = new QTimer(this);
+    styleSheetReloadTimer->setSingleShot(true);
+    styleSheetReloadTimer->setInterval(GW_STYLE_SHEET_RELOAD_DELAY);
+    this->connect(styleSheetReloadTimer, SIGNAL(timeout()), SLOT(reloadStyleSheet()));
+
     this->changeStyleSheet(cssIndex);
 
     this->connect(document, SIGNAL(filePathChanged()), SLOT(updateBaseDir()));
@@ -204,10 +233,16 @@ HtmlPreview::HtmlPreview
     // Don't want to affect image size, only text size.
     htmlBrowser->settings()->setAttribute(QWebSettings::ZoomTextOnly, true);
     htmlBrowser->setZoomFactor((horizontalDpi / 96.0));
+
+    setRemoteRenderingEnabled(AppSettings::getInstance()->getRemotePreviewRenderingEnabled());
+
+    MemoryAccounting::getInstance()->addAccountable(this);
 }
 
 HtmlPreview::~HtmlPreview()
 {
+    MemoryAccounting::getInstance()->removeAccountable(this);
+
     QSettings settings;
 
     // Store the selected exporter name.
@@ -253,6 +288,7 @@ HtmlPreview::~HtmlPreview()
 
     // Wait for thread to finish if in the middle of updating the preview.
     futureWatcher->waitForFinished();
+    TaskScheduler::getInstance()->forgetRevision(this);
 }
 
 void HtmlPreview::updatePreview()
@@ -270,16 +306,27 @@ void HtmlPreview::updatePreview()
         else if (NULL != exporter)
         {
             QString text = document->toPlainText();
+            PreviewTimings timings;
+            timings.snapshotTaken = PreviewTimings::now();
 
             if (!text.isNull() && !text.isEmpty())
             {
-                QFuture<QString> future =
-                    QtConcurrent::run
+                // Only the latest revision of the document is of any
+                // interest, so supersede any render still in the queue.
+                //
+                TaskOptions options(TaskPriorityNormal);
+                options.revisionKey = this;
+                options.revision = document->revision();
+
+                QFuture<RenderedHtml> future =
+                    TaskScheduler::getInstance()->run
                     (
+                        options,
                         this,
                         &HtmlPreview::exportToHtml,
-                        document->toPlainText(),
-                        exporter
+                        text,
+                        exporter,
+                        timings
                     );
                 futureWatcher->setFuture(future);
             }
@@ -290,12 +337,84 @@ void HtmlPreview::updatePreview()
 void HtmlPreview::navigateToHeading(int headingSequenceNumber)
 {
     QString anchor = QString("livepreviewhnbr%1").arg(headingSequenceNumber);
-    this->htmlBrowser->page()->mainFrame()->scrollToAnchor(anchor);
+
+    if (NULL != remoteRenderer)
+    {
+        remoteRenderer->scrollToAnchor(anchor);
+    }
+    else
+    {
+        this->htmlBrowser->page()->mainFrame()->scrollToAnchor(anchor);
+    }
+}
+
+void HtmlPreview::setRemoteRenderingEnabled(bool enabled)
+{
+    if (enabled == (NULL != remoteRenderer))
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        remoteRenderer = new RemotePreviewRenderer(this);
+        remoteRenderer->setZoomFactor(htmlBrowser->zoomFactor());
+        remoteRenderer->setUserStyleSheetUrl(userStyleSheetUrl);
+        connect(remoteRenderer, SIGNAL(linkClicked(QUrl)), this, SLOT(onLinkClicked(QUrl)));
+        connect(remoteRenderer, SIGNAL(rendererWindowCreated(qulonglong)), this, SLOT(onRendererWindowCreated(qulonglong)));
+        remoteRenderer->start();
+
+#if QT_VERSION < 0x050000
+        // Foreign windows cannot be embedded, so the renderer displays its
+        // own top-level window alongside this one.
+        //
+        remoteRendererWidget = new QLabel(tr("The HTML preview is being "
+            "rendered in a separate window."), previewStack);
+        ((QLabel*) remoteRendererWidget)->setAlignment(Qt::AlignCenter);
+        previewStack->addWidget(remoteRendererWidget);
+        previewStack->setCurrentWidget(remoteRendererWidget);
+        remoteRenderer->setWindowVisible(this->isVisible());
+#endif
+
+        // Free the memory held by the in-process page.
+        htmlBrowser->setHtml("");
+
+        if (!html.isEmpty())
+        {
+            remoteRenderer->setContent(html.toUtf8(), baseUrl);
+        }
+    }
+    else
+    {
+        if (NULL != remoteRendererWidget)
+        {
+            previewStack->removeWidget(remoteRendererWidget);
+            delete remoteRendererWidget;
+            remoteRendererWidget = NULL;
+        }
+
+        delete remoteRenderer;
+        remoteRenderer = NULL;
+
+        previewStack->setCurrentWidget(htmlBrowser);
+        htmlBrowser->settings()->setUserStyleSheetUrl(userStyleSheetUrl);
+
+        QString currentHtml = html;
+        setHtml(currentHtml);
+    }
 }
 
 void HtmlPreview::onHtmlReady()
 {
-    QString html = futureWatcher->result();
+    if (futureWatcher->isCanceled())
+    {
+        return;
+    }
+
+    RenderedHtml result = futureWatcher->result();
+    QString html = result.html;
+    PreviewTimings timings = result.timings;
+    timings.htmlReceived = PreviewTimings::now();
 
     if (html == this->html)
     {
@@ -343,15 +462,52 @@ void HtmlPreview::onHtmlReady()
         newLine = newHtmlDoc.readLine();
     }
 
+    timings.diffFinished = PreviewTimings::now();
+
+    // The page may finish loading within setHtml(), so mark the timings as
+    // pending beforehand.
+    //
+    loadingTimings = timings;
+    loadingTimingsPending = (NULL == remoteRenderer);
+
     setHtml(anchoredHtml);
     this->html = html;
 
+    if (loadingTimingsPending && (0 == loadingTimings.contentSet))
+    {
+        loadingTimings.contentSet = PreviewTimings::now();
+    }
+}
+
+void HtmlPreview::onLoadFinished(bool ok)
+{
+    Q_UNUSED(ok);
+
+    if (!loadingTimingsPending)
+    {
+        return;
+    }
+
+    loadingTimingsPending = false;
+    loadingTimings.loadFinished = PreviewTimings::now();
+
+    if (0 == loadingTimings.contentSet)
+    {
+        loadingTimings.contentSet = loadingTimings.loadFinished;
+    }
+
+    emit previewUpdated(loadingTimings);
+}
+
+void HtmlPreview::anchorHeadings(QWebFrame* frame)
+{
+    QRegExp headingTagExp("[Hh][1-6]");
+
     // Traverse the DOM in the browser, and find all the H1-H6 tags.
     // Set the id attribute of each heading tag to have a unique
     // sequence number, so that when the navigateToHeading() slot
     // is triggered, we can scroll to the desired heading.
     //
-    QWebFrame* frame = htmlBrowser->page()->mainFrame();
     QWebElement element = frame->documentElement();
     QStack<QWebElement> elementStack;
     int headingId = 1;
@@ -399,13 +555,62 @@ void HtmlPreview::onHtmlReady()
     }
 }
 
+MarkdownFlavor HtmlPreview::getMarkdownFlavor() const
+{
+    if (NULL == exporter)
+    {
+        return MarkdownFlavorGitHub;
+    }
+
+    return exporter->getMarkdownFlavor();
+}
+
+QString HtmlPreview::getExporterName() const
+{
+    if (NULL == exporter)
+    {
+        return QString();
+    }
+
+    return exporter->getName();
+}
+
+bool HtmlPreview::selectExporter(const QString& name)
+{
+    int index = previewerComboBox->findText(name);
+
+    if (index < 0)
+    {
+        return false;
+    }
+
+    previewerComboBox->setCurrentIndex(index);
+    return true;
+}
+
+void HtmlPreview::accountMemory(QList<MemoryUsage>& usage) const
+{
+    // The HTML is kept here for diffing, and its UTF-8 encoding is handed
+    // to the page on each update.
+    //
+    qint64 bytes = (html.capacity() * sizeof(QChar)) + html.length();
+
+    usage.append(MemoryUsage(GW_MEMORY_HTML_PREVIEW, 1, bytes));
+}
+
 void HtmlPreview::onPreviewerChanged(int index)
 {
     QVariant exporterVariant = previewerComboBox->itemData(index);
+    MarkdownFlavor oldFlavor = getMarkdownFlavor();
 
     exporter = (Exporter*) exporterVariant.value<void*>();
     setHtml("");
     updatePreview();
+
+    if (getMarkdownFlavor() != oldFlavor)
+    {
+        emit markdownFlavorChanged(getMarkdownFlavor());
+    }
 }
 
 void HtmlPreview::changeStyleSheet(int index)
@@ -418,7 +623,7 @@ void HtmlPreview::changeStyleSheet(int index)
         return;
     }
 
-    bool previewUpdateNeeded = true;
+    bool styleSheetChangeNeeded = true;
 
     handlingStyleSheetChange = true;
 
@@ -472,14 +677,14 @@ void HtmlPreview::changeStyleSheet(int index)
 
                 if (styleSheet == oldSelection)
                 {
-                    previewUpdateNeeded = false;
+                    styleSheetChangeNeeded = false;
                     selectionIndex = i + 1;
                 }
             }
 
             // If the last selected style sheet was one of the default ones,
-            // and is still currently selected, then we don't need to update
-            // the preview again.
+            // and is still currently selected, then we don't need to apply
+            // the style sheet again.
             //
             if
             (
@@ -487,7 +692,7 @@ void HtmlPreview::changeStyleSheet(int index)
                 (selectionIndex < defaultStyleSheets.size())
             )
             {
-                previewUpdateNeeded = false;
+                styleSheetChangeNeeded = false;
             }
 
             styleSheetComboBox->setCurrentIndex(selectionIndex);
@@ -505,32 +710,119 @@ void HtmlPreview::changeStyleSheet(int index)
         filePath = styleSheetComboBox->itemData(index).toString();
     }
 
-    // Update the HTML preview with the newly selected style sheet, if needed.
-    if (previewUpdateNeeded)
+    // Apply the newly selected style sheet to the existing page, if needed.
+    // There is no need to re-render the HTML, since only the CSS changed.
+    //
+    if (styleSheetChangeNeeded)
     {
         if (selectionIndex >= defaultStyleSheets.size())
         {
-            htmlBrowser->settings()->setUserStyleSheetUrl
-            (
-                QUrl::fromLocalFile(filePath)
-            );
+            applyStyleSheet(filePath);
         }
         else
         {
-            htmlBrowser->settings()->setUserStyleSheetUrl
-            (
-                QUrl(QString("qrc") + defaultStyleSheets.at(selectionIndex))
-            );
+            applyStyleSheet(defaultStyleSheets.at(selectionIndex));
         }
+    }
 
-        setHtml("");
-        updatePreview();
+    // Remember the selection right away rather than on close, since the
+    // export dialog inlines it into self-contained HTML exports.
+    //
+    if (selectionIndex < (styleSheetComboBox->count() - 1))
+    {
+        QSettings settings;
+        settings.setValue
+        (
+            GW_LAST_USED_STYLE_SHEET_KEY,
+            styleSheetComboBox->itemData(selectionIndex).toString()
+        );
     }
 
     lastStyleSheetIndex = selectionIndex;
     handlingStyleSheetChange = false;
 }
 
+void HtmlPreview::onStyleSheetFileChanged(const QString& path)
+{
+    if (path != currentStyleSheetPath)
+    {
+        return;
+    }
+
+    // Editors often save a file in several steps, such as truncating it
+    // and then writing it, so wait for the changes to settle rather than
+    // reloading a half-written style sheet.
+    //
+    styleSheetReloadTimer->start();
+}
+
+void HtmlPreview::onStyleSheetDirectoryChanged(const QString& path)
+{
+    // Many text editors save by writing a new file and renaming it over the
+    // old one, in which case the watcher drops the file's path.  Once the
+    // new file is in place, reload it, which also watches it again.
+    //
+    if
+    (
+        currentStyleSheetPath.isEmpty() ||
+        currentStyleSheetPath.startsWith(":") ||
+        (QFileInfo(currentStyleSheetPath).absolutePath() != path) ||
+        styleSheetWatcher->files().contains(currentStyleSheetPath) ||
+        !QFileInfo(currentStyleSheetPath).exists()
+    )
+    {
+        return;
+    }
+
+    styleSheetReloadTimer->start();
+}
+
+void HtmlPreview::reloadStyleSheet()
+{
+    QFile cssFile(currentStyleSheetPath);
+
+    // Keep the last style sheet that could be read applied, for example
+    // while the file is being replaced, rather than unstyling the page.
+    //
+    if (!cssFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QByteArray css = cssFile.readAll();
+    cssFile.close();
+
+    // Resource files (":/...") never change, so only watch files on disk.
+    if
+    (
+        !currentStyleSheetPath.startsWith(":") &&
+        !styleSheetWatcher->files().contains(currentStyleSheetPath)
+    )
+    {
+        styleSheetWatcher->addPath(currentStyleSheetPath);
+    }
+
+    // WebKit accepts the user style sheet as a UTF-8, Base64-encoded data
+    // URL, and restyles the current page in place when it changes.  Using a
+    // data URL rather than a file URL also ensures that a modified file is
+    // not served from WebKit's cache.
+    //
+    css = resolveStyleSheetUrls(QString::fromUtf8(css.data()), currentStyleSheetPath).toUtf8();
+
+    userStyleSheetUrl =
+        QUrl(QString("data:text/css;charset=utf-8;base64,")
+            + QString::fromLatin1(css.toBase64()));
+
+    if (NULL != remoteRenderer)
+    {
+        remoteRenderer->setUserStyleSheetUrl(userStyleSheetUrl);
+    }
+    else
+    {
+        htmlBrowser->settings()->setUserStyleSheetUrl(userStyleSheetUrl);
+    }
+}
+
 void HtmlPreview::printPreview()
 {
     QPrintPreviewDialog printPreviewDialog(&printer, this);
@@ -548,7 +840,20 @@ void HtmlPreview::printPreview()
 
 void HtmlPreview::printHtmlToPrinter(QPrinter* printer)
 {
+    if (NULL != remoteRenderer)
+    {
+        // The in-process browser is left empty while rendering out of
+        // process, so load the page into it just for printing.
+        //
+        htmlBrowser->setContent(html.toUtf8(), "text/html", baseUrl);
+    }
+
     this->htmlBrowser->print(printer);
+
+    if (NULL != remoteRenderer)
+    {
+        htmlBrowser->setHtml("");
+    }
 }
 
 void HtmlPreview::onExport()
@@ -572,6 +877,28 @@ void HtmlPreview::onLinkClicked(const QUrl& url)
     QDesktopServices::openUrl(url);
 }
 
+void HtmlPreview::onRendererWindowCreated(qulonglong windowId)
+{
+#if QT_VERSION >= 0x050000
+    // Embed the renderer's native window in place of the in-process browser.
+    // A new window is created whenever the renderer restarts, so replace any
+    // previous container.
+    //
+    if (NULL != remoteRendererWidget)
+    {
+        previewStack->removeWidget(remoteRendererWidget);
+        delete remoteRendererWidget;
+    }
+
+    QWindow* rendererWindow = QWindow::fromWinId((WId) windowId);
+    remoteRendererWidget = QWidget::createWindowContainer(rendererWindow, previewStack);
+    previewStack->addWidget(remoteRendererWidget);
+    previewStack->setCurrentWidget(remoteRendererWidget);
+#else
+    Q_UNUSED(windowId)
+#endif
+}
+
 void HtmlPreview::updateBaseDir()
 {
     if (!document->getFilePath().isNull() && !document->getFilePath().isEmpty())
@@ -597,10 +924,29 @@ QSize HtmlPreview::sizeHint() const
     return QSize(500, 600);
 }
 
+void HtmlPreview::showEvent(QShowEvent* event)
+{
+#if QT_VERSION < 0x050000
+    if (NULL != remoteRenderer)
+    {
+        remoteRenderer->setWindowVisible(true);
+    }
+#endif
+
+    QMainWindow::showEvent(event);
+}
+
 void HtmlPreview::closeEvent(QCloseEvent* event)
 {
     Q_UNUSED(event);
 
+#if QT_VERSION < 0x050000
+    if (NULL != remoteRenderer)
+    {
+        remoteRenderer->setWindowVisible(false);
+    }
+#endif
+
     setHtml("");
     html = "";
 }
@@ -609,18 +955,129 @@ void HtmlPreview::setHtml(const QString& html)
 {
     this->html = html;
 
-    htmlBrowser->setContent(html.toUtf8(), "text/html", baseUrl);
-    htmlBrowser->page()->mainFrame()->scrollToAnchor("livepreviewmodifypoint");
+    if (NULL != remoteRenderer)
+    {
+        // The renderer anchors the headings and scrolls to the modification
+        // point itself.
+        //
+        remoteRenderer->setContent(html.toUtf8(), baseUrl);
+    }
+    else
+    {
+        htmlBrowser->setContent(html.toUtf8(), "text/html", baseUrl);
+        anchorHeadings(htmlBrowser->page()->mainFrame());
+        htmlBrowser->page()->mainFrame()->scrollToAnchor("livepreviewmodifypoint");
+    }
+}
+
+void HtmlPreview::applyStyleSheet(const QString& filePath)
+{
+    if (!currentStyleSheetPath.isEmpty())
+    {
+        QString directoryPath = QFileInfo(currentStyleSheetPath).absolutePath();
+
+        if (styleSheetWatcher->files().contains(currentStyleSheetPath))
+        {
+            styleSheetWatcher->removePath(currentStyleSheetPath);
+        }
+
+        if (styleSheetWatcher->directories().contains(directoryPath))
+        {
+            styleSheetWatcher->removePath(directoryPath);
+        }
+    }
+
+    styleSheetReloadTimer->stop();
+    currentStyleSheetPath = filePath;
+
+    // Also watch the directory of a style sheet on disk, so that the file
+    // can be watched again after being replaced or deleted and recreated.
+    // The file itself is watched once it has been read.
+    //
+    if (!filePath.startsWith(":"))
+    {
+        QString directoryPath = QFileInfo(filePath).absolutePath();
+
+        if (QFileInfo(directoryPath).isDir())
+        {
+            styleSheetWatcher->addPath(directoryPath);
+        }
+    }
+
+    reloadStyleSheet();
+}
+
+QString HtmlPreview::resolveStyleSheetUrls
+(
+    const QString& css,
+    const QString& filePath
+) const
+{
+    QUrl baseUrl;
+
+    if (filePath.startsWith(":"))
+    {
+        baseUrl = QUrl("qrc" + filePath);
+    }
+    else
+    {
+        baseUrl = QUrl::fromLocalFile(QFileInfo(filePath).absoluteFilePath());
+    }
+
+    // The second capture of each expression is the referenced URL, whether
+    // or not it is quoted.
+    //
+    QList<QRegExp> references;
+    references.append(QRegExp("url\\(\\s*(['\"]?)([^'\")]*)\\1\\s*\\)", Qt::CaseInsensitive));
+    references.append(QRegExp("@import\\s+(['\"])([^'\"]*)\\1", Qt::CaseInsensitive));
+
+    QString resolvedCss = css;
+
+    for (int i = 0; i < references.size(); i++)
+    {
+        QRegExp& regex = references[i];
+        int pos = 0;
+
+        while ((pos = regex.indexIn(resolvedCss, pos)) >= 0)
+        {
+            QString reference = regex.cap(2).trimmed();
+            int referencePos = regex.pos(2);
+            int referenceLength = regex.cap(2).length();
+
+            if
+            (
+                reference.isEmpty() ||
+                reference.startsWith("#") ||
+                !QUrl(reference).isRelative()
+            )
+            {
+                pos += regex.matchedLength();
+                continue;
+            }
+
+            QString resolved = baseUrl.resolved(QUrl(reference)).toString();
+
+            resolvedCss.replace(referencePos, referenceLength, resolved);
+            pos += regex.matchedLength() - referenceLength + resolved.length();
+        }
+    }
+
+    return resolvedCss;
 }
 
-QString HtmlPreview::exportToHtml
+HtmlPreview::RenderedHtml HtmlPreview::exportToHtml
 (
     const QString& text,
-    Exporter* exporter
+    Exporter* exporter,
+    const PreviewTimings& timings
 ) const
 {
+    RenderedHtml result;
     QString html;
 
+    result.timings = timings;
+    result.timings.exportStarted = PreviewTimings::now();
+
     // Enable smart typography for preview, if available for the exporter.
     bool smartTypographyEnabled = exporter->getSmartTypographyEnabled();
     exporter->setSmartTypographyEnabled(true);
@@ -633,5 +1090,7 @@ QString HtmlPreview::exportToHtml
     //
     exporter->setSmartTypographyEnabled(smartTypographyEnabled);
 
-    return html;
+    result.html = html;
+    result.timings.exportFinished = PreviewTimings::now();
+    return result;
 }
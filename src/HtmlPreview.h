@@ -33,6 +33,8 @@
 #include <QUrl>
 #include <QFutureWatcher>
 #include <QStringList>
+#include <QFileSystemWatcher>
+#include <QStackedWidget>
 
 #if QT_VERSION >= 0x050000
 #include <QtWebKitWidgets>
@@ -41,15 +43,26 @@
 #endif
 
 #include "Exporter.h"
+#include "MemoryAccounting.h"
+#include "PreviewTimings.h"
 #include "TextDocument.h"
 
 class QPrintPreviewDialog;
 class QPrinter;
+class RemotePreviewRenderer;
+
+/*
+ * Settings key of the style sheet selected in the live preview, which the
+ * export dialog also inlines into self-contained HTML files, and the style
+ * sheet to use when none has been selected yet.
+ */
+#define GW_LAST_USED_STYLE_SHEET_KEY "Preview/lastUsedStyleSheet"
+#define GW_DEFAULT_STYLE_SHEET ":/resources/github.css"
 
 /**
  * Live HTML Preview window.
  */
-class HtmlPreview : public QMainWindow
+class HtmlPreview : public QMainWindow, public MemoryAccountable
 {
     Q_OBJECT
     
@@ -69,6 +82,39 @@ class HtmlPreview : public QMainWindow
          */
         virtual ~HtmlPreview();
 
+        /**
+         * Adds anchors named livepreviewhnbr1, livepreviewhnbr2, etc., before
+         * each heading tag (h1 - h6) in the given frame, in document order,
+         * for use with navigateToHeading().
+         */
+        static void anchorHeadings(QWebFrame* frame);
+
+        /**
+         * Returns the Markdown flavor read by the currently selected
+         * exporter.
+         */
+        MarkdownFlavor getMarkdownFlavor() const;
+
+        /**
+         * Returns the name of the exporter that renders the preview, or a
+         * null string if no exporter is available.
+         */
+        QString getExporterName() const;
+
+        /**
+         * Selects the exporter with the given name to render the preview,
+         * as if the user had chosen it.  Returns false if no such exporter
+         * is available.
+         */
+        bool selectExporter(const QString& name);
+
+        /**
+         * Appends the memory held for the displayed HTML to the given
+         * list.  Memory held by WebKit for the rendered page and its
+         * caches cannot be queried, and is not included.
+         */
+        void accountMemory(QList<MemoryUsage>& usage) const;
+
     signals:
         /**
          * Emitted when a lengthy operation has started, such as when the user
@@ -87,6 +133,20 @@ class HtmlPreview : public QMainWindow
          */
         void operationFinished();
 
+        /**
+         * Emitted when the user selects an exporter that reads a different
+         * Markdown flavor than the previously selected one.
+         */
+        void markdownFlavorChanged(MarkdownFlavor flavor);
+
+        /**
+         * Emitted once the page rendered for an updated document has
+         * finished loading, with the timestamps of each stage of the
+         * update.  Only emitted when the page is rendered in this window
+         * rather than in a helper process.
+         */
+        void previewUpdated(const PreviewTimings& timings);
+
     public slots:
         /**
          * Call this method to re-render the HTML for the document.
@@ -102,15 +162,45 @@ class HtmlPreview : public QMainWindow
          */
         void navigateToHeading(int headingSequenceNumber);
 
+        /**
+         * Sets whether the HTML is rendered in a separate helper process
+         * rather than in this window.  Rendering out of process keeps slow
+         * page layout from blocking the editor's GUI thread.
+         */
+        void setRemoteRenderingEnabled(bool enabled);
+
     private slots:
         void onHtmlReady();
+        void onLoadFinished(bool ok);
         void onPreviewerChanged(int index);
         void changeStyleSheet(int index);
+
+        /*
+         * Called when the currently selected custom style sheet is modified
+         * on disk, so that the new CSS can be applied to the page without
+         * re-rendering the document.
+         */
+        void onStyleSheetFileChanged(const QString& path);
+
+        /*
+         * Called when the directory of the currently selected custom style
+         * sheet changes, so that the style sheet is watched and reloaded
+         * again once an editor that saves by replacing the file has put
+         * the new file in place.
+         */
+        void onStyleSheetDirectoryChanged(const QString& path);
+
+        /*
+         * Reads the current style sheet and applies it to the page.  Called
+         * once changes to the file have settled.
+         */
+        void reloadStyleSheet();
         void printPreview();
         void printHtmlToPrinter(QPrinter* printer);
         void onExport();
         void copyHtml();
         void onLinkClicked(const QUrl& url);
+        void onRendererWindowCreated(qulonglong windowId);
 
         /**
          * Sets the base directory path for determining resource
@@ -121,10 +211,26 @@ class HtmlPreview : public QMainWindow
 
     protected:
         QSize sizeHint() const;
+        void showEvent(QShowEvent* event);
         void closeEvent(QCloseEvent* event);
 
     private:
+        // HTML rendered on a worker thread, with the timestamps of the
+        // stages that the update has gone through so far.
+        //
+        struct RenderedHtml
+        {
+            QString html;
+            PreviewTimings timings;
+        };
+
+        QStackedWidget* previewStack;
         QWebView* htmlBrowser;
+        RemotePreviewRenderer* remoteRenderer;
+
+        // Displays the renderer's window when rendering out of process.
+        QWidget* remoteRendererWidget;
+
         QUrl baseUrl;
         TextDocument* document;
         QComboBox* previewerComboBox;
@@ -135,7 +241,6 @@ class HtmlPreview : public QMainWindow
         bool documentChanged;
         bool typingPaused;
         QString html;
-        QRegExp headingTagExp;
         int lastStyleSheetIndex;
         QStringList customCssFiles;
 
@@ -150,9 +255,22 @@ class HtmlPreview : public QMainWindow
         // flag used to prevent recursion in changeStyleSheet
         bool handlingStyleSheetChange;
 
-        QFutureWatcher<QString>* futureWatcher;
+        QFutureWatcher<RenderedHtml>* futureWatcher;
+
+        // Timings of the update whose page is loading, if any.
+        PreviewTimings loadingTimings;
+        bool loadingTimingsPending;
         QStringList defaultStyleSheets;
 
+        // Watches the currently selected custom style sheet, and its
+        // directory, for changes.  Changes are reloaded after a short delay,
+        // since editors often write a file in several steps.
+        //
+        QFileSystemWatcher* styleSheetWatcher;
+        QTimer* styleSheetReloadTimer;
+        QString currentStyleSheetPath;
+        QUrl userStyleSheetUrl;
+
         /*
          * Sets the HTML contents to display, and creates a backup of the old
          * HTML for diffing to scroll to the first difference whenever
@@ -160,7 +278,36 @@ class HtmlPreview : public QMainWindow
          */
         void setHtml(const QString& html);
 
-        QString exportToHtml(const QString& text, Exporter* exporter) const;
+        /*
+         * Loads the CSS at the given file path (which may also be a Qt
+         * resource path) and applies it to the page as the user style sheet.
+         * Since the CSS is handed to WebKit as a data URL, the browser only
+         * needs to recompute styles for the existing page, and the HTML does
+         * not need to be regenerated by the exporter.  The file is also
+         * watched for changes if it resides on the file system.  If the
+         * file cannot be read, the last style sheet that could be read
+         * stays applied.
+         */
+        void applyStyleSheet(const QString& filePath);
+
+        /*
+         * Returns the given CSS with the relative URLs of its url() and
+         * @import references resolved against the directory of the CSS file
+         * at the given path, since a style sheet loaded from a data URL has
+         * no base URL of its own against which to resolve them.
+         */
+        QString resolveStyleSheetUrls
+        (
+            const QString& css,
+            const QString& filePath
+        ) const;
+
+        RenderedHtml exportToHtml
+        (
+            const QString& text,
+            Exporter* exporter,
+            const PreviewTimings& timings
+        ) const;
 };
 
 #endif
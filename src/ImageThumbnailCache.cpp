@@ -0,0 +1,247 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImageReader>
+
+#include "ImageThumbnailCache.h"
+#include "TaskScheduler.h"
+
+// Maximum memory used by the cached thumbnails, in kilobytes.
+#define GW_THUMBNAIL_CACHE_SIZE 16384
+
+// Time in milliseconds after which a cached thumbnail is checked against
+// the last modified time of its file again.
+//
+#define GW_THUMBNAIL_REVALIDATE_INTERVAL 10000
+
+ImageThumbnailCache::ImageThumbnailCache
+(
+    const QSize& maxThumbnailSize,
+    QObject* parent
+)
+    : QObject(parent), maxThumbnailSize(maxThumbnailSize)
+{
+    thumbnails.setMaxCost(GW_THUMBNAIL_CACHE_SIZE);
+    clock.start();
+
+    MemoryAccounting::getInstance()->addAccountable(this);
+}
+
+ImageThumbnailCache::~ImageThumbnailCache()
+{
+    MemoryAccounting::getInstance()->removeAccountable(this);
+
+    // Pending decodes only hold copies of their parameters, so there is no
+    // need to wait for them.
+    //
+    token.cancel();
+}
+
+QPixmap ImageThumbnailCache::thumbnail(const QString& filePath)
+{
+    Thumbnail* thumbnail = thumbnails.object(filePath);
+
+    if (NULL == thumbnail)
+    {
+        requestDecode(filePath, QDateTime());
+        return QPixmap();
+    }
+
+    if ((clock.elapsed() - thumbnail->validatedAt) > GW_THUMBNAIL_REVALIDATE_INTERVAL)
+    {
+        requestDecode(filePath, thumbnail->lastModified);
+    }
+
+    return thumbnail->pixmap;
+}
+
+int ImageThumbnailCache::getCacheSize() const
+{
+    return thumbnails.totalCost();
+}
+
+int ImageThumbnailCache::getMaxCacheSize() const
+{
+    return thumbnails.maxCost();
+}
+
+void ImageThumbnailCache::clear()
+{
+    token.cancel();
+    token = CancellationToken();
+    pendingFilePaths.clear();
+    thumbnails.clear();
+}
+
+void ImageThumbnailCache::accountMemory(QList<MemoryUsage>& usage) const
+{
+    usage.append
+    (
+        MemoryUsage
+        (
+            GW_MEMORY_IMAGE_THUMBNAILS,
+            thumbnails.count(),
+            ((qint64) thumbnails.totalCost()) * 1024
+        )
+    );
+}
+
+void ImageThumbnailCache::onDecodeFinished()
+{
+    QFutureWatcher<DecodeResult>* watcher =
+        static_cast<QFutureWatcher<DecodeResult>*>(sender());
+
+    watcher->deleteLater();
+
+    // Decodes are only cancelled by clear(), which has already forgotten
+    // about them.
+    //
+    if (watcher->isCanceled())
+    {
+        return;
+    }
+
+    DecodeResult result = watcher->result();
+
+    if (!pendingFilePaths.remove(result.filePath))
+    {
+        return;
+    }
+
+    Thumbnail* thumbnail = thumbnails.object(result.filePath);
+
+    if (result.unchanged)
+    {
+        if (NULL != thumbnail)
+        {
+            thumbnail->validatedAt = clock.elapsed();
+        }
+        // The thumbnail was evicted while its file was being checked.
+        else
+        {
+            requestDecode(result.filePath, QDateTime());
+        }
+
+        return;
+    }
+
+    thumbnail = new Thumbnail();
+    thumbnail->pixmap = QPixmap::fromImage(result.image);
+    thumbnail->lastModified = result.lastModified;
+    thumbnail->validatedAt = clock.elapsed();
+
+    // Images that fail to decode are cached as null pixmaps, so that they
+    // are not decoded over and over again while they are on screen.
+    //
+    int cost =
+        (thumbnail->pixmap.width() * thumbnail->pixmap.height()
+            * thumbnail->pixmap.depth()) / (8 * 1024);
+
+    thumbnails.insert(result.filePath, thumbnail, qMax(1, cost));
+    emit thumbnailReady(result.filePath);
+}
+
+void ImageThumbnailCache::requestDecode
+(
+    const QString& filePath,
+    const QDateTime& lastModified
+)
+{
+    if (pendingFilePaths.contains(filePath))
+    {
+        return;
+    }
+
+    pendingFilePaths.insert(filePath);
+
+    TaskOptions options(TaskPriorityNormal);
+    options.token = token;
+
+    QFutureWatcher<DecodeResult>* watcher =
+        new QFutureWatcher<DecodeResult>(this);
+
+    connect(watcher, SIGNAL(finished()), this, SLOT(onDecodeFinished()));
+
+    watcher->setFuture
+    (
+        TaskScheduler::getInstance()->run
+        (
+            options,
+            &ImageThumbnailCache::decode,
+            filePath,
+            lastModified,
+            maxThumbnailSize
+        )
+    );
+}
+
+ImageThumbnailCache::DecodeResult ImageThumbnailCache::decode
+(
+    const QString& filePath,
+    const QDateTime& knownLastModified,
+    const QSize& maxSize
+)
+{
+    DecodeResult result;
+    QFileInfo fileInfo(filePath);
+
+    result.filePath = filePath;
+    result.lastModified = fileInfo.lastModified();
+    result.unchanged =
+        knownLastModified.isValid()
+        && (knownLastModified == result.lastModified);
+
+    if (result.unchanged || !fileInfo.isFile() || CancellationToken::current().isCancelled())
+    {
+        return result;
+    }
+
+    QImageReader reader(filePath);
+    QSize size = reader.size();
+
+    // Let the image reader scale the image while decoding it whenever the
+    // image size is known up front.  For JPEG images in particular, this is
+    // far faster than decoding the full image and scaling it afterwards.
+    //
+    if
+    (
+        size.isValid()
+        && ((size.width() > maxSize.width()) || (size.height() > maxSize.height()))
+    )
+    {
+        reader.setScaledSize(size.scaled(maxSize, Qt::KeepAspectRatio));
+    }
+
+    result.image = reader.read();
+
+    if
+    (
+        !result.image.isNull()
+        && ((result.image.width() > maxSize.width()) || (result.image.height() > maxSize.height()))
+    )
+    {
+        result.image =
+            result.image.scaled(maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    return result;
+}
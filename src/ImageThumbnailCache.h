@@ -0,0 +1,137 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef IMAGETHUMBNAILCACHE_H
+#define IMAGETHUMBNAILCACHE_H
+
+#include <QObject>
+#include <QCache>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
+#include <QSize>
+#include <QString>
+
+#include "CancellationToken.h"
+#include "MemoryAccounting.h"
+
+/**
+ * Cache of downscaled image thumbnails, such as for the image previews
+ * shown in the editor.  Images are decoded and scaled on a worker thread
+ * via the TaskScheduler, so that large photos never stall the GUI.  The
+ * cache holds the most recently used thumbnails up to a fixed amount of
+ * memory, and thumbnails are decoded again whenever the last modified time
+ * of their image file changes.
+ */
+class ImageThumbnailCache : public QObject, public MemoryAccountable
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Thumbnails are scaled down to fit within the given
+         * size, keeping their aspect ratio.  Smaller images are not scaled.
+         */
+        ImageThumbnailCache(const QSize& maxThumbnailSize, QObject* parent = 0);
+
+        /**
+         * Destructor.
+         */
+        ~ImageThumbnailCache();
+
+        /**
+         * Returns the thumbnail for the image at the given absolute file
+         * path, or a null pixmap if it has not been decoded yet or if the
+         * file is not a readable image.  If the thumbnail is missing or has
+         * not been checked against its file for a while, it is decoded in
+         * the background, and thumbnailReady() is emitted once it is
+         * available.
+         */
+        QPixmap thumbnail(const QString& filePath);
+
+        /**
+         * Returns the approximate memory used by the cached thumbnails, in
+         * kilobytes.
+         */
+        int getCacheSize() const;
+
+        /**
+         * Returns the maximum memory used by the cached thumbnails, in
+         * kilobytes.
+         */
+        int getMaxCacheSize() const;
+
+        /**
+         * Removes all thumbnails from the cache, and cancels any pending
+         * decodes.
+         */
+        void clear();
+
+        /**
+         * Appends the memory held by the cached thumbnails to the given
+         * list.
+         */
+        void accountMemory(QList<MemoryUsage>& usage) const;
+
+    signals:
+        /**
+         * Emitted when the thumbnail for the given file path has been
+         * decoded and added to the cache.
+         */
+        void thumbnailReady(const QString& filePath);
+
+    private slots:
+        void onDecodeFinished();
+
+    private:
+        struct Thumbnail
+        {
+            QPixmap pixmap;
+            QDateTime lastModified;
+            qint64 validatedAt;
+        };
+
+        struct DecodeResult
+        {
+            QString filePath;
+            QImage image;
+            QDateTime lastModified;
+            bool unchanged;
+        };
+
+        QSize maxThumbnailSize;
+        QCache<QString, Thumbnail> thumbnails;
+        QSet<QString> pendingFilePaths;
+        CancellationToken token;
+        QElapsedTimer clock;
+
+        void requestDecode(const QString& filePath, const QDateTime& lastModified);
+
+        static DecodeResult decode
+        (
+            const QString& filePath,
+            const QDateTime& knownLastModified,
+            const QSize& maxSize
+        );
+};
+
+#endif // IMAGETHUMBNAILCACHE_H
@@ -61,6 +61,7 @@
 #include "MarkdownHighlighter.h"
 #include "DocumentManager.h"
 #include "DocumentHistory.h"
+#include "AsyncFileAccess.h"
 #include "Outline.h"
 #include "MessageBoxHelper.h"
 #include "SimpleFontDialog.h"
@@ -69,6 +70,15 @@
 #include "DocumentStatisticsWidget.h"
 #include "SessionStatistics.h"
 #include "SessionStatisticsWidget.h"
+#include "WritingHistory.h"
+#include "WritingHistoryWidget.h"
+#include "MarkdownLinter.h"
+#include "ProblemsPanel.h"
+#include "MemoryDiagnosticsWidget.h"
+#include "DocumentMinimap.h"
+#include "BackgroundImageLoader.h"
+#include "PipeTableFormatter.h"
+#include "QuickJumpPalette.h"
 
 #define GW_MAIN_WINDOW_GEOMETRY_KEY "Window/mainWindowGeometry"
 #define GW_MAIN_WINDOW_STATE_KEY "Window/mainWindowState"
@@ -76,10 +86,16 @@
 #define GW_CHEAT_SHEET_HUD_GEOMETRY_KEY "HUD/cheatSheetHudGeometry"
 #define GW_DOCUMENT_STATISTICS_HUD_GEOMETRY_KEY "HUD/documentStatisticsHudGeometry"
 #define GW_SESSION_STATISTICS_HUD_GEOMETRY_KEY "HUD/sessionStatisticsHudGeometry"
+#define GW_WRITING_HISTORY_HUD_GEOMETRY_KEY "HUD/writingHistoryHudGeometry"
+#define GW_PROBLEMS_HUD_GEOMETRY_KEY "HUD/problemsHudGeometry"
+#define GW_MEMORY_DIAGNOSTICS_HUD_GEOMETRY_KEY "HUD/memoryDiagnosticsHudGeometry"
 #define GW_OUTLINE_HUD_OPEN_KEY "HUD/outlineHudOpen"
 #define GW_CHEAT_SHEET_HUD_OPEN_KEY "HUD/cheatSheetHudOpen"
 #define GW_DOCUMENT_STATISTICS_HUD_OPEN_KEY "HUD/documentStatisticsHudOpen"
 #define GW_SESSION_STATISTICS_HUD_OPEN_KEY "HUD/sessionStatisticsHudOpen"
+#define GW_WRITING_HISTORY_HUD_OPEN_KEY "HUD/writingHistoryHudOpen"
+#define GW_PROBLEMS_HUD_OPEN_KEY "HUD/problemsHudOpen"
+#define GW_MEMORY_DIAGNOSTICS_HUD_OPEN_KEY "HUD/memoryDiagnosticsHudOpen"
 #define GW_HTML_PREVIEW_GEOMETRY_KEY "Preview/htmlPreviewGeometry"
 #define GW_HTML_PREVIEW_OPEN "Preview/htmlPreviewOpen"
 
@@ -163,6 +179,16 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
     sessionStatsHud->setCentralWidget(sessionStatsWidget);
     sessionStatsHud->setButtonLayout(appSettings->getHudButtonLayout());
 
+    writingHistoryWidget = new WritingHistoryWidget();
+    writingHistoryWidget->verticalScrollBar()->setStyle(new QCommonStyle());
+    writingHistoryWidget->horizontalScrollBar()->setStyle(new QCommonStyle());
+    writingHistoryWidget->setSelectionMode(QAbstractItemView::NoSelection);
+
+    writingHistoryHud = new HudWindow(this);
+    writingHistoryHud->setWindowTitle(tr("Writing History"));
+    writingHistoryHud->setCentralWidget(writingHistoryWidget);
+    writingHistoryHud->setButtonLayout(appSettings->getHudButtonLayout());
+
     TextDocument* document = new TextDocument();
 
     // The below connection must happen before the Highlighter is created and
@@ -173,20 +199,51 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
 
     highlighter = new MarkdownHighlighter(document);
     highlighter->setSpellCheckEnabled(appSettings->getLiveSpellCheckEnabled());
+    highlighter->setStyleCheckEnabled(appSettings->getLiveStyleCheckEnabled());
     highlighter->setBlockquoteStyle(appSettings->getBlockquoteStyle());
     connect(highlighter, SIGNAL(headingFound(int,int,QString)), outlineWidget, SLOT(insertHeadingIntoOutline(int,int,QString)));
     connect(highlighter, SIGNAL(headingRemoved(int)), outlineWidget, SLOT(removeHeadingFromOutline(int)));
 
+    // The linter must be created after the highlighter.  See note in the
+    // MarkdownLinter class's constructor.
+    //
+    linter = new MarkdownLinter(document, this);
+    highlighter->setLinter(linter);
+
+    problemsWidget = new ProblemsPanel(document);
+    problemsWidget->verticalScrollBar()->setStyle(new QCommonStyle());
+    problemsWidget->horizontalScrollBar()->setStyle(new QCommonStyle());
+    connect(linter, SIGNAL(diagnosticsChanged()), problemsWidget, SLOT(onDiagnosticsChanged()));
+
+    problemsHud = new HudWindow(this);
+    problemsHud->setWindowTitle(tr("Problems"));
+    problemsHud->setCentralWidget(problemsWidget);
+    problemsHud->setButtonLayout(appSettings->getHudButtonLayout());
+
+    memoryDiagnosticsWidget = new MemoryDiagnosticsWidget();
+    memoryDiagnosticsWidget->verticalScrollBar()->setStyle(new QCommonStyle());
+    memoryDiagnosticsWidget->horizontalScrollBar()->setStyle(new QCommonStyle());
+    memoryDiagnosticsWidget->setSelectionMode(QAbstractItemView::NoSelection);
+
+    memoryDiagnosticsHud = new HudWindow(this);
+    memoryDiagnosticsHud->setWindowTitle(tr("Memory Diagnostics"));
+    memoryDiagnosticsHud->setCentralWidget(memoryDiagnosticsWidget);
+    memoryDiagnosticsHud->setButtonLayout(appSettings->getHudButtonLayout());
+
     editor = new MarkdownEditor(document, highlighter, this);
     editor->setFont(appSettings->getFont().family(), appSettings->getFont().pointSize());
     editor->setUseUnderlineForEmphasis(appSettings->getUseUnderlineForEmphasis());
     editor->setEnableLargeHeadingSizes(appSettings->getLargeHeadingSizesEnabled());
+    editor->setImagePreviewsEnabled(appSettings->getImagePreviewsEnabled());
+    editor->setPaintCacheEnabled(appSettings->getPaintCacheEnabled());
     editor->setAutoMatchEnabled(appSettings->getAutoMatchEnabled());
     editor->setBulletPointCyclingEnabled(appSettings->getBulletPointCyclingEnabled());
     editor->setPlainText("");
     editor->setEditorWidth((EditorWidth) appSettings->getEditorWidth());
     connect(outlineWidget, SIGNAL(documentPositionNavigated(int)), editor, SLOT(navigateDocument(int)));
     connect(editor, SIGNAL(cursorPositionChanged(int)), outlineWidget, SLOT(updateCurrentNavigationHeading(int)));
+    connect(linter, SIGNAL(diagnosticsChanged()), editor, SLOT(refreshAnnotations()));
+    connect(problemsWidget, SIGNAL(documentPositionNavigated(int)), editor, SLOT(navigateDocument(int)));
 
     // We need to set an empty style for the editor's scrollbar in order for the
     // scrollbar CSS stylesheet to take full effect.  Otherwise, the scrollbar's
@@ -208,6 +265,8 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
     connect(documentStats, SIGNAL(readabilityIndexChanged(int)), documentStatsWidget, SLOT(setReadabilityIndex(int)));
     connect(editor, SIGNAL(textSelected(QString,int,int)), documentStats, SLOT(onTextSelected(QString,int,int)));
     connect(editor, SIGNAL(textDeselected()), documentStats, SLOT(onTextDeselected()));
+    connect(documentStats, SIGNAL(blockWordCountsChanged(int,int)), outlineWidget, SLOT(updateSectionStatistics(int,int)));
+    outlineWidget->setDocumentStatistics(documentStats);
 
     sessionStats = new SessionStatistics(this);
     connect(documentStats, SIGNAL(totalWordCountChanged(int)), sessionStats, SLOT(onDocumentWordCountChanged(int)));
@@ -219,6 +278,10 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
     connect(editor, SIGNAL(typingPaused()), sessionStats, SLOT(onTypingPaused()));
     connect(editor, SIGNAL(typingResumed()), sessionStats, SLOT(onTypingResumed()));
 
+    writingHistory = new WritingHistory(appSettings->getHistoryDirectoryPath(), this);
+    connect(sessionStats, SIGNAL(activityRecorded(int,bool)), writingHistory, SLOT(onActivityRecorded(int,bool)));
+    connect(writingHistory, SIGNAL(historyAvailable(WritingHistorySummary)), writingHistoryWidget, SLOT(setHistory(WritingHistorySummary)));
+
     documentManager = new DocumentManager(editor, documentStats, sessionStats, this);
     documentManager->setAutoSaveEnabled(appSettings->getAutoSaveEnabled());
     documentManager->setFileBackupEnabled(appSettings->getBackupFileEnabled());
@@ -230,6 +293,9 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
     connect(documentManager, SIGNAL(operationUpdate(QString)), this, SLOT(onOperationStarted(QString)));
     connect(documentManager, SIGNAL(operationFinished()), this, SLOT(onOperationFinished()));
     connect(documentManager, SIGNAL(documentClosed()), this, SLOT(refreshRecentFiles()));
+    connect(documentManager, SIGNAL(filePathChanged(QString)), writingHistory, SLOT(setDocumentPath(QString)));
+    writingHistory->setDocumentPath(documentManager->getDocument()->getFilePath());
+    writingHistory->requestHistory();
 
     editor->setAutoMatchEnabled('\"', appSettings->getAutoMatchDoubleQuotes());
     editor->setAutoMatchEnabled('\'', appSettings->getAutoMatchSingleQuotes());
@@ -245,19 +311,44 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
     editorPane->setObjectName("editorLayoutArea");
     editorPane->setLayout(editor->getPreferredLayout());
 
+    minimap = new DocumentMinimap(editor, editorPane);
+    minimap->setVisible(appSettings->getMinimapEnabled());
+    editor->getPreferredLayout()->addWidget(minimap, 0, 1);
+
+    backgroundImageLoader =
+        new BackgroundImageLoader
+        (
+            appSettings->getCacheDirectoryPath() + "/backgrounds",
+            this
+        );
+
+    connect
+    (
+        backgroundImageLoader,
+        SIGNAL(imageLoaded(QString,PictureAspect,QImage)),
+        this,
+        SLOT(onBackgroundImageLoaded(QString,PictureAspect,QImage))
+    );
+
+    tableFormatter = new PipeTableFormatter(editor, this);
+    tableFormatter->setEnabled(appSettings->getTableFormattingEnabled());
+    connect(editor, SIGNAL(typingPaused()), tableFormatter, SLOT(formatTableAtCursor()));
+
     setCentralWidget(editorPane);
 
+    quickJumpPalette = new QuickJumpPalette(this);
+    connect(quickJumpPalette, SIGNAL(documentPositionNavigated(int)), editor, SLOT(navigateDocument(int)));
+    connect(quickJumpPalette, SIGNAL(fileSelected(QString)), documentManager, SLOT(open(QString)));
+
     findReplaceDialog = new FindDialog(editor);
     findReplaceDialog->setModal(false);
     connect(findReplaceDialog, SIGNAL(replaceAllComplete()), documentStats, SLOT(refreshStatistics()));
+    connect(findReplaceDialog, SIGNAL(matchesFound(QList<int>)), editor, SLOT(setSearchMatches(QList<int>)));
 
-    QStringList recentFiles;
+    fileAccess = new AsyncFileAccess(this, this);
+    connect(fileAccess, SIGNAL(existingFilesFound(QStringList)), this, SLOT(onRecentFilesFound(QStringList)));
 
-    if (appSettings->getFileHistoryEnabled())
-    {
-        DocumentHistory history;
-        recentFiles = history.getRecentFiles(MAX_RECENT_FILES + 2);
-    }
+    restoringLastFile = false;
 
     if (!filePath.isNull() && !filePath.isEmpty())
     {
@@ -266,7 +357,6 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
         if (cliFileInfo.exists())
         {
             fileToOpen = filePath;
-            recentFiles.removeAll(cliFileInfo.absoluteFilePath());
         }
         else
         {
@@ -274,21 +364,13 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
             exit(-1);
         }
     }
-
-    if (fileToOpen.isNull() && appSettings->getFileHistoryEnabled())
+    else
     {
-        QString lastFile;
-
-        if (!recentFiles.isEmpty())
-        {
-            lastFile = recentFiles.first();
-        }
-
-        if (QFileInfo(lastFile).exists())
-        {
-            fileToOpen = lastFile;
-            recentFiles.removeAll(lastFile);
-        }
+        // The last file of the previous session is reopened once the lookup
+        // of which recent files still exist finishes, rather than holding up
+        // startup on an unresponsive file system.  See onRecentFilesFound().
+        //
+        restoringLastFile = appSettings->getFileHistoryEnabled();
     }
 
     for (int i = 0; i < MAX_RECENT_FILES; i++)
@@ -302,17 +384,11 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
             SLOT(openRecentFile())
         );
 
-        if (i < recentFiles.size())
-        {
-            recentFilesActions[i]->setText(recentFiles.at(i));
-            recentFilesActions[i]->setVisible(true);
-        }
-        else
-        {
-            recentFilesActions[i]->setVisible(false);
-        }
+        recentFilesActions[i]->setVisible(false);
     }
 
+    refreshRecentFiles();
+
     buildMenuBar();
     buildStatusBar();
 
@@ -359,6 +435,8 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
     connect(outlineWidget, SIGNAL(headingNumberNavigated(int)), htmlPreview, SLOT(navigateToHeading(int)));
     connect(htmlPreview, SIGNAL(operationStarted(QString)), this, SLOT(onOperationStarted(QString)));
     connect(htmlPreview, SIGNAL(operationFinished()), this, SLOT(onOperationFinished()));
+    connect(htmlPreview, SIGNAL(markdownFlavorChanged(MarkdownFlavor)), highlighter, SLOT(setMarkdownFlavor(MarkdownFlavor)));
+    highlighter->setMarkdownFlavor(htmlPreview->getMarkdownFlavor());
 
     // Set dimensions for all the windows/HUDs.
     QSettings windowSettings;
@@ -422,6 +500,36 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
         sessionStatsHud->adjustSize();
     }
 
+    if (windowSettings.contains(GW_WRITING_HISTORY_HUD_GEOMETRY_KEY))
+    {
+        writingHistoryHud->restoreGeometry(windowSettings.value(GW_WRITING_HISTORY_HUD_GEOMETRY_KEY).toByteArray());
+    }
+    else
+    {
+        writingHistoryHud->move(400, 400);
+        writingHistoryHud->adjustSize();
+    }
+
+    if (windowSettings.contains(GW_PROBLEMS_HUD_GEOMETRY_KEY))
+    {
+        problemsHud->restoreGeometry(windowSettings.value(GW_PROBLEMS_HUD_GEOMETRY_KEY).toByteArray());
+    }
+    else
+    {
+        problemsHud->move(200, 200);
+        problemsHud->adjustSize();
+    }
+
+    if (windowSettings.contains(GW_MEMORY_DIAGNOSTICS_HUD_GEOMETRY_KEY))
+    {
+        memoryDiagnosticsHud->restoreGeometry(windowSettings.value(GW_MEMORY_DIAGNOSTICS_HUD_GEOMETRY_KEY).toByteArray());
+    }
+    else
+    {
+        memoryDiagnosticsHud->move(400, 400);
+        memoryDiagnosticsHud->adjustSize();
+    }
+
     if (windowSettings.contains(GW_HTML_PREVIEW_GEOMETRY_KEY))
     {
         htmlPreview->restoreGeometry(windowSettings.value(GW_HTML_PREVIEW_GEOMETRY_KEY).toByteArray());
@@ -455,11 +563,28 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
         sessionStatsHud->show();
     }
 
+    if (windowSettings.value(GW_WRITING_HISTORY_HUD_OPEN_KEY, QVariant(false)).toBool())
+    {
+        writingHistoryHud->show();
+    }
+
+    if (windowSettings.value(GW_PROBLEMS_HUD_OPEN_KEY, QVariant(false)).toBool())
+    {
+        problemsHud->show();
+    }
+
+    if (windowSettings.value(GW_MEMORY_DIAGNOSTICS_HUD_OPEN_KEY, QVariant(false)).toBool())
+    {
+        memoryDiagnosticsHud->show();
+    }
+
     if (windowSettings.value(GW_HTML_PREVIEW_OPEN, QVariant(false)).toBool())
     {
         htmlPreview->show();
     }
 
+    MemoryAccounting::getInstance()->addAccountable(this);
+
     // Apply the theme only after show() is called on all the widgets,
     // since the Outline scrollbars can end up transparent in Windows if
     // the theme is applied before show().
@@ -477,6 +602,8 @@ MainWindow::MainWindow(const QString& filePath, QWidget* parent)
 
 MainWindow::~MainWindow()
 {
+    MemoryAccounting::getInstance()->removeAccountable(this);
+
     if (NULL != htmlPreview)
     {
         delete htmlPreview;
@@ -574,10 +701,18 @@ void MainWindow::quitApplication()
         windowSettings.setValue(GW_DOCUMENT_STATISTICS_HUD_OPEN_KEY, QVariant(documentStatsHud->isVisible()));
         windowSettings.setValue(GW_SESSION_STATISTICS_HUD_GEOMETRY_KEY, sessionStatsHud->saveGeometry());
         windowSettings.setValue(GW_SESSION_STATISTICS_HUD_OPEN_KEY, QVariant(sessionStatsHud->isVisible()));
+        windowSettings.setValue(GW_WRITING_HISTORY_HUD_GEOMETRY_KEY, writingHistoryHud->saveGeometry());
+        windowSettings.setValue(GW_WRITING_HISTORY_HUD_OPEN_KEY, QVariant(writingHistoryHud->isVisible()));
+        windowSettings.setValue(GW_PROBLEMS_HUD_GEOMETRY_KEY, problemsHud->saveGeometry());
+        windowSettings.setValue(GW_PROBLEMS_HUD_OPEN_KEY, QVariant(problemsHud->isVisible()));
+        windowSettings.setValue(GW_MEMORY_DIAGNOSTICS_HUD_GEOMETRY_KEY, memoryDiagnosticsHud->saveGeometry());
+        windowSettings.setValue(GW_MEMORY_DIAGNOSTICS_HUD_OPEN_KEY, QVariant(memoryDiagnosticsHud->isVisible()));
         windowSettings.setValue(GW_HTML_PREVIEW_GEOMETRY_KEY, htmlPreview->saveGeometry());
         windowSettings.setValue(GW_HTML_PREVIEW_OPEN, QVariant(htmlPreview->isVisible()));
         windowSettings.sync();
 
+        writingHistory->close();
+
         DictionaryManager::instance().addProviders();
         DictionaryManager::instance().setDefaultLanguage(language);
 
@@ -703,6 +838,9 @@ void MainWindow::toggleOutlineAlternateRowColors(bool checked)
     cheatSheetWidget->setAlternatingRowColors(checked);
     documentStatsWidget->setAlternatingRowColors(checked);
     sessionStatsWidget->setAlternatingRowColors(checked);
+    writingHistoryWidget->setAlternatingRowColors(checked);
+    problemsWidget->setAlternatingRowColors(checked);
+    memoryDiagnosticsWidget->setAlternatingRowColors(checked);
     appSettings->setAlternateHudRowColorsEnabled(checked);
     applyTheme();
 }
@@ -713,6 +851,12 @@ void MainWindow::toggleLiveSpellCheck(bool checked)
     editor->setSpellCheckEnabled(checked);
 }
 
+void MainWindow::toggleLiveStyleCheck(bool checked)
+{
+    appSettings->setLiveStyleCheckEnabled(checked);
+    highlighter->setStyleCheckEnabled(checked);
+}
+
 void MainWindow::toggleFileHistoryEnabled(bool checked)
 {
     if (!checked)
@@ -730,6 +874,24 @@ void MainWindow::toggleLargeLeadingSizes(bool checked)
     appSettings->setLargeHeadingSizesEnabled(checked);
 }
 
+void MainWindow::toggleImagePreviews(bool checked)
+{
+    editor->setImagePreviewsEnabled(checked);
+    appSettings->setImagePreviewsEnabled(checked);
+}
+
+void MainWindow::toggleMinimap(bool checked)
+{
+    minimap->setVisible(checked);
+    appSettings->setMinimapEnabled(checked);
+}
+
+void MainWindow::togglePaintCache(bool checked)
+{
+    editor->setPaintCacheEnabled(checked);
+    appSettings->setPaintCacheEnabled(checked);
+}
+
 void MainWindow::toggleAutoMatch(bool checked)
 {
     editor->setAutoMatchEnabled(checked);
@@ -742,6 +904,12 @@ void MainWindow::toggleBulletPointCycling(bool checked)
     appSettings->setBulletPointCyclingEnabled(checked);
 }
 
+void MainWindow::toggleTableFormatting(bool checked)
+{
+    tableFormatter->setEnabled(checked);
+    appSettings->setTableFormattingEnabled(checked);
+}
+
 void MainWindow::toggleDisplayTimeInFullScreen(bool checked)
 {
     appSettings->setDisplayTimeInFullScreenEnabled(checked);
@@ -780,6 +948,15 @@ void MainWindow::toggleDesktopCompositingEffects(bool checked)
     cheatSheetHud->setDesktopCompositingEnabled(checked);
     documentStatsHud->setDesktopCompositingEnabled(checked);
     sessionStatsHud->setDesktopCompositingEnabled(checked);
+    writingHistoryHud->setDesktopCompositingEnabled(checked);
+    problemsHud->setDesktopCompositingEnabled(checked);
+    memoryDiagnosticsHud->setDesktopCompositingEnabled(checked);
+}
+
+void MainWindow::toggleRemotePreviewRendering(bool checked)
+{
+    appSettings->setRemotePreviewRenderingEnabled(checked);
+    htmlPreview->setRemoteRenderingEnabled(checked);
 }
 
 void MainWindow::insertImage()
@@ -789,7 +966,8 @@ void MainWindow::insertImage()
 
     if (!document->isNew())
     {
-        startingDirectory = QFileInfo(document->getFilePath()).dir().path();
+        startingDirectory =
+            fileAccess->startingDirectory(document->getFilePath());
     }
 
     QString imagePath =
@@ -869,6 +1047,9 @@ void MainWindow::changeHudButtonLayout(QAction* action)
     this->cheatSheetHud->setButtonLayout(layout);
     this->documentStatsHud->setButtonLayout(layout);
     this->sessionStatsHud->setButtonLayout(layout);
+    this->writingHistoryHud->setButtonLayout(layout);
+    this->problemsHud->setButtonLayout(layout);
+    this->memoryDiagnosticsHud->setButtonLayout(layout);
     appSettings->setHudButtonLayout(layout);
 }
 
@@ -947,6 +1128,31 @@ void MainWindow::showOutlineHud()
     outlineHud->activateWindow();
 }
 
+void MainWindow::showQuickJumpPalette()
+{
+    quickJumpPalette->clearCandidates();
+
+    for (int i = 0; i < MAX_RECENT_FILES; i++)
+    {
+        if (recentFilesActions[i]->isVisible())
+        {
+            quickJumpPalette->addFile(recentFilesActions[i]->text());
+        }
+    }
+
+    for (int i = 0; i < outlineWidget->count(); i++)
+    {
+        quickJumpPalette->addHeading
+        (
+            outlineWidget->getHeadingText(i),
+            outlineWidget->getHeadingPosition(i)
+        );
+    }
+
+    addQuickJumpCommands(this->menuBar()->actions(), QString());
+    quickJumpPalette->popup();
+}
+
 void MainWindow::showCheatSheetHud()
 {
     cheatSheetHud->show();
@@ -965,6 +1171,25 @@ void MainWindow::showSessionStatisticsHud()
     sessionStatsHud->activateWindow();
 }
 
+void MainWindow::showWritingHistoryHud()
+{
+    writingHistory->requestHistory();
+    writingHistoryHud->show();
+    writingHistoryHud->activateWindow();
+}
+
+void MainWindow::showProblemsHud()
+{
+    problemsHud->show();
+    problemsHud->activateWindow();
+}
+
+void MainWindow::showMemoryDiagnosticsHud()
+{
+    memoryDiagnosticsHud->show();
+    memoryDiagnosticsHud->activateWindow();
+}
+
 void MainWindow::onQuickRefGuideLinkClicked(const QUrl& url)
 {
     QDesktopServices::openUrl(url);
@@ -1047,30 +1272,51 @@ void MainWindow::openRecentFile()
 
 void MainWindow::refreshRecentFiles()
 {
+    // The menu is updated once the lookup of which recent files still
+    // exist finishes.  See onRecentFilesFound().
+    //
     if (appSettings->getFileHistoryEnabled())
     {
         DocumentHistory history;
-        QStringList recentFiles = history.getRecentFiles(MAX_RECENT_FILES + 1);
-        TextDocument* document = documentManager->getDocument();
+        fileAccess->findExistingFiles(history.getRecentFiles());
+    }
+}
 
-        if (!document->isNew())
-        {
-            QString sanitizedPath =
-                QFileInfo(document->getFilePath()).absoluteFilePath();
-            recentFiles.removeAll(sanitizedPath);
-        }
+void MainWindow::onRecentFilesFound(const QStringList& existingPaths)
+{
+    QStringList recentFiles = existingPaths;
+    TextDocument* document = documentManager->getDocument();
 
-        for (int i = 0; (i < MAX_RECENT_FILES) && (i < recentFiles.size()); i++)
-        {
-            recentFilesActions[i]->setText(recentFiles.at(i));
-            recentFilesActions[i]->setVisible(true);
-        }
+    // Reopen the last file of the previous session, unless the user has
+    // started writing in the meantime.
+    //
+    if (restoringLastFile)
+    {
+        restoringLastFile = false;
 
-        for (int i = recentFiles.size(); i < MAX_RECENT_FILES; i++)
+        if (!recentFiles.isEmpty() && document->isNew() && !document->isModified())
         {
-            recentFilesActions[i]->setVisible(false);
+            documentManager->open(recentFiles.first());
         }
     }
+
+    if (!document->isNew())
+    {
+        QString sanitizedPath =
+            QFileInfo(document->getFilePath()).absoluteFilePath();
+        recentFiles.removeAll(sanitizedPath);
+    }
+
+    for (int i = 0; (i < MAX_RECENT_FILES) && (i < recentFiles.size()); i++)
+    {
+        recentFilesActions[i]->setText(recentFiles.at(i));
+        recentFilesActions[i]->setVisible(true);
+    }
+
+    for (int i = recentFiles.size(); i < MAX_RECENT_FILES; i++)
+    {
+        recentFilesActions[i]->setVisible(false);
+    }
 }
 
 void MainWindow::clearRecentFileHistory()
@@ -1082,6 +1328,11 @@ void MainWindow::clearRecentFileHistory()
     {
         recentFilesActions[i]->setVisible(false);
     }
+
+    // Keep a lookup still pending from before the history was cleared from
+    // bringing the old entries back.
+    //
+    refreshRecentFiles();
 }
 
 void MainWindow::changeDocumentDisplayName(const QString& displayName)
@@ -1215,6 +1466,12 @@ void MainWindow::changeHudOpacity(int value)
     documentStatsHud->update();
     sessionStatsHud->setBackgroundColor(color);
     sessionStatsHud->update();
+    writingHistoryHud->setBackgroundColor(color);
+    writingHistoryHud->update();
+    problemsHud->setBackgroundColor(color);
+    problemsHud->update();
+    memoryDiagnosticsHud->setBackgroundColor(color);
+    memoryDiagnosticsHud->update();
 
     appSettings->setHudOpacity(value);
 }
@@ -1422,9 +1679,13 @@ void MainWindow::buildMenuBar()
 
     viewMenu->addAction(tr("&Preview in HTML"), this, SLOT(openHtmlPreview()), QKeySequence("CTRL+W"));
     viewMenu->addAction(tr("&Outline HUD"), this, SLOT(showOutlineHud()), QKeySequence("CTRL+L"));
+    viewMenu->addAction(tr("&Quick Jump..."), this, SLOT(showQuickJumpPalette()), QKeySequence("CTRL+J"));
     viewMenu->addAction(tr("&Cheat Sheet HUD"), this, SLOT(showCheatSheetHud()));
     viewMenu->addAction(tr("&Document Statistics HUD"), this, SLOT(showDocumentStatisticsHud()));
     viewMenu->addAction(tr("&Session Statistics HUD"), this, SLOT(showSessionStatisticsHud()));
+    viewMenu->addAction(tr("&Writing History HUD"), this, SLOT(showWritingHistoryHud()));
+    viewMenu->addAction(tr("&Problems HUD"), this, SLOT(showProblemsHud()));
+    viewMenu->addAction(tr("&Memory Diagnostics HUD"), this, SLOT(showMemoryDiagnosticsHud()));
     viewMenu->addSeparator();
 
     QMenu* settingsMenu = this->menuBar()->addMenu(tr("&Settings"));
@@ -1544,6 +1805,24 @@ void MainWindow::buildMenuBar()
     connect(largeHeadingsAction, SIGNAL(toggled(bool)), this, SLOT(toggleLargeLeadingSizes(bool)));
     settingsMenu->addAction(largeHeadingsAction);
 
+    QAction* imagePreviewsAction = new QAction(tr("Show Image Previews"), this);
+    imagePreviewsAction->setCheckable(true);
+    imagePreviewsAction->setChecked(appSettings->getImagePreviewsEnabled());
+    connect(imagePreviewsAction, SIGNAL(toggled(bool)), this, SLOT(toggleImagePreviews(bool)));
+    settingsMenu->addAction(imagePreviewsAction);
+
+    QAction* minimapAction = new QAction(tr("Show Minimap"), this);
+    minimapAction->setCheckable(true);
+    minimapAction->setChecked(appSettings->getMinimapEnabled());
+    connect(minimapAction, SIGNAL(toggled(bool)), this, SLOT(toggleMinimap(bool)));
+    settingsMenu->addAction(minimapAction);
+
+    QAction* paintCacheAction = new QAction(tr("Cache Rendered Text for Faster Scrolling"), this);
+    paintCacheAction->setCheckable(true);
+    paintCacheAction->setChecked(appSettings->getPaintCacheEnabled());
+    connect(paintCacheAction, SIGNAL(toggled(bool)), this, SLOT(togglePaintCache(bool)));
+    settingsMenu->addAction(paintCacheAction);
+
     bool underlineEnabled = appSettings->getUseUnderlineForEmphasis();
     QAction* underlineAction = new QAction(tr("Use Underline Instead of Italics for Emphasis"), this);
     underlineAction->setCheckable(true);
@@ -1567,6 +1846,12 @@ void MainWindow::buildMenuBar()
     connect(bulletCycleAction, SIGNAL(toggled(bool)), this, SLOT(toggleBulletPointCycling(bool)));
     settingsMenu->addAction(bulletCycleAction);
 
+    QAction* tableFormattingAction = new QAction(tr("Align Table Columns While Typing"), this);
+    tableFormattingAction->setCheckable(true);
+    tableFormattingAction->setChecked(appSettings->getTableFormattingEnabled());
+    connect(tableFormattingAction, SIGNAL(toggled(bool)), this, SLOT(toggleTableFormatting(bool)));
+    settingsMenu->addAction(tableFormattingAction);
+
     bool displayTimeEnabled = appSettings->getDisplayTimeInFullScreenEnabled();
     QAction* displayTimeAction = new QAction(tr("Display Current Time in Full Screen Mode"), this);
     displayTimeAction->setCheckable(true);
@@ -1582,6 +1867,12 @@ void MainWindow::buildMenuBar()
     connect(liveSpellcheckAction, SIGNAL(toggled(bool)), this, SLOT(toggleLiveSpellCheck(bool)));
     settingsMenu->addAction(liveSpellcheckAction);
 
+    QAction* liveStyleCheckAction = new QAction(tr("Live Style Check Enabled"), this);
+    liveStyleCheckAction->setCheckable(true);
+    liveStyleCheckAction->setChecked(appSettings->getLiveStyleCheckEnabled());
+    connect(liveStyleCheckAction, SIGNAL(toggled(bool)), this, SLOT(toggleLiveStyleCheck(bool)));
+    settingsMenu->addAction(liveStyleCheckAction);
+
     settingsMenu->addAction(tr("Dictionaries..."), this, SLOT(onSetDictionary()));
 
     settingsMenu->addAction(tr("Application Language..."), this, SLOT(onSetLocale()));
@@ -1630,6 +1921,9 @@ void MainWindow::buildMenuBar()
     cheatSheetWidget->setAlternatingRowColors(outlineAlternateColorsAction->isChecked());
     documentStatsWidget->setAlternatingRowColors(outlineAlternateColorsAction->isChecked());
     sessionStatsWidget->setAlternatingRowColors(outlineAlternateColorsAction->isChecked());
+    writingHistoryWidget->setAlternatingRowColors(outlineAlternateColorsAction->isChecked());
+    problemsWidget->setAlternatingRowColors(outlineAlternateColorsAction->isChecked());
+    memoryDiagnosticsWidget->setAlternatingRowColors(outlineAlternateColorsAction->isChecked());
 
     QMenu* hudButtonLayoutMenu = new QMenu(tr("HUD Window Button Layout"));
     QActionGroup* hudButtonLayoutGroup = new QActionGroup(this);
@@ -1659,11 +1953,22 @@ void MainWindow::buildMenuBar()
     cheatSheetHud->setDesktopCompositingEnabled(desktopCompositingAction->isChecked());
     documentStatsHud->setDesktopCompositingEnabled(desktopCompositingAction->isChecked());
     sessionStatsHud->setDesktopCompositingEnabled(desktopCompositingAction->isChecked());
+    writingHistoryHud->setDesktopCompositingEnabled(desktopCompositingAction->isChecked());
+    problemsHud->setDesktopCompositingEnabled(desktopCompositingAction->isChecked());
+    memoryDiagnosticsHud->setDesktopCompositingEnabled(desktopCompositingAction->isChecked());
     connect(desktopCompositingAction, SIGNAL(toggled(bool)), this, SLOT(toggleDesktopCompositingEffects(bool)));
     settingsMenu->addAction(desktopCompositingAction);
 
     settingsMenu->addAction(tr("HUD Window Opacity..."), this, SLOT(showHudOpacityDialog()));
 
+    settingsMenu->addSeparator();
+
+    QAction* remotePreviewAction = new QAction(tr("Render HTML Preview in Separate Process"), this);
+    remotePreviewAction->setCheckable(true);
+    remotePreviewAction->setChecked(appSettings->getRemotePreviewRenderingEnabled());
+    connect(remotePreviewAction, SIGNAL(toggled(bool)), this, SLOT(toggleRemotePreviewRendering(bool)));
+    settingsMenu->addAction(remotePreviewAction);
+
     QMenu* helpMenu = this->menuBar()->addMenu(tr("&Help"));
     helpMenu->addAction(tr("&About"), this, SLOT(showAbout()));
     helpMenu->addAction(tr("About &Qt"), qApp, SLOT(aboutQt()));
@@ -1683,6 +1988,46 @@ void MainWindow::buildMenuBar()
     connect(helpMenu, SIGNAL(aboutToHide()), effectsMenuBar, SLOT(onAboutToHide()));
 }
 
+void MainWindow::addQuickJumpCommands
+(
+    const QList<QAction*>& actions,
+    const QString& menuPath
+)
+{
+    foreach (QAction* action, actions)
+    {
+        if (action->isSeparator() || !action->isVisible())
+        {
+            continue;
+        }
+
+        QString text = action->text().remove(QChar('&'));
+
+        if (NULL != action->menu())
+        {
+            addQuickJumpCommands(action->menu()->actions(), menuPath + text + " > ");
+            continue;
+        }
+
+        // Recent files are listed as files instead.
+        bool isRecentFile = false;
+
+        for (int i = 0; i < MAX_RECENT_FILES; i++)
+        {
+            if (action == recentFilesActions[i])
+            {
+                isRecentFile = true;
+                break;
+            }
+        }
+
+        if (!isRecentFile && action->isEnabled())
+        {
+            quickJumpPalette->addCommand(action, menuPath + text);
+        }
+    }
+}
+
 void MainWindow::buildStatusBar()
 {
     statusBarWidget = new QFrame();
@@ -1965,6 +2310,14 @@ void MainWindow::applyTheme()
     );
     editor->setStyleSheet(styleSheet);
 
+    minimap->setColorScheme
+    (
+        theme.getDefaultTextColor(),
+        theme.getEditorBackgroundColor(),
+        theme.getMarkupColor(),
+        theme.getLinkColor()
+    );
+
     styleSheet = "";
 
     stream
@@ -1994,11 +2347,10 @@ void MainWindow::applyTheme()
 
     if (EditorAspectCenter == theme.getEditorAspect())
     {
-        QGraphicsDropShadowEffect* chromeDropShadowEffect = new QGraphicsDropShadowEffect();
+        CachedDropShadowEffect* chromeDropShadowEffect = new CachedDropShadowEffect();
         chromeDropShadowEffect->setColor(QColor(Qt::black));
         chromeDropShadowEffect->setBlurRadius(3.5);
-        chromeDropShadowEffect->setXOffset(1.0);
-        chromeDropShadowEffect->setYOffset(1.0);
+        chromeDropShadowEffect->setOffset(1.0, 1.0);
 
         this->statusBar()->setGraphicsEffect(chromeDropShadowEffect);
         effectsMenuBar->setDropShadow(Qt::black, 3.5, 1.0, 1.0);
@@ -2011,7 +2363,9 @@ void MainWindow::applyTheme()
 
     styleSheet = "";
 
-    // Wipe out old background image drawing material.
+    // Wipe out old background image drawing material.  The background
+    // color is shown until the new image has been loaded.
+    //
     originalBackgroundImage = QImage();
     adjustedBackgroundImage = QImage();
 
@@ -2021,9 +2375,11 @@ void MainWindow::applyTheme()
         !theme.getBackgroundImageUrl().isEmpty()
     )
     {
-        // Predraw background image for paintEvent()
-        originalBackgroundImage.load(theme.getBackgroundImageUrl());
-        predrawBackgroundImage();
+        backgroundImageLoader->load
+        (
+            theme,
+            BackgroundImageLoader::largestScreenSize()
+        );
     }
 
     stream
@@ -2105,6 +2461,12 @@ void MainWindow::applyTheme()
     documentStatsHud->setBackgroundColor(alphaHudBackgroundColor);
     sessionStatsHud->setForegroundColor(theme.getHudForegroundColor());
     sessionStatsHud->setBackgroundColor(alphaHudBackgroundColor);
+    writingHistoryHud->setForegroundColor(theme.getHudForegroundColor());
+    writingHistoryHud->setBackgroundColor(alphaHudBackgroundColor);
+    problemsHud->setForegroundColor(theme.getHudForegroundColor());
+    problemsHud->setBackgroundColor(alphaHudBackgroundColor);
+    memoryDiagnosticsHud->setForegroundColor(theme.getHudForegroundColor());
+    memoryDiagnosticsHud->setBackgroundColor(alphaHudBackgroundColor);
 
     // Style the outline itself.
     alphaHudBackgroundColor.setAlpha(0);
@@ -2118,25 +2480,25 @@ void MainWindow::applyTheme()
 
     int hudFontSize = cheatSheetWidget->font().pointSize();
 
-    // Important!  For QListWidget (used in Outline HUD), set
-    // QListWidget { outline: none } for the style sheet to get rid of the
+    // Important!  For QListView (used in Outline and Problems HUDs), set
+    // QListView { outline: none } for the style sheet to get rid of the
     // focus rectangle without losing keyboard focus capability.
     // Unforntunately, this property isn't in the Qt documentation, so
     // it's being documented here for posterity's sake.
     //
     if (outlineWidget->alternatingRowColors())
     {
-        stream << "QListWidget { outline: none; border: 0; padding: 1; background-color: transparent; color: "
+        stream << "QListView { outline: none; border: 0; padding: 1; background-color: transparent; color: "
                << hudFgString
                << "; alternate-background-color: rgba(255, 255, 255, 50)"
                << "; font-size: "
                << hudFontSize
-               << "pt } QListWidget::item { padding: 1 0 1 0; margin: 0; background-color: "
+               << "pt } QListView::item { padding: 1 0 1 0; margin: 0; background-color: "
                << "rgba(0, 0, 0, 10)"
-               << " } QListWidget::item:alternate { padding: 1; margin: 0; background-color: "
+               << " } QListView::item:alternate { padding: 1; margin: 0; background-color: "
                << "rgba(255, 255, 255, 10)"
                << " } "
-               << "QListWidget::item:selected { border-radius: 3px; color: "
+               << "QListView::item:selected { border-radius: 3px; color: "
                << hudSelectionFgString
                << "; background-color: "
                << hudSelectionBgString
@@ -2145,12 +2507,12 @@ void MainWindow::applyTheme()
     }
     else
     {
-        stream << "QListWidget { outline: none; border: 0; padding: 1; background-color: transparent; color: "
+        stream << "QListView { outline: none; border: 0; padding: 1; background-color: transparent; color: "
                << hudFgString
                << "; font-size: "
                << hudFontSize
-               << "pt  } QListWidget::item { padding: 1 0 1 0; margin: 0; background-color: transparent } "
-               << "QListWidget::item:selected { border-radius: 3px; color: "
+               << "pt  } QListView::item { padding: 1 0 1 0; margin: 0; background-color: transparent } "
+               << "QListView::item:selected { border-radius: 3px; color: "
                << hudSelectionFgString
                << "; background-color: "
                << hudSelectionBgString
@@ -2179,10 +2541,36 @@ void MainWindow::applyTheme()
     cheatSheetWidget->setStyleSheet(styleSheet);
     documentStatsWidget->setStyleSheet(styleSheet);
     sessionStatsWidget->setStyleSheet(styleSheet);
+    writingHistoryWidget->setStyleSheet(styleSheet);
+    problemsWidget->setStyleSheet(styleSheet);
+    memoryDiagnosticsWidget->setStyleSheet(styleSheet);
 
     editor->setupPaperMargins(this->width());
 }
 
+void MainWindow::onBackgroundImageLoaded
+(
+    const QString& imagePath,
+    PictureAspect aspect,
+    const QImage& image
+)
+{
+    // Ignore images of themes that are no longer applied.
+    if
+    (
+        (imagePath != theme.getBackgroundImageUrl()) ||
+        (aspect != theme.getBackgroundImageAspect()) ||
+        image.isNull()
+    )
+    {
+        return;
+    }
+
+    originalBackgroundImage = image;
+    predrawBackgroundImage();
+    update();
+}
+
 // Lifted from FocusWriter's theme.cpp file
 void MainWindow::predrawBackgroundImage()
 {
@@ -2249,3 +2637,22 @@ void MainWindow::predrawBackgroundImage()
         painter.end();
     }
 }
+
+void MainWindow::accountMemory(QList<MemoryUsage>& usage) const
+{
+    MemoryUsage images(GW_MEMORY_BACKGROUND_IMAGES);
+
+    if (!originalBackgroundImage.isNull())
+    {
+        images.objectCount++;
+        images.estimatedBytes += originalBackgroundImage.byteCount();
+    }
+
+    if (!adjustedBackgroundImage.isNull())
+    {
+        images.objectCount++;
+        images.estimatedBytes += adjustedBackgroundImage.byteCount();
+    }
+
+    usage.append(images);
+}
@@ -27,10 +27,11 @@
 #include <QAction>
 #include <QLabel>
 #include <QGraphicsColorizeEffect>
-#include <QGraphicsDropShadowEffect>
 
+#include "CachedDropShadowEffect.h"
 #include "MarkdownEditor.h"
 #include "HtmlPreview.h"
+#include "MemoryAccounting.h"
 #include "ThemeFactory.h"
 #include "HtmlPreview.h"
 #include "AppSettings.h"
@@ -55,11 +56,21 @@ class DocumentStatistics;
 class DocumentStatisticsWidget;
 class SessionStatistics;
 class SessionStatisticsWidget;
+class WritingHistory;
+class WritingHistoryWidget;
+class AsyncFileAccess;
+class MarkdownLinter;
+class ProblemsPanel;
+class MemoryDiagnosticsWidget;
+class DocumentMinimap;
+class BackgroundImageLoader;
+class PipeTableFormatter;
+class QuickJumpPalette;
 
 /**
  * Main window for the application.
  */
-class MainWindow : public QMainWindow
+class MainWindow : public QMainWindow, public MemoryAccountable
 {
     Q_OBJECT
 
@@ -76,6 +87,7 @@ class MainWindow : public QMainWindow
 
     private slots:
         void quitApplication();
+        void onBackgroundImageLoaded(const QString& imagePath, PictureAspect aspect, const QImage& image);
         void changeTheme();
         void showFindReplaceDialog();
         void toggleHemingwayMode(bool checked);
@@ -84,14 +96,20 @@ class MainWindow : public QMainWindow
         void toggleHideMenuBarInFullScreen(bool checked);
         void toggleOutlineAlternateRowColors(bool checked);
         void toggleLiveSpellCheck(bool checked);
+        void toggleLiveStyleCheck(bool checked);
         void toggleFileHistoryEnabled(bool checked);
         void toggleLargeLeadingSizes(bool checked);
+        void toggleImagePreviews(bool checked);
+        void toggleMinimap(bool checked);
+        void togglePaintCache(bool checked);
         void toggleAutoMatch(bool checked);
         void toggleBulletPointCycling(bool checked);
+        void toggleTableFormatting(bool checked);
         void toggleDisplayTimeInFullScreen(bool checked);
         void toggleUseUnderlineForEmphasis(bool checked);
         void toggleSpacesForTabs(bool checked);
         void toggleDesktopCompositingEffects(bool checked);
+        void toggleRemotePreviewRendering(bool checked);
         void insertImage();
         void changeTabulationWidth();
         void changeEditorWidth(QAction* action);
@@ -102,6 +120,10 @@ class MainWindow : public QMainWindow
         void showCheatSheetHud();
         void showDocumentStatisticsHud();
         void showSessionStatisticsHud();
+        void showWritingHistoryHud();
+        void showProblemsHud();
+        void showMemoryDiagnosticsHud();
+        void showQuickJumpPalette();
         void onQuickRefGuideLinkClicked(const QUrl& url);
         void showAbout();
         void updateWordCount(int newWordCount);
@@ -110,6 +132,7 @@ class MainWindow : public QMainWindow
         void openHtmlPreview();
         void openRecentFile();
         void refreshRecentFiles();
+        void onRecentFilesFound(const QStringList& existingPaths);
         void clearRecentFileHistory();
         void changeDocumentDisplayName(const QString& displayName);
         void onOperationStarted(const QString& description);
@@ -123,6 +146,8 @@ class MainWindow : public QMainWindow
 
 	private:
         MarkdownEditor* editor;
+        DocumentMinimap* minimap;
+        PipeTableFormatter* tableFormatter;
         MarkdownHighlighter* highlighter;
         DocumentManager* documentManager;
         ThemeFactory* themeFactory;
@@ -144,14 +169,26 @@ class MainWindow : public QMainWindow
         HudWindow* cheatSheetHud;
         HudWindow* documentStatsHud;
         HudWindow* sessionStatsHud;
+        HudWindow* writingHistoryHud;
+        HudWindow* problemsHud;
+        HudWindow* memoryDiagnosticsHud;
         DocumentStatistics* documentStats;
         DocumentStatisticsWidget* documentStatsWidget;
         SessionStatistics* sessionStats;
         SessionStatisticsWidget* sessionStatsWidget;
+        WritingHistory* writingHistory;
+        WritingHistoryWidget* writingHistoryWidget;
+        MarkdownLinter* linter;
+        ProblemsPanel* problemsWidget;
+        MemoryDiagnosticsWidget* memoryDiagnosticsWidget;
+        QuickJumpPalette* quickJumpPalette;
         QListWidget* cheatSheetWidget;
+        BackgroundImageLoader* backgroundImageLoader;
         QImage originalBackgroundImage;
         QImage adjustedBackgroundImage;
         QFileSystemWatcher* fileWatcher;
+        AsyncFileAccess* fileAccess;
+        bool restoringLastFile;
         QDialog* hudOpacityDialog = NULL;
         QAction* recentFilesActions[MAX_RECENT_FILES];
         EffectsMenuBar* effectsMenuBar;
@@ -172,10 +209,12 @@ class MainWindow : public QMainWindow
         );
 
         void buildMenuBar();
+        void addQuickJumpCommands(const QList<QAction*>& actions, const QString& menuPath);
         void buildStatusBar();
 
         void applyTheme();
         void predrawBackgroundImage();
+        void accountMemory(QList<MemoryUsage>& usage) const;
 };
 
 #endif
@@ -19,6 +19,9 @@
  *
  ***********************************************************************/
 
+#include <math.h>
+
+#include <QAbstractTextDocumentLayout>
 #include <QTextStream>
 #include <QString>
 #include <QMimeData>
@@ -37,16 +40,41 @@
 #include <QPainter>
 #include <QFileInfo>
 #include <QDir>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <QPaintEvent>
+#include <QTextBlock>
+#include <QTextLayout>
+#include <QWheelEvent>
 
 #include "ColorHelper.h"
 #include "MarkdownEditor.h"
 #include "MarkdownStates.h"
 #include "MarkdownTokenizer.h"
 #include "GraphicsFadeEffect.h"
+#include "StyleChecker.h"
+#include "TextBlockData.h"
+#include "TextDocumentLayout.h"
 #include "spelling/dictionary_ref.h"
 #include "spelling/dictionary_manager.h"
 #include "spelling/spell_checker.h"
 
+// Maximum size of the image previews shown beneath lines, and the vertical
+// margin around them.
+//
+#define GW_IMAGE_PREVIEW_WIDTH 320
+#define GW_IMAGE_PREVIEW_HEIGHT 240
+#define GW_IMAGE_PREVIEW_MARGIN 8
+
+// Number of blocks above and below the visible area of the editor for
+// which image previews are decoded ahead of time, so that they are usually
+// ready by the time they are scrolled into view.
+//
+#define GW_IMAGE_PREVIEW_LOOKAHEAD 25
+
+// Maximum size of the cache of rendered blocks, in kilobytes.
+#define GW_PAINT_CACHE_SIZE 32768
+
 MarkdownEditor::MarkdownEditor
 (
     TextDocument* textDocument,
@@ -59,11 +87,18 @@ MarkdownEditor::MarkdownEditor
         dictionary(DictionaryManager::instance().requestDictionary()),
         autoMatchEnabled(true),
         bulletPointCyclingEnabled(true),
-        mouseButtonDown(false)
+        mouseButtonDown(false),
+        paintCacheEnabled(false),
+        paintCache(GW_PAINT_CACHE_SIZE),
+        nextPaintCacheId(1),
+        paintCacheStyleGeneration(0)
 {
     setDocument(textDocument);
     setAcceptDrops(true);
 
+    annotatedScrollBar = new AnnotatedScrollBar(this);
+    setVerticalScrollBar(annotatedScrollBar);
+
     preferredLayout = new QGridLayout();
     preferredLayout->setSpacing(0);
     preferredLayout->setMargin(0);
@@ -144,6 +179,35 @@ MarkdownEditor::MarkdownEditor
     fadeEffect = new GraphicsFadeEffect(this);
     fadeEffect->setFadeHeight(this->fontMetrics().height());
     viewport()->setGraphicsEffect(fadeEffect);
+
+    imagePreviewsEnabled = false;
+    thumbnailCache =
+        new ImageThumbnailCache
+        (
+            QSize(GW_IMAGE_PREVIEW_WIDTH, GW_IMAGE_PREVIEW_HEIGHT),
+            this
+        );
+
+    imagePreviewTimer = new QTimer(this);
+    imagePreviewTimer->setSingleShot(true);
+    imagePreviewTimer->setInterval(0);
+    connect(imagePreviewTimer, SIGNAL(timeout()), this, SLOT(updateImagePreviewHeights()));
+
+    connect(thumbnailCache, SIGNAL(thumbnailReady(QString)), this, SLOT(onThumbnailReady()));
+    connect(this, SIGNAL(updateRequest(QRect,int)), this, SLOT(scheduleImagePreviewUpdate()));
+    connect(textDocument, SIGNAL(filePathChanged()), this, SLOT(clearImagePreviews()));
+
+    // Note that the syntax highlighter marks the blocks whose formats it
+    // changes as changed, so restyled blocks are dropped from the cache
+    // as well.
+    //
+    connect
+    (
+        textDocument,
+        SIGNAL(contentsChange(int,int,int)),
+        this,
+        SLOT(invalidatePaintCache(int,int,int))
+    );
 }
 
 MarkdownEditor::~MarkdownEditor()
@@ -223,6 +287,13 @@ void MarkdownEditor::setColorScheme
 
     fadeColor = QBrush(fadedForegroundColor);
     focusText();
+
+    annotatedScrollBar->setAnnotationColor(AnnotatedScrollBar::AnnotationHeading, fadedForegroundColor);
+    annotatedScrollBar->setAnnotationColor(AnnotatedScrollBar::AnnotationSpellingError, spellingErrorColor);
+    annotatedScrollBar->setAnnotationColor(AnnotatedScrollBar::AnnotationLint, markupColor);
+    annotatedScrollBar->setAnnotationColor(AnnotatedScrollBar::AnnotationSearchMatch, linkColor);
+
+    paintCacheStyleGeneration++;
 }
 
 void MarkdownEditor::setAspect(EditorAspect aspect)
@@ -237,6 +308,7 @@ void MarkdownEditor::setFont(const QString& family, double pointSize)
     highlighter->setFont(family, pointSize);
     setTabulationWidth(tabWidth);
     fadeEffect->setFadeHeight(this->fontMetrics().height());
+    paintCacheStyleGeneration++;
 }
 
 void MarkdownEditor::setAutoMatchEnabled(const QChar openingCharacter, bool enabled)
@@ -372,6 +444,80 @@ void MarkdownEditor::dropEvent(QDropEvent* e)
     }
 }
 
+/*
+ * QPlainTextEdit scrolls by a fixed number of lines per wheel step, so a
+ * step over a block with an image preview beneath it jumps by the entire
+ * height of the preview on top of those lines.  Instead, scroll to the line
+ * at the system's number of lines of text away in pixels, using the
+ * document layout's block height index to find it in logarithmic time.
+ * The scroll bar counts lines, so the distance is rounded to a whole line,
+ * and a preview taller than a step is scrolled past in a single step.
+ */
+void MarkdownEditor::wheelEvent(QWheelEvent* event)
+{
+    TextDocumentLayout* layout =
+        qobject_cast<TextDocumentLayout*>(document()->documentLayout());
+
+#if QT_VERSION >= 0x050000
+    int delta = event->angleDelta().y();
+    bool vertical = (0 == event->angleDelta().x());
+#else
+    int delta = event->delta();
+    bool vertical = (Qt::Vertical == event->orientation());
+#endif
+
+    QTextBlock block = firstVisibleBlock();
+
+    if
+    (
+        (NULL == layout) ||
+        !vertical ||
+        (0 == delta) ||
+        (Qt::NoModifier != event->modifiers()) ||
+        !block.isValid()
+    )
+    {
+        QPlainTextEdit::wheelEvent(event);
+        return;
+    }
+
+    QScrollBar* scrollBar = verticalScrollBar();
+
+    // Find the y coordinate of the line at the top of the viewport.
+    int lineInBlock = scrollBar->value() - block.firstLineNumber();
+    int top = layout->blockTop(block.blockNumber());
+
+    if
+    (
+        (NULL != block.layout()) &&
+        (lineInBlock > 0) &&
+        (lineInBlock < block.layout()->lineCount())
+    )
+    {
+        top += qRound(block.layout()->lineAt(lineInBlock).y());
+    }
+
+    // A wheel step of 120 eighths of a degree scrolls by the system's
+    // number of lines of text.
+    //
+    qreal distance = -delta / 120.0
+        * QApplication::wheelScrollLines()
+        * fontMetrics().lineSpacing();
+
+    int value = layout->lineNumberAt(qMax(0, qRound(top + distance)));
+
+    // Always move by at least one line, even when the step ends within the
+    // line (or the image preview) at the top.
+    //
+    if (value == scrollBar->value())
+    {
+        value += (delta < 0) ? 1 : -1;
+    }
+
+    scrollBar->setValue(value);
+    event->accept();
+}
+
 /*
  * This method contains a code snippet that was lifted and modified from ReText
  */
@@ -445,8 +591,379 @@ void MarkdownEditor::keyPressEvent(QKeyEvent* e)
     }
 }
 
+void MarkdownEditor::paintEvent(QPaintEvent* event)
+{
+    if (paintCacheEnabled)
+    {
+        paintBlocks(event);
+    }
+    else
+    {
+        QPlainTextEdit::paintEvent(event);
+    }
+
+    if (!imagePreviewsEnabled)
+    {
+        return;
+    }
+
+    QPainter painter(viewport());
+    QPointF offset = contentOffset();
+    QTextBlock block = firstVisibleBlock();
+
+    while (block.isValid())
+    {
+        QRectF blockRect = blockBoundingGeometry(block).translated(offset);
+
+        if (blockRect.top() > event->rect().bottom())
+        {
+            break;
+        }
+
+        TextBlockData* blockData = (TextBlockData*) block.userData();
+
+        if
+        (
+            (NULL != blockData)
+            && (blockData->imagePreviewHeight > 0)
+            && (blockRect.bottom() >= event->rect().top())
+        )
+        {
+            QPixmap preview = imagePreview(block);
+
+            if (!preview.isNull())
+            {
+                painter.drawPixmap
+                (
+                    QPointF
+                    (
+                        blockRect.left() + document()->documentMargin(),
+                        blockRect.top()
+                            + block.layout()->boundingRect().height()
+                            + GW_IMAGE_PREVIEW_MARGIN
+                    ),
+                    preview
+                );
+            }
+        }
+
+        block = block.next();
+    }
+}
+
+/*
+ * Paints the visible blocks the way QPlainTextEdit::paintEvent() does,
+ * except that blocks without the text cursor, a selection or input method
+ * text are painted from the paint cache.
+ */
+void MarkdownEditor::paintBlocks(QPaintEvent* event)
+{
+    QPainter painter(viewport());
+    QPointF offset = contentOffset();
+    QRect eventRect = event->rect();
+    QRect viewportRect = viewport()->rect();
+    bool editable = !isReadOnly();
+    QTextBlock block = firstVisibleBlock();
+    qreal maximumWidth = document()->documentLayout()->documentSize().width();
+
+    painter.setBrushOrigin(offset);
+
+    // Keep the right margin clear of full width selections.
+    int maxX = offset.x()
+        + qMax((qreal) viewportRect.width(), maximumWidth)
+        - document()->documentMargin();
+
+    eventRect.setRight(qMin(eventRect.right(), maxX));
+    painter.setClipRect(eventRect);
+
+    QAbstractTextDocumentLayout::PaintContext context = getPaintContext();
+
+    while (block.isValid())
+    {
+        QRectF blockRect = blockBoundingRect(block).translated(offset);
+        QTextLayout* layout = block.layout();
+
+        if (!block.isVisible())
+        {
+            offset.ry() += blockRect.height();
+            block = block.next();
+            continue;
+        }
+
+        if
+        (
+            (blockRect.bottom() >= eventRect.top()) &&
+            (blockRect.top() <= eventRect.bottom())
+        )
+        {
+            QBrush background = block.blockFormat().background();
+
+            if (Qt::NoBrush != background.style())
+            {
+                QRectF contentsRect = blockRect;
+                contentsRect.setWidth(qMax(blockRect.width(), maximumWidth));
+                fillBackground(&painter, contentsRect, background);
+            }
+
+            QVector<QTextLayout::FormatRange> selections;
+            int blockPosition = block.position();
+            int blockLength = block.length();
+
+            for (int i = 0; i < context.selections.size(); i++)
+            {
+                const QAbstractTextDocumentLayout::Selection& range =
+                    context.selections.at(i);
+                int selectionStart = range.cursor.selectionStart() - blockPosition;
+                int selectionEnd = range.cursor.selectionEnd() - blockPosition;
+
+                if
+                (
+                    (selectionStart < blockLength) &&
+                    (selectionEnd > 0) &&
+                    (selectionEnd > selectionStart)
+                )
+                {
+                    QTextLayout::FormatRange formatRange;
+                    formatRange.start = selectionStart;
+                    formatRange.length = selectionEnd - selectionStart;
+                    formatRange.format = range.format;
+                    selections.append(formatRange);
+                }
+                else if
+                (
+                    !range.cursor.hasSelection() &&
+                    range.format.hasProperty(QTextFormat::FullWidthSelection) &&
+                    block.contains(range.cursor.position())
+                )
+                {
+                    // Full width selections only need a position to
+                    // specify the line.
+                    //
+                    QTextLine line =
+                        layout->lineForTextPosition
+                        (
+                            range.cursor.position() - blockPosition
+                        );
+
+                    QTextLayout::FormatRange formatRange;
+                    formatRange.start = line.textStart();
+                    formatRange.length = line.textLength();
+
+                    if ((formatRange.start + formatRange.length) == (blockLength - 1))
+                    {
+                        // Include the newline.
+                        formatRange.length++;
+                    }
+
+                    formatRange.format = range.format;
+                    selections.append(formatRange);
+                }
+            }
+
+            bool hasCursor =
+                (editable || (textInteractionFlags() & Qt::TextSelectableByKeyboard))
+                && (textCursor().block() == block);
+            bool hasPreedit = !layout->preeditAreaText().isEmpty();
+            QPixmap cached;
+
+            if (selections.isEmpty() && !hasCursor && !hasPreedit)
+            {
+                cached = cachedBlockPaint(block, painter.pen());
+            }
+
+            if (!cached.isNull())
+            {
+                painter.drawPixmap(blockRect.topLeft(), cached);
+            }
+            else
+            {
+                layout->draw(&painter, offset, selections, eventRect);
+
+                bool drawCursor =
+                    hasCursor
+                    && (context.cursorPosition >= blockPosition)
+                    && (context.cursorPosition < (blockPosition + blockLength));
+
+                if
+                (
+                    drawCursor ||
+                    (editable && (context.cursorPosition < -1) && hasPreedit)
+                )
+                {
+                    int cursorPosition = context.cursorPosition;
+
+                    if (cursorPosition < -1)
+                    {
+                        cursorPosition =
+                            layout->preeditAreaPosition() - (cursorPosition + 2);
+                    }
+                    else
+                    {
+                        cursorPosition -= blockPosition;
+                    }
+
+                    layout->drawCursor(&painter, offset, cursorPosition, cursorWidth());
+                }
+            }
+        }
+
+        offset.ry() += blockRect.height();
+
+        if (offset.y() > viewportRect.height())
+        {
+            break;
+        }
+
+        block = block.next();
+    }
+
+    if
+    (
+        backgroundVisible() &&
+        !block.isValid() &&
+        (offset.y() <= eventRect.bottom()) &&
+        (
+            centerOnScroll() ||
+            (verticalScrollBar()->maximum() == verticalScrollBar()->value())
+        )
+    )
+    {
+        painter.fillRect
+        (
+            QRect(QPoint(eventRect.left(), (int) offset.y()), eventRect.bottomRight()),
+            palette().brush(QPalette::Window)
+        );
+    }
+}
+
+/*
+ * Returns the rendered text of the given block from the paint cache,
+ * rendering it first if the cached pixmap is missing or stale.  Returns a
+ * null pixmap if the block cannot be cached.
+ */
+QPixmap MarkdownEditor::cachedBlockPaint(const QTextBlock& block, const QPen& pen)
+{
+    TextBlockData* blockData = (TextBlockData*) block.userData();
+
+    if (NULL == blockData)
+    {
+        return QPixmap();
+    }
+
+#if QT_VERSION >= 0x050600
+    qreal devicePixelRatio = viewport()->devicePixelRatioF();
+#elif QT_VERSION >= 0x050000
+    qreal devicePixelRatio = viewport()->devicePixelRatio();
+#else
+    qreal devicePixelRatio = 1.0;
+#endif
+
+    qreal textWidth = document()->textWidth();
+
+    if (blockData->paintCacheId > 0)
+    {
+        CachedBlockPaint* entry = paintCache.object(blockData->paintCacheId);
+
+        if
+        (
+            (NULL != entry) &&
+            (entry->revision == block.revision()) &&
+            (entry->styleGeneration == paintCacheStyleGeneration) &&
+            (entry->textWidth == textWidth) &&
+            (entry->devicePixelRatio == devicePixelRatio)
+        )
+        {
+            return entry->pixmap;
+        }
+    }
+    else
+    {
+        blockData->paintCacheId = nextPaintCacheId++;
+    }
+
+    // Leave out the space reserved beneath the text for an image preview.
+    QTextLayout* layout = block.layout();
+    QRectF textRect = layout->boundingRect();
+    int width = (int) ceil(qMax(blockBoundingRect(block).width(), textRect.right()));
+    int height = (int) ceil(textRect.bottom());
+
+    if ((width <= 0) || (height <= 0))
+    {
+        return QPixmap();
+    }
+
+    QPixmap pixmap
+    (
+        (int) ceil(width * devicePixelRatio),
+        (int) ceil(height * devicePixelRatio)
+    );
+
+#if QT_VERSION >= 0x050000
+    pixmap.setDevicePixelRatio(devicePixelRatio);
+#endif
+
+    pixmap.fill(Qt::transparent);
+
+    QPainter painter(&pixmap);
+    painter.setPen(pen);
+    layout->draw(&painter, QPointF(0, 0));
+    painter.end();
+
+    CachedBlockPaint* entry = new CachedBlockPaint();
+    entry->pixmap = pixmap;
+    entry->revision = block.revision();
+    entry->styleGeneration = paintCacheStyleGeneration;
+    entry->textWidth = textWidth;
+    entry->devicePixelRatio = devicePixelRatio;
+
+    // The cost is the size of the pixmap in kilobytes.  Note that the
+    // cache deletes the entry right away if it is too large to be cached.
+    //
+    paintCache.insert
+    (
+        blockData->paintCacheId,
+        entry,
+        qMax(1, (pixmap.width() * pixmap.height() * 4) / 1024)
+    );
+
+    return pixmap;
+}
+
 bool MarkdownEditor::eventFilter(QObject* watched, QEvent* event)
 {
+    // Describe the style issue under the mouse, if any.
+    if ((event->type() == QEvent::ToolTip) && (watched == this->viewport()))
+    {
+        QHelpEvent* helpEvent = static_cast<QHelpEvent*>(event);
+        QTextCursor cursor = cursorForPosition(helpEvent->pos());
+        TextBlockData* blockData = (TextBlockData*) cursor.block().userData();
+        int blockPosition = cursor.positionInBlock();
+        QString toolTip;
+
+        if (NULL != blockData)
+        {
+            foreach (const StyleIssue& issue, blockData->styleIssues)
+            {
+                if
+                (
+                    (blockPosition >= issue.position) &&
+                    (blockPosition < (issue.position + issue.length))
+                )
+                {
+                    toolTip = StyleChecker::ruleDescription(issue.rule);
+                    break;
+                }
+            }
+        }
+
+        // Otherwise, let the tool tip event through for default handling.
+        if (!toolTip.isEmpty())
+        {
+            QToolTip::showText(helpEvent->globalPos(), toolTip, this->viewport());
+            return true;
+        }
+    }
+
     if (event->type() == QEvent::MouseButtonPress)
     {
         mouseButtonDown = true;
@@ -1098,6 +1615,43 @@ void MarkdownEditor::setSpellCheckEnabled(const bool enabled)
     highlighter->setSpellCheckEnabled(enabled);
 }
 
+void MarkdownEditor::setImagePreviewsEnabled(bool enabled)
+{
+    imagePreviewsEnabled = enabled;
+
+    if (!enabled)
+    {
+        clearImagePreviews();
+        thumbnailCache->clear();
+    }
+    else
+    {
+        scheduleImagePreviewUpdate();
+    }
+}
+
+void MarkdownEditor::setPaintCacheEnabled(bool enabled)
+{
+    paintCacheEnabled = enabled;
+
+    if (!enabled)
+    {
+        paintCache.clear();
+    }
+
+    viewport()->update();
+}
+
+void MarkdownEditor::setSearchMatches(const QList<int>& positions)
+{
+    annotatedScrollBar->setSearchMatches(positions);
+}
+
+void MarkdownEditor::refreshAnnotations()
+{
+    annotatedScrollBar->refreshAnnotations();
+}
+
 void MarkdownEditor::suggestSpelling(QAction* action)
 {
     if (action == addWordToDictionaryAction)
@@ -1292,6 +1846,70 @@ void MarkdownEditor::onCursorPositionChanged()
     emit cursorPositionChanged(this->textCursor().position());
 }
 
+void MarkdownEditor::invalidatePaintCache
+(
+    int position,
+    int charsRemoved,
+    int charsAdded
+)
+{
+    Q_UNUSED(charsRemoved)
+
+    if (paintCache.isEmpty())
+    {
+        return;
+    }
+
+    QTextBlock block = document()->findBlock(position);
+    QTextBlock last = document()->findBlock(position + charsAdded);
+
+    while (block.isValid())
+    {
+        TextBlockData* blockData = (TextBlockData*) block.userData();
+
+        if ((NULL != blockData) && (blockData->paintCacheId > 0))
+        {
+            paintCache.remove(blockData->paintCacheId);
+        }
+
+        if (block == last)
+        {
+            break;
+        }
+
+        block = block.next();
+    }
+}
+
+void MarkdownEditor::onThumbnailReady()
+{
+    // Make room for the new preview, which is then painted along with the
+    // blocks that move down to make room for it.
+    //
+    scheduleImagePreviewUpdate();
+}
+
+void MarkdownEditor::scheduleImagePreviewUpdate()
+{
+    if (imagePreviewsEnabled && !imagePreviewTimer->isActive())
+    {
+        imagePreviewTimer->start();
+    }
+}
+
+void MarkdownEditor::clearImagePreviews()
+{
+    QTextBlock block = document()->begin();
+
+    while (block.isValid())
+    {
+        setImagePreviewHeight(block, 0);
+        block = block.next();
+    }
+
+    scheduleImagePreviewUpdate();
+}
+
 void MarkdownEditor::handleCarriageReturn()
 {
     QString autoInsertText = "";
@@ -1708,3 +2326,137 @@ QString MarkdownEditor::getPriorMarkdownBlockItemStart(QRegExp& itemRegex)
 
     return QString("");
 }
+
+QString MarkdownEditor::imageFilePath(const QString& destination) const
+{
+    // Note that only the path strings are examined here, since the file
+    // system is never accessed from the GUI thread.  Also, check for an
+    // absolute path first, since Windows drive letters would otherwise be
+    // mistaken for URL schemes.
+    //
+    if (QFileInfo(destination).isAbsolute())
+    {
+        return QDir::cleanPath(destination);
+    }
+
+    QUrl url(destination);
+
+    if (url.isLocalFile())
+    {
+        return QDir::cleanPath(url.toLocalFile());
+    }
+
+    // Remote images are not previewed.
+    if (!url.scheme().isEmpty() || textDocument->isNew())
+    {
+        return QString();
+    }
+
+    QFileInfo documentInfo(textDocument->getFilePath());
+
+    return QDir::cleanPath
+        (
+            documentInfo.dir().absoluteFilePath
+            (
+                QUrl::fromPercentEncoding(destination.toUtf8())
+            )
+        );
+}
+
+QPixmap MarkdownEditor::imagePreview(const QTextBlock& block)
+{
+    TextBlockData* blockData = (TextBlockData*) block.userData();
+
+    if ((NULL == blockData) || blockData->imageDestination.isEmpty())
+    {
+        return QPixmap();
+    }
+
+    QString filePath = imageFilePath(blockData->imageDestination);
+
+    if (filePath.isEmpty())
+    {
+        return QPixmap();
+    }
+
+    return thumbnailCache->thumbnail(filePath);
+}
+
+void MarkdownEditor::updateImagePreviewHeights()
+{
+    if (!imagePreviewsEnabled)
+    {
+        return;
+    }
+
+    QTextBlock firstVisible = firstVisibleBlock();
+    QTextBlock block = firstVisible;
+
+    for (int i = 0; (i < GW_IMAGE_PREVIEW_LOOKAHEAD) && block.previous().isValid(); i++)
+    {
+        block = block.previous();
+    }
+
+    // Requesting the preview of each block near the visible area makes the
+    // thumbnail cache decode any previews that are missing.  Blocks that no
+    // longer have an image give up their space.
+    //
+    qreal top = blockBoundingGeometry(firstVisible).translated(contentOffset()).top();
+    int blocksBelowView = 0;
+
+    while (block.isValid() && (blocksBelowView < GW_IMAGE_PREVIEW_LOOKAHEAD))
+    {
+        TextBlockData* blockData = (TextBlockData*) block.userData();
+
+        if (NULL != blockData)
+        {
+            QPixmap preview = imagePreview(block);
+            int height = 0;
+
+            if (!preview.isNull())
+            {
+                height = preview.height() + (2 * GW_IMAGE_PREVIEW_MARGIN);
+            }
+
+            setImagePreviewHeight(block, height);
+        }
+
+        if (block.blockNumber() >= firstVisible.blockNumber())
+        {
+            if (top > viewport()->height())
+            {
+                blocksBelowView++;
+            }
+
+            top += blockBoundingRect(block).height();
+        }
+
+        block = block.next();
+    }
+}
+
+void MarkdownEditor::setImagePreviewHeight(const QTextBlock& block, int height)
+{
+    TextBlockData* blockData = (TextBlockData*) block.userData();
+
+    if ((NULL == blockData) || (height == blockData->imagePreviewHeight))
+    {
+        return;
+    }
+
+    blockData->imagePreviewHeight = height;
+
+    // Have the layout measure the block again, which updates the scroll
+    // range and repaints the blocks that moved.  Marking the block's
+    // contents dirty instead would have everything that listens for text
+    // changes, such as the highlighter and the outline, process the block
+    // again for nothing.
+    //
+    TextDocumentLayout* layout =
+        qobject_cast<TextDocumentLayout*>(document()->documentLayout());
+
+    if (NULL != layout)
+    {
+        layout->imagePreviewHeightChanged(block);
+    }
+}
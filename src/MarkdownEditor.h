@@ -20,7 +20,9 @@
 #ifndef MARKDOWN_EDITOR_H
 #define MARKDOWN_EDITOR_H
 
+#include <QCache>
 #include <QObject>
+#include <QPixmap>
 #include <QPlainTextEdit>
 #include <QString>
 #include <QResizeEvent>
@@ -34,7 +36,9 @@
 #include "TextDocument.h"
 #include "MarkdownEditorTypes.h"
 #include "MarkdownHighlighter.h"
+#include "AnnotatedScrollBar.h"
 #include "GraphicsFadeEffect.h"
+#include "ImageThumbnailCache.h"
 #include "Theme.h"
 #include "spelling/dictionary_ref.h"
 
@@ -144,6 +148,8 @@ class MarkdownEditor : public QPlainTextEdit
         void dragEnterEvent(QDragEnterEvent* e);
         void dropEvent(QDropEvent* e);
         void keyPressEvent(QKeyEvent *e);
+        void paintEvent(QPaintEvent* event);
+        void wheelEvent(QWheelEvent* event);
         bool eventFilter(QObject* watched, QEvent* event);
 
     signals:
@@ -318,6 +324,35 @@ class MarkdownEditor : public QPlainTextEdit
          */
         void setSpellCheckEnabled(const bool enabled);
 
+        /**
+         * Sets whether a thumbnail of the first inline image in a line is
+         * shown beneath the line.  Thumbnails are only decoded for lines
+         * near the visible area of the editor.
+         */
+        void setImagePreviewsEnabled(bool enabled);
+
+        /**
+         * Sets whether the rendered text of blocks is cached as pixmaps, so
+         * that scrolling mostly copies the cached pixmaps instead of
+         * painting the text anew.  The cache is bounded in size, and a
+         * block is always painted directly while it contains the text
+         * cursor or a selection.
+         */
+        void setPaintCacheEnabled(bool enabled);
+
+        /**
+         * Marks the given document positions of search matches on the
+         * vertical scroll bar, or clears the marks if the list is empty.
+         */
+        void setSearchMatches(const QList<int>& positions);
+
+        /**
+         * Checks the annotations shown on the vertical scroll bar for every
+         * block in the document again, such as after the lint findings for
+         * the document have changed.
+         */
+        void refreshAnnotations();
+
     private slots:
         void suggestSpelling(QAction* action);
         void onTextChanged();
@@ -326,6 +361,11 @@ class MarkdownEditor : public QPlainTextEdit
         void checkIfTypingPaused();
         void spellCheckFinished(int result);
         void onCursorPositionChanged();
+        void onThumbnailReady();
+        void scheduleImagePreviewUpdate();
+        void updateImagePreviewHeights();
+        void clearImagePreviews();
+        void invalidatePaintCache(int position, int charsRemoved, int charsAdded);
 
     private:
         TextDocument* textDocument;
@@ -355,6 +395,35 @@ class MarkdownEditor : public QPlainTextEdit
         QHash<QChar, bool> autoMatchFilter; // Used for filtering paired characters.
         bool mouseButtonDown;
         GraphicsFadeEffect* fadeEffect;
+        AnnotatedScrollBar* annotatedScrollBar;
+        ImageThumbnailCache* thumbnailCache;
+        bool imagePreviewsEnabled;
+
+        // Timer with which the space reserved for the image previews is
+        // updated once the editor has scrolled or repainted, rather than
+        // while it is painting, which would leave the document size stale.
+        //
+        QTimer* imagePreviewTimer;
+
+        // Rendered text of blocks, keyed by the paintCacheId of their
+        // TextBlockData.  A cached pixmap is only used if the block's
+        // revision, the style generation, the text width and the device
+        // pixel ratio all still match.  The style generation is increased
+        // whenever the editor is restyled.
+        //
+        struct CachedBlockPaint
+        {
+            QPixmap pixmap;
+            int revision;
+            int styleGeneration;
+            qreal textWidth;
+            qreal devicePixelRatio;
+        };
+
+        bool paintCacheEnabled;
+        QCache<int, CachedBlockPaint> paintCache;
+        int nextPaintCacheId;
+        int paintCacheStyleGeneration;
 
         // Timer used to determine when typing has paused.
         QTimer* typingTimer;
@@ -366,6 +435,8 @@ class MarkdownEditor : public QPlainTextEdit
         //
         bool typingPausedSignalSent;
 
+        void paintBlocks(QPaintEvent* event);
+        QPixmap cachedBlockPaint(const QTextBlock& block, const QPen& pen);
         void handleCarriageReturn();
         bool handleBackspaceKey();
         void insertPrefixForBlocks(const QString& prefix);
@@ -375,6 +446,9 @@ class MarkdownEditor : public QPlainTextEdit
         void insertFormattingMarkup(const QString& markup);
         QString getPriorIndentation();
         QString getPriorMarkdownBlockItemStart(QRegExp& itemRegex);
+        QString imageFilePath(const QString& destination) const;
+        QPixmap imagePreview(const QTextBlock& block);
+        void setImagePreviewHeight(const QTextBlock& block, int height);
 
 };
 
@@ -0,0 +1,77 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef MARKDOWN_FLAVOR_H
+#define MARKDOWN_FLAVOR_H
+
+/*
+ * Optional Markdown syntax features that the tokenizer recognizes only when
+ * they are supported by the target Markdown processor.  Syntax common to all
+ * processors, such as emphasis, links, lists and fenced code blocks, is
+ * always recognized.
+ */
+enum MarkdownFeature
+{
+    MarkdownFeatureNone = 0x0,
+    MarkdownFeatureStrikethrough = 0x1,
+    MarkdownFeaturePipeTables = 0x2,
+    MarkdownFeatureMentions = 0x4,
+    MarkdownFeatureFrontMatter = 0x8,
+    MarkdownFeatureFootnotes = 0x10,
+    MarkdownFeatureInlineMath = 0x20,
+    MarkdownFeatureDefinitionLists = 0x40
+};
+
+/*
+ * Markdown flavors, each of which is the set of MarkdownFeature flags that
+ * its processors support.  The flavor values are used as template arguments
+ * by MarkdownTokenizer, so that the checks for disabled features are
+ * compiled out of the tokenizer entirely.
+ */
+enum MarkdownFlavor
+{
+    MarkdownFlavorCommonMark = MarkdownFeatureNone,
+
+    // The GitHub flavor is the default, read by Sundown and the built-in
+    // CommonMark exporter, neither of which renders front matter or
+    // footnotes.
+    //
+    MarkdownFlavorGitHub =
+        MarkdownFeatureStrikethrough
+        | MarkdownFeaturePipeTables
+        | MarkdownFeatureMentions,
+
+    MarkdownFlavorPandoc =
+        MarkdownFeatureStrikethrough
+        | MarkdownFeaturePipeTables
+        | MarkdownFeatureFrontMatter
+        | MarkdownFeatureFootnotes
+        | MarkdownFeatureInlineMath
+        | MarkdownFeatureDefinitionLists,
+
+    MarkdownFlavorMultiMarkdown =
+        MarkdownFeaturePipeTables
+        | MarkdownFeatureFrontMatter
+        | MarkdownFeatureFootnotes
+        | MarkdownFeatureInlineMath
+        | MarkdownFeatureDefinitionLists
+};
+
+#endif // MARKDOWN_FLAVOR_H
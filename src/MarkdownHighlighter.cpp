@@ -20,6 +20,7 @@
 #include <QBrush>
 #include <QColor>
 #include <QFont>
+#include <QHash>
 #include <QObject>
 #include <QRegExp>
 #include <QString>
@@ -30,22 +31,35 @@
 #include <QTextBlockFormat>
 #include <QStyle>
 #include <QApplication>
+#include <QTimer>
 #include <Qt>
 
 #include "MarkdownHighlighter.h"
+#include "MarkdownLinter.h"
 #include "MarkdownTokenizer.h"
 #include "MarkdownTokenTypes.h"
 #include "MarkdownStates.h"
 #include "ColorHelper.h"
+#include "TaskScheduler.h"
+#include "TextBlockData.h"
 #include "spelling/dictionary_ref.h"
 #include "spelling/dictionary_manager.h"
 
 #define GW_FADE_ALPHA 200
 
+// Milliseconds to wait after the last change before style checking the
+// changed blocks.
+//
+#define GW_STYLE_CHECK_DELAY 250
+
 MarkdownHighlighter::MarkdownHighlighter(QTextDocument* document)
     : QSyntaxHighlighter(document), tokenizer(NULL),
         dictionary(DictionaryManager::instance().requestDictionary()),
         spellCheckEnabled(false),
+        styleCheckEnabled(false),
+        styleChecker(NULL),
+        nextStyleCheckId(1),
+        linter(NULL),
         useUndlerlineForEmphasis(false),
         inBlockquote(false),
         defaultTextColor(Qt::black),
@@ -64,6 +78,14 @@ MarkdownHighlighter::MarkdownHighlighter(QTextDocument* document)
         SLOT(onHighlightBlockAtPosition(int)),
         Qt::QueuedConnection
     );
+
+    styleCheckWatcher = new QFutureWatcher< QList<StyleCheckResult> >(this);
+    connect(styleCheckWatcher, SIGNAL(finished()), this, SLOT(onStyleCheckFinished()));
+
+    styleCheckTimer = new QTimer(this);
+    styleCheckTimer->setSingleShot(true);
+    styleCheckTimer->setInterval(GW_STYLE_CHECK_DELAY);
+    connect(styleCheckTimer, SIGNAL(timeout()), this, SLOT(startStyleCheck()));
     
 
     QFont font;
@@ -123,6 +145,7 @@ MarkdownHighlighter::MarkdownHighlighter(QTextDocument* document)
     strongMarkup[TokenNumberedList] = true;
     strongMarkup[TokenBlockquote] = true;
     strongMarkup[TokenBulletPointList] = true;
+    strongMarkup[TokenDefinitionList] = true;
 }
         
 MarkdownHighlighter::~MarkdownHighlighter()
@@ -132,6 +155,16 @@ MarkdownHighlighter::~MarkdownHighlighter()
         delete tokenizer;
         tokenizer = NULL;
     }
+
+    // Don't delete the style checker out from under the worker thread.
+    styleCheckToken.cancel();
+    styleCheckWatcher->waitForFinished();
+
+    if (NULL != styleChecker)
+    {
+        delete styleChecker;
+        styleChecker = NULL;
+    }
 }
 
 // Note:  Never, ever set the QTextBlockFormat for a QTextBlock from within the
@@ -150,6 +183,7 @@ MarkdownHighlighter::~MarkdownHighlighter()
 void MarkdownHighlighter::highlightBlock(const QString& text)
 {
     int lastState = currentBlockState();
+    QString textToStyleCheck = text;
 
     setFormat(0, text.length(), defaultFormat);
 
@@ -179,11 +213,23 @@ void MarkdownHighlighter::highlightBlock(const QString& text)
         }
 
         QList<Token> tokens = tokenizer->getTokens();
+        QString firstImageDestination;
 
         foreach (Token token, tokens)
         {
             switch (token.getType())
             {
+                case TokenImage:
+                    applyFormattingForToken(token);
+
+                    if (firstImageDestination.isEmpty())
+                    {
+                        firstImageDestination = imageDestination
+                            (
+                                text.mid(token.getPosition(), token.getLength())
+                            );
+                    }
+                    break;
                 case TokenAtxHeading1:
                 case TokenAtxHeading2:
                 case TokenAtxHeading3:
@@ -227,11 +273,43 @@ void MarkdownHighlighter::highlightBlock(const QString& text)
             QTextBlock previous = currentBlock().previous();
             emit highlightBlockAtPosition(previous.position());
         }
+
+        recordImageDestination(firstImageDestination);
+
+        if (NULL != linter)
+        {
+            linter->lintBlock(block, tokens);
+        }
+
+        if (styleCheckEnabled)
+        {
+            textToStyleCheck = proseText(text, tokens);
+        }
     }
 
+    int misspellingCount = 0;
+
     if (spellCheckEnabled)
     {
-        spellCheck(text);
+        misspellingCount = spellCheck(text);
+    }
+
+    TextBlockData* blockData = (TextBlockData*) currentBlockUserData();
+
+    if ((NULL == blockData) && (misspellingCount > 0))
+    {
+        blockData = new TextBlockData();
+        setCurrentBlockUserData(blockData);
+    }
+
+    if (NULL != blockData)
+    {
+        blockData->misspellingCount = misspellingCount;
+    }
+
+    if (styleCheckEnabled)
+    {
+        styleCheck(textToStyleCheck);
     }
 
     // If the block has transitioned from previously being a heading to now
@@ -312,12 +390,54 @@ void MarkdownHighlighter::setFont(const QString& fontFamily, const double fontSi
     rehighlight();
 }
 
+void MarkdownHighlighter::setMarkdownFlavor(MarkdownFlavor flavor)
+{
+    MarkdownTokenizer* markdownTokenizer = (MarkdownTokenizer*) tokenizer;
+
+    if (flavor != markdownTokenizer->getFlavor())
+    {
+        markdownTokenizer->setFlavor(flavor);
+        rehighlight();
+    }
+}
+
 void MarkdownHighlighter::setSpellCheckEnabled(const bool enabled)
 {
     spellCheckEnabled = enabled;
     rehighlight();
 }
 
+void MarkdownHighlighter::setStyleCheckEnabled(const bool enabled)
+{
+    if (enabled == styleCheckEnabled)
+    {
+        return;
+    }
+
+    styleCheckEnabled = enabled;
+
+    if (enabled && (NULL == styleChecker))
+    {
+        styleChecker = new StyleChecker();
+    }
+
+    // Forget all previous results, since the document may have changed
+    // while style checking was disabled.
+    //
+    clearStyleChecks();
+    rehighlight();
+}
+
+void MarkdownHighlighter::setLinter(MarkdownLinter* linter)
+{
+    this->linter = linter;
+
+    if (NULL != linter)
+    {
+        rehighlight();
+    }
+}
+
 void MarkdownHighlighter::setBlockquoteStyle(const BlockquoteStyle style)
 {
     blockquoteStyle = style;
@@ -341,6 +461,122 @@ void MarkdownHighlighter::onHighlightBlockAtPosition(int position)
     rehighlightBlock(block);
 }
 
+void MarkdownHighlighter::startStyleCheck()
+{
+    // If a check is already in progress, the changed blocks will be checked
+    // once it has finished.
+    //
+    if (pendingStyleChecks.isEmpty() || styleCheckWatcher->isRunning())
+    {
+        return;
+    }
+
+    TaskOptions options(TaskPriorityNormal);
+    options.token = styleCheckToken;
+
+    QFuture< QList<StyleCheckResult> > future =
+        TaskScheduler::getInstance()->run
+        (
+            options,
+            &MarkdownHighlighter::checkBlocks,
+            (const StyleChecker*) styleChecker,
+            pendingStyleChecks
+        );
+
+    pendingStyleChecks.clear();
+    styleCheckWatcher->setFuture(future);
+}
+
+void MarkdownHighlighter::onStyleCheckFinished()
+{
+    QList<StyleCheckResult> results;
+
+    // The results of a cancelled check are stale, since the checks were
+    // cleared when it was cancelled.
+    //
+    if (!styleCheckWatcher->isCanceled())
+    {
+        results = styleCheckWatcher->result();
+    }
+
+    if (styleCheckEnabled)
+    {
+        QHash<uint, StyleCheckResult> movedResults;
+
+        foreach (const StyleCheckResult& result, results)
+        {
+            QTextBlock block = document()->findBlockByNumber(result.blockNumber);
+
+            if (!applyStyleCheckResult(block, result))
+            {
+                movedResults.insert(result.id, result);
+            }
+        }
+
+        // Blocks were inserted or removed above the blocks whose results
+        // are left, or those blocks have changed since the check was
+        // requested.  Look for the requests' IDs in a single pass over the
+        // document.  The results of blocks that have changed are discarded,
+        // since they were requested again under new IDs.
+        //
+        QTextBlock block = document()->begin();
+
+        while (!movedResults.isEmpty() && block.isValid())
+        {
+            TextBlockData* blockData = (TextBlockData*) block.userData();
+
+            if ((NULL != blockData) && movedResults.contains(blockData->styleCheckId))
+            {
+                applyStyleCheckResult(block, movedResults.take(blockData->styleCheckId));
+            }
+
+            block = block.next();
+        }
+    }
+
+    if (!pendingStyleChecks.isEmpty())
+    {
+        styleCheckTimer->start();
+    }
+}
+
+bool MarkdownHighlighter::applyStyleCheckResult
+(
+    const QTextBlock& block,
+    const StyleCheckResult& result
+)
+{
+    if (!block.isValid())
+    {
+        return false;
+    }
+
+    TextBlockData* blockData = (TextBlockData*) block.userData();
+
+    if
+    (
+        (NULL == blockData) ||
+        !blockData->styleCheckRequested ||
+        (blockData->styleCheckId != result.id)
+    )
+    {
+        return false;
+    }
+
+    blockData->styleIssues = result.issues;
+
+    // The block's old issues were already cleared when the check was
+    // requested, so there is only a need to rehighlight blocks that have
+    // new issues.
+    //
+    if (!result.issues.isEmpty())
+    {
+        rehighlightBlock(block);
+    }
+
+    return true;
+}
+
 bool MarkdownHighlighter::isHeadingBlockState(int state) const
 {
     switch (state)
@@ -359,8 +595,9 @@ bool MarkdownHighlighter::isHeadingBlockState(int state) const
     }
 }
 
-void MarkdownHighlighter::spellCheck(const QString& text)
+int MarkdownHighlighter::spellCheck(const QString& text)
 {
+    int misspellingCount = 0;
     QStringRef misspelledWord = dictionary.check(text, 0);
 
     while (!misspelledWord.isNull())
@@ -380,10 +617,292 @@ void MarkdownHighlighter::spellCheck(const QString& text)
         );
 
         setFormat(startIndex, length, spellingErrorFormat);
+        misspellingCount++;
 
         startIndex += length;
         misspelledWord = dictionary.check(text, startIndex);
     }
+
+    return misspellingCount;
+}
+
+QString MarkdownHighlighter::proseText
+(
+    const QString& text,
+    const QList<Token>& tokens
+) const
+{
+    switch (currentBlockState())
+    {
+        case MarkdownStateCodeBlock:
+        case MarkdownStateInGithubCodeFence:
+        case MarkdownStateInPandocCodeFence:
+        case MarkdownStateCodeFenceEnd:
+        case MarkdownStateComment:
+        case MarkdownStateHorizontalRule:
+        case MarkdownStateSetextHeading1Line2:
+        case MarkdownStateSetextHeading2Line2:
+        case MarkdownStatePipeTableDivider:
+        case MarkdownStateFrontMatter:
+        case MarkdownStateFrontMatterEnd:
+            return QString();
+        default:
+            break;
+    }
+
+    // Mask out anything that isn't prose, so that the style checker treats
+    // it as neither words nor whitespace.
+    //
+    QString prose = text;
+    const QChar mask = QChar::ObjectReplacementCharacter;
+
+    foreach (const Token& token, tokens)
+    {
+        int start = token.getPosition();
+        int length = token.getLength();
+
+        switch (token.getType())
+        {
+            case TokenVerbatim:
+            case TokenHtmlTag:
+            case TokenHtmlEntity:
+            case TokenHtmlComment:
+            case TokenAutomaticLink:
+            case TokenImage:
+            case TokenReferenceDefinition:
+            case TokenGithubCodeFence:
+            case TokenPandocCodeFence:
+            case TokenCodeBlock:
+            case TokenInlineMath:
+            case TokenFootnoteReference:
+            case TokenFootnoteDefinition:
+                break;
+            case TokenInlineLink:
+            case TokenReferenceLink:
+            {
+                // Keep the link text, but mask out the link destination or
+                // reference label.
+                //
+                int split = text.mid(start, length).lastIndexOf
+                    (
+                        (TokenInlineLink == token.getType()) ? "](" : "]["
+                    );
+
+                if (split < 0)
+                {
+                    length = 0;
+                }
+                else
+                {
+                    start += split;
+                    length -= split;
+                }
+                break;
+            }
+            default:
+                length = 0;
+                break;
+        }
+
+        for (int i = start; (i < (start + length)) && (i < prose.length()); i++)
+        {
+            prose[i] = mask;
+        }
+    }
+
+    return prose;
+}
+
+void MarkdownHighlighter::recordImageDestination(const QString& destination)
+{
+    TextBlockData* blockData = (TextBlockData*) currentBlockUserData();
+
+    if (NULL == blockData)
+    {
+        if (destination.isEmpty())
+        {
+            return;
+        }
+
+        blockData = new TextBlockData();
+        setCurrentBlockUserData(blockData);
+    }
+
+    // The editor sizes the preview again the next time the block is
+    // painted.
+    //
+    if (destination != blockData->imageDestination)
+    {
+        blockData->imageDestination = destination;
+        blockData->imagePreviewHeight = 0;
+    }
+}
+
+QString MarkdownHighlighter::imageDestination(const QString& image)
+{
+    // The image token has the form ![alt text](destination "title"),
+    // where the destination may optionally be enclosed in angle brackets.
+    //
+    int start = image.indexOf("](");
+
+    if ((start < 0) || !image.endsWith(QChar(')')))
+    {
+        return QString();
+    }
+
+    QString destination =
+        image.mid(start + 2, image.length() - start - 3).trimmed();
+
+    if (destination.startsWith(QChar('<')))
+    {
+        int end = destination.indexOf(QChar('>'));
+
+        return (end < 0) ? QString() : destination.mid(1, end - 1);
+    }
+
+    int end = destination.indexOf(QRegExp("\\s"));
+
+    if (end >= 0)
+    {
+        destination.truncate(end);
+    }
+
+    return destination;
+}
+
+void MarkdownHighlighter::styleCheck(const QString& text)
+{
+    TextBlockData* blockData = (TextBlockData*) currentBlockUserData();
+
+    if (NULL == blockData)
+    {
+        blockData = new TextBlockData();
+        setCurrentBlockUserData(blockData);
+    }
+
+    uint hash = qHash(text);
+
+    if (!blockData->styleCheckRequested || (hash != blockData->styleCheckHash))
+    {
+        // Drop the block's previous request, if it hasn't started yet.
+        pendingStyleChecks.remove(blockData->styleCheckId);
+
+        blockData->styleCheckRequested = true;
+        blockData->styleCheckHash = hash;
+        blockData->styleCheckId = nextStyleCheckId++;
+        blockData->styleIssues.clear();
+
+        if (!text.trimmed().isEmpty())
+        {
+            StyleCheckRequest request;
+            request.blockNumber = currentBlock().blockNumber();
+            request.text = text;
+
+            pendingStyleChecks.insert(blockData->styleCheckId, request);
+            styleCheckTimer->start();
+        }
+
+        return;
+    }
+
+    QTextCharFormat::UnderlineStyle spellingErrorUnderlineStyle =
+        (QTextCharFormat::UnderlineStyle)
+        QApplication::style()->styleHint
+        (
+            QStyle::SH_SpellCheckUnderlineStyle
+        );
+
+    // Use a different underline style than the one for spelling errors,
+    // both so that the user can tell them apart and so that the editor's
+    // spelling suggestions menu isn't offered for style issues.
+    //
+    QTextCharFormat::UnderlineStyle styleIssueUnderlineStyle =
+        QTextCharFormat::DashUnderline;
+
+    if (QTextCharFormat::DashUnderline == spellingErrorUnderlineStyle)
+    {
+        styleIssueUnderlineStyle = QTextCharFormat::DotLine;
+    }
+
+    foreach (const StyleIssue& issue, blockData->styleIssues)
+    {
+        int end = qMin(issue.position + issue.length, text.length());
+        int runStart = issue.position;
+
+        // Apply the underline one run of identically formatted text at a
+        // time, so as to preserve any other formatting within the issue's
+        // range, and leave spelling errors alone.
+        //
+        while (runStart < end)
+        {
+            QTextCharFormat runFormat = format(runStart);
+            int runEnd = runStart + 1;
+
+            while ((runEnd < end) && (format(runEnd) == runFormat))
+            {
+                runEnd++;
+            }
+
+            if (runFormat.underlineStyle() != spellingErrorUnderlineStyle)
+            {
+                runFormat.setUnderlineColor(linkColor);
+                runFormat.setUnderlineStyle(styleIssueUnderlineStyle);
+                setFormat(runStart, runEnd - runStart, runFormat);
+            }
+
+            runStart = runEnd;
+        }
+    }
+}
+
+void MarkdownHighlighter::clearStyleChecks()
+{
+    pendingStyleChecks.clear();
+    styleCheckTimer->stop();
+    styleCheckToken.cancel();
+    styleCheckToken = CancellationToken();
+
+    QTextBlock block = document()->begin();
+
+    while (block.isValid())
+    {
+        TextBlockData* blockData = (TextBlockData*) block.userData();
+
+        if (NULL != blockData)
+        {
+            blockData->styleCheckRequested = false;
+            blockData->styleIssues.clear();
+        }
+
+        block = block.next();
+    }
+}
+
+QList<MarkdownHighlighter::StyleCheckResult> MarkdownHighlighter::checkBlocks
+(
+    const StyleChecker* checker,
+    const QMap<uint, StyleCheckRequest>& requests
+)
+{
+    QList<StyleCheckResult> results;
+    QMap<uint, StyleCheckRequest>::const_iterator iter;
+    CancellationToken token = CancellationToken::current();
+
+    for (iter = requests.begin(); iter != requests.end(); iter++)
+    {
+        if (token.isCancelled())
+        {
+            break;
+        }
+
+        StyleCheckResult result;
+        result.id = iter.key();
+        result.blockNumber = iter.value().blockNumber;
+        result.issues = checker->check(iter.value().text);
+        results.append(result);
+    }
+
+    return results;
 }
 
 void MarkdownHighlighter::setupTokenColors()
@@ -421,6 +940,10 @@ void MarkdownHighlighter::setupTokenColors()
     colorForToken[TokenSetextHeading2Line2] = markupColor;
     colorForToken[TokenTableDivider] = markupColor;
     colorForToken[TokenTablePipe] = markupColor;
+    colorForToken[TokenFrontMatter] = fadedColor;
+    colorForToken[TokenFootnoteReference] = linkColor;
+    colorForToken[TokenFootnoteDefinition] = linkColor;
+    colorForToken[TokenInlineMath] = fadedColor;
 }
 
 void MarkdownHighlighter::setupHeadingFontSize(bool useLargeHeadings)
@@ -21,10 +21,14 @@
 #define MARKDOWN_HIGHLIGHTER_H
 
 #include <QSyntaxHighlighter>
+#include <QFutureWatcher>
+#include <QMap>
 
 #include "spelling/dictionary_ref.h"
 #include "MarkdownTokenizer.h"
 #include "MarkdownStyles.h"
+#include "CancellationToken.h"
+#include "StyleChecker.h"
 #include "Token.h"
 
 class QColor;
@@ -32,7 +36,9 @@ class QRegExp;
 class QString;
 class QTextCharFormat;
 class QTextDocument;
+class QTimer;
 class HighlightTokenizer;
+class MarkdownLinter;
 
 /**
  * Highlighter for the Markdown text format.
@@ -106,11 +112,32 @@ class MarkdownHighlighter : public QSyntaxHighlighter
          */
         void setSpellCheckEnabled(const bool enabled);
 
+        /**
+         * Sets whether live style checking is enabled.  Style checks run
+         * on a worker thread, and only for blocks whose text has changed
+         * since they were last checked.  Style issues are underlined with a
+         * different style than spelling errors.
+         */
+        void setStyleCheckEnabled(const bool enabled);
+
+        /**
+         * Sets the linter to which each block's tokens are passed after
+         * the block is tokenized.  Set to NULL to disable linting.
+         */
+        void setLinter(MarkdownLinter* linter);
+
         /**
          * Sets the blockquote style.
          */
         void setBlockquoteStyle(const BlockquoteStyle style);
 
+    public slots:
+        /**
+         * Sets the Markdown flavor whose syntax is highlighted, and
+         * rehighlights the document if the flavor changed.
+         */
+        void setMarkdownFlavor(MarkdownFlavor flavor);
+
     signals:
         /**
          * Notifies listeners that a heading was found in the document at the
@@ -145,10 +172,45 @@ class MarkdownHighlighter : public QSyntaxHighlighter
          */
         void onHighlightBlockAtPosition(int position);
 
+        /*
+         * Starts style checking the blocks that have changed, if a style
+         * check is not already in progress.
+         */
+        void startStyleCheck();
+
+        /*
+         * Applies the results of the style check that just finished.
+         */
+        void onStyleCheckFinished();
+
     private:
+        // Text of a block to style check, along with the block's number
+        // when the check was requested.
+        //
+        struct StyleCheckRequest
+        {
+            int blockNumber;
+            QString text;
+        };
+
+        struct StyleCheckResult
+        {
+            uint id;
+            int blockNumber;
+            QList<StyleIssue> issues;
+        };
+
         HighlightTokenizer* tokenizer;
         DictionaryRef dictionary;
         bool spellCheckEnabled;
+        bool styleCheckEnabled;
+        StyleChecker* styleChecker;
+        QMap<uint, StyleCheckRequest> pendingStyleChecks;
+        uint nextStyleCheckId;
+        QFutureWatcher< QList<StyleCheckResult> >* styleCheckWatcher;
+        QTimer* styleCheckTimer;
+        CancellationToken styleCheckToken;
+        MarkdownLinter* linter;
         bool useUndlerlineForEmphasis;
         bool inBlockquote;
         BlockquoteStyle blockquoteStyle;
@@ -173,7 +235,23 @@ class MarkdownHighlighter : public QSyntaxHighlighter
          */
         bool isHeadingBlockState(int state) const;
 
-        void spellCheck(const QString& text);
+        int spellCheck(const QString& text);
+        QString proseText(const QString& text, const QList<Token>& tokens) const;
+        void styleCheck(const QString& text);
+        void clearStyleChecks();
+        bool applyStyleCheckResult
+        (
+            const QTextBlock& block,
+            const StyleCheckResult& result
+        );
+        void recordImageDestination(const QString& destination);
+        static QString imageDestination(const QString& image);
+
+        static QList<StyleCheckResult> checkBlocks
+        (
+            const StyleChecker* checker,
+            const QMap<uint, StyleCheckRequest>& requests
+        );
         void setupTokenColors();
         void setupHeadingFontSize(bool useLargeHeadings);
 
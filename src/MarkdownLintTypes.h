@@ -0,0 +1,60 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef MARKDOWNLINTTYPES_H
+#define MARKDOWNLINTTYPES_H
+
+/**
+ * House style rules checked by the MarkdownLinter.
+ */
+enum MarkdownLintRule
+{
+    LintRuleInconsistentListMarker,
+    LintRuleSkippedHeadingLevel,
+    LintRuleCodeFenceWithoutLanguage,
+    LintRuleTrailingWhitespace,
+    LintRuleTableColumnCount
+};
+
+/**
+ * A lint diagnostic for a text block, given as the position and length of
+ * the offending text within the block.  The meaning of the expected and
+ * actual values depends on the rule.  For example, for
+ * LintRuleTableColumnCount they are the number of columns in the table
+ * header and in the offending row, respectively.
+ */
+struct MarkdownLintDiagnostic
+{
+    int position;
+    int length;
+    MarkdownLintRule rule;
+    int expected;
+    int actual;
+
+    bool operator==(const MarkdownLintDiagnostic& other) const
+    {
+        return (position == other.position)
+            && (length == other.length)
+            && (rule == other.rule)
+            && (expected == other.expected)
+            && (actual == other.actual);
+    }
+};
+
+#endif // MARKDOWNLINTTYPES_H
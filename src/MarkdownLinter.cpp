@@ -0,0 +1,519 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QTextDocument>
+
+#include "MarkdownLinter.h"
+#include "MarkdownStates.h"
+#include "MarkdownTokenizer.h"
+#include "TextBlockData.h"
+
+MarkdownLinter::MarkdownLinter(QTextDocument* document, QObject* parent)
+    : QObject(parent), document(document)
+{
+    lastBlockCount = document->blockCount();
+    connect(document, SIGNAL(contentsChange(int,int,int)), this, SLOT(onContentsChange(int,int,int)));
+}
+
+MarkdownLinter::~MarkdownLinter()
+{
+
+}
+
+void MarkdownLinter::lintBlock(QTextBlock block, const QList<Token>& tokens)
+{
+    TextBlockData* data = blockData(block);
+    QString text = block.text();
+    int state = block.userState();
+
+    int headingLevel = headingLevelForState(state);
+    QChar listMarker;
+    int listIndent = -1;
+    int tableColumnCount = 0;
+    bool untaggedCodeFence = false;
+
+    if
+    (
+        (MarkdownStateBulletPointList == state) ||
+        (MarkdownStateNumberedList == state)
+    )
+    {
+        for (listIndent = 0; listIndent < text.length(); listIndent++)
+        {
+            if (!text[listIndent].isSpace())
+            {
+                break;
+            }
+        }
+
+        if ((MarkdownStateBulletPointList == state) && (listIndent < text.length()))
+        {
+            listMarker = text[listIndent];
+        }
+    }
+
+    if (isTableState(state))
+    {
+        tableColumnCount = countTableColumns(text, tokens);
+    }
+
+    foreach (const Token& token, tokens)
+    {
+        if
+        (
+            (TokenGithubCodeFence == token.getType()) ||
+            (TokenPandocCodeFence == token.getType())
+        )
+        {
+            QString info = text.trimmed();
+            int i = 0;
+
+            while ((i < info.length()) && (info[i] == info[0]))
+            {
+                i++;
+            }
+
+            untaggedCodeFence = info.mid(i).trimmed().isEmpty();
+            break;
+        }
+    }
+
+    bool headingChanged = (data->headingLevel != headingLevel);
+    bool listChanged =
+        (data->listIndent != listIndent) || (data->listMarker != listMarker);
+    bool tableChanged = (data->tableColumnCount != tableColumnCount);
+
+    data->headingLevel = headingLevel;
+    data->listMarker = listMarker;
+    data->listIndent = listIndent;
+    data->tableColumnCount = tableColumnCount;
+    data->untaggedCodeFence = untaggedCodeFence;
+
+    bool changed = checkBlock(block);
+
+    if
+    (
+        checkDependentBlocks(block, headingChanged, listChanged, tableChanged)
+    )
+    {
+        changed = true;
+    }
+
+    if (changed)
+    {
+        emit diagnosticsChanged();
+    }
+}
+
+QString MarkdownLinter::describe(const MarkdownLintDiagnostic& diagnostic)
+{
+    switch (diagnostic.rule)
+    {
+        case LintRuleInconsistentListMarker:
+            return tr("Inconsistent bullet point marker (expected %1)")
+                .arg(QChar(diagnostic.expected));
+        case LintRuleSkippedHeadingLevel:
+            return tr("Heading skips from level %1 to level %2")
+                .arg(diagnostic.expected - 1)
+                .arg(diagnostic.actual);
+        case LintRuleCodeFenceWithoutLanguage:
+            return tr("Code fence has no language tag");
+        case LintRuleTrailingWhitespace:
+            return tr("Trailing whitespace");
+        case LintRuleTableColumnCount:
+            return tr("Table row has %1 columns, but the header has %2")
+                .arg(diagnostic.actual)
+                .arg(diagnostic.expected);
+        default:
+            return QString();
+    }
+}
+
+void MarkdownLinter::onContentsChange(int position, int charsRemoved, int charsAdded)
+{
+    Q_UNUSED(charsRemoved)
+    Q_UNUSED(charsAdded)
+
+    // When blocks are added or removed, the blocks that follow may have
+    // new structural neighbors even though their own facts haven't changed.
+    //
+    if (document->blockCount() != lastBlockCount)
+    {
+        lastBlockCount = document->blockCount();
+
+        if (checkDependentBlocks(document->findBlock(position), true, true, true))
+        {
+            emit diagnosticsChanged();
+        }
+    }
+}
+
+TextBlockData* MarkdownLinter::blockData(QTextBlock& block) const
+{
+    TextBlockData* data = (TextBlockData*) block.userData();
+
+    if (NULL == data)
+    {
+        data = new TextBlockData();
+        block.setUserData(data);
+    }
+
+    return data;
+}
+
+bool MarkdownLinter::checkBlock(QTextBlock& block)
+{
+    TextBlockData* data = (TextBlockData*) block.userData();
+
+    if (NULL == data)
+    {
+        return false;
+    }
+
+    QList<MarkdownLintDiagnostic> diagnostics;
+    QString text = block.text();
+    int state = block.userState();
+    MarkdownLintDiagnostic diagnostic;
+    diagnostic.expected = 0;
+    diagnostic.actual = 0;
+
+    // Check for trailing whitespace, allowing for two trailing spaces as a
+    // Markdown line break.
+    //
+    int end = text.length();
+
+    while ((end > 0) && text[end - 1].isSpace())
+    {
+        end--;
+    }
+
+    int trailingLength = text.length() - end;
+
+    if
+    (
+        (trailingLength > 0) &&
+        !(
+            (2 == trailingLength) &&
+            (end > 0) &&
+            text.endsWith("  ") &&
+            (MarkdownStateCodeBlock != state) &&
+            (MarkdownStateInGithubCodeFence != state) &&
+            (MarkdownStateInPandocCodeFence != state)
+        )
+    )
+    {
+        diagnostic.position = end;
+        diagnostic.length = trailingLength;
+        diagnostic.rule = LintRuleTrailingWhitespace;
+        diagnostics.append(diagnostic);
+    }
+
+    if (data->untaggedCodeFence)
+    {
+        diagnostic.position = 0;
+        diagnostic.length = text.length();
+        diagnostic.rule = LintRuleCodeFenceWithoutLanguage;
+        diagnostics.append(diagnostic);
+    }
+
+    // Check that the heading is at most one level deeper than the previous
+    // heading.
+    //
+    if (data->headingLevel > 0)
+    {
+        QTextBlock previous = block.previous();
+
+        while (previous.isValid())
+        {
+            TextBlockData* previousData = (TextBlockData*) previous.userData();
+
+            if ((NULL != previousData) && (previousData->headingLevel > 0))
+            {
+                if (data->headingLevel > (previousData->headingLevel + 1))
+                {
+                    diagnostic.position = 0;
+                    diagnostic.length = text.length();
+                    diagnostic.rule = LintRuleSkippedHeadingLevel;
+                    diagnostic.expected = previousData->headingLevel + 1;
+                    diagnostic.actual = data->headingLevel;
+                    diagnostics.append(diagnostic);
+                }
+
+                break;
+            }
+
+            previous = previous.previous();
+        }
+    }
+
+    // Check that the bullet point marker is the same as that of the
+    // previous item in the list at the same indentation.
+    //
+    if (!data->listMarker.isNull())
+    {
+        QTextBlock previous = block.previous();
+
+        while (previous.isValid() && isListState(previous.userState()))
+        {
+            TextBlockData* previousData = (TextBlockData*) previous.userData();
+
+            if ((NULL != previousData) && (previousData->listIndent >= 0))
+            {
+                if (previousData->listIndent < data->listIndent)
+                {
+                    // This is the first item of a nested list.
+                    break;
+                }
+                else if
+                (
+                    (previousData->listIndent == data->listIndent) &&
+                    !previousData->listMarker.isNull()
+                )
+                {
+                    if (previousData->listMarker != data->listMarker)
+                    {
+                        diagnostic.position = data->listIndent;
+                        diagnostic.length = 1;
+                        diagnostic.rule = LintRuleInconsistentListMarker;
+                        diagnostic.expected = previousData->listMarker.unicode();
+                        diagnostic.actual = data->listMarker.unicode();
+                        diagnostics.append(diagnostic);
+                    }
+
+                    break;
+                }
+            }
+
+            previous = previous.previous();
+        }
+    }
+
+    // Check that table rows have as many columns as the table header.
+    if
+    (
+        (data->tableColumnCount > 0) &&
+        (MarkdownStatePipeTableHeader != state)
+    )
+    {
+        QTextBlock previous = block.previous();
+
+        while (previous.isValid() && isTableState(previous.userState()))
+        {
+            if (MarkdownStatePipeTableHeader == previous.userState())
+            {
+                TextBlockData* headerData = (TextBlockData*) previous.userData();
+
+                if
+                (
+                    (NULL != headerData) &&
+                    (headerData->tableColumnCount > 0) &&
+                    (headerData->tableColumnCount != data->tableColumnCount)
+                )
+                {
+                    diagnostic.position = 0;
+                    diagnostic.length = text.length();
+                    diagnostic.rule = LintRuleTableColumnCount;
+                    diagnostic.expected = headerData->tableColumnCount;
+                    diagnostic.actual = data->tableColumnCount;
+                    diagnostics.append(diagnostic);
+                }
+
+                break;
+            }
+
+            previous = previous.previous();
+        }
+    }
+
+    if (diagnostics == data->lintDiagnostics)
+    {
+        return false;
+    }
+
+    data->lintDiagnostics = diagnostics;
+    return true;
+}
+
+bool MarkdownLinter::checkDependentBlocks
+(
+    QTextBlock block,
+    bool headingChanged,
+    bool listChanged,
+    bool tableChanged
+)
+{
+    bool changed = false;
+
+    // Only the next heading depends on this block's heading level.
+    if (headingChanged)
+    {
+        QTextBlock next = block.next();
+
+        while (next.isValid())
+        {
+            TextBlockData* nextData = (TextBlockData*) next.userData();
+
+            if ((NULL != nextData) && (nextData->headingLevel > 0))
+            {
+                changed = checkBlock(next) || changed;
+                break;
+            }
+
+            next = next.next();
+        }
+    }
+
+    if (listChanged)
+    {
+        QTextBlock next = block.next();
+
+        while (next.isValid() && isListState(next.userState()))
+        {
+            changed = checkBlock(next) || changed;
+            next = next.next();
+        }
+    }
+
+    if (tableChanged)
+    {
+        QTextBlock next = block.next();
+
+        while
+        (
+            next.isValid() &&
+            isTableState(next.userState()) &&
+            (MarkdownStatePipeTableHeader != next.userState())
+        )
+        {
+            changed = checkBlock(next) || changed;
+            next = next.next();
+        }
+    }
+
+    return changed;
+}
+
+bool MarkdownLinter::isListState(int state)
+{
+    switch (state)
+    {
+        case MarkdownStateBulletPointList:
+        case MarkdownStateNumberedList:
+        case MarkdownStateListLineBreak:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool MarkdownLinter::isTableState(int state)
+{
+    switch (state)
+    {
+        case MarkdownStatePipeTableHeader:
+        case MarkdownStatePipeTableDivider:
+        case MarkdownStatePipeTableRow:
+            return true;
+        default:
+            return false;
+    }
+}
+
+int MarkdownLinter::headingLevelForState(int state)
+{
+    switch (state)
+    {
+        case MarkdownStateAtxHeading1:
+        case MarkdownStateSetextHeading1Line1:
+            return 1;
+        case MarkdownStateAtxHeading2:
+        case MarkdownStateSetextHeading2Line1:
+            return 2;
+        case MarkdownStateAtxHeading3:
+            return 3;
+        case MarkdownStateAtxHeading4:
+            return 4;
+        case MarkdownStateAtxHeading5:
+            return 5;
+        case MarkdownStateAtxHeading6:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+int MarkdownLinter::countTableColumns(const QString& text, const QList<Token>& tokens)
+{
+    QList<int> pipePositions;
+
+    foreach (const Token& token, tokens)
+    {
+        if (TokenTablePipe == token.getType())
+        {
+            pipePositions.append(token.getPosition());
+        }
+    }
+
+    // The tokenizer does not mark the pipes of the divider row, which
+    // cannot contain escaped pipes or code spans anyway.
+    //
+    if (pipePositions.isEmpty())
+    {
+        for (int i = 0; i < text.length(); i++)
+        {
+            if ('|' == text[i])
+            {
+                pipePositions.append(i);
+            }
+        }
+    }
+
+    int first = 0;
+    int last = text.length() - 1;
+
+    while ((first <= last) && text[first].isSpace())
+    {
+        first++;
+    }
+
+    while ((last >= first) && text[last].isSpace())
+    {
+        last--;
+    }
+
+    if (first > last)
+    {
+        return 0;
+    }
+
+    // Leading and trailing pipes are optional, and don't start new columns.
+    int columns = pipePositions.size() + 1;
+
+    if (pipePositions.contains(first))
+    {
+        columns--;
+    }
+
+    if ((last != first) && pipePositions.contains(last))
+    {
+        columns--;
+    }
+
+    return columns;
+}
@@ -0,0 +1,121 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef MARKDOWNLINTER_H
+#define MARKDOWNLINTER_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <QTextBlock>
+
+#include "MarkdownLintTypes.h"
+#include "Token.h"
+
+class QTextDocument;
+class TextBlockData;
+
+/**
+ * Checks a Markdown document against house style rules, one block at a time.
+ *
+ * The linter does not parse the document itself.  Instead, the
+ * MarkdownHighlighter passes it each block's tokens as the block is
+ * highlighted, from which the linter records a few structural facts about
+ * the block (heading level, bullet point marker, table column count, and
+ * the like) in the block's TextBlockData.  Rules that depend on other
+ * blocks, such as skipped heading levels, only ever look back at the facts
+ * recorded for previous blocks.  When a block's facts change, the blocks
+ * after it whose diagnostics depend on those facts are checked again.
+ * Thus, diagnostics are only recomputed for the blocks that changed and
+ * their structural neighbors.
+ */
+class MarkdownLinter : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Takes the document to lint as a parameter.  Note
+         * that the linter must be constructed after the highlighter that
+         * calls lintBlock(), so that it is notified of changes to the
+         * document only after the highlighter has processed them.
+         */
+        MarkdownLinter(QTextDocument* document, QObject* parent = NULL);
+
+        /**
+         * Destructor.
+         */
+        virtual ~MarkdownLinter();
+
+        /**
+         * Lints the given block, which has just been tokenized into the
+         * given tokens.  This method is meant to be called by the
+         * highlighter after setting the block's state.
+         */
+        void lintBlock(QTextBlock block, const QList<Token>& tokens);
+
+        /**
+         * Returns a description of the given diagnostic for display to the
+         * user.
+         */
+        static QString describe(const MarkdownLintDiagnostic& diagnostic);
+
+    signals:
+        /**
+         * Emitted when the diagnostics for any block in the document have
+         * changed.
+         */
+        void diagnosticsChanged();
+
+    private slots:
+        void onContentsChange(int position, int charsRemoved, int charsAdded);
+
+    private:
+        QTextDocument* document;
+        int lastBlockCount;
+
+        TextBlockData* blockData(QTextBlock& block) const;
+
+        /*
+         * Recomputes the diagnostics for the given block from its text and
+         * the facts recorded for it and for the blocks before it.  Returns
+         * true if the diagnostics changed.
+         */
+        bool checkBlock(QTextBlock& block);
+
+        /*
+         * Checks the blocks after the given one whose diagnostics depend
+         * on the given block's facts.  Returns true if any diagnostics
+         * changed.
+         */
+        bool checkDependentBlocks
+        (
+            QTextBlock block,
+            bool headingChanged,
+            bool listChanged,
+            bool tableChanged
+        );
+
+        static bool isListState(int state);
+        static bool isTableState(int state);
+        static int headingLevelForState(int state);
+        static int countTableColumns(const QString& text, const QList<Token>& tokens);
+};
+
+#endif // MARKDOWNLINTER_H
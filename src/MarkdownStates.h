@@ -53,7 +53,10 @@ enum MarkdownState
     MarkdownStateSetextHeading2Line2,
     MarkdownStatePipeTableHeader,
     MarkdownStatePipeTableDivider,
-    MarkdownStatePipeTableRow
+    MarkdownStatePipeTableRow,
+    MarkdownStateFrontMatter,
+    MarkdownStateFrontMatterEnd,
+    MarkdownStateDefinitionList
 };
 
 #endif // MARKDOWN_STATES_H
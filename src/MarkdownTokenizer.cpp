@@ -26,9 +26,11 @@
 
 // This character is used to replace escape characters and other characters
 // with special meaning in a dummy copy of the current line being parsed,
-// for ease of parsing.
+// for ease of parsing.  It is the ASCII substitute character rather than a
+// printable one, so that it cannot be mistaken for markup, such as the
+// dollar signs around inline math.
 //
-static const QChar DUMMY_CHAR('$');
+static const QChar DUMMY_CHAR(0x1A);
 
 static const int MAX_MARKDOWN_HEADING_LEVEL = 6;
 
@@ -69,6 +71,13 @@ MarkdownTokenizer::MarkdownTokenizer()
     htmlInlineCommentRegex.setMinimal(true);
     mentionRegex.setPattern("\\B@\\w+(\\-\\w+)*(/\\w+(\\-\\w+)*)?");
     pipeTableDividerRegex.setPattern("^ {0,3}(\\|[ :]?)?-{3,}([ :]?\\|[ :]?-{3,}([ :]?\\|)?)+\\s*$");
+    frontMatterStartRegex.setPattern("^---\\s*$");
+    frontMatterEndRegex.setPattern("^(---|\\.\\.\\.)\\s*$");
+    footnoteDefinitionRegex.setPattern("^ {0,3}\\[\\^[^\\]\\s]+\\]:");
+    footnoteReferenceRegex.setPattern("\\[\\^[^\\]\\s]+\\]");
+    definitionRegex.setPattern("^ {0,3}[:~][ \\t]+\\S.*$");
+
+    setFlavor(MarkdownFlavorGitHub);
 }
         
 MarkdownTokenizer::~MarkdownTokenizer()
@@ -88,7 +97,68 @@ void MarkdownTokenizer::tokenize
     this->previousState = previousState;
     this->nextState = nextState;
 
+    (this->*lineTokenizer)(text);
+
+    // Make sure that if the second line of a setext heading is removed the
+    // first line is reprocessed.  Otherwise, it will still show up in the
+    // document as a heading.
+    //
+    if
+    (
+        (
+            (previousState == MarkdownStateSetextHeading1Line1)
+            && (this->getState() != MarkdownStateSetextHeading1Line2)
+        )
+        ||
+        (
+            (previousState == MarkdownStateSetextHeading2Line1)
+            && (this->getState() != MarkdownStateSetextHeading2Line2)
+        )
+    )
+    {
+        this->requestBacktrack();
+    }
+}
+
+void MarkdownTokenizer::setFlavor(MarkdownFlavor flavor)
+{
+    this->flavor = flavor;
+
+    switch (flavor)
+    {
+        case MarkdownFlavorCommonMark:
+            lineTokenizer = &MarkdownTokenizer::tokenizeLine<MarkdownFlavorCommonMark>;
+            break;
+        case MarkdownFlavorPandoc:
+            lineTokenizer = &MarkdownTokenizer::tokenizeLine<MarkdownFlavorPandoc>;
+            break;
+        case MarkdownFlavorMultiMarkdown:
+            lineTokenizer = &MarkdownTokenizer::tokenizeLine<MarkdownFlavorMultiMarkdown>;
+            break;
+        default:
+            this->flavor = MarkdownFlavorGitHub;
+            lineTokenizer = &MarkdownTokenizer::tokenizeLine<MarkdownFlavorGitHub>;
+            break;
+    }
+}
+
+MarkdownFlavor MarkdownTokenizer::getFlavor() const
+{
+    return flavor;
+}
+
+template <int Features>
+void MarkdownTokenizer::tokenizeLine(const QString& text)
+{
     if
+    (
+        (Features & MarkdownFeatureFrontMatter)
+        && tokenizeFrontMatter(text)
+    )
+    {
+        ; // No further tokenizing required
+    }
+    else if
     (
         (MarkdownStateComment != previousState)
         && paragraphBreakRegex.exactMatch(text)
@@ -122,7 +192,7 @@ void MarkdownTokenizer::tokenize
         || tokenizeCodeBlock(text)
         || tokenizeMultilineComment(text)
         || tokenizeHorizontalRule(text)
-        || tokenizeTableDivider(text)
+        || ((Features & MarkdownFeaturePipeTables) && tokenizeTableDivider(text))
     )
     {
         ; // No further tokenizing required
@@ -132,11 +202,12 @@ void MarkdownTokenizer::tokenize
         tokenizeAtxHeading(text)
         || tokenizeSetextHeadingLine1(text)
         || tokenizeBlockquote(text)
+        || ((Features & MarkdownFeatureDefinitionLists) && tokenizeDefinition(text))
         || tokenizeNumberedList(text)
         || tokenizeBulletPointList(text)
     )
     {
-        tokenizeInline(text);
+        tokenizeInline<Features>(text);
     }
     else
     {
@@ -167,27 +238,7 @@ void MarkdownTokenizer::tokenize
         }
 
         // tokenize inline
-        tokenizeInline(text);
-    }
-
-    // Make sure that if the second line of a setext heading is removed the
-    // first line is reprocessed.  Otherwise, it will still show up in the
-    // document as a heading.
-    //
-    if
-    (
-        (
-            (previousState == MarkdownStateSetextHeading1Line1)
-            && (this->getState() != MarkdownStateSetextHeading1Line2)
-        )
-        ||
-        (
-            (previousState == MarkdownStateSetextHeading2Line1)
-            && (this->getState() != MarkdownStateSetextHeading2Line2)
-        )
-    )
-    {
-        this->requestBacktrack();
+        tokenizeInline<Features>(text);
     }
 }
 
@@ -739,6 +790,75 @@ bool MarkdownTokenizer::tokenizeMultilineComment
     return false;
 }
 
+bool MarkdownTokenizer::tokenizeFrontMatter(const QString& text)
+{
+    if (MarkdownStateFrontMatter == previousState)
+    {
+        if (frontMatterEndRegex.exactMatch(text))
+        {
+            setState(MarkdownStateFrontMatterEnd);
+        }
+        else
+        {
+            setState(MarkdownStateFrontMatter);
+        }
+    }
+    else if
+    (
+        (MarkdownStateUnknown == previousState)
+        && frontMatterStartRegex.exactMatch(text)
+    )
+    {
+        // Front matter can only start on the first line of the document,
+        // which is the line that has no previous line state.
+        //
+        setState(MarkdownStateFrontMatter);
+    }
+    else
+    {
+        return false;
+    }
+
+    Token token;
+    token.setType(TokenFrontMatter);
+    token.setPosition(0);
+    token.setLength(text.length());
+    addToken(token);
+    return true;
+}
+
+bool MarkdownTokenizer::tokenizeDefinition(const QString& text)
+{
+    if
+    (
+        (
+            (MarkdownStateParagraph == previousState)
+            || (MarkdownStateDefinitionList == previousState)
+        )
+        && definitionRegex.exactMatch(text)
+    )
+    {
+        int markerIndex = 0;
+
+        while (QChar(' ') == text[markerIndex])
+        {
+            markerIndex++;
+        }
+
+        Token token;
+        token.setType(TokenDefinitionList);
+        token.setPosition(0);
+        token.setLength(text.length());
+        token.setOpeningMarkupLength(markerIndex + 1);
+        addToken(token);
+        setState(MarkdownStateDefinitionList);
+        return true;
+    }
+
+    return false;
+}
+
+template <int Features>
 bool MarkdownTokenizer::tokenizeInline
 (
     const QString& text
@@ -746,6 +866,11 @@ bool MarkdownTokenizer::tokenizeInline
 {
     QString escapedText = dummyOutEscapeCharacters(text);
 
+    if (Features & MarkdownFeatureFootnotes)
+    {
+        tokenizeFootnoteDefinition(escapedText);
+    }
+
     // Check if the line is a reference definition.
     if (referenceDefinitionRegex.exactMatch(escapedText))
     {
@@ -768,19 +893,44 @@ bool MarkdownTokenizer::tokenizeInline
     }
 
     tokenizeVerbatim(escapedText);
+
+    if (Features & MarkdownFeatureInlineMath)
+    {
+        tokenizeInlineMath(escapedText);
+    }
+
     tokenizeHtmlComments(escapedText);
-    tokenizeTableHeaderRow(escapedText);
-    tokenizeTableRow(escapedText);
+
+    if (Features & MarkdownFeaturePipeTables)
+    {
+        tokenizeTableHeaderRow(escapedText);
+        tokenizeTableRow(escapedText);
+    }
+
+    if (Features & MarkdownFeatureFootnotes)
+    {
+        tokenizeMatches(TokenFootnoteReference, escapedText, footnoteReferenceRegex, 0, 0, false, true);
+    }
+
     tokenizeMatches(TokenImage, escapedText, imageRegex, 0, 0, false, true);
     tokenizeMatches(TokenInlineLink, escapedText, inlineLinkRegex, 0, 0, false, true);
     tokenizeMatches(TokenReferenceLink, escapedText, referenceLinkRegex, 0, 0, false, true);
     tokenizeMatches(TokenHtmlEntity, escapedText, htmlEntityRegex);
     tokenizeMatches(TokenAutomaticLink, escapedText, automaticLinkRegex, 0, 0, false, true);
-    tokenizeMatches(TokenStrikethrough, escapedText, strikethroughRegex, 2, 2);
+
+    if (Features & MarkdownFeatureStrikethrough)
+    {
+        tokenizeMatches(TokenStrikethrough, escapedText, strikethroughRegex, 2, 2);
+    }
+
     tokenizeMatches(TokenStrong, escapedText, strongRegex, 2, 2, true);
     tokenizeMatches(TokenEmphasis, escapedText, emphasisRegex, 1, 1, true);
     tokenizeMatches(TokenHtmlTag, escapedText, htmlTagRegex);
-    tokenizeMatches(TokenMention, escapedText, mentionRegex, 0, 0, false, true);
+
+    if (Features & MarkdownFeatureMentions)
+    {
+        tokenizeMatches(TokenMention, escapedText, mentionRegex, 0, 0, false, true);
+    }
 
     return true;
 }
@@ -837,6 +987,108 @@ void MarkdownTokenizer::tokenizeVerbatim(QString& text)
     }
 }
 
+void MarkdownTokenizer::tokenizeInlineMath(QString& text)
+{
+    int index = text.indexOf(QChar('$'));
+
+    while (index >= 0)
+    {
+        int delimiterLength = 1;
+        int endIndex = -1;
+
+        if (((index + 1) < text.length()) && (QChar('$') == text[index + 1]))
+        {
+            delimiterLength = 2;
+        }
+
+        int start = index + delimiterLength;
+
+        if (2 == delimiterLength)
+        {
+            endIndex = text.indexOf("$$", start);
+
+            if (endIndex == start)
+            {
+                endIndex = -1;
+            }
+        }
+        else if ((start < text.length()) && !text[start].isSpace())
+        {
+            // As with Pandoc, the opening dollar sign must be followed by a
+            // non-space character, and the closing one must be preceded by
+            // a non-space character and not followed by a digit, so that
+            // prices such as $20 and $30 aren't taken for math.
+            //
+            for (int i = start + 1; i < text.length(); i++)
+            {
+                if
+                (
+                    (QChar('$') == text[i])
+                    && !text[i - 1].isSpace()
+                    &&
+                    (
+                        ((i + 1) >= text.length())
+                        || !text[i + 1].isDigit()
+                    )
+                )
+                {
+                    endIndex = i;
+                    break;
+                }
+            }
+        }
+
+        if (endIndex >= 0)
+        {
+            Token token;
+            token.setType(TokenInlineMath);
+            token.setPosition(index);
+            token.setLength(endIndex + delimiterLength - index);
+            token.setOpeningMarkupLength(delimiterLength);
+            token.setClosingMarkupLength(delimiterLength);
+            addToken(token);
+
+            // Fill out the math with the dummy character so that its
+            // contents aren't taken for emphasis or other markup.
+            //
+            for (int i = index; i < (index + token.getLength()); i++)
+            {
+                text[i] = DUMMY_CHAR;
+            }
+
+            index += token.getLength();
+        }
+        else
+        {
+            index = start;
+        }
+
+        index = text.indexOf(QChar('$'), index);
+    }
+}
+
+void MarkdownTokenizer::tokenizeFootnoteDefinition(QString& text)
+{
+    if (0 == footnoteDefinitionRegex.indexIn(text))
+    {
+        int length = footnoteDefinitionRegex.matchedLength();
+
+        Token token;
+        token.setType(TokenFootnoteDefinition);
+        token.setPosition(0);
+        token.setLength(length);
+        addToken(token);
+
+        // Replace the label so that it doesn't get highlighted as a
+        // reference definition or reference link.
+        //
+        for (int i = 0; i < length; i++)
+        {
+            text[i] = DUMMY_CHAR;
+        }
+    }
+}
+
 void MarkdownTokenizer::tokenizeHtmlComments(QString& text)
 {
     // Check for the end of a multiline comment so that it doesn't get further
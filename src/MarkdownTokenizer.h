@@ -22,6 +22,7 @@
 #define MARKDOWNTOKENIZER_H
 
 #include "HighlightTokenizer.h"
+#include "MarkdownFlavor.h"
 
 class QRegExp;
 class QString;
@@ -63,12 +64,23 @@ enum MarkdownTokenType
     TokenTableHeader,
     TokenTableDivider,
     TokenTablePipe,
+    TokenFrontMatter,
+    TokenFootnoteReference,
+    TokenFootnoteDefinition,
+    TokenInlineMath,
+    TokenDefinitionList,
     TokenLast
 };
 
 /**
  * Tokenizes one line of Markdown text at a time.  See documentation for
  * HighlightTokenizer class for details.
+ *
+ * Syntax that only some Markdown processors support is recognized according
+ * to the current MarkdownFlavor.  The line tokenizer is a template that is
+ * instantiated once per flavor, with the flavor's feature flags as its
+ * argument, so that a flavor pays nothing per line for the features it
+ * does not support.
  */
 class MarkdownTokenizer : public HighlightTokenizer
 {
@@ -84,10 +96,25 @@ class MarkdownTokenizer : public HighlightTokenizer
             int nextState
         );
 
+        /**
+         * Sets the Markdown flavor whose syntax is to be recognized.
+         * Defaults to MarkdownFlavorGitHub.
+         */
+        void setFlavor(MarkdownFlavor flavor);
+
+        /**
+         * Gets the Markdown flavor whose syntax is recognized.
+         */
+        MarkdownFlavor getFlavor() const;
+
     private:
+        typedef void (MarkdownTokenizer::*LineTokenizer)(const QString& text);
+
         int currentState;
         int previousState;
         int nextState;
+        MarkdownFlavor flavor;
+        LineTokenizer lineTokenizer;
 
         QRegExp paragraphBreakRegex;
         QRegExp heading1SetextRegex;
@@ -114,7 +141,18 @@ class MarkdownTokenizer : public HighlightTokenizer
         QRegExp htmlInlineCommentRegex;
         QRegExp mentionRegex;
         QRegExp pipeTableDividerRegex;
+        QRegExp frontMatterStartRegex;
+        QRegExp frontMatterEndRegex;
+        QRegExp footnoteDefinitionRegex;
+        QRegExp footnoteReferenceRegex;
+        QRegExp definitionRegex;
 
+        /*
+         * Tokenizes a line for the flavor whose MarkdownFeature flags are
+         * given as the template argument.
+         */
+        template <int Features>
+        void tokenizeLine(const QString& text);
 
         bool tokenizeSetextHeadingLine1(const QString& text);
         bool tokenizeSetextHeadingLine2(const QString& text);
@@ -126,9 +164,14 @@ class MarkdownTokenizer : public HighlightTokenizer
         bool tokenizeBlockquote(const QString& text);
         bool tokenizeCodeBlock(const QString& text);
         bool tokenizeMultilineComment(const QString& text);
-        
+        bool tokenizeFrontMatter(const QString& text);
+        bool tokenizeDefinition(const QString& text);
+
+        template <int Features>
         bool tokenizeInline(const QString& text);
         void tokenizeVerbatim(QString& text);
+        void tokenizeInlineMath(QString& text);
+        void tokenizeFootnoteDefinition(QString& text);
         void tokenizeHtmlComments(QString& text);
         void tokenizeTableHeaderRow(QString& text);
         bool tokenizeTableDivider(const QString& text);
@@ -0,0 +1,199 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QStringList>
+#include <QTextStream>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
+
+#include "MemoryAccounting.h"
+#include "spelling/dictionary_manager.h"
+
+// Rough ratio of the memory that Hunspell uses for a loaded dictionary to
+// the size of its .aff and .dic files, as its hash tables and affix
+// entries take up more room than the text they are parsed from.
+//
+#define GW_MEMORY_DICTIONARY_EXPANSION 3
+
+MemoryAccounting* MemoryAccounting::instance = NULL;
+
+MemoryAccounting* MemoryAccounting::getInstance()
+{
+    if (NULL == instance)
+    {
+        instance = new MemoryAccounting();
+    }
+
+    return instance;
+}
+
+void MemoryAccounting::addAccountable(MemoryAccountable* accountable)
+{
+    if (!accountables.contains(accountable))
+    {
+        accountables.append(accountable);
+    }
+}
+
+void MemoryAccounting::removeAccountable(MemoryAccountable* accountable)
+{
+    accountables.removeAll(accountable);
+}
+
+QList<MemoryUsage> MemoryAccounting::measure() const
+{
+    QList<MemoryUsage> usage;
+
+    foreach (MemoryAccountable* accountable, accountables)
+    {
+        accountable->accountMemory(usage);
+    }
+
+    accountDictionaries(usage);
+
+    // Sum the entries of each subsystem.  QMap keeps them sorted by name.
+    QMap<QString, MemoryUsage> totals;
+
+    foreach (const MemoryUsage& entry, usage)
+    {
+        MemoryUsage& total = totals[entry.subsystem];
+        total.subsystem = entry.subsystem;
+        total.objectCount += entry.objectCount;
+        total.estimatedBytes += entry.estimatedBytes;
+    }
+
+    return totals.values();
+}
+
+qint64 MemoryAccounting::residentSetSize()
+{
+#if defined(Q_OS_LINUX)
+    QFile statm("/proc/self/statm");
+
+    if (statm.open(QIODevice::ReadOnly))
+    {
+        // The second field is the number of resident pages.
+        QStringList fields = QString(statm.readAll()).split(' ');
+
+        if (fields.size() > 1)
+        {
+            return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+        }
+    }
+#endif
+
+    return -1;
+}
+
+QString MemoryAccounting::toJson(const QList<MemoryUsage>& usage)
+{
+    QString json;
+    QTextStream out(&json);
+    qint64 totalBytes = 0;
+
+    out << "{\n    \"subsystems\": {";
+
+    for (int i = 0; i < usage.size(); i++)
+    {
+        QString name = usage[i].subsystem;
+        name.replace("\\", "\\\\").replace("\"", "\\\"");
+
+        out << ((i > 0) ? ",\n" : "\n")
+            << "        \"" << name << "\": { \"objectCount\": "
+            << usage[i].objectCount << ", \"estimatedBytes\": "
+            << usage[i].estimatedBytes << " }";
+
+        totalBytes += usage[i].estimatedBytes;
+    }
+
+    out << "\n    },\n    \"totalEstimatedBytes\": " << totalBytes << ",\n"
+        << "    \"residentSetSize\": ";
+
+    qint64 rss = residentSetSize();
+
+    if (rss < 0)
+    {
+        out << "null";
+    }
+    else
+    {
+        out << rss;
+    }
+
+    out << "\n}\n";
+    out.flush();
+
+    return json;
+}
+
+QString MemoryAccounting::formatBytes(qint64 bytes)
+{
+    if (bytes < 1024)
+    {
+        return QString("%1 B").arg(bytes);
+    }
+    else if (bytes < (1024 * 1024))
+    {
+        return QString("%1 KB").arg(bytes / 1024.0, 0, 'f', 1);
+    }
+    else
+    {
+        return QString("%1 MB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+    }
+}
+
+MemoryAccounting::MemoryAccounting()
+{
+    ;
+}
+
+MemoryAccounting::~MemoryAccounting()
+{
+    ;
+}
+
+void MemoryAccounting::accountDictionaries(QList<MemoryUsage>& usage) const
+{
+    MemoryUsage dictionaries(GW_MEMORY_DICTIONARIES);
+
+    // Only Hunspell dictionaries can be estimated from their files.  The
+    // dictionaries of other providers are counted, but not sized.
+    //
+    foreach (QString language, DictionaryManager::instance().loadedDictionaries())
+    {
+        dictionaries.objectCount++;
+
+        QFileInfo aff("dict:" + language + ".aff");
+        QFileInfo dic("dict:" + language + ".dic");
+
+        if (aff.exists() && dic.exists())
+        {
+            dictionaries.estimatedBytes +=
+                (aff.size() + dic.size()) * GW_MEMORY_DICTIONARY_EXPANSION;
+        }
+    }
+
+    usage.append(dictionaries);
+}
@@ -0,0 +1,140 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef MEMORYACCOUNTING_H
+#define MEMORYACCOUNTING_H
+
+#include <QList>
+#include <QString>
+
+/*
+ * Names of the subsystems whose memory is accounted for.  These are also
+ * the keys of the JSON dump, so do not translate them.
+ */
+#define GW_MEMORY_DOCUMENT_TEXT "Document text"
+#define GW_MEMORY_UNDO_HISTORY "Undo history"
+#define GW_MEMORY_TEXT_BLOCK_DATA "Text block data"
+#define GW_MEMORY_HIGHLIGHT_FORMATS "Highlight formats"
+#define GW_MEMORY_HTML_PREVIEW "HTML preview"
+#define GW_MEMORY_DICTIONARIES "Dictionaries"
+#define GW_MEMORY_BACKGROUND_IMAGES "Background images"
+#define GW_MEMORY_IMAGE_THUMBNAILS "Image thumbnails"
+
+/**
+ * Number of objects and estimated memory held by a subsystem.
+ */
+struct MemoryUsage
+{
+    MemoryUsage(const QString& subsystem = QString(), qint64 objectCount = 0, qint64 estimatedBytes = 0)
+        : subsystem(subsystem), objectCount(objectCount), estimatedBytes(estimatedBytes)
+    {
+        ;
+    }
+
+    QString subsystem;
+    qint64 objectCount;
+    qint64 estimatedBytes;
+};
+
+/**
+ * Interface for objects that hold memory worth accounting for.  Register
+ * them with the MemoryAccounting instance for the duration of their
+ * lifetime.
+ */
+class MemoryAccountable
+{
+    public:
+        virtual ~MemoryAccountable()
+        {
+            ;
+        }
+
+        /**
+         * Appends the memory held by this object to the given list, with
+         * one entry per subsystem.  Called on the GUI thread.
+         */
+        virtual void accountMemory(QList<MemoryUsage>& usage) const = 0;
+};
+
+/**
+ * Collects per-subsystem object counts and memory estimates from the
+ * registered MemoryAccountable objects, to find out which part of the
+ * application is responsible when memory use grows over a long session.
+ * Estimates are computed from the sizes of the data structures involved,
+ * rather than from the heap, so they leave out allocator overhead and
+ * memory held privately by Qt.  This class is not thread-safe, and must
+ * only be used on the GUI thread.
+ */
+class MemoryAccounting
+{
+    public:
+        /**
+         * Gets the single instance of this class.
+         */
+        static MemoryAccounting* getInstance();
+
+        /**
+         * Registers the given object, which must be unregistered before it
+         * is destroyed.
+         */
+        void addAccountable(MemoryAccountable* accountable);
+
+        /**
+         * Unregisters the given object.
+         */
+        void removeAccountable(MemoryAccountable* accountable);
+
+        /**
+         * Measures the memory held by the registered objects and the
+         * loaded spell checking dictionaries.  Returns one entry per
+         * subsystem, summed over all objects and sorted by subsystem name.
+         */
+        QList<MemoryUsage> measure() const;
+
+        /**
+         * Returns the resident set size of the process in bytes, or -1 if
+         * it is unavailable on this platform.
+         */
+        static qint64 residentSetSize();
+
+        /**
+         * Returns the given measurement as a JSON object, along with the
+         * resident set size of the process.
+         */
+        static QString toJson(const QList<MemoryUsage>& usage);
+
+        /**
+         * Returns the given number of bytes in a human readable form, such
+         * as "1.5 MB".
+         */
+        static QString formatBytes(qint64 bytes);
+
+    private:
+        static MemoryAccounting* instance;
+
+        QList<MemoryAccountable*> accountables;
+
+        MemoryAccounting();
+        ~MemoryAccounting();
+
+        void accountDictionaries(QList<MemoryUsage>& usage) const;
+};
+
+#endif // MEMORYACCOUNTING_H
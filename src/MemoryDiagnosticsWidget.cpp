@@ -0,0 +1,254 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <QAction>
+#include <QApplication>
+#include <QClipboard>
+#include <QFile>
+#include <QFileDialog>
+#include <QTextStream>
+#include <QTimer>
+
+#include "MemoryDiagnosticsWidget.h"
+#include "MemoryAccounting.h"
+#include "MessageBoxHelper.h"
+
+// Interval in milliseconds at which memory is measured again while the
+// widget is visible.
+//
+#define GW_MEMORY_DIAGNOSTICS_REFRESH_INTERVAL 2000
+
+MemoryDiagnosticsWidget::MemoryDiagnosticsWidget(QWidget* parent) :
+    AbstractStatisticsWidget(parent)
+{
+    residentSetSizeLabel = addStatisticLabel
+        (
+            tr("Resident Memory:"),
+            tr("n/a"),
+            tr("Physical memory used by the whole process")
+        );
+    totalLabel = addStatisticLabel
+        (
+            tr("Total Estimated:"),
+            "0 B",
+            tr("Sum of the estimates below, which exclude memory held "
+                "privately by Qt and WebKit")
+        );
+    workersLabel = addStatisticLabel
+        (
+            tr("Worker Threads:"),
+            "0",
+            tr("Background worker threads, including extra ones started in "
+                "place of workers blocked on unresponsive files")
+        );
+    stolenTasksLabel = addStatisticLabel
+        (
+            tr("Stolen Tasks:"),
+            "0",
+            tr("Tasks taken by an idle worker from another worker's queue")
+        );
+
+    QString taskToolTip =
+        tr("Tasks waiting, started, finished and cancelled, with the "
+            "average and longest wait before starting and the average time "
+            "spent running");
+
+    taskLabels[TaskPriorityInteractive] =
+        addStatisticLabel(tr("Interactive Tasks:"), QString(), taskToolTip);
+    taskLabels[TaskPriorityNormal] =
+        addStatisticLabel(tr("Normal Tasks:"), QString(), taskToolTip);
+    taskLabels[TaskPriorityBackground] =
+        addStatisticLabel(tr("Background Tasks:"), QString(), taskToolTip);
+
+    refreshTimer = new QTimer(this);
+    refreshTimer->setInterval(GW_MEMORY_DIAGNOSTICS_REFRESH_INTERVAL);
+    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+
+    QAction* copyAction = new QAction(tr("Copy as JSON"), this);
+    connect(copyAction, SIGNAL(triggered()), this, SLOT(copyJson()));
+    this->addAction(copyAction);
+
+    QAction* saveAction = new QAction(tr("Save as JSON..."), this);
+    connect(saveAction, SIGNAL(triggered()), this, SLOT(saveJson()));
+    this->addAction(saveAction);
+
+    this->setContextMenuPolicy(Qt::ActionsContextMenu);
+}
+
+MemoryDiagnosticsWidget::~MemoryDiagnosticsWidget()
+{
+
+}
+
+void MemoryDiagnosticsWidget::refresh()
+{
+    QList<MemoryUsage> usage = MemoryAccounting::getInstance()->measure();
+    qint64 totalBytes = 0;
+
+    foreach (const MemoryUsage& entry, usage)
+    {
+        QLabel* label = subsystemLabels.value(entry.subsystem, NULL);
+
+        if (NULL == label)
+        {
+            label = addStatisticLabel(entry.subsystem + ":", QString());
+            subsystemLabels.insert(entry.subsystem, label);
+        }
+
+        setStringValueForLabel
+        (
+            label,
+            tr("%1 (%L2 objects)")
+                .arg(MemoryAccounting::formatBytes(entry.estimatedBytes))
+                .arg(entry.objectCount)
+        );
+
+        totalBytes += entry.estimatedBytes;
+    }
+
+    setStringValueForLabel(totalLabel, MemoryAccounting::formatBytes(totalBytes));
+
+    qint64 rss = MemoryAccounting::residentSetSize();
+
+    if (rss >= 0)
+    {
+        setStringValueForLabel(residentSetSizeLabel, MemoryAccounting::formatBytes(rss));
+    }
+
+    refreshTaskStatistics();
+}
+
+void MemoryDiagnosticsWidget::refreshTaskStatistics()
+{
+    TaskSchedulerStatistics statistics =
+        TaskScheduler::getInstance()->getStatistics();
+
+    setStringValueForLabel
+    (
+        workersLabel,
+        tr("%L1 (%L2 extra, %L3 busy)")
+            .arg(statistics.workerCount)
+            .arg(statistics.extraWorkerCount)
+            .arg(statistics.running)
+    );
+    setStringValueForLabel(stolenTasksLabel, QString("%L1").arg(statistics.stolen));
+
+    for (int p = 0; p < TaskPriorityCount; p++)
+    {
+        const TaskSchedulerStatistics::PriorityStatistics& stats =
+            statistics.priorities[p];
+
+        // Times are in microseconds.
+        double averageWait = 0.0;
+        double averageRun = 0.0;
+
+        if (stats.started > 0)
+        {
+            averageWait = stats.totalWaitTime / (1000.0 * stats.started);
+        }
+
+        if (stats.completed > 0)
+        {
+            averageRun = stats.totalRunTime / (1000.0 * stats.completed);
+        }
+
+        setStringValueForLabel
+        (
+            taskLabels[p],
+            tr("%L1 queued, %L2 started, %L3 done, %L4 cancelled; "
+                "wait %L5 ms avg, %L6 ms max; run %L7 ms avg")
+                .arg(stats.queued)
+                .arg(stats.started)
+                .arg(stats.completed)
+                .arg(stats.cancelled)
+                .arg(averageWait, 0, 'f', 1)
+                .arg(stats.maxWaitTime / 1000.0, 0, 'f', 1)
+                .arg(averageRun, 0, 'f', 1)
+        );
+    }
+}
+
+void MemoryDiagnosticsWidget::showEvent(QShowEvent* event)
+{
+    refresh();
+    refreshTimer->start();
+    AbstractStatisticsWidget::showEvent(event);
+}
+
+void MemoryDiagnosticsWidget::hideEvent(QHideEvent* event)
+{
+    refreshTimer->stop();
+    AbstractStatisticsWidget::hideEvent(event);
+}
+
+void MemoryDiagnosticsWidget::copyJson()
+{
+    QApplication::clipboard()->setText
+    (
+        MemoryAccounting::toJson(MemoryAccounting::getInstance()->measure())
+    );
+}
+
+void MemoryDiagnosticsWidget::saveJson()
+{
+    QString filePath =
+        QFileDialog::getSaveFileName
+        (
+            this,
+            tr("Save Memory Diagnostics"),
+            QString(),
+            tr("JSON (*.json)")
+        );
+
+    if (filePath.isNull() || filePath.isEmpty())
+    {
+        return;
+    }
+
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        MessageBoxHelper::critical
+        (
+            this,
+            tr("Could not save memory diagnostics."),
+            file.errorString()
+        );
+        return;
+    }
+
+    QTextStream out(&file);
+    out.setCodec("UTF-8");
+    out << MemoryAccounting::toJson(MemoryAccounting::getInstance()->measure());
+    out.flush();
+
+    if (QFile::NoError != file.error())
+    {
+        MessageBoxHelper::critical
+        (
+            this,
+            tr("Could not save memory diagnostics."),
+            file.errorString()
+        );
+    }
+
+    file.close();
+}
@@ -0,0 +1,84 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef MEMORYDIAGNOSTICSWIDGET_H
+#define MEMORYDIAGNOSTICSWIDGET_H
+
+#include <QMap>
+
+#include "AbstractStatisticsWidget.h"
+#include "TaskScheduler.h"
+
+class QLabel;
+class QTimer;
+
+/**
+ * Widget to display the object counts and estimated memory of each
+ * subsystem, as measured by MemoryAccounting, along with the queue depths
+ * and latencies of the TaskScheduler.  The measurement is refreshed
+ * periodically while the widget is visible, and can be copied or saved as
+ * JSON from the context menu.
+ */
+class MemoryDiagnosticsWidget : public AbstractStatisticsWidget
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.
+         */
+        MemoryDiagnosticsWidget(QWidget* parent = NULL);
+
+        /**
+         * Destructor.
+         */
+        virtual ~MemoryDiagnosticsWidget();
+
+    public slots:
+        /**
+         * Measures memory use again and updates the display.
+         */
+        void refresh();
+
+    protected:
+        void showEvent(QShowEvent* event);
+        void hideEvent(QHideEvent* event);
+
+    private slots:
+        void copyJson();
+        void saveJson();
+
+    private:
+        QTimer* refreshTimer;
+        QLabel* residentSetSizeLabel;
+        QLabel* totalLabel;
+        QLabel* workersLabel;
+        QLabel* stolenTasksLabel;
+        QLabel* taskLabels[TaskPriorityCount];
+
+        void refreshTaskStatistics();
+
+        // Value labels of the subsystems, which are added as they are
+        // first measured.
+        //
+        QMap<QString, QLabel*> subsystemLabels;
+};
+
+#endif // MEMORYDIAGNOSTICSWIDGET_H
@@ -0,0 +1,527 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+
+#include <QApplication>
+#include <QEventLoop>
+#include <QFile>
+#include <QKeyEvent>
+#include <QMap>
+#include <QTextCursor>
+#include <QTextStream>
+#include <QTimer>
+
+#if QT_VERSION >= 0x050000
+#include <QtWebKitWidgets>
+#else
+#include <QtWebKit>
+#endif
+
+#include "MemorySoakHarness.h"
+#include "AppSettings.h"
+#include "BackgroundImageLoader.h"
+#include "HtmlPreview.h"
+#include "MarkdownEditor.h"
+#include "MarkdownHighlighter.h"
+#include "TextDocument.h"
+#include "ThemeFactory.h"
+#include "spelling/dictionary_manager.h"
+#include "spelling/dictionary_ref.h"
+
+// Number of hours of writing simulated when none is given.
+#define GW_SOAK_DEFAULT_HOURS 8
+
+// Number of words typed per simulated minute.
+#define GW_SOAK_WORDS_PER_MINUTE 25
+
+// Simulated minutes between deleting the last word typed.
+#define GW_SOAK_DELETE_INTERVAL 3
+
+// Simulated minutes between undoing and redoing the last edit.
+#define GW_SOAK_UNDO_INTERVAL 7
+
+// Simulated minutes between theme switches.
+#define GW_SOAK_THEME_INTERVAL 30
+
+// Seed for choosing words and edit positions, so that runs are repeatable.
+#define GW_SOAK_RANDOM_SEED 1118
+
+// Time in milliseconds to wait for the preview to update before giving up
+// on it.
+//
+#define GW_SOAK_TIMEOUT 30000
+
+// Size of the window that theme background images are scaled to.
+#define GW_SOAK_WINDOW_WIDTH 1280
+#define GW_SOAK_WINDOW_HEIGHT 800
+
+static const char* const SOAK_WORDS[] =
+{
+    "the", "quiet", "harbor", "lantern", "*drifted*", "toward", "morning",
+    "and", "a", "**storm**", "gathered", "over", "`the_ledger`", "while",
+    "she", "wrote", "[notes](https://example.com)", "about", "everything",
+    "that", "mattered", "to", "her", "mispeled", "words", "stay", "behind"
+};
+
+MemorySoakHarness::MemorySoakHarness
+(
+    const QStringList& arguments,
+    QObject* parent
+)
+    : QObject(parent),
+    hours(GW_SOAK_DEFAULT_HOURS),
+    themeIndex(0),
+    previewUpdated(false)
+{
+    foreach (QString argument, arguments)
+    {
+        bool isNumber = false;
+        int value = argument.toInt(&isNumber);
+
+        if (isNumber && (value > 0))
+        {
+            hours = value;
+        }
+        else if (!argument.startsWith("-") && QFile::exists(argument))
+        {
+            startFilePath = argument;
+        }
+    }
+
+    themeNames = ThemeFactory::getInstance()->getAvailableThemes();
+
+    document = new TextDocument(this);
+    highlighter = new MarkdownHighlighter(document);
+    editor = new MarkdownEditor(document, highlighter);
+    editor->resize(GW_SOAK_WINDOW_WIDTH, GW_SOAK_WINDOW_HEIGHT);
+    preview = new HtmlPreview(document);
+
+    // The preview must render in this process for WebKit's memory to be
+    // included in the resident set size.
+    //
+    preview->setRemoteRenderingEnabled(false);
+
+    // Spell check as the editor would, so that the dictionary is loaded.
+    AppSettings* appSettings = AppSettings::getInstance();
+    QString language =
+        DictionaryManager::instance().availableDictionary(appSettings->getDictionaryLanguage());
+
+    if (!language.isNull() && !language.isEmpty())
+    {
+        editor->setDictionary(DictionaryManager::instance().requestDictionary(language));
+        editor->setSpellCheckEnabled(true);
+    }
+
+    backgroundImageLoader =
+        new BackgroundImageLoader
+        (
+            appSettings->getCacheDirectoryPath() + "/backgrounds",
+            this
+        );
+
+    connect
+    (
+        backgroundImageLoader,
+        SIGNAL(imageLoaded(QString,PictureAspect,QImage)),
+        this,
+        SLOT(onBackgroundImageLoaded(QString,PictureAspect,QImage))
+    );
+
+    eventLoop = new QEventLoop(this);
+    timeoutTimer = new QTimer(this);
+    timeoutTimer->setSingleShot(true);
+    timeoutTimer->setInterval(GW_SOAK_TIMEOUT);
+    connect(timeoutTimer, SIGNAL(timeout()), eventLoop, SLOT(quit()));
+    connect
+    (
+        preview,
+        SIGNAL(previewUpdated(PreviewTimings)),
+        this,
+        SLOT(onPreviewUpdated())
+    );
+
+    MemoryAccounting::getInstance()->addAccountable(this);
+}
+
+MemorySoakHarness::~MemorySoakHarness()
+{
+    MemoryAccounting::getInstance()->removeAccountable(this);
+
+    delete preview;
+    delete editor;
+}
+
+int MemorySoakHarness::run()
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    if (!startFilePath.isNull())
+    {
+        QFile file(startFilePath);
+
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            err << "Could not open " << startFilePath << ": "
+                << file.errorString() << "\n";
+            return 1;
+        }
+
+        QTextStream in(&file);
+        in.setCodec("UTF-8");
+        document->setPlainText(in.readAll());
+        file.close();
+    }
+
+    // The preview remembers the last selected exporter in the user's
+    // settings, so put it back once done.
+    //
+    QString originalExporterName = preview->getExporterName();
+
+    editor->show();
+    preview->show();
+    qsrand(GW_SOAK_RANDOM_SEED);
+
+    switchTheme();
+
+    // An empty document is not rendered, so there would be no update to
+    // wait for.
+    //
+    if (!document->isEmpty())
+    {
+        refreshPreview();
+    }
+
+    QApplication::processEvents();
+
+    QList<MemoryUsage> start = MemoryAccounting::getInstance()->measure();
+    qint64 startRss = MemoryAccounting::residentSetSize();
+    qint64 lastRss = startRss;
+    int droppedCount = 0;
+
+    out << "Memory soak, " << hours << " simulated hour(s), "
+        << themeNames.size() << " theme(s)\n";
+    out.flush();
+
+    for (int hour = 1; hour <= hours; hour++)
+    {
+        for (int minute = 0; minute < 60; minute++)
+        {
+            simulateMinute(((hour - 1) * 60) + minute);
+
+            if (!refreshPreview())
+            {
+                droppedCount++;
+            }
+        }
+
+        QList<MemoryUsage> usage = MemoryAccounting::getInstance()->measure();
+        qint64 estimatedBytes = 0;
+
+        foreach (const MemoryUsage& entry, usage)
+        {
+            estimatedBytes += entry.estimatedBytes;
+        }
+
+        qint64 rss = MemoryAccounting::residentSetSize();
+
+        out << "Hour " << hour << ": " << document->characterCount()
+            << " characters, estimated "
+            << MemoryAccounting::formatBytes(estimatedBytes);
+
+        if (rss >= 0)
+        {
+            out << ", resident " << MemoryAccounting::formatBytes(rss)
+                << " (" << ((rss >= lastRss) ? "+" : "-")
+                << MemoryAccounting::formatBytes(qAbs(rss - lastRss)) << ")";
+            lastRss = rss;
+        }
+
+        out << "\n";
+        out.flush();
+    }
+
+    QList<MemoryUsage> end = MemoryAccounting::getInstance()->measure();
+    qint64 endRss = MemoryAccounting::residentSetSize();
+
+    writeReport(out, start, end, startRss, endRss);
+
+    if (droppedCount > 0)
+    {
+        out << droppedCount << " preview refresh(es) timed out.\n";
+    }
+
+    // WebKit's memory caches cannot be measured directly, so estimate them
+    // by how much memory is returned when they are cleared.
+    //
+    if (endRss >= 0)
+    {
+        QWebSettings::clearMemoryCaches();
+        QApplication::processEvents();
+
+        qint64 clearedRss = MemoryAccounting::residentSetSize();
+
+        out << "WebKit memory caches: about "
+            << MemoryAccounting::formatBytes(qMax((qint64) 0, endRss - clearedRss))
+            << " released by clearing them\n";
+    }
+
+    preview->selectExporter(originalExporterName);
+    return 0;
+}
+
+void MemorySoakHarness::accountMemory(QList<MemoryUsage>& usage) const
+{
+    MemoryUsage images(GW_MEMORY_BACKGROUND_IMAGES);
+
+    if (!originalBackgroundImage.isNull())
+    {
+        images.objectCount++;
+        images.estimatedBytes += originalBackgroundImage.byteCount();
+    }
+
+    if (!adjustedBackgroundImage.isNull())
+    {
+        images.objectCount++;
+        images.estimatedBytes += adjustedBackgroundImage.byteCount();
+    }
+
+    usage.append(images);
+}
+
+void MemorySoakHarness::onPreviewUpdated()
+{
+    previewUpdated = true;
+    eventLoop->quit();
+}
+
+void MemorySoakHarness::simulateMinute(int minute)
+{
+    int wordCount = sizeof(SOAK_WORDS) / sizeof(SOAK_WORDS[0]);
+
+    // Now and then, go back and revise an earlier paragraph.
+    if ((minute % 10) == 9)
+    {
+        QTextCursor cursor(document);
+        cursor.setPosition(qrand() % document->characterCount());
+        editor->setTextCursor(cursor);
+    }
+    else
+    {
+        editor->moveCursor(QTextCursor::End);
+    }
+
+    for (int i = 0; i < GW_SOAK_WORDS_PER_MINUTE; i++)
+    {
+        typeText(QString(SOAK_WORDS[qrand() % wordCount]) + " ");
+    }
+
+    if ((minute % 5) == 4)
+    {
+        pressKey(Qt::Key_Return, "\n");
+
+        if ((minute % 20) == 19)
+        {
+            typeText("## ");
+            typeText(QString(SOAK_WORDS[qrand() % wordCount]));
+            pressKey(Qt::Key_Return, "\n");
+        }
+    }
+
+    if ((minute % GW_SOAK_DELETE_INTERVAL) == 0)
+    {
+        QTextCursor cursor = editor->textCursor();
+        cursor.movePosition(QTextCursor::PreviousWord, QTextCursor::KeepAnchor);
+        editor->setTextCursor(cursor);
+        pressKey(Qt::Key_Backspace);
+    }
+
+    if ((minute % GW_SOAK_UNDO_INTERVAL) == 0)
+    {
+        document->undo();
+        document->redo();
+    }
+
+    if ((minute % GW_SOAK_THEME_INTERVAL) == (GW_SOAK_THEME_INTERVAL - 1))
+    {
+        switchTheme();
+    }
+
+    // Let the timers for spell checking, statistics and the like fire.
+    QApplication::processEvents();
+}
+
+void MemorySoakHarness::switchTheme()
+{
+    if (themeNames.isEmpty())
+    {
+        return;
+    }
+
+    QString err;
+    Theme theme =
+        ThemeFactory::getInstance()->loadTheme
+        (
+            themeNames[themeIndex % themeNames.size()],
+            err
+        );
+    themeIndex++;
+
+    if (!err.isNull())
+    {
+        return;
+    }
+
+    editor->setColorScheme
+    (
+        theme.getDefaultTextColor(),
+        theme.getEditorBackgroundColor(),
+        theme.getMarkupColor(),
+        theme.getLinkColor(),
+        theme.getSpellingErrorColor()
+    );
+
+    originalBackgroundImage = QImage();
+    adjustedBackgroundImage = QImage();
+
+    if
+    (
+        !theme.getBackgroundImageUrl().isNull() &&
+        !theme.getBackgroundImageUrl().isEmpty()
+    )
+    {
+        backgroundImageLoader->load
+        (
+            theme,
+            BackgroundImageLoader::largestScreenSize()
+        );
+    }
+}
+
+void MemorySoakHarness::onBackgroundImageLoaded
+(
+    const QString& imagePath,
+    PictureAspect aspect,
+    const QImage& image
+)
+{
+    Q_UNUSED(imagePath)
+    Q_UNUSED(aspect)
+
+    if (image.isNull())
+    {
+        return;
+    }
+
+    originalBackgroundImage = image;
+    adjustedBackgroundImage =
+        originalBackgroundImage.scaled
+        (
+            GW_SOAK_WINDOW_WIDTH,
+            GW_SOAK_WINDOW_HEIGHT,
+            Qt::KeepAspectRatioByExpanding,
+            Qt::SmoothTransformation
+        ).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+bool MemorySoakHarness::refreshPreview()
+{
+    previewUpdated = false;
+    preview->updatePreview();
+
+    timeoutTimer->start();
+    eventLoop->exec();
+    timeoutTimer->stop();
+
+    return previewUpdated;
+}
+
+void MemorySoakHarness::typeText(const QString& text)
+{
+    for (int i = 0; i < text.length(); i++)
+    {
+        int key = text[i].toUpper().unicode();
+
+        if (QChar(' ') == text[i])
+        {
+            key = Qt::Key_Space;
+        }
+
+        pressKey(key, QString(text[i]));
+    }
+}
+
+void MemorySoakHarness::pressKey(int key, const QString& text)
+{
+    QKeyEvent press(QEvent::KeyPress, key, Qt::NoModifier, text);
+    QKeyEvent release(QEvent::KeyRelease, key, Qt::NoModifier, text);
+    QApplication::sendEvent(editor, &press);
+    QApplication::sendEvent(editor, &release);
+}
+
+void MemorySoakHarness::writeReport
+(
+    QTextStream& out,
+    const QList<MemoryUsage>& start,
+    const QList<MemoryUsage>& end,
+    qint64 startRss,
+    qint64 endRss
+) const
+{
+    QMap<QString, MemoryUsage> startUsage;
+
+    foreach (const MemoryUsage& entry, start)
+    {
+        startUsage.insert(entry.subsystem, entry);
+    }
+
+    out << "\n" << QString("Subsystem").leftJustified(22)
+        << QString("Objects").rightJustified(18)
+        << QString("Start").rightJustified(12)
+        << QString("End").rightJustified(12)
+        << QString("Growth/hour").rightJustified(14) << "\n";
+
+    foreach (const MemoryUsage& entry, end)
+    {
+        MemoryUsage before = startUsage.value(entry.subsystem, MemoryUsage(entry.subsystem));
+        qint64 growth = entry.estimatedBytes - before.estimatedBytes;
+
+        out << entry.subsystem.leftJustified(22)
+            << QString("%1 -> %2").arg(before.objectCount).arg(entry.objectCount).rightJustified(18)
+            << MemoryAccounting::formatBytes(before.estimatedBytes).rightJustified(12)
+            << MemoryAccounting::formatBytes(entry.estimatedBytes).rightJustified(12)
+            << (QString((growth < 0) ? "-" : "+")
+                + MemoryAccounting::formatBytes(qAbs(growth) / hours)).rightJustified(14)
+            << "\n";
+    }
+
+    if ((startRss >= 0) && (endRss >= 0))
+    {
+        qint64 growth = endRss - startRss;
+
+        out << QString("Resident set size").leftJustified(22)
+            << QString().rightJustified(18)
+            << MemoryAccounting::formatBytes(startRss).rightJustified(12)
+            << MemoryAccounting::formatBytes(endRss).rightJustified(12)
+            << (QString((growth < 0) ? "-" : "+")
+                + MemoryAccounting::formatBytes(qAbs(growth) / hours)).rightJustified(14)
+            << "\n";
+    }
+}
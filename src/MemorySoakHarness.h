@@ -0,0 +1,127 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+
+#ifndef MEMORYSOAKHARNESS_H
+#define MEMORYSOAKHARNESS_H
+
+#include <QObject>
+#include <QImage>
+#include <QList>
+#include <QStringList>
+
+#include "MemoryAccounting.h"
+#include "Theme.h"
+
+class QEventLoop;
+class QTextStream;
+class QTimer;
+class BackgroundImageLoader;
+class HtmlPreview;
+class MarkdownEditor;
+class MarkdownHighlighter;
+class TextDocument;
+
+/*
+ * Command line argument that launches ghostwriter as the memory soak
+ * harness rather than as an editor.  It may be followed by the number of
+ * hours of writing to simulate, and by a Markdown file to start editing
+ * from.  Run with "-platform offscreen" to run without a display.
+ */
+#define GW_SOAK_HARNESS_ARG "--soak-harness"
+
+/**
+ * Simulates a long writing session to find out which subsystem is
+ * responsible when memory use grows over time.  The harness drives a
+ * MarkdownEditor and HtmlPreview through hours of scripted typing,
+ * deletions, undo and redo, preview refreshes and theme switches, as fast
+ * as they can be processed, and reports the growth of each subsystem as
+ * measured by MemoryAccounting, along with the resident set size of the
+ * process.
+ */
+class MemorySoakHarness : public QObject, public MemoryAccountable
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Takes the arguments that follow the harness
+         * argument on the command line as a parameter.
+         */
+        MemorySoakHarness(const QStringList& arguments, QObject* parent = 0);
+
+        /**
+         * Destructor.
+         */
+        ~MemorySoakHarness();
+
+        /**
+         * Runs the simulated session and writes the report to standard
+         * output.  Returns the process exit code.
+         */
+        int run();
+
+        /**
+         * Appends the memory held by the theme background images to the
+         * given list.
+         */
+        void accountMemory(QList<MemoryUsage>& usage) const;
+
+    private slots:
+        void onPreviewUpdated();
+        void onBackgroundImageLoaded(const QString& imagePath, PictureAspect aspect, const QImage& image);
+
+    private:
+        int hours;
+        QString startFilePath;
+        QStringList themeNames;
+        int themeIndex;
+        TextDocument* document;
+        MarkdownHighlighter* highlighter;
+        MarkdownEditor* editor;
+        HtmlPreview* preview;
+        QEventLoop* eventLoop;
+        QTimer* timeoutTimer;
+        bool previewUpdated;
+
+        // The current theme's background image, as loaded and as scaled
+        // to the window by the MainWindow.
+        //
+        BackgroundImageLoader* backgroundImageLoader;
+        QImage originalBackgroundImage;
+        QImage adjustedBackgroundImage;
+
+        void simulateMinute(int minute);
+        void switchTheme();
+        bool refreshPreview();
+        void typeText(const QString& text);
+        void pressKey(int key, const QString& text = QString());
+
+        void writeReport
+        (
+            QTextStream& out,
+            const QList<MemoryUsage>& start,
+            const QList<MemoryUsage>& end,
+            qint64 startRss,
+            qint64 endRss
+        ) const;
+};
+
+#endif // MEMORYSOAKHARNESS_H
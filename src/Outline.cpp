@@ -21,12 +21,13 @@
 #include <QVariant>
 
 #include "Outline.h"
+#include "DocumentStatistics.h"
 
 const int Outline::HEADING_LEVEL_ROLE = Qt::UserRole + 1;
-const int Outline::DOCUMENT_POS_ROLE = HEADING_LEVEL_ROLE + 1;
+const int Outline::HEADING_TEXT_ROLE = HEADING_LEVEL_ROLE + 1;
 
 Outline::Outline(QWidget* parent)
-    : QListWidget(parent)
+    : QListWidget(parent), documentStatistics(NULL)
 {
     connect(this, SIGNAL(itemActivated(QListWidgetItem*)), this, SLOT(onOutlineHeadingSelected(QListWidgetItem*)));
     connect(this, SIGNAL(itemClicked(QListWidgetItem*)), this, SLOT(onOutlineHeadingSelected(QListWidgetItem*)));
@@ -38,62 +39,53 @@ Outline::~Outline()
 
 }
 
+void Outline::setDocumentStatistics(DocumentStatistics* statistics)
+{
+    documentStatistics = statistics;
+
+    for (int i = 0; i < this->count(); i++)
+    {
+        updateHeadingText(i);
+    }
+}
+
+QString Outline::getHeadingText(int row) const
+{
+    return this->item(row)->data(HEADING_TEXT_ROLE).toString();
+}
+
+int Outline::getHeadingPosition(int row) const
+{
+    return headingOffsets.prefixSum(row + 1);
+}
+
 void Outline::updateCurrentNavigationHeading(int position)
 {
     currentPosition = position;
 
     if ((this->count() > 0) && (position >= 0))
     {
-        QListWidgetItem* lastItem = NULL;
-
         // Find out in which subsection of the document the cursor presently is
         // located.
         //
-        for (int i = 0; i < this->count(); i++)
+        int row = findHeadingRow(position);
+
+        // If current cursor position is less than the first heading's
+        // position, then no heading should be styled.
+        //
+        if (row < 0)
         {
-            QListWidgetItem* currentItem = this->item(i);
-            int outlinePos = currentItem->data(DOCUMENT_POS_ROLE).toInt();
-
-            // If current cursor position is less than the first heading's
-            // position, then no heading should be styled.
-            //
-            if ((0 == i) && (position < outlinePos))
-            {
-                setCurrentItem(currentItem, QItemSelectionModel::Clear);
-                this->scrollToItem(currentItem);
-                break;
-            }
-
-            QListWidgetItem* itemToHighlight = NULL;
-
-            // If cursor position is within the last found heading's text
-            // range, then style the last tree item to show that it is the
-            // current section heading.
-            //
-            if ((NULL != lastItem) && (position < outlinePos))
-            {
-                itemToHighlight = lastItem;
-            }
-            // Else if the cursor is right at the beginning of the current
-            // heading's text range, then style the current tree item.
-            //
-            else if ((position == outlinePos) || (this->count() - 1 == i))
-            {
-                itemToHighlight = currentItem;
-            }
-
-            if (NULL != itemToHighlight)
-            {
-                setCurrentItem(itemToHighlight);
-                this->scrollToItem
-                (
-                    itemToHighlight,
-                    QAbstractItemView::PositionAtCenter
-                );
-                break;
-            }
-
-            lastItem = currentItem;
+            setCurrentItem(this->item(0), QItemSelectionModel::Clear);
+            this->scrollToItem(this->item(0));
+        }
+        else
+        {
+            setCurrentItem(this->item(row));
+            this->scrollToItem
+            (
+                this->item(row),
+                QAbstractItemView::PositionAtCenter
+            );
         }
     }
 }
@@ -127,29 +119,20 @@ void Outline::onTextChanged
     }
 
     // Check for headings that were removed, and remove them from the list
-    // if they fall in the range of deleted text.
+    // if they fall in the range of deleted text.  Since the headings are
+    // sorted by position, they occupy a contiguous run of rows.
     //
-    int index = 0;
     bool headingRemoved = false;
 
-    while (index < this->count())
+    if (endRemovedIndex >= startIndex)
     {
-        int treePos = this->item(index)->data(DOCUMENT_POS_ROLE).toInt();
+        int firstRow = headingOffsets.upperBound(startIndex - 1);
+        int endRow = headingOffsets.upperBound(endRemovedIndex);
 
-        if ((treePos >= startIndex) && (treePos <= endRemovedIndex))
+        for (int row = endRow - 1; row >= firstRow; row--)
         {
-            QListWidgetItem* item = this->takeItem(index);
+            removeHeadingRow(row);
             headingRemoved = true;
-
-            if (NULL != item)
-            {
-                delete item;
-                item = NULL;
-            }
-        }
-        else
-        {
-            index++;
         }
     }
 
@@ -172,60 +155,60 @@ void Outline::insertHeadingIntoOutline
     const QString heading
 )
 {
-    QString headingText("   ");
+    int row = findHeadingRow(position);
+    QListWidgetItem* item = NULL;
 
-    for (int i = 1; i < level; i++)
+    if (level < 1)
     {
-        headingText += "    ";
+        level = 1;
+    }
+    else if (level > MAX_HEADING_LEVEL)
+    {
+        level = MAX_HEADING_LEVEL;
     }
 
-    headingText += heading;
-
-    if (this->count() <= 0)
+    if ((row >= 0) && (getHeadingPosition(row) == position))
     {
-        QListWidgetItem* item = new QListWidgetItem();
-        item->setText(headingText);
-        item->setData(DOCUMENT_POS_ROLE, QVariant(position));
-        this->addItem(item);
+        // Replace text
+        item = this->item(row);
     }
     else
     {
-        bool added = false;
+        // Insert after the last heading that comes before it.
+        row++;
+        item = new QListWidgetItem();
+        this->insertItem(row, item);
+
+        int previousPosition = headingOffsets.prefixSum(row);
+        int offset = position - previousPosition;
 
-        // Find out where it goes.
-        for (int i = 0; i < this->count(); i++)
+        headingOffsets.insert(row, 1);
+        headingOffsets.setValue(row, offset);
+
+        // The next heading's position is now relative to this one.
+        if (row + 1 < headingOffsets.size())
         {
-            int outlinePos = this->item(i)->data(DOCUMENT_POS_ROLE).toInt();
-
-            if (position < outlinePos)
-            {
-                // Insert before
-                QListWidgetItem* item = new QListWidgetItem();
-                item->setText(headingText);
-                item->setData(DOCUMENT_POS_ROLE, QVariant(position));
-                this->insertItem(i, item);
-                added = true;
-                break;
-            }
-            else if (position == outlinePos)
-            {
-                // Replace text
-                this->item(i)->setText(headingText);
-                added = true;
-                break;
-            }
+            headingOffsets.setValue(row + 1, headingOffsets.value(row + 1) - offset);
         }
 
-        if (!added)
+        for (int i = 0; i < MAX_HEADING_LEVEL; i++)
         {
-            // Insert at the end
-            QListWidgetItem* item = new QListWidgetItem();
-            item->setText(headingText);
-            item->setData(DOCUMENT_POS_ROLE, QVariant(position));
-            this->addItem(item);
+            headingsAtLevel[i].insert(row, 1);
         }
     }
 
+    for (int i = 0; i < MAX_HEADING_LEVEL; i++)
+    {
+        headingsAtLevel[i].setValue(row, (level <= i + 1) ? 1 : 0);
+    }
+
+    item->setData(HEADING_LEVEL_ROLE, QVariant(level));
+    item->setData(HEADING_TEXT_ROLE, QVariant(heading));
+    updateHeadingText(row);
+
+    // The new heading cuts short the sections it falls within.
+    updateSectionStatistics(position - 1, position);
+
     // Refresh which heading is highlighted in the outline as the
     // current position.
     //
@@ -234,47 +217,184 @@ void Outline::insertHeadingIntoOutline
 
 void Outline::removeHeadingFromOutline(int position)
 {
-    for (int i = 0; i < this->count(); i++)
-    {
-        int outlinePos = this->item(i)->data(DOCUMENT_POS_ROLE).toInt();
+    int row = findHeadingRow(position);
 
-        if (outlinePos == position)
-        {
-            QListWidgetItem* item = this->takeItem(i);
-
-            if (NULL != item)
-            {
-                delete item;
-                item = NULL;
-            }
+    if ((row >= 0) && (getHeadingPosition(row) == position))
+    {
+        removeHeadingRow(row);
 
-            // Refresh which heading is highlighted in the outline as the
-            // current position.
-            //
-            this->updateCurrentNavigationHeading(currentPosition);
+        // The sections the heading fell within now extend past it.
+        updateSectionStatistics(position - 1, position);
 
-            return;
-        }
+        // Refresh which heading is highlighted in the outline as the
+        // current position.
+        //
+        this->updateCurrentNavigationHeading(currentPosition);
     }
 }
 
 void Outline::onOutlineHeadingSelected(QListWidgetItem* item)
 {
-    int documentPosition = item->data(DOCUMENT_POS_ROLE).toInt();
-    emit documentPositionNavigated(documentPosition);
-    emit headingNumberNavigated(this->row(item) + 1);
+    int row = this->row(item);
+
+    emit documentPositionNavigated(getHeadingPosition(row));
+    emit headingNumberNavigated(row + 1);
 }
 
 void Outline::updateDocumentPositions(int startPosition, int offset)
 {
-    for (int i = 0; i < this->count(); i++)
+    // Positions are stored relative to the previous heading, so shifting
+    // the first heading past startPosition shifts all those after it.
+    //
+    int row = headingOffsets.upperBound(startPosition);
+
+    if (row < headingOffsets.size())
+    {
+        headingOffsets.setValue(row, headingOffsets.value(row) + offset);
+    }
+}
+
+void Outline::removeHeadingRow(int row)
+{
+    // The next heading's position becomes relative to the previous one.
+    if (row + 1 < headingOffsets.size())
+    {
+        headingOffsets.setValue
+        (
+            row + 1,
+            headingOffsets.value(row + 1) + headingOffsets.value(row)
+        );
+    }
+
+    headingOffsets.remove(row, 1);
+
+    for (int i = 0; i < MAX_HEADING_LEVEL; i++)
+    {
+        headingsAtLevel[i].remove(row, 1);
+    }
+
+    QListWidgetItem* item = this->takeItem(row);
+
+    if (NULL != item)
     {
-        int treePos = this->item(i)->data(DOCUMENT_POS_ROLE).toInt();
+        delete item;
+        item = NULL;
+    }
+}
+
+void Outline::updateSectionStatistics(int startPosition, int endPosition)
+{
+    if ((NULL == documentStatistics) || (this->count() <= 0))
+    {
+        return;
+    }
+
+    // The sections affected are the one in which the range starts, the
+    // sections enclosing it, and any sections beginning within the range.
+    //
+    int row = findHeadingRow(startPosition);
+
+    for (int i = row; i >= 0; i = findParentRow(i))
+    {
+        updateHeadingText(i);
+    }
+
+    int lastRow = findHeadingRow(endPosition);
+
+    for (int i = row + 1; i <= lastRow; i++)
+    {
+        updateHeadingText(i);
+    }
+}
+
+int Outline::findHeadingRow(int position) const
+{
+    return headingOffsets.upperBound(position) - 1;
+}
+
+int Outline::findSectionEnd(int row) const
+{
+    int level = this->item(row)->data(HEADING_LEVEL_ROLE).toInt();
+    const SumTree<int>& headings = headingsAtLevel[level - 1];
+
+    // The section ends at the first heading after it whose level is the
+    // same or higher.
+    //
+    int endRow = headings.upperBound(headings.prefixSum(row + 1));
+
+    if (endRow >= headingOffsets.size())
+    {
+        return -1;
+    }
+
+    return getHeadingPosition(endRow);
+}
+
+int Outline::findParentRow(int row) const
+{
+    int level = this->item(row)->data(HEADING_LEVEL_ROLE).toInt();
+
+    if (level <= 1)
+    {
+        return -1;
+    }
+
+    // The parent is the last heading before this one whose level is
+    // higher.
+    //
+    const SumTree<int>& headings = headingsAtLevel[level - 2];
+    int count = headings.prefixSum(row);
+
+    if (count <= 0)
+    {
+        return -1;
+    }
+
+    return headings.upperBound(count - 1);
+}
+
+void Outline::updateHeadingText(int row)
+{
+    QListWidgetItem* item = this->item(row);
+    int level = item->data(HEADING_LEVEL_ROLE).toInt();
+    QString headingText("   ");
 
-        if (treePos > startPosition)
+    for (int i = 1; i < level; i++)
+    {
+        headingText += "    ";
+    }
+
+    headingText += item->data(HEADING_TEXT_ROLE).toString();
+
+    if (NULL != documentStatistics)
+    {
+        int words = documentStatistics->getWordCount
+            (
+                getHeadingPosition(row),
+                findSectionEnd(row)
+            );
+
+        int minutes = DocumentStatistics::calculateReadingTime(words);
+        QString readingTime;
+
+        if (minutes < 1)
+        {
+            readingTime = tr("< 1m");
+        }
+        else if (minutes >= 60)
         {
-            treePos += offset;
-            this->item(i)->setData(DOCUMENT_POS_ROLE, QVariant(treePos));
+            readingTime = tr("%1h %2m").arg(minutes / 60).arg(minutes % 60);
         }
+        else
+        {
+            readingTime = tr("%1m").arg(minutes);
+        }
+
+        headingText += "   " + tr("(%Ln word(s), %1)", "", words).arg(readingTime);
+    }
+
+    if (item->text() != headingText)
+    {
+        item->setText(headingText);
     }
 }
@@ -23,6 +23,10 @@
 #include <QListWidget>
 #include <QString>
 
+#include "SumTree.h"
+
+class DocumentStatistics;
+
 /**
  * Outline widget for use in navigating document headings and displaying the
  * current position in the document to the user.
@@ -35,6 +39,26 @@ class Outline : public QListWidget
         Outline(QWidget* parent = 0);
         virtual ~Outline();
 
+        /**
+         * Sets the statistics from which to fetch the word count and
+         * reading time shown next to each heading.  A heading's section
+         * includes the sections of its subheadings.  If no statistics are
+         * set, only the heading text is shown.
+         */
+        void setDocumentStatistics(DocumentStatistics* statistics);
+
+        /**
+         * Returns the text of the heading at the given row in the outline,
+         * without any statistics.
+         */
+        QString getHeadingText(int row) const;
+
+        /**
+         * Returns the document position of the heading at the given row in
+         * the outline.
+         */
+        int getHeadingPosition(int row) const;
+
     signals:
         /**
          * Emitted when the user selects one of the headings in the outline
@@ -103,6 +127,13 @@ class Outline : public QListWidget
          */
         void removeHeadingFromOutline(int position);
 
+        /**
+         * Refreshes the word counts and reading times of the sections that
+         * overlap the given range of document positions.  Connect this
+         * slot to DocumentStatistics::blockWordCountsChanged().
+         */
+        void updateSectionStatistics(int startPosition, int endPosition);
+
     private slots:
         /*
          * Invoked when the user selects one of the headings in the outline
@@ -112,10 +143,24 @@ class Outline : public QListWidget
 
     private:
         static const int HEADING_LEVEL_ROLE;
-        static const int DOCUMENT_POS_ROLE;
+        static const int HEADING_TEXT_ROLE;
+        static const int MAX_HEADING_LEVEL = 6;
 
+        DocumentStatistics* documentStatistics;
         int currentPosition;
 
+        // The document position of each heading, stored by row as the
+        // distance from the previous heading's position, so that shifting
+        // the headings after an edit updates a single row.
+        //
+        SumTree<int> headingOffsets;
+
+        // For each heading level, holds 1 at the rows of the headings of
+        // that level or higher, and 0 at the others, for finding where a
+        // section ends and which sections enclose it.
+        //
+        SumTree<int> headingsAtLevel[MAX_HEADING_LEVEL];
+
         /*
          * Adds value of offset to the document positions stored in each
          * heading, beginning with the heading whose position is greater
@@ -124,6 +169,37 @@ class Outline : public QListWidget
          */
         void updateDocumentPositions(int startPosition, int offset);
 
+        /*
+         * Removes the heading at the given row from the outline.
+         */
+        void removeHeadingRow(int row);
+
+        /*
+         * Returns the row of the last heading whose position is less than
+         * or equal to the given position, or -1 if there is none.
+         */
+        int findHeadingRow(int position) const;
+
+        /*
+         * Returns the document position at which the section of the
+         * heading at the given row ends, which is the position of the next
+         * heading of the same or higher level, or -1 if the section runs
+         * to the end of the document.
+         */
+        int findSectionEnd(int row) const;
+
+        /*
+         * Returns the row of the heading whose section directly encloses
+         * that of the heading at the given row, or -1 if there is none.
+         */
+        int findParentRow(int row) const;
+
+        /*
+         * Sets the display text of the heading at the given row, including
+         * its section's word count and reading time.
+         */
+        void updateHeadingText(int row);
+
 };
 
 #endif // OUTLINE_H
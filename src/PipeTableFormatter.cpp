@@ -0,0 +1,917 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QPlainTextEdit>
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QTextDocument>
+
+#include "MarkdownStates.h"
+#include "PipeTableFormatter.h"
+
+// Minimum width of a column, which is the minimum number of dashes in a
+// cell of the divider row.
+//
+#define GW_TABLE_MIN_COLUMN_WIDTH 3
+
+PipeTableFormatter::PipeTableFormatter(QPlainTextEdit* editor, QObject* parent)
+    : QObject(parent), editor(editor)
+{
+    enabled = true;
+    formatting = false;
+    userEditPending = false;
+    firstDirtyBlock = -1;
+    lastDirtyBlock = -1;
+    lastBlockCount = editor->document()->blockCount();
+    tableFirstBlock = -1;
+    measuredBlockCount = lastBlockCount;
+    formattedLeadingPipe = false;
+    formattedTrailingPipe = false;
+
+    connect
+    (
+        editor->document(),
+        SIGNAL(contentsChange(int,int,int)),
+        this,
+        SLOT(onContentsChange(int,int,int))
+    );
+
+    // Undo and redo change the document without adding undo commands, and
+    // should not cause the table to be formatted again.
+    //
+    connect
+    (
+        editor->document(),
+        SIGNAL(undoCommandAdded()),
+        this,
+        SLOT(onUndoCommandAdded())
+    );
+}
+
+PipeTableFormatter::~PipeTableFormatter()
+{
+
+}
+
+bool PipeTableFormatter::isEnabled() const
+{
+    return enabled;
+}
+
+void PipeTableFormatter::setEnabled(bool enabled)
+{
+    this->enabled = enabled;
+}
+
+void PipeTableFormatter::formatTableAtCursor()
+{
+    if (!enabled || !userEditPending)
+    {
+        return;
+    }
+
+    QTextCursor cursor = editor->textCursor();
+    QTextBlock cursorBlock = cursor.block();
+
+    if (cursor.hasSelection() || !isTableState(cursorBlock.userState()))
+    {
+        return;
+    }
+
+    // Wait while the cursor follows whitespace, which would otherwise be
+    // trimmed from the cell before the user types the next word.
+    //
+    int positionInBlock = cursor.position() - cursorBlock.position();
+
+    if
+    (
+        (positionInBlock > 0) &&
+        cursorBlock.text()[positionInBlock - 1].isSpace()
+    )
+    {
+        return;
+    }
+
+    // Most pauses are in the table that was formatted last, whose extent
+    // is known without walking over its rows again.
+    //
+    QTextBlock header;
+    int rowCount = 0;
+
+    if
+    (
+        !findMeasuredTable(cursorBlock, header, rowCount) &&
+        !findTable(cursorBlock, header, rowCount)
+    )
+    {
+        return;
+    }
+
+    if
+    (
+        (rowCount < 2) ||
+        (MarkdownStatePipeTableDivider != header.next().userState())
+    )
+    {
+        return;
+    }
+
+    // Work out the layout of the table from its header and divider rows.
+    // Whether the header has a leading pipe decides how the other rows are
+    // split, so the table has to be measured again if that changes.
+    //
+    bool leadingPipe = false;
+    bool trailingPipe = false;
+    QVector<int> alignments;
+
+    splitRow(header.text(), true, &leadingPipe, &trailingPipe);
+
+    if (leadingPipe != formattedLeadingPipe)
+    {
+        tableFirstBlock = -1;
+    }
+
+    formattedLeadingPipe = leadingPipe;
+
+    int firstRow = 0;
+    int lastRow = -1;
+    bool remeasured = measureTable(header, rowCount, firstRow, lastRow);
+    QVector<int> widths(columnWidths.size());
+
+    userEditPending = false;
+
+    foreach (const Cell& cell, splitRow(header.next().text(), leadingPipe))
+    {
+        alignments.append(alignmentForDivider(cell.text));
+    }
+
+    for (int i = 0; i < widths.size(); i++)
+    {
+        widths[i] = columnWidth(i);
+    }
+
+    // If any column changes width or alignment, the padding of every row
+    // may change.  Otherwise, only the changed rows need to be checked.
+    //
+    if
+    (
+        remeasured ||
+        (widths != formattedWidths) ||
+        (alignments != formattedAlignments) ||
+        (trailingPipe != formattedTrailingPipe)
+    )
+    {
+        firstRow = 0;
+        lastRow = rowCount - 1;
+    }
+
+    formattedWidths = widths;
+    formattedAlignments = alignments;
+    formattedTrailingPipe = trailingPipe;
+
+    QTextCursor edit(editor->document());
+    bool editing = false;
+    int cursorRow = cursorBlock.blockNumber() - header.blockNumber();
+    int newCursorPosition = -1;
+
+    formatting = true;
+    QTextBlock block = editor->document()->findBlockByNumber(header.blockNumber() + firstRow);
+
+    for (int row = firstRow; (row <= lastRow) && block.isValid(); row++)
+    {
+        QString text = block.text();
+        QList<Cell> cells = splitRow(text, leadingPipe);
+        QVector<int> contentStarts;
+        QString formatted =
+            formatRow
+            (
+                cells,
+                (MarkdownStatePipeTableDivider == block.userState()),
+                widths,
+                alignments,
+                leadingPipe,
+                trailingPipe,
+                contentStarts
+            );
+
+        if (formatted != text)
+        {
+            if (!editing)
+            {
+                edit.beginEditBlock();
+                editing = true;
+            }
+
+            // Keep the cursor at the same place within its cell.
+            if (row == cursorRow)
+            {
+                newCursorPosition = formatted.length();
+
+                if (cells.isEmpty() || (positionInBlock <= cells.first().rawStart))
+                {
+                    newCursorPosition = qMin(positionInBlock, formatted.length());
+                }
+                else
+                {
+                    for (int i = 0; i < cells.size(); i++)
+                    {
+                        if (positionInBlock <= cells[i].rawEnd)
+                        {
+                            newCursorPosition = contentStarts[i] +
+                                qBound
+                                (
+                                    0,
+                                    positionInBlock - cells[i].start,
+                                    cells[i].text.length()
+                                );
+                            break;
+                        }
+                    }
+                }
+            }
+
+            edit.setPosition(block.position());
+            edit.setPosition(block.position() + text.length(), QTextCursor::KeepAnchor);
+            edit.insertText(formatted);
+        }
+
+        block = block.next();
+    }
+
+    if (editing)
+    {
+        edit.endEditBlock();
+    }
+
+    formatting = false;
+
+    if (newCursorPosition >= 0)
+    {
+        cursor.setPosition(cursorBlock.position() + newCursorPosition);
+        editor->setTextCursor(cursor);
+    }
+}
+
+void PipeTableFormatter::onContentsChange
+(
+    int position,
+    int charsRemoved,
+    int charsAdded
+)
+{
+    Q_UNUSED(charsRemoved)
+
+    if (formatting)
+    {
+        return;
+    }
+
+    QTextDocument* document = editor->document();
+    int blockCount = document->blockCount();
+    QTextBlock first = document->findBlock(position);
+    QTextBlock last = document->findBlock(position + charsAdded);
+
+    int firstBlock = first.isValid() ? first.blockNumber() : 0;
+    int lastBlock = last.isValid() ? last.blockNumber() : (blockCount - 1);
+
+    if (firstDirtyBlock < 0)
+    {
+        firstDirtyBlock = firstBlock;
+        lastDirtyBlock = lastBlock;
+    }
+    else
+    {
+        // Blocks inserted or removed by this change move the end of the
+        // range changed before it, if they come before that end.
+        //
+        if (firstBlock <= lastDirtyBlock)
+        {
+            lastDirtyBlock += blockCount - lastBlockCount;
+        }
+
+        firstDirtyBlock = qMin(firstDirtyBlock, firstBlock);
+        lastDirtyBlock = qMax(qMax(lastDirtyBlock, lastBlock), firstDirtyBlock);
+    }
+
+    lastBlockCount = blockCount;
+}
+
+void PipeTableFormatter::onUndoCommandAdded()
+{
+    if (!formatting)
+    {
+        userEditPending = true;
+    }
+}
+
+/*
+ * Finds the header block and the number of rows of the table containing
+ * the given block by walking over the rows of the table.  Returns false if
+ * the block is not in a table.
+ */
+bool PipeTableFormatter::findTable
+(
+    const QTextBlock& block,
+    QTextBlock& header,
+    int& rowCount
+) const
+{
+    header = block;
+
+    while (MarkdownStatePipeTableHeader != header.userState())
+    {
+        header = header.previous();
+
+        if (!header.isValid() || !isTableState(header.userState()))
+        {
+            return false;
+        }
+    }
+
+    QTextBlock row = header.next();
+    rowCount = 1;
+
+    while
+    (
+        row.isValid() &&
+        isTableState(row.userState()) &&
+        (MarkdownStatePipeTableHeader != row.userState())
+    )
+    {
+        rowCount++;
+        row = row.next();
+    }
+
+    return true;
+}
+
+/*
+ * Finds the header block and the number of rows of the table containing
+ * the given block from the extent of the table last measured, shifted by
+ * the blocks inserted or removed since.  Only the blocks changed since
+ * then and the blocks at either end of the table are checked, in place of
+ * walking over the whole table.  Returns false if the changes could have
+ * moved the start of the table, or the block is not within the table, in
+ * which case the table has to be found by walking over it.
+ */
+bool PipeTableFormatter::findMeasuredTable
+(
+    const QTextBlock& block,
+    QTextBlock& header,
+    int& rowCount
+) const
+{
+    QTextDocument* document = editor->document();
+    int oldRowCount = rowWidths.size();
+
+    if ((tableFirstBlock < 0) || (oldRowCount <= 0))
+    {
+        return false;
+    }
+
+    int blockDelta = document->blockCount() - measuredBlockCount;
+    int first = tableFirstBlock;
+    int last = tableFirstBlock + oldRowCount - 1;
+    int firstChecked = first + 1;
+    int lastChecked = first;
+
+    if (firstDirtyBlock >= 0)
+    {
+        if ((lastDirtyBlock - blockDelta) < first)
+        {
+            // The changes are all above the table.
+            first += blockDelta;
+            last += blockDelta;
+        }
+        else if (firstDirtyBlock <= first)
+        {
+            return false;
+        }
+        else if (firstDirtyBlock <= (last + 1))
+        {
+            // The changes are within the table or extend it.
+            last += blockDelta;
+            firstChecked = firstDirtyBlock;
+            lastChecked = qMin(lastDirtyBlock, last);
+        }
+    }
+
+    int blockNumber = block.blockNumber();
+
+    if ((blockNumber < first) || (blockNumber > last))
+    {
+        return false;
+    }
+
+    header = document->findBlockByNumber(first);
+
+    if (MarkdownStatePipeTableHeader != header.userState())
+    {
+        return false;
+    }
+
+    QTextBlock row = document->findBlockByNumber(firstChecked);
+
+    for (int i = firstChecked; i <= lastChecked; i++)
+    {
+        if
+        (
+            !row.isValid() ||
+            !isTableState(row.userState()) ||
+            (MarkdownStatePipeTableHeader == row.userState())
+        )
+        {
+            return false;
+        }
+
+        row = row.next();
+    }
+
+    QTextBlock lastRow = document->findBlockByNumber(last);
+    QTextBlock next = lastRow.next();
+
+    if
+    (
+        !isTableState(lastRow.userState()) ||
+        (
+            next.isValid() &&
+            isTableState(next.userState()) &&
+            (MarkdownStatePipeTableHeader != next.userState())
+        )
+    )
+    {
+        return false;
+    }
+
+    rowCount = last - first + 1;
+    return true;
+}
+
+/*
+ * Brings the cached cell widths up to date with the table that starts at
+ * the given header block.  The rows changed since the table was last
+ * measured are replaced, as long as the table is the same one and its row
+ * count adds up.  Otherwise, the whole table is measured again and true is
+ * returned.  The range of changed rows is returned in the output
+ * parameters, and is empty if no row changed.
+ */
+bool PipeTableFormatter::measureTable
+(
+    const QTextBlock& header,
+    int rowCount,
+    int& firstChangedRow,
+    int& lastChangedRow
+)
+{
+    QTextDocument* document = editor->document();
+    int tableFirst = header.blockNumber();
+    int blockDelta = document->blockCount() - measuredBlockCount;
+    int oldRowCount = rowWidths.size();
+    bool remeasure = (tableFirst != tableFirstBlock) || (0 == oldRowCount);
+
+    firstChangedRow = 0;
+    lastChangedRow = -1;
+
+    if (!remeasure && (firstDirtyBlock >= 0))
+    {
+        // The changed rows, as numbered before and after the change.
+        int first = qMax(0, firstDirtyBlock - tableFirst);
+        int oldLast = qMin(oldRowCount - 1, lastDirtyBlock - blockDelta - tableFirst);
+        int newLast = qMin(rowCount - 1, lastDirtyBlock - tableFirst);
+        int oldCount = qMax(0, oldLast - first + 1);
+        int newCount = qMax(0, newLast - first + 1);
+
+        if ((oldRowCount - oldCount + newCount) != rowCount)
+        {
+            remeasure = true;
+        }
+        else
+        {
+            for (int i = first; i < (first + oldCount); i++)
+            {
+                removeRowWidths(rowWidths[i]);
+            }
+
+            rowWidths.remove(first, oldCount);
+            rowWidths.insert(first, newCount, QVector<int>());
+
+            QTextBlock block = document->findBlockByNumber(tableFirst + first);
+
+            for (int i = first; (i < (first + newCount)) && block.isValid(); i++)
+            {
+                rowWidths[i] = measureRow(block);
+                addRowWidths(rowWidths[i]);
+                block = block.next();
+            }
+
+            firstChangedRow = first;
+            lastChangedRow = first + newCount - 1;
+        }
+    }
+    else if (!remeasure && (oldRowCount != rowCount))
+    {
+        remeasure = true;
+    }
+
+    if (remeasure)
+    {
+        QTextBlock block = header;
+
+        rowWidths.resize(rowCount);
+        columnWidths.clear();
+
+        for (int i = 0; (i < rowCount) && block.isValid(); i++)
+        {
+            rowWidths[i] = measureRow(block);
+            addRowWidths(rowWidths[i]);
+            block = block.next();
+        }
+
+        firstChangedRow = 0;
+        lastChangedRow = rowCount - 1;
+    }
+
+    tableFirstBlock = tableFirst;
+    measuredBlockCount = document->blockCount();
+    firstDirtyBlock = -1;
+    lastDirtyBlock = -1;
+
+    return remeasure;
+}
+
+QVector<int> PipeTableFormatter::measureRow(const QTextBlock& block) const
+{
+    QVector<int> widths;
+
+    // The divider row is rewritten to fit the other rows.
+    if (MarkdownStatePipeTableDivider != block.userState())
+    {
+        foreach (const Cell& cell, splitRow(block.text(), formattedLeadingPipe))
+        {
+            widths.append(displayWidth(cell.text));
+        }
+    }
+
+    return widths;
+}
+
+void PipeTableFormatter::addRowWidths(const QVector<int>& widths)
+{
+    if (columnWidths.size() < widths.size())
+    {
+        columnWidths.resize(widths.size());
+    }
+
+    for (int i = 0; i < widths.size(); i++)
+    {
+        columnWidths[i][widths[i]]++;
+    }
+}
+
+void PipeTableFormatter::removeRowWidths(const QVector<int>& widths)
+{
+    for (int i = 0; (i < widths.size()) && (i < columnWidths.size()); i++)
+    {
+        QMap<int, int>::iterator width = columnWidths[i].find(widths[i]);
+
+        if (width != columnWidths[i].end())
+        {
+            if (--width.value() <= 0)
+            {
+                columnWidths[i].erase(width);
+            }
+        }
+    }
+
+    // Drop columns that no longer have any cells.
+    while (!columnWidths.isEmpty() && columnWidths.last().isEmpty())
+    {
+        columnWidths.remove(columnWidths.size() - 1);
+    }
+}
+
+int PipeTableFormatter::columnWidth(int column) const
+{
+    if ((column >= columnWidths.size()) || columnWidths[column].isEmpty())
+    {
+        return GW_TABLE_MIN_COLUMN_WIDTH;
+    }
+
+    return qMax(GW_TABLE_MIN_COLUMN_WIDTH, columnWidths[column].lastKey());
+}
+
+/*
+ * Each cell is written as a space, the padded cell text and another space,
+ * with pipes between the cells.  Cells of the divider row are written as
+ * dashes, with the alignment colons in place of the spaces, which keeps the
+ * divider in a form that the tokenizer recognizes.  The space before the
+ * first cell and after the last one are left out if the row has no leading
+ * or trailing pipe, respectively, as is the padding of the last cell.
+ */
+QString PipeTableFormatter::formatRow
+(
+    const QList<Cell>& cells,
+    bool divider,
+    const QVector<int>& widths,
+    const QVector<int>& alignments,
+    bool leadingPipe,
+    bool trailingPipe,
+    QVector<int>& contentStarts
+) const
+{
+    QString row;
+
+    contentStarts.clear();
+
+    if (leadingPipe)
+    {
+        row += '|';
+    }
+
+    for (int i = 0; i < cells.size(); i++)
+    {
+        bool firstCell = (0 == i);
+        bool lastCell = (i == (cells.size() - 1));
+        int width = (i < widths.size()) ? widths[i] : displayWidth(cells[i].text);
+        int alignment = (i < alignments.size()) ? alignments[i] : AlignNone;
+
+        if (!firstCell)
+        {
+            row += '|';
+        }
+
+        if (divider)
+        {
+            bool leftColon = (AlignLeft == alignment) || (AlignCenter == alignment);
+            bool rightColon = (AlignRight == alignment) || (AlignCenter == alignment);
+
+            if (!firstCell || leadingPipe)
+            {
+                row += leftColon ? ':' : ' ';
+            }
+
+            contentStarts.append(row.length());
+            row += QString(qMax(GW_TABLE_MIN_COLUMN_WIDTH, width), '-');
+
+            if (!lastCell || trailingPipe)
+            {
+                row += rightColon ? ':' : ' ';
+            }
+        }
+        else
+        {
+            const QString& text = cells[i].text;
+            int padding = qMax(0, width - displayWidth(text));
+            int paddingBefore = 0;
+
+            if (AlignRight == alignment)
+            {
+                paddingBefore = padding;
+            }
+            else if (AlignCenter == alignment)
+            {
+                paddingBefore = padding / 2;
+            }
+
+            if (!firstCell || leadingPipe)
+            {
+                row += ' ';
+            }
+
+            row += QString(paddingBefore, ' ');
+            contentStarts.append(row.length());
+            row += text;
+
+            if (!lastCell || trailingPipe)
+            {
+                row += QString(padding - paddingBefore + 1, ' ');
+            }
+        }
+    }
+
+    if (trailingPipe)
+    {
+        row += '|';
+    }
+
+    return row;
+}
+
+/*
+ * Splits a table row into cells at its unescaped pipes.  A pipe before the
+ * first cell or after the last one does not start a cell of its own.
+ *
+ * A row has a trailing pipe if its last non-space character is an
+ * unescaped pipe.  Likewise for a leading pipe and the first non-space
+ * character, except that in a table without leading pipes, a pipe indented
+ * from the start of the row follows an empty first cell, since that is how
+ * the formatter writes such a cell.
+ */
+QList<PipeTableFormatter::Cell> PipeTableFormatter::splitRow
+(
+    const QString& text,
+    bool tableLeadingPipe,
+    bool* leadingPipe,
+    bool* trailingPipe
+)
+{
+    QList<int> bounds;
+
+    bounds.append(-1);
+
+    for (int i = 0; i < text.length(); i++)
+    {
+        if ('\\' == text[i])
+        {
+            i++;
+        }
+        else if ('|' == text[i])
+        {
+            bounds.append(i);
+        }
+    }
+
+    bounds.append(text.length());
+
+    QList<Cell> cells;
+
+    for (int i = 0; i < (bounds.size() - 1); i++)
+    {
+        Cell cell;
+        cell.rawStart = bounds[i] + 1;
+        cell.rawEnd = bounds[i + 1];
+
+        int start = cell.rawStart;
+        int end = cell.rawEnd;
+
+        while ((start < end) && text[start].isSpace())
+        {
+            start++;
+        }
+
+        while ((end > start) && text[end - 1].isSpace())
+        {
+            end--;
+        }
+
+        cell.start = start;
+        cell.text = text.mid(start, end - start);
+        cells.append(cell);
+    }
+
+    int firstCharacter = 0;
+    int lastCharacter = text.length() - 1;
+
+    while ((firstCharacter < text.length()) && text[firstCharacter].isSpace())
+    {
+        firstCharacter++;
+    }
+
+    while ((lastCharacter >= 0) && text[lastCharacter].isSpace())
+    {
+        lastCharacter--;
+    }
+
+    bool leading =
+        (cells.size() > 1) &&
+        (bounds[1] == firstCharacter) &&
+        (tableLeadingPipe || (0 == firstCharacter));
+
+    if (leading)
+    {
+        cells.removeFirst();
+    }
+
+    bool trailing =
+        (cells.size() > 1) && (bounds[bounds.size() - 2] == lastCharacter);
+
+    if (trailing)
+    {
+        cells.removeLast();
+    }
+
+    if (NULL != leadingPipe)
+    {
+        *leadingPipe = leading;
+    }
+
+    if (NULL != trailingPipe)
+    {
+        *trailingPipe = trailing;
+    }
+
+    return cells;
+}
+
+/*
+ * Columns are padded for a monospaced font, in which East Asian wide and
+ * fullwidth characters take up two columns, and combining marks and other
+ * zero-width characters take up none.
+ */
+int PipeTableFormatter::displayWidth(const QString& text)
+{
+    int width = 0;
+
+    for (int i = 0; i < text.length(); i++)
+    {
+        uint c = text[i].unicode();
+
+        if
+        (
+            text[i].isHighSurrogate() &&
+            ((i + 1) < text.length()) &&
+            text[i + 1].isLowSurrogate()
+        )
+        {
+            c = QChar::surrogateToUcs4(text[i], text[i + 1]);
+            i++;
+        }
+
+        switch (QChar::category(c))
+        {
+            case QChar::Mark_NonSpacing:
+            case QChar::Mark_Enclosing:
+            case QChar::Other_Format:
+                break;
+            default:
+                width += isWideCharacter(c) ? 2 : 1;
+                break;
+        }
+    }
+
+    return width;
+}
+
+/*
+ * Returns true if the given code point is in one of the blocks of East
+ * Asian wide or fullwidth characters, or of emoji, which are displayed
+ * twice as wide as other characters.
+ */
+bool PipeTableFormatter::isWideCharacter(uint c)
+{
+    return
+        ((c >= 0x1100) && (c <= 0x115F)) ||     // Hangul Jamo
+        ((c >= 0x2E80) && (c <= 0x303E)) ||     // CJK radicals and punctuation
+        ((c >= 0x3041) && (c <= 0x33FF)) ||     // Kana, Bopomofo, CJK compatibility
+        ((c >= 0x3400) && (c <= 0x4DBF)) ||     // CJK extension A
+        ((c >= 0x4E00) && (c <= 0x9FFF)) ||     // CJK unified ideographs
+        ((c >= 0xA000) && (c <= 0xA4CF)) ||     // Yi
+        ((c >= 0xAC00) && (c <= 0xD7A3)) ||     // Hangul syllables
+        ((c >= 0xF900) && (c <= 0xFAFF)) ||     // CJK compatibility ideographs
+        ((c >= 0xFE30) && (c <= 0xFE4F)) ||     // CJK compatibility forms
+        ((c >= 0xFF00) && (c <= 0xFF60)) ||     // Fullwidth forms
+        ((c >= 0xFFE0) && (c <= 0xFFE6)) ||
+        ((c >= 0x1F300) && (c <= 0x1F64F)) ||   // Emoji
+        ((c >= 0x1F900) && (c <= 0x1F9FF)) ||
+        ((c >= 0x20000) && (c <= 0x3FFFD));     // CJK extensions B and on
+}
+
+int PipeTableFormatter::alignmentForDivider(const QString& cellText)
+{
+    bool left = cellText.startsWith(':');
+    bool right = cellText.endsWith(':');
+
+    if (left && right)
+    {
+        return AlignCenter;
+    }
+    else if (left)
+    {
+        return AlignLeft;
+    }
+    else if (right)
+    {
+        return AlignRight;
+    }
+
+    return AlignNone;
+}
+
+bool PipeTableFormatter::isTableState(int state)
+{
+    switch (state)
+    {
+        case MarkdownStatePipeTableHeader:
+        case MarkdownStatePipeTableDivider:
+        case MarkdownStatePipeTableRow:
+            return true;
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,191 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef PIPETABLEFORMATTER_H
+#define PIPETABLEFORMATTER_H
+
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+class QPlainTextEdit;
+class QTextBlock;
+
+/**
+ * Realigns the columns of the pipe table under the editor's cursor,
+ * padding every cell to the width of the widest cell in its column.  Widths
+ * are counted in the columns of a monospaced font, so that tables with
+ * East Asian text or combining marks line up.
+ *
+ * To keep tables with thousands of rows responsive, the formatter caches
+ * the extent of the table it last formatted and the width of each of its
+ * cells, along with a multiset of the cell widths of each column, from
+ * which the column widths are read in logarithmic time.  As the table is edited, only the
+ * changed rows are measured again.  If no column width changes, only the
+ * changed rows are rewritten; otherwise, only rows whose padding actually
+ * differs are.  The rewrite is a single undoable edit.
+ */
+class PipeTableFormatter : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Takes the editor whose tables are to be formatted
+         * as a parameter.
+         */
+        PipeTableFormatter(QPlainTextEdit* editor, QObject* parent = 0);
+
+        /**
+         * Destructor.
+         */
+        ~PipeTableFormatter();
+
+        /**
+         * Returns true if tables are formatted as the user types.
+         */
+        bool isEnabled() const;
+
+        /**
+         * Sets whether tables are formatted as the user types.
+         */
+        void setEnabled(bool enabled);
+
+        /**
+         * Returns the number of columns that the given text takes up in a
+         * monospaced font, which is the width its table cells are padded
+         * to.
+         */
+        static int displayWidth(const QString& text);
+
+    public slots:
+        /**
+         * Realigns the columns of the table at the cursor, if the table was
+         * edited by the user since it was last formatted.  Connect this
+         * slot to a signal that is sent when the user pauses typing.
+         */
+        void formatTableAtCursor();
+
+    private slots:
+        void onContentsChange(int position, int charsRemoved, int charsAdded);
+        void onUndoCommandAdded();
+
+    private:
+        enum ColumnAlignment
+        {
+            AlignNone,
+            AlignLeft,
+            AlignRight,
+            AlignCenter
+        };
+
+        // A cell of a table row, with its text trimmed of whitespace.  The
+        // raw cell spans from rawStart up to rawEnd in the row's text, with
+        // the trimmed text starting at start.
+        //
+        struct Cell
+        {
+            QString text;
+            int start;
+            int rawStart;
+            int rawEnd;
+        };
+
+        QPlainTextEdit* editor;
+        bool enabled;
+
+        // Set while the formatter edits the document, so that its own
+        // edits are neither tracked nor counted as the user's.
+        //
+        bool formatting;
+        bool userEditPending;
+
+        // Range of blocks changed since the table was last measured, or -1
+        // if none, and the block count after the latest change.
+        //
+        int firstDirtyBlock;
+        int lastDirtyBlock;
+        int lastBlockCount;
+
+        // Cached measurements of the table last formatted: the number of
+        // its first block and the document's block count at the time, the
+        // cell widths of each row, and a multiset of the cell widths of
+        // each column, mapping each width to the number of cells with it.
+        //
+        int tableFirstBlock;
+        int measuredBlockCount;
+        QVector<QVector<int> > rowWidths;
+        QVector<QMap<int, int> > columnWidths;
+
+        // Layout the table was last formatted with.
+        QVector<int> formattedWidths;
+        QVector<int> formattedAlignments;
+        bool formattedLeadingPipe;
+        bool formattedTrailingPipe;
+
+        bool findTable
+        (
+            const QTextBlock& block,
+            QTextBlock& header,
+            int& rowCount
+        ) const;
+        bool findMeasuredTable
+        (
+            const QTextBlock& block,
+            QTextBlock& header,
+            int& rowCount
+        ) const;
+        bool measureTable
+        (
+            const QTextBlock& header,
+            int rowCount,
+            int& firstChangedRow,
+            int& lastChangedRow
+        );
+        QVector<int> measureRow(const QTextBlock& block) const;
+        void addRowWidths(const QVector<int>& widths);
+        void removeRowWidths(const QVector<int>& widths);
+        int columnWidth(int column) const;
+
+        QString formatRow
+        (
+            const QList<Cell>& cells,
+            bool divider,
+            const QVector<int>& widths,
+            const QVector<int>& alignments,
+            bool leadingPipe,
+            bool trailingPipe,
+            QVector<int>& contentStarts
+        ) const;
+
+        static QList<Cell> splitRow
+        (
+            const QString& text,
+            bool tableLeadingPipe,
+            bool* leadingPipe = NULL,
+            bool* trailingPipe = NULL
+        );
+        static bool isWideCharacter(uint c);
+        static int alignmentForDivider(const QString& cellText);
+        static bool isTableState(int state);
+};
+
+#endif // PIPETABLEFORMATTER_H
@@ -0,0 +1,261 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <stdio.h>
+
+#include <QPlainTextEdit>
+#include <QStringList>
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QTextStream>
+
+#include "PipeTableHarness.h"
+#include "PipeTableFormatter.h"
+#include "MarkdownHighlighter.h"
+#include "TextDocument.h"
+
+PipeTableHarness::PipeTableHarness()
+{
+    ;
+}
+
+PipeTableHarness::~PipeTableHarness()
+{
+    ;
+}
+
+int PipeTableHarness::run()
+{
+    QTextStream out(stdout);
+    int passed = 0;
+    int failed = 0;
+
+    // A row whose first cell is empty must keep its text in the second
+    // column, whether or not the table has leading pipes.
+    //
+    checkColumn
+    (
+        out,
+        "Empty first cell without leading pipes",
+        "a | b\n--|--\n  | ",
+        "x",
+        'x',
+        1
+    ) ? passed++ : failed++;
+
+    checkColumn
+    (
+        out,
+        "Empty first cell with leading pipes",
+        "| a | b |\n|--|--|\n|  | ",
+        "x |",
+        'x',
+        1
+    ) ? passed++ : failed++;
+
+    checkColumn
+    (
+        out,
+        "Empty middle cell",
+        "a | b | c\n--|--|--\n",
+        "x |  | y",
+        'y',
+        2
+    ) ? passed++ : failed++;
+
+    checkColumn
+    (
+        out,
+        "Escaped pipe",
+        "a | b\n--|--\nc \\| d | ",
+        "x",
+        'x',
+        1
+    ) ? passed++ : failed++;
+
+    checkAligned
+    (
+        out,
+        "Plain text",
+        "a | bb\n--|--\nccccc | ",
+        "d"
+    ) ? passed++ : failed++;
+
+    checkAligned
+    (
+        out,
+        "East Asian wide characters",
+        QString::fromUtf8("\xE5\x90\x8D\xE5\x89\x8D | b\n--|--\nabcde | "),
+        "x"
+    ) ? passed++ : failed++;
+
+    checkAligned
+    (
+        out,
+        "Combining marks",
+        QString::fromUtf8("e\xCC\x81te\xCC\x81 | b\n--|--\nab | "),
+        "x"
+    ) ? passed++ : failed++;
+
+    out << "\n" << passed << " passed, " << failed << " failed\n";
+    out.flush();
+
+    return (0 == failed) ? 0 : 1;
+}
+
+/*
+ * Sets the editor's text to the given table, types the given text at the
+ * end of it as the user would, and returns the text of the document after
+ * the formatter has formatted the table.
+ */
+QString PipeTableHarness::formatAfterTyping
+(
+    const QString& table,
+    const QString& typed
+) const
+{
+    TextDocument document;
+    MarkdownHighlighter highlighter(&document);
+    QPlainTextEdit editor;
+
+    editor.setDocument(&document);
+
+    // The formatter tracks the document it was given at construction, so
+    // the document has to be set before it starts listening.
+    //
+    PipeTableFormatter tableFormatter(&editor);
+
+    document.setPlainText(table);
+
+    QTextCursor cursor(&document);
+    cursor.movePosition(QTextCursor::End);
+    editor.setTextCursor(cursor);
+
+    for (int i = 0; i < typed.length(); i++)
+    {
+        cursor = editor.textCursor();
+        cursor.insertText(typed.mid(i, 1));
+        editor.setTextCursor(cursor);
+    }
+
+    tableFormatter.formatTableAtCursor();
+
+    return document.toPlainText();
+}
+
+/*
+ * Checks that the given marker character of the typed text ends up in the
+ * cell with the given column index after formatting, that is, behind that
+ * many of the last row's unescaped pipes, not counting a leading pipe.
+ */
+bool PipeTableHarness::checkColumn
+(
+    QTextStream& out,
+    const QString& name,
+    const QString& table,
+    const QString& typed,
+    QChar marker,
+    int expectedColumn
+) const
+{
+    QString formatted = formatAfterTyping(table, typed);
+    QString row = formatted.section('\n', -1);
+    int position = row.indexOf(marker);
+    int column = 0;
+
+    for (int i = 0; i < position; i++)
+    {
+        if ('\\' == row[i])
+        {
+            i++;
+        }
+        else if ('|' == row[i])
+        {
+            column++;
+        }
+    }
+
+    if (formatted.section('\n', 0, 0).trimmed().startsWith('|'))
+    {
+        column--;
+    }
+
+    if ((position < 0) || (column != expectedColumn))
+    {
+        out << "FAIL " << name << ": expected column " << expectedColumn
+            << ", got " << column << "\n" << formatted << "\n\n";
+        return false;
+    }
+
+    out << "PASS " << name << "\n";
+    return true;
+}
+
+/*
+ * Checks that the pipes of every row of the formatted table line up when
+ * shown in a monospaced font.
+ */
+bool PipeTableHarness::checkAligned
+(
+    QTextStream& out,
+    const QString& name,
+    const QString& table,
+    const QString& typed
+) const
+{
+    QString formatted = formatAfterTyping(table, typed);
+    QStringList rows = formatted.split('\n');
+    QList<int> expected = pipeColumns(rows.first());
+
+    foreach (const QString& row, rows)
+    {
+        if (pipeColumns(row) != expected)
+        {
+            out << "FAIL " << name << ": columns do not line up\n"
+                << formatted << "\n\n";
+            return false;
+        }
+    }
+
+    out << "PASS " << name << "\n";
+    return true;
+}
+
+/*
+ * Returns the display columns at which the unescaped pipes of the given
+ * row appear.
+ */
+QList<int> PipeTableHarness::pipeColumns(const QString& row)
+{
+    QList<int> columns;
+
+    for (int i = 0; i < row.length(); i++)
+    {
+        if ('\\' == row[i])
+        {
+            i++;
+        }
+        else if ('|' == row[i])
+        {
+            columns.append(PipeTableFormatter::displayWidth(row.left(i)));
+        }
+    }
+
+    return columns;
+}
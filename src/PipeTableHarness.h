@@ -0,0 +1,84 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef PIPETABLEHARNESS_H
+#define PIPETABLEHARNESS_H
+
+#include <QChar>
+#include <QList>
+#include <QString>
+
+class QTextStream;
+
+/*
+ * Command line argument that launches ghostwriter as the pipe table
+ * formatter tests rather than as an editor.
+ */
+#define GW_PIPE_TABLE_TESTS_ARG "--pipe-table-tests"
+
+/**
+ * Checks the PipeTableFormatter against tables whose layout is easy to get
+ * wrong, such as rows with empty first or last cells, escaped pipes, and
+ * cells of East Asian text or combining marks.  Each table is typed into an
+ * editor with the Markdown highlighter attached, as in the application, and
+ * formatted once the typing pauses.
+ */
+class PipeTableHarness
+{
+    public:
+        /**
+         * Constructor.
+         */
+        PipeTableHarness();
+
+        /**
+         * Destructor.
+         */
+        ~PipeTableHarness();
+
+        /**
+         * Runs every test, and writes the failed tests and the number of
+         * passing tests to standard output.  Returns the process exit code,
+         * which is non-zero if any test failed.
+         */
+        int run();
+
+    private:
+        QString formatAfterTyping(const QString& table, const QString& typed) const;
+        bool checkColumn
+        (
+            QTextStream& out,
+            const QString& name,
+            const QString& table,
+            const QString& typed,
+            QChar marker,
+            int expectedColumn
+        ) const;
+        bool checkAligned
+        (
+            QTextStream& out,
+            const QString& name,
+            const QString& table,
+            const QString& typed
+        ) const;
+
+        static QList<int> pipeColumns(const QString& row);
+};
+
+#endif // PIPETABLEHARNESS_H
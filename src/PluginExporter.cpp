@@ -0,0 +1,120 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QObject>
+#include <QMutexLocker>
+
+#if QT_VERSION < 0x050000
+#include <QTextDocument>
+#endif
+
+#include "PluginExporter.h"
+
+PluginExporter::PluginExporter(ExporterPlugin* plugin)
+    : Exporter(plugin->name()), plugin(plugin)
+{
+    setMarkdownFlavor(plugin->markdownFlavor());
+    supportedFormats.append(ExportFormat::HTML);
+    selfContainedHtmlSupported = true;
+}
+
+PluginExporter::~PluginExporter()
+{
+
+}
+
+void PluginExporter::exportToHtml(const QString& text, QString& html)
+{
+    QString err;
+
+    if (!render(text, html, err))
+    {
+#if QT_VERSION >= 0x050000
+        err = err.toHtmlEscaped();
+#else
+        err = Qt::escape(err);
+#endif
+
+        html = QString("<center><b style='color: red'>") + err +
+            QString("</b></center>");
+    }
+}
+
+void PluginExporter::exportToFile
+(
+    const ExportFormat* format,
+    const QString& inputFilePath,
+    const QString& text,
+    const QString& outputFilePath,
+    QString& err
+)
+{
+    QString html;
+
+    if (ExportFormat::HTML != format)
+    {
+        err = QObject::tr("%1 format is unsupported by the %2 processor.")
+            .arg(format->getName())
+            .arg(getName());
+        return;
+    }
+
+    if (!render(text, html, err))
+    {
+        return;
+    }
+
+    writeHtmlFile(html, inputFilePath, outputFilePath, err);
+}
+
+bool PluginExporter::render(const QString& text, QString& html, QString& err)
+{
+    QByteArray markdown = text.toUtf8();
+    QByteArray output;
+    bool success;
+
+    {
+        // Hand the UTF-8 buffers directly to the plugin.  Only plugins that
+        // are not thread-safe need to wait for other exports to finish.
+        //
+        QMutexLocker locker(plugin->isThreadSafe() ? NULL : &renderMutex);
+
+        success = plugin->renderHtml
+            (
+                markdown,
+                this->getSmartTypographyEnabled(),
+                output,
+                err
+            );
+    }
+
+    if (!success)
+    {
+        if (err.isEmpty())
+        {
+            err = QObject::tr("Export failed");
+        }
+
+        return false;
+    }
+
+    html = QString::fromUtf8(output.data(), output.size());
+    err = QString();
+    return true;
+}
@@ -0,0 +1,86 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef PLUGINEXPORTER_H
+#define PLUGINEXPORTER_H
+
+#include <QMutex>
+
+#include "Exporter.h"
+#include "ExporterPlugin.h"
+
+/**
+ * Exports Markdown text to HTML via a Markdown processor that is loaded as
+ * an ExporterPlugin, so that the processor renders within the application's
+ * process rather than being run as a separate program for every export.
+ */
+class PluginExporter : public Exporter
+{
+    public:
+        /**
+         * Constructor.  Takes the plugin that renders the HTML as parameter.
+         * The plugin remains owned by its plugin loader.
+         */
+        PluginExporter(ExporterPlugin* plugin);
+
+        /**
+         * Destructor.
+         */
+        ~PluginExporter();
+
+        /**
+         * Exports the given Markdown text to HTML, setting the html parameter
+         * to have the HTML output.  This method is safe to call from
+         * multiple threads, even if the plugin itself is not.
+         */
+        void exportToHtml(const QString& text, QString& html);
+
+        /**
+         * Exports the given Markdown text to the given export format and
+         * output file path.  Sets err to a non-null string error message
+         * if the export fails.  Note that the only supported format for
+         * this exporter is HTML.
+         */
+        void exportToFile
+        (
+            const ExportFormat* format,
+            const QString& inputFilePath,
+            const QString& text,
+            const QString& outputFilePath,
+            QString& err
+        );
+
+    private:
+        ExporterPlugin* plugin;
+
+        // Serializes calls to plugins that are not thread-safe, since the
+        // live preview renders on a worker thread while file exports run
+        // on the GUI thread.
+        //
+        QMutex renderMutex;
+
+        /*
+         * Renders the given text with the plugin, setting html to the HTML
+         * output.  Returns false and sets err to an error message if the
+         * plugin fails.
+         */
+        bool render(const QString& text, QString& html, QString& err);
+};
+
+#endif // PLUGINEXPORTER_H
@@ -0,0 +1,98 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QLocalSocket>
+#include <QDataStream>
+#include <QByteArray>
+
+#include "PreviewChannel.h"
+
+PreviewChannel::PreviewChannel(QLocalSocket* socket, QObject* parent)
+    : QObject(parent), socket(socket), pendingMessageSize(0)
+{
+    socket->setParent(this);
+    connect(socket, SIGNAL(readyRead()), this, SLOT(readMessages()));
+    connect(socket, SIGNAL(disconnected()), this, SIGNAL(disconnected()));
+}
+
+PreviewChannel::~PreviewChannel()
+{
+    ;
+}
+
+bool PreviewChannel::isConnected() const
+{
+    return QLocalSocket::ConnectedState == socket->state();
+}
+
+void PreviewChannel::send(PreviewMessageType type, const QList<QVariant>& args)
+{
+    if (!isConnected())
+    {
+        return;
+    }
+
+    QByteArray payload;
+    QDataStream payloadStream(&payload, QIODevice::WriteOnly);
+    payloadStream.setVersion(QDataStream::Qt_4_8);
+    payloadStream << (qint32) type << args;
+
+    QByteArray frame;
+    QDataStream frameStream(&frame, QIODevice::WriteOnly);
+    frameStream.setVersion(QDataStream::Qt_4_8);
+    frameStream << (quint32) payload.size();
+    frame.append(payload);
+
+    socket->write(frame);
+}
+
+void PreviewChannel::readMessages()
+{
+    forever
+    {
+        if (0 == pendingMessageSize)
+        {
+            if (socket->bytesAvailable() < (qint64) sizeof(quint32))
+            {
+                return;
+            }
+
+            QDataStream sizeStream(socket);
+            sizeStream.setVersion(QDataStream::Qt_4_8);
+            sizeStream >> pendingMessageSize;
+        }
+
+        if (socket->bytesAvailable() < pendingMessageSize)
+        {
+            return;
+        }
+
+        QByteArray payload = socket->read(pendingMessageSize);
+        pendingMessageSize = 0;
+
+        QDataStream payloadStream(payload);
+        payloadStream.setVersion(QDataStream::Qt_4_8);
+
+        qint32 type;
+        QList<QVariant> args;
+        payloadStream >> type >> args;
+
+        emit messageReceived(type, args);
+    }
+}
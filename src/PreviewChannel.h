@@ -0,0 +1,91 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef PREVIEWCHANNEL_H
+#define PREVIEWCHANNEL_H
+
+#include <QObject>
+#include <QVariant>
+#include <QList>
+
+#include "PreviewRendererTypes.h"
+
+class QLocalSocket;
+
+/**
+ * Sends and receives length-prefixed messages over a local socket connecting
+ * the editor to the preview renderer helper process.  Each message consists
+ * of a PreviewMessageType and a list of arguments.
+ */
+class PreviewChannel : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Takes the (possibly not yet connected) socket over
+         * which to communicate as a parameter.  The channel takes ownership
+         * of the socket.
+         */
+        PreviewChannel(QLocalSocket* socket, QObject* parent = 0);
+
+        /**
+         * Destructor.
+         */
+        virtual ~PreviewChannel();
+
+        /**
+         * Returns true if the underlying socket is connected.
+         */
+        bool isConnected() const;
+
+        /**
+         * Sends a message with the given arguments.  The message is queued
+         * for sending if the socket is busy.
+         */
+        void send
+        (
+            PreviewMessageType type,
+            const QList<QVariant>& args = QList<QVariant>()
+        );
+
+    signals:
+        /**
+         * Emitted when a complete message has been received.
+         */
+        void messageReceived(int type, const QList<QVariant>& args);
+
+        /**
+         * Emitted when the other end of the channel disconnects.
+         */
+        void disconnected();
+
+    private slots:
+        void readMessages();
+
+    private:
+        QLocalSocket* socket;
+
+        // Size of the message currently being received, or zero if the
+        // size prefix of the next message has yet to be read.
+        //
+        quint32 pendingMessageSize;
+};
+
+#endif // PREVIEWCHANNEL_H
@@ -0,0 +1,357 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <math.h>
+#include <stdio.h>
+
+#include <QApplication>
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QKeyEvent>
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QTextStream>
+#include <QTimer>
+#include <QtAlgorithms>
+
+#include "PreviewLatencyHarness.h"
+#include "Exporter.h"
+#include "ExporterFactory.h"
+#include "HtmlPreview.h"
+#include "MarkdownEditor.h"
+#include "MarkdownHighlighter.h"
+#include "TextDocument.h"
+
+// Number of scripted edits applied to each corpus document per exporter.
+#define GW_HARNESS_EDITS_PER_DOCUMENT 10
+
+// Text typed for each scripted edit.
+#define GW_HARNESS_EDIT_TEXT "latency "
+
+// Seed for choosing edit positions, so that every exporter is measured
+// with the same edits.
+//
+#define GW_HARNESS_RANDOM_SEED 1117
+
+// Time in milliseconds to wait for the preview to show an edit before
+// giving up on it.
+//
+#define GW_HARNESS_TIMEOUT 30000
+
+PreviewLatencyHarness::PreviewLatencyHarness
+(
+    const QStringList& corpusPaths,
+    QObject* parent
+)
+    : QObject(parent),
+    typingPausedTime(0),
+    previewUpdated(false)
+{
+    findCorpusFiles(corpusPaths);
+
+    document = new TextDocument(this);
+    highlighter = new MarkdownHighlighter(document);
+    editor = new MarkdownEditor(document, highlighter);
+    editor->resize(800, 600);
+    preview = new HtmlPreview(document);
+
+    eventLoop = new QEventLoop(this);
+    timeoutTimer = new QTimer(this);
+    timeoutTimer->setSingleShot(true);
+    timeoutTimer->setInterval(GW_HARNESS_TIMEOUT);
+    connect(timeoutTimer, SIGNAL(timeout()), eventLoop, SLOT(quit()));
+
+    // Timestamp the typing pause before the preview starts updating.
+    connect(editor, SIGNAL(typingPaused()), this, SLOT(onTypingPaused()));
+    connect(editor, SIGNAL(typingPaused()), preview, SLOT(updatePreview()));
+    connect
+    (
+        preview,
+        SIGNAL(previewUpdated(PreviewTimings)),
+        this,
+        SLOT(onPreviewUpdated(PreviewTimings))
+    );
+}
+
+PreviewLatencyHarness::~PreviewLatencyHarness()
+{
+    delete preview;
+    delete editor;
+}
+
+int PreviewLatencyHarness::run()
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    if (corpusFilePaths.isEmpty())
+    {
+        err << "Usage: ghostwriter " << GW_LATENCY_HARNESS_ARG
+            << " <Markdown files or directories> [-platform offscreen]\n";
+        return 1;
+    }
+
+    QList<Exporter*> exporters =
+        ExporterFactory::getInstance()->getHtmlExporters();
+
+    if (exporters.isEmpty())
+    {
+        err << "No HTML exporters are available.\n";
+        return 1;
+    }
+
+    // The preview remembers the last selected exporter in the user's
+    // settings, so put it back once done.
+    //
+    QString originalExporterName = preview->getExporterName();
+
+    editor->show();
+    preview->show();
+
+    out << "Edit-to-preview latency, " << corpusFilePaths.size()
+        << " document(s), " << GW_HARNESS_EDITS_PER_DOCUMENT
+        << " edit(s) per document\n";
+
+    foreach (Exporter* exporter, exporters)
+    {
+        int droppedCount = 0;
+        QList<Sample> samples = measureExporter(exporter->getName(), droppedCount);
+        writeReport(out, exporter->getName(), samples, droppedCount);
+        out.flush();
+    }
+
+    preview->selectExporter(originalExporterName);
+    return 0;
+}
+
+void PreviewLatencyHarness::onTypingPaused()
+{
+    typingPausedTime = PreviewTimings::now();
+}
+
+void PreviewLatencyHarness::onPreviewUpdated(const PreviewTimings& timings)
+{
+    lastTimings = timings;
+    previewUpdated = true;
+    eventLoop->quit();
+}
+
+void PreviewLatencyHarness::findCorpusFiles(const QStringList& corpusPaths)
+{
+    QStringList nameFilters;
+    nameFilters << "*.md" << "*.markdown" << "*.mdown" << "*.mkd" << "*.txt";
+
+    foreach (QString path, corpusPaths)
+    {
+        QFileInfo info(path);
+
+        if (info.isDir())
+        {
+            QDir dir(path);
+
+            foreach (QString fileName, dir.entryList(nameFilters, QDir::Files, QDir::Name))
+            {
+                corpusFilePaths.append(dir.filePath(fileName));
+            }
+        }
+        else if (info.isFile())
+        {
+            corpusFilePaths.append(path);
+        }
+    }
+}
+
+bool PreviewLatencyHarness::waitForPreview()
+{
+    previewUpdated = false;
+    timeoutTimer->start();
+    eventLoop->exec();
+    timeoutTimer->stop();
+
+    return previewUpdated;
+}
+
+void PreviewLatencyHarness::typeText(const QString& text)
+{
+    for (int i = 0; i < text.length(); i++)
+    {
+        int key = text[i].toUpper().unicode();
+
+        if (QChar(' ') == text[i])
+        {
+            key = Qt::Key_Space;
+        }
+
+        QKeyEvent press(QEvent::KeyPress, key, Qt::NoModifier, QString(text[i]));
+        QKeyEvent release(QEvent::KeyRelease, key, Qt::NoModifier, QString(text[i]));
+        QApplication::sendEvent(editor, &press);
+        QApplication::sendEvent(editor, &release);
+    }
+}
+
+QList<PreviewLatencyHarness::Sample> PreviewLatencyHarness::measureExporter
+(
+    const QString& exporterName,
+    int& droppedCount
+)
+{
+    QList<Sample> samples;
+
+    preview->selectExporter(exporterName);
+    qsrand(GW_HARNESS_RANDOM_SEED);
+
+    foreach (QString filePath, corpusFilePaths)
+    {
+        QFile file(filePath);
+
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            continue;
+        }
+
+        QTextStream in(&file);
+        in.setCodec("UTF-8");
+        document->setPlainText(in.readAll());
+        file.close();
+
+        // Let the preview render the unedited document, so that each edit
+        // is measured against a warm preview.
+        //
+        waitForPreview();
+
+        for (int i = 0; i < GW_HARNESS_EDITS_PER_DOCUMENT; i++)
+        {
+            QTextCursor cursor(document);
+            cursor.setPosition(qrand() % document->characterCount());
+            editor->setTextCursor(cursor);
+
+            typingPausedTime = 0;
+            typeText(GW_HARNESS_EDIT_TEXT);
+
+            Sample sample;
+            sample.keystroke = PreviewTimings::now();
+
+            // Edits that never reach the preview, or that are superseded
+            // by an update started before typing paused, are dropped.
+            //
+            if
+            (
+                waitForPreview()
+                && (typingPausedTime > sample.keystroke)
+                && (lastTimings.snapshotTaken >= typingPausedTime)
+            )
+            {
+                sample.typingPaused = typingPausedTime;
+                sample.timings = lastTimings;
+                samples.append(sample);
+            }
+            else
+            {
+                droppedCount++;
+            }
+        }
+    }
+
+    return samples;
+}
+
+void PreviewLatencyHarness::writeReport
+(
+    QTextStream& out,
+    const QString& exporterName,
+    const QList<Sample>& samples,
+    int droppedCount
+) const
+{
+    QVector<qint64> typingPause;
+    QVector<qint64> snapshot;
+    QVector<qint64> queue;
+    QVector<qint64> exportToHtml;
+    QVector<qint64> delivery;
+    QVector<qint64> diff;
+    QVector<qint64> setContent;
+    QVector<qint64> load;
+    QVector<qint64> total;
+
+    foreach (const Sample& sample, samples)
+    {
+        const PreviewTimings& t = sample.timings;
+
+        typingPause.append(sample.typingPaused - sample.keystroke);
+        snapshot.append(t.snapshotTaken - sample.typingPaused);
+        queue.append(t.exportStarted - t.snapshotTaken);
+        exportToHtml.append(t.exportFinished - t.exportStarted);
+        delivery.append(t.htmlReceived - t.exportFinished);
+        diff.append(t.diffFinished - t.htmlReceived);
+        setContent.append(t.contentSet - t.diffFinished);
+        load.append(t.loadFinished - t.contentSet);
+        total.append(t.loadFinished - sample.keystroke);
+    }
+
+    out << "\n" << exporterName << " (" << samples.size() << " edit(s) measured, "
+        << droppedCount << " dropped)\n";
+
+    if (samples.isEmpty())
+    {
+        return;
+    }
+
+    out << QString("Stage").leftJustified(26)
+        << QString("p50 ms").rightJustified(11)
+        << QString("p90 ms").rightJustified(11)
+        << QString("p99 ms").rightJustified(11)
+        << QString("max ms").rightJustified(11) << "\n";
+
+    writeStage(out, "Typing pause detection", typingPause);
+    writeStage(out, "Text snapshot", snapshot);
+    writeStage(out, "Task queue", queue);
+    writeStage(out, "exportToHtml", exportToHtml);
+    writeStage(out, "Result delivery", delivery);
+    writeStage(out, "Diff (onHtmlReady)", diff);
+    writeStage(out, "setContent", setContent);
+    writeStage(out, "Load finished", load);
+    writeStage(out, "Total", total);
+}
+
+void PreviewLatencyHarness::writeStage
+(
+    QTextStream& out,
+    const QString& stageName,
+    QVector<qint64> durations
+) const
+{
+    qSort(durations);
+    out << stageName.leftJustified(26);
+
+    const double percentiles[] = { 50.0, 90.0, 99.0, 100.0 };
+
+    for (int i = 0; i < 4; i++)
+    {
+        // Nearest-rank percentile.
+        int rank = (int) ceil((percentiles[i] / 100.0) * durations.size());
+        qint64 nanoseconds = durations[qMax(0, rank - 1)];
+
+        out << QString::number(nanoseconds / 1000000.0, 'f', 2).rightJustified(11);
+    }
+
+    out << "\n";
+}
@@ -0,0 +1,128 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef PREVIEWLATENCYHARNESS_H
+#define PREVIEWLATENCYHARNESS_H
+
+#include <QObject>
+#include <QList>
+#include <QStringList>
+#include <QVector>
+
+#include "PreviewTimings.h"
+
+class QEventLoop;
+class QTextStream;
+class QTimer;
+class HtmlPreview;
+class MarkdownEditor;
+class MarkdownHighlighter;
+class TextDocument;
+
+/*
+ * Command line argument that launches ghostwriter as the edit-to-preview
+ * latency harness rather than as an editor.  The arguments that follow it
+ * are the Markdown files, or directories of Markdown files, to edit.  Run
+ * with "-platform offscreen" to run without a display.
+ */
+#define GW_LATENCY_HARNESS_ARG "--latency-harness"
+
+/**
+ * Measures how long it takes from a keystroke until the live HTML preview
+ * shows it.  The harness drives a MarkdownEditor and HtmlPreview through
+ * scripted edits of each corpus document, timestamping each stage of the
+ * preview update, and reports the percentiles of each stage for every
+ * available HTML exporter.
+ */
+class PreviewLatencyHarness : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Takes the Markdown files, or directories of
+         * Markdown files, to edit as a parameter.
+         */
+        PreviewLatencyHarness(const QStringList& corpusPaths, QObject* parent = 0);
+
+        /**
+         * Destructor.
+         */
+        ~PreviewLatencyHarness();
+
+        /**
+         * Runs the scripted edits for each exporter and writes the report
+         * to standard output.  Returns the process exit code.
+         */
+        int run();
+
+    private slots:
+        void onTypingPaused();
+        void onPreviewUpdated(const PreviewTimings& timings);
+
+    private:
+        // Timestamps of one scripted edit, from its last keystroke until
+        // the preview showed it.
+        //
+        struct Sample
+        {
+            qint64 keystroke;
+            qint64 typingPaused;
+            PreviewTimings timings;
+        };
+
+        QStringList corpusFilePaths;
+        TextDocument* document;
+        MarkdownHighlighter* highlighter;
+        MarkdownEditor* editor;
+        HtmlPreview* preview;
+
+        QEventLoop* eventLoop;
+        QTimer* timeoutTimer;
+        qint64 typingPausedTime;
+        PreviewTimings lastTimings;
+        bool previewUpdated;
+
+        void findCorpusFiles(const QStringList& corpusPaths);
+        bool waitForPreview();
+        void typeText(const QString& text);
+        QList<Sample> measureExporter
+        (
+            const QString& exporterName,
+            int& droppedCount
+        );
+
+        void writeReport
+        (
+            QTextStream& out,
+            const QString& exporterName,
+            const QList<Sample>& samples,
+            int droppedCount
+        ) const;
+
+        void writeStage
+        (
+            QTextStream& out,
+            const QString& stageName,
+            QVector<qint64> durations
+        ) const;
+};
+
+#endif // PREVIEWLATENCYHARNESS_H
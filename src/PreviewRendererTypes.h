@@ -0,0 +1,63 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef PREVIEWRENDERERTYPES_H
+#define PREVIEWRENDERERTYPES_H
+
+/*
+ * Command line argument that launches ghostwriter as a preview renderer
+ * helper process.  The argument following it is the name of the local
+ * server to which the helper process should connect.
+ */
+#define GW_PREVIEW_RENDERER_ARG "--preview-renderer"
+
+/*
+ * Messages exchanged between the editor and the preview renderer helper
+ * process.  The arguments of each message are listed in its comment.
+ */
+enum PreviewMessageType
+{
+    // Editor to renderer: HTML (QByteArray, UTF-8), base URL (QUrl).
+    PreviewMessageSetContent,
+
+    // Editor to renderer: anchor name (QString).
+    PreviewMessageScrollToAnchor,
+
+    // Editor to renderer: style sheet URL (QUrl).
+    PreviewMessageSetUserStyleSheet,
+
+    // Editor to renderer: zoom factor (qreal).
+    PreviewMessageSetZoomFactor,
+
+    // Editor to renderer: visible (bool).  Only used when the renderer's
+    // window cannot be embedded into the editor's preview window.
+    PreviewMessageSetWindowVisible,
+
+    // Renderer to editor: native window ID (qulonglong).
+    PreviewMessageWindowCreated,
+
+    // Renderer to editor: no arguments.  Sent once the last HTML content
+    // received has been laid out.
+    PreviewMessageContentLoaded,
+
+    // Renderer to editor: URL (QUrl).
+    PreviewMessageLinkClicked
+};
+
+#endif // PREVIEWRENDERERTYPES_H
@@ -0,0 +1,136 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QApplication>
+#include <QLocalSocket>
+#include <QAction>
+
+#include "PreviewRendererWindow.h"
+#include "PreviewChannel.h"
+#include "HtmlPreview.h"
+
+PreviewRendererWindow::PreviewRendererWindow
+(
+    const QString& serverName,
+    QWidget* parent
+)
+    : QWebView(parent)
+{
+    this->setWindowTitle(tr("HTML Preview"));
+    this->settings()->setDefaultTextEncoding("utf-8");
+    this->settings()->setAttribute(QWebSettings::ZoomTextOnly, true);
+    this->setHtml("");
+    this->page()->setContentEditable(false);
+    this->page()->setLinkDelegationPolicy(QWebPage::DelegateExternalLinks);
+    this->page()->action(QWebPage::Reload)->setVisible(false);
+    this->page()->action(QWebPage::OpenLink)->setVisible(false);
+    this->page()->action(QWebPage::OpenLinkInNewWindow)->setVisible(false);
+    connect(this, SIGNAL(linkClicked(QUrl)), this, SLOT(onLinkClicked(QUrl)));
+
+    QLocalSocket* socket = new QLocalSocket();
+    channel = new PreviewChannel(socket, this);
+
+    connect(socket, SIGNAL(connected()), this, SLOT(onConnected()));
+    connect(channel, SIGNAL(messageReceived(int,QList<QVariant>)), this, SLOT(onMessageReceived(int,QList<QVariant>)));
+
+    // If the editor goes away (or was never there), so does this process.
+    connect(channel, SIGNAL(disconnected()), qApp, SLOT(quit()));
+
+    socket->connectToServer(serverName);
+
+    if (!socket->waitForConnected(5000))
+    {
+        qCritical("Preview renderer could not connect to ghostwriter.");
+        QMetaObject::invokeMethod(qApp, "quit", Qt::QueuedConnection);
+    }
+}
+
+PreviewRendererWindow::~PreviewRendererWindow()
+{
+    ;
+}
+
+void PreviewRendererWindow::onConnected()
+{
+    // Create the native window now so that the editor can embed it.
+    QList<QVariant> args;
+    args.append(QVariant((qulonglong) this->winId()));
+    channel->send(PreviewMessageWindowCreated, args);
+}
+
+void PreviewRendererWindow::onMessageReceived
+(
+    int type,
+    const QList<QVariant>& args
+)
+{
+    switch (type)
+    {
+        case PreviewMessageSetContent:
+            if (args.size() >= 2)
+            {
+                this->setContent(args[0].toByteArray(), "text/html", args[1].toUrl());
+                HtmlPreview::anchorHeadings(this->page()->mainFrame());
+                this->page()->mainFrame()->scrollToAnchor("livepreviewmodifypoint");
+            }
+
+            // Let the editor know it can send the next update.
+            channel->send(PreviewMessageContentLoaded);
+            break;
+        case PreviewMessageScrollToAnchor:
+            if (args.size() >= 1)
+            {
+                this->page()->mainFrame()->scrollToAnchor(args[0].toString());
+            }
+            break;
+        case PreviewMessageSetUserStyleSheet:
+            if (args.size() >= 1)
+            {
+                this->settings()->setUserStyleSheetUrl(args[0].toUrl());
+            }
+            break;
+        case PreviewMessageSetZoomFactor:
+            if (args.size() >= 1)
+            {
+                this->setZoomFactor(args[0].toReal());
+            }
+            break;
+        case PreviewMessageSetWindowVisible:
+            if ((args.size() >= 1) && args[0].toBool())
+            {
+                this->show();
+                this->raise();
+            }
+            else
+            {
+                this->hide();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void PreviewRendererWindow::onLinkClicked(const QUrl& url)
+{
+    // Let the editor open links, since it knows the user's preferences.
+    QList<QVariant> args;
+    args.append(QVariant(url));
+    channel->send(PreviewMessageLinkClicked, args);
+}
@@ -0,0 +1,68 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef PREVIEWRENDERERWINDOW_H
+#define PREVIEWRENDERERWINDOW_H
+
+#include <QString>
+#include <QUrl>
+#include <QVariant>
+#include <QList>
+
+#if QT_VERSION >= 0x050000
+#include <QtWebKitWidgets>
+#else
+#include <QtWebKit>
+#endif
+
+class PreviewChannel;
+
+/**
+ * Web view that runs inside the preview renderer helper process.  It
+ * connects to the editor process over a local socket, renders the HTML it
+ * receives, and reports link clicks back to the editor.  Running the web
+ * view in its own process keeps expensive page layout (or a misbehaving
+ * WebKit) from stalling the editor's GUI thread.
+ */
+class PreviewRendererWindow : public QWebView
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Takes the name of the editor's local server as
+         * parameter.
+         */
+        PreviewRendererWindow(const QString& serverName, QWidget* parent = 0);
+
+        /**
+         * Destructor.
+         */
+        virtual ~PreviewRendererWindow();
+
+    private slots:
+        void onConnected();
+        void onMessageReceived(int type, const QList<QVariant>& args);
+        void onLinkClicked(const QUrl& url);
+
+    private:
+        PreviewChannel* channel;
+};
+
+#endif // PREVIEWRENDERERWINDOW_H
@@ -0,0 +1,50 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <QElapsedTimer>
+
+#include "PreviewTimings.h"
+
+static QElapsedTimer startClock()
+{
+    QElapsedTimer clock;
+    clock.start();
+    return clock;
+}
+
+// Started during static initialization, before any thread can read it.
+static const QElapsedTimer processClock = startClock();
+
+PreviewTimings::PreviewTimings()
+    : snapshotTaken(0),
+    exportStarted(0),
+    exportFinished(0),
+    htmlReceived(0),
+    diffFinished(0),
+    contentSet(0),
+    loadFinished(0)
+{
+
+}
+
+qint64 PreviewTimings::now()
+{
+    return processClock.nsecsElapsed();
+}
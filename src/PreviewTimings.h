@@ -0,0 +1,56 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef PREVIEWTIMINGS_H
+#define PREVIEWTIMINGS_H
+
+#include <QtGlobal>
+
+/**
+ * Timestamps of the stages that a live HTML preview update passes through,
+ * from the moment the document text is copied for rendering until the
+ * rendered page has finished loading.  Timestamps are in nanoseconds on the
+ * process-wide monotonic clock returned by now(), so that they can be
+ * compared with timestamps taken elsewhere, such as when a key is pressed.
+ * Stages that have not been reached are zero.
+ */
+struct PreviewTimings
+{
+    /**
+     * Constructor.  Sets all timestamps to zero.
+     */
+    PreviewTimings();
+
+    qint64 snapshotTaken;
+    qint64 exportStarted;
+    qint64 exportFinished;
+    qint64 htmlReceived;
+    qint64 diffFinished;
+    qint64 contentSet;
+    qint64 loadFinished;
+
+    /**
+     * Returns the current time on the process-wide monotonic clock, in
+     * nanoseconds.  This method is thread-safe.
+     */
+    static qint64 now();
+};
+
+#endif // PREVIEWTIMINGS_H
@@ -0,0 +1,204 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <QAbstractListModel>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QTimer>
+#include <QVector>
+
+#include "ProblemsPanel.h"
+#include "MarkdownLinter.h"
+#include "TextBlockData.h"
+
+// Milliseconds to wait after the last change to the diagnostics before
+// rebuilding the list.
+//
+#define GW_PROBLEMS_REFRESH_DELAY 300
+
+/*
+ * Read-only model for the problems list.  Display strings are built only
+ * when requested by the view, which is to say only for the visible rows.
+ */
+class ProblemsModel : public QAbstractListModel
+{
+    public:
+        struct Problem
+        {
+            int blockNumber;
+            int documentPosition;
+            MarkdownLintDiagnostic diagnostic;
+        };
+
+        ProblemsModel(QObject* parent = NULL)
+            : QAbstractListModel(parent)
+        {
+
+        }
+
+        int rowCount(const QModelIndex& parent = QModelIndex()) const
+        {
+            if (parent.isValid())
+            {
+                return 0;
+            }
+
+            return problems.size();
+        }
+
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const
+        {
+            if (!index.isValid() || (index.row() >= problems.size()))
+            {
+                return QVariant();
+            }
+
+            const Problem& problem = problems[index.row()];
+
+            if (Qt::DisplayRole == role)
+            {
+                return QObject::tr("Line %1: %2")
+                    .arg(problem.blockNumber + 1)
+                    .arg(MarkdownLinter::describe(problem.diagnostic));
+            }
+
+            return QVariant();
+        }
+
+        void setProblems(const QVector<Problem>& problems)
+        {
+            beginResetModel();
+            this->problems = problems;
+            endResetModel();
+        }
+
+        int documentPosition(int row) const
+        {
+            if ((row < 0) || (row >= problems.size()))
+            {
+                return -1;
+            }
+
+            return problems[row].documentPosition;
+        }
+
+    private:
+        QVector<Problem> problems;
+};
+
+ProblemsPanel::ProblemsPanel(QTextDocument* document, QWidget* parent)
+    : QListView(parent), document(document), stale(true)
+{
+    problemsModel = new ProblemsModel(this);
+    this->setModel(problemsModel);
+    this->setUniformItemSizes(true);
+    this->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    this->setSelectionMode(QAbstractItemView::SingleSelection);
+
+    refreshTimer = new QTimer(this);
+    refreshTimer->setSingleShot(true);
+    refreshTimer->setInterval(GW_PROBLEMS_REFRESH_DELAY);
+
+    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+    connect(this, SIGNAL(activated(QModelIndex)), this, SLOT(onItemActivated(QModelIndex)));
+    connect(this, SIGNAL(clicked(QModelIndex)), this, SLOT(onItemActivated(QModelIndex)));
+}
+
+ProblemsPanel::~ProblemsPanel()
+{
+
+}
+
+void ProblemsPanel::onDiagnosticsChanged()
+{
+    stale = true;
+    refreshTimer->start();
+}
+
+void ProblemsPanel::showEvent(QShowEvent* event)
+{
+    QListView::showEvent(event);
+
+    if (stale)
+    {
+        refresh();
+    }
+}
+
+void ProblemsPanel::refresh()
+{
+    // Don't bother rebuilding the list while nobody can see it.  It will
+    // be rebuilt the next time the panel is shown.
+    //
+    if (!this->isVisible())
+    {
+        stale = true;
+        return;
+    }
+
+    QVector<ProblemsModel::Problem> problems;
+    QTextBlock block = document->begin();
+
+    while (block.isValid())
+    {
+        TextBlockData* data = (TextBlockData*) block.userData();
+
+        if ((NULL != data) && !data->lintDiagnostics.isEmpty())
+        {
+            foreach (const MarkdownLintDiagnostic& diagnostic, data->lintDiagnostics)
+            {
+                ProblemsModel::Problem problem;
+                problem.blockNumber = block.blockNumber();
+                problem.documentPosition = block.position() + diagnostic.position;
+                problem.diagnostic = diagnostic;
+                problems.append(problem);
+            }
+        }
+
+        block = block.next();
+    }
+
+    // Keep the scroll position, so that the list doesn't jump back to the
+    // top while the user is working through it.
+    //
+    int firstVisibleRow = this->indexAt(QPoint(0, 0)).row();
+
+    problemsModel->setProblems(problems);
+    stale = false;
+
+    if ((firstVisibleRow > 0) && (firstVisibleRow < problems.size()))
+    {
+        this->scrollTo
+        (
+            problemsModel->index(firstVisibleRow),
+            QAbstractItemView::PositionAtTop
+        );
+    }
+}
+
+void ProblemsPanel::onItemActivated(const QModelIndex& index)
+{
+    int position = problemsModel->documentPosition(index.row());
+
+    if (position >= 0)
+    {
+        emit documentPositionNavigated(position);
+    }
+}
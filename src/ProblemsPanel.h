@@ -0,0 +1,85 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef PROBLEMSPANEL_H
+#define PROBLEMSPANEL_H
+
+#include <QListView>
+
+class QTextDocument;
+class QTimer;
+class ProblemsModel;
+
+/**
+ * Lists the lint diagnostics for every block in the document, in document
+ * order.  Clicking on a diagnostic navigates to its position in the
+ * document.
+ *
+ * The list is backed by a lightweight model rather than by list widget
+ * items, and its items have uniform sizes, so that documents with
+ * thousands of diagnostics scroll smoothly.  The list is rebuilt lazily
+ * after the diagnostics settle, and only while the panel is visible.
+ */
+class ProblemsPanel : public QListView
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Takes the document whose diagnostics are to be
+         * listed as a parameter.
+         */
+        ProblemsPanel(QTextDocument* document, QWidget* parent = NULL);
+
+        /**
+         * Destructor.
+         */
+        virtual ~ProblemsPanel();
+
+    signals:
+        /**
+         * Emitted when the user selects a diagnostic, with the diagnostic's
+         * position in the document.
+         */
+        void documentPositionNavigated(int position);
+
+    public slots:
+        /**
+         * Schedules the list to be rebuilt.  Connect this slot to the
+         * MarkdownLinter's diagnosticsChanged() signal.
+         */
+        void onDiagnosticsChanged();
+
+    protected:
+        void showEvent(QShowEvent* event);
+
+    private slots:
+        void refresh();
+        void onItemActivated(const QModelIndex& index);
+
+    private:
+        QTextDocument* document;
+        ProblemsModel* problemsModel;
+        QTimer* refreshTimer;
+        bool stale;
+
+};
+
+#endif // PROBLEMSPANEL_H
@@ -0,0 +1,203 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <QAction>
+#include <QApplication>
+#include <QKeyEvent>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QVBoxLayout>
+
+#include "QuickJumpPalette.h"
+
+QuickJumpPalette::QuickJumpPalette(QWidget* parent)
+    : QFrame(parent, Qt::Popup)
+{
+    this->setFrameStyle(QFrame::StyledPanel | QFrame::Raised);
+
+    queryEdit = new QLineEdit(this);
+    queryEdit->setPlaceholderText(tr("Jump to a heading, file or command"));
+    queryEdit->installEventFilter(this);
+
+    resultsList = new QListWidget(this);
+    resultsList->setUniformItemSizes(true);
+    resultsList->setFocusPolicy(Qt::NoFocus);
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(4, 4, 4, 4);
+    layout->setSpacing(4);
+    layout->addWidget(queryEdit);
+    layout->addWidget(resultsList);
+
+    connect(queryEdit, SIGNAL(textChanged(QString)), this, SLOT(updateResults()));
+    connect(resultsList, SIGNAL(itemActivated(QListWidgetItem*)), this, SLOT(activateItem(QListWidgetItem*)));
+}
+
+QuickJumpPalette::~QuickJumpPalette()
+{
+
+}
+
+void QuickJumpPalette::clearCandidates()
+{
+    candidates.clear();
+    matcher.clear();
+}
+
+void QuickJumpPalette::addHeading(const QString& heading, int position)
+{
+    Candidate candidate;
+    candidate.type = CandidateHeading;
+    candidate.text = heading;
+    candidate.position = position;
+    addCandidate(candidate);
+}
+
+void QuickJumpPalette::addFile(const QString& filePath)
+{
+    Candidate candidate;
+    candidate.type = CandidateFile;
+    candidate.text = filePath;
+    candidate.position = -1;
+    addCandidate(candidate);
+}
+
+void QuickJumpPalette::addCommand(QAction* action, const QString& text)
+{
+    Candidate candidate;
+    candidate.type = CandidateCommand;
+    candidate.text = text;
+    candidate.position = -1;
+    candidate.action = action;
+    addCandidate(candidate);
+}
+
+void QuickJumpPalette::popup()
+{
+    QWidget* parent = this->parentWidget();
+    int width = qBound(400, parent->width() / 2, 700);
+    int height = qMin(400, parent->height() - 80);
+
+    this->resize(width, height);
+    this->move(parent->mapToGlobal(QPoint((parent->width() - width) / 2, 40)));
+
+    queryEdit->clear();
+    updateResults();
+    this->show();
+    queryEdit->setFocus();
+}
+
+bool QuickJumpPalette::eventFilter(QObject* watched, QEvent* event)
+{
+    if ((watched == queryEdit) && (QEvent::KeyPress == event->type()))
+    {
+        QKeyEvent* keyEvent = static_cast<QKeyEvent*>(event);
+
+        switch (keyEvent->key())
+        {
+            case Qt::Key_Up:
+            case Qt::Key_Down:
+            case Qt::Key_PageUp:
+            case Qt::Key_PageDown:
+                QApplication::sendEvent(resultsList, event);
+                return true;
+            case Qt::Key_Return:
+            case Qt::Key_Enter:
+                activateItem(resultsList->currentItem());
+                return true;
+            case Qt::Key_Escape:
+                this->hide();
+                return true;
+            default:
+                break;
+        }
+    }
+
+    return QFrame::eventFilter(watched, event);
+}
+
+void QuickJumpPalette::updateResults()
+{
+    QVector<FuzzyMatcher::Match> matches =
+        matcher.match(queryEdit->text(), GW_QUICK_JUMP_MAX_RESULTS);
+
+    resultsList->clear();
+
+    foreach (const FuzzyMatcher::Match& match, matches)
+    {
+        const Candidate& candidate = candidates[match.index];
+        QString label;
+
+        switch (candidate.type)
+        {
+            case CandidateHeading:
+                label = tr("Heading: %1").arg(candidate.text);
+                break;
+            case CandidateFile:
+                label = tr("File: %1").arg(candidate.text);
+                break;
+            default:
+                label = tr("Command: %1").arg(candidate.text);
+                break;
+        }
+
+        QListWidgetItem* item = new QListWidgetItem(label, resultsList);
+        item->setData(Qt::UserRole, QVariant(match.index));
+    }
+
+    if (resultsList->count() > 0)
+    {
+        resultsList->setCurrentRow(0);
+    }
+}
+
+void QuickJumpPalette::activateItem(QListWidgetItem* item)
+{
+    if (NULL == item)
+    {
+        return;
+    }
+
+    Candidate candidate = candidates[item->data(Qt::UserRole).toInt()];
+
+    this->hide();
+
+    switch (candidate.type)
+    {
+        case CandidateHeading:
+            emit documentPositionNavigated(candidate.position);
+            break;
+        case CandidateFile:
+            emit fileSelected(candidate.text);
+            break;
+        default:
+            if (!candidate.action.isNull() && candidate.action->isEnabled())
+            {
+                candidate.action->trigger();
+            }
+            break;
+    }
+}
+
+void QuickJumpPalette::addCandidate(const Candidate& candidate)
+{
+    candidates.append(candidate);
+    matcher.addCandidate(candidate.text);
+}
@@ -0,0 +1,131 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef QUICKJUMPPALETTE_H
+#define QUICKJUMPPALETTE_H
+
+#include <QFrame>
+#include <QPointer>
+#include <QString>
+#include <QVector>
+
+#include "FuzzyMatcher.h"
+
+/*
+ * Maximum number of matches listed at once.
+ */
+#define GW_QUICK_JUMP_MAX_RESULTS 100
+
+class QAction;
+class QLineEdit;
+class QListWidget;
+class QListWidgetItem;
+
+/**
+ * Pop-up palette for jumping to a heading, opening a recent file, or
+ * running a menu command by typing part of its name.  The list of matches
+ * is updated with every keystroke, best matches first.
+ */
+class QuickJumpPalette : public QFrame
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  The palette pops up centered at the top of the
+         * given parent widget.
+         */
+        QuickJumpPalette(QWidget* parent);
+
+        /**
+         * Destructor.
+         */
+        ~QuickJumpPalette();
+
+        /**
+         * Removes all headings, files and commands from the palette.
+         */
+        void clearCandidates();
+
+        /**
+         * Adds a heading with the given text at the given document
+         * position.
+         */
+        void addHeading(const QString& heading, int position);
+
+        /**
+         * Adds a file that can be opened.
+         */
+        void addFile(const QString& filePath);
+
+        /**
+         * Adds a command that triggers the given action.  The text is
+         * what the user searches for, such as the action's menu path.
+         */
+        void addCommand(QAction* action, const QString& text);
+
+        /**
+         * Shows the palette with an empty query, ready for typing.
+         */
+        void popup();
+
+    signals:
+        /**
+         * Emitted when the user selects a heading.
+         */
+        void documentPositionNavigated(int position);
+
+        /**
+         * Emitted when the user selects a file.
+         */
+        void fileSelected(const QString& filePath);
+
+    protected:
+        bool eventFilter(QObject* watched, QEvent* event);
+
+    private slots:
+        void updateResults();
+        void activateItem(QListWidgetItem* item);
+
+    private:
+        enum CandidateType
+        {
+            CandidateHeading,
+            CandidateFile,
+            CandidateCommand
+        };
+
+        struct Candidate
+        {
+            CandidateType type;
+            QString text;
+            int position;
+            QPointer<QAction> action;
+        };
+
+        QLineEdit* queryEdit;
+        QListWidget* resultsList;
+        QVector<Candidate> candidates;
+        FuzzyMatcher matcher;
+
+        void addCandidate(const Candidate& candidate);
+};
+
+#endif // QUICKJUMPPALETTE_H
@@ -0,0 +1,278 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QCoreApplication>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QStringList>
+#include <QTimer>
+
+#include "RemotePreviewRenderer.h"
+#include "PreviewChannel.h"
+#include "PreviewRendererTypes.h"
+
+// Delay before restarting a crashed helper, to avoid spinning if it keeps
+// crashing on the same content.
+//
+#define GW_RENDERER_RESTART_DELAY 1000
+
+// Time to give the helper to quit on its own after the connection to it is
+// closed, before killing it.
+//
+#define GW_RENDERER_SHUTDOWN_TIMEOUT 1000
+
+RemotePreviewRenderer::RemotePreviewRenderer(QObject* parent)
+    : QObject(parent),
+    channel(NULL),
+    shuttingDown(false),
+    zoomFactor(1.0),
+    windowVisible(false),
+    awaitingContentLoaded(false),
+    contentPending(false)
+{
+    QString serverName = QString("ghostwriter-preview-%1")
+        .arg(QCoreApplication::applicationPid());
+
+    server = new QLocalServer(this);
+
+    // Remove any stale socket left behind by a crashed instance.
+    QLocalServer::removeServer(serverName);
+
+#if QT_VERSION >= 0x050000
+    // The helper receives the rendered document over this socket, so keep
+    // other users on the machine from connecting to it.
+    //
+    server->setSocketOptions(QLocalServer::UserAccessOption);
+#endif
+
+    server->listen(serverName);
+    connect(server, SIGNAL(newConnection()), this, SLOT(onNewConnection()));
+
+    process = new QProcess(this);
+    process->setProcessChannelMode(QProcess::ForwardedChannels);
+    connect(process, SIGNAL(finished(int,QProcess::ExitStatus)), this, SLOT(onProcessFinished(int,QProcess::ExitStatus)));
+}
+
+RemotePreviewRenderer::~RemotePreviewRenderer()
+{
+    shuttingDown = true;
+
+    // Closing the connection tells the helper to quit.
+    if (NULL != channel)
+    {
+        delete channel;
+        channel = NULL;
+    }
+
+    // Rather than blocking the GUI thread until the helper has quit, leave
+    // the process object to delete itself once the helper has finished, and
+    // kill the helper if it has not quit in time.  The kill is dropped if
+    // the process object is deleted first.  The application takes ownership
+    // of the process object in the meantime, so that it is still cleaned up
+    // if the application quits first.
+    //
+    if (QProcess::NotRunning != process->state())
+    {
+        process->disconnect(this);
+        process->setParent(QCoreApplication::instance());
+        connect(process, SIGNAL(finished(int,QProcess::ExitStatus)), process, SLOT(deleteLater()));
+        QTimer::singleShot(GW_RENDERER_SHUTDOWN_TIMEOUT, process, SLOT(kill()));
+    }
+}
+
+void RemotePreviewRenderer::start()
+{
+    if (QProcess::NotRunning != process->state())
+    {
+        return;
+    }
+
+    QStringList args;
+    args << GW_PREVIEW_RENDERER_ARG << server->serverName();
+
+    process->start(QCoreApplication::applicationFilePath(), args);
+}
+
+void RemotePreviewRenderer::setContent(const QByteArray& html, const QUrl& baseUrl)
+{
+    this->html = html;
+    this->baseUrl = baseUrl;
+
+    if (awaitingContentLoaded)
+    {
+        contentPending = true;
+    }
+    else
+    {
+        sendContent();
+    }
+}
+
+void RemotePreviewRenderer::scrollToAnchor(const QString& anchor)
+{
+    if (NULL != channel)
+    {
+        QList<QVariant> args;
+        args.append(QVariant(anchor));
+        channel->send(PreviewMessageScrollToAnchor, args);
+    }
+}
+
+void RemotePreviewRenderer::setUserStyleSheetUrl(const QUrl& url)
+{
+    userStyleSheetUrl = url;
+
+    if (NULL != channel)
+    {
+        QList<QVariant> args;
+        args.append(QVariant(url));
+        channel->send(PreviewMessageSetUserStyleSheet, args);
+    }
+}
+
+void RemotePreviewRenderer::setZoomFactor(qreal factor)
+{
+    zoomFactor = factor;
+
+    if (NULL != channel)
+    {
+        QList<QVariant> args;
+        args.append(QVariant(factor));
+        channel->send(PreviewMessageSetZoomFactor, args);
+    }
+}
+
+void RemotePreviewRenderer::setWindowVisible(bool visible)
+{
+    windowVisible = visible;
+
+    if (NULL != channel)
+    {
+        QList<QVariant> args;
+        args.append(QVariant(visible));
+        channel->send(PreviewMessageSetWindowVisible, args);
+    }
+}
+
+void RemotePreviewRenderer::onNewConnection()
+{
+    QLocalSocket* socket = server->nextPendingConnection();
+
+    if (NULL == socket)
+    {
+        return;
+    }
+
+    // Only one helper is ever connected at a time.
+    if (NULL != channel)
+    {
+        delete channel;
+    }
+
+    channel = new PreviewChannel(socket, this);
+    connect(channel, SIGNAL(messageReceived(int,QList<QVariant>)), this, SLOT(onMessageReceived(int,QList<QVariant>)));
+
+    awaitingContentLoaded = false;
+    contentPending = false;
+    sendState();
+}
+
+void RemotePreviewRenderer::onMessageReceived(int type, const QList<QVariant>& args)
+{
+    switch (type)
+    {
+        case PreviewMessageWindowCreated:
+            if (args.size() >= 1)
+            {
+                emit rendererWindowCreated(args[0].toULongLong());
+            }
+            break;
+        case PreviewMessageContentLoaded:
+            awaitingContentLoaded = false;
+
+            if (contentPending)
+            {
+                contentPending = false;
+                sendContent();
+            }
+            break;
+        case PreviewMessageLinkClicked:
+            if (args.size() >= 1)
+            {
+                emit linkClicked(args[0].toUrl());
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void RemotePreviewRenderer::onProcessFinished
+(
+    int exitCode,
+    QProcess::ExitStatus exitStatus
+)
+{
+    Q_UNUSED(exitCode)
+    Q_UNUSED(exitStatus)
+
+    if (NULL != channel)
+    {
+        channel->deleteLater();
+        channel = NULL;
+    }
+
+    if (!shuttingDown)
+    {
+        qWarning("Preview renderer exited unexpectedly.  Restarting...");
+        QTimer::singleShot(GW_RENDERER_RESTART_DELAY, this, SLOT(start()));
+    }
+}
+
+void RemotePreviewRenderer::sendContent()
+{
+    if (NULL == channel)
+    {
+        // The content will be sent once the helper connects.
+        return;
+    }
+
+    QList<QVariant> args;
+    args.append(QVariant(html));
+    args.append(QVariant(baseUrl));
+    channel->send(PreviewMessageSetContent, args);
+    awaitingContentLoaded = true;
+}
+
+void RemotePreviewRenderer::sendState()
+{
+    setZoomFactor(zoomFactor);
+
+    if (!userStyleSheetUrl.isEmpty())
+    {
+        setUserStyleSheetUrl(userStyleSheetUrl);
+    }
+
+    sendContent();
+
+    if (windowVisible)
+    {
+        setWindowVisible(true);
+    }
+}
@@ -0,0 +1,134 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef REMOTEPREVIEWRENDERER_H
+#define REMOTEPREVIEWRENDERER_H
+
+#include <QObject>
+#include <QProcess>
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+#include <QVariant>
+#include <QList>
+
+class QLocalServer;
+class PreviewChannel;
+
+/**
+ * Editor-side handle to the preview renderer helper process.  The helper
+ * process is another instance of this application, launched with the
+ * GW_PREVIEW_RENDERER_ARG command line argument, which owns the web view
+ * and renders whatever HTML it is sent over a local socket.
+ *
+ * Only the latest content is ever forwarded: while the helper is still busy
+ * laying out a previous page, newer content replaces any content waiting to
+ * be sent.  If the helper process crashes, it is restarted and its state is
+ * restored.
+ */
+class RemotePreviewRenderer : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.
+         */
+        RemotePreviewRenderer(QObject* parent = 0);
+
+        /**
+         * Destructor.  Shuts down the helper process without waiting for
+         * it to quit.
+         */
+        virtual ~RemotePreviewRenderer();
+
+        /**
+         * Sets the HTML to display, with the given base URL used for
+         * resolving relative resource paths.
+         */
+        void setContent(const QByteArray& html, const QUrl& baseUrl);
+
+        /**
+         * Scrolls the page to the given anchor.
+         */
+        void scrollToAnchor(const QString& anchor);
+
+        /**
+         * Sets the user style sheet URL for the page.
+         */
+        void setUserStyleSheetUrl(const QUrl& url);
+
+        /**
+         * Sets the page zoom factor.
+         */
+        void setZoomFactor(qreal factor);
+
+        /**
+         * Shows or hides the helper's top-level window.  This is only
+         * necessary when the helper's window cannot be embedded.
+         */
+        void setWindowVisible(bool visible);
+
+    public slots:
+        /**
+         * Launches the helper process, if it is not already running.
+         */
+        void start();
+
+    signals:
+        /**
+         * Emitted when the helper process has created its window, so that
+         * it can be embedded.  Emitted again if the helper is restarted.
+         */
+        void rendererWindowCreated(qulonglong windowId);
+
+        /**
+         * Emitted when the user clicks a link in the preview.
+         */
+        void linkClicked(const QUrl& url);
+
+    private slots:
+        void onNewConnection();
+        void onMessageReceived(int type, const QList<QVariant>& args);
+        void onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
+
+    private:
+        QLocalServer* server;
+        QProcess* process;
+        PreviewChannel* channel;
+        bool shuttingDown;
+
+        // The latest state sent to the helper, replayed on restart.
+        QByteArray html;
+        QUrl baseUrl;
+        QUrl userStyleSheetUrl;
+        qreal zoomFactor;
+        bool windowVisible;
+
+        // True while the helper has yet to acknowledge the last content.
+        bool awaitingContentLoaded;
+
+        // True if new content arrived while awaiting acknowledgement.
+        bool contentPending;
+
+        void sendContent();
+        void sendState();
+};
+
+#endif // REMOTEPREVIEWRENDERER_H
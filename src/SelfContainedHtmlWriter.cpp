@@ -0,0 +1,445 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <QBuffer>
+#include <QFile>
+#include <QFileInfo>
+#include <QFuture>
+#include <QImage>
+#include <QImageReader>
+#include <QList>
+#include <QRegExp>
+#include <QThread>
+#include <QUrl>
+
+#include "SelfContainedHtmlWriter.h"
+#include "TaskScheduler.h"
+
+// Number of images encoded ahead of the HTML being written, per worker
+// thread.  This bounds the number of encoded images held in memory.
+//
+#define GW_EMBEDDED_IMAGES_PER_THREAD 2
+
+// JPEG quality of downscaled photos.
+#define GW_EMBEDDED_JPEG_QUALITY 90
+
+// Number of levels of @import rules whose style sheets are embedded.  This
+// stops style sheets that import each other from being embedded forever.
+//
+#define GW_EMBEDDED_STYLE_SHEET_MAX_DEPTH 8
+
+/*
+ * Returns the MIME type of a file referenced by a style sheet, going by its
+ * file name extension.
+ */
+static QString styleSheetResourceMimeType(const QString& filePath)
+{
+    QString suffix = QFileInfo(filePath).suffix().toLower();
+
+    if ("css" == suffix)
+    {
+        return "text/css";
+    }
+    else if (("jpg" == suffix) || ("jpeg" == suffix))
+    {
+        return "image/jpeg";
+    }
+    else if ("svg" == suffix)
+    {
+        return "image/svg+xml";
+    }
+    else if
+    (
+        ("png" == suffix)
+        || ("gif" == suffix)
+        || ("bmp" == suffix)
+        || ("webp" == suffix)
+    )
+    {
+        return "image/" + suffix;
+    }
+    else if
+    (
+        ("woff" == suffix)
+        || ("woff2" == suffix)
+        || ("ttf" == suffix)
+        || ("otf" == suffix)
+    )
+    {
+        return "font/" + suffix;
+    }
+    else
+    {
+        return "application/octet-stream";
+    }
+}
+
+SelfContainedHtmlWriter::SelfContainedHtmlWriter(const QDir& baseDir)
+    : baseDir(baseDir), maxImageWidth(0)
+{
+    ;
+}
+
+SelfContainedHtmlWriter::~SelfContainedHtmlWriter()
+{
+    ;
+}
+
+void SelfContainedHtmlWriter::setStyleSheetPath(const QString& path)
+{
+    styleSheetPath = path;
+}
+
+void SelfContainedHtmlWriter::setMaxImageWidth(int width)
+{
+    maxImageWidth = width;
+}
+
+void SelfContainedHtmlWriter::write(const QString& bodyHtml, QIODevice* device)
+{
+    QList<ImageSource> sources;
+    QRegExp imageExpression("<img\\s[^>]*src=\"([^\"]*)\"", Qt::CaseInsensitive);
+    int position = 0;
+
+    while ((position = imageExpression.indexIn(bodyHtml, position)) >= 0)
+    {
+        QString filePath = resolveImagePath(imageExpression.cap(1));
+
+        if (!filePath.isNull())
+        {
+            ImageSource source;
+            source.position = imageExpression.pos(1);
+            source.length = imageExpression.cap(1).length();
+            source.filePath = filePath;
+            sources.append(source);
+        }
+
+        position += imageExpression.matchedLength();
+    }
+
+    QByteArray styleSheet;
+
+    if (!styleSheetPath.isNull() && !styleSheetPath.isEmpty())
+    {
+        QFile styleSheetFile(styleSheetPath);
+
+        if (styleSheetFile.open(QIODevice::ReadOnly))
+        {
+            styleSheet = styleSheetFile.readAll();
+            styleSheetFile.close();
+
+            // The exported file is meant to be shared on its own, so embed
+            // the images, fonts and imported style sheets that the style
+            // sheet references rather than linking to them.
+            //
+            styleSheet = embedStyleSheetUrls
+                (
+                    QString::fromUtf8(styleSheet.constData(), styleSheet.size()),
+                    styleSheetPath,
+                    0
+                ).toUtf8();
+        }
+    }
+
+    // Specify the character set (UTF-8) for the HTML document.
+    // Browsers typically can't tell if the HTML has unicode characters
+    // unless UTF-8 is specified in the <head> section.
+    //
+    device->write("<html><head><meta http-equiv=\"Content-Type\" "
+        "content=\"text/html; charset=utf-8\" /><title></title>");
+
+    if (!styleSheet.isEmpty())
+    {
+        device->write("<style type=\"text/css\">\n");
+        device->write(styleSheet);
+        device->write("\n</style>");
+    }
+
+    device->write("</head><body>");
+
+    // Keep the workers busy encoding the images that come next while the
+    // HTML before the current image is written out.  Each image is released
+    // as soon as it has been written.
+    //
+    TaskOptions options(TaskPriorityBackground);
+    int window = qMax(1, QThread::idealThreadCount()) * GW_EMBEDDED_IMAGES_PER_THREAD;
+    QList< QFuture<QByteArray> > pendingImages;
+    int nextImage = 0;
+
+    position = 0;
+
+    for (int i = 0; i < sources.size(); i++)
+    {
+        while ((nextImage < sources.size()) && (nextImage < (i + window)))
+        {
+            pendingImages.append
+            (
+                TaskScheduler::getInstance()->run
+                (
+                    options,
+                    &SelfContainedHtmlWriter::encodeImage,
+                    sources[nextImage].filePath,
+                    maxImageWidth
+                )
+            );
+            nextImage++;
+        }
+
+        const ImageSource& source = sources[i];
+        device->write(bodyHtml.mid(position, source.position - position).toUtf8());
+
+        QByteArray dataUrl = pendingImages.takeFirst().result();
+
+        if (dataUrl.isEmpty())
+        {
+            device->write(bodyHtml.mid(source.position, source.length).toUtf8());
+        }
+        else
+        {
+            device->write(dataUrl);
+        }
+
+        position = source.position + source.length;
+    }
+
+    device->write(bodyHtml.mid(position).toUtf8());
+    device->write("</body></html>");
+}
+
+QString SelfContainedHtmlWriter::resolveImagePath(const QString& source) const
+{
+    // The HTML processors escape ampersands in URLs.
+    QString url = source;
+    url.replace("&amp;", "&");
+
+    if (url.startsWith("file://", Qt::CaseInsensitive))
+    {
+        url = QUrl(url).toLocalFile();
+    }
+    else if (url.contains("://") || url.startsWith("data:", Qt::CaseInsensitive))
+    {
+        return QString();
+    }
+    else
+    {
+        url = QUrl::fromPercentEncoding(url.toUtf8());
+    }
+
+    QFileInfo fileInfo(baseDir, url);
+
+    if (!fileInfo.isFile())
+    {
+        return QString();
+    }
+
+    return fileInfo.absoluteFilePath();
+}
+
+/*
+ * Returns the given CSS with the relative URLs of its url() and @import
+ * references replaced by data URLs of the files they refer to, resolved
+ * against the directory of the CSS file at the given path (which may be a
+ * resource path).  Imported style sheets have their own references
+ * embedded in turn.  References to files that cannot be read, or to style
+ * sheets imported too deeply, are resolved to absolute URLs instead.
+ */
+QString SelfContainedHtmlWriter::embedStyleSheetUrls
+(
+    const QString& css,
+    const QString& filePath,
+    int depth
+) const
+{
+    QUrl baseUrl;
+
+    if (filePath.startsWith(":"))
+    {
+        baseUrl = QUrl("qrc" + filePath);
+    }
+    else
+    {
+        baseUrl = QUrl::fromLocalFile(QFileInfo(filePath).absoluteFilePath());
+    }
+
+    // The second capture of each expression is the referenced URL, whether
+    // or not it is quoted.
+    //
+    QList<QRegExp> references;
+    references.append(QRegExp("url\\(\\s*(['\"]?)([^'\")]*)\\1\\s*\\)", Qt::CaseInsensitive));
+    references.append(QRegExp("@import\\s+(['\"])([^'\"]*)\\1", Qt::CaseInsensitive));
+
+    QString embeddedCss = css;
+
+    for (int i = 0; i < references.size(); i++)
+    {
+        QRegExp& regex = references[i];
+        int pos = 0;
+
+        while ((pos = regex.indexIn(embeddedCss, pos)) >= 0)
+        {
+            QString reference = regex.cap(2).trimmed();
+            int referencePos = regex.pos(2);
+            int referenceLength = regex.cap(2).length();
+
+            if
+            (
+                reference.isEmpty() ||
+                reference.startsWith("#") ||
+                !QUrl(reference).isRelative()
+            )
+            {
+                pos += regex.matchedLength();
+                continue;
+            }
+
+            QUrl resolvedUrl = baseUrl.resolved(QUrl(reference));
+            QString resolvedPath;
+            QString replacement = resolvedUrl.toString();
+
+            if ("qrc" == resolvedUrl.scheme())
+            {
+                resolvedPath = ":" + resolvedUrl.path();
+            }
+            else
+            {
+                resolvedPath = resolvedUrl.toLocalFile();
+            }
+
+            QString mimeType = styleSheetResourceMimeType(resolvedPath);
+            QFile file(resolvedPath);
+
+            if
+            (
+                (("text/css" != mimeType) || (depth < GW_EMBEDDED_STYLE_SHEET_MAX_DEPTH))
+                && file.open(QIODevice::ReadOnly)
+            )
+            {
+                QByteArray data = file.readAll();
+                file.close();
+
+                if ("text/css" == mimeType)
+                {
+                    data = embedStyleSheetUrls
+                        (
+                            QString::fromUtf8(data.constData(), data.size()),
+                            resolvedPath,
+                            depth + 1
+                        ).toUtf8();
+                }
+
+                replacement = "data:" + mimeType + ";base64,"
+                    + QString::fromLatin1(data.toBase64());
+
+                // Keep the fragment, which picks out an SVG font or sprite.
+                if (resolvedUrl.hasFragment())
+                {
+                    replacement += "#" + resolvedUrl.fragment();
+                }
+            }
+
+            embeddedCss.replace(referencePos, referenceLength, replacement);
+            pos += regex.matchedLength() - referenceLength + replacement.length();
+        }
+    }
+
+    return embeddedCss;
+}
+
+QByteArray SelfContainedHtmlWriter::encodeImage(const QString& filePath, int maxWidth)
+{
+    QImageReader reader(filePath);
+    QByteArray format = reader.format().toLower();
+    QByteArray mimeType;
+    QByteArray data;
+
+    if (format.isEmpty())
+    {
+        return QByteArray();
+    }
+    else if ("jpg" == format)
+    {
+        format = "jpeg";
+    }
+
+    mimeType = "image/" + format;
+
+    if ("svg" == format)
+    {
+        mimeType = "image/svg+xml";
+    }
+
+    QSize size = reader.size();
+
+    if
+    (
+        (maxWidth > 0)
+        && ("svg" != format)
+        && size.isValid()
+        && (size.width() > maxWidth)
+    )
+    {
+        // Let the image reader scale the image while decoding it, which is
+        // far faster for JPEG images than scaling it afterwards.
+        //
+        reader.setScaledSize
+        (
+            QSize(maxWidth, qMax(1, (size.height() * maxWidth) / size.width()))
+        );
+
+        QImage image = reader.read();
+
+        if (image.isNull())
+        {
+            return QByteArray();
+        }
+
+        // Keep photos as JPEG, and everything else lossless.
+        if ("jpeg" != format)
+        {
+            format = "png";
+            mimeType = "image/png";
+        }
+
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        image.save(&buffer, format.constData(), ("jpeg" == format) ? GW_EMBEDDED_JPEG_QUALITY : -1);
+        buffer.close();
+    }
+    else
+    {
+        // Embed the file as is, without decoding it.
+        QFile file(filePath);
+
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return QByteArray();
+        }
+
+        data = file.readAll();
+        file.close();
+    }
+
+    if (data.isEmpty())
+    {
+        return QByteArray();
+    }
+
+    return "data:" + mimeType + ";base64," + data.toBase64();
+}
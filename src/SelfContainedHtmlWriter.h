@@ -0,0 +1,100 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef SELFCONTAINEDHTMLWRITER_H
+#define SELFCONTAINEDHTMLWRITER_H
+
+#include <QByteArray>
+#include <QDir>
+#include <QString>
+
+class QIODevice;
+
+/**
+ * Writes an HTML document that can be shared as a single file, with its
+ * local images embedded as Base64-encoded data URLs and a style sheet
+ * inlined into its head, along with the files that the style sheet
+ * references.  Images are read, optionally downscaled, and
+ * encoded in parallel via the TaskScheduler while the HTML before them is
+ * written out, and only a bounded number of them is held in memory at a
+ * time, so that large documents with many images export quickly without
+ * using much memory.
+ */
+class SelfContainedHtmlWriter
+{
+    public:
+        /**
+         * Constructor.  Relative image paths are resolved against the given
+         * base directory.
+         */
+        SelfContainedHtmlWriter(const QDir& baseDir);
+
+        /**
+         * Destructor.
+         */
+        ~SelfContainedHtmlWriter();
+
+        /**
+         * Sets the style sheet to inline into the document, which may be a
+         * resource path.  No style sheet is inlined if the path is null or
+         * empty.
+         */
+        void setStyleSheetPath(const QString& path);
+
+        /**
+         * Sets the maximum width in pixels of embedded images.  Wider
+         * images are scaled down to fit, keeping their aspect ratio.  A
+         * width of 0 embeds images at their original size.
+         */
+        void setMaxImageWidth(int width);
+
+        /**
+         * Writes a complete HTML document with the given HTML body to the
+         * given device, which must be open for writing.  Images that cannot
+         * be read are left linked rather than embedded.  Check the device
+         * for errors afterwards.
+         */
+        void write(const QString& bodyHtml, QIODevice* device);
+
+    private:
+        // Location of a local image's URL within the HTML.
+        struct ImageSource
+        {
+            int position;
+            int length;
+            QString filePath;
+        };
+
+        QDir baseDir;
+        QString styleSheetPath;
+        int maxImageWidth;
+
+        QString resolveImagePath(const QString& source) const;
+        QString embedStyleSheetUrls
+        (
+            const QString& css,
+            const QString& filePath,
+            int depth
+        ) const;
+
+        static QByteArray encodeImage(const QString& filePath, int maxWidth);
+};
+
+#endif // SELFCONTAINEDHTMLWRITER_H
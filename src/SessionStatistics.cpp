@@ -42,6 +42,7 @@ void SessionStatistics::startNewSession(int initialWordCount)
     sessionWordCount = 0;
     totalWordsWritten = 0;
     lastWordCount = initialWordCount;
+    unrecordedWordsWritten = 0;
     totalSeconds = 0;
     idleSeconds = 0;
     idle = true;
@@ -62,6 +63,7 @@ void SessionStatistics::onDocumentWordCountChanged(int newWordCount)
     if (deltaWords > 0)
     {
         totalWordsWritten += deltaWords;
+        unrecordedWordsWritten += deltaWords;
     }
 
     sessionWordCount += deltaWords;
@@ -103,6 +105,9 @@ void SessionStatistics::onSessionTimerExpired()
     emit wordsPerMinuteChanged(calculateWPM());
     emit writingTimeChanged(totalSeconds / 60);
     emit idleTimePercentageChanged((int) (((float)idleSeconds / (float)totalSeconds) * 100.0f));
+    emit activityRecorded(unrecordedWordsWritten, idle);
+
+    unrecordedWordsWritten = 0;
 }
 
 int SessionStatistics::calculateWPM() const
@@ -69,6 +69,13 @@ class SessionStatistics : public QObject
          */
         void idleTimePercentageChanged(int percentage);
 
+        /**
+         * Emitted once per second of the session with the number of words
+         * written since the previous emission (deletions are not counted),
+         * and whether the writer was idle during that second.
+         */
+        void activityRecorded(int wordsWritten, bool idle);
+
     public slots:
         /**
          * Resets statistics for a new writing session.
@@ -86,6 +93,7 @@ class SessionStatistics : public QObject
         int sessionWordCount;
         int totalWordsWritten;
         int lastWordCount;
+        int unrecordedWordsWritten;
         QTimer* sessionTimer;
         bool idle;
         unsigned long totalSeconds;
@@ -0,0 +1,509 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QObject>
+#include <QQueue>
+#include <QTextBoundaryFinder>
+#include <QtAlgorithms>
+
+#include "StyleChecker.h"
+
+// The automaton's alphabet is the letters a to z, the apostrophe, and the
+// space.  All other characters send the automaton back to its root state.
+//
+static const int ALPHABET_SIZE = 28;
+static const int APOSTROPHE_INDEX = 26;
+static const int SPACE_INDEX = 27;
+
+// Sentences with more words than this are flagged as too long.
+static const int LONG_SENTENCE_WORD_COUNT = 40;
+
+static const char* const WEASEL_WORDS[] =
+{
+    "actually", "arguably", "basically", "certainly", "clearly",
+    "completely", "definitely", "essentially", "extremely", "fairly",
+    "generally", "hopefully", "interestingly", "just", "largely",
+    "literally", "mostly", "obviously", "quite", "rather", "really",
+    "relatively", "remarkably", "significantly", "simply", "somewhat",
+    "surprisingly", "totally", "truly", "usually", "various", "very",
+    "virtually",
+    NULL
+};
+
+static const char* const WORDY_PHRASES[] =
+{
+    "a large number of", "a majority of", "at the present time",
+    "at this point in time", "due to the fact that", "each and every",
+    "first and foremost", "for the purpose of", "has the ability to",
+    "have the ability to", "in close proximity to", "in order to",
+    "in spite of the fact that", "in the event that", "in the process of",
+    "in terms of", "it is important to note that", "on a daily basis",
+    "the fact that", "with regard to", "with respect to",
+    NULL
+};
+
+static const char* const BE_VERBS[] =
+{
+    "am", "are", "be", "been", "being", "is", "isn't", "was", "wasn't",
+    "were", "weren't", "aren't",
+    NULL
+};
+
+static const char* const IRREGULAR_PARTICIPLES[] =
+{
+    "awoken", "been", "born", "beaten", "become", "begun", "bent", "bound",
+    "bitten", "blown", "broken", "brought", "built", "bought", "caught",
+    "chosen", "done", "drawn", "driven", "eaten", "fallen", "fed", "felt",
+    "fought", "found", "forbidden", "forgotten", "forgiven", "frozen",
+    "given", "gone", "grown", "held", "hidden", "hit", "hurt", "kept",
+    "known", "laid", "led", "left", "lent", "lost", "made", "meant", "met",
+    "paid", "put", "read", "ridden", "rung", "risen", "run", "said", "seen",
+    "sold", "sent", "set", "shaken", "shot", "shown", "shut", "sung",
+    "sunk", "slain", "spoken", "spent", "spun", "split", "spread", "stolen",
+    "struck", "sworn", "swept", "taken", "taught", "torn", "told",
+    "thought", "thrown", "understood", "woken", "worn", "won", "withdrawn",
+    "written",
+    NULL
+};
+
+// Words ending in "ed" that are not past participles.
+static const char* const NON_PARTICIPLES[] =
+{
+    "bleed", "breed", "creed", "exceed", "greed", "indeed", "proceed",
+    "speed", "succeed", "steed",
+    NULL
+};
+
+static bool issueLessThan(const StyleIssue& issue1, const StyleIssue& issue2)
+{
+    return issue1.position < issue2.position;
+}
+
+StyleChecker::StyleChecker()
+{
+    // Create the root state.
+    transitions.fill(-1, ALPHABET_SIZE);
+    matchedPattern.append(-1);
+    outputLink.append(-1);
+
+    for (int i = 0; NULL != WEASEL_WORDS[i]; i++)
+    {
+        addPattern(WEASEL_WORDS[i], StyleRuleWeaselWord);
+    }
+
+    for (int i = 0; NULL != WORDY_PHRASES[i]; i++)
+    {
+        addPattern(WORDY_PHRASES[i], StyleRuleWordyPhrase);
+    }
+
+    buildFailureLinks();
+
+    for (int i = 0; NULL != BE_VERBS[i]; i++)
+    {
+        beVerbs.insert(BE_VERBS[i]);
+    }
+
+    for (int i = 0; NULL != IRREGULAR_PARTICIPLES[i]; i++)
+    {
+        irregularParticiples.insert(IRREGULAR_PARTICIPLES[i]);
+    }
+
+    for (int i = 0; NULL != NON_PARTICIPLES[i]; i++)
+    {
+        nonParticiples.insert(NON_PARTICIPLES[i]);
+    }
+}
+
+StyleChecker::~StyleChecker()
+{
+
+}
+
+QList<StyleIssue> StyleChecker::check(const QString& text) const
+{
+    QList<StyleIssue> issues;
+
+    if (text.trimmed().isEmpty())
+    {
+        return issues;
+    }
+
+    QTextBoundaryFinder boundaryFinder(QTextBoundaryFinder::Sentence, text);
+    int sentenceStart = 0;
+    int sentenceEnd = boundaryFinder.toNextBoundary();
+
+    while (sentenceEnd > sentenceStart)
+    {
+        checkSentence(text, sentenceStart, sentenceEnd, issues);
+        findPhrases(text, sentenceStart, sentenceEnd, issues);
+
+        sentenceStart = sentenceEnd;
+        sentenceEnd = boundaryFinder.toNextBoundary();
+    }
+
+    // Look for runs of spaces between words.  Leading spaces are left
+    // alone, since they are indentation, and so are trailing spaces, since
+    // two trailing spaces are a line break in Markdown.
+    //
+    int i = 1;
+
+    while (i < text.length())
+    {
+        if ((' ' == text[i]) && !text[i - 1].isSpace())
+        {
+            int runEnd = i + 1;
+
+            while ((runEnd < text.length()) && (' ' == text[runEnd]))
+            {
+                runEnd++;
+            }
+
+            if (((runEnd - i) > 1) && (runEnd < text.length()))
+            {
+                StyleIssue issue;
+                issue.position = i;
+                issue.length = runEnd - i;
+                issue.rule = StyleRuleDoubleSpace;
+                issues.append(issue);
+            }
+
+            i = runEnd;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    qStableSort(issues.begin(), issues.end(), issueLessThan);
+    return issues;
+}
+
+QString StyleChecker::ruleDescription(StyleRule rule)
+{
+    switch (rule)
+    {
+        case StyleRulePassiveVoice:
+            return QObject::tr("Passive voice");
+        case StyleRuleDoubledWord:
+            return QObject::tr("Doubled word");
+        case StyleRuleWeaselWord:
+            return QObject::tr("Weasel word");
+        case StyleRuleWordyPhrase:
+            return QObject::tr("Wordy phrase");
+        case StyleRuleLongSentence:
+            return QObject::tr("Very long sentence");
+        case StyleRuleDoubleSpace:
+            return QObject::tr("Double space");
+        default:
+            return QString();
+    }
+}
+
+void StyleChecker::addPattern(const QString& pattern, StyleRule rule)
+{
+    int state = 0;
+
+    for (int i = 0; i < pattern.length(); i++)
+    {
+        int index = alphabetIndex(pattern[i]);
+        int next = transitions[(state * ALPHABET_SIZE) + index];
+
+        if (next < 0)
+        {
+            next = matchedPattern.size();
+            transitions.insert(transitions.size(), ALPHABET_SIZE, -1);
+            matchedPattern.append(-1);
+            outputLink.append(-1);
+            transitions[(state * ALPHABET_SIZE) + index] = next;
+        }
+
+        state = next;
+    }
+
+    matchedPattern[state] = patternLengths.size();
+    patternLengths.append(pattern.length());
+    patternRules.append(rule);
+}
+
+void StyleChecker::buildFailureLinks()
+{
+    // Breadth-first traversal of the trie, which fills in the missing
+    // transitions of each state with those of its failure state, so that
+    // the automaton never has to follow failure links while matching.
+    //
+    QVector<int> failure(matchedPattern.size(), 0);
+    QQueue<int> queue;
+
+    for (int index = 0; index < ALPHABET_SIZE; index++)
+    {
+        int child = transitions[index];
+
+        if (child < 0)
+        {
+            transitions[index] = 0;
+        }
+        else
+        {
+            failure[child] = 0;
+            queue.enqueue(child);
+        }
+    }
+
+    while (!queue.isEmpty())
+    {
+        int state = queue.dequeue();
+
+        for (int index = 0; index < ALPHABET_SIZE; index++)
+        {
+            int child = transitions[(state * ALPHABET_SIZE) + index];
+            int fallback = transitions[(failure[state] * ALPHABET_SIZE) + index];
+
+            if (child < 0)
+            {
+                transitions[(state * ALPHABET_SIZE) + index] = fallback;
+            }
+            else
+            {
+                failure[child] = fallback;
+
+                if (matchedPattern[fallback] >= 0)
+                {
+                    outputLink[child] = fallback;
+                }
+                else
+                {
+                    outputLink[child] = outputLink[fallback];
+                }
+
+                queue.enqueue(child);
+            }
+        }
+    }
+}
+
+int StyleChecker::alphabetIndex(QChar c)
+{
+    ushort u = c.toLower().unicode();
+
+    if ((u >= 'a') && (u <= 'z'))
+    {
+        return u - 'a';
+    }
+    else if (('\'' == u) || (0x2019 == u))
+    {
+        return APOSTROPHE_INDEX;
+    }
+    else if (c.isSpace())
+    {
+        return SPACE_INDEX;
+    }
+
+    return -1;
+}
+
+bool StyleChecker::isWordCharacter(QChar c)
+{
+    return c.isLetterOrNumber() || ('\'' == c) || (0x2019 == c.unicode());
+}
+
+void StyleChecker::checkSentence
+(
+    const QString& text,
+    int start,
+    int end,
+    QList<StyleIssue>& issues
+) const
+{
+    QVector<Word> words;
+    QStringList lowerCaseWords;
+    int i = start;
+
+    while (i < end)
+    {
+        if (isWordCharacter(text[i]))
+        {
+            int wordStart = i;
+
+            while ((i < end) && isWordCharacter(text[i]))
+            {
+                i++;
+            }
+
+            int wordEnd = i;
+
+            // Leave out quotation marks around the word.
+            while ((wordStart < wordEnd) && !text[wordStart].isLetterOrNumber())
+            {
+                wordStart++;
+            }
+
+            while ((wordEnd > wordStart) && !text[wordEnd - 1].isLetterOrNumber())
+            {
+                wordEnd--;
+            }
+
+            if (wordEnd > wordStart)
+            {
+                Word word;
+                word.position = wordStart;
+                word.length = wordEnd - wordStart;
+                words.append(word);
+                lowerCaseWords.append(text.mid(wordStart, word.length).toLower());
+            }
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    if (words.isEmpty())
+    {
+        return;
+    }
+
+    if (words.size() > LONG_SENTENCE_WORD_COUNT)
+    {
+        StyleIssue issue;
+        issue.position = words.first().position;
+        issue.length = words.last().position + words.last().length - issue.position;
+        issue.rule = StyleRuleLongSentence;
+        issues.append(issue);
+    }
+
+    for (int w = 0; w < words.size(); w++)
+    {
+        // Check for the same word twice in a row, separated only by
+        // whitespace.
+        //
+        if
+        (
+            (w > 0) &&
+            (lowerCaseWords[w] == lowerCaseWords[w - 1]) &&
+            !text[words[w].position].isDigit() &&
+            text.mid
+            (
+                words[w - 1].position + words[w - 1].length,
+                words[w].position - words[w - 1].position - words[w - 1].length
+            ).trimmed().isEmpty()
+        )
+        {
+            StyleIssue issue;
+            issue.position = words[w - 1].position;
+            issue.length = words[w].position + words[w].length - issue.position;
+            issue.rule = StyleRuleDoubledWord;
+            issues.append(issue);
+        }
+
+        // Check for a form of "to be" followed by a past participle,
+        // allowing for an adverb in between, as in "was quickly written".
+        //
+        if (beVerbs.contains(lowerCaseWords[w]))
+        {
+            int participle = w + 1;
+
+            if
+            (
+                ((participle + 1) < words.size()) &&
+                lowerCaseWords[participle].endsWith("ly")
+            )
+            {
+                participle++;
+            }
+
+            if
+            (
+                (participle < words.size()) &&
+                isPastParticiple(lowerCaseWords[participle])
+            )
+            {
+                StyleIssue issue;
+                issue.position = words[w].position;
+                issue.length = words[participle].position
+                    + words[participle].length - issue.position;
+                issue.rule = StyleRulePassiveVoice;
+                issues.append(issue);
+            }
+        }
+    }
+}
+
+void StyleChecker::findPhrases
+(
+    const QString& text,
+    int start,
+    int end,
+    QList<StyleIssue>& issues
+) const
+{
+    int state = 0;
+
+    for (int i = start; i < end; i++)
+    {
+        int index = alphabetIndex(text[i]);
+
+        if (index < 0)
+        {
+            state = 0;
+            continue;
+        }
+
+        state = transitions[(state * ALPHABET_SIZE) + index];
+
+        // Report the longest pattern ending here that starts and ends on
+        // word boundaries.
+        //
+        int matchState = (matchedPattern[state] >= 0) ? state : outputLink[state];
+
+        while (matchState >= 0)
+        {
+            int pattern = matchedPattern[matchState];
+            int matchStart = i - patternLengths[pattern] + 1;
+
+            if
+            (
+                ((matchStart == start) || !isWordCharacter(text[matchStart - 1])) &&
+                (((i + 1) == end) || !isWordCharacter(text[i + 1]))
+            )
+            {
+                StyleIssue issue;
+                issue.position = matchStart;
+                issue.length = patternLengths[pattern];
+                issue.rule = patternRules[pattern];
+                issues.append(issue);
+                break;
+            }
+
+            matchState = outputLink[matchState];
+        }
+    }
+}
+
+bool StyleChecker::isPastParticiple(const QString& word) const
+{
+    if (irregularParticiples.contains(word))
+    {
+        return true;
+    }
+
+    return (word.length() > 4)
+        && word.endsWith("ed")
+        && !nonParticiples.contains(word);
+}
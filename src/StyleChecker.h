@@ -0,0 +1,141 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef STYLECHECKER_H
+#define STYLECHECKER_H
+
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * Kinds of writing style issues detected by the StyleChecker.
+ */
+enum StyleRule
+{
+    StyleRulePassiveVoice,
+    StyleRuleDoubledWord,
+    StyleRuleWeaselWord,
+    StyleRuleWordyPhrase,
+    StyleRuleLongSentence,
+    StyleRuleDoubleSpace
+};
+
+/**
+ * A writing style issue found in a line of text, given as the position and
+ * length of the offending text within the line.
+ */
+struct StyleIssue
+{
+    int position;
+    int length;
+    StyleRule rule;
+};
+
+/**
+ * Rule-based writing style checker.  Text is checked one sentence at a
+ * time, with sentences found using QTextBoundaryFinder.  Weasel words and
+ * wordy phrases are found in a single pass over each sentence with an
+ * Aho-Corasick automaton that is built once on construction.  The remaining
+ * rules (passive voice, doubled words, long sentences, and double spaces)
+ * are checked with a simple scan of the sentence's words.
+ *
+ * Once constructed, a StyleChecker is never modified, so that check() may
+ * be called from multiple threads at once.
+ */
+class StyleChecker
+{
+    public:
+        /**
+         * Constructor.
+         */
+        StyleChecker();
+
+        /**
+         * Destructor.
+         */
+        ~StyleChecker();
+
+        /**
+         * Checks the given text, and returns the style issues found, in
+         * order of position.  Text that should not be checked, such as
+         * inline code, can be masked out by replacing it with
+         * QChar::ObjectReplacementCharacter.
+         */
+        QList<StyleIssue> check(const QString& text) const;
+
+        /**
+         * Returns a short description of the given rule for display to
+         * the user.
+         */
+        static QString ruleDescription(StyleRule rule);
+
+    private:
+        struct Word
+        {
+            int position;
+            int length;
+        };
+
+        // Automaton transitions, ALPHABET_SIZE entries per state.
+        QVector<int> transitions;
+
+        // For each state, the index of the longest pattern ending at that
+        // state, or -1 if none.
+        QVector<int> matchedPattern;
+
+        // For each state, the next state along its failure links that
+        // matches a pattern, or -1 if none.
+        QVector<int> outputLink;
+
+        QVector<int> patternLengths;
+        QVector<StyleRule> patternRules;
+
+        QSet<QString> beVerbs;
+        QSet<QString> irregularParticiples;
+        QSet<QString> nonParticiples;
+
+        void addPattern(const QString& pattern, StyleRule rule);
+        void buildFailureLinks();
+
+        static int alphabetIndex(QChar c);
+        static bool isWordCharacter(QChar c);
+
+        void checkSentence
+        (
+            const QString& text,
+            int start,
+            int end,
+            QList<StyleIssue>& issues
+        ) const;
+
+        void findPhrases
+        (
+            const QString& text,
+            int start,
+            int end,
+            QList<StyleIssue>& issues
+        ) const;
+
+        bool isPastParticiple(const QString& word) const;
+};
+
+#endif // STYLECHECKER_H
@@ -0,0 +1,519 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef SUMTREE_H
+#define SUMTREE_H
+
+#include <QVector>
+
+/**
+ * Sequence of values that supports inserting and removing values at any
+ * index, changing a value, and summing a range of values, all in
+ * logarithmic time.  This makes it suitable for keeping per-block
+ * statistics of a document whose blocks are being inserted and removed as
+ * the user types.
+ *
+ * The values are kept in an implicit treap, that is, a randomized binary
+ * search tree ordered by index, where each node records the size and the
+ * sum of its subtree.  The value type T must be default-constructible to
+ * zero and support addition and subtraction.
+ */
+template <class T>
+class SumTree
+{
+    public:
+        /**
+         * Constructor.  Creates an empty tree.
+         */
+        SumTree();
+
+        /**
+         * Destructor.
+         */
+        ~SumTree();
+
+        /**
+         * Replaces the contents of the tree with the given values, in
+         * linear time.
+         */
+        void reset(const QVector<T>& values);
+
+        /**
+         * Removes all values from the tree.
+         */
+        void clear();
+
+        /**
+         * Returns the number of values in the tree.
+         */
+        int size() const;
+
+        /**
+         * Returns the value at the given index.
+         */
+        T value(int index) const;
+
+        /**
+         * Sets the value at the given index.
+         */
+        void setValue(int index, const T& value);
+
+        /**
+         * Inserts count zero values before the given index, shifting the
+         * values from that index on.  Runs in time linear in count, and
+         * logarithmic in the size of the tree.
+         */
+        void insert(int index, int count);
+
+        /**
+         * Removes count values starting at the given index, shifting the
+         * values that follow them.
+         */
+        void remove(int index, int count);
+
+        /**
+         * Returns the sum of the first count values.
+         */
+        T prefixSum(int count) const;
+
+        /**
+         * Returns the sum of the values from index first up to, but not
+         * including, index last.
+         */
+        T sum(int first, int last) const;
+
+        /**
+         * Returns the sum of all values.
+         */
+        T total() const;
+
+        /**
+         * Returns the largest count for which prefixSum(count) does not
+         * exceed the given sum.  The values in the tree must not be
+         * negative.
+         */
+        int upperBound(T sum) const;
+
+    private:
+        struct Node
+        {
+            int left;
+            int right;
+            unsigned int priority;
+            int size;
+            T value;
+            T sum;
+        };
+
+        // Node 0 is the null node, an empty subtree whose size and sum
+        // are zero.
+        //
+        QVector<Node> nodes;
+        QVector<int> freeNodes;
+        int root;
+        unsigned int seed;
+
+        int newNode(const T& value);
+        int build(const QVector<T>& values);
+        void update(int node);
+        void split(int node, int count, int& left, int& right);
+        int merge(int left, int right);
+        void release(int node);
+        unsigned int nextPriority();
+};
+
+template <class T>
+SumTree<T>::SumTree()
+    : root(0), seed(0x9E3779B9u)
+{
+    clear();
+}
+
+template <class T>
+SumTree<T>::~SumTree()
+{
+
+}
+
+template <class T>
+void SumTree<T>::reset(const QVector<T>& values)
+{
+    clear();
+    root = build(values);
+}
+
+template <class T>
+void SumTree<T>::clear()
+{
+    Node null;
+    null.left = 0;
+    null.right = 0;
+    null.priority = 0;
+    null.size = 0;
+    null.value = T();
+    null.sum = T();
+
+    nodes.clear();
+    nodes.append(null);
+    freeNodes.clear();
+    root = 0;
+}
+
+template <class T>
+int SumTree<T>::size() const
+{
+    return nodes[root].size;
+}
+
+template <class T>
+T SumTree<T>::value(int index) const
+{
+    int node = root;
+
+    while (0 != node)
+    {
+        int leftSize = nodes[nodes[node].left].size;
+
+        if (index < leftSize)
+        {
+            node = nodes[node].left;
+        }
+        else if (index == leftSize)
+        {
+            return nodes[node].value;
+        }
+        else
+        {
+            index -= leftSize + 1;
+            node = nodes[node].right;
+        }
+    }
+
+    return T();
+}
+
+template <class T>
+void SumTree<T>::setValue(int index, const T& value)
+{
+    if ((index < 0) || (index >= size()))
+    {
+        return;
+    }
+
+    T delta = value - this->value(index);
+    int node = root;
+
+    // Add the difference to the sum of every subtree on the way down to
+    // the node.
+    //
+    while (0 != node)
+    {
+        int leftSize = nodes[nodes[node].left].size;
+        nodes[node].sum = nodes[node].sum + delta;
+
+        if (index < leftSize)
+        {
+            node = nodes[node].left;
+        }
+        else if (index == leftSize)
+        {
+            nodes[node].value = value;
+            break;
+        }
+        else
+        {
+            index -= leftSize + 1;
+            node = nodes[node].right;
+        }
+    }
+}
+
+template <class T>
+void SumTree<T>::insert(int index, int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    int left;
+    int right;
+
+    split(root, qBound(0, index, size()), left, right);
+    root = merge(merge(left, build(QVector<T>(count))), right);
+}
+
+template <class T>
+void SumTree<T>::remove(int index, int count)
+{
+    if ((count <= 0) || (index < 0) || (index >= size()))
+    {
+        return;
+    }
+
+    int left;
+    int middle;
+    int right;
+
+    split(root, index, left, right);
+    split(right, count, middle, right);
+    release(middle);
+    root = merge(left, right);
+}
+
+template <class T>
+T SumTree<T>::prefixSum(int count) const
+{
+    T total = T();
+    int node = root;
+
+    while ((0 != node) && (count > 0))
+    {
+        int leftSize = nodes[nodes[node].left].size;
+
+        if (count <= leftSize)
+        {
+            node = nodes[node].left;
+        }
+        else
+        {
+            total = total + nodes[nodes[node].left].sum + nodes[node].value;
+            count -= leftSize + 1;
+            node = nodes[node].right;
+        }
+    }
+
+    return total;
+}
+
+template <class T>
+T SumTree<T>::sum(int first, int last) const
+{
+    if (last <= first)
+    {
+        return T();
+    }
+
+    return prefixSum(last) - prefixSum(first);
+}
+
+template <class T>
+T SumTree<T>::total() const
+{
+    return nodes[root].sum;
+}
+
+template <class T>
+int SumTree<T>::upperBound(T sum) const
+{
+    int count = 0;
+    int node = root;
+
+    while (0 != node)
+    {
+        const Node& n = nodes[node];
+
+        if (sum < nodes[n.left].sum)
+        {
+            node = n.left;
+        }
+        else
+        {
+            sum = sum - nodes[n.left].sum;
+            count += nodes[n.left].size;
+
+            if (sum < n.value)
+            {
+                break;
+            }
+
+            sum = sum - n.value;
+            count++;
+            node = n.right;
+        }
+    }
+
+    return count;
+}
+
+template <class T>
+int SumTree<T>::newNode(const T& value)
+{
+    Node n;
+    n.left = 0;
+    n.right = 0;
+    n.priority = nextPriority();
+    n.size = 1;
+    n.value = value;
+    n.sum = value;
+
+    if (!freeNodes.isEmpty())
+    {
+        int node = freeNodes.last();
+        freeNodes.pop_back();
+        nodes[node] = n;
+        return node;
+    }
+
+    nodes.append(n);
+    return nodes.size() - 1;
+}
+
+template <class T>
+int SumTree<T>::build(const QVector<T>& values)
+{
+    // Build the treap in linear time from the values in order, keeping the
+    // rightmost path of the tree on a stack.  Each new node adopts the
+    // part of that path whose priorities are lower than its own as its
+    // left subtree.
+    //
+    QVector<int> path;
+
+    for (int i = 0; i < values.size(); i++)
+    {
+        int node = newNode(values[i]);
+        int last = 0;
+
+        while (!path.isEmpty() && (nodes[path.last()].priority < nodes[node].priority))
+        {
+            last = path.last();
+            path.pop_back();
+            update(last);
+        }
+
+        nodes[node].left = last;
+
+        if (!path.isEmpty())
+        {
+            nodes[path.last()].right = node;
+        }
+
+        path.append(node);
+    }
+
+    for (int i = path.size() - 1; i >= 0; i--)
+    {
+        update(path[i]);
+    }
+
+    return path.isEmpty() ? 0 : path.first();
+}
+
+template <class T>
+void SumTree<T>::update(int node)
+{
+    Node& n = nodes[node];
+    n.size = nodes[n.left].size + 1 + nodes[n.right].size;
+    n.sum = nodes[n.left].sum + n.value + nodes[n.right].sum;
+}
+
+template <class T>
+void SumTree<T>::split(int node, int count, int& left, int& right)
+{
+    if (0 == node)
+    {
+        left = 0;
+        right = 0;
+        return;
+    }
+
+    int leftSize = nodes[nodes[node].left].size;
+
+    if (count <= leftSize)
+    {
+        int subtreeRight;
+        split(nodes[node].left, count, left, subtreeRight);
+        nodes[node].left = subtreeRight;
+        right = node;
+    }
+    else
+    {
+        int subtreeLeft;
+        split(nodes[node].right, count - leftSize - 1, subtreeLeft, right);
+        nodes[node].right = subtreeLeft;
+        left = node;
+    }
+
+    update(node);
+}
+
+template <class T>
+int SumTree<T>::merge(int left, int right)
+{
+    if ((0 == left) || (0 == right))
+    {
+        return left + right;
+    }
+
+    if (nodes[left].priority > nodes[right].priority)
+    {
+        int subtree = merge(nodes[left].right, right);
+        nodes[left].right = subtree;
+        update(left);
+        return left;
+    }
+    else
+    {
+        int subtree = merge(left, nodes[right].left);
+        nodes[right].left = subtree;
+        update(right);
+        return right;
+    }
+}
+
+template <class T>
+void SumTree<T>::release(int node)
+{
+    QVector<int> pending;
+
+    if (0 != node)
+    {
+        pending.append(node);
+    }
+
+    while (!pending.isEmpty())
+    {
+        int next = pending.last();
+        pending.pop_back();
+
+        if (0 != nodes[next].left)
+        {
+            pending.append(nodes[next].left);
+        }
+
+        if (0 != nodes[next].right)
+        {
+            pending.append(nodes[next].right);
+        }
+
+        freeNodes.append(next);
+    }
+}
+
+template <class T>
+unsigned int SumTree<T>::nextPriority()
+{
+    // Xorshift, which is plenty random enough to keep the tree balanced.
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+#endif // SUMTREE_H
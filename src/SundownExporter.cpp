@@ -24,18 +24,29 @@
 #include <QObject>
 #include <QFile>
 #include <QFileInfo>
-#include <QTextStream>
 
 #include "SundownExporter.h"
 
 #include "sundown/markdown.h"
 #include "sundown/html.h"
+#include "sundown/latex.h"
+#include "sundown/odt.h"
 #include "sundown/buffer.h"
 
+// Sundown stream callback that writes rendered output to a QFile.
+//
+static void writeToFile(const uint8_t* data, size_t size, void* file)
+{
+    ((QFile*) file)->write((const char*) data, size);
+}
+
 
 SundownExporter::SundownExporter() : Exporter("Sundown")
 {
     supportedFormats.append(ExportFormat::HTML);
+    supportedFormats.append(ExportFormat::LATEX);
+    supportedFormats.append(ExportFormat::ODF);
+    selfContainedHtmlSupported = true;
 }
 
 SundownExporter::~SundownExporter()
@@ -118,7 +129,66 @@ void SundownExporter::exportToFile
     QString& err
 )
 {
-    Q_UNUSED(inputFilePath);
+    if ((ExportFormat::LATEX == format) || (ExportFormat::ODF == format))
+    {
+        QFile outputFile(outputFilePath);
+
+        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            err = outputFile.errorString();
+            return;
+        }
+
+        QByteArray utf8Text = text.toUtf8();
+        struct buf* outputBuffer = bufnew(1024);
+        struct sd_callbacks callbacks;
+        struct latex_renderopt latexOptions;
+        struct odt_renderopt odtOptions;
+        void* options;
+        struct sd_markdown* markdown;
+
+        // Rather than building the entire document in memory, the renderers
+        // hand each completed top-level block to writeToFile() as they go.
+        //
+        if (ExportFormat::LATEX == format)
+        {
+            sdlatex_renderer(&callbacks, &latexOptions, writeToFile, &outputFile);
+            options = &latexOptions;
+        }
+        else
+        {
+            sdodt_renderer(&callbacks, &odtOptions, writeToFile, &outputFile);
+            options = &odtOptions;
+        }
+
+        markdown = sd_markdown_new
+        (
+            MKDEXT_TABLES | MKDEXT_FENCED_CODE | MKDEXT_SPACE_HEADERS
+                | MKDEXT_SUPERSCRIPT | MKDEXT_STRIKETHROUGH | MKDEXT_AUTOLINK,
+            16,
+            &callbacks,
+            options
+        );
+
+        sd_markdown_render
+        (
+            outputBuffer,
+            (const uint8_t*) utf8Text.data(),
+            utf8Text.length(),
+            markdown
+        );
+
+        sd_markdown_free(markdown);
+        bufrelease(outputBuffer);
+
+        if (QFile::NoError != outputFile.error())
+        {
+            err = outputFile.errorString();
+        }
+
+        outputFile.close();
+        return;
+    }
 
     QString html;
 
@@ -137,33 +207,5 @@ void SundownExporter::exportToFile
         return;
     }
 
-    QFile outputFile(outputFilePath);
-
-    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
-    {
-        err = outputFile.errorString();
-        return;
-    }
-
-    // Write contents to disk.
-    QTextStream outStream(&outputFile);
-
-    // Specify the character set (UTF-8) for the HTML document.
-    // Browsers typically can't tell if the HTML has unicode characters
-    // unless UTF-8 is specified in the <head> section.
-    //
-    outStream << "<html><head><meta http-equiv=\"Content-Type\" "
-        "content=\"text/html; charset=utf-8\" />"
-        "<title></title></head><body>";
-
-    outStream << html;
-    outStream << "</body></html>";
-
-    if (QFile::NoError != outputFile.error())
-    {
-        err = outputFile.errorString();
-    }
-
-    // Close the file.  All done!
-    outputFile.close();
+    writeHtmlFile(html, inputFilePath, outputFilePath, err);
 }
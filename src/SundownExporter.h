@@ -23,7 +23,8 @@
 #include "Exporter.h"
 
 /**
- * Exports Markdown text to HTML via the built-in Sundown processor.
+ * Exports Markdown text to HTML, LaTeX, or OpenDocument Flat XML via the
+ * built-in Sundown processor.
  */
 class SundownExporter : public Exporter
 {
@@ -47,8 +48,9 @@ class SundownExporter : public Exporter
         /**
          * Exports the given Markdown text to the given export format and
          * output file path.  Sets err to a non-null string error message
-         * if the export fails.  Note that the only supported format for
-         * this exporter is HTML.
+         * if the export fails.  Note that the only supported formats for
+         * this exporter are HTML, LaTeX, and OpenDocument Flat XML.  LaTeX
+         * and OpenDocument output is streamed to disk as it is rendered.
          */
         void exportToFile
         (
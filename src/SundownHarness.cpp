@@ -0,0 +1,474 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <stdio.h>
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include "SundownHarness.h"
+#include "SundownExporter.h"
+#include "ExporterFactory.h"
+#include "ExportFormat.h"
+
+// Minimum time in milliseconds to spend exporting each document to each
+// format with each exporter, so that the fast exports are not skewed by
+// the timer's resolution.  Each export runs at least once, however long
+// it takes.
+//
+#define GW_EXPORT_BENCHMARK_MIN_TIME 1000
+
+// Number of chapters in the book that is made up when no documents are
+// given.  Each chapter is a little over 4 KB, for a book of about 850 KB,
+// the length of a long novel.
+//
+#define GW_EXPORT_BENCHMARK_CHAPTERS 200
+
+// Name of the Pandoc exporter to compare with.
+#define GW_EXPORT_BENCHMARK_PANDOC "Pandoc"
+
+// Number of lines of text in each nested document.
+#define GW_NESTING_BENCHMARK_LINES 20000
+
+// Minimum time in milliseconds to spend rendering each nested document,
+// and the minimum number of renders.
+//
+#define GW_NESTING_BENCHMARK_MIN_TIME 1000
+#define GW_NESTING_BENCHMARK_MIN_ITERATIONS 5
+
+// Depths to which the lines of the nested documents are nested.  Each
+// level of a list uses up more than one of the exporter's sixteen levels
+// of nesting, so lists cannot be nested much further than the deepest of
+// these.
+//
+#define GW_NESTING_BENCHMARK_DEPTHS { 1, 2, 4, 8 }
+
+SundownHarness::SundownHarness(const QStringList& paths)
+    : paths(paths)
+{
+    ;
+}
+
+SundownHarness::~SundownHarness()
+{
+    ;
+}
+
+int SundownHarness::runExportBenchmark()
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    QStringList documentNames;
+    QStringList documents;
+
+    foreach (QString filePath, findCorpusFiles())
+    {
+        QFile file(filePath);
+
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            err << "Could not read " << filePath << "\n";
+            continue;
+        }
+
+        QTextStream in(&file);
+        in.setCodec("UTF-8");
+        documents.append(in.readAll());
+        documentNames.append(QFileInfo(filePath).fileName());
+        file.close();
+    }
+
+    if (documents.isEmpty())
+    {
+        documents.append(makeBook());
+        documentNames.append("Made up book");
+    }
+
+    SundownExporter sundownExporter;
+    Exporter* pandocExporter = findPandocExporter();
+    const ExportFormat* formats[] = { ExportFormat::LATEX, ExportFormat::ODF };
+    const char* formatNames[] = { "LaTeX", "FODT" };
+    int failures = 0;
+
+    // Smart typography is not part of the LaTeX or OpenDocument output of
+    // the Sundown exporter, so leave it out of the comparison.
+    //
+    if (NULL == pandocExporter)
+    {
+        out << "Pandoc is not installed, so only Sundown is timed.\n\n";
+    }
+    else
+    {
+        pandocExporter->setSmartTypographyEnabled(false);
+    }
+
+    out << QString("Document").leftJustified(28)
+        << QString("KB").rightJustified(8)
+        << QString("Format").rightJustified(8)
+        << QString("Sundown ms").rightJustified(12)
+        << QString("Pandoc ms").rightJustified(12)
+        << QString("Speedup").rightJustified(9) << "\n";
+
+    for (int i = 0; i < documents.size(); i++)
+    {
+        for (int j = 0; j < 2; j++)
+        {
+            QString outputFilePath = QDir::temp().filePath
+                (
+                    QString("ghostwriter-export-benchmark.")
+                        + formats[j]->getDefaultFileExtension()
+                );
+            QString sundownErr;
+            QString pandocErr;
+            double sundownTime = measureExportTime
+                (
+                    &sundownExporter,
+                    formats[j],
+                    documents[i],
+                    outputFilePath,
+                    sundownErr
+                );
+
+            out << documentNames[i].leftJustified(28, ' ', true)
+                << QString::number(documents[i].toUtf8().size() / 1024.0, 'f', 1).rightJustified(8)
+                << QString(formatNames[j]).rightJustified(8);
+
+            if (!sundownErr.isNull())
+            {
+                out << QString("failed").rightJustified(12) << "\n";
+                err << "Sundown: " << sundownErr << "\n";
+                failures++;
+                QFile::remove(outputFilePath);
+                continue;
+            }
+
+            out << QString::number(sundownTime, 'f', 2).rightJustified(12);
+
+            if (NULL != pandocExporter)
+            {
+                double pandocTime = measureExportTime
+                    (
+                        pandocExporter,
+                        formats[j],
+                        documents[i],
+                        outputFilePath,
+                        pandocErr
+                    );
+
+                // Pandoc writes warnings to the error output without
+                // failing, so only report them.
+                //
+                if (!pandocErr.isEmpty())
+                {
+                    err << "Pandoc: " << pandocErr << "\n";
+                }
+
+                out << QString::number(pandocTime, 'f', 2).rightJustified(12)
+                    << QString::number(pandocTime / qMax(sundownTime, 0.001), 'f', 1).rightJustified(9);
+            }
+
+            out << "\n";
+            out.flush();
+
+            QFile::remove(outputFilePath);
+        }
+    }
+
+    return (0 == failures) ? 0 : 1;
+}
+
+int SundownHarness::runNestingBenchmark()
+{
+    static const int depths[] = GW_NESTING_BENCHMARK_DEPTHS;
+    int depthCount = (int) (sizeof(depths) / sizeof(depths[0]));
+    QTextStream out(stdout);
+    SundownExporter exporter;
+    int failures = 0;
+
+    // Smart typography is an extra pass over the output, which does not
+    // depend on how deeply the input is nested.
+    //
+    exporter.setSmartTypographyEnabled(false);
+
+    out << QString("Document").leftJustified(16)
+        << QString("Depth").rightJustified(6)
+        << QString("KB").rightJustified(8)
+        << QString("ms").rightJustified(10)
+        << QString("Slowdown").rightJustified(10) << "\n";
+
+    for (int kind = 0; kind < 2; kind++)
+    {
+        bool blockquotes = (1 == kind);
+        double unnestedTime = 0.0;
+
+        for (int i = 0; i < depthCount; i++)
+        {
+            QString markdown = makeNestedDocument(blockquotes, depths[i]);
+            QString html;
+            QElapsedTimer timer;
+            int iterations = 0;
+
+            // Render once before timing, to warm up the caches and to check
+            // the output.
+            //
+            exporter.exportToHtml(markdown, html);
+
+            int renderedDepth = findNestingDepth
+                (
+                    html,
+                    blockquotes ? "blockquote" : "ul"
+                );
+
+            timer.start();
+
+            while
+            (
+                (timer.elapsed() < GW_NESTING_BENCHMARK_MIN_TIME)
+                || (iterations < GW_NESTING_BENCHMARK_MIN_ITERATIONS)
+            )
+            {
+                exporter.exportToHtml(markdown, html);
+                iterations++;
+            }
+
+            double time = (timer.nsecsElapsed() / 1000000.0) / iterations;
+
+            if (0 == i)
+            {
+                unnestedTime = time;
+            }
+
+            out << QString(blockquotes ? "Block quotes" : "Lists").leftJustified(16)
+                << QString::number(depths[i]).rightJustified(6)
+                << QString::number(markdown.toUtf8().size() / 1024.0, 'f', 1).rightJustified(8)
+                << QString::number(time, 'f', 2).rightJustified(10)
+                << QString::number(time / qMax(unnestedTime, 0.001), 'f', 2).rightJustified(10);
+
+            if (renderedDepth != depths[i])
+            {
+                out << "  FAILED (rendered " << renderedDepth << " levels deep)";
+                failures++;
+            }
+
+            out << "\n";
+            out.flush();
+        }
+    }
+
+    return (0 == failures) ? 0 : 1;
+}
+
+QStringList SundownHarness::findCorpusFiles() const
+{
+    QStringList corpusFilePaths;
+    QStringList nameFilters;
+    nameFilters << "*.md" << "*.markdown" << "*.mdown" << "*.mkd" << "*.txt";
+
+    foreach (QString path, paths)
+    {
+        QFileInfo info(path);
+
+        if (info.isDir())
+        {
+            QDir dir(path);
+
+            foreach (QString fileName, dir.entryList(nameFilters, QDir::Files, QDir::Name))
+            {
+                corpusFilePaths.append(dir.filePath(fileName));
+            }
+        }
+        else if (info.isFile())
+        {
+            corpusFilePaths.append(path);
+        }
+    }
+
+    return corpusFilePaths;
+}
+
+/*
+ * Returns a book made up of chapters that each use every block and span
+ * element that the LaTeX and OpenDocument renderers handle, including the
+ * characters LaTeX needs escaped.
+ */
+QString SundownHarness::makeBook() const
+{
+    QString book;
+    QString paragraph =
+        "It was a *dark* and **stormy** night, and the rain fell in torrents, "
+        "except at occasional intervals, when it was checked by a violent gust "
+        "of wind which swept up the streets (for it is in London that our scene "
+        "lies), rattling along the housetops, and fiercely agitating the scanty "
+        "flame of the lamps that struggled against the darkness.  See "
+        "[the notes](http://example.com/notes_1.html) and `fire_place` for "
+        "100% of the story & #%1.\n\n";
+
+    for (int chapter = 1; chapter <= GW_EXPORT_BENCHMARK_CHAPTERS; chapter++)
+    {
+        book += QString("# Chapter %1\n\n").arg(chapter);
+
+        for (int section = 1; section <= 3; section++)
+        {
+            book += QString("## Section %1.%2\n\n").arg(chapter).arg(section);
+
+            for (int i = 0; i < 3; i++)
+            {
+                book += paragraph.arg(chapter);
+            }
+        }
+
+        book +=
+            "> A quotation that goes on for a while, with *emphasis* and a\n"
+            "> second line.\n"
+            ">\n"
+            "> > And a nested quotation.\n\n"
+            "1. First step\n"
+            "2. Second step\n"
+            "    * A detail\n"
+            "    * Another detail\n"
+            "3. Third step\n\n"
+            "| Name | Value | Notes |\n"
+            "|:-----|------:|:-----:|\n"
+            "| one  | 1     | ~~old~~ |\n"
+            "| two  | 2     | new   |\n\n"
+            "```\n"
+            "for (i = 0; i < 10; i++) { total += i; }\n"
+            "```\n\n"
+            "![A figure](images/figure_1.png)\n\n"
+            "* * *\n\n";
+    }
+
+    return book;
+}
+
+Exporter* SundownHarness::findPandocExporter() const
+{
+    foreach (Exporter* exporter, ExporterFactory::getInstance()->getFileExporters())
+    {
+        if (GW_EXPORT_BENCHMARK_PANDOC == exporter->getName())
+        {
+            return exporter;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Returns a document of the same sentence on every line, with the lines
+ * nested one level deeper each up to the given depth, and then back to
+ * the first level again.  Lines are nested either as list items indented
+ * by four spaces per level, or as block quotes with one "> " per level.
+ * Groups of block quotes are separated by blank lines, so that each group
+ * starts a new block quote rather than continuing the deepest one.
+ */
+QString SundownHarness::makeNestedDocument(bool blockquotes, int depth) const
+{
+    QString sentence = "The quick brown fox jumps over the lazy dog, then naps in the sun.\n";
+    QString markdown;
+    int lineCount = 0;
+
+    while (lineCount < GW_NESTING_BENCHMARK_LINES)
+    {
+        for (int level = 1; (level <= depth) && (lineCount < GW_NESTING_BENCHMARK_LINES); level++)
+        {
+            if (blockquotes)
+            {
+                markdown += QString("> ").repeated(level);
+            }
+            else
+            {
+                markdown += QString("    ").repeated(level - 1) + "* ";
+            }
+
+            markdown += sentence;
+            lineCount++;
+        }
+
+        if (blockquotes)
+        {
+            markdown += "\n";
+        }
+    }
+
+    return markdown;
+}
+
+/*
+ * Returns how deeply the elements with the given tag are nested in the
+ * HTML.
+ */
+int SundownHarness::findNestingDepth(const QString& html, const QString& tag) const
+{
+    QString openingTag = "<" + tag + ">";
+    QString closingTag = "</" + tag + ">";
+    int depth = 0;
+    int maxDepth = 0;
+    int index = html.indexOf('<');
+
+    while (index >= 0)
+    {
+        if (html.midRef(index, openingTag.length()) == openingTag)
+        {
+            depth++;
+            maxDepth = qMax(maxDepth, depth);
+        }
+        else if (html.midRef(index, closingTag.length()) == closingTag)
+        {
+            depth--;
+        }
+
+        index = html.indexOf('<', index + 1);
+    }
+
+    return maxDepth;
+}
+
+/*
+ * Exports the text to the output file repeatedly, and returns the average
+ * time taken per export in milliseconds.  Sets err to the error of the
+ * last export, if any.
+ */
+double SundownHarness::measureExportTime
+(
+    Exporter* exporter,
+    const ExportFormat* format,
+    const QString& text,
+    const QString& outputFilePath,
+    QString& err
+) const
+{
+    QElapsedTimer timer;
+    int iterations = 0;
+
+    timer.start();
+
+    do
+    {
+        err = QString();
+        exporter->exportToFile(format, QString(), text, outputFilePath, err);
+        iterations++;
+    }
+    while (err.isNull() && (timer.elapsed() < GW_EXPORT_BENCHMARK_MIN_TIME));
+
+    return (timer.nsecsElapsed() / 1000000.0) / iterations;
+}
@@ -0,0 +1,100 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef SUNDOWNHARNESS_H
+#define SUNDOWNHARNESS_H
+
+#include <QString>
+#include <QStringList>
+
+class Exporter;
+class ExportFormat;
+
+/*
+ * Command line argument that launches ghostwriter as the LaTeX and
+ * OpenDocument export benchmark rather than as an editor.  The arguments
+ * that follow it are optional Markdown files, or directories of Markdown
+ * files, to export.  A large book is made up when none are given.
+ */
+#define GW_EXPORT_BENCHMARK_ARG "--export-benchmark"
+
+/*
+ * Command line argument that launches ghostwriter as the nested block
+ * benchmark of the Sundown parser rather than as an editor.
+ */
+#define GW_NESTING_BENCHMARK_ARG "--nesting-benchmark"
+
+/**
+ * Measures how long the built-in Sundown renderers take to export
+ * Markdown documents to LaTeX and OpenDocument Flat XML, compared with
+ * Pandoc when it is installed, and how much slower the Sundown parser
+ * gets on deeply nested lists and block quotes.
+ */
+class SundownHarness
+{
+    public:
+        /**
+         * Constructor.  Takes the Markdown files, or directories of Markdown
+         * files, to use as a parameter.
+         */
+        SundownHarness(const QStringList& paths);
+
+        /**
+         * Destructor.
+         */
+        ~SundownHarness();
+
+        /**
+         * Exports each document, or a made up book if no documents were
+         * given, to LaTeX and OpenDocument Flat XML files with the Sundown
+         * exporter and with Pandoc, and writes the time taken per export
+         * to standard output.  Returns the process exit code, which is
+         * non-zero if a Sundown export failed.
+         */
+        int runExportBenchmark();
+
+        /**
+         * Renders documents of nested lists and of nested block quotes to
+         * HTML, each with the same lines of text nested to a different
+         * depth, and writes the time taken per render and the slowdown
+         * relative to the unnested document to standard output.  Returns
+         * the process exit code, which is non-zero if any document was
+         * not rendered to its full depth.
+         */
+        int runNestingBenchmark();
+
+    private:
+        QStringList paths;
+
+        QStringList findCorpusFiles() const;
+        QString makeBook() const;
+        Exporter* findPandocExporter() const;
+        QString makeNestedDocument(bool blockquotes, int depth) const;
+        int findNestingDepth(const QString& html, const QString& tag) const;
+        double measureExportTime
+        (
+            Exporter* exporter,
+            const ExportFormat* format,
+            const QString& text,
+            const QString& outputFilePath,
+            QString& err
+        ) const;
+};
+
+#endif // SUNDOWNHARNESS_H
@@ -0,0 +1,518 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <QCoreApplication>
+#include <QMutexLocker>
+#include <QThread>
+
+#include "TaskScheduler.h"
+
+// Milliseconds to wait for each running task to stop when the application
+// exits.
+//
+#define GW_TASK_SHUTDOWN_TIMEOUT 5000
+
+/*
+ * Worker thread for the TaskScheduler.  The worker's queues and current
+ * task are guarded by the scheduler's lock.
+ */
+class TaskWorker : public QThread
+{
+    public:
+        TaskWorker(TaskScheduler* scheduler, int index)
+            : scheduler(scheduler), index(index), currentTask(NULL)
+        {
+
+        }
+
+        TaskScheduler* scheduler;
+        int index;
+        QList<ScheduledTask*> localQueues[TaskPriorityCount];
+        ScheduledTask* currentTask;
+
+    protected:
+        void run()
+        {
+            scheduler->runTasks(this);
+        }
+};
+
+TaskScheduler* TaskScheduler::instance = NULL;
+
+TaskScheduler* TaskScheduler::getInstance()
+{
+    if (NULL == instance)
+    {
+        instance = new TaskScheduler();
+        qAddPostRoutine(TaskScheduler::destroyInstance);
+    }
+
+    return instance;
+}
+
+bool TaskScheduler::isLatestRevision(const void* revisionKey, int revision) const
+{
+    QMutexLocker locker(&mutex);
+    return latestRevisions.value(revisionKey, revision) == revision;
+}
+
+void TaskScheduler::forgetRevision(const void* revisionKey)
+{
+    QMutexLocker locker(&mutex);
+    latestRevisions.remove(revisionKey);
+}
+
+void TaskScheduler::startExtraWorker()
+{
+    QMutexLocker locker(&mutex);
+
+    if (!stopping)
+    {
+        extraWorkerCount++;
+        addWorker();
+    }
+}
+
+void TaskScheduler::retireExtraWorker()
+{
+    QMutexLocker locker(&mutex);
+
+    if (!stopping && (extraWorkerCount > 0))
+    {
+        extraWorkerCount--;
+        retiringCount++;
+        taskAvailable.wakeAll();
+    }
+}
+
+TaskSchedulerStatistics TaskScheduler::getStatistics() const
+{
+    QMutexLocker locker(&mutex);
+
+    TaskSchedulerStatistics snapshot = statistics;
+    snapshot.workerCount = workers.size();
+    snapshot.extraWorkerCount = extraWorkerCount;
+    snapshot.running = 0;
+
+    for (int p = 0; p < TaskPriorityCount; p++)
+    {
+        snapshot.priorities[p].queued = sharedQueues[p].size();
+    }
+
+    foreach (TaskWorker* worker, workers)
+    {
+        if (NULL != worker->currentTask)
+        {
+            snapshot.running++;
+        }
+
+        for (int p = 0; p < TaskPriorityCount; p++)
+        {
+            snapshot.priorities[p].queued += worker->localQueues[p].size();
+        }
+    }
+
+    return snapshot;
+}
+
+CancellationToken TaskScheduler::currentCancellationToken()
+{
+    TaskWorker* worker = dynamic_cast<TaskWorker*>(QThread::currentThread());
+
+    // Only the worker itself sets its current task, so there is no need
+    // to lock in order to read it from the worker's own thread.
+    //
+    if ((NULL != worker) && (NULL != worker->currentTask))
+    {
+        return worker->currentTask->options.token;
+    }
+
+    return CancellationToken();
+}
+
+TaskScheduler::TaskScheduler()
+    : queuedCount(0), extraWorkerCount(0), retiringCount(0), stopping(false)
+{
+    clock.start();
+
+    statistics.workerCount = 0;
+    statistics.extraWorkerCount = 0;
+    statistics.running = 0;
+    statistics.stolen = 0;
+
+    for (int p = 0; p < TaskPriorityCount; p++)
+    {
+        statistics.priorities[p].queued = 0;
+        statistics.priorities[p].started = 0;
+        statistics.priorities[p].completed = 0;
+        statistics.priorities[p].cancelled = 0;
+        statistics.priorities[p].totalWaitTime = 0;
+        statistics.priorities[p].maxWaitTime = 0;
+        statistics.priorities[p].totalRunTime = 0;
+    }
+
+    // Keep at least two workers, so that a long task can't hold up
+    // everything else on single-core machines.
+    //
+    int workerCount = qMax(2, QThread::idealThreadCount());
+
+    QMutexLocker locker(&mutex);
+
+    for (int i = 0; i < workerCount; i++)
+    {
+        addWorker();
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+
+}
+
+bool TaskScheduler::shutDown()
+{
+    mutex.lock();
+    stopping = true;
+
+    // Cancel everything that hasn't started yet, and ask the running tasks
+    // to stop as soon as they can.
+    //
+    for (int p = 0; p < TaskPriorityCount; p++)
+    {
+        while (!sharedQueues[p].isEmpty())
+        {
+            ScheduledTask* task = sharedQueues[p].takeFirst();
+            task->reportCancelled();
+            delete task;
+        }
+
+        foreach (TaskWorker* worker, workers)
+        {
+            while (!worker->localQueues[p].isEmpty())
+            {
+                ScheduledTask* task = worker->localQueues[p].takeFirst();
+                task->reportCancelled();
+                delete task;
+            }
+        }
+    }
+
+    foreach (TaskWorker* worker, workers)
+    {
+        if (NULL != worker->currentTask)
+        {
+            worker->currentTask->options.token.cancel();
+        }
+    }
+
+    queuedCount = 0;
+    taskAvailable.wakeAll();
+    mutex.unlock();
+
+    // Retired workers are between tasks, so they stop right away.
+    deleteRetiredWorkers(GW_TASK_SHUTDOWN_TIMEOUT);
+
+    bool allStopped = retiredWorkers.isEmpty();
+
+    foreach (TaskWorker* worker, workers)
+    {
+        if (worker->wait(GW_TASK_SHUTDOWN_TIMEOUT))
+        {
+            delete worker;
+        }
+        else
+        {
+            allStopped = false;
+        }
+    }
+
+    if (allStopped)
+    {
+        workers.clear();
+    }
+
+    return allStopped;
+}
+
+void TaskScheduler::destroyInstance()
+{
+    // A worker that is stuck in a system call (say, on a hung network file
+    // system) would come back to a deleted scheduler, so in that case leave
+    // the scheduler for the operating system to clean up.
+    //
+    if (instance->shutDown())
+    {
+        delete instance;
+    }
+
+    instance = NULL;
+}
+
+void TaskScheduler::enqueue(ScheduledTask* task)
+{
+    QMutexLocker locker(&mutex);
+
+    if (stopping || task->options.token.isCancelled())
+    {
+        task->reportCancelled();
+        statistics.priorities[task->options.priority].cancelled++;
+        delete task;
+        return;
+    }
+
+    if (NULL != task->options.revisionKey)
+    {
+        supersede(task->options.revisionKey);
+        latestRevisions.insert(task->options.revisionKey, task->options.revision);
+    }
+
+    task->enqueueTime = clock.nsecsElapsed();
+
+    // Tasks scheduled by one of our own workers stay with that worker, so
+    // that they run on the same core as the task that spawned them unless
+    // another worker is idle and steals them.
+    //
+    TaskWorker* worker = dynamic_cast<TaskWorker*>(QThread::currentThread());
+
+    if ((NULL != worker) && (this == worker->scheduler))
+    {
+        worker->localQueues[task->options.priority].append(task);
+    }
+    else
+    {
+        sharedQueues[task->options.priority].append(task);
+    }
+
+    queuedCount++;
+    taskAvailable.wakeOne();
+}
+
+void TaskScheduler::supersede(const void* revisionKey)
+{
+    QList<QList<ScheduledTask*>*> queues;
+
+    for (int p = 0; p < TaskPriorityCount; p++)
+    {
+        queues.append(&sharedQueues[p]);
+
+        foreach (TaskWorker* worker, workers)
+        {
+            queues.append(&worker->localQueues[p]);
+        }
+    }
+
+    foreach (QList<ScheduledTask*>* queue, queues)
+    {
+        for (int i = queue->size() - 1; i >= 0; i--)
+        {
+            ScheduledTask* task = queue->at(i);
+
+            if (revisionKey == task->options.revisionKey)
+            {
+                queue->removeAt(i);
+                queuedCount--;
+                task->options.token.cancel();
+                task->reportCancelled();
+                statistics.priorities[task->options.priority].cancelled++;
+                delete task;
+            }
+        }
+    }
+
+    foreach (TaskWorker* worker, workers)
+    {
+        if
+        (
+            (NULL != worker->currentTask) &&
+            (revisionKey == worker->currentTask->options.revisionKey)
+        )
+        {
+            worker->currentTask->options.token.cancel();
+        }
+    }
+}
+
+void TaskScheduler::addWorker()
+{
+    deleteRetiredWorkers(0);
+
+    TaskWorker* worker = new TaskWorker(this, workers.size());
+    workers.append(worker);
+    worker->start();
+}
+
+void TaskScheduler::retireWorker(TaskWorker* worker)
+{
+    workers.removeAt(worker->index);
+
+    for (int i = worker->index; i < workers.size(); i++)
+    {
+        workers[i]->index = i;
+    }
+
+    // Hand the worker's own tasks over to the shared queues, where any of
+    // the remaining workers will pick them up.  They were already counted
+    // as queued.
+    //
+    for (int p = 0; p < TaskPriorityCount; p++)
+    {
+        sharedQueues[p].append(worker->localQueues[p]);
+        worker->localQueues[p].clear();
+    }
+
+    if (queuedCount > 0)
+    {
+        taskAvailable.wakeAll();
+    }
+
+    retiredWorkers.append(worker);
+}
+
+void TaskScheduler::deleteRetiredWorkers(int timeout)
+{
+    for (int i = retiredWorkers.size() - 1; i >= 0; i--)
+    {
+        if (retiredWorkers[i]->wait(timeout))
+        {
+            delete retiredWorkers.takeAt(i);
+        }
+    }
+}
+
+ScheduledTask* TaskScheduler::takeTask(TaskWorker* worker)
+{
+    for (int p = 0; p < TaskPriorityCount; p++)
+    {
+        // Newest first from our own queue...
+        if (!worker->localQueues[p].isEmpty())
+        {
+            return worker->localQueues[p].takeLast();
+        }
+
+        // ...then oldest first from the shared queue...
+        if (!sharedQueues[p].isEmpty())
+        {
+            return sharedQueues[p].takeFirst();
+        }
+
+        // ...then steal the oldest from another worker, starting with our
+        // neighbor so that the workers don't all gang up on the first one.
+        //
+        for (int i = 1; i < workers.size(); i++)
+        {
+            TaskWorker* victim = workers.at((worker->index + i) % workers.size());
+
+            if (!victim->localQueues[p].isEmpty())
+            {
+                statistics.stolen++;
+                return victim->localQueues[p].takeFirst();
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void TaskScheduler::runTasks(TaskWorker* worker)
+{
+    while (true)
+    {
+        ScheduledTask* task = NULL;
+
+        mutex.lock();
+
+        while (!stopping && (queuedCount <= 0) && (retiringCount <= 0))
+        {
+            taskAvailable.wait(&mutex);
+        }
+
+        if (stopping)
+        {
+            mutex.unlock();
+            return;
+        }
+
+        // Any worker that is between tasks can stand down in place of the
+        // extra one, since the workers are interchangeable.
+        //
+        if (retiringCount > 0)
+        {
+            retiringCount--;
+            retireWorker(worker);
+            mutex.unlock();
+            return;
+        }
+
+        task = takeTask(worker);
+
+        if (NULL == task)
+        {
+            mutex.unlock();
+            continue;
+        }
+
+        queuedCount--;
+        worker->currentTask = task;
+
+        qint64 startTime = clock.nsecsElapsed();
+        qint64 waitTime = (startTime - task->enqueueTime) / 1000;
+        TaskSchedulerStatistics::PriorityStatistics& stats =
+            statistics.priorities[task->options.priority];
+
+        stats.started++;
+        stats.totalWaitTime += waitTime;
+
+        if (waitTime > stats.maxWaitTime)
+        {
+            stats.maxWaitTime = waitTime;
+        }
+
+        mutex.unlock();
+
+        bool cancelled = task->options.token.isCancelled();
+
+        if (cancelled)
+        {
+            task->reportCancelled();
+        }
+        else
+        {
+            task->run();
+            cancelled = task->options.token.isCancelled();
+        }
+
+        mutex.lock();
+
+        if (cancelled)
+        {
+            stats.cancelled++;
+        }
+        else
+        {
+            stats.completed++;
+            stats.totalRunTime += (clock.nsecsElapsed() - startTime) / 1000;
+        }
+
+        worker->currentTask = NULL;
+        mutex.unlock();
+
+        delete task;
+    }
+}
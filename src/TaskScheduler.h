@@ -0,0 +1,648 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QFutureInterface>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "CancellationToken.h"
+
+class TaskWorker;
+
+/**
+ * Priority classes for background tasks, from highest to lowest.  Queued
+ * tasks of a higher priority class always start before those of a lower
+ * one.
+ */
+enum TaskPriority
+{
+    // Work the user is actively waiting on, such as file access that
+    // blocks the GUI.
+    TaskPriorityInteractive,
+
+    // Ordinary work, such as saves, the live HTML preview and style
+    // checks.
+    TaskPriorityNormal,
+
+    // Bulk work that nobody is waiting on, such as exports and
+    // whole-document rebuilds.
+    TaskPriorityBackground,
+
+    TaskPriorityCount
+};
+
+/**
+ * Options for scheduling a task.
+ */
+struct TaskOptions
+{
+    /**
+     * Constructor.  Creates options for a task of the given priority with
+     * a new cancellation token and no revision tag.
+     */
+    TaskOptions(TaskPriority priority = TaskPriorityNormal)
+        : priority(priority), revisionKey(NULL), revision(0)
+    {
+
+    }
+
+    TaskPriority priority;
+
+    /**
+     * Token with which the task can be cancelled.  Keep a copy of it to
+     * cancel the task later.
+     */
+    CancellationToken token;
+
+    /**
+     * Revision tag.  If the revision key is not NULL, scheduling the task
+     * supersedes all tasks previously scheduled with the same key: queued
+     * tasks are cancelled before they start, and running tasks have their
+     * tokens cancelled.  Typically, the key identifies the consumer of the
+     * results for a document, such as the HTML preview, and the revision
+     * is the revision of the document that the task will process.
+     */
+    const void* revisionKey;
+    int revision;
+};
+
+/**
+ * Snapshot of the scheduler's queue depths and latencies, for diagnostics.
+ * All times are in microseconds.
+ */
+struct TaskSchedulerStatistics
+{
+    struct PriorityStatistics
+    {
+        int queued;
+        quint64 started;
+        quint64 completed;
+        quint64 cancelled;
+        qint64 totalWaitTime;
+        qint64 maxWaitTime;
+        qint64 totalRunTime;
+    };
+
+    int workerCount;
+    int extraWorkerCount;
+    int running;
+    quint64 stolen;
+    PriorityStatistics priorities[TaskPriorityCount];
+};
+
+/**
+ * Base class for tasks run by the TaskScheduler.  Use TaskScheduler::run()
+ * rather than subclassing this directly.
+ */
+class ScheduledTask
+{
+    public:
+        ScheduledTask() : enqueueTime(0) { }
+        virtual ~ScheduledTask() { }
+
+        /**
+         * Runs the task and reports its result.
+         */
+        virtual void run() = 0;
+
+        /**
+         * Reports that the task was cancelled without running.
+         */
+        virtual void reportCancelled() = 0;
+
+        TaskOptions options;
+        qint64 enqueueTime;
+};
+
+/**
+ * Task that reports its result through a QFuture, so that callers can use
+ * a QFutureWatcher just as they would with QtConcurrent::run().
+ */
+template <class T>
+class FutureTask : public ScheduledTask
+{
+    public:
+        FutureTask()
+        {
+            futureInterface.reportStarted();
+        }
+
+        QFuture<T> future()
+        {
+            return futureInterface.future();
+        }
+
+        void run()
+        {
+            T result = call();
+
+            // A task cancelled while running may have returned early, so
+            // don't report what could be a partial result.
+            //
+            if (options.token.isCancelled())
+            {
+                futureInterface.reportCanceled();
+            }
+            else
+            {
+                futureInterface.reportResult(result);
+            }
+
+            futureInterface.reportFinished();
+        }
+
+        void reportCancelled()
+        {
+            futureInterface.reportCanceled();
+            futureInterface.reportFinished();
+        }
+
+    protected:
+        virtual T call() = 0;
+
+    private:
+        QFutureInterface<T> futureInterface;
+};
+
+/**
+ * Application-wide scheduler for background work.
+ *
+ * Tasks are queued by priority class, and run on a fixed pool of worker
+ * threads.  Tasks scheduled from the GUI thread go into a shared queue for
+ * each priority class.  Tasks scheduled from a worker (for example, to
+ * split a large job into pieces) go into that worker's own queue, from
+ * which it takes the newest task first to keep its data warm in the cache.
+ * Idle workers steal the oldest tasks from other workers' queues.  Within
+ * each priority class, a worker looks at its own queue, then the shared
+ * queue, and then the other workers' queues before moving on to the next
+ * class.
+ *
+ * The queues are guarded by a single lock.  Tasks are coarse-grained
+ * (rendering a preview, checking a batch of blocks), so the lock is held
+ * for a tiny fraction of the time that tasks spend running.
+ *
+ * Results are reported through QFuture, so a QFutureWatcher can be used to
+ * be notified of results on the GUI thread.  Tasks that are cancelled or
+ * superseded report a cancelled future, for which no result is available.
+ * Always check QFuture::isCanceled() before taking the result.
+ */
+class TaskScheduler
+{
+    public:
+        /**
+         * Gets the single instance of this class.  The instance is shut
+         * down when the application exits.
+         */
+        static TaskScheduler* getInstance();
+
+        /**
+         * Runs the given function with the given arguments on a worker
+         * thread, with the given options, and returns a future for its
+         * result.  Overloads are provided for static functions and const
+         * member functions of up to three parameters.  The arguments are
+         * copied, so they must be safe to use from the worker thread.
+         */
+        template <class T>
+        QFuture<T> run(const TaskOptions& options, T (*function)());
+
+        template <class T, class Param1, class Arg1>
+        QFuture<T> run
+        (
+            const TaskOptions& options,
+            T (*function)(Param1),
+            const Arg1& arg1
+        );
+
+        template <class T, class Param1, class Arg1, class Param2, class Arg2>
+        QFuture<T> run
+        (
+            const TaskOptions& options,
+            T (*function)(Param1, Param2),
+            const Arg1& arg1,
+            const Arg2& arg2
+        );
+
+        template <class T, class Param1, class Arg1, class Param2, class Arg2, class Param3, class Arg3>
+        QFuture<T> run
+        (
+            const TaskOptions& options,
+            T (*function)(Param1, Param2, Param3),
+            const Arg1& arg1,
+            const Arg2& arg2,
+            const Arg3& arg3
+        );
+
+        template <class T, class Class>
+        QFuture<T> run
+        (
+            const TaskOptions& options,
+            const Class* object,
+            T (Class::*function)() const
+        );
+
+        template <class T, class Class, class Param1, class Arg1>
+        QFuture<T> run
+        (
+            const TaskOptions& options,
+            const Class* object,
+            T (Class::*function)(Param1) const,
+            const Arg1& arg1
+        );
+
+        template <class T, class Class, class Param1, class Arg1, class Param2, class Arg2>
+        QFuture<T> run
+        (
+            const TaskOptions& options,
+            const Class* object,
+            T (Class::*function)(Param1, Param2) const,
+            const Arg1& arg1,
+            const Arg2& arg2
+        );
+
+        template <class T, class Class, class Param1, class Arg1, class Param2, class Arg2, class Param3, class Arg3>
+        QFuture<T> run
+        (
+            const TaskOptions& options,
+            const Class* object,
+            T (Class::*function)(Param1, Param2, Param3) const,
+            const Arg1& arg1,
+            const Arg2& arg2,
+            const Arg3& arg3
+        );
+
+        /**
+         * Returns true if the given revision is the latest one scheduled
+         * with the given revision key.  Use this to discard stale results.
+         */
+        bool isLatestRevision(const void* revisionKey, int revision) const;
+
+        /**
+         * Forgets the latest revision scheduled with the given key.  Call
+         * this when the owner of the key is destroyed.
+         */
+        void forgetRevision(const void* revisionKey);
+
+        /**
+         * Starts an extra worker thread to take the place of one that is
+         * blocked indefinitely, such as in a system call on a hung network
+         * file system, so that other tasks aren't starved.  Call
+         * retireExtraWorker() once the blocked task returns.
+         */
+        void startExtraWorker();
+
+        /**
+         * Stops one of the workers started by startExtraWorker() as soon as
+         * it is between tasks.  Its queued tasks are handed over to the
+         * remaining workers.
+         */
+        void retireExtraWorker();
+
+        /**
+         * Returns a snapshot of the queue depths and latencies.
+         */
+        TaskSchedulerStatistics getStatistics() const;
+
+        /**
+         * Returns the cancellation token of the task running on the calling
+         * thread.  See CancellationToken::current().
+         */
+        static CancellationToken currentCancellationToken();
+
+    private:
+        friend class TaskWorker;
+
+        static TaskScheduler* instance;
+
+        mutable QMutex mutex;
+        QWaitCondition taskAvailable;
+        QList<TaskWorker*> workers;
+
+        // Workers that have stopped or are about to stop after being
+        // retired, to be deleted once their threads have finished.
+        //
+        QList<TaskWorker*> retiredWorkers;
+        QList<ScheduledTask*> sharedQueues[TaskPriorityCount];
+        QHash<const void*, int> latestRevisions;
+        QElapsedTimer clock;
+        int queuedCount;
+        int extraWorkerCount;
+        int retiringCount;
+        bool stopping;
+        TaskSchedulerStatistics statistics;
+
+        TaskScheduler();
+        ~TaskScheduler();
+
+        static void destroyInstance();
+
+        /*
+         * Cancels all tasks and stops the workers.  Returns false if any
+         * worker failed to stop in time.
+         */
+        bool shutDown();
+
+        void enqueue(ScheduledTask* task);
+        void supersede(const void* revisionKey);
+        void addWorker();
+        void retireWorker(TaskWorker* worker);
+        void deleteRetiredWorkers(int timeout);
+        ScheduledTask* takeTask(TaskWorker* worker);
+        void runTasks(TaskWorker* worker);
+};
+
+/*
+ * Tasks that store a function and its arguments.
+ */
+
+template <class T, class Function>
+class FunctionTask0 : public FutureTask<T>
+{
+    public:
+        FunctionTask0(Function function)
+            : function(function) { }
+
+    protected:
+        T call() { return function(); }
+
+    private:
+        Function function;
+};
+
+template <class T, class Function, class Arg1>
+class FunctionTask1 : public FutureTask<T>
+{
+    public:
+        FunctionTask1(Function function, const Arg1& arg1)
+            : function(function), arg1(arg1) { }
+
+    protected:
+        T call() { return function(arg1); }
+
+    private:
+        Function function;
+        Arg1 arg1;
+};
+
+template <class T, class Function, class Arg1, class Arg2>
+class FunctionTask2 : public FutureTask<T>
+{
+    public:
+        FunctionTask2(Function function, const Arg1& arg1, const Arg2& arg2)
+            : function(function), arg1(arg1), arg2(arg2) { }
+
+    protected:
+        T call() { return function(arg1, arg2); }
+
+    private:
+        Function function;
+        Arg1 arg1;
+        Arg2 arg2;
+};
+
+template <class T, class Function, class Arg1, class Arg2, class Arg3>
+class FunctionTask3 : public FutureTask<T>
+{
+    public:
+        FunctionTask3(Function function, const Arg1& arg1, const Arg2& arg2, const Arg3& arg3)
+            : function(function), arg1(arg1), arg2(arg2), arg3(arg3) { }
+
+    protected:
+        T call() { return function(arg1, arg2, arg3); }
+
+    private:
+        Function function;
+        Arg1 arg1;
+        Arg2 arg2;
+        Arg3 arg3;
+};
+
+template <class T, class Class, class Function>
+class MemberFunctionTask0 : public FutureTask<T>
+{
+    public:
+        MemberFunctionTask0(const Class* object, Function function)
+            : object(object), function(function) { }
+
+    protected:
+        T call() { return (object->*function)(); }
+
+    private:
+        const Class* object;
+        Function function;
+};
+
+template <class T, class Class, class Function, class Arg1>
+class MemberFunctionTask1 : public FutureTask<T>
+{
+    public:
+        MemberFunctionTask1(const Class* object, Function function, const Arg1& arg1)
+            : object(object), function(function), arg1(arg1) { }
+
+    protected:
+        T call() { return (object->*function)(arg1); }
+
+    private:
+        const Class* object;
+        Function function;
+        Arg1 arg1;
+};
+
+template <class T, class Class, class Function, class Arg1, class Arg2>
+class MemberFunctionTask2 : public FutureTask<T>
+{
+    public:
+        MemberFunctionTask2(const Class* object, Function function, const Arg1& arg1, const Arg2& arg2)
+            : object(object), function(function), arg1(arg1), arg2(arg2) { }
+
+    protected:
+        T call() { return (object->*function)(arg1, arg2); }
+
+    private:
+        const Class* object;
+        Function function;
+        Arg1 arg1;
+        Arg2 arg2;
+};
+
+template <class T, class Class, class Function, class Arg1, class Arg2, class Arg3>
+class MemberFunctionTask3 : public FutureTask<T>
+{
+    public:
+        MemberFunctionTask3(const Class* object, Function function, const Arg1& arg1, const Arg2& arg2, const Arg3& arg3)
+            : object(object), function(function), arg1(arg1), arg2(arg2), arg3(arg3) { }
+
+    protected:
+        T call() { return (object->*function)(arg1, arg2, arg3); }
+
+    private:
+        const Class* object;
+        Function function;
+        Arg1 arg1;
+        Arg2 arg2;
+        Arg3 arg3;
+};
+
+/*
+ * Since enqueue() may cancel and delete a task straight away, get the
+ * task's future before enqueueing it.
+ */
+
+template <class T>
+QFuture<T> TaskScheduler::run(const TaskOptions& options, T (*function)())
+{
+    FutureTask<T>* task = new FunctionTask0<T, T (*)()>(function);
+    task->options = options;
+    QFuture<T> future = task->future();
+    enqueue(task);
+    return future;
+}
+
+template <class T, class Param1, class Arg1>
+QFuture<T> TaskScheduler::run
+(
+    const TaskOptions& options,
+    T (*function)(Param1),
+    const Arg1& arg1
+)
+{
+    FutureTask<T>* task = new FunctionTask1<T, T (*)(Param1), Arg1>(function, arg1);
+    task->options = options;
+    QFuture<T> future = task->future();
+    enqueue(task);
+    return future;
+}
+
+template <class T, class Param1, class Arg1, class Param2, class Arg2>
+QFuture<T> TaskScheduler::run
+(
+    const TaskOptions& options,
+    T (*function)(Param1, Param2),
+    const Arg1& arg1,
+    const Arg2& arg2
+)
+{
+    FutureTask<T>* task =
+        new FunctionTask2<T, T (*)(Param1, Param2), Arg1, Arg2>(function, arg1, arg2);
+    task->options = options;
+    QFuture<T> future = task->future();
+    enqueue(task);
+    return future;
+}
+
+template <class T, class Param1, class Arg1, class Param2, class Arg2, class Param3, class Arg3>
+QFuture<T> TaskScheduler::run
+(
+    const TaskOptions& options,
+    T (*function)(Param1, Param2, Param3),
+    const Arg1& arg1,
+    const Arg2& arg2,
+    const Arg3& arg3
+)
+{
+    FutureTask<T>* task =
+        new FunctionTask3<T, T (*)(Param1, Param2, Param3), Arg1, Arg2, Arg3>
+            (function, arg1, arg2, arg3);
+    task->options = options;
+    QFuture<T> future = task->future();
+    enqueue(task);
+    return future;
+}
+
+template <class T, class Class>
+QFuture<T> TaskScheduler::run
+(
+    const TaskOptions& options,
+    const Class* object,
+    T (Class::*function)() const
+)
+{
+    FutureTask<T>* task =
+        new MemberFunctionTask0<T, Class, T (Class::*)() const>(object, function);
+    task->options = options;
+    QFuture<T> future = task->future();
+    enqueue(task);
+    return future;
+}
+
+template <class T, class Class, class Param1, class Arg1>
+QFuture<T> TaskScheduler::run
+(
+    const TaskOptions& options,
+    const Class* object,
+    T (Class::*function)(Param1) const,
+    const Arg1& arg1
+)
+{
+    FutureTask<T>* task =
+        new MemberFunctionTask1<T, Class, T (Class::*)(Param1) const, Arg1>
+            (object, function, arg1);
+    task->options = options;
+    QFuture<T> future = task->future();
+    enqueue(task);
+    return future;
+}
+
+template <class T, class Class, class Param1, class Arg1, class Param2, class Arg2>
+QFuture<T> TaskScheduler::run
+(
+    const TaskOptions& options,
+    const Class* object,
+    T (Class::*function)(Param1, Param2) const,
+    const Arg1& arg1,
+    const Arg2& arg2
+)
+{
+    FutureTask<T>* task =
+        new MemberFunctionTask2<T, Class, T (Class::*)(Param1, Param2) const, Arg1, Arg2>
+            (object, function, arg1, arg2);
+    task->options = options;
+    QFuture<T> future = task->future();
+    enqueue(task);
+    return future;
+}
+
+template <class T, class Class, class Param1, class Arg1, class Param2, class Arg2, class Param3, class Arg3>
+QFuture<T> TaskScheduler::run
+(
+    const TaskOptions& options,
+    const Class* object,
+    T (Class::*function)(Param1, Param2, Param3) const,
+    const Arg1& arg1,
+    const Arg2& arg2,
+    const Arg3& arg3
+)
+{
+    FutureTask<T>* task =
+        new MemberFunctionTask3<T, Class, T (Class::*)(Param1, Param2, Param3) const, Arg1, Arg2, Arg3>
+            (object, function, arg1, arg2, arg3);
+    task->options = options;
+    QFuture<T> future = task->future();
+    enqueue(task);
+    return future;
+}
+
+#endif // TASKSCHEDULER_H
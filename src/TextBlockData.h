@@ -20,8 +20,14 @@
 #ifndef TEXTBLOCKDATA_H
 #define TEXTBLOCKDATA_H
 
+#include <QChar>
+#include <QList>
+#include <QString>
 #include <QTextBlockUserData>
 
+#include "MarkdownLintTypes.h"
+#include "StyleChecker.h"
+
 /**
  * User data for use with the QSyntaxHighlighter.
  */
@@ -30,11 +36,16 @@ class TextBlockData : public QTextBlockUserData
     public:
         TextBlockData()
         {
-            wordCount = 0;
-            alphaNumericCharacterCount = 0;
-            sentenceCount = 0;
-            lixLongWordCount = 0;
-            blankLine = true;
+            misspellingCount = 0;
+            styleCheckRequested = false;
+            styleCheckHash = 0;
+            styleCheckId = 0;
+            headingLevel = 0;
+            listIndent = -1;
+            tableColumnCount = 0;
+            untaggedCodeFence = false;
+            imagePreviewHeight = 0;
+            paintCacheId = 0;
         }
 
         virtual ~TextBlockData()
@@ -42,11 +53,41 @@ class TextBlockData : public QTextBlockUserData
             ;
         }
 
-        int wordCount;
-        int alphaNumericCharacterCount;
-        int sentenceCount;
-        int lixLongWordCount;
-        bool blankLine;
+        // Number of misspelled words found by the live spell checker.
+        int misspellingCount;
+
+        // Live style check results, which are valid for the block text
+        // whose hash is styleCheckHash.  The MarkdownHighlighter gives each
+        // style check request a new ID, by which its result finds the block
+        // even if the block has moved since.
+        //
+        bool styleCheckRequested;
+        uint styleCheckHash;
+        uint styleCheckId;
+        QList<StyleIssue> styleIssues;
+
+        // Structural facts recorded by the MarkdownLinter, and the lint
+        // diagnostics derived from them.  A listIndent of -1 means that
+        // the block is not a list item.
+        //
+        int headingLevel;
+        QChar listMarker;
+        int listIndent;
+        int tableColumnCount;
+        bool untaggedCodeFence;
+        QList<MarkdownLintDiagnostic> lintDiagnostics;
+
+        // Destination of the first inline image in the block, as written
+        // in the Markdown text, and the height of the space reserved for
+        // its preview beneath the block by the TextDocumentLayout.
+        //
+        QString imageDestination;
+        int imagePreviewHeight;
+
+        // Key of the block's rendered text in the editor's paint cache, or
+        // zero if the block was never cached.
+        //
+        int paintCacheId;
 };
 
 #endif // TEXTBLOCKDATA_H
@@ -18,28 +18,50 @@
  ***********************************************************************/
 
 #include <QString>
+#include <QTextBlock>
 #include <QTextDocument>
-#include <QPlainTextDocumentLayout>
+#include <QTextLayout>
 #include <QFileInfo>
 
 #include "TextDocument.h"
+#include "TextDocumentLayout.h"
+#include "TextBlockData.h"
+
+// Estimated size of the bookkeeping for a single undo step, not counting
+// the text of the edit.
+//
+#define GW_MEMORY_UNDO_STEP_BYTES 64
 
 TextDocument::TextDocument(QObject* parent)
     : QTextDocument(parent)
 {
-    QPlainTextDocumentLayout* documentLayout =
-        new QPlainTextDocumentLayout(this);
+    TextDocumentLayout* documentLayout = new TextDocumentLayout(this);
     this->setDocumentLayout(documentLayout);
 
     filePath = QString();
     readOnlyFlag = false;
     displayName = tr("untitled");
     timestamp = QDateTime::currentDateTime();
+    undoStepCount = 0;
+    undoCommandPending = false;
+
+    connect
+    (
+        this,
+        SIGNAL(contentsChange(int,int,int)),
+        this,
+        SLOT(onContentsChange(int,int,int))
+    );
+    connect(this, SIGNAL(undoCommandAdded()), this, SLOT(onUndoCommandAdded()));
+    connect(this, SIGNAL(undoAvailable(bool)), this, SLOT(onUndoRedoAvailable()));
+    connect(this, SIGNAL(redoAvailable(bool)), this, SLOT(onUndoRedoAvailable()));
+
+    MemoryAccounting::getInstance()->addAccountable(this);
 }
 
 TextDocument::~TextDocument()
 {
-
+    MemoryAccounting::getInstance()->removeAccountable(this);
 }
 
 QString TextDocument::getDisplayName() const
@@ -95,3 +117,116 @@ void TextDocument::setTimestamp(const QDateTime& timestamp)
 {
     this->timestamp = timestamp;
 }
+
+void TextDocument::accountMemory(QList<MemoryUsage>& usage) const
+{
+    MemoryUsage text
+    (
+        GW_MEMORY_DOCUMENT_TEXT,
+        this->blockCount(),
+        this->characterCount() * sizeof(QChar)
+    );
+    MemoryUsage undoHistory(GW_MEMORY_UNDO_HISTORY);
+    MemoryUsage blockData(GW_MEMORY_TEXT_BLOCK_DATA);
+    MemoryUsage formats(GW_MEMORY_HIGHLIGHT_FORMATS);
+
+    if (this->isUndoAvailable() || this->isRedoAvailable())
+    {
+        qint64 undoHistoryCharacters = 0;
+
+        for (int i = 0; i < undoStepCharacters.size(); i++)
+        {
+            undoHistoryCharacters += undoStepCharacters[i];
+        }
+
+        undoHistory.objectCount =
+            this->availableUndoSteps() + this->availableRedoSteps();
+        undoHistory.estimatedBytes =
+            (undoHistory.objectCount * GW_MEMORY_UNDO_STEP_BYTES)
+            + (undoHistoryCharacters * sizeof(QChar));
+    }
+
+    for (QTextBlock block = this->begin(); block.isValid(); block = block.next())
+    {
+        TextBlockData* data = (TextBlockData*) block.userData();
+
+        if (NULL != data)
+        {
+            blockData.objectCount++;
+            blockData.estimatedBytes += sizeof(TextBlockData)
+                + (data->styleIssues.size() * sizeof(StyleIssue))
+                + (data->lintDiagnostics.size() * sizeof(MarkdownLintDiagnostic))
+                + (data->imageDestination.capacity() * sizeof(QChar));
+        }
+
+        if (NULL != block.layout())
+        {
+            // Formats of the same style share their properties, so only
+            // the ranges themselves are counted.
+            //
+            int rangeCount = block.layout()->additionalFormats().size();
+
+            formats.objectCount += rangeCount;
+            formats.estimatedBytes += rangeCount * sizeof(QTextLayout::FormatRange);
+        }
+    }
+
+    usage << text << undoHistory << blockData << formats;
+}
+
+void TextDocument::onContentsChange(int position, int charsRemoved, int charsAdded)
+{
+    Q_UNUSED(position);
+
+    int undoSteps = this->availableUndoSteps();
+    int redoSteps = this->availableRedoSteps();
+
+    if (undoCommandPending && (undoSteps > 0))
+    {
+        // The edit was pushed onto the undo stack as a new step, which
+        // discarded any steps that could have been redone.
+        //
+        undoStepCharacters.resize(qMin(undoStepCount, undoStepCharacters.size()));
+        undoStepCharacters.resize(undoSteps);
+        undoStepCharacters[undoSteps - 1] += charsRemoved + charsAdded;
+    }
+    else if
+    (
+        (undoSteps == undoStepCount)
+        && (undoSteps > 0)
+        && (charsRemoved != charsAdded)
+    )
+    {
+        // The edit was merged into the last step, as happens when typing.
+        // Changes that leave the undo stack as it was and neither add nor
+        // remove characters are formatting done by the highlighter, which
+        // does not go into the undo history.
+        //
+        undoStepCharacters.resize(undoSteps);
+        undoStepCharacters[undoSteps - 1] += charsRemoved + charsAdded;
+    }
+
+    // Undoing or redoing only moves the boundary between the stacks.  Keep
+    // one entry per step should the stacks have changed some other way.
+    //
+    undoStepCharacters.resize(undoSteps + redoSteps);
+    undoStepCount = undoSteps;
+    undoCommandPending = false;
+}
+
+void TextDocument::onUndoCommandAdded()
+{
+    // The document announces a new undo step before the change that
+    // made it.
+    //
+    undoCommandPending = true;
+}
+
+void TextDocument::onUndoRedoAvailable()
+{
+    if (!this->isUndoAvailable() && !this->isRedoAvailable())
+    {
+        undoStepCharacters.clear();
+        undoStepCount = 0;
+    }
+}
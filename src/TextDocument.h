@@ -23,12 +23,16 @@
 #include <QTextDocument>
 #include <QString>
 #include <QDateTime>
+#include <QVector>
+
+#include "MemoryAccounting.h"
 
 /**
  * Text document that maintains timestamp, read-only state, and new vs.
- * saved status.
+ * saved status.  The document accounts for the memory held by its text,
+ * undo history, block user data, and highlighting formats.
  */
-class TextDocument : public QTextDocument
+class TextDocument : public QTextDocument, public MemoryAccountable
 {
     Q_OBJECT
 
@@ -86,17 +90,37 @@ class TextDocument : public QTextDocument
          */
         void setTimestamp(const QDateTime& timestamp);
 
+        /**
+         * Appends the memory held by the document to the given list.
+         */
+        void accountMemory(QList<MemoryUsage>& usage) const;
+
     signals:
         /**
          * Emitted when the file path changes.
          */
         void filePathChanged();
 
+    private slots:
+        void onContentsChange(int position, int charsRemoved, int charsAdded);
+        void onUndoCommandAdded();
+        void onUndoRedoAvailable();
+
     private:
         QString displayName;
         QString filePath;
         bool readOnlyFlag;
         QDateTime timestamp;
+
+        // Number of characters inserted or removed by each step on the undo
+        // and redo stacks, oldest first.  The document keeps the text of
+        // each edit around for as long as it can be undone or redone.
+        // Undoing and redoing only move between the steps, so the number of
+        // undo steps is remembered to tell them apart from new edits.
+        //
+        QVector<qint64> undoStepCharacters;
+        int undoStepCount;
+        bool undoCommandPending;
 };
 
 #endif // MARKUPDOCUMENT_H
@@ -0,0 +1,263 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <math.h>
+
+#include <QFontMetricsF>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QTextLayout>
+#include <QVector>
+
+#include "TextBlockData.h"
+#include "TextDocumentLayout.h"
+
+TextDocumentLayout::TextDocumentLayout(QTextDocument* document)
+    : QPlainTextDocumentLayout(document),
+    indexedTextWidth(-1),
+    indexValid(false)
+{
+
+}
+
+TextDocumentLayout::~TextDocumentLayout()
+{
+
+}
+
+QRectF TextDocumentLayout::blockBoundingRect(const QTextBlock& block) const
+{
+    QRectF rect = QPlainTextDocumentLayout::blockBoundingRect(block);
+    TextBlockData* blockData = (TextBlockData*) block.userData();
+
+    if (!rect.isNull() && (NULL != blockData) && (blockData->imagePreviewHeight > 0))
+    {
+        rect.adjust(0, 0, 0, blockData->imagePreviewHeight);
+    }
+
+    // The base class lays out the block if needed, so its actual height
+    // is known now.
+    //
+    if (indexValid && block.isValid())
+    {
+        updateBlockHeight(block.blockNumber(), qRound(rect.height()));
+    }
+
+    return rect;
+}
+
+int TextDocumentLayout::blockTop(int blockNumber) const
+{
+    ensureIndex();
+    return blockHeights.prefixSum(blockNumber);
+}
+
+int TextDocumentLayout::blockNumberAt(int y) const
+{
+    ensureIndex();
+
+    if (blockHeights.size() <= 0)
+    {
+        return 0;
+    }
+
+    // The blocks that end at or above y come before the block at y.
+    return qMin(blockHeights.upperBound(qMax(0, y)), blockHeights.size() - 1);
+}
+
+int TextDocumentLayout::lineNumberAt(int y, int* lineTop) const
+{
+    QTextBlock block = document()->findBlockByNumber(blockNumberAt(y));
+
+    if (!block.isValid())
+    {
+        if (NULL != lineTop)
+        {
+            *lineTop = 0;
+        }
+
+        return 0;
+    }
+
+    int top = blockTop(block.blockNumber());
+    int line = 0;
+
+    if (NULL != block.layout())
+    {
+        for (int i = block.layout()->lineCount() - 1; i > 0; i--)
+        {
+            int lineY = top + qRound(block.layout()->lineAt(i).y());
+
+            if (lineY <= y)
+            {
+                line = i;
+                top = lineY;
+                break;
+            }
+        }
+    }
+
+    if (NULL != lineTop)
+    {
+        *lineTop = top;
+    }
+
+    return block.firstLineNumber() + line;
+}
+
+int TextDocumentLayout::documentHeight() const
+{
+    ensureIndex();
+    return blockHeights.total();
+}
+
+void TextDocumentLayout::imagePreviewHeightChanged(const QTextBlock& block)
+{
+    if (indexValid && block.isValid())
+    {
+        updateBlockHeight(block.blockNumber(), blockHeight(block));
+    }
+
+    // The base class measures the document size in lines, which a preview
+    // does not change, so signal the new size regardless for the views that
+    // measure the document in pixels, such as the annotated scroll bar.
+    //
+    emit documentSizeChanged(documentSize());
+    requestUpdate();
+}
+
+void TextDocumentLayout::documentChanged(int from, int charsRemoved, int charsAdded)
+{
+    QTextBlock block = document()->findBlock(from);
+
+    // Of the blocks spanned by the change, only the first one existed
+    // before it, so splice any inserted or removed blocks in after that
+    // one.  This is done before the base class lays out the changed
+    // blocks, so that the heights it reports go to the right blocks.
+    //
+    if (indexValid && block.isValid())
+    {
+        int blockCountDelta = document()->blockCount() - blockHeights.size();
+
+        if (blockCountDelta > 0)
+        {
+            blockHeights.insert(block.blockNumber() + 1, blockCountDelta);
+        }
+        else if (blockCountDelta < 0)
+        {
+            blockHeights.remove(block.blockNumber() + 1, -blockCountDelta);
+        }
+    }
+
+    QPlainTextDocumentLayout::documentChanged(from, charsRemoved, charsAdded);
+
+    if (!indexValid || !block.isValid())
+    {
+        return;
+    }
+
+    QTextBlock last = document()->findBlock
+        (
+            qMin(from + charsAdded, document()->characterCount() - 1)
+        );
+
+    while (block.isValid())
+    {
+        updateBlockHeight(block.blockNumber(), blockHeight(block));
+
+        if (block == last)
+        {
+            break;
+        }
+
+        block = block.next();
+    }
+}
+
+void TextDocumentLayout::ensureIndex() const
+{
+    if (indexValid && (textWidth() == indexedTextWidth))
+    {
+        return;
+    }
+
+    QVector<int> heights(document()->blockCount());
+    QTextBlock block = document()->begin();
+
+    for (int i = 0; (i < heights.size()) && block.isValid(); i++)
+    {
+        heights[i] = blockHeight(block);
+        block = block.next();
+    }
+
+    blockHeights.reset(heights);
+    indexedTextWidth = textWidth();
+    indexValid = true;
+}
+
+int TextDocumentLayout::blockHeight(const QTextBlock& block) const
+{
+    if (!block.isVisible())
+    {
+        return 0;
+    }
+
+    TextBlockData* blockData = (TextBlockData*) block.userData();
+    int previewHeight = 0;
+
+    if ((NULL != blockData) && (blockData->imagePreviewHeight > 0))
+    {
+        previewHeight = blockData->imagePreviewHeight;
+    }
+
+    QTextLayout* layout = block.layout();
+
+    if ((NULL != layout) && (layout->lineCount() > 0))
+    {
+        return qRound(layout->boundingRect().height()) + previewHeight;
+    }
+
+    // Estimate the number of lines that the text will wrap to with the
+    // default font, without laying it out.
+    //
+    QFontMetricsF metrics(document()->defaultFont());
+    int lineCount = 1;
+
+    if (textWidth() > 0)
+    {
+        lineCount = qMax
+            (
+                1,
+                (int) ceil((block.length() * metrics.averageCharWidth()) / textWidth())
+            );
+    }
+
+    return qRound(lineCount * metrics.lineSpacing()) + previewHeight;
+}
+
+void TextDocumentLayout::updateBlockHeight(int blockNumber, int height) const
+{
+    if ((blockNumber < 0) || (blockNumber >= blockHeights.size()))
+    {
+        return;
+    }
+
+    blockHeights.setValue(blockNumber, height);
+}
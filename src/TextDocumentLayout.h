@@ -0,0 +1,114 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef TEXTDOCUMENTLAYOUT_H
+#define TEXTDOCUMENTLAYOUT_H
+
+#include <QPlainTextDocumentLayout>
+
+#include "SumTree.h"
+
+/**
+ * Plain text document layout that leaves room beneath a block for an image
+ * preview whenever the block's TextBlockData has a non-zero preview height.
+ * The editor paints the preview into the space it reserves.
+ *
+ * The layout also keeps an index of the height of each block in pixels,
+ * so that positions can be mapped to and from y coordinates in logarithmic
+ * time.  Blocks inserted or removed as the user types are spliced into the
+ * index in place.  QPlainTextDocumentLayout only lays out blocks as they
+ * are needed, so the heights of blocks that have not been laid out yet are
+ * estimated from their length, and replaced with their actual heights as
+ * soon as they are laid out.
+ */
+class TextDocumentLayout : public QPlainTextDocumentLayout
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.
+         */
+        TextDocumentLayout(QTextDocument* document);
+
+        /**
+         * Destructor.
+         */
+        virtual ~TextDocumentLayout();
+
+        /**
+         * Overridden to add the block's image preview height to the height
+         * of its text.
+         */
+        QRectF blockBoundingRect(const QTextBlock& block) const;
+
+        /**
+         * Returns the distance in pixels from the top of the document to
+         * the top of the block with the given number.
+         */
+        int blockTop(int blockNumber) const;
+
+        /**
+         * Returns the number of the block at the given distance in pixels
+         * from the top of the document.
+         */
+        int blockNumberAt(int y) const;
+
+        /**
+         * Returns the number of the line at the given distance in pixels
+         * from the top of the document, counting lines from the start of
+         * the document the way the vertical scroll bar of QPlainTextEdit
+         * does.  A point within an image preview belongs to the last line
+         * of its block.  If lineTop is not NULL, it is set to the distance
+         * in pixels from the top of the document to the top of the line.
+         */
+        int lineNumberAt(int y, int* lineTop = NULL) const;
+
+        /**
+         * Returns the height of the document in pixels, as indexed.
+         */
+        int documentHeight() const;
+
+        /**
+         * Measures the given block again after its image preview height
+         * has changed, and has the views of the document update their
+         * scroll range and repaint, without marking the text of the block
+         * as changed.
+         */
+        void imagePreviewHeightChanged(const QTextBlock& block);
+
+    protected:
+        void documentChanged(int from, int charsRemoved, int charsAdded);
+
+    private:
+        // Height of each block in pixels, and the text width for which the
+        // heights were indexed.  The index is rebuilt whenever the text is
+        // rewrapped.
+        //
+        mutable SumTree<int> blockHeights;
+        mutable qreal indexedTextWidth;
+        mutable bool indexValid;
+
+        void ensureIndex() const;
+        int blockHeight(const QTextBlock& block) const;
+        void updateBlockHeight(int blockNumber, int height) const;
+};
+
+#endif // TEXTDOCUMENTLAYOUT_H
@@ -0,0 +1,192 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QThread>
+
+#include "WritingHistory.h"
+
+WritingHistory::WritingHistory(const QString& directoryPath, QObject* parent)
+    : QObject(parent),
+      closed(false),
+      documentId(0),
+      pendingMinute(0),
+      pendingWords(0),
+      pendingActiveSeconds(0),
+      pendingIdleSeconds(0)
+{
+    qRegisterMetaType<WritingHistorySummary>("WritingHistorySummary");
+
+    workerThread = new QThread(this);
+    log = new WritingHistoryLog(directoryPath);
+    log->moveToThread(workerThread);
+
+    connect(log, SIGNAL(summaryReady(WritingHistorySummary)), this, SIGNAL(historyAvailable(WritingHistorySummary)));
+
+    workerThread->start();
+    QMetaObject::invokeMethod(log, "open", Qt::QueuedConnection);
+}
+
+WritingHistory::~WritingHistory()
+{
+    close();
+}
+
+void WritingHistory::close()
+{
+    if (closed)
+    {
+        return;
+    }
+
+    flushPendingSample();
+
+    // Wait for the samples that are still queued to be written before
+    // stopping the thread.
+    //
+    QMetaObject::invokeMethod(log, "close", Qt::BlockingQueuedConnection);
+
+    workerThread->quit();
+    workerThread->wait();
+
+    delete log;
+    log = NULL;
+    closed = true;
+}
+
+void WritingHistory::setDocumentPath(const QString& filePath)
+{
+    quint32 newDocumentId = documentIdForPath(filePath);
+
+    if (newDocumentId != documentId)
+    {
+        flushPendingSample();
+        documentId = newDocumentId;
+        requestHistory();
+    }
+}
+
+void WritingHistory::onActivityRecorded(int wordsWritten, bool idle)
+{
+    quint32 minute = QDateTime::currentDateTime().toUTC().toTime_t() / 60;
+
+    if (minute != pendingMinute)
+    {
+        flushPendingSample();
+        pendingMinute = minute;
+    }
+
+    pendingWords += wordsWritten;
+
+    if (idle)
+    {
+        pendingIdleSeconds = qMin(60, pendingIdleSeconds + 1);
+    }
+    else
+    {
+        pendingActiveSeconds = qMin(60, pendingActiveSeconds + 1);
+    }
+}
+
+void WritingHistory::requestHistory()
+{
+    if (!closed)
+    {
+        QMetaObject::invokeMethod
+        (
+            log,
+            "requestSummary",
+            Qt::QueuedConnection,
+            Q_ARG(uint, documentId)
+        );
+    }
+}
+
+void WritingHistory::flushPendingSample()
+{
+    // Only minutes during which the writer was actually at work are
+    // recorded.  Otherwise, leaving the application open overnight would
+    // fill the log with idle time.
+    //
+    if (!closed && ((pendingActiveSeconds > 0) || (pendingWords > 0)))
+    {
+        WritingSample sample;
+        sample.utcMinute = pendingMinute;
+        sample.documentId = documentId;
+        sample.words = pendingWords;
+        sample.activeSeconds = (quint8) pendingActiveSeconds;
+        sample.idleSeconds = (quint8) pendingIdleSeconds;
+        sample.utcOffsetMinutes = currentUtcOffsetMinutes();
+
+        QMetaObject::invokeMethod
+        (
+            log,
+            "appendSample",
+            Qt::QueuedConnection,
+            Q_ARG(QByteArray, sample.encode())
+        );
+
+        requestHistory();
+    }
+
+    pendingWords = 0;
+    pendingActiveSeconds = 0;
+    pendingIdleSeconds = 0;
+}
+
+quint32 WritingHistory::documentIdForPath(const QString& filePath)
+{
+    if (filePath.isEmpty())
+    {
+        return 0;
+    }
+
+    // Use FNV-1a rather than qHash(), since the IDs are stored on disk and
+    // must not change between Qt versions.
+    //
+    QByteArray path = QFileInfo(filePath).absoluteFilePath().toUtf8();
+    quint32 hash = 2166136261U;
+
+    for (int i = 0; i < path.size(); i++)
+    {
+        hash ^= (uchar) path[i];
+        hash *= 16777619U;
+    }
+
+    // Zero is reserved for untitled documents.
+    if (0 == hash)
+    {
+        hash = 1;
+    }
+
+    return hash;
+}
+
+qint16 WritingHistory::currentUtcOffsetMinutes()
+{
+    QDateTime local = QDateTime::currentDateTime();
+    QDateTime utc = local.toUTC();
+
+    // Reinterpret the UTC time as local time to find the offset.
+    utc.setTimeSpec(Qt::LocalTime);
+
+    return (qint16) (utc.secsTo(local) / 60);
+}
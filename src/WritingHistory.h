@@ -0,0 +1,102 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef WRITINGHISTORY_H
+#define WRITINGHISTORY_H
+
+#include <QObject>
+#include <QString>
+
+#include "WritingHistoryLog.h"
+
+class QThread;
+
+/**
+ * Records the writing activity reported by SessionStatistics into a
+ * persistent WritingHistoryLog, so that the history of words written and
+ * time spent writing can be tracked across sessions.  Activity is gathered
+ * into one sample per minute on the GUI thread, and the samples are written
+ * to disk on a worker thread.
+ */
+class WritingHistory : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Takes the directory in which to store the history
+         * files as a parameter.
+         */
+        WritingHistory(const QString& directoryPath, QObject* parent = NULL);
+
+        /**
+         * Destructor.
+         */
+        virtual ~WritingHistory();
+
+        /**
+         * Writes any pending activity to disk and stops the worker thread.
+         * No further activity is recorded after this method is called.
+         */
+        void close();
+
+    signals:
+        /**
+         * Emitted with an updated summary of the writing history, in
+         * response to requestHistory().
+         */
+        void historyAvailable(const WritingHistorySummary& summary);
+
+    public slots:
+        /**
+         * Sets the file path of the document to which subsequent activity
+         * is attributed.  Pass in an empty string for an untitled document.
+         */
+        void setDocumentPath(const QString& filePath);
+
+        /**
+         * Records one second of writing activity, during which the given
+         * number of words were written.
+         */
+        void onActivityRecorded(int wordsWritten, bool idle);
+
+        /**
+         * Requests an updated summary of the writing history.  The summary
+         * will be delivered with the historyAvailable() signal.
+         */
+        void requestHistory();
+
+    private:
+        QThread* workerThread;
+        WritingHistoryLog* log;
+        bool closed;
+
+        quint32 documentId;
+        quint32 pendingMinute;
+        qint32 pendingWords;
+        int pendingActiveSeconds;
+        int pendingIdleSeconds;
+
+        void flushPendingSample();
+
+        static quint32 documentIdForPath(const QString& filePath);
+        static qint16 currentUtcOffsetMinutes();
+};
+
+#endif // WRITINGHISTORY_H
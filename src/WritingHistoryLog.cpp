@@ -0,0 +1,688 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QDir>
+#include <QFileInfo>
+#include <QPair>
+#include <QtEndian>
+
+#include "WritingHistoryLog.h"
+
+#define SAMPLES_FILE_NAME "samples.log"
+#define DAYS_FILE_NAME "days.dat"
+#define LOCK_FILE_NAME "history.lock"
+
+// Time in milliseconds to wait for another instance to release the lock.
+static const int LOCK_TIMEOUT = 5000;
+
+// Julian day of the Unix epoch (January 1, 1970).
+static const qint64 EPOCH_JULIAN_DAY = 2440588;
+static const int MINUTES_PER_DAY = 1440;
+
+// Number of days to read at a time from the day aggregates when summarizing
+// the history.
+static const int SUMMARY_WINDOW_DAYS = 30;
+
+quint32 WritingSample::localJulianDay() const
+{
+    qint64 localMinute = (qint64) utcMinute + utcOffsetMinutes;
+    return (quint32) (EPOCH_JULIAN_DAY + (localMinute / MINUTES_PER_DAY));
+}
+
+int WritingSample::localHour() const
+{
+    qint64 localMinute = (qint64) utcMinute + utcOffsetMinutes;
+    return (int) ((localMinute % MINUTES_PER_DAY) / 60);
+}
+
+QByteArray WritingSample::encode() const
+{
+    QByteArray record(RECORD_SIZE, '\0');
+    uchar* data = (uchar*) record.data();
+
+    qToLittleEndian<quint32>(utcMinute, data);
+    qToLittleEndian<quint32>(documentId, data + 4);
+    qToLittleEndian<qint32>(words, data + 8);
+    data[12] = activeSeconds;
+    data[13] = idleSeconds;
+    qToLittleEndian<qint16>(utcOffsetMinutes, data + 14);
+
+    return record;
+}
+
+WritingSample WritingSample::decode(const char* record)
+{
+    const uchar* data = (const uchar*) record;
+    WritingSample sample;
+
+    sample.utcMinute = qFromLittleEndian<quint32>(data);
+    sample.documentId = qFromLittleEndian<quint32>(data + 4);
+    sample.words = qFromLittleEndian<qint32>(data + 8);
+    sample.activeSeconds = data[12];
+    sample.idleSeconds = data[13];
+    sample.utcOffsetMinutes = qFromLittleEndian<qint16>(data + 14);
+
+    return sample;
+}
+
+WritingDay::WritingDay(quint32 julianDay, quint32 documentId)
+    : julianDay(julianDay),
+      documentId(documentId),
+      words(0),
+      activeSeconds(0),
+      idleSeconds(0)
+{
+    for (int i = 0; i < 24; i++)
+    {
+        activeMinutesByHour[i] = 0;
+    }
+}
+
+void WritingDay::add(const WritingSample& sample)
+{
+    words += sample.words;
+    activeSeconds += sample.activeSeconds;
+    idleSeconds += sample.idleSeconds;
+
+    if (sample.activeSeconds > 0)
+    {
+        int hour = sample.localHour();
+        activeMinutesByHour[hour] = qMin(60, activeMinutesByHour[hour] + 1);
+    }
+}
+
+void WritingDay::merge(const WritingDay& other)
+{
+    words += other.words;
+    activeSeconds += other.activeSeconds;
+    idleSeconds += other.idleSeconds;
+
+    // Two documents can be active during the same minute, so make sure
+    // that an hour is never counted as more than sixty minutes.
+    //
+    for (int i = 0; i < 24; i++)
+    {
+        activeMinutesByHour[i] =
+            qMin(60, activeMinutesByHour[i] + other.activeMinutesByHour[i]);
+    }
+}
+
+QByteArray WritingDay::encode() const
+{
+    QByteArray record(RECORD_SIZE, '\0');
+    uchar* data = (uchar*) record.data();
+
+    qToLittleEndian<quint32>(julianDay, data);
+    qToLittleEndian<quint32>(documentId, data + 4);
+    qToLittleEndian<qint32>(words, data + 8);
+    qToLittleEndian<quint32>(activeSeconds, data + 12);
+    qToLittleEndian<quint32>(idleSeconds, data + 16);
+
+    for (int i = 0; i < 24; i++)
+    {
+        data[20 + i] = activeMinutesByHour[i];
+    }
+
+    return record;
+}
+
+WritingDay WritingDay::decode(const char* record)
+{
+    const uchar* data = (const uchar*) record;
+    WritingDay day;
+
+    day.julianDay = qFromLittleEndian<quint32>(data);
+    day.documentId = qFromLittleEndian<quint32>(data + 4);
+    day.words = qFromLittleEndian<qint32>(data + 8);
+    day.activeSeconds = qFromLittleEndian<quint32>(data + 12);
+    day.idleSeconds = qFromLittleEndian<quint32>(data + 16);
+
+    for (int i = 0; i < 24; i++)
+    {
+        day.activeMinutesByHour[i] = data[20 + i];
+    }
+
+    return day;
+}
+
+WritingHistorySummary::WritingHistorySummary()
+    : documentWordsToday(0),
+      documentWordsThisWeek(0),
+      wordsToday(0),
+      wordsThisWeek(0),
+      activeMinutesThisWeek(0),
+      streakDays(0),
+      mostActiveHour(-1)
+{
+
+}
+
+WritingHistoryLog::WritingHistoryLog(const QString& directoryPath, QObject* parent)
+    : QObject(parent),
+      currentDay(0)
+#if QT_VERSION >= 0x050100
+      , lockFile(QDir(directoryPath).absoluteFilePath(LOCK_FILE_NAME))
+#endif
+{
+    QDir directory(directoryPath);
+
+    samplesFilePath = directory.absoluteFilePath(SAMPLES_FILE_NAME);
+    daysFilePath = directory.absoluteFilePath(DAYS_FILE_NAME);
+}
+
+WritingHistoryLog::~WritingHistoryLog()
+{
+    close();
+}
+
+QList<WritingDay> WritingHistoryLog::queryDays
+(
+    const QDate& first,
+    const QDate& last,
+    bool allDocuments,
+    uint documentId
+)
+{
+    QList<WritingDay> days;
+    quint32 firstDay = (quint32) first.toJulianDay();
+    quint32 lastDay = (quint32) last.toJulianDay();
+
+    if (!daysFile.isOpen() || (firstDay > lastDay))
+    {
+        return days;
+    }
+
+    int count = dayRecordCount();
+
+    for (int i = findFirstDayRecord(firstDay); i < count; i++)
+    {
+        WritingDay day;
+
+        if (!readDayRecord(i, day) || (day.julianDay > lastDay))
+        {
+            break;
+        }
+
+        if (allDocuments)
+        {
+            if (!days.isEmpty() && (days.last().julianDay == day.julianDay))
+            {
+                days.last().merge(day);
+            }
+            else
+            {
+                day.documentId = 0;
+                days.append(day);
+            }
+        }
+        else if (documentId == day.documentId)
+        {
+            days.append(day);
+        }
+    }
+
+    // Today has not been rolled up yet, so add it from memory.
+    if ((currentDay >= firstDay) && (currentDay <= lastDay))
+    {
+        WritingDay today(currentDay, allDocuments ? 0 : documentId);
+        bool found = false;
+
+        QMap<quint32, WritingDay>::const_iterator iter;
+
+        for (iter = todayByDocument.begin(); iter != todayByDocument.end(); iter++)
+        {
+            if (allDocuments || (documentId == iter.key()))
+            {
+                today.merge(iter.value());
+                found = true;
+            }
+        }
+
+        if (found)
+        {
+            if (!days.isEmpty() && (days.last().julianDay == currentDay))
+            {
+                days.last().merge(today);
+            }
+            else
+            {
+                days.append(today);
+            }
+        }
+    }
+
+    return days;
+}
+
+void WritingHistoryLog::open()
+{
+    if (!lock())
+    {
+        qWarning("Could not lock writing history in %s",
+            QFileInfo(daysFilePath).absolutePath().toLocal8Bit().constData());
+        return;
+    }
+
+    // Recover from an interruption while the sample log was being replaced.
+    QString tempFilePath = samplesFilePath + ".tmp";
+
+    if (!QFile::exists(samplesFilePath) && QFile::exists(tempFilePath))
+    {
+        QFile::rename(tempFilePath, samplesFilePath);
+    }
+
+    daysFile.setFileName(daysFilePath);
+
+    if (!daysFile.open(QIODevice::ReadWrite))
+    {
+        qWarning("Could not open writing history file %s",
+            daysFilePath.toLocal8Bit().constData());
+        unlock();
+        return;
+    }
+
+    rollUp((quint32) QDate::currentDate().toJulianDay());
+    unlock();
+}
+
+void WritingHistoryLog::appendSample(const QByteArray& record)
+{
+    if (!daysFile.isOpen() || (WritingSample::RECORD_SIZE != record.size()))
+    {
+        return;
+    }
+
+    WritingSample sample = WritingSample::decode(record.constData());
+    quint32 day = sample.localJulianDay();
+
+    pendingSamples.append(record);
+
+    // If another instance holds the lock, keep the sample until the next
+    // one comes along.
+    //
+    if (lock())
+    {
+        if (day > currentDay)
+        {
+            rollUp(day);
+        }
+
+        writePendingSamples();
+        unlock();
+    }
+
+    if (day == currentDay)
+    {
+        QMap<quint32, WritingDay>::iterator iter =
+            todayByDocument.find(sample.documentId);
+
+        if (todayByDocument.end() == iter)
+        {
+            iter = todayByDocument.insert
+                (
+                    sample.documentId,
+                    WritingDay(currentDay, sample.documentId)
+                );
+        }
+
+        iter.value().add(sample);
+    }
+}
+
+void WritingHistoryLog::requestSummary(uint documentId)
+{
+    WritingHistorySummary summary;
+
+    QDate today = QDate::currentDate();
+    QDate weekStart = today.addDays(1 - today.dayOfWeek());
+    QDate windowStart = today.addDays(1 - SUMMARY_WINDOW_DAYS);
+    quint32 todayDay = (quint32) today.toJulianDay();
+    quint32 weekStartDay = (quint32) weekStart.toJulianDay();
+
+    QList<WritingDay> days = queryDays(weekStart, today, false, documentId);
+
+    for (int i = 0; i < days.size(); i++)
+    {
+        summary.documentWordsThisWeek += days[i].words;
+
+        if (todayDay == days[i].julianDay)
+        {
+            summary.documentWordsToday += days[i].words;
+        }
+    }
+
+    days = queryDays(windowStart, today, true);
+
+    int activeMinutesByHour[24];
+    quint32 activeSecondsThisWeek = 0;
+
+    for (int i = 0; i < 24; i++)
+    {
+        activeMinutesByHour[i] = 0;
+    }
+
+    for (int i = 0; i < days.size(); i++)
+    {
+        const WritingDay& day = days[i];
+
+        if (day.julianDay >= weekStartDay)
+        {
+            summary.wordsThisWeek += day.words;
+            activeSecondsThisWeek += day.activeSeconds;
+        }
+
+        if (todayDay == day.julianDay)
+        {
+            summary.wordsToday += day.words;
+        }
+
+        for (int hour = 0; hour < 24; hour++)
+        {
+            activeMinutesByHour[hour] += day.activeMinutesByHour[hour];
+        }
+    }
+
+    summary.activeMinutesThisWeek = activeSecondsThisWeek / 60;
+
+    for (int hour = 0; hour < 24; hour++)
+    {
+        if
+        (
+            (activeMinutesByHour[hour] > 0) &&
+            (
+                (summary.mostActiveHour < 0) ||
+                (activeMinutesByHour[hour] > activeMinutesByHour[summary.mostActiveHour])
+            )
+        )
+        {
+            summary.mostActiveHour = hour;
+        }
+    }
+
+    // Count the consecutive days with words written, going backwards from
+    // today.  A streak is not broken until today is over, so start counting
+    // from yesterday if nothing has been written yet today.  If the streak
+    // reaches the start of the window that was read, keep reading earlier
+    // windows until it ends.
+    //
+    QDate expected = today;
+    bool streakEnded = false;
+
+    while (!streakEnded)
+    {
+        for (int i = days.size() - 1; i >= 0; i--)
+        {
+            if (days[i].words <= 0)
+            {
+                continue;
+            }
+
+            QDate date = QDate::fromJulianDay(days[i].julianDay);
+
+            if (date > expected)
+            {
+                continue;
+            }
+
+            if ((0 == summary.streakDays) && (date == today.addDays(-1)))
+            {
+                expected = date;
+            }
+
+            if (date != expected)
+            {
+                break;
+            }
+
+            summary.streakDays++;
+            expected = expected.addDays(-1);
+        }
+
+        if (expected == windowStart.addDays(-1))
+        {
+            QDate windowEnd = expected;
+            windowStart = windowEnd.addDays(1 - SUMMARY_WINDOW_DAYS);
+            days = queryDays(windowStart, windowEnd, true);
+        }
+        else
+        {
+            streakEnded = true;
+        }
+    }
+
+    emit summaryReady(summary);
+}
+
+void WritingHistoryLog::close()
+{
+    if (!pendingSamples.isEmpty() && lock())
+    {
+        writePendingSamples();
+        unlock();
+    }
+
+    if (daysFile.isOpen())
+    {
+        daysFile.close();
+    }
+}
+
+bool WritingHistoryLog::lock()
+{
+#if QT_VERSION >= 0x050100
+    return lockFile.tryLock(LOCK_TIMEOUT);
+#else
+    // Qt 4 has no lock files, so only one instance may safely run at a time.
+    return true;
+#endif
+}
+
+void WritingHistoryLog::unlock()
+{
+#if QT_VERSION >= 0x050100
+    lockFile.unlock();
+#endif
+}
+
+void WritingHistoryLog::writePendingSamples()
+{
+    // The sample log is opened anew for every write, since another instance
+    // may have replaced it while rolling it up.
+    //
+    QFile samplesFile(samplesFilePath);
+
+    if (!samplesFile.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        qWarning("Could not open writing history file %s",
+            samplesFilePath.toLocal8Bit().constData());
+        return;
+    }
+
+    samplesFile.write(pendingSamples);
+    samplesFile.close();
+    pendingSamples.clear();
+}
+
+void WritingHistoryLog::rollUp(quint32 today)
+{
+    currentDay = today;
+    todayByDocument.clear();
+
+    // Discard any partial record left behind by an interrupted write.
+    qint64 daysFileSize = daysFile.size();
+
+    if (0 != (daysFileSize % WritingDay::RECORD_SIZE))
+    {
+        daysFile.resize(daysFileSize - (daysFileSize % WritingDay::RECORD_SIZE));
+    }
+
+    quint32 lastStoredDay = 0;
+    int count = dayRecordCount();
+    WritingDay lastDay;
+
+    if ((count > 0) && readDayRecord(count - 1, lastDay))
+    {
+        lastStoredDay = lastDay.julianDay;
+    }
+
+    QByteArray samples;
+    QFile oldSamplesFile(samplesFilePath);
+
+    if (oldSamplesFile.open(QIODevice::ReadOnly))
+    {
+        samples = oldSamplesFile.readAll();
+        oldSamplesFile.close();
+    }
+
+    // Aggregate the samples of past days by day, then by document, which
+    // is the order in which they are stored.
+    //
+    QMap<QPair<quint32, quint32>, WritingDay> pastDays;
+    QByteArray remainingSamples;
+    int sampleCount = samples.size() / WritingSample::RECORD_SIZE;
+
+    for (int i = 0; i < sampleCount; i++)
+    {
+        const char* record = samples.constData() + (i * WritingSample::RECORD_SIZE);
+        WritingSample sample = WritingSample::decode(record);
+        quint32 day = sample.localJulianDay();
+
+        if (day >= today)
+        {
+            remainingSamples.append(record, WritingSample::RECORD_SIZE);
+
+            if (day == today)
+            {
+                QMap<quint32, WritingDay>::iterator iter =
+                    todayByDocument.find(sample.documentId);
+
+                if (todayByDocument.end() == iter)
+                {
+                    iter = todayByDocument.insert
+                        (
+                            sample.documentId,
+                            WritingDay(today, sample.documentId)
+                        );
+                }
+
+                iter.value().add(sample);
+            }
+        }
+        else if (day > lastStoredDay)
+        {
+            QPair<quint32, quint32> key(day, sample.documentId);
+            QMap<QPair<quint32, quint32>, WritingDay>::iterator iter =
+                pastDays.find(key);
+
+            if (pastDays.end() == iter)
+            {
+                iter = pastDays.insert(key, WritingDay(day, sample.documentId));
+            }
+
+            iter.value().add(sample);
+        }
+
+        // Otherwise, the sample's day was already rolled up before the sample
+        // log could be rewritten, so the sample can be dropped.
+    }
+
+    if (!pastDays.isEmpty())
+    {
+        daysFile.seek(daysFile.size());
+
+        QMap<QPair<quint32, quint32>, WritingDay>::const_iterator iter;
+
+        for (iter = pastDays.begin(); iter != pastDays.end(); iter++)
+        {
+            daysFile.write(iter.value().encode());
+        }
+
+        daysFile.flush();
+    }
+
+    // Replace the sample log with only the samples that are left, writing
+    // them to a temporary file first so that the log is never left half
+    // written.  This also drops any partial record at the end of the log.
+    //
+    if (remainingSamples.size() != samples.size())
+    {
+        QString tempFilePath = samplesFilePath + ".tmp";
+        QFile tempFile(tempFilePath);
+
+        if (tempFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            tempFile.write(remainingSamples);
+            tempFile.close();
+
+            QFile::remove(samplesFilePath);
+            QFile::rename(tempFilePath, samplesFilePath);
+        }
+    }
+}
+
+int WritingHistoryLog::dayRecordCount()
+{
+    return (int) (daysFile.size() / WritingDay::RECORD_SIZE);
+}
+
+bool WritingHistoryLog::readDayRecord(int index, WritingDay& day)
+{
+    if (!daysFile.seek((qint64) index * WritingDay::RECORD_SIZE))
+    {
+        return false;
+    }
+
+    QByteArray record = daysFile.read(WritingDay::RECORD_SIZE);
+
+    if (WritingDay::RECORD_SIZE != record.size())
+    {
+        return false;
+    }
+
+    day = WritingDay::decode(record.constData());
+    return true;
+}
+
+int WritingHistoryLog::findFirstDayRecord(quint32 julianDay)
+{
+    int low = 0;
+    int high = dayRecordCount();
+
+    while (low < high)
+    {
+        int mid = low + ((high - low) / 2);
+        WritingDay day;
+
+        if (!readDayRecord(mid, day))
+        {
+            return high;
+        }
+
+        if (day.julianDay < julianDay)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
@@ -0,0 +1,219 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef WRITINGHISTORYLOG_H
+#define WRITINGHISTORYLOG_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QDate>
+#include <QFile>
+#include <QList>
+#include <QMap>
+#include <QMetaType>
+#include <QString>
+
+#if QT_VERSION >= 0x050100
+#include <QLockFile>
+#endif
+
+/**
+ * One minute of writing activity for a document.  Samples are appended to
+ * the history log as fixed-size, little-endian records of
+ * WritingSample::RECORD_SIZE bytes.
+ */
+struct WritingSample
+{
+    static const int RECORD_SIZE = 16;
+
+    quint32 utcMinute;
+    quint32 documentId;
+    qint32 words;
+    quint8 activeSeconds;
+    quint8 idleSeconds;
+    qint16 utcOffsetMinutes;
+
+    /**
+     * Returns the Julian day of the writer's local date when the sample
+     * was taken.
+     */
+    quint32 localJulianDay() const;
+
+    /**
+     * Returns the hour of the writer's local time when the sample was taken.
+     */
+    int localHour() const;
+
+    QByteArray encode() const;
+    static WritingSample decode(const char* data);
+};
+
+/**
+ * Writing activity for one document (or for all documents) over one day.
+ * Day aggregates are stored as fixed-size, little-endian records of
+ * WritingDay::RECORD_SIZE bytes, sorted by day.
+ */
+struct WritingDay
+{
+    static const int RECORD_SIZE = 44;
+
+    quint32 julianDay;
+    quint32 documentId;
+    qint32 words;
+    quint32 activeSeconds;
+    quint32 idleSeconds;
+    quint8 activeMinutesByHour[24];
+
+    WritingDay(quint32 julianDay = 0, quint32 documentId = 0);
+
+    /**
+     * Adds the given sample's activity to this day.
+     */
+    void add(const WritingSample& sample);
+
+    /**
+     * Adds another day's activity to this day.
+     */
+    void merge(const WritingDay& other);
+
+    QByteArray encode() const;
+    static WritingDay decode(const char* data);
+};
+
+/**
+ * Summary of the writing history, as displayed in the writing history HUD.
+ */
+struct WritingHistorySummary
+{
+    int documentWordsToday;
+    int documentWordsThisWeek;
+    int wordsToday;
+    int wordsThisWeek;
+    int activeMinutesThisWeek;
+    int streakDays;
+    int mostActiveHour;
+
+    WritingHistorySummary();
+};
+
+Q_DECLARE_METATYPE(WritingHistorySummary)
+
+/**
+ * Persistent store for the writing history, which is meant to live on a
+ * worker thread so that disk access never blocks the GUI.  Minute samples
+ * are appended to a raw log file.  Once a day is over, its samples are
+ * rolled up into per-day, per-document aggregates in a second file and
+ * removed from the raw log, so that the raw log never holds more than a
+ * day or so worth of samples.  Range queries are answered with a binary
+ * search over the day aggregates plus the in-memory totals for today, and
+ * never need to scan raw samples.
+ *
+ * Several running instances of the application share the same files, so
+ * appending samples and rolling them up are guarded by a lock file.
+ */
+class WritingHistoryLog : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.  Takes the directory in which to store the history
+         * files as a parameter.  No files are opened until open() is called.
+         */
+        WritingHistoryLog(const QString& directoryPath, QObject* parent = NULL);
+
+        /**
+         * Destructor.
+         */
+        virtual ~WritingHistoryLog();
+
+        /**
+         * Returns the activity for each day in the given range for which
+         * there is any history, in ascending order of day.  If
+         * allDocuments is true, the activity for all documents is combined
+         * into one entry per day.  Otherwise, only the activity for the
+         * document with the given ID is returned.
+         */
+        QList<WritingDay> queryDays
+        (
+            const QDate& first,
+            const QDate& last,
+            bool allDocuments,
+            uint documentId = 0
+        );
+
+    signals:
+        /**
+         * Emitted in response to requestSummary().
+         */
+        void summaryReady(const WritingHistorySummary& summary);
+
+    public slots:
+        /**
+         * Opens the history files, rolling up the samples of any days
+         * that have passed since the application last ran.
+         */
+        void open();
+
+        /**
+         * Appends an encoded WritingSample to the log.
+         */
+        void appendSample(const QByteArray& record);
+
+        /**
+         * Computes a summary of the writing history for today, with
+         * the document having the given ID as the current document.
+         * Emits summaryReady() with the result.
+         */
+        void requestSummary(uint documentId);
+
+        /**
+         * Flushes and closes the history files.
+         */
+        void close();
+
+    private:
+        QString samplesFilePath;
+        QString daysFilePath;
+        QFile daysFile;
+        quint32 currentDay;
+
+#if QT_VERSION >= 0x050100
+        QLockFile lockFile;
+#endif
+
+        // Samples that could not be written yet because another instance
+        // held the lock.
+        //
+        QByteArray pendingSamples;
+
+        // Today's activity, by document ID.
+        QMap<quint32, WritingDay> todayByDocument;
+
+        bool lock();
+        void unlock();
+        // These must only be called while holding the lock.
+        void writePendingSamples();
+        void rollUp(quint32 today);
+        int dayRecordCount();
+        bool readDayRecord(int index, WritingDay& day);
+        int findFirstDayRecord(quint32 julianDay);
+};
+
+#endif // WRITINGHISTORYLOG_H
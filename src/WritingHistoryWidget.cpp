@@ -0,0 +1,63 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include <QLocale>
+#include <QTime>
+
+#include "WritingHistoryWidget.h"
+
+WritingHistoryWidget::WritingHistoryWidget(QWidget* parent) :
+    AbstractStatisticsWidget(parent)
+{
+    documentWordsTodayLabel = addStatisticLabel(tr("Document Today:"), "0", tr("Words written in this document today"));
+    documentWordsThisWeekLabel = addStatisticLabel(tr("Document This Week:"), "0", tr("Words written in this document this week"));
+    wordsTodayLabel = addStatisticLabel(tr("All Today:"), "0", tr("Words written in all documents today"));
+    wordsThisWeekLabel = addStatisticLabel(tr("All This Week:"), "0", tr("Words written in all documents this week"));
+    writingTimeThisWeekLabel = addStatisticLabel(tr("Time This Week:"), LESS_THAN_ONE_MINUTE_STR);
+    streakLabel = addStatisticLabel(tr("Writing Streak:"), "0", tr("Consecutive days on which you have written"));
+    mostActiveHourLabel = addStatisticLabel(tr("Most Active Hour:"), "-", tr("Hour of the day you have written the most in the last 30 days"));
+}
+
+WritingHistoryWidget::~WritingHistoryWidget()
+{
+
+}
+
+void WritingHistoryWidget::setHistory(const WritingHistorySummary& summary)
+{
+    setIntegerValueForLabel(documentWordsTodayLabel, summary.documentWordsToday);
+    setIntegerValueForLabel(documentWordsThisWeekLabel, summary.documentWordsThisWeek);
+    setIntegerValueForLabel(wordsTodayLabel, summary.wordsToday);
+    setIntegerValueForLabel(wordsThisWeekLabel, summary.wordsThisWeek);
+    setTimeValueForLabel(writingTimeThisWeekLabel, summary.activeMinutesThisWeek);
+    setStringValueForLabel(streakLabel, tr("%n day(s)", "", summary.streakDays));
+
+    if (summary.mostActiveHour < 0)
+    {
+        setStringValueForLabel(mostActiveHourLabel, "-");
+    }
+    else
+    {
+        setStringValueForLabel
+        (
+            mostActiveHourLabel,
+            QLocale().toString(QTime(summary.mostActiveHour, 0), QLocale::ShortFormat)
+        );
+    }
+}
@@ -0,0 +1,63 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2016 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef WRITINGHISTORYWIDGET_H
+#define WRITINGHISTORYWIDGET_H
+
+#include "AbstractStatisticsWidget.h"
+#include "WritingHistoryLog.h"
+
+class QLabel;
+
+/**
+ * Widget to display the writing history across sessions.
+ */
+class WritingHistoryWidget : public AbstractStatisticsWidget
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor.
+         */
+        WritingHistoryWidget(QWidget* parent = NULL);
+
+        /**
+         * Destructor.
+         */
+        virtual ~WritingHistoryWidget();
+
+    public slots:
+        /**
+         * Sets the writing history summary to display.
+         */
+        void setHistory(const WritingHistorySummary& summary);
+
+    private:
+        QLabel* documentWordsTodayLabel;
+        QLabel* documentWordsThisWeekLabel;
+        QLabel* wordsTodayLabel;
+        QLabel* wordsThisWeekLabel;
+        QLabel* writingTimeThisWeekLabel;
+        QLabel* streakLabel;
+        QLabel* mostActiveHourLabel;
+
+};
+
+#endif // WRITINGHISTORYWIDGET_H
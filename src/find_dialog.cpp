@@ -39,7 +39,9 @@
 
 FindDialog::FindDialog(QPlainTextEdit* document)
     : QDialog(document->window(), Qt::WindowTitleHint | Qt::MSWindowsFixedSizeDialogHint | Qt::WindowSystemMenuHint | Qt::WindowCloseButtonHint),
-    m_document(document)
+    m_document(document),
+    m_matches_regular_expression(false),
+    m_matches_revision(-1)
 {
 	// Create widgets
 	QLabel* find_label = new QLabel(tr("Search for:"), this);
@@ -124,6 +126,8 @@ void FindDialog::reject()
 	settings.setValue("FindDialog/WholeWords", m_whole_words->isChecked());
 	settings.setValue("FindDialog/RegularExpressions", m_regular_expressions->isChecked());
 	settings.setValue("FindDialog/SearchBackwards", m_search_backwards->isChecked());
+	m_matches_revision = -1;
+	emit matchesFound(QList<int>());
 	QDialog::reject();
 }
 
@@ -309,6 +313,8 @@ void FindDialog::replaceAll()
     start_cursor.endEditBlock();
     document->setTextCursor(start_cursor);
     emit replaceAllComplete();
+
+	findAll(text, regex, flags);
 }
 
 //-----------------------------------------------------------------------------
@@ -328,6 +334,9 @@ void FindDialog::find(bool backwards)
 	if (m_whole_words->isChecked() && !m_regular_expressions->isChecked()) {
 		flags |= QTextDocument::FindWholeWords;
 	}
+
+	findAll(text, regex, flags);
+
 	if (backwards) {
 		flags |= QTextDocument::FindBackward;
 	}
@@ -358,6 +367,48 @@ void FindDialog::find(bool backwards)
 
 //-----------------------------------------------------------------------------
 
+void FindDialog::findAll(const QString& text, const QRegExp& regex, QTextDocument::FindFlags flags)
+{
+	// Searching the whole document again is only needed when the search
+	// or the document has changed since the last time.
+	QTextDocument* document = m_document->document();
+	bool regular_expression = m_regular_expressions->isChecked();
+	if ((text == m_matches_text) && (flags == m_matches_flags) &&
+			(regular_expression == m_matches_regular_expression) &&
+			(document->revision() == m_matches_revision)) {
+		return;
+	}
+	m_matches_text = text;
+	m_matches_flags = flags;
+	m_matches_regular_expression = regular_expression;
+	m_matches_revision = document->revision();
+
+	QList<int> positions;
+	QTextCursor cursor(document);
+	if (!regular_expression) {
+		forever {
+			cursor = document->find(text, cursor, flags);
+			if (!cursor.isNull()) {
+				positions.append(cursor.selectionStart());
+			} else {
+				break;
+			}
+		}
+	} else {
+		forever {
+			cursor = document->find(regex, cursor, flags);
+			if (!cursor.isNull() && cursor.hasSelection()) {
+				positions.append(cursor.selectionStart());
+			} else {
+				break;
+			}
+		}
+	}
+	emit matchesFound(positions);
+}
+
+//-----------------------------------------------------------------------------
+
 void FindDialog::showMode(bool replace)
 {
 	m_replace_label->setVisible(replace);
@@ -24,10 +24,13 @@
 class Stack;
 
 #include <QDialog>
+#include <QList>
+#include <QTextDocument>
 class QCheckBox;
 class QLabel;
 class QLineEdit;
 class QRadioButton;
+class QRegExp;
 class QPlainTextEdit;
 
 class FindDialog : public QDialog
@@ -57,6 +60,12 @@ signals:
     //
     void replaceAllComplete();
 
+	// Emitted with the document positions of all matches of the search
+	// phrase whenever they are found anew, and with an empty list when
+	// the dialog is closed.
+	//
+	void matchesFound(const QList<int>& positions);
+
 
 protected:
 	void moveEvent(QMoveEvent* event);
@@ -71,6 +80,7 @@ private slots:
 
 private:
 	void find(bool backwards);
+	void findAll(const QString& text, const QRegExp& regex, QTextDocument::FindFlags flags);
 	void showMode(bool replace);
 
 private:
@@ -90,6 +100,13 @@ private:
 	QPushButton* m_replace_all_button;
 
 	QPoint m_position;
+
+	// Search for which all matches were last found, and the document
+	// revision at the time.
+	QString m_matches_text;
+	QTextDocument::FindFlags m_matches_flags;
+	bool m_matches_regular_expression;
+	int m_matches_revision;
 };
 
 #endif
@@ -132,6 +132,15 @@ QString DictionaryManager::availableDictionary(const QString& language) const
 
 //-----------------------------------------------------------------------------
 
+QStringList DictionaryManager::loadedDictionaries() const
+{
+	QStringList result = m_dictionaries.keys();
+	result.sort();
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+
 void DictionaryManager::add(const QString& word)
 {
 	QStringList words = personal();
@@ -38,6 +38,7 @@ public:
 	QStringList availableDictionaries() const;
 	QString availableDictionary(const QString& language) const;
 	QString defaultLanguage() const;
+	QStringList loadedDictionaries() const;
 	QStringList personal() const;
 
 	void add(const QString& word);
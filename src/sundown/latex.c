@@ -0,0 +1,537 @@
+/*
+ * Copyright (c) 2016, wereturtle
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "markdown.h"
+#include "latex.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <ctype.h>
+
+/* output is handed to the stream once the root buffer grows past this */
+#define LATEX_FLUSH_SIZE (64 * 1024)
+
+static void
+escape_latex(struct buf *ob, const uint8_t *source, size_t length)
+{
+	size_t i = 0, org;
+
+	while (i < length) {
+		org = i;
+		while (i < length && !strchr("#$%&_{}~^\\", source[i]))
+			i++;
+
+		if (i > org)
+			bufput(ob, source + org, i - org);
+
+		if (i >= length)
+			break;
+
+		switch (source[i]) {
+		case '~':
+			BUFPUTSL(ob, "\\textasciitilde{}");
+			break;
+		case '^':
+			BUFPUTSL(ob, "\\textasciicircum{}");
+			break;
+		case '\\':
+			BUFPUTSL(ob, "\\textbackslash{}");
+			break;
+		default:
+			bufputc(ob, '\\');
+			bufputc(ob, source[i]);
+			break;
+		}
+
+		i++;
+	}
+}
+
+/* URLs are passed through verbatim by hyperref, except for these */
+static void
+escape_url(struct buf *ob, const uint8_t *source, size_t length)
+{
+	size_t i;
+
+	for (i = 0; i < length; ++i) {
+		if (source[i] == '%' || source[i] == '#' || source[i] == '\\')
+			bufputc(ob, '\\');
+		bufputc(ob, source[i]);
+	}
+}
+
+/* image links name files on disk, so percent-decode them before escaping */
+static void
+escape_path(struct buf *ob, const uint8_t *source, size_t length)
+{
+	struct buf *path = bufnew(length + 1);
+	size_t i = 0;
+
+	while (i < length) {
+		if (source[i] == '%' && i + 2 < length &&
+			isxdigit(source[i + 1]) && isxdigit(source[i + 2])) {
+			char hex[3];
+
+			hex[0] = source[i + 1];
+			hex[1] = source[i + 2];
+			hex[2] = '\0';
+			bufputc(path, (int)strtol(hex, NULL, 16));
+			i += 3;
+		} else {
+			bufputc(path, source[i]);
+			i++;
+		}
+	}
+
+	escape_latex(ob, path->data, path->size);
+	bufrelease(path);
+}
+
+/* block_start: separates a block from whatever preceded it */
+static void
+block_start(struct buf *ob, struct latex_renderopt *options)
+{
+	if (ob->size || (ob == options->root && options->flushed))
+		bufputc(ob, '\n');
+}
+
+/* block_end: streams completed top-level blocks to their destination */
+static void
+block_end(struct buf *ob, struct latex_renderopt *options)
+{
+	if (options->stream_cb && ob == options->root && ob->size >= LATEX_FLUSH_SIZE) {
+		options->stream_cb(ob->data, ob->size, options->stream);
+		options->flushed += ob->size;
+		ob->size = 0;
+	}
+}
+
+/********************
+ * GENERIC RENDERER *
+ ********************/
+static int
+rndr_autolink(struct buf *ob, const struct buf *link, enum mkd_autolink type, void *opaque)
+{
+	if (!link || !link->size)
+		return 0;
+
+	BUFPUTSL(ob, "\\href{");
+	if (type == MKDA_EMAIL)
+		BUFPUTSL(ob, "mailto:");
+	escape_url(ob, link->data, link->size);
+	BUFPUTSL(ob, "}{\\nolinkurl{");
+
+	if (bufprefix(link, "mailto:") == 0)
+		escape_url(ob, link->data + 7, link->size - 7);
+	else
+		escape_url(ob, link->data, link->size);
+
+	BUFPUTSL(ob, "}}");
+	return 1;
+}
+
+static void
+rndr_blockcode(struct buf *ob, const struct buf *text, const struct buf *lang, void *opaque)
+{
+	struct latex_renderopt *options = opaque;
+
+	block_start(ob, options);
+	BUFPUTSL(ob, "\\begin{verbatim}\n");
+
+	if (text)
+		bufput(ob, text->data, text->size);
+
+	if (!text || !text->size || text->data[text->size - 1] != '\n')
+		bufputc(ob, '\n');
+
+	BUFPUTSL(ob, "\\end{verbatim}\n");
+	block_end(ob, options);
+}
+
+static void
+rndr_blockquote(struct buf *ob, const struct buf *text, void *opaque)
+{
+	struct latex_renderopt *options = opaque;
+
+	block_start(ob, options);
+	BUFPUTSL(ob, "\\begin{quote}\n");
+	if (text) bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, "\\end{quote}\n");
+	block_end(ob, options);
+}
+
+static int
+rndr_codespan(struct buf *ob, const struct buf *text, void *opaque)
+{
+	BUFPUTSL(ob, "\\texttt{");
+	if (text) escape_latex(ob, text->data, text->size);
+	BUFPUTSL(ob, "}");
+	return 1;
+}
+
+static int
+rndr_strikethrough(struct buf *ob, const struct buf *text, void *opaque)
+{
+	if (!text || !text->size)
+		return 0;
+
+	BUFPUTSL(ob, "\\sout{");
+	bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, "}");
+	return 1;
+}
+
+static int
+rndr_double_emphasis(struct buf *ob, const struct buf *text, void *opaque)
+{
+	if (!text || !text->size)
+		return 0;
+
+	BUFPUTSL(ob, "\\textbf{");
+	bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, "}");
+	return 1;
+}
+
+static int
+rndr_emphasis(struct buf *ob, const struct buf *text, void *opaque)
+{
+	if (!text || !text->size) return 0;
+	BUFPUTSL(ob, "\\emph{");
+	bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, "}");
+	return 1;
+}
+
+static int
+rndr_triple_emphasis(struct buf *ob, const struct buf *text, void *opaque)
+{
+	if (!text || !text->size) return 0;
+	BUFPUTSL(ob, "\\textbf{\\emph{");
+	bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, "}}");
+	return 1;
+}
+
+static int
+rndr_superscript(struct buf *ob, const struct buf *text, void *opaque)
+{
+	if (!text || !text->size) return 0;
+	BUFPUTSL(ob, "\\textsuperscript{");
+	bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, "}");
+	return 1;
+}
+
+static int
+rndr_linebreak(struct buf *ob, void *opaque)
+{
+	BUFPUTSL(ob, "\\\\\n");
+	return 1;
+}
+
+static void
+rndr_header(struct buf *ob, const struct buf *text, int level, void *opaque)
+{
+	static const char *sections[] = {
+		"section", "subsection", "subsubsection",
+		"paragraph", "subparagraph", "subparagraph"
+	};
+
+	struct latex_renderopt *options = opaque;
+
+	if (level < 1) level = 1;
+	if (level > 6) level = 6;
+
+	block_start(ob, options);
+	bufprintf(ob, "\\%s{", sections[level - 1]);
+	if (text) bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, "}\n");
+	block_end(ob, options);
+}
+
+static int
+rndr_link(struct buf *ob, const struct buf *link, const struct buf *title, const struct buf *content, void *opaque)
+{
+	BUFPUTSL(ob, "\\href{");
+	if (link && link->size)
+		escape_url(ob, link->data, link->size);
+	BUFPUTSL(ob, "}{");
+	if (content && content->size) bufput(ob, content->data, content->size);
+	BUFPUTSL(ob, "}");
+	return 1;
+}
+
+static void
+rndr_list(struct buf *ob, const struct buf *text, int flags, void *opaque)
+{
+	struct latex_renderopt *options = opaque;
+
+	block_start(ob, options);
+	bufputs(ob, flags & MKD_LIST_ORDERED ? "\\begin{enumerate}\n" : "\\begin{itemize}\n");
+	if (text) bufput(ob, text->data, text->size);
+	bufputs(ob, flags & MKD_LIST_ORDERED ? "\\end{enumerate}\n" : "\\end{itemize}\n");
+	block_end(ob, options);
+}
+
+static void
+rndr_listitem(struct buf *ob, const struct buf *text, int flags, void *opaque)
+{
+	BUFPUTSL(ob, "\\item ");
+	if (text) {
+		size_t size = text->size;
+		while (size && text->data[size - 1] == '\n')
+			size--;
+
+		bufput(ob, text->data, size);
+	}
+	bufputc(ob, '\n');
+}
+
+static void
+rndr_paragraph(struct buf *ob, const struct buf *text, void *opaque)
+{
+	struct latex_renderopt *options = opaque;
+	size_t i = 0;
+
+	if (!text || !text->size)
+		return;
+
+	while (i < text->size && isspace(text->data[i])) i++;
+
+	if (i == text->size)
+		return;
+
+	block_start(ob, options);
+	bufput(ob, &text->data[i], text->size - i);
+	bufputc(ob, '\n');
+	block_end(ob, options);
+}
+
+static void
+rndr_hrule(struct buf *ob, void *opaque)
+{
+	struct latex_renderopt *options = opaque;
+
+	block_start(ob, options);
+	BUFPUTSL(ob, "\\begin{center}\\rule{0.5\\linewidth}{0.4pt}\\end{center}\n");
+	block_end(ob, options);
+}
+
+static int
+rndr_image(struct buf *ob, const struct buf *link, const struct buf *title, const struct buf *alt, void *opaque)
+{
+	if (!link || !link->size) return 0;
+
+	BUFPUTSL(ob, "\\includegraphics[width=\\linewidth,keepaspectratio]{");
+	escape_path(ob, link->data, link->size);
+	BUFPUTSL(ob, "}");
+	return 1;
+}
+
+static int
+rndr_raw_html(struct buf *ob, const struct buf *text, void *opaque)
+{
+	/* HTML has no meaning in LaTeX output, so drop it */
+	return 1;
+}
+
+static void
+rndr_table(struct buf *ob, const struct buf *header, const struct buf *body, void *opaque)
+{
+	struct latex_renderopt *options = opaque;
+	size_t i;
+
+	block_start(ob, options);
+	BUFPUTSL(ob, "\\begin{tabular}{");
+
+	for (i = 0; i < options->table_data.columns; ++i)
+		bufputc(ob, options->table_data.align[i]);
+
+	BUFPUTSL(ob, "}\n\\hline\n");
+	if (header)
+		bufput(ob, header->data, header->size);
+	BUFPUTSL(ob, "\\hline\n");
+	if (body)
+		bufput(ob, body->data, body->size);
+	BUFPUTSL(ob, "\\hline\n\\end{tabular}\n");
+
+	options->table_data.columns = 0;
+	block_end(ob, options);
+}
+
+static void
+rndr_tablerow(struct buf *ob, const struct buf *text, void *opaque)
+{
+	if (text)
+		bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, " \\\\\n");
+}
+
+static void
+rndr_tablecell(struct buf *ob, const struct buf *text, int flags, void *opaque)
+{
+	struct latex_renderopt *options = opaque;
+
+	/* each row is rendered into a fresh buffer, so an empty buffer
+	 * means this is the first cell in the row */
+	if (ob->size)
+		BUFPUTSL(ob, " & ");
+
+	/* the header row determines the column alignments */
+	if ((flags & MKD_TABLE_HEADER) && options->table_data.columns < LATEX_MAX_COLUMNS) {
+		char align;
+
+		switch (flags & MKD_TABLE_ALIGNMASK) {
+		case MKD_TABLE_ALIGN_CENTER:
+			align = 'c';
+			break;
+		case MKD_TABLE_ALIGN_R:
+			align = 'r';
+			break;
+		default:
+			align = 'l';
+			break;
+		}
+
+		options->table_data.align[options->table_data.columns++] = align;
+	}
+
+	if (flags & MKD_TABLE_HEADER)
+		BUFPUTSL(ob, "\\textbf{");
+
+	if (text)
+		bufput(ob, text->data, text->size);
+
+	if (flags & MKD_TABLE_HEADER)
+		BUFPUTSL(ob, "}");
+}
+
+static void
+rndr_entity(struct buf *ob, const struct buf *entity, void *opaque)
+{
+	static const struct {
+		const char *entity;
+		const char *latex;
+	} entities[] = {
+		{ "&amp;", "\\&" },
+		{ "&lt;", "\\textless{}" },
+		{ "&gt;", "\\textgreater{}" },
+		{ "&quot;", "\"" },
+		{ "&nbsp;", "~" },
+		{ "&copy;", "\\copyright{}" },
+		{ "&mdash;", "---" },
+		{ "&ndash;", "--" },
+		{ "&hellip;", "\\ldots{}" },
+	};
+
+	size_t i;
+
+	for (i = 0; i < sizeof(entities) / sizeof(entities[0]); ++i) {
+		size_t len = strlen(entities[i].entity);
+
+		if (entity->size == len && memcmp(entity->data, entities[i].entity, len) == 0) {
+			bufputs(ob, entities[i].latex);
+			return;
+		}
+	}
+
+	escape_latex(ob, entity->data, entity->size);
+}
+
+static void
+rndr_normal_text(struct buf *ob, const struct buf *text, void *opaque)
+{
+	if (text)
+		escape_latex(ob, text->data, text->size);
+}
+
+static void
+rndr_doc_header(struct buf *ob, void *opaque)
+{
+	struct latex_renderopt *options = opaque;
+
+	options->root = ob;
+	options->flushed = 0;
+
+	BUFPUTSL(ob,
+		"\\documentclass{article}\n"
+		"\\usepackage[utf8]{inputenc}\n"
+		"\\usepackage[T1]{fontenc}\n"
+		"\\usepackage{graphicx}\n"
+		"\\usepackage[normalem]{ulem}\n"
+		"\\usepackage{hyperref}\n"
+		"\\begin{document}\n");
+}
+
+static void
+rndr_doc_footer(struct buf *ob, void *opaque)
+{
+	struct latex_renderopt *options = opaque;
+
+	BUFPUTSL(ob, "\\end{document}\n");
+
+	if (options->stream_cb && ob->size) {
+		options->stream_cb(ob->data, ob->size, options->stream);
+		options->flushed += ob->size;
+		ob->size = 0;
+	}
+}
+
+void
+sdlatex_renderer(struct sd_callbacks *callbacks, struct latex_renderopt *options, sd_stream_cb stream_cb, void *stream)
+{
+	static const struct sd_callbacks cb_default = {
+		rndr_blockcode,
+		rndr_blockquote,
+		NULL,
+		rndr_header,
+		rndr_hrule,
+		rndr_list,
+		rndr_listitem,
+		rndr_paragraph,
+		rndr_table,
+		rndr_tablerow,
+		rndr_tablecell,
+
+		rndr_autolink,
+		rndr_codespan,
+		rndr_double_emphasis,
+		rndr_emphasis,
+		rndr_image,
+		rndr_linebreak,
+		rndr_link,
+		rndr_raw_html,
+		rndr_triple_emphasis,
+		rndr_strikethrough,
+		rndr_superscript,
+
+		rndr_entity,
+		rndr_normal_text,
+
+		rndr_doc_header,
+		rndr_doc_footer,
+	};
+
+	/* Prepare the options pointer */
+	memset(options, 0x0, sizeof(struct latex_renderopt));
+	options->stream_cb = stream_cb;
+	options->stream = stream;
+
+	/* Prepare the callbacks */
+	memcpy(callbacks, &cb_default, sizeof(struct sd_callbacks));
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2016, wereturtle
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef UPSKIRT_LATEX_H
+#define UPSKIRT_LATEX_H
+
+#include "markdown.h"
+#include "buffer.h"
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LATEX_MAX_COLUMNS 64
+
+struct latex_renderopt {
+	/* streaming: when set, completed top-level blocks are handed to
+	 * the stream callback instead of accumulating in the output buffer */
+	sd_stream_cb stream_cb;
+	void *stream;
+
+	/* internal state */
+	struct buf *root;
+	size_t flushed;
+
+	struct {
+		size_t columns;
+		char align[LATEX_MAX_COLUMNS];
+	} table_data;
+};
+
+extern void
+sdlatex_renderer(struct sd_callbacks *callbacks, struct latex_renderopt *options_ptr, sd_stream_cb stream_cb, void *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -1382,6 +1382,24 @@ prefix_uli(uint8_t *data, size_t size)
 static void parse_block(struct buf *ob, struct sd_markdown *rndr,
 			uint8_t *data, size_t size);
 
+/* append_in_place • appends a line, stripped of its container prefix, to
+ * the content of a blockquote or list item.  The content is compacted
+ * over the stripped prefixes inside the source data itself, so nested
+ * blocks are re-parsed in place instead of being copied into a fresh work
+ * buffer at every nesting level.  This is safe since the content never
+ * grows past the end of the lines it was taken from, which the caller has
+ * already consumed. */
+static inline void
+append_in_place(uint8_t **work_data, size_t *work_size, uint8_t *line, size_t size)
+{
+	if (!*work_data)
+		*work_data = line;
+	else if (line != *work_data + *work_size)
+		memmove(*work_data + *work_size, line, size);
+
+	*work_size += size;
+}
+
 
 /* parse_blockquote • handles parsing of a blockquote fragment */
 static size_t
@@ -1407,14 +1425,8 @@ parse_blockquote(struct buf *ob, struct sd_markdown *rndr, uint8_t *data, size_t
 				!is_empty(data + end, size - end))))
 			break;
 
-		if (beg < end) { /* copy into the in-place working buffer */
-			/* bufput(work, data + beg, end - beg); */
-			if (!work_data)
-				work_data = data + beg;
-			else if (data + beg != work_data + work_size)
-				memmove(work_data + work_size, data + beg, end - beg);
-			work_size += end - beg;
-		}
+		if (beg < end) /* copy into the in-place working buffer */
+			append_in_place(&work_data, &work_size, data + beg, end - beg);
 		beg = end;
 	}
 
@@ -1628,7 +1640,9 @@ parse_blockcode(struct buf *ob, struct sd_markdown *rndr, uint8_t *data, size_t
 static size_t
 parse_listitem(struct buf *ob, struct sd_markdown *rndr, uint8_t *data, size_t size, int *flags)
 {
-	struct buf *work = 0, *inter = 0;
+	struct buf *inter = 0;
+	uint8_t *work_data = 0;
+	size_t work_size = 0;
 	size_t beg = 0, end, pre, sublist = 0, orgpre = 0, i;
 	int in_empty = 0, has_inside_empty = 0, in_fence = 0;
 
@@ -1649,11 +1663,10 @@ parse_listitem(struct buf *ob, struct sd_markdown *rndr, uint8_t *data, size_t s
 		end++;
 
 	/* getting working buffers */
-	work = rndr_newbuf(rndr, BUFFER_SPAN);
 	inter = rndr_newbuf(rndr, BUFFER_SPAN);
 
-	/* putting the first line into the working buffer */
-	bufput(work, data + beg, end - beg);
+	/* putting the first line into the in-place working buffer */
+	append_in_place(&work_data, &work_size, data + beg, end - beg);
 	beg = end;
 
 	/* process the following lines */
@@ -1708,7 +1721,7 @@ parse_listitem(struct buf *ob, struct sd_markdown *rndr, uint8_t *data, size_t s
 				break;             /* the same indentation */
 
 			if (!sublist)
-				sublist = work->size;
+				sublist = work_size;
 		}
 		/* joining only indented stuff after empty lines;
 		 * note that now we only require 1 space of indentation
@@ -1718,14 +1731,15 @@ parse_listitem(struct buf *ob, struct sd_markdown *rndr, uint8_t *data, size_t s
 			break;
 		}
 		else if (in_empty) {
-			bufputc(work, '\n');
+			/* the skipped empty lines leave room for this newline */
+			work_data[work_size++] = '\n';
 			has_inside_empty = 1;
 		}
 
 		in_empty = 0;
 
 		/* adding the line without prefix into the working buffer */
-		bufput(work, data + beg + i, end - beg - i);
+		append_in_place(&work_data, &work_size, data + beg + i, end - beg - i);
 		beg = end;
 	}
 
@@ -1735,27 +1749,26 @@ parse_listitem(struct buf *ob, struct sd_markdown *rndr, uint8_t *data, size_t s
 
 	if (*flags & MKD_LI_BLOCK) {
 		/* intermediate render of block li */
-		if (sublist && sublist < work->size) {
-			parse_block(inter, rndr, work->data, sublist);
-			parse_block(inter, rndr, work->data + sublist, work->size - sublist);
+		if (sublist && sublist < work_size) {
+			parse_block(inter, rndr, work_data, sublist);
+			parse_block(inter, rndr, work_data + sublist, work_size - sublist);
 		}
 		else
-			parse_block(inter, rndr, work->data, work->size);
+			parse_block(inter, rndr, work_data, work_size);
 	} else {
 		/* intermediate render of inline li */
-		if (sublist && sublist < work->size) {
-			parse_inline(inter, rndr, work->data, sublist);
-			parse_block(inter, rndr, work->data + sublist, work->size - sublist);
+		if (sublist && sublist < work_size) {
+			parse_inline(inter, rndr, work_data, sublist);
+			parse_block(inter, rndr, work_data + sublist, work_size - sublist);
 		}
 		else
-			parse_inline(inter, rndr, work->data, work->size);
+			parse_inline(inter, rndr, work_data, work_size);
 	}
 
 	/* render of li itself */
 	if (rndr->cb.listitem)
 		rndr->cb.listitem(ob, inter, *flags, rndr->opaque);
 
-	rndr_popbuf(rndr, BUFFER_SPAN);
 	rndr_popbuf(rndr, BUFFER_SPAN);
 	return beg;
 }
@@ -101,6 +101,10 @@ struct sd_callbacks {
 
 struct sd_markdown;
 
+/* sd_stream_cb - receives rendered output from renderers that can stream
+ * completed blocks directly to their destination */
+typedef void (*sd_stream_cb)(const uint8_t *data, size_t size, void *stream);
+
 /*********
  * FLAGS *
  *********/
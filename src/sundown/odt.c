@@ -0,0 +1,757 @@
+/*
+ * Copyright (c) 2016, wereturtle
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "markdown.h"
+#include "odt.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <ctype.h>
+
+#include "houdini.h"
+
+/* output is handed to the stream once the root buffer grows past this */
+#define ODT_FLUSH_SIZE (64 * 1024)
+
+#define ODT_BODY_STYLE "Text_20_body"
+#define ODT_QUOTE_STYLE "Quotations"
+
+static inline void escape_xml(struct buf *ob, const uint8_t *source, size_t length)
+{
+	houdini_escape_html0(ob, source, length, 0);
+}
+
+/* block_end: streams completed top-level blocks to their destination */
+static void
+block_end(struct buf *ob, struct odt_renderopt *options)
+{
+	if (options->stream_cb && ob == options->root && ob->size >= ODT_FLUSH_SIZE) {
+		options->stream_cb(ob->data, ob->size, options->stream);
+		options->flushed += ob->size;
+		ob->size = 0;
+	}
+}
+
+/* put_spaces: whitespace runs collapse in ODF, so they need explicit markup */
+static void
+put_spaces(struct buf *ob, size_t count, int line_start)
+{
+	if (!line_start) {
+		bufputc(ob, ' ');
+		count--;
+	}
+
+	if (count == 1)
+		BUFPUTSL(ob, "<text:s/>");
+	else if (count > 1)
+		bufprintf(ob, "<text:s text:c=\"%u\"/>", (unsigned int)count);
+}
+
+/********************
+ * GENERIC RENDERER *
+ ********************/
+static int
+rndr_autolink(struct buf *ob, const struct buf *link, enum mkd_autolink type, void *opaque)
+{
+	if (!link || !link->size)
+		return 0;
+
+	BUFPUTSL(ob, "<text:a xlink:type=\"simple\" xlink:href=\"");
+	if (type == MKDA_EMAIL)
+		BUFPUTSL(ob, "mailto:");
+	escape_xml(ob, link->data, link->size);
+	BUFPUTSL(ob, "\">");
+
+	if (bufprefix(link, "mailto:") == 0)
+		escape_xml(ob, link->data + 7, link->size - 7);
+	else
+		escape_xml(ob, link->data, link->size);
+
+	BUFPUTSL(ob, "</text:a>");
+	return 1;
+}
+
+static void
+rndr_blockcode(struct buf *ob, const struct buf *text, const struct buf *lang, void *opaque)
+{
+	size_t i = 0, org, size;
+
+	size = text ? text->size : 0;
+
+	/* drop the trailing newline so that it doesn't become an empty line */
+	while (size && text->data[size - 1] == '\n')
+		size--;
+
+	do {
+		BUFPUTSL(ob, "<text:p text:style-name=\"Preformatted_20_Text\">");
+
+		org = i;
+		while (i < size && text->data[i] != '\n') {
+			size_t run = i;
+
+			if (text->data[i] == ' ') {
+				while (i < size && text->data[i] == ' ')
+					i++;
+
+				put_spaces(ob, i - run, run == org);
+			} else if (text->data[i] == '\t') {
+				BUFPUTSL(ob, "<text:tab/>");
+				i++;
+			} else {
+				while (i < size && text->data[i] != '\n' &&
+						text->data[i] != ' ' && text->data[i] != '\t')
+					i++;
+
+				escape_xml(ob, text->data + run, i - run);
+			}
+		}
+
+		BUFPUTSL(ob, "</text:p>\n");
+		i++;
+	} while (i < size);
+
+	block_end(ob, opaque);
+}
+
+static void
+rndr_blockquote(struct buf *ob, const struct buf *text, void *opaque)
+{
+	static const char body_style[] = "\"" ODT_BODY_STYLE "\"";
+	static const char quote_style[] = "\"" ODT_QUOTE_STYLE "\"";
+
+	size_t i = 0, org;
+
+	if (!text)
+		return;
+
+	/* ODF has no block quote element, so restyle the quoted paragraphs */
+	while (i < text->size) {
+		org = i;
+
+		while (i < text->size && (text->size - i < sizeof(body_style) - 1 ||
+				memcmp(text->data + i, body_style, sizeof(body_style) - 1) != 0))
+			i++;
+
+		bufput(ob, text->data + org, i - org);
+
+		if (i < text->size) {
+			BUFPUTSL(ob, quote_style);
+			i += sizeof(body_style) - 1;
+		}
+	}
+
+	block_end(ob, opaque);
+}
+
+static int
+rndr_codespan(struct buf *ob, const struct buf *text, void *opaque)
+{
+	BUFPUTSL(ob, "<text:span text:style-name=\"Source_20_Text\">");
+	if (text) escape_xml(ob, text->data, text->size);
+	BUFPUTSL(ob, "</text:span>");
+	return 1;
+}
+
+static int
+rndr_span(struct buf *ob, const struct buf *text, const char *style)
+{
+	if (!text || !text->size)
+		return 0;
+
+	bufprintf(ob, "<text:span text:style-name=\"%s\">", style);
+	bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, "</text:span>");
+	return 1;
+}
+
+static int
+rndr_strikethrough(struct buf *ob, const struct buf *text, void *opaque)
+{
+	return rndr_span(ob, text, "Strikethrough");
+}
+
+static int
+rndr_double_emphasis(struct buf *ob, const struct buf *text, void *opaque)
+{
+	return rndr_span(ob, text, "Strong_20_Emphasis");
+}
+
+static int
+rndr_emphasis(struct buf *ob, const struct buf *text, void *opaque)
+{
+	return rndr_span(ob, text, "Emphasis");
+}
+
+static int
+rndr_triple_emphasis(struct buf *ob, const struct buf *text, void *opaque)
+{
+	return rndr_span(ob, text, "Strong_20_Emphasis_20_Italic");
+}
+
+static int
+rndr_superscript(struct buf *ob, const struct buf *text, void *opaque)
+{
+	return rndr_span(ob, text, "Superscript");
+}
+
+static int
+rndr_linebreak(struct buf *ob, void *opaque)
+{
+	BUFPUTSL(ob, "<text:line-break/>");
+	return 1;
+}
+
+static void
+rndr_header(struct buf *ob, const struct buf *text, int level, void *opaque)
+{
+	bufprintf(ob, "<text:h text:style-name=\"Heading_20_%d\" text:outline-level=\"%d\">", level, level);
+	if (text) bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, "</text:h>\n");
+	block_end(ob, opaque);
+}
+
+static int
+rndr_link(struct buf *ob, const struct buf *link, const struct buf *title, const struct buf *content, void *opaque)
+{
+	BUFPUTSL(ob, "<text:a xlink:type=\"simple\" xlink:href=\"");
+	if (link && link->size)
+		escape_xml(ob, link->data, link->size);
+
+	if (title && title->size) {
+		BUFPUTSL(ob, "\" office:title=\"");
+		escape_xml(ob, title->data, title->size);
+	}
+
+	BUFPUTSL(ob, "\">");
+	if (content && content->size) bufput(ob, content->data, content->size);
+	BUFPUTSL(ob, "</text:a>");
+	return 1;
+}
+
+/* lists and list items that are open around a table, innermost last */
+#define ODT_LIST_DEPTH 64
+#define ODT_CONTINUE " text:continue-numbering=\"true\">"
+
+enum odt_open_kind {
+	ODT_OPEN_LIST,
+	ODT_OPEN_ITEM,
+	ODT_OPEN_HEADER
+};
+
+static int
+starts_with(const struct buf *text, size_t i, const char *prefix)
+{
+	size_t len = strlen(prefix);
+	return text->size - i >= len && memcmp(text->data + i, prefix, len) == 0;
+}
+
+static void
+close_open(struct buf *ob, int kind)
+{
+	if (kind == ODT_OPEN_LIST)
+		BUFPUTSL(ob, "</text:list>\n");
+	else if (kind == ODT_OPEN_ITEM)
+		BUFPUTSL(ob, "</text:list-item>\n");
+	else
+		BUFPUTSL(ob, "</text:list-header>\n");
+}
+
+static size_t
+skip_close(const struct buf *text, size_t i, int kind)
+{
+	static const char *closers[] = {
+		"</text:list>", "</text:list-item>", "</text:list-header>"
+	};
+	int k;
+
+	for (k = 0; k < 3; ++k) {
+		if ((kind == ODT_OPEN_LIST) != (k == 0))
+			continue;
+
+		if (starts_with(text, i, closers[k])) {
+			i += strlen(closers[k]);
+			if (i < text->size && text->data[i] == '\n') i++;
+			return i;
+		}
+	}
+
+	return 0;
+}
+
+/* lift_tables: tables may not appear inside ODF lists, so close the open
+ * lists before each table and continue them after it.  A continued item
+ * becomes a list header, so that it does not get a bullet or number of
+ * its own. */
+static void
+lift_tables(struct buf *ob, const struct buf *text)
+{
+	size_t tag[ODT_LIST_DEPTH], tag_size[ODT_LIST_DEPTH];
+	int kind[ODT_LIST_DEPTH];
+	int depth = 0, j;
+	size_t i = 0, org, end;
+
+	while (i < text->size) {
+		org = i;
+		while (i < text->size && text->data[i] != '<')
+			i++;
+
+		if (i > org)
+			bufput(ob, text->data + org, i - org);
+
+		if (i >= text->size)
+			break;
+
+		if (starts_with(text, i, "<text:list ") ||
+				starts_with(text, i, "<text:list-item>") ||
+				starts_with(text, i, "<text:list-header>")) {
+			if (depth == ODT_LIST_DEPTH) {
+				bufput(ob, text->data + i, text->size - i);
+				return;
+			}
+
+			end = i;
+			while (end < text->size && text->data[end] != '>')
+				end++;
+			if (end < text->size) end++;
+
+			tag[depth] = i;
+			tag_size[depth] = end - i;
+			kind[depth] = text->data[i + 10] == ' ' ? ODT_OPEN_LIST :
+				text->data[i + 11] == 'i' ? ODT_OPEN_ITEM : ODT_OPEN_HEADER;
+			depth++;
+
+			bufput(ob, text->data + i, end - i);
+			i = end;
+		} else if (depth > 0 && (end = skip_close(text, i, kind[depth - 1])) > 0) {
+			close_open(ob, kind[--depth]);
+			i = end;
+		} else if (depth > 0 && starts_with(text, i, "<table:table ")) {
+			for (end = i; end < text->size; ++end) {
+				if (starts_with(text, end, "</table:table>")) {
+					end += 14;
+					if (end < text->size && text->data[end] == '\n') end++;
+					break;
+				}
+			}
+
+			for (j = depth - 1; j >= 0; --j)
+				close_open(ob, kind[j]);
+
+			bufput(ob, text->data + i, end - i);
+			if (text->data[end - 1] != '\n') bufputc(ob, '\n');
+			i = end;
+
+			/* elements that end right after the table stay closed */
+			while (i < text->size && text->data[i] == '\n')
+				i++;
+
+			while (depth > 0 && (end = skip_close(text, i, kind[depth - 1])) > 0) {
+				depth--;
+				i = end;
+			}
+
+			for (j = 0; j < depth; ++j) {
+				if (kind[j] != ODT_OPEN_LIST) {
+					BUFPUTSL(ob, "<text:list-header>");
+					kind[j] = ODT_OPEN_HEADER;
+				} else if (tag_size[j] > strlen(ODT_CONTINUE) &&
+						memcmp(text->data + tag[j] + tag_size[j] - strlen(ODT_CONTINUE),
+							ODT_CONTINUE, strlen(ODT_CONTINUE)) == 0) {
+					bufput(ob, text->data + tag[j], tag_size[j]);
+					bufputc(ob, '\n');
+				} else {
+					bufput(ob, text->data + tag[j], tag_size[j] - 1);
+					BUFPUTSL(ob, ODT_CONTINUE "\n");
+				}
+			}
+		} else {
+			bufputc(ob, '<');
+			i++;
+		}
+	}
+}
+
+static void
+rndr_list(struct buf *ob, const struct buf *text, int flags, void *opaque)
+{
+	struct buf *list = bufnew(text ? text->size + 128 : 128);
+
+	bufputs(list, flags & MKD_LIST_ORDERED ?
+		"<text:list text:style-name=\"Numbering_20_1\">\n" :
+		"<text:list text:style-name=\"List_20_1\">\n");
+	if (text) bufput(list, text->data, text->size);
+	BUFPUTSL(list, "</text:list>\n");
+
+	lift_tables(ob, list);
+	bufrelease(list);
+	block_end(ob, opaque);
+}
+
+static void
+rndr_listitem(struct buf *ob, const struct buf *text, int flags, void *opaque)
+{
+	size_t size = 0, inline_end;
+
+	BUFPUTSL(ob, "<text:list-item>");
+
+	if (text) {
+		size = text->size;
+		while (size && text->data[size - 1] == '\n')
+			size--;
+	}
+
+	if (flags & MKD_LI_BLOCK) {
+		bufput(ob, text->data, size);
+	} else {
+		/* a tight item holds inline content, possibly followed by a
+		 * nested list, and list items may only contain block elements */
+		for (inline_end = 0; inline_end < size; ++inline_end) {
+			if (text->data[inline_end] == '<' && size - inline_end > 10 &&
+					memcmp(text->data + inline_end, "<text:list ", 11) == 0)
+				break;
+		}
+
+		BUFPUTSL(ob, "<text:p text:style-name=\"List_20_Contents\">");
+		while (inline_end && text->data[inline_end - 1] == '\n')
+			inline_end--;
+		bufput(ob, text->data, inline_end);
+		BUFPUTSL(ob, "</text:p>");
+
+		while (inline_end < size && text->data[inline_end] == '\n')
+			inline_end++;
+		bufput(ob, text->data + inline_end, size - inline_end);
+	}
+
+	BUFPUTSL(ob, "</text:list-item>\n");
+}
+
+static void
+rndr_paragraph(struct buf *ob, const struct buf *text, void *opaque)
+{
+	size_t i = 0;
+
+	if (!text || !text->size)
+		return;
+
+	while (i < text->size && isspace(text->data[i])) i++;
+
+	if (i == text->size)
+		return;
+
+	BUFPUTSL(ob, "<text:p text:style-name=\"" ODT_BODY_STYLE "\">");
+	bufput(ob, &text->data[i], text->size - i);
+	BUFPUTSL(ob, "</text:p>\n");
+	block_end(ob, opaque);
+}
+
+static void
+rndr_hrule(struct buf *ob, void *opaque)
+{
+	BUFPUTSL(ob, "<text:p text:style-name=\"Horizontal_20_Line\"/>\n");
+	block_end(ob, opaque);
+}
+
+static int
+rndr_image(struct buf *ob, const struct buf *link, const struct buf *title, const struct buf *alt, void *opaque)
+{
+	if (!link || !link->size) return 0;
+
+	BUFPUTSL(ob, "<draw:frame text:anchor-type=\"as-char\" svg:width=\"6in\" style:rel-width=\"100%\" style:rel-height=\"scale\"");
+
+	if (alt && alt->size) {
+		BUFPUTSL(ob, " draw:name=\"");
+		escape_xml(ob, alt->data, alt->size);
+		BUFPUTSL(ob, "\"");
+	}
+
+	BUFPUTSL(ob, "><draw:image xlink:type=\"simple\" xlink:show=\"embed\" xlink:actuate=\"onLoad\" xlink:href=\"");
+	escape_xml(ob, link->data, link->size);
+	BUFPUTSL(ob, "\"/>");
+
+	if (title && title->size) {
+		BUFPUTSL(ob, "<svg:title>");
+		escape_xml(ob, title->data, title->size);
+		BUFPUTSL(ob, "</svg:title>");
+	}
+
+	BUFPUTSL(ob, "</draw:frame>");
+	return 1;
+}
+
+static int
+rndr_raw_html(struct buf *ob, const struct buf *text, void *opaque)
+{
+	/* HTML has no meaning in ODF output, so drop it */
+	return 1;
+}
+
+static void
+rndr_table(struct buf *ob, const struct buf *header, const struct buf *body, void *opaque)
+{
+	struct odt_renderopt *options = opaque;
+
+	bufprintf(ob, "<table:table table:name=\"Table%u\">\n", ++options->table_data.count);
+
+	if (options->table_data.columns)
+		bufprintf(ob, "<table:table-column table:number-columns-repeated=\"%u\"/>\n",
+			(unsigned int)options->table_data.columns);
+
+	BUFPUTSL(ob, "<table:table-header-rows>\n");
+	if (header)
+		bufput(ob, header->data, header->size);
+	BUFPUTSL(ob, "</table:table-header-rows>\n");
+	if (body)
+		bufput(ob, body->data, body->size);
+	BUFPUTSL(ob, "</table:table>\n");
+
+	options->table_data.columns = 0;
+	block_end(ob, opaque);
+}
+
+static void
+rndr_tablerow(struct buf *ob, const struct buf *text, void *opaque)
+{
+	BUFPUTSL(ob, "<table:table-row>");
+	if (text)
+		bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, "</table:table-row>\n");
+}
+
+static void
+rndr_tablecell(struct buf *ob, const struct buf *text, int flags, void *opaque)
+{
+	struct odt_renderopt *options = opaque;
+	const char *style;
+
+	if (flags & MKD_TABLE_HEADER) {
+		options->table_data.columns++;
+		style = "Table_20_Heading";
+	} else {
+		style = "Table_20_Contents";
+	}
+
+	switch (flags & MKD_TABLE_ALIGNMASK) {
+	case MKD_TABLE_ALIGN_CENTER:
+		bufprintf(ob, "<table:table-cell office:value-type=\"string\"><text:p text:style-name=\"%s_20_Center\">", style);
+		break;
+
+	case MKD_TABLE_ALIGN_R:
+		bufprintf(ob, "<table:table-cell office:value-type=\"string\"><text:p text:style-name=\"%s_20_Right\">", style);
+		break;
+
+	default:
+		bufprintf(ob, "<table:table-cell office:value-type=\"string\"><text:p text:style-name=\"%s\">", style);
+		break;
+	}
+
+	if (text)
+		bufput(ob, text->data, text->size);
+	BUFPUTSL(ob, "</text:p></table:table-cell>");
+}
+
+static void
+rndr_entity(struct buf *ob, const struct buf *entity, void *opaque)
+{
+	/* named entities other than these are not defined in XML */
+	static const struct {
+		const char *entity;
+		const char *xml;
+	} entities[] = {
+		{ "&amp;", "&amp;" },
+		{ "&lt;", "&lt;" },
+		{ "&gt;", "&gt;" },
+		{ "&quot;", "&quot;" },
+		{ "&apos;", "&apos;" },
+		{ "&nbsp;", "&#160;" },
+		{ "&copy;", "&#169;" },
+		{ "&reg;", "&#174;" },
+		{ "&trade;", "&#8482;" },
+		{ "&mdash;", "&#8212;" },
+		{ "&ndash;", "&#8211;" },
+		{ "&hellip;", "&#8230;" },
+		{ "&laquo;", "&#171;" },
+		{ "&raquo;", "&#187;" },
+	};
+
+	size_t i;
+
+	/* numeric character references are valid XML as they are */
+	if (entity->size > 3 && entity->data[1] == '#') {
+		bufput(ob, entity->data, entity->size);
+		return;
+	}
+
+	for (i = 0; i < sizeof(entities) / sizeof(entities[0]); ++i) {
+		size_t len = strlen(entities[i].entity);
+
+		if (entity->size == len && memcmp(entity->data, entities[i].entity, len) == 0) {
+			bufputs(ob, entities[i].xml);
+			return;
+		}
+	}
+
+	escape_xml(ob, entity->data, entity->size);
+}
+
+static void
+rndr_normal_text(struct buf *ob, const struct buf *text, void *opaque)
+{
+	if (text)
+		escape_xml(ob, text->data, text->size);
+}
+
+static void
+rndr_doc_header(struct buf *ob, void *opaque)
+{
+	struct odt_renderopt *options = opaque;
+
+	options->root = ob;
+	options->flushed = 0;
+	options->table_data.count = 0;
+
+	BUFPUTSL(ob,
+		"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+		"<office:document"
+		" xmlns:office=\"urn:oasis:names:tc:opendocument:xmlns:office:1.0\""
+		" xmlns:style=\"urn:oasis:names:tc:opendocument:xmlns:style:1.0\""
+		" xmlns:text=\"urn:oasis:names:tc:opendocument:xmlns:text:1.0\""
+		" xmlns:table=\"urn:oasis:names:tc:opendocument:xmlns:table:1.0\""
+		" xmlns:draw=\"urn:oasis:names:tc:opendocument:xmlns:drawing:1.0\""
+		" xmlns:fo=\"urn:oasis:names:tc:opendocument:xmlns:xsl-fo-compatible:1.0\""
+		" xmlns:xlink=\"http://www.w3.org/1999/xlink\""
+		" xmlns:svg=\"urn:oasis:names:tc:opendocument:xmlns:svg-compatible:1.0\""
+		" office:version=\"1.2\""
+		" office:mimetype=\"application/vnd.oasis.opendocument.text\">\n"
+		"<office:styles>\n"
+		"<style:style style:name=\"Standard\" style:family=\"paragraph\"/>\n"
+		"<style:style style:name=\"Text_20_body\" style:display-name=\"Text body\" style:family=\"paragraph\" style:parent-style-name=\"Standard\">"
+		"<style:paragraph-properties fo:margin-top=\"0in\" fo:margin-bottom=\"0.0835in\"/></style:style>\n"
+		"<style:style style:name=\"Heading\" style:family=\"paragraph\" style:parent-style-name=\"Standard\" style:next-style-name=\"Text_20_body\">"
+		"<style:paragraph-properties fo:margin-top=\"0.1665in\" fo:margin-bottom=\"0.0835in\" fo:keep-with-next=\"always\"/>"
+		"<style:text-properties fo:font-weight=\"bold\"/></style:style>\n"
+		"<style:style style:name=\"Heading_20_1\" style:display-name=\"Heading 1\" style:family=\"paragraph\" style:parent-style-name=\"Heading\" style:default-outline-level=\"1\">"
+		"<style:text-properties fo:font-size=\"200%\"/></style:style>\n"
+		"<style:style style:name=\"Heading_20_2\" style:display-name=\"Heading 2\" style:family=\"paragraph\" style:parent-style-name=\"Heading\" style:default-outline-level=\"2\">"
+		"<style:text-properties fo:font-size=\"150%\"/></style:style>\n"
+		"<style:style style:name=\"Heading_20_3\" style:display-name=\"Heading 3\" style:family=\"paragraph\" style:parent-style-name=\"Heading\" style:default-outline-level=\"3\">"
+		"<style:text-properties fo:font-size=\"130%\"/></style:style>\n"
+		"<style:style style:name=\"Heading_20_4\" style:display-name=\"Heading 4\" style:family=\"paragraph\" style:parent-style-name=\"Heading\" style:default-outline-level=\"4\">"
+		"<style:text-properties fo:font-size=\"115%\"/></style:style>\n"
+		"<style:style style:name=\"Heading_20_5\" style:display-name=\"Heading 5\" style:family=\"paragraph\" style:parent-style-name=\"Heading\" style:default-outline-level=\"5\">"
+		"<style:text-properties fo:font-size=\"100%\"/></style:style>\n"
+		"<style:style style:name=\"Heading_20_6\" style:display-name=\"Heading 6\" style:family=\"paragraph\" style:parent-style-name=\"Heading\" style:default-outline-level=\"6\">"
+		"<style:text-properties fo:font-size=\"100%\" fo:font-style=\"italic\"/></style:style>\n"
+		"<style:style style:name=\"Quotations\" style:family=\"paragraph\" style:parent-style-name=\"Text_20_body\">"
+		"<style:paragraph-properties fo:margin-left=\"0.3937in\" fo:margin-right=\"0.3937in\"/></style:style>\n"
+		"<style:style style:name=\"Preformatted_20_Text\" style:display-name=\"Preformatted Text\" style:family=\"paragraph\" style:parent-style-name=\"Standard\">"
+		"<style:paragraph-properties fo:margin-top=\"0in\" fo:margin-bottom=\"0in\"/>"
+		"<style:text-properties style:font-name=\"Courier New\" fo:font-family=\"'Courier New', monospace\"/></style:style>\n"
+		"<style:style style:name=\"Horizontal_20_Line\" style:display-name=\"Horizontal Line\" style:family=\"paragraph\" style:parent-style-name=\"Standard\">"
+		"<style:paragraph-properties fo:margin-bottom=\"0.1965in\" fo:border-bottom=\"0.0104in solid #808080\" fo:padding=\"0in\"/></style:style>\n"
+		"<style:style style:name=\"List_20_Contents\" style:display-name=\"List Contents\" style:family=\"paragraph\" style:parent-style-name=\"Standard\"/>\n"
+		"<style:style style:name=\"Table_20_Contents\" style:display-name=\"Table Contents\" style:family=\"paragraph\" style:parent-style-name=\"Standard\"/>\n"
+		"<style:style style:name=\"Table_20_Contents_20_Center\" style:display-name=\"Table Contents Center\" style:family=\"paragraph\" style:parent-style-name=\"Table_20_Contents\">"
+		"<style:paragraph-properties fo:text-align=\"center\"/></style:style>\n"
+		"<style:style style:name=\"Table_20_Contents_20_Right\" style:display-name=\"Table Contents Right\" style:family=\"paragraph\" style:parent-style-name=\"Table_20_Contents\">"
+		"<style:paragraph-properties fo:text-align=\"end\"/></style:style>\n"
+		"<style:style style:name=\"Table_20_Heading\" style:display-name=\"Table Heading\" style:family=\"paragraph\" style:parent-style-name=\"Table_20_Contents\">"
+		"<style:text-properties fo:font-weight=\"bold\"/></style:style>\n"
+		"<style:style style:name=\"Table_20_Heading_20_Center\" style:display-name=\"Table Heading Center\" style:family=\"paragraph\" style:parent-style-name=\"Table_20_Heading\">"
+		"<style:paragraph-properties fo:text-align=\"center\"/></style:style>\n"
+		"<style:style style:name=\"Table_20_Heading_20_Right\" style:display-name=\"Table Heading Right\" style:family=\"paragraph\" style:parent-style-name=\"Table_20_Heading\">"
+		"<style:paragraph-properties fo:text-align=\"end\"/></style:style>\n"
+		"<style:style style:name=\"Emphasis\" style:family=\"text\"><style:text-properties fo:font-style=\"italic\"/></style:style>\n"
+		"<style:style style:name=\"Strong_20_Emphasis\" style:display-name=\"Strong Emphasis\" style:family=\"text\"><style:text-properties fo:font-weight=\"bold\"/></style:style>\n"
+		"<style:style style:name=\"Strong_20_Emphasis_20_Italic\" style:display-name=\"Strong Emphasis Italic\" style:family=\"text\"><style:text-properties fo:font-weight=\"bold\" fo:font-style=\"italic\"/></style:style>\n"
+		"<style:style style:name=\"Source_20_Text\" style:display-name=\"Source Text\" style:family=\"text\"><style:text-properties style:font-name=\"Courier New\" fo:font-family=\"'Courier New', monospace\"/></style:style>\n"
+		"<style:style style:name=\"Strikethrough\" style:family=\"text\"><style:text-properties style:text-line-through-style=\"solid\"/></style:style>\n"
+		"<style:style style:name=\"Superscript\" style:family=\"text\"><style:text-properties style:text-position=\"super 58%\"/></style:style>\n"
+		"<text:list-style style:name=\"List_20_1\" style:display-name=\"List 1\">\n"
+		"<text:list-level-style-bullet text:level=\"1\" text:bullet-char=\"&#8226;\"><style:list-level-properties text:space-before=\"0.25in\" text:min-label-width=\"0.25in\"/></text:list-level-style-bullet>\n"
+		"<text:list-level-style-bullet text:level=\"2\" text:bullet-char=\"&#9702;\"><style:list-level-properties text:space-before=\"0.5in\" text:min-label-width=\"0.25in\"/></text:list-level-style-bullet>\n"
+		"<text:list-level-style-bullet text:level=\"3\" text:bullet-char=\"&#9642;\"><style:list-level-properties text:space-before=\"0.75in\" text:min-label-width=\"0.25in\"/></text:list-level-style-bullet>\n"
+		"</text:list-style>\n"
+		"<text:list-style style:name=\"Numbering_20_1\" style:display-name=\"Numbering 1\">\n"
+		"<text:list-level-style-number text:level=\"1\" style:num-suffix=\".\" style:num-format=\"1\"><style:list-level-properties text:space-before=\"0.25in\" text:min-label-width=\"0.25in\"/></text:list-level-style-number>\n"
+		"<text:list-level-style-number text:level=\"2\" style:num-suffix=\".\" style:num-format=\"a\"><style:list-level-properties text:space-before=\"0.5in\" text:min-label-width=\"0.25in\"/></text:list-level-style-number>\n"
+		"<text:list-level-style-number text:level=\"3\" style:num-suffix=\".\" style:num-format=\"i\"><style:list-level-properties text:space-before=\"0.75in\" text:min-label-width=\"0.25in\"/></text:list-level-style-number>\n"
+		"</text:list-style>\n"
+		"</office:styles>\n"
+		"<office:body>\n"
+		"<office:text>\n");
+}
+
+static void
+rndr_doc_footer(struct buf *ob, void *opaque)
+{
+	struct odt_renderopt *options = opaque;
+
+	BUFPUTSL(ob,
+		"</office:text>\n"
+		"</office:body>\n"
+		"</office:document>\n");
+
+	if (options->stream_cb && ob->size) {
+		options->stream_cb(ob->data, ob->size, options->stream);
+		options->flushed += ob->size;
+		ob->size = 0;
+	}
+}
+
+void
+sdodt_renderer(struct sd_callbacks *callbacks, struct odt_renderopt *options, sd_stream_cb stream_cb, void *stream)
+{
+	static const struct sd_callbacks cb_default = {
+		rndr_blockcode,
+		rndr_blockquote,
+		NULL,
+		rndr_header,
+		rndr_hrule,
+		rndr_list,
+		rndr_listitem,
+		rndr_paragraph,
+		rndr_table,
+		rndr_tablerow,
+		rndr_tablecell,
+
+		rndr_autolink,
+		rndr_codespan,
+		rndr_double_emphasis,
+		rndr_emphasis,
+		rndr_image,
+		rndr_linebreak,
+		rndr_link,
+		rndr_raw_html,
+		rndr_triple_emphasis,
+		rndr_strikethrough,
+		rndr_superscript,
+
+		rndr_entity,
+		rndr_normal_text,
+
+		rndr_doc_header,
+		rndr_doc_footer,
+	};
+
+	/* Prepare the options pointer */
+	memset(options, 0x0, sizeof(struct odt_renderopt));
+	options->stream_cb = stream_cb;
+	options->stream = stream;
+
+	/* Prepare the callbacks */
+	memcpy(callbacks, &cb_default, sizeof(struct sd_callbacks));
+}